@@ -0,0 +1,407 @@
+// vulkan_game_bench - CPU hot path benchmarks (animation, motion matching,
+// terrain queries, MLP inference, ECS systems, procedural generation).
+// Headless: no window, no Vulkan device.
+//
+// Run from the project root so the fixtures in tests/data are found:
+//   vulkan_game_bench [--filter <text>] [--json out.json]
+//                     [--baseline base.json] [--threshold <percent>]
+//
+// With --baseline, each benchmark's ns/op and allocations/op are compared
+// with the stored run and the exit code is 1 if any regressed.
+
+#include "Bench.h"
+
+#include <SDL3/SDL_log.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace bench {
+
+// =============================================================================
+// State
+// =============================================================================
+
+void State::start() {
+    started_ = true;
+    startAllocations_ = allocationCount();
+    startTime_ = Clock::now();
+}
+
+void State::stop() {
+    if (stopped_) return;
+    pauseTiming();
+    stopped_ = true;
+}
+
+void State::pauseTiming() {
+    if (!started_ || paused_) return;
+    elapsedNs_ += std::chrono::duration<double, std::nano>(Clock::now() - startTime_).count();
+    allocations_ += allocationCount() - startAllocations_;
+    paused_ = true;
+}
+
+void State::resumeTiming() {
+    if (!paused_ || stopped_) return;
+    paused_ = false;
+    startAllocations_ = allocationCount();
+    startTime_ = Clock::now();
+}
+
+// =============================================================================
+// Registry
+// =============================================================================
+
+namespace {
+
+struct Benchmark {
+    std::string name;
+    BenchmarkFn fn;
+};
+
+// Function-local so registration from other translation units is order-safe
+std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+} // namespace
+
+Registrar::Registrar(const char* name, BenchmarkFn fn) {
+    registry().push_back({name, fn});
+}
+
+} // namespace bench
+
+// =============================================================================
+// Runner
+// =============================================================================
+
+namespace {
+
+constexpr uint64_t MAX_ITERATIONS = 1000000000;
+
+struct Options {
+    std::string filter;
+    std::string jsonPath;
+    std::string baselinePath;
+    std::string dataDir = "tests/data";
+    double minTimeSec = 0.5;
+    double thresholdPercent = 10.0;
+    int repetitions = 3;
+    bool smoke = false;         // One iteration each: checks the benchmarks still run
+    bool list = false;
+};
+
+struct Result {
+    std::string name;
+    uint64_t iterations = 0;
+    double nsPerOp = 0.0;
+    double allocsPerOp = 0.0;
+    double itemsPerSecond = 0.0;
+    std::string skipped;
+};
+
+struct Sample {
+    double nsPerOp = 0.0;
+    double allocsPerOp = 0.0;
+    double itemsPerIteration = 0.0;
+    std::string skipped;
+    bool completed = false;
+};
+
+Sample runBatch(const bench::Benchmark& benchmark, uint64_t iterations, const Options& options) {
+    bench::State state(iterations, options.dataDir);
+    benchmark.fn(state);
+
+    Sample sample;
+    sample.skipped = state.skipReason();
+    sample.completed = state.completed();
+    sample.nsPerOp = state.elapsedNs() / static_cast<double>(iterations);
+    sample.allocsPerOp = static_cast<double>(state.allocations()) / static_cast<double>(iterations);
+    sample.itemsPerIteration = state.itemsPerIteration();
+    return sample;
+}
+
+Result measure(const bench::Benchmark& benchmark, const Options& options) {
+    Result result;
+    result.name = benchmark.name;
+
+    // Grow the batch until it lasts minTime, like Google Benchmark does
+    const double minTimeNs = options.minTimeSec * 1e9;
+    uint64_t iterations = 1;
+    Sample sample;
+    for (;;) {
+        sample = runBatch(benchmark, iterations, options);
+        if (!sample.skipped.empty()) {
+            result.skipped = sample.skipped;
+            return result;
+        }
+        if (!sample.completed) {
+            result.skipped = "loop did not run to completion";
+            return result;
+        }
+
+        double elapsedNs = sample.nsPerOp * static_cast<double>(iterations);
+        if (options.smoke || elapsedNs >= minTimeNs || iterations >= MAX_ITERATIONS) break;
+
+        double multiplier = elapsedNs > 0.0 ? minTimeNs * 1.4 / elapsedNs : 10.0;
+        if (elapsedNs < minTimeNs * 0.1) multiplier = std::min(multiplier, 10.0);
+        uint64_t next = static_cast<uint64_t>(static_cast<double>(iterations) * std::max(multiplier, 1.5));
+        iterations = std::min(MAX_ITERATIONS, std::max(iterations + 1, next));
+    }
+
+    // Median of the repetitions; the calibrated batch counts as the first
+    std::vector<Sample> samples = {sample};
+    int repetitions = options.smoke ? 1 : std::max(1, options.repetitions);
+    for (int i = 1; i < repetitions; ++i) {
+        samples.push_back(runBatch(benchmark, iterations, options));
+    }
+    std::sort(samples.begin(), samples.end(),
+              [](const Sample& a, const Sample& b) { return a.nsPerOp < b.nsPerOp; });
+    const Sample& median = samples[samples.size() / 2];
+
+    result.iterations = iterations;
+    result.nsPerOp = median.nsPerOp;
+    result.allocsPerOp = median.allocsPerOp;
+    if (median.itemsPerIteration > 0.0 && median.nsPerOp > 0.0) {
+        result.itemsPerSecond = median.itemsPerIteration * 1e9 / median.nsPerOp;
+    }
+    return result;
+}
+
+std::string formatTime(double ns) {
+    char buffer[32];
+    if (ns >= 1e6) {
+        std::snprintf(buffer, sizeof(buffer), "%.2f ms", ns / 1e6);
+    } else if (ns >= 1e3) {
+        std::snprintf(buffer, sizeof(buffer), "%.2f us", ns / 1e3);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.1f ns", ns);
+    }
+    return buffer;
+}
+
+std::string formatRate(double perSecond) {
+    if (perSecond <= 0.0) return "-";
+    char buffer[32];
+    if (perSecond >= 1e9) {
+        std::snprintf(buffer, sizeof(buffer), "%.2fG/s", perSecond / 1e9);
+    } else if (perSecond >= 1e6) {
+        std::snprintf(buffer, sizeof(buffer), "%.2fM/s", perSecond / 1e6);
+    } else if (perSecond >= 1e3) {
+        std::snprintf(buffer, sizeof(buffer), "%.2fk/s", perSecond / 1e3);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.1f/s", perSecond);
+    }
+    return buffer;
+}
+
+bool writeJson(const std::string& path, const std::vector<Result>& results, const Options& options) {
+    json benchmarks = json::array();
+    for (const auto& result : results) {
+        if (!result.skipped.empty()) continue;
+        benchmarks.push_back({
+            {"name", result.name},
+            {"iterations", result.iterations},
+            {"ns_per_op", result.nsPerOp},
+            {"allocs_per_op", result.allocsPerOp},
+            {"items_per_second", result.itemsPerSecond}
+        });
+    }
+
+    json document = {
+        {"context", {
+            {"executable", "vulkan_game_bench"},
+#ifdef NDEBUG
+            {"build", "release"},
+#else
+            {"build", "debug"},
+#endif
+            {"min_time_s", options.minTimeSec},
+            {"repetitions", options.repetitions}
+        }},
+        {"benchmarks", std::move(benchmarks)}
+    };
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Can't write %s", path.c_str());
+        return false;
+    }
+    file << document.dump(2) << '\n';
+    SDL_Log("Results written to %s", path.c_str());
+    return static_cast<bool>(file);
+}
+
+/**
+ * Compare against a stored run. ns/op regresses when it is more than
+ * threshold percent slower; allocations are deterministic, so any increase
+ * of half an allocation per op or more counts.
+ * Returns the number of regressions, or -1 if the baseline can't be read.
+ */
+int compareWithBaseline(const std::string& path, const std::vector<Result>& results, double thresholdPercent) {
+    std::ifstream file(path);
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Can't read baseline %s", path.c_str());
+        return -1;
+    }
+    json baseline = json::parse(file, nullptr, false);
+    if (baseline.is_discarded() || !baseline.contains("benchmarks") || !baseline["benchmarks"].is_array()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Baseline %s is not a vulkan_game_bench result", path.c_str());
+        return -1;
+    }
+
+    std::map<std::string, const json*> byName;
+    for (const auto& entry : baseline["benchmarks"]) {
+        if (entry.contains("name") && entry["name"].is_string()) {
+            byName[entry["name"].get<std::string>()] = &entry;
+        }
+    }
+
+    SDL_Log("Baseline %s (threshold %.1f%%)", path.c_str(), thresholdPercent);
+    SDL_Log("%-44s %12s %12s %9s %15s  %s", "benchmark", "baseline", "current", "change", "allocs/op", "status");
+
+    int regressions = 0;
+    for (const auto& result : results) {
+        if (!result.skipped.empty()) continue;
+        auto it = byName.find(result.name);
+        if (it == byName.end()) {
+            SDL_Log("%-44s %12s %12s %9s %15s  new", result.name.c_str(), "-",
+                    formatTime(result.nsPerOp).c_str(), "-", "-");
+            continue;
+        }
+
+        double baseNs = it->second->value("ns_per_op", 0.0);
+        double baseAllocs = it->second->value("allocs_per_op", 0.0);
+        double change = baseNs > 0.0 ? (result.nsPerOp / baseNs - 1.0) * 100.0 : 0.0;
+
+        bool slower = change > thresholdPercent;
+        bool moreAllocations = result.allocsPerOp >= baseAllocs + 0.5;
+        const char* status = "ok";
+        if (slower && moreAllocations) {
+            status = "REGRESSION (time, allocs)";
+        } else if (slower) {
+            status = "REGRESSION (time)";
+        } else if (moreAllocations) {
+            status = "REGRESSION (allocs)";
+        } else if (change < -thresholdPercent) {
+            status = "faster";
+        }
+        if (slower || moreAllocations) ++regressions;
+
+        char allocs[32];
+        std::snprintf(allocs, sizeof(allocs), "%.1f -> %.1f", baseAllocs, result.allocsPerOp);
+        SDL_Log("%-44s %12s %12s %+8.1f%% %15s  %s", result.name.c_str(), formatTime(baseNs).c_str(),
+                formatTime(result.nsPerOp).c_str(), change, allocs, status);
+    }
+
+    if (regressions > 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%d benchmark(s) regressed against %s", regressions, path.c_str());
+    } else {
+        SDL_Log("No regressions against %s", path.c_str());
+    }
+    return regressions;
+}
+
+void printUsage(const char* programName) {
+    SDL_Log("Usage: %s [options]", programName);
+    SDL_Log("  --filter <text>       Only run benchmarks whose name contains text");
+    SDL_Log("  --min-time <s>        Minimum duration of a measured batch (default: 0.5)");
+    SDL_Log("  --repetitions <n>     Batches per benchmark, median is reported (default: 3)");
+    SDL_Log("  --json <path>         Write results as JSON (usable as a later --baseline)");
+    SDL_Log("  --baseline <path>     Compare with a previous --json run; exit 1 on regression");
+    SDL_Log("  --threshold <pct>     Allowed ns/op slowdown against the baseline (default: 10)");
+    SDL_Log("  --data <dir>          Fixture directory (default: tests/data)");
+    SDL_Log("  --smoke               Run each benchmark once, timings are meaningless");
+    SDL_Log("  --list                List benchmark names and exit");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            options.minTimeSec = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--repetitions" && hasValue) {
+            options.repetitions = std::atoi(argv[++i]);
+        } else if (arg == "--json" && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if (arg == "--baseline" && hasValue) {
+            options.baselinePath = argv[++i];
+        } else if (arg == "--threshold" && hasValue) {
+            options.thresholdPercent = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--data" && hasValue) {
+            options.dataDir = argv[++i];
+        } else if (arg == "--smoke") {
+            options.smoke = true;
+        } else if (arg == "--list") {
+            options.list = true;
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<const bench::Benchmark*> selected;
+    for (const auto& benchmark : bench::registry()) {
+        if (options.filter.empty() || benchmark.name.find(options.filter) != std::string::npos) {
+            selected.push_back(&benchmark);
+        }
+    }
+    std::sort(selected.begin(), selected.end(),
+              [](const bench::Benchmark* a, const bench::Benchmark* b) { return a->name < b->name; });
+
+    if (options.list) {
+        for (const auto* benchmark : selected) SDL_Log("%s", benchmark->name.c_str());
+        return 0;
+    }
+    if (selected.empty()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "No benchmark matches '%s'", options.filter.c_str());
+        return 1;
+    }
+
+#ifndef NDEBUG
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Debug build: timings are not representative");
+#endif
+    SDL_Log("%zu benchmarks, min time %.2fs, %d repetitions%s", selected.size(), options.minTimeSec,
+            options.repetitions, options.smoke ? " (smoke run)" : "");
+    SDL_Log("%-44s %12s %12s %12s %12s", "benchmark", "time/op", "allocs/op", "iterations", "items/s");
+
+    std::vector<Result> results;
+    for (const auto* benchmark : selected) {
+        Result result = measure(*benchmark, options);
+        if (!result.skipped.empty()) {
+            SDL_Log("%-44s skipped: %s", result.name.c_str(), result.skipped.c_str());
+        } else {
+            SDL_Log("%-44s %12s %12.1f %12llu %12s", result.name.c_str(), formatTime(result.nsPerOp).c_str(),
+                    result.allocsPerOp, static_cast<unsigned long long>(result.iterations),
+                    formatRate(result.itemsPerSecond).c_str());
+        }
+        results.push_back(std::move(result));
+    }
+
+    if (!options.jsonPath.empty() && !writeJson(options.jsonPath, results, options)) {
+        return 1;
+    }
+    if (!options.baselinePath.empty()) {
+        int regressions = compareWithBaseline(options.baselinePath, results, options.thresholdPercent);
+        if (regressions != 0) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+/**
+ * Bench - Minimal benchmark harness for vulkan_game_bench
+ *
+ * A benchmark is a function taking a bench::State. Setup goes before the
+ * loop and is not timed; the loop body is the measured operation:
+ *
+ *   BENCHMARK("MLP/forward") {
+ *       MLPNetwork net = makePolicy();
+ *       while (state.keepRunning()) {
+ *           net.forward(input, output);
+ *           bench::doNotOptimize(output);
+ *       }
+ *       state.setItemsPerIteration(1);
+ *   }
+ *
+ * The runner calls the function with growing iteration counts until one
+ * batch lasts --min-time, then reports ns/op, heap allocations/op (every
+ * operator new in the process while the loop runs) and items/sec.
+ */
+namespace bench {
+
+class State {
+public:
+    State(uint64_t iterations, std::string dataDir)
+        : remaining_(iterations), iterations_(iterations), dataDir_(std::move(dataDir)) {}
+
+    // Loop condition; the first call starts the clock, the last stops it
+    bool keepRunning() {
+        if (!started_) start();
+        if (remaining_ == 0) {
+            stop();
+            return false;
+        }
+        --remaining_;
+        return true;
+    }
+
+    uint64_t iterations() const { return iterations_; }
+
+    // Items (poses, queries, entities...) handled by one loop iteration
+    void setItemsPerIteration(double items) { itemsPerIteration_ = items; }
+
+    // Exclude per-iteration setup from timing and allocation counts
+    void pauseTiming();
+    void resumeTiming();
+
+    // Report the benchmark as skipped (e.g. a missing fixture)
+    void skip(std::string reason) { skipReason_ = std::move(reason); }
+
+    // Directory holding the test fixtures (tests/data by default)
+    const std::string& dataDir() const { return dataDir_; }
+
+    // Filled in by the loop, read by the runner
+    double elapsedNs() const { return elapsedNs_; }
+    uint64_t allocations() const { return allocations_; }
+    double itemsPerIteration() const { return itemsPerIteration_; }
+    bool completed() const { return stopped_; }
+    const std::string& skipReason() const { return skipReason_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void start();
+    void stop();
+
+    uint64_t remaining_;
+    uint64_t iterations_;
+    std::string dataDir_;
+
+    bool started_ = false;
+    bool stopped_ = false;
+    bool paused_ = false;
+    Clock::time_point startTime_;
+    uint64_t startAllocations_ = 0;
+    double elapsedNs_ = 0.0;
+    uint64_t allocations_ = 0;
+
+    double itemsPerIteration_ = 0.0;
+    std::string skipReason_;
+};
+
+using BenchmarkFn = void (*)(State&);
+
+// Static registration, used through BENCHMARK()
+struct Registrar {
+    Registrar(const char* name, BenchmarkFn fn);
+};
+
+// Heap allocations made by any thread since startup
+uint64_t allocationCount();
+
+// Keep a computed value alive so the optimizer can't drop the work
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+} // namespace bench
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+
+#define BENCHMARK_IMPL(name, fn)                                          \
+    static void fn(bench::State& state);                                  \
+    static const bench::Registrar BENCH_CONCAT(fn, _registrar){name, fn}; \
+    static void fn([[maybe_unused]] bench::State& state)
+
+#define BENCHMARK(name) BENCHMARK_IMPL(name, BENCH_CONCAT(benchmark_, __LINE__))
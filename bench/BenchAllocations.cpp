@@ -0,0 +1,82 @@
+// Heap allocation counting for vulkan_game_bench. Every global operator new
+// in the executable goes through these replacements, so a benchmark's
+// allocations/op includes containers, std::function and the engine code it
+// calls. Kept apart from Bench.cpp so GCC doesn't pair inlined allocations
+// there with these definitions (-Wmismatched-new-delete).
+
+#include "Bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> allocationCounter{0};
+
+void* allocate(std::size_t size) {
+    allocationCounter.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    allocationCounter.fetch_add(1, std::memory_order_relaxed);
+    size_t align = std::max(static_cast<size_t>(alignment), sizeof(void*));
+#ifdef _WIN32
+    return _aligned_malloc(size ? size : 1, align);
+#else
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, align, size ? size : 1) == 0 ? ptr : nullptr;
+#endif
+}
+
+void freeAligned(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (void* ptr = allocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* ptr = allocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = allocateAligned(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = allocateAligned(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { freeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { freeAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { freeAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { freeAligned(ptr); }
+
+namespace bench {
+
+uint64_t allocationCount() {
+    return allocationCounter.load(std::memory_order_relaxed);
+}
+
+} // namespace bench
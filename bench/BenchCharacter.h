@@ -0,0 +1,101 @@
+#pragma once
+
+// Procedural humanoid used by the animation and motion matching benchmarks:
+// a Mixamo-style 52 joint skeleton (spine, arms with five-finger hands, legs)
+// and looping locomotion clips that key every joint at 30 Hz.
+
+#include "loaders/GLTFLoader.h"
+#include "animation/Animation.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+inline Skeleton makeHumanoidSkeleton() {
+    Skeleton skeleton;
+    auto add = [&](const std::string& name, int32_t parent, glm::vec3 offset) {
+        Joint joint;
+        joint.name = name;
+        joint.parentIndex = parent;
+        joint.localTransform = glm::translate(glm::mat4(1.0f), offset);
+        joint.inverseBindMatrix = glm::mat4(1.0f);
+        skeleton.joints.push_back(joint);
+        return static_cast<int32_t>(skeleton.joints.size() - 1);
+    };
+
+    int32_t hips = add("Hips", -1, {0.0f, 1.0f, 0.0f});
+    int32_t spine = add("Spine", hips, {0.0f, 0.1f, 0.0f});
+    int32_t spine1 = add("Spine1", spine, {0.0f, 0.12f, 0.0f});
+    int32_t spine2 = add("Spine2", spine1, {0.0f, 0.12f, 0.0f});
+    int32_t neck = add("Neck", spine2, {0.0f, 0.15f, 0.0f});
+    add("Head", neck, {0.0f, 0.1f, 0.0f});
+
+    static const char* fingers[] = {"Thumb", "Index", "Middle", "Ring", "Pinky"};
+    for (const char* side : {"Left", "Right"}) {
+        float sign = std::string(side) == "Left" ? 1.0f : -1.0f;
+        int32_t shoulder = add(std::string(side) + "Shoulder", spine2, {sign * 0.08f, 0.12f, 0.0f});
+        int32_t arm = add(std::string(side) + "Arm", shoulder, {sign * 0.12f, 0.0f, 0.0f});
+        int32_t foreArm = add(std::string(side) + "ForeArm", arm, {sign * 0.28f, 0.0f, 0.0f});
+        int32_t hand = add(std::string(side) + "Hand", foreArm, {sign * 0.25f, 0.0f, 0.0f});
+        for (int f = 0; f < 5; ++f) {
+            int32_t parent = hand;
+            for (int segment = 1; segment <= 3; ++segment) {
+                parent = add(std::string(side) + "Hand" + fingers[f] + std::to_string(segment), parent,
+                             {sign * 0.03f, 0.0f, (f - 2) * 0.02f});
+            }
+        }
+
+        int32_t upLeg = add(std::string(side) + "UpLeg", hips, {sign * 0.1f, -0.05f, 0.0f});
+        int32_t leg = add(std::string(side) + "Leg", upLeg, {0.0f, -0.42f, 0.0f});
+        int32_t foot = add(std::string(side) + "Foot", leg, {0.0f, -0.42f, 0.0f});
+        add(std::string(side) + "ToeBase", foot, {0.0f, -0.05f, 0.12f});
+    }
+    return skeleton;
+}
+
+/**
+ * Looping clip with a translation and rotation key per joint every 1/30 s.
+ * The root moves forward at speed m/s; limbs swing with a per-joint phase.
+ */
+inline AnimationClip makeLocomotionClip(const Skeleton& skeleton, const std::string& name,
+                                        float duration, float speed) {
+    AnimationClip clip;
+    clip.name = name;
+    clip.duration = duration;
+    clip.rootBoneIndex = 0;
+    clip.rootMotionPerCycle = glm::vec3(0.0f, 0.0f, speed * duration);
+
+    const int keyCount = static_cast<int>(duration * 30.0f) + 1;
+    const float swing = 0.15f + 0.1f * speed;
+    for (size_t j = 0; j < skeleton.joints.size(); ++j) {
+        AnimationChannel channel;
+        channel.jointIndex = static_cast<int32_t>(j);
+        glm::vec3 bindOffset = glm::vec3(skeleton.joints[j].localTransform[3]);
+        float phase = static_cast<float>(j) * 0.7f;
+
+        for (int k = 0; k < keyCount; ++k) {
+            float t = duration * static_cast<float>(k) / static_cast<float>(keyCount - 1);
+            float cycle = t / duration * 6.2831853f;
+
+            glm::vec3 translation = bindOffset;
+            if (j == 0) {
+                translation.z += speed * t;
+                translation.y += 0.03f * std::sin(2.0f * cycle);
+            }
+            glm::quat rotation = glm::angleAxis(swing * std::sin(cycle + phase), glm::vec3(1.0f, 0.0f, 0.0f));
+
+            channel.translation.times.push_back(t);
+            channel.translation.values.push_back(translation);
+            channel.rotation.times.push_back(t);
+            channel.rotation.values.push_back(rotation);
+        }
+        clip.channels.push_back(std::move(channel));
+    }
+    return clip;
+}
+
+} // namespace bench
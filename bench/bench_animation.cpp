@@ -0,0 +1,90 @@
+// Animation benchmarks: clip sampling, pose blending and the skeleton's
+// local-to-global transform pass, per character per frame.
+
+#include "Bench.h"
+#include "BenchCharacter.h"
+#include "animation/AnimationBlend.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr float FRAME_DT = 1.0f / 60.0f;
+
+SkeletonPose samplePose(const AnimationClip& clip, Skeleton skeleton, float time) {
+    clip.sample(time, skeleton);
+    SkeletonPose pose;
+    pose.resize(skeleton.joints.size());
+    for (size_t i = 0; i < skeleton.joints.size(); ++i) {
+        pose[i] = BonePose::fromMatrix(skeleton.joints[i].localTransform);
+    }
+    return pose;
+}
+
+} // namespace
+
+BENCHMARK("Animation/ClipSample") {
+    Skeleton skeleton = bench::makeHumanoidSkeleton();
+    AnimationClip clip = bench::makeLocomotionClip(skeleton, "walk", 1.2f, 1.5f);
+
+    float time = 0.0f;
+    while (state.keepRunning()) {
+        clip.sample(time, skeleton);
+        time = std::fmod(time + FRAME_DT, clip.duration);
+        bench::doNotOptimize(skeleton.joints.back().localTransform);
+    }
+    state.setItemsPerIteration(static_cast<double>(skeleton.joints.size()));
+}
+
+BENCHMARK("Animation/BlendPoses") {
+    Skeleton skeleton = bench::makeHumanoidSkeleton();
+    AnimationClip walk = bench::makeLocomotionClip(skeleton, "walk", 1.2f, 1.5f);
+    AnimationClip run = bench::makeLocomotionClip(skeleton, "run", 0.8f, 4.0f);
+    SkeletonPose a = samplePose(walk, skeleton, 0.3f);
+    SkeletonPose b = samplePose(run, skeleton, 0.5f);
+    SkeletonPose out;
+    out.resize(a.size());
+
+    float weight = 0.0f;
+    while (state.keepRunning()) {
+        AnimationBlend::blend(a, b, weight, out);
+        weight = weight >= 1.0f ? 0.0f : weight + 0.01f;
+        bench::doNotOptimize(out[out.size() - 1]);
+    }
+    state.setItemsPerIteration(static_cast<double>(a.size()));
+}
+
+BENCHMARK("Animation/GlobalTransforms") {
+    Skeleton skeleton = bench::makeHumanoidSkeleton();
+    skeleton.buildHierarchy();
+    AnimationClip clip = bench::makeLocomotionClip(skeleton, "walk", 1.2f, 1.5f);
+    clip.sample(0.4f, skeleton);
+    std::vector<glm::mat4> globals;
+
+    while (state.keepRunning()) {
+        skeleton.computeGlobalTransforms(globals);
+        bench::doNotOptimize(globals.back());
+    }
+    state.setItemsPerIteration(static_cast<double>(skeleton.joints.size()));
+}
+
+// What an animated character pays each frame before skinning
+BENCHMARK("Animation/CharacterFrame") {
+    Skeleton skeleton = bench::makeHumanoidSkeleton();
+    skeleton.buildHierarchy();
+    AnimationClip clip = bench::makeLocomotionClip(skeleton, "walk", 1.2f, 1.5f);
+    std::vector<glm::mat4> globals;
+    std::vector<glm::mat4> boneMatrices(skeleton.joints.size());
+
+    float time = 0.0f;
+    while (state.keepRunning()) {
+        clip.sample(time, skeleton);
+        skeleton.computeGlobalTransforms(globals);
+        for (size_t i = 0; i < globals.size(); ++i) {
+            boneMatrices[i] = globals[i] * skeleton.joints[i].inverseBindMatrix;
+        }
+        time = std::fmod(time + FRAME_DT, clip.duration);
+        bench::doNotOptimize(boneMatrices.back());
+    }
+    state.setItemsPerIteration(1);
+}
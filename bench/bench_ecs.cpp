@@ -0,0 +1,211 @@
+// ECS system benchmarks: hierarchical transforms, frustum visibility and NPC
+// LOD bookkeeping over populated worlds, one system call per iteration.
+
+#include "Bench.h"
+#include "ecs/World.h"
+#include "ecs/Components.h"
+#include "ecs/Systems.h"
+#include "ecs/SpatialSystem.h"
+#include "core/threading/TaskScheduler.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace ecs;
+
+namespace {
+
+constexpr size_t ROOT_COUNT = 1000;
+constexpr size_t CHAIN_LENGTH = 3;          // Children under each root, one per level
+constexpr size_t LARGE_ROOT_COUNT = 10000;    // x 10 nodes per root = 100k entities
+constexpr size_t CULLED_ENTITY_COUNT = 10000;
+constexpr size_t LARGE_CULLED_COUNT = 200000;
+constexpr size_t MOVED_PER_FRAME = LARGE_CULLED_COUNT / 20;   // 5% of bounds change each frame
+constexpr size_t NPC_COUNT = 2000;
+constexpr float WORLD_EXTENT = 500.0f;
+
+glm::vec3 randomPosition(std::mt19937& rng) {
+    std::uniform_real_distribution<float> coord(-WORLD_EXTENT, WORLD_EXTENT);
+    return {coord(rng), 0.0f, coord(rng)};
+}
+
+// Camera at the origin turning in place, so visibility changes every frame
+std::vector<Frustum> makeCameraSweep(size_t count) {
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 600.0f);
+    std::vector<Frustum> frustums;
+    for (size_t i = 0; i < count; ++i) {
+        float yaw = glm::radians(360.0f * static_cast<float>(i) / static_cast<float>(count));
+        glm::vec3 eye(0.0f, 2.0f, 0.0f);
+        glm::vec3 forward(std::sin(yaw), 0.0f, std::cos(yaw));
+        frustums.push_back(Frustum::fromViewProjection(
+            projection * glm::lookAt(eye, eye + forward, glm::vec3(0.0f, 1.0f, 0.0f))));
+    }
+    return frustums;
+}
+
+} // namespace
+
+BENCHMARK("ECS/UpdateWorldTransforms") {
+    World world;
+    std::mt19937 rng(1);
+    for (size_t i = 0; i < ROOT_COUNT; ++i) {
+        Entity parent = world.create();
+        world.add<LocalTransform>(parent, randomPosition(rng), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f));
+        world.add<Transform>(parent);
+        for (size_t depth = 0; depth < CHAIN_LENGTH; ++depth) {
+            Entity child = world.create();
+            world.add<LocalTransform>(child, glm::vec3(0.0f, 1.0f, 0.5f),
+                                      glm::angleAxis(0.3f, glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(1.0f));
+            world.add<Transform>(child);
+            world.add<Parent>(child, parent);
+            parent = child;
+        }
+    }
+    systems::updateHierarchyDepths(world);
+
+    while (state.keepRunning()) {
+        systems::updateWorldTransforms(world);
+    }
+    state.setItemsPerIteration(static_cast<double>(ROOT_COUNT * (CHAIN_LENGTH + 1)));
+}
+
+// Same tree shape and dirty ratio as Hierarchy/Update100kDirty10: a rolling
+// 10% of entities get their LocalTransform patched each frame, so the timed
+// frame is the dirty marking plus the partitioned update on TaskScheduler workers
+BENCHMARK("ECS/UpdateWorldTransforms100k") {
+    TaskScheduler::instance().initialize();
+
+    World world;
+    std::mt19937 rng(4);
+    std::vector<Entity> entities;
+    entities.reserve(LARGE_ROOT_COUNT * 10);
+    auto addNode = [&](Entity parent, const glm::vec3& position) {
+        Entity entity = world.create();
+        world.add<LocalTransform>(entity, position, glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f));
+        world.add<Transform>(entity);
+        if (parent != NullEntity) world.add<Parent>(entity, parent);
+        entities.push_back(entity);
+        return entity;
+    };
+    for (size_t i = 0; i < LARGE_ROOT_COUNT; ++i) {
+        Entity root = addNode(NullEntity, randomPosition(rng));
+        for (size_t c = 0; c < 3; ++c) {
+            Entity child = addNode(root, glm::vec3(1.0f, 0.5f, 0.0f));
+            for (size_t g = 0; g < 2; ++g) addNode(child, glm::vec3(0.0f, 0.3f, 0.2f));
+        }
+    }
+    std::shuffle(entities.begin(), entities.end(), rng);
+    systems::updateWorldTransforms(world);  // Builds the stored order once
+
+    const size_t dirtyPerFrame = entities.size() / 10;
+    size_t cursor = 0;
+    float offset = 0.0f;
+    while (state.keepRunning()) {
+        offset += 0.01f;
+        for (size_t i = 0; i < dirtyPerFrame; ++i) {
+            world.patch<LocalTransform>(entities[cursor], [offset](LocalTransform& local) {
+                local.position.y = offset;
+            });
+            cursor = (cursor + 1) % entities.size();
+        }
+        systems::updateWorldTransforms(world);
+    }
+    state.setItemsPerIteration(static_cast<double>(entities.size()));
+}
+
+BENCHMARK("ECS/UpdateVisibility") {
+    World world;
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> radius(0.5f, 4.0f);
+    for (size_t i = 0; i < CULLED_ENTITY_COUNT; ++i) {
+        Entity entity = world.create();
+        world.add<Transform>(entity, Transform::fromPosition(randomPosition(rng)));
+        world.add<BoundingSphere>(entity, glm::vec3(0.0f, 1.0f, 0.0f), radius(rng));
+    }
+    std::vector<Frustum> sweep = makeCameraSweep(64);
+
+    systems::updateSpatialIndex(world);  // Builds the index once; nothing moves
+
+    size_t frame = 0;
+    while (state.keepRunning()) {
+        systems::updateSpatialIndex(world);
+        systems::updateVisibility(world, sweep[frame % sweep.size()]);
+        ++frame;
+    }
+    state.setItemsPerIteration(static_cast<double>(CULLED_ENTITY_COUNT));
+}
+
+// Half spheres, half boxes; a rolling 5% of entities moves each frame, so the
+// timed frame is the spatial index refresh (bounds on TaskScheduler workers,
+// proxy moves) plus the frustum query and tag batching
+BENCHMARK("ECS/UpdateVisibility200k") {
+    TaskScheduler::instance().initialize();
+
+    World world;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> radius(0.5f, 4.0f);
+    std::vector<Entity> entities;
+    entities.reserve(LARGE_CULLED_COUNT);
+    for (size_t i = 0; i < LARGE_CULLED_COUNT; ++i) {
+        Entity entity = world.create();
+        world.add<Transform>(entity, Transform::fromPosition(randomPosition(rng)));
+        if (i % 2 == 0) {
+            world.add<BoundingSphere>(entity, glm::vec3(0.0f, 1.0f, 0.0f), radius(rng));
+        } else {
+            float r = radius(rng);
+            world.add<BoundingBox>(entity, glm::vec3(-r, 0.0f, -r), glm::vec3(r, 2.0f * r, r));
+        }
+        entities.push_back(entity);
+    }
+    std::vector<Frustum> sweep = makeCameraSweep(64);
+    systems::updateSpatialIndex(world);  // Builds the index and initial tags
+    systems::updateVisibility(world, sweep[0]);
+
+    size_t frame = 0;
+    size_t nextMoved = 0;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        for (size_t i = 0; i < MOVED_PER_FRAME; ++i) {
+            Entity entity = entities[nextMoved];
+            world.get<Transform>(entity).setPosition(randomPosition(rng));
+            nextMoved = (nextMoved + 1) % entities.size();
+        }
+        state.resumeTiming();
+
+        systems::updateSpatialIndex(world);
+        systems::updateVisibility(world, sweep[frame % sweep.size()]);
+        ++frame;
+    }
+    state.setItemsPerIteration(static_cast<double>(LARGE_CULLED_COUNT));
+}
+
+// LOD bookkeeping NPCSimulation::updateArchetypeMode does before animating
+BENCHMARK("ECS/NPCLODFrame") {
+    World world;
+    std::mt19937 rng(3);
+    for (size_t i = 0; i < NPC_COUNT; ++i) {
+        Entity npc = world.create();
+        world.add<Transform>(npc, Transform::fromPosition(randomPosition(rng) * 0.2f));
+        world.add<NPCLODController>(npc);
+    }
+
+    glm::vec3 camera(0.0f);
+    size_t frame = 0;
+    while (state.keepRunning()) {
+        camera.x = std::sin(static_cast<float>(frame++) * 0.01f) * 40.0f;
+        systems::updateNPCLODLevels(world, camera);
+        systems::tickNPCFrameCounters(world);
+
+        size_t animated = 0;
+        for (auto [entity, transform, lodCtrl] : world.view<Transform, NPCLODController>().each()) {
+            if (!lodCtrl.shouldUpdate()) continue;
+            lodCtrl.framesSinceUpdate = 0;
+            animated += glm::distance(camera, transform.position()) > 0.0f ? 1 : 0;
+        }
+        bench::doNotOptimize(animated);
+    }
+    state.setItemsPerIteration(static_cast<double>(NPC_COUNT));
+}
@@ -0,0 +1,101 @@
+// Transform hierarchy benchmarks: 100k nodes with 10% of them given a new
+// local transform each frame, updated serially and split across workers by
+// root subtree.
+
+#include "Bench.h"
+#include "scene/Transform.h"
+#include "core/threading/TaskScheduler.h"
+#include <glm/glm.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t ROOT_COUNT = 10000;
+constexpr size_t CHILDREN_PER_ROOT = 3;
+constexpr size_t GRANDCHILDREN_PER_CHILD = 2;   // 10 nodes per root, 100k total
+constexpr size_t DIRTY_PERCENT = 10;
+constexpr size_t DIRTY_SETS = 16;               // Distinct dirty selections cycled per frame
+
+struct HierarchyFixture {
+    TransformHierarchy hierarchy;
+    std::vector<TransformHandle> handles;
+    std::vector<std::vector<TransformHandle>> dirtySets;
+};
+
+void buildFixture(HierarchyFixture& fixture) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coord(-500.0f, 500.0f);
+    TransformHierarchy& hierarchy = fixture.hierarchy;
+
+    for (size_t r = 0; r < ROOT_COUNT; ++r) {
+        TransformHandle root = hierarchy.create();
+        hierarchy.setLocal(root, Transform(glm::vec3(coord(rng), 0.0f, coord(rng))));
+        fixture.handles.push_back(root);
+        for (size_t c = 0; c < CHILDREN_PER_ROOT; ++c) {
+            TransformHandle child = hierarchy.create("", root);
+            hierarchy.setLocal(child, Transform(glm::vec3(1.0f, 0.5f, 0.0f), Transform::yRotation(0.4f)));
+            fixture.handles.push_back(child);
+            for (size_t g = 0; g < GRANDCHILDREN_PER_CHILD; ++g) {
+                TransformHandle grandchild = hierarchy.create("", child);
+                hierarchy.setLocal(grandchild, Transform(glm::vec3(0.0f, 0.3f, 0.2f)));
+                fixture.handles.push_back(grandchild);
+            }
+        }
+    }
+    hierarchy.updateWorldMatrices();
+
+    std::uniform_int_distribution<size_t> pick(0, fixture.handles.size() - 1);
+    size_t dirtyCount = fixture.handles.size() * DIRTY_PERCENT / 100;
+    fixture.dirtySets.resize(DIRTY_SETS);
+    for (auto& set : fixture.dirtySets) {
+        for (size_t i = 0; i < dirtyCount; ++i) set.push_back(fixture.handles[pick(rng)]);
+    }
+}
+
+// Animate the frame's dirty selection; setLocal marks each subtree dirty
+void touchDirtySet(HierarchyFixture& fixture, size_t frame) {
+    float angle = static_cast<float>(frame) * 0.01f;
+    for (TransformHandle handle : fixture.dirtySets[frame % DIRTY_SETS]) {
+        fixture.hierarchy.localMut(handle).rotation = Transform::yRotation(angle);
+        fixture.hierarchy.markDirty(handle);
+    }
+}
+
+} // namespace
+
+BENCHMARK("Hierarchy/Update100kDirty10") {
+    HierarchyFixture fixture;
+    buildFixture(fixture);
+
+    size_t frame = 0;
+    while (state.keepRunning()) {
+        touchDirtySet(fixture, frame++);
+        fixture.hierarchy.updateWorldMatrices();
+        bench::doNotOptimize(fixture.hierarchy.getWorldMatrix(fixture.handles.back()));
+    }
+    state.setItemsPerIteration(static_cast<double>(fixture.handles.size()));
+}
+
+BENCHMARK("Hierarchy/Update100kDirty10Parallel") {
+    HierarchyFixture fixture;
+    buildFixture(fixture);
+
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    scheduler.initialize();
+    // A few ranges per worker so uneven subtrees still balance
+    auto ranges = fixture.hierarchy.partitionWorldUpdate(scheduler.getThreadCount() * 4);
+
+    size_t frame = 0;
+    while (state.keepRunning()) {
+        touchDirtySet(fixture, frame++);
+        ScopedTaskGroup group(scheduler);
+        for (const auto& range : ranges) {
+            group.submit([&fixture, range] { fixture.hierarchy.updateWorldMatrices(range); },
+                         TaskScheduler::Priority::High);
+        }
+        group.wait();
+        bench::doNotOptimize(fixture.hierarchy.getWorldMatrix(fixture.handles.back()));
+    }
+    state.setItemsPerIteration(static_cast<double>(fixture.handles.size()));
+}
@@ -0,0 +1,96 @@
+// Light clustering benchmarks: LightClusterGrid assignment of town-like light
+// sets (lanterns, a quarter of them downward spots) over a 400 m square, with
+// the camera turning (everything rebinned), walking (partial reuse) and still
+// (full reuse), next to the distance cull and full sort it replaces.
+
+#include "Bench.h"
+#include "lighting/LightClusterGrid.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr float TOWN_EXTENT = 200.0f;
+constexpr float CULL_RADIUS = 100.0f;
+constexpr float FROXEL_FAR_PLANE = 200.0f;
+
+std::vector<ClusterLight> makeLights(size_t count) {
+    std::mt19937 rng(31);
+    std::uniform_real_distribution<float> coord(-TOWN_EXTENT, TOWN_EXTENT);
+    std::uniform_real_distribution<float> height(2.0f, 6.0f);
+    std::uniform_real_distribution<float> range(6.0f, 15.0f);
+    std::vector<ClusterLight> lights(count);
+    for (size_t i = 0; i < count; ++i) {
+        lights[i].position = glm::vec3(coord(rng), height(rng), coord(rng));
+        lights[i].radius = range(rng);
+        lights[i].id = static_cast<uint32_t>(i);
+        if (i % 4 == 0) {
+            lights[i].direction = glm::vec3(0.0f, -1.0f, 0.0f);
+            lights[i].cosOuterCone = std::cos(glm::radians(40.0f));
+        }
+    }
+    return lights;
+}
+
+glm::mat4 makeProjection() {
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    projection[1][1] *= -1.0f;   // Vulkan clip space, as Camera builds it
+    return projection;
+}
+
+glm::mat4 makeView(const glm::vec3& eye, float yaw) {
+    glm::vec3 forward(std::sin(yaw), 0.0f, std::cos(yaw));
+    return glm::lookAt(eye, eye + forward, glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+// eyeStep / yawStep: camera motion per frame, restarting every 400 frames
+void benchAssign(bench::State& state, size_t count, const glm::vec3& eyeStep, float yawStep) {
+    std::vector<ClusterLight> lights = makeLights(count);
+    glm::mat4 projection = makeProjection();
+    LightClusterGrid grid;
+    grid.setDepthRange(FROXEL_FAR_PLANE, CULL_RADIUS);
+
+    const glm::vec3 start(0.0f, 2.0f, -50.0f);
+    size_t frame = 0;
+    while (state.keepRunning()) {
+        float step = static_cast<float>(frame++ % 400);
+        grid.assign(makeView(start + eyeStep * step, yawStep * step), projection, lights);
+        bench::doNotOptimize(grid.lightIndices().size());
+    }
+    state.setItemsPerIteration(static_cast<double>(count));
+}
+
+// What buildLightBuffer did before clustering: distance cull, then sort
+// every candidate by weight
+void benchDistanceSort(bench::State& state, size_t count) {
+    std::vector<ClusterLight> lights = makeLights(count);
+    glm::vec3 eye(0.0f, 2.0f, -50.0f);
+    glm::vec3 front(0.0f, 0.0f, 1.0f);
+    std::vector<std::pair<float, uint32_t>> candidates;
+    while (state.keepRunning()) {
+        candidates.clear();
+        for (const auto& light : lights) {
+            float distance = glm::length(light.position - eye);
+            if (distance > CULL_RADIUS + light.radius) continue;
+            float facing = 0.25f + 0.75f * std::max(0.0f, glm::dot((light.position - eye) / distance, front));
+            candidates.emplace_back(facing / (distance + 1.0f), light.id);
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const auto& a, const auto& b) { return a.first > b.first; });
+        bench::doNotOptimize(candidates.data());
+    }
+    state.setItemsPerIteration(static_cast<double>(count));
+}
+
+} // namespace
+
+BENCHMARK("Lighting/ClusterAssignTurning1k") { benchAssign(state, 1000, glm::vec3(0.0f), 0.01f); }
+BENCHMARK("Lighting/ClusterAssignTurning4k") { benchAssign(state, 4000, glm::vec3(0.0f), 0.01f); }
+BENCHMARK("Lighting/ClusterAssignWalking4k") { benchAssign(state, 4000, glm::vec3(0.0f, 0.0f, 0.025f), 0.0f); }
+BENCHMARK("Lighting/ClusterAssignStill4k") { benchAssign(state, 4000, glm::vec3(0.0f), 0.0f); }
+BENCHMARK("Lighting/DistanceSort1k") { benchDistanceSort(state, 1000); }
+BENCHMARK("Lighting/DistanceSort4k") { benchDistanceSort(state, 4000); }
@@ -0,0 +1,127 @@
+// MLP inference benchmarks: the CALM low-level controller evaluated on the
+// observation vectors in tests/data/training_test_vectors.json, and the
+// 1024x1024 matrix-vector product that dominates it.
+
+#include "Bench.h"
+#include "ml/MLPNetwork.h"
+#include "ml/Tensor.h"
+#include "ml/calm/LowLevelController.h"
+#include <nlohmann/json.hpp>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <vector>
+
+using namespace ml;
+
+namespace {
+
+constexpr int LATENT_DIM = 64;
+
+struct ObservationFixture {
+    int observationDim = 0;
+    int actionDim = 0;
+    std::vector<Tensor> observations;
+};
+
+bool loadObservations(const std::string& dataDir, ObservationFixture& fixture) {
+    std::ifstream file(dataDir + "/training_test_vectors.json");
+    if (!file) return false;
+    nlohmann::json data = nlohmann::json::parse(file, nullptr, false);
+    if (data.is_discarded()) return false;
+
+    fixture.observationDim = data.value("observation_dim", 0);
+    fixture.actionDim = data.value("num_dofs", 0);
+    for (const auto& test : data.value("observation_tests", nlohmann::json::array())) {
+        std::vector<float> values = test.value("expected_obs", std::vector<float>{});
+        if (static_cast<int>(values.size()) != fixture.observationDim) continue;
+        fixture.observations.emplace_back(1, fixture.observationDim, std::move(values));
+    }
+    return fixture.observationDim > 0 && fixture.actionDim > 0 && !fixture.observations.empty();
+}
+
+// Random weights scaled by fan-in so activations stay in range, as trained ones do
+void randomizeWeights(MLPNetwork& network, std::mt19937& rng) {
+    for (size_t i = 0; i < network.numLayers(); ++i) {
+        const LinearLayer& layer = network.layer(i);
+        std::normal_distribution<float> weight(0.0f, 1.0f / std::sqrt(static_cast<float>(layer.inFeatures)));
+        std::vector<float> weights(static_cast<size_t>(layer.inFeatures) * layer.outFeatures);
+        std::vector<float> bias(static_cast<size_t>(layer.outFeatures));
+        for (float& w : weights) w = weight(rng);
+        for (float& b : bias) b = weight(rng) * 0.1f;
+        network.setLayerWeights(i, std::move(weights), std::move(bias));
+    }
+}
+
+// Layer sizes from LowLevelController's AMPStyleCatNet1 description
+calm::LowLevelController makeController(int observationDim, int actionDim) {
+    std::mt19937 rng(42);
+
+    MLPNetwork styleMLP;
+    styleMLP.addLayer(LATENT_DIM, 512, Activation::ReLU);
+    styleMLP.addLayer(512, 256, Activation::Tanh);
+    randomizeWeights(styleMLP, rng);
+
+    MLPNetwork mainMLP;
+    mainMLP.addLayer(256 + observationDim, 1024, Activation::ReLU);
+    mainMLP.addLayer(1024, 1024, Activation::ReLU);
+    mainMLP.addLayer(1024, 512, Activation::ReLU);
+    randomizeWeights(mainMLP, rng);
+
+    MLPNetwork muHead;
+    muHead.addLayer(512, actionDim, Activation::None);
+    randomizeWeights(muHead, rng);
+
+    StyleConditionedNetwork network;
+    network.setStyleMLP(std::move(styleMLP));
+    network.setMainMLP(std::move(mainMLP));
+
+    calm::LowLevelController controller;
+    controller.setNetwork(std::move(network));
+    controller.setMuHead(std::move(muHead));
+    return controller;
+}
+
+} // namespace
+
+BENCHMARK("MLP/LowLevelControllerEvaluate") {
+    ObservationFixture fixture;
+    if (!loadObservations(state.dataDir(), fixture)) {
+        state.skip("training_test_vectors.json not found in " + state.dataDir());
+        return;
+    }
+    calm::LowLevelController controller = makeController(fixture.observationDim, fixture.actionDim);
+
+    Tensor latent(LATENT_DIM);
+    latent.fill(1.0f);
+    Tensor::l2Normalize(latent);
+    Tensor actions;
+
+    size_t next = 0;
+    while (state.keepRunning()) {
+        controller.evaluate(latent, fixture.observations[next], actions);
+        bench::doNotOptimize(actions[0]);
+        next = (next + 1) % fixture.observations.size();
+    }
+    state.setItemsPerIteration(1);
+}
+
+BENCHMARK("MLP/MatVec1024") {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    std::vector<float> weights(1024 * 1024);
+    for (float& w : weights) w = value(rng);
+    std::vector<float> input(1024);
+    for (float& x : input) x = value(rng);
+
+    Tensor matrix(1024, 1024, std::move(weights));
+    Tensor vec(1, 1024, std::move(input));
+    Tensor out(1024);
+
+    while (state.keepRunning()) {
+        Tensor::matVecMul(matrix, vec, out);
+        bench::doNotOptimize(out[0]);
+    }
+    // Items are multiply-adds
+    state.setItemsPerIteration(1024.0 * 1024.0);
+}
@@ -0,0 +1,105 @@
+// Motion matching benchmarks: database build and pose search, brute force and
+// KD-tree, over a locomotion set of about a thousand poses.
+
+#include "Bench.h"
+#include "BenchCharacter.h"
+#include "animation/MotionDatabase.h"
+#include <string>
+#include <vector>
+
+using namespace MotionMatching;
+
+namespace {
+
+constexpr size_t CLIP_COUNT = 24;
+
+struct LocomotionSet {
+    Skeleton skeleton = bench::makeHumanoidSkeleton();
+    std::vector<AnimationClip> clips;
+
+    LocomotionSet() {
+        clips.reserve(CLIP_COUNT);
+        for (size_t i = 0; i < CLIP_COUNT; ++i) {
+            float speed = 0.25f * static_cast<float>(i);
+            float duration = 2.0f - 0.05f * static_cast<float>(i);
+            clips.push_back(bench::makeLocomotionClip(skeleton, "loco" + std::to_string(i), duration, speed));
+        }
+    }
+
+    void addTo(MotionDatabase& database) const {
+        database.initialize(skeleton, FeatureConfig::locomotion());
+        for (const auto& clip : clips) {
+            const char* gait = clip.getRootMotionSpeed() < 0.1f ? "idle" : "locomotion";
+            database.addClip(&clip, clip.name, true, 30.0f, {gait}, clip.getRootMotionSpeed());
+        }
+    }
+};
+
+DatabaseBuildOptions buildOptions() {
+    DatabaseBuildOptions options;
+    options.pruneStaticPoses = false;
+    options.buildKDTree = true;
+    return options;
+}
+
+// Queries taken from the database itself, nudged so none match exactly
+std::vector<std::pair<Trajectory, PoseFeatures>> makeQueries(const MotionDatabase& database, size_t count) {
+    std::vector<std::pair<Trajectory, PoseFeatures>> queries;
+    for (size_t i = 0; i < count; ++i) {
+        const DatabasePose& pose = database.getPose((i * 7919) % database.getPoseCount());
+        Trajectory trajectory = pose.trajectory;
+        for (size_t s = 0; s < trajectory.sampleCount; ++s) {
+            trajectory.samples[s].velocity *= 1.1f;
+        }
+        PoseFeatures features = pose.poseFeatures;
+        features.rootVelocity *= 0.9f;
+        queries.emplace_back(trajectory, features);
+    }
+    return queries;
+}
+
+void runSearch(bench::State& state, bool useKDTree) {
+    LocomotionSet set;
+    MotionDatabase database;
+    set.addTo(database);
+    database.build(buildOptions());
+
+    MotionMatcher matcher;
+    matcher.setDatabase(&database);
+    auto queries = makeQueries(database, 64);
+
+    SearchOptions options;
+    options.useKDTree = useKDTree;
+
+    size_t next = 0;
+    while (state.keepRunning()) {
+        const auto& [trajectory, features] = queries[next];
+        MatchResult result = matcher.findBestMatch(trajectory, features, options);
+        bench::doNotOptimize(result.cost);
+        next = (next + 1) % queries.size();
+    }
+    state.setItemsPerIteration(1);
+}
+
+} // namespace
+
+BENCHMARK("MotionMatching/DatabaseBuild") {
+    LocomotionSet set;
+    size_t poses = 0;
+    while (state.keepRunning()) {
+        MotionDatabase database;
+        set.addTo(database);
+        database.build(buildOptions());
+        poses = database.getPoseCount();
+        bench::doNotOptimize(poses);
+    }
+    state.setItemsPerIteration(static_cast<double>(poses));
+}
+
+BENCHMARK("MotionMatching/SearchBruteForce") {
+    runSearch(state, false);
+}
+
+BENCHMARK("MotionMatching/SearchKDTree") {
+    runSearch(state, true);
+}
@@ -0,0 +1,56 @@
+// Procedural generation benchmarks: tree skeletons from the built-in presets
+// (as vegetation tiles generate them at load) and detritus branches.
+
+#include "Bench.h"
+#include "vegetation/BranchGenerator.h"
+#include "vegetation/TreeGenerator.h"
+#include "vegetation/TreeOptions.h"
+#include <vector>
+
+namespace {
+
+// Fresh seed per iteration so every tree takes a different shape
+void generateTrees(bench::State& state, TreeOptions options) {
+    TreeGenerator generator;
+    std::vector<BranchDataGPU> branches;
+    std::vector<SectionDataGPU> sections;
+    std::vector<LeafDataGPU> leaves;
+
+    uint32_t seed = 1;
+    while (state.keepRunning()) {
+        options.seed = seed++;
+        TreeMeshData tree = generator.generate(options);
+        TreeGenerator::toGPUFormat(tree, branches, sections, leaves);
+        bench::doNotOptimize(leaves.size());
+    }
+    state.setItemsPerIteration(1);
+}
+
+} // namespace
+
+BENCHMARK("Procedural/TreeOak") {
+    generateTrees(state, TreeOptions::defaultOak());
+}
+
+BENCHMARK("Procedural/TreePine") {
+    generateTrees(state, TreeOptions::defaultPine());
+}
+
+BENCHMARK("Procedural/TreeBirch") {
+    generateTrees(state, TreeOptions::defaultBirch());
+}
+
+BENCHMARK("Procedural/DetritusBranch") {
+    BranchGenerator generator;
+    BranchConfig config;
+    config.childCount = 3;
+    config.gnarliness = 0.3f;
+
+    uint32_t seed = 1;
+    while (state.keepRunning()) {
+        config.seed = seed++;
+        GeneratedBranch branch = generator.generate(config);
+        bench::doNotOptimize(branch.branches.size());
+    }
+    state.setItemsPerIteration(1);
+}
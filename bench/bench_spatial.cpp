@@ -0,0 +1,149 @@
+// Spatial index benchmarks: query cost against entity count for the dynamic
+// AABB tree, next to the linear scan it replaces. Entities are unit-ish boxes
+// scattered over a 1 km square; queries are a 30 m sphere (light gathering,
+// proximity), a camera frustum and a 200 m ray.
+
+#include "Bench.h"
+#include "ecs/SpatialIndex.h"
+#include "ecs/Systems.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <vector>
+
+using namespace ecs;
+
+namespace {
+
+constexpr float WORLD_EXTENT = 500.0f;
+constexpr float QUERY_RADIUS = 30.0f;
+constexpr size_t QUERY_POINTS = 256;
+
+struct SpatialFixture {
+    std::vector<glm::vec3> mins;
+    std::vector<glm::vec3> maxs;
+    SpatialIndex index;
+    std::vector<int32_t> proxies;
+    std::vector<glm::vec3> queryPoints;
+};
+
+void buildFixture(SpatialFixture& fixture, size_t count) {
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<float> coord(-WORLD_EXTENT, WORLD_EXTENT);
+    std::uniform_real_distribution<float> size(0.5f, 4.0f);
+    for (size_t i = 0; i < count; ++i) {
+        glm::vec3 min(coord(rng), 0.0f, coord(rng));
+        glm::vec3 max = min + glm::vec3(size(rng), size(rng), size(rng));
+        fixture.mins.push_back(min);
+        fixture.maxs.push_back(max);
+        fixture.proxies.push_back(fixture.index.insert(min, max, static_cast<uint32_t>(i)));
+    }
+    for (size_t i = 0; i < QUERY_POINTS; ++i) {
+        fixture.queryPoints.emplace_back(coord(rng), 1.0f, coord(rng));
+    }
+}
+
+size_t scanSphere(const SpatialFixture& fixture, const glm::vec3& center, float radius) {
+    size_t hits = 0;
+    for (size_t i = 0; i < fixture.mins.size(); ++i) {
+        glm::vec3 offset = glm::clamp(center, fixture.mins[i], fixture.maxs[i]) - center;
+        hits += glm::dot(offset, offset) <= radius * radius ? 1 : 0;
+    }
+    return hits;
+}
+
+void benchSphereQuery(bench::State& state, size_t count) {
+    SpatialFixture fixture;
+    buildFixture(fixture, count);
+    size_t query = 0;
+    while (state.keepRunning()) {
+        size_t hits = 0;
+        fixture.index.querySphere(fixture.queryPoints[query++ % QUERY_POINTS], QUERY_RADIUS,
+                                  SpatialIndex::ALL_LAYERS, [&](uint32_t) { ++hits; });
+        bench::doNotOptimize(hits);
+    }
+    state.setItemsPerIteration(1);
+}
+
+void benchSphereScan(bench::State& state, size_t count) {
+    SpatialFixture fixture;
+    buildFixture(fixture, count);
+    size_t query = 0;
+    while (state.keepRunning()) {
+        size_t hits = scanSphere(fixture, fixture.queryPoints[query++ % QUERY_POINTS], QUERY_RADIUS);
+        bench::doNotOptimize(hits);
+    }
+    state.setItemsPerIteration(1);
+}
+
+void benchFrustumQuery(bench::State& state, size_t count) {
+    SpatialFixture fixture;
+    buildFixture(fixture, count);
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f);
+    glm::vec3 eye(0.0f, 2.0f, 0.0f);
+    Frustum frustum = Frustum::fromViewProjection(
+        projection * glm::lookAt(eye, eye + glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    while (state.keepRunning()) {
+        size_t visible = 0;
+        fixture.index.queryFrustum(frustum.planes, SpatialIndex::ALL_LAYERS,
+                                   [&](uint32_t, bool) { ++visible; });
+        bench::doNotOptimize(visible);
+    }
+    state.setItemsPerIteration(1);
+}
+
+void benchRaycast(bench::State& state, size_t count) {
+    SpatialFixture fixture;
+    buildFixture(fixture, count);
+    size_t query = 0;
+    while (state.keepRunning()) {
+        const glm::vec3& origin = fixture.queryPoints[query++ % QUERY_POINTS];
+        glm::vec3 direction = glm::normalize(glm::vec3(-origin.x, 0.0f, -origin.z) + glm::vec3(0.001f));
+        size_t candidates = 0;
+        fixture.index.raycast(origin, direction, 200.0f, SpatialIndex::ALL_LAYERS,
+                              [&](uint32_t, float maxDistance) {
+                                  ++candidates;
+                                  return maxDistance;
+                              });
+        bench::doNotOptimize(candidates);
+    }
+    state.setItemsPerIteration(1);
+}
+
+// Whole-tree moves: 5% of the boxes jump each frame, the rest drift inside
+// their fat boxes
+void benchUpdate(bench::State& state, size_t count) {
+    SpatialFixture fixture;
+    buildFixture(fixture, count);
+
+    std::mt19937 rng(22);
+    std::uniform_real_distribution<float> coord(-WORLD_EXTENT, WORLD_EXTENT);
+    size_t next = 0;
+    size_t frame = 0;
+    while (state.keepRunning()) {
+        float drift = (frame++ % 2 == 0) ? 0.05f : -0.05f;
+        for (size_t i = 0; i < count; ++i) {
+            glm::vec3 delta(drift, 0.0f, 0.0f);
+            if (i % 20 == next % 20) delta = glm::vec3(coord(rng), 0.0f, coord(rng)) - fixture.mins[i];
+            fixture.mins[i] += delta;
+            fixture.maxs[i] += delta;
+            fixture.index.update(fixture.proxies[i], fixture.mins[i], fixture.maxs[i]);
+        }
+        ++next;
+    }
+    state.setItemsPerIteration(static_cast<double>(count));
+}
+
+} // namespace
+
+BENCHMARK("Spatial/SphereQuery1k") { benchSphereQuery(state, 1000); }
+BENCHMARK("Spatial/SphereQuery10k") { benchSphereQuery(state, 10000); }
+BENCHMARK("Spatial/SphereQuery100k") { benchSphereQuery(state, 100000); }
+BENCHMARK("Spatial/SphereScan1k") { benchSphereScan(state, 1000); }
+BENCHMARK("Spatial/SphereScan10k") { benchSphereScan(state, 10000); }
+BENCHMARK("Spatial/SphereScan100k") { benchSphereScan(state, 100000); }
+BENCHMARK("Spatial/FrustumQuery10k") { benchFrustumQuery(state, 10000); }
+BENCHMARK("Spatial/FrustumQuery100k") { benchFrustumQuery(state, 100000); }
+BENCHMARK("Spatial/Raycast10k") { benchRaycast(state, 10000); }
+BENCHMARK("Spatial/Raycast100k") { benchRaycast(state, 100000); }
+BENCHMARK("Spatial/Update100k") { benchUpdate(state, 100000); }
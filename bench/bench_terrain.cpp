@@ -0,0 +1,105 @@
+// Terrain query benchmarks: CPU height sampling as used for object placement
+// and physics, tile selection for streaming, and analytic hole tests.
+
+#include "Bench.h"
+#include "terrain/TerrainHeight.h"
+#include "terrain/TileGridLogic.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t HEIGHTMAP_RESOLUTION = 1024;
+constexpr float TERRAIN_SIZE = 16384.0f;
+constexpr float HEIGHT_SCALE = 235.0f;
+constexpr size_t QUERIES_PER_BATCH = 1024;
+
+std::vector<float> makeHeightmap() {
+    std::vector<float> heights(HEIGHTMAP_RESOLUTION * HEIGHTMAP_RESOLUTION);
+    for (uint32_t y = 0; y < HEIGHTMAP_RESOLUTION; ++y) {
+        for (uint32_t x = 0; x < HEIGHTMAP_RESOLUTION; ++x) {
+            float fx = static_cast<float>(x) * 0.013f;
+            float fy = static_cast<float>(y) * 0.017f;
+            heights[y * HEIGHTMAP_RESOLUTION + x] =
+                0.5f + 0.3f * std::sin(fx) * std::cos(fy) + 0.1f * std::sin(fx * 5.3f + fy * 3.1f);
+        }
+    }
+    return heights;
+}
+
+// Scattered world positions, like vegetation placement or NPC grounding
+std::vector<std::pair<float, float>> makeQueryPoints(size_t count) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> coord(-TERRAIN_SIZE * 0.5f, TERRAIN_SIZE * 0.5f);
+    std::vector<std::pair<float, float>> points(count);
+    for (auto& point : points) point = {coord(rng), coord(rng)};
+    return points;
+}
+
+} // namespace
+
+BENCHMARK("Terrain/HeightQuery") {
+    std::vector<float> heights = makeHeightmap();
+    auto points = makeQueryPoints(QUERIES_PER_BATCH);
+
+    while (state.keepRunning()) {
+        float sum = 0.0f;
+        for (const auto& [x, z] : points) {
+            float u, v;
+            TerrainHeight::worldToUV(x, z, TERRAIN_SIZE, u, v);
+            sum += TerrainHeight::sampleWorldHeight(u, v, heights.data(), HEIGHTMAP_RESOLUTION, HEIGHT_SCALE);
+        }
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsPerIteration(static_cast<double>(QUERIES_PER_BATCH));
+}
+
+// Per-frame streaming decision: the LOD and tile wanted around the camera
+BENCHMARK("Terrain/TileSelection") {
+    TileGrid::GridConfig config;
+    const float camX = 1200.0f;
+    const float camZ = -800.0f;
+    const int radius = 16;      // LOD0 tiles in each direction
+
+    size_t tiles = 0;
+    while (state.keepRunning()) {
+        uint64_t keyHash = 0;
+        tiles = 0;
+        TileGrid::TileCoord center = TileGrid::worldToTileCoord(camX, camZ, 0, config);
+        for (int dz = -radius; dz <= radius; ++dz) {
+            for (int dx = -radius; dx <= radius; ++dx) {
+                TileGrid::TileCoord coord{center.x + dx, center.z + dz};
+                if (!TileGrid::isValidTileCoord(coord, 0, config)) continue;
+                float distance = TileGrid::distanceToTile(camX, camZ, coord, 0, config);
+                uint32_t lod = TileGrid::getLODForDistance(distance, config.lodThresholds);
+
+                float centerX, centerZ;
+                TileGrid::getTileCenter(coord, 0, config, centerX, centerZ);
+                TileGrid::TileCoord lodCoord = TileGrid::worldToTileCoord(centerX, centerZ, lod, config);
+                keyHash ^= TileGrid::makeTileKey(lodCoord, lod) * 0x9E3779B97F4A7C15ull;
+                ++tiles;
+            }
+        }
+        bench::doNotOptimize(keyHash);
+    }
+    state.setItemsPerIteration(static_cast<double>(tiles));
+}
+
+BENCHMARK("Terrain/HoleQuery") {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> coord(-TERRAIN_SIZE * 0.5f, TERRAIN_SIZE * 0.5f);
+    std::uniform_real_distribution<float> radius(5.0f, 40.0f);
+    std::vector<TileGrid::TerrainHole> holes(64);
+    for (auto& hole : holes) hole = {coord(rng), coord(rng), radius(rng)};
+    auto points = makeQueryPoints(QUERIES_PER_BATCH);
+
+    while (state.keepRunning()) {
+        size_t inside = 0;
+        for (const auto& [x, z] : points) {
+            inside += TileGrid::isPointInHole(x, z, holes) ? 1 : 0;
+        }
+        bench::doNotOptimize(inside);
+    }
+    state.setItemsPerIteration(static_cast<double>(QUERIES_PER_BATCH));
+}
@@ -8,6 +8,8 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <algorithm>
+#include <cstring>
 
 namespace DDSLoader {
 
@@ -145,27 +147,31 @@ inline bool isBCFormat(VkFormat format) {
     return getBlockSize(format) > 0;
 }
 
-// Read a DDS file
-inline Image load(const std::string& path) {
+// Parse a DDS file already in memory (e.g. read through IOService)
+inline Image loadFromMemory(const uint8_t* bytes, size_t size) {
     Image result{};
     result.format = VK_FORMAT_UNDEFINED;
     result.blockSize = 0;
 
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) {
-        return result;
-    }
+    size_t cursor = 0;
+    auto readBytes = [&](void* dst, size_t count) {
+        if (size - cursor < count) return false;
+        std::memcpy(dst, bytes + cursor, count);
+        cursor += count;
+        return true;
+    };
 
     // Read and verify magic
     uint32_t magic;
-    file.read(reinterpret_cast<char*>(&magic), 4);
-    if (magic != DDS_MAGIC) {
+    if (!readBytes(&magic, 4) || magic != DDS_MAGIC) {
         return result;
     }
 
     // Read header
     Header header;
-    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!readBytes(&header, sizeof(header))) {
+        return result;
+    }
 
     if (header.size != 124 || header.pixelFormat.size != 32) {
         return result;
@@ -181,7 +187,9 @@ inline Image load(const std::string& path) {
 
     if (hasDX10) {
         HeaderDX10 dx10Header;
-        file.read(reinterpret_cast<char*>(&dx10Header), sizeof(dx10Header));
+        if (!readBytes(&dx10Header, sizeof(dx10Header))) {
+            return result;
+        }
 
         switch (dx10Header.dxgiFormat) {
             case DXGIFormat::BC1_UNORM:
@@ -245,9 +253,7 @@ inline Image load(const std::string& path) {
 
     // Read data
     result.data.resize(totalSize);
-    file.read(reinterpret_cast<char*>(result.data.data()), totalSize);
-
-    if (!file.good()) {
+    if (!readBytes(result.data.data(), totalSize)) {
         result.data.clear();
         result.format = VK_FORMAT_UNDEFINED;
     }
@@ -255,4 +261,20 @@ inline Image load(const std::string& path) {
     return result;
 }
 
+// Read a DDS file
+inline Image load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        Image result{};
+        result.format = VK_FORMAT_UNDEFINED;
+        result.blockSize = 0;
+        return result;
+    }
+
+    std::vector<uint8_t> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0, std::ios::beg);
+    file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return loadFromMemory(bytes.data(), static_cast<size_t>(file.gcount()));
+}
+
 } // namespace DDSLoader
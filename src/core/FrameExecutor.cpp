@@ -1,6 +1,18 @@
 #include "FrameExecutor.h"
 #include "VulkanContext.h"
+#include "QueueSubmitDiagnostics.h"
 #include <SDL3/SDL.h>
+#include <chrono>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+float elapsedMs(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+} // namespace
 
 bool FrameExecutor::init(VulkanContext* ctx, uint32_t frameCount) {
     if (!ctx) {
@@ -33,12 +45,16 @@ FrameResult FrameExecutor::execute(const FrameBuilder& builder) {
     if (extent.width == 0 || extent.height == 0) return FrameResult::Skipped;
 
     // Wait for this frame slot to be available
-    frameSync_.waitForCurrentFrameIfNeeded();
+    Clock::time_point frameStart = Clock::now();
+    bool fenceSignaled = frameSync_.isCurrentFrameComplete();
+    if (!fenceSignaled) frameSync_.waitForCurrentFrame();
+    Clock::time_point fenceDone = Clock::now();
 
     // Acquire swapchain image
     uint32_t imageIndex;
     FrameResult acquireResult = acquireImage(imageIndex);
     if (acquireResult != FrameResult::Success) return acquireResult;
+    Clock::time_point acquireDone = Clock::now();
 
     uint32_t frameIndex = frameSync_.currentIndex();
 
@@ -48,14 +64,26 @@ FrameResult FrameExecutor::execute(const FrameBuilder& builder) {
         frameSync_.advance();
         return FrameResult::Skipped;
     }
+    Clock::time_point recordDone = Clock::now();
 
     // Submit
     FrameResult submitResult = submitCommandBuffer(cmd);
     if (submitResult != FrameResult::Success) return submitResult;
+    Clock::time_point submitDone = Clock::now();
 
     // Present
     FrameResult presentResult = present(imageIndex);
 
+    if (diagnostics_) {
+        diagnostics_->fenceWasAlreadySignaled = fenceSignaled;
+        diagnostics_->fenceWaitTimeMs = elapsedMs(frameStart, fenceDone);
+        diagnostics_->acquireImageTimeMs = elapsedMs(fenceDone, acquireDone);
+        diagnostics_->commandRecordTimeMs = elapsedMs(acquireDone, recordDone);
+        diagnostics_->queueSubmitTimeMs = elapsedMs(recordDone, submitDone);
+        diagnostics_->frameToSubmitTimeMs = elapsedMs(frameStart, submitDone);
+        diagnostics_->presentTimeMs = elapsedMs(submitDone, Clock::now());
+    }
+
     // Advance to next frame slot regardless of present result
     frameSync_.advance();
 
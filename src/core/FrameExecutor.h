@@ -26,6 +26,7 @@
 #include <functional>
 
 class VulkanContext;
+struct QueueSubmitDiagnostics;
 
 enum class FrameResult {
     Success,
@@ -67,6 +68,9 @@ public:
 
     void setWindowSuspended(bool suspended) { windowSuspended_ = suspended; }
 
+    // Per-frame fence wait, acquire, record, submit and present times go here
+    void setDiagnostics(QueueSubmitDiagnostics* diagnostics) { diagnostics_ = diagnostics; }
+
 private:
     FrameResult acquireImage(uint32_t& imageIndex);
     FrameResult submitCommandBuffer(VkCommandBuffer cmd);
@@ -74,5 +78,6 @@ private:
 
     TripleBuffering frameSync_;
     VulkanContext* vulkanContext_ = nullptr;
+    QueueSubmitDiagnostics* diagnostics_ = nullptr;
     bool windowSuspended_ = false;
 };
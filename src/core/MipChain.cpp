@@ -0,0 +1,248 @@
+#include "MipChain.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MIPCHAIN_SSE2 1
+#endif
+
+namespace {
+
+// Upper bound for the coverage alpha scale (as in Castaño's reference)
+constexpr float MAX_ALPHA_SCALE = 4.0f;
+constexpr int COVERAGE_SEARCH_STEPS = 16;
+
+inline uint8_t scaleAlpha(uint8_t alpha, float scale) {
+    return static_cast<uint8_t>(std::min(255.0f, alpha * scale + 0.5f));
+}
+
+inline bool passesAlphaTest(uint8_t alpha, float threshold) {
+    return alpha / 255.0f >= threshold;
+}
+
+// Coverage the level would have with its alpha scaled, from a 256-bin histogram
+float histogramCoverage(const uint32_t (&histogram)[256], size_t pixelCount, float scale, float threshold) {
+    size_t passing = 0;
+    for (int a = 0; a < 256; ++a) {
+        if (histogram[a] != 0 && passesAlphaTest(scaleAlpha(static_cast<uint8_t>(a), scale), threshold)) {
+            passing += histogram[a];
+        }
+    }
+    return static_cast<float>(passing) / static_cast<float>(pixelCount);
+}
+
+} // namespace
+
+uint32_t MipChain::levelCountFor(uint32_t width, uint32_t height) {
+    uint32_t size = std::max(width, height);
+    uint32_t levels = 1;
+    while (size > 1) {
+        size >>= 1;
+        ++levels;
+    }
+    return levels;
+}
+
+MipChain MipChain::build(const uint8_t* rgba, uint32_t width, uint32_t height, float alphaTestThreshold) {
+    MipChain chain;
+    if (!rgba || width == 0 || height == 0) {
+        return chain;
+    }
+
+    // Lay out every level first so the whole chain is one allocation
+    uint32_t levelCount = levelCountFor(width, height);
+    chain.levels.resize(levelCount);
+    size_t totalSize = 0;
+    uint32_t w = width;
+    uint32_t h = height;
+    for (Level& level : chain.levels) {
+        level.width = w;
+        level.height = h;
+        level.offset = totalSize;
+        level.size = static_cast<size_t>(w) * h * 4;
+        totalSize += level.size;
+        w = std::max(1u, w / 2);
+        h = std::max(1u, h / 2);
+    }
+    chain.data.resize(totalSize);
+    std::memcpy(chain.data.data(), rgba, chain.levels[0].size);
+
+    bool preserveCoverage = alphaTestThreshold > 0.0f;
+    float targetCoverage = preserveCoverage
+        ? MipGen::alphaCoverage(rgba, static_cast<size_t>(width) * height, alphaTestThreshold)
+        : 0.0f;
+
+    for (uint32_t i = 1; i < levelCount; ++i) {
+        const Level& src = chain.levels[i - 1];
+        const Level& dst = chain.levels[i];
+        uint8_t* dstPixels = chain.data.data() + dst.offset;
+        MipGen::downsample(chain.data.data() + src.offset, src.width, src.height,
+                           dstPixels, dst.width, dst.height);
+        if (preserveCoverage) {
+            MipGen::scaleAlphaToCoverage(dstPixels, static_cast<size_t>(dst.width) * dst.height,
+                                         targetCoverage, alphaTestThreshold);
+        }
+    }
+
+    return chain;
+}
+
+namespace MipGen {
+
+// Per channel: alpha-weighted mean of the 2x2 block (plain mean if the block
+// is fully transparent), rounded; alpha is the rounded plain mean. All sums
+// are exact integers in float, so only the final divide rounds and the SSE2
+// path produces bit-identical results.
+void downsampleScalar(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight,
+                      uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight) {
+    for (uint32_t dy = 0; dy < dstHeight; ++dy) {
+        uint32_t y0 = dy * 2;
+        uint32_t y1 = std::min(y0 + 1, srcHeight - 1);
+        for (uint32_t dx = 0; dx < dstWidth; ++dx) {
+            uint32_t x0 = dx * 2;
+            uint32_t x1 = std::min(x0 + 1, srcWidth - 1);
+            const uint8_t* p[4] = {
+                src + (static_cast<size_t>(y0) * srcWidth + x0) * 4,
+                src + (static_cast<size_t>(y0) * srcWidth + x1) * 4,
+                src + (static_cast<size_t>(y1) * srcWidth + x0) * 4,
+                src + (static_cast<size_t>(y1) * srcWidth + x1) * 4,
+            };
+
+            uint32_t sumA = p[0][3] + p[1][3] + p[2][3] + p[3][3];
+            uint8_t* out = dst + (static_cast<size_t>(dy) * dstWidth + dx) * 4;
+            for (int c = 0; c < 3; ++c) {
+                uint32_t num = 0;
+                for (const uint8_t* px : p) {
+                    num += sumA > 0 ? px[c] * px[3] : px[c];
+                }
+                float div = sumA > 0 ? static_cast<float>(sumA) : 4.0f;
+                out[c] = static_cast<uint8_t>(static_cast<float>(num) / div + 0.5f);
+            }
+            out[3] = static_cast<uint8_t>(static_cast<float>(sumA) / 4.0f + 0.5f);
+        }
+    }
+}
+
+#ifdef MIPCHAIN_SSE2
+
+namespace {
+
+inline __m128 loadPixel(const uint8_t* px) {
+    int32_t packed;
+    std::memcpy(&packed, px, 4);
+    __m128i zero = _mm_setzero_si128();
+    __m128i v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero);
+    return _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero));
+}
+
+inline __m128 broadcastAlpha(__m128 v) {
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+} // namespace
+
+// One output pixel per iteration with the four channels in the four lanes
+void downsample(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight,
+                uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 four = _mm_set1_ps(4.0f);
+    const __m128 alphaLane = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+    for (uint32_t dy = 0; dy < dstHeight; ++dy) {
+        uint32_t y0 = dy * 2;
+        uint32_t y1 = std::min(y0 + 1, srcHeight - 1);
+        const uint8_t* row0 = src + static_cast<size_t>(y0) * srcWidth * 4;
+        const uint8_t* row1 = src + static_cast<size_t>(y1) * srcWidth * 4;
+        uint8_t* out = dst + static_cast<size_t>(dy) * dstWidth * 4;
+
+        for (uint32_t dx = 0; dx < dstWidth; ++dx) {
+            uint32_t x0 = dx * 2 * 4;
+            uint32_t x1 = std::min(dx * 2 + 1, srcWidth - 1) * 4;
+            __m128 p0 = loadPixel(row0 + x0);
+            __m128 p1 = loadPixel(row0 + x1);
+            __m128 p2 = loadPixel(row1 + x0);
+            __m128 p3 = loadPixel(row1 + x1);
+
+            __m128 plainSum = _mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3));
+            __m128 weightedSum = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(p0, broadcastAlpha(p0)), _mm_mul_ps(p1, broadcastAlpha(p1))),
+                _mm_add_ps(_mm_mul_ps(p2, broadcastAlpha(p2)), _mm_mul_ps(p3, broadcastAlpha(p3))));
+            __m128 sumA = broadcastAlpha(plainSum);
+
+            // Fully transparent blocks (and the alpha lane) take the plain mean
+            __m128 usePlain = _mm_or_ps(_mm_cmpeq_ps(sumA, zero), alphaLane);
+            __m128 num = _mm_or_ps(_mm_and_ps(usePlain, plainSum), _mm_andnot_ps(usePlain, weightedSum));
+            __m128 div = _mm_or_ps(_mm_and_ps(usePlain, four), _mm_andnot_ps(usePlain, sumA));
+
+            __m128i result = _mm_cvttps_epi32(_mm_add_ps(_mm_div_ps(num, div), half));
+            result = _mm_packs_epi32(result, result);
+            result = _mm_packus_epi16(result, result);
+            int32_t packed = _mm_cvtsi128_si32(result);
+            std::memcpy(out + static_cast<size_t>(dx) * 4, &packed, 4);
+        }
+    }
+}
+
+#else
+
+void downsample(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight,
+                uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight) {
+    downsampleScalar(src, srcWidth, srcHeight, dst, dstWidth, dstHeight);
+}
+
+#endif
+
+float alphaCoverage(const uint8_t* rgba, size_t pixelCount, float threshold) {
+    if (pixelCount == 0) return 0.0f;
+    size_t passing = 0;
+    for (size_t i = 0; i < pixelCount; ++i) {
+        if (passesAlphaTest(rgba[i * 4 + 3], threshold)) {
+            ++passing;
+        }
+    }
+    return static_cast<float>(passing) / static_cast<float>(pixelCount);
+}
+
+void scaleAlphaToCoverage(uint8_t* rgba, size_t pixelCount, float targetCoverage, float threshold) {
+    if (pixelCount == 0) return;
+
+    uint32_t histogram[256] = {};
+    for (size_t i = 0; i < pixelCount; ++i) {
+        histogram[rgba[i * 4 + 3]]++;
+    }
+
+    float current = histogramCoverage(histogram, pixelCount, 1.0f, threshold);
+    if (current == targetCoverage) return;
+
+    // Coverage only grows with the scale, so bisect for the target
+    float lo = 0.0f;
+    float hi = MAX_ALPHA_SCALE;
+    float bestScale = 1.0f;
+    float bestError = std::abs(current - targetCoverage);
+    for (int step = 0; step < COVERAGE_SEARCH_STEPS; ++step) {
+        float scale = 0.5f * (lo + hi);
+        float coverage = histogramCoverage(histogram, pixelCount, scale, threshold);
+        float error = std::abs(coverage - targetCoverage);
+        if (error < bestError) {
+            bestError = error;
+            bestScale = scale;
+        }
+        if (coverage < targetCoverage) {
+            lo = scale;
+        } else if (coverage > targetCoverage) {
+            hi = scale;
+        } else {
+            break;
+        }
+    }
+
+    if (bestScale == 1.0f) return;
+    for (size_t i = 0; i < pixelCount; ++i) {
+        rgba[i * 4 + 3] = scaleAlpha(rgba[i * 4 + 3], bestScale);
+    }
+}
+
+} // namespace MipGen
@@ -0,0 +1,74 @@
+// CPU mip chain generation for RGBA8 textures
+// Alpha-weighted 2x2 box downsample (SSE2 where available) with alpha
+// coverage preservation for alpha-tested foliage
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A full mip chain packed into one allocation, level 0 first, tightly
+ * packed RGBA8 - the layout copied as-is into a single staging buffer.
+ *
+ * Alpha coverage: an alpha-tested texture's visible area shrinks at lower
+ * mips because averaging pulls alpha below the test threshold. Each level's
+ * alpha is scaled by the factor (found by binary search over the level's
+ * alpha histogram) that gives it the same fraction of pixels passing the
+ * threshold as level 0.
+ *
+ * Pure CPU; safe to build many chains concurrently on TaskScheduler
+ * workers and upload afterwards.
+ */
+struct MipChain {
+    struct Level {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        size_t offset = 0;      // Byte offset into data
+        size_t size = 0;        // Bytes
+    };
+
+    std::vector<Level> levels;
+    std::vector<uint8_t> data;
+
+    bool isValid() const { return !levels.empty(); }
+    uint32_t getWidth() const { return levels.empty() ? 0 : levels[0].width; }
+    uint32_t getHeight() const { return levels.empty() ? 0 : levels[0].height; }
+    uint32_t getLevelCount() const { return static_cast<uint32_t>(levels.size()); }
+    const uint8_t* getLevelData(uint32_t level) const { return data.data() + levels[level].offset; }
+
+    // floor(log2(max(width, height))) + 1
+    static uint32_t levelCountFor(uint32_t width, uint32_t height);
+
+    /**
+     * Build every level down to 1x1 from RGBA8 pixels.
+     * alphaTestThreshold <= 0 disables coverage preservation (plain
+     * alpha-weighted box filter).
+     */
+    static MipChain build(const uint8_t* rgba, uint32_t width, uint32_t height,
+                          float alphaTestThreshold = 0.5f);
+};
+
+namespace MipGen {
+
+/**
+ * One level of alpha-weighted 2x2 box filtering: colour is averaged
+ * weighted by alpha so transparent texels don't bleed their (often black)
+ * colour into the edges; alpha is the plain average. dst is
+ * max(1, src / 2) in each dimension.
+ */
+void downsample(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight,
+                uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight);
+
+// Scalar reference for downsample(); the SIMD path must match it exactly
+void downsampleScalar(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight,
+                      uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight);
+
+// Fraction of pixels whose alpha passes threshold (0-1)
+float alphaCoverage(const uint8_t* rgba, size_t pixelCount, float threshold);
+
+// Scale alpha so alphaCoverage() comes as close to targetCoverage as possible
+void scaleAlphaToCoverage(uint8_t* rgba, size_t pixelCount, float targetCoverage, float threshold);
+
+} // namespace MipGen
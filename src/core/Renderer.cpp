@@ -277,6 +277,10 @@ void Renderer::setupFrameGraph() {
     // Use FrameGraphBuilder to configure all passes and dependencies
     if (!FrameGraphBuilder::build(frameGraph_, *systems_, callbacks, state)) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to build frame graph");
+    } else if (!frameGraph_.realizeTransients(vulkanContext_->getVkDevice(), vulkanContext_->getAllocator())) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate frame graph transients");
+    } else if (!FrameGraphBuilder::bindTransients(frameGraph_, *systems_)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to bind frame graph transients");
     }
 }
 
@@ -331,6 +335,8 @@ void Renderer::cleanup() {
         asyncTransferManager_.shutdown();
         threadedCommandPool_.shutdown();
 
+        frameGraph_.destroyTransients();
+
         // Destroy FrameExecutor (owns TripleBuffering) before its dependencies
         frameExecutor_.destroy();
 
@@ -438,7 +444,10 @@ bool Renderer::render(const Camera& camera) {
 }
 
 VkCommandBuffer Renderer::buildFrame(const Camera& camera, uint32_t imageIndex, uint32_t frameIndex) {
+    systems_->profiler().beginCpuZone("Streaming:Uploads");
     asyncTransferManager_.processPendingTransfers();
+    assetRegistry_.processPendingUploads();
+    systems_->profiler().endCpuZone("Streaming:Uploads");
 
     // Per-frame data updates
     TimingData timing = systems_->time().update();
@@ -451,6 +460,7 @@ VkCommandBuffer Renderer::buildFrame(const Camera& camera, uint32_t imageIndex,
     uboConfig.hdrEnabled = hdrEnabled;
     uboConfig.maxSnowHeight = MAX_SNOW_HEIGHT;
     uboConfig.lightCullRadius = lightCullRadius;
+    uboConfig.lightClusters = &lightClusters_;
     uboConfig.ecsWorld = ecsWorld_;
     uboConfig.deltaTime = timing.deltaTime;
     auto uboResult = UBOUpdater::update(*systems_, frameIndex, camera, uboConfig);
@@ -996,6 +1006,7 @@ bool Renderer::pollAsyncInit() {
         if (progressCallback_) progressCallback_(1.0f, "Ready");
 
         // Clean up async loader
+        asyncLoader_->logCriticalPath();
         asyncLoader_->shutdown();
         asyncLoader_.reset();
 
@@ -21,6 +21,7 @@
 #include "asset/AssetRegistry.h"
 #include "ScenePipeline.h"
 #include "material/DescriptorManager.h"
+#include "LightClusterGrid.h"
 
 // Forward declarations
 class Camera;
@@ -310,6 +311,7 @@ private:
 
     // Dynamic lights
     float lightCullRadius = 100.0f;        // Radius from camera for light culling
+    LightClusterGrid lightClusters_;       // Kept across frames so static lights reuse their clusters
 
     // ECS world for light updates
     ecs::World* ecsWorld_ = nullptr;
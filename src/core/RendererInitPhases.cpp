@@ -650,6 +650,7 @@ std::vector<Loading::SystemInitTask> Renderer::buildInitTasks(const InitContext&
                 SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to initialize FrameExecutor");
                 return false;
             }
+            frameExecutor_.setDiagnostics(&systems_->profiler().getQueueSubmitDiagnostics());
 
             // Debug line system
             auto debugLineSystem = DebugLineSystem::create(*ctxPtr, core.hdr.renderPass);
@@ -749,10 +750,11 @@ void Renderer::initResizeCoordinator() {
     resizeCoordinator_->registerWithExtent(systems_->catmullClark(), "CatmullClarkSystem");
     resizeCoordinator_->registerWithExtent(systems_->skinnedMesh(), "SkinnedMeshRenderer");
 
-    // Register callback for bloom texture rebinding (needed after bloom resize)
-    resizeCoordinator_->registerCallback("BloomRebind",
+    // Rebuild the frame graph after bloom resize: its mip chain is made of
+    // graph transients sized at declaration, rebound to bloom and the composite
+    resizeCoordinator_->registerCallback("FrameGraphRebuild",
         [this](VkExtent2D) {
-            systems_->postProcess().setBloomTexture(systems_->bloom().getBloomOutput(), systems_->bloom().getBloomSampler());
+            setupFrameGraph();
         },
         nullptr,
         ResizePriority::RenderTarget);
@@ -5,9 +5,14 @@
 #include "VmaBufferFactory.h"
 #include "CommandBufferUtils.h"
 #include "ImageBuilder.h"
+#include "MipChain.h"
+#include "threading/TaskScheduler.h"
+#include "io/IOService.h"
+#include "asset/DerivedDataCache.h"
 #include <vulkan/vulkan.hpp>
 #include <cstring>
 #include <algorithm>
+#include <chrono>
 #include <memory>
 
 // Custom deleter for stbi-loaded pixels
@@ -555,148 +560,150 @@ bool Texture::copyBufferToImage(VkDevice device, VkCommandPool commandPool, VkQu
     return cmd.end();
 }
 
-// Generate a single mip level on CPU with alpha-coverage preservation
-// This keeps alpha values high enough to pass alpha testing at lower mip levels
-static void generateMipLevelAlphaCoverage(
-    const uint8_t* srcPixels, int srcWidth, int srcHeight,
-    uint8_t* dstPixels, int dstWidth, int dstHeight,
-    float alphaTestThreshold = 0.5f)
-{
-    for (int dy = 0; dy < dstHeight; ++dy) {
-        for (int dx = 0; dx < dstWidth; ++dx) {
-            // Sample 2x2 block from source
-            int sx = dx * 2;
-            int sy = dy * 2;
-
-            float r = 0, g = 0, b = 0, a = 0;
-            float totalWeight = 0;
-            int passingPixels = 0;
-
-            for (int oy = 0; oy < 2; ++oy) {
-                for (int ox = 0; ox < 2; ++ox) {
-                    int px = std::min(sx + ox, srcWidth - 1);
-                    int py = std::min(sy + oy, srcHeight - 1);
-                    const uint8_t* src = srcPixels + (py * srcWidth + px) * 4;
-
-                    float srcA = src[3] / 255.0f;
-
-                    // Count pixels that pass alpha test
-                    if (srcA >= alphaTestThreshold) {
-                        passingPixels++;
-                    }
-
-                    // Weight RGB by alpha for proper color blending
-                    float weight = srcA;
-                    r += src[0] * weight;
-                    g += src[1] * weight;
-                    b += src[2] * weight;
-                    a += srcA;
-                    totalWeight += weight;
-                }
-            }
-
-            uint8_t* dst = dstPixels + (dy * dstWidth + dx) * 4;
-
-            if (totalWeight > 0.001f) {
-                // Normalize RGB by total weight (alpha-weighted average)
-                dst[0] = static_cast<uint8_t>(std::clamp(r / totalWeight, 0.0f, 255.0f));
-                dst[1] = static_cast<uint8_t>(std::clamp(g / totalWeight, 0.0f, 255.0f));
-                dst[2] = static_cast<uint8_t>(std::clamp(b / totalWeight, 0.0f, 255.0f));
-            } else {
-                dst[0] = dst[1] = dst[2] = 0;
-            }
-
-            // Scale alpha to preserve coverage ratio
-            // If 2 out of 4 pixels passed alpha test, output alpha should also pass
-            float coverageRatio = passingPixels / 4.0f;
-            float avgAlpha = a / 4.0f;
-
-            // Boost alpha to maintain coverage: if any pixels passed, ensure output can pass too
-            float outputAlpha;
-            if (passingPixels > 0) {
-                // Scale alpha so that coverage is preserved
-                // If original coverage was 50% (2/4 pixels), output alpha should be ~threshold
-                outputAlpha = std::max(avgAlpha, coverageRatio * (alphaTestThreshold + 0.1f) + (1.0f - coverageRatio) * avgAlpha);
-                outputAlpha = std::min(outputAlpha, 1.0f);
-            } else {
-                outputAlpha = avgAlpha;
-            }
-
-            dst[3] = static_cast<uint8_t>(outputAlpha * 255.0f);
-        }
+// Mip chain cache blob: level count, per-level width/height, then the packed data
+static void writeMipChain(BlobWriter& out, const MipChain& chain) {
+    out.write(chain.getLevelCount());
+    for (const auto& level : chain.levels) {
+        out.write(level.width);
+        out.write(level.height);
     }
+    out.writeVector(chain.data);
 }
 
-bool Texture::loadWithMipmapsInternal(const std::string& path, VmaAllocator allocator, VkDevice device,
-                                       VkCommandPool commandPool, VkQueue queue, VkPhysicalDevice physicalDevice,
-                                       bool useSRGB, bool enableAnisotropy) {
-    allocator_ = allocator;
-    device_ = device;
+static bool readMipChain(const std::vector<uint8_t>& blob, MipChain& chain) {
+    BlobReader in(blob);
+    uint32_t levelCount = 0;
+    if (!in.read(levelCount) || levelCount == 0 || levelCount > 32) return false;
+    chain.levels.resize(levelCount);
+    size_t offset = 0;
+    for (auto& level : chain.levels) {
+        if (!in.read(level.width) || !in.read(level.height)) return false;
+        level.offset = offset;
+        level.size = static_cast<size_t>(level.width) * level.height * 4;
+        offset += level.size;
+    }
+    return in.readVector(chain.data) && in.atEnd() && chain.data.size() == offset;
+}
 
-    // Load with stb_image (PNG, JPG, etc.)
-    int channels;
-    stbi_uc* pixels = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+MipChain Texture::decodeMipChain(const std::string& path, float alphaTestThreshold) {
+    auto start = std::chrono::steady_clock::now();
+    auto elapsedMs = [&start]() {
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
 
-    if (!pixels) {
+    IOResult file = IOService::instance().readFile(path);
+    if (!file.ok()) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load texture: %s", path.c_str());
-        return false;
+        return MipChain{};
     }
 
-    StbiPixels pixelGuard(pixels);
+    // Keyed on the encoded file, so an edited texture misses automatically
+    DerivedDataCache& cache = DerivedDataCache::instance();
+    DerivedDataKey key("texture-mips-v1");
+    key.bytes(file.data.data(), file.data.size()).value(alphaTestThreshold);
 
-    VkFormat imageFormat = useSRGB ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+    MipChain chain;
+    std::vector<uint8_t> blob;
+    if (cache.load(key, blob)) {
+        if (readMipChain(blob, chain)) {
+            cache.recordLoad("Textures", true, elapsedMs());
+            return chain;
+        }
+        cache.remove(key);
+        chain = MipChain{};
+    }
 
-    // Calculate mip levels
-    uint32_t mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+    int w, h, channels;
+    StbiPixels pixels(stbi_load_from_memory(file.data.data(), static_cast<int>(file.data.size()),
+                                            &w, &h, &channels, STBI_rgb_alpha));
+    if (!pixels) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load texture: %s (%s)", path.c_str(),
+                     stbi_failure_reason());
+        return MipChain{};
+    }
+    chain = MipChain::build(pixels.get(), static_cast<uint32_t>(w), static_cast<uint32_t>(h), alphaTestThreshold);
 
-    // Generate all mip levels on CPU with alpha coverage preservation
-    std::vector<std::vector<uint8_t>> mipData(mipLevels);
-    std::vector<uint32_t> mipWidths(mipLevels);
-    std::vector<uint32_t> mipHeights(mipLevels);
+    if (cache.isEnabled()) {
+        BlobWriter out;
+        writeMipChain(out, chain);
+        cache.store(key, out.data());
+    }
+    cache.recordLoad("Textures", false, elapsedMs());
+    return chain;
+}
 
-    // Level 0 is the original image
-    mipWidths[0] = width;
-    mipHeights[0] = height;
-    mipData[0].resize(width * height * 4);
-    memcpy(mipData[0].data(), pixels, width * height * 4);
+std::unique_ptr<Texture> Texture::createFromMipChain(const MipChain& chain, const std::string& debugName,
+                                                      VmaAllocator allocator, VkDevice device,
+                                                      VkCommandPool commandPool, VkQueue queue,
+                                                      bool useSRGB, bool enableAnisotropy) {
+    auto texture = std::make_unique<Texture>(ConstructToken{});
+    if (!texture->uploadMipChain(chain, debugName, allocator, device, commandPool, queue, useSRGB, enableAnisotropy)) {
+        return nullptr;
+    }
+    return texture;
+}
 
-    // Generate subsequent mip levels
-    for (uint32_t i = 1; i < mipLevels; ++i) {
-        mipWidths[i] = std::max(1u, mipWidths[i-1] / 2);
-        mipHeights[i] = std::max(1u, mipHeights[i-1] / 2);
-        mipData[i].resize(mipWidths[i] * mipHeights[i] * 4);
+std::vector<std::unique_ptr<Texture>> Texture::loadBatchWithMipmaps(const std::vector<std::string>& paths,
+                                                                    VmaAllocator allocator, VkDevice device,
+                                                                    VkCommandPool commandPool, VkQueue queue,
+                                                                    bool useSRGB, bool enableAnisotropy) {
+    // Decode and downsample in parallel; each task owns its own chain
+    std::vector<MipChain> chains(paths.size());
+    {
+        ScopedTaskGroup group(TaskScheduler::instance());
+        for (size_t i = 0; i < paths.size(); ++i) {
+            group.submit([&chains, &paths, i]() {
+                chains[i] = decodeMipChain(paths[i]);
+            });
+        }
+    }
 
-        generateMipLevelAlphaCoverage(
-            mipData[i-1].data(), mipWidths[i-1], mipHeights[i-1],
-            mipData[i].data(), mipWidths[i], mipHeights[i],
-            0.5f  // Alpha test threshold
-        );
+    // Vulkan uploads stay on this thread (the command pool isn't thread safe)
+    std::vector<std::unique_ptr<Texture>> textures(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (chains[i].isValid()) {
+            textures[i] = createFromMipChain(chains[i], paths[i], allocator, device, commandPool, queue,
+                                             useSRGB, enableAnisotropy);
+        }
+        chains[i] = MipChain{};
     }
+    return textures;
+}
 
-    // Calculate total size needed for staging buffer
-    VkDeviceSize totalSize = 0;
-    std::vector<VkDeviceSize> mipOffsets(mipLevels);
-    for (uint32_t i = 0; i < mipLevels; ++i) {
-        mipOffsets[i] = totalSize;
-        totalSize += mipWidths[i] * mipHeights[i] * 4;
+bool Texture::loadWithMipmapsInternal(const std::string& path, VmaAllocator allocator, VkDevice device,
+                                       VkCommandPool commandPool, VkQueue queue, VkPhysicalDevice physicalDevice,
+                                       bool useSRGB, bool enableAnisotropy) {
+    MipChain chain = decodeMipChain(path);
+    if (!chain.isValid()) {
+        return false;
     }
+    return uploadMipChain(chain, path, allocator, device, commandPool, queue, useSRGB, enableAnisotropy);
+}
+
+bool Texture::uploadMipChain(const MipChain& chain, const std::string& path, VmaAllocator allocator, VkDevice device,
+                             VkCommandPool commandPool, VkQueue queue, bool useSRGB, bool enableAnisotropy) {
+    allocator_ = allocator;
+    device_ = device;
+    width = static_cast<int>(chain.getWidth());
+    height = static_cast<int>(chain.getHeight());
 
-    // Create staging buffer for all mip levels
+    VkFormat imageFormat = useSRGB ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+    uint32_t mipLevels = chain.getLevelCount();
+
+    // The chain is already laid out level by level, so it goes into one
+    // staging buffer with a single copy
     ManagedBuffer stagingBuffer;
-    if (!VmaBufferFactory::createStagingBuffer(allocator, totalSize, stagingBuffer)) {
+    if (!VmaBufferFactory::createStagingBuffer(allocator, chain.data.size(), stagingBuffer)) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create staging buffer for texture: %s", path.c_str());
         return false;
     }
 
-    // Copy all mip levels to staging buffer
     uint8_t* data = static_cast<uint8_t*>(stagingBuffer.map());
     if (!data) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to map staging buffer for texture: %s", path.c_str());
         return false;
     }
-    for (uint32_t i = 0; i < mipLevels; ++i) {
-        memcpy(data + mipOffsets[i], mipData[i].data(), mipData[i].size());
-    }
+    memcpy(data, chain.data.data(), chain.data.size());
     stagingBuffer.unmap();
 
     // Create image with mip levels
@@ -747,7 +754,7 @@ bool Texture::loadWithMipmapsInternal(const std::string& path, VmaAllocator allo
         std::vector<vk::BufferImageCopy> regions(mipLevels);
         for (uint32_t i = 0; i < mipLevels; ++i) {
             regions[i] = vk::BufferImageCopy{}
-                .setBufferOffset(mipOffsets[i])
+                .setBufferOffset(chain.levels[i].offset)
                 .setBufferRowLength(0)
                 .setBufferImageHeight(0)
                 .setImageSubresource(vk::ImageSubresourceLayers{}
@@ -756,7 +763,7 @@ bool Texture::loadWithMipmapsInternal(const std::string& path, VmaAllocator allo
                     .setBaseArrayLayer(0)
                     .setLayerCount(1))
                 .setImageOffset({0, 0, 0})
-                .setImageExtent({mipWidths[i], mipHeights[i], 1});
+                .setImageExtent({chain.levels[i].width, chain.levels[i].height, 1});
         }
 
         vk::CommandBuffer vkCmd(cmd.get());
@@ -4,6 +4,9 @@
 #include <vk_mem_alloc.h>
 #include <string>
 #include <memory>
+#include <vector>
+
+struct MipChain;
 
 class Texture {
 public:
@@ -22,6 +25,30 @@ public:
                                                       VmaAllocator allocator, VkDevice device,
                                                       VkCommandPool commandPool, VkQueue queue);
 
+    /**
+     * Decode an image and build its full mip chain on the CPU (alpha
+     * coverage preserved at alphaTestThreshold). Thread safe - no Vulkan
+     * calls. Returns an invalid chain on failure.
+     */
+    static MipChain decodeMipChain(const std::string& path, float alphaTestThreshold = 0.5f);
+
+    // Upload a prebuilt chain through one staging buffer - nullptr on failure
+    static std::unique_ptr<Texture> createFromMipChain(const MipChain& chain, const std::string& debugName,
+                                                        VmaAllocator allocator, VkDevice device,
+                                                        VkCommandPool commandPool, VkQueue queue,
+                                                        bool useSRGB = true, bool enableAnisotropy = true);
+
+    /**
+     * loadFromFileWithMipmaps() for many files: decoding and mip generation
+     * run concurrently on TaskScheduler workers, uploads then happen in
+     * order on the calling thread. Result matches paths; failed entries
+     * are nullptr.
+     */
+    static std::vector<std::unique_ptr<Texture>> loadBatchWithMipmaps(const std::vector<std::string>& paths,
+                                                                      VmaAllocator allocator, VkDevice device,
+                                                                      VkCommandPool commandPool, VkQueue queue,
+                                                                      bool useSRGB = true, bool enableAnisotropy = true);
+
 
     ~Texture();
 
@@ -41,6 +68,8 @@ private:
     bool loadWithMipmapsInternal(const std::string& path, VmaAllocator allocator, VkDevice device,
                                   VkCommandPool commandPool, VkQueue queue, VkPhysicalDevice physicalDevice,
                                   bool useSRGB, bool enableAnisotropy);
+    bool uploadMipChain(const MipChain& chain, const std::string& path, VmaAllocator allocator, VkDevice device,
+                        VkCommandPool commandPool, VkQueue queue, bool useSRGB, bool enableAnisotropy);
     bool createSolidColorInternal(uint8_t r, uint8_t g, uint8_t b, uint8_t a,
                                    VmaAllocator allocator, VkDevice device,
                                    VkCommandPool commandPool, VkQueue queue);
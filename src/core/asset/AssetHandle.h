@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <memory>
+
+/**
+ * AssetHandle - An asset that may still be loading
+ *
+ * Wraps the shared future handed out by WeakCache::acquire(). Every
+ * requester of the same asset holds a copy of the same future, so they all
+ * see it become ready at once.
+ */
+template<typename T>
+class AssetHandle {
+public:
+    using Future = std::shared_future<std::shared_ptr<T>>;
+
+    AssetHandle() = default;
+    explicit AssetHandle(Future future) : future_(std::move(future)) {}
+
+    bool isValid() const { return future_.valid(); }
+
+    bool isReady() const {
+        return isValid() && future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    // The asset if it has finished loading, nullptr while loading or if the load failed
+    std::shared_ptr<T> tryGet() const {
+        return isReady() ? future_.get() : nullptr;
+    }
+
+    // Block until loaded. nullptr if the load failed.
+    std::shared_ptr<T> get() const {
+        return isValid() ? future_.get() : nullptr;
+    }
+
+    const Future& future() const { return future_; }
+
+private:
+    Future future_;
+};
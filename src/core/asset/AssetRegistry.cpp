@@ -1,5 +1,28 @@
 #include "AssetRegistry.h"
 #include <SDL3/SDL_log.h>
+#include <chrono>
+#include <exception>
+
+AssetRegistry::~AssetRegistry() {
+    // Workers capture this; let them finish before the caches go away
+    backgroundTasks_.wait();
+
+    // Nothing will upload what's left, so release anyone still waiting
+    std::deque<PendingUpload> abandoned;
+    {
+        std::lock_guard<std::mutex> lock(uploadMutex_);
+        abandoned.swap(pendingUploads_);
+    }
+    for (auto& upload : abandoned) {
+        if (upload.unnamedMesh) {
+            upload.unnamedMesh->set_value(nullptr);
+        } else if (upload.mesh) {
+            meshCache_.fulfil(upload.key, nullptr);
+        } else {
+            textureCache_.fulfil(upload.key, nullptr);
+        }
+    }
+}
 
 void AssetRegistry::init(VkDevice device, VkPhysicalDevice physicalDevice,
                          VmaAllocator allocator, VkCommandPool commandPool,
@@ -10,44 +33,101 @@ void AssetRegistry::init(VkDevice device, VkPhysicalDevice physicalDevice,
     commandPool_ = commandPool;
     queue_ = queue;
 
+    decodePool_ = TaskScheduler::instance().registerPool("AssetDecode", TaskScheduler::Priority::Normal, 0);
+
     SDL_Log("AssetRegistry initialized");
 }
 
+template<typename T, typename Load>
+std::shared_ptr<T> AssetRegistry::loadDeduplicated(WeakCache<T>& cache, const std::string& key, Load load) {
+    auto lookup = cache.acquire(key);
+    if (lookup.shouldLoad) {
+        std::shared_ptr<T> value;
+        try {
+            value = load();
+        } catch (...) {
+            // Release the waiters as for a failed load, then let the caller see why
+            cache.fulfil(key, nullptr);
+            throw;
+        }
+        cache.fulfil(key, value);
+        return value;
+    }
+
+    // Cached, or in flight. An async load may be waiting on this thread's
+    // processPendingUploads(), so keep pumping while waiting.
+    while (lookup.future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready) {
+        processPendingUploads();
+    }
+    return lookup.future.get();
+}
+
 // ============================================================================
 // Texture Management
 // ============================================================================
 
 std::shared_ptr<Texture> AssetRegistry::loadTexture(const std::string& path,
                                                     const TextureLoadConfig& config) {
-    // Check cache first
-    if (auto cached = textureCache_.get(path)) {
-        return cached;
-    }
+    return loadDeduplicated(textureCache_, path, [&]() -> std::shared_ptr<Texture> {
+        // Load the texture
+        std::unique_ptr<Texture> texPtr;
+        if (config.generateMipmaps) {
+            texPtr = Texture::loadFromFileWithMipmaps(
+                path, allocator_, device_, commandPool_, queue_,
+                physicalDevice_, config.useSRGB, config.enableAnisotropy);
+        } else {
+            texPtr = Texture::loadFromFile(
+                path, allocator_, device_, commandPool_, queue_,
+                physicalDevice_, config.useSRGB);
+        }
 
-    // Load the texture
-    std::unique_ptr<Texture> texPtr;
-    if (config.generateMipmaps) {
-        texPtr = Texture::loadFromFileWithMipmaps(
-            path, allocator_, device_, commandPool_, queue_,
-            physicalDevice_, config.useSRGB, config.enableAnisotropy);
-    } else {
-        texPtr = Texture::loadFromFile(
-            path, allocator_, device_, commandPool_, queue_,
-            physicalDevice_, config.useSRGB);
-    }
+        if (!texPtr) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                         "AssetRegistry: Failed to load texture: %s", path.c_str());
+            return nullptr;
+        }
 
-    if (!texPtr) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                     "AssetRegistry: Failed to load texture: %s", path.c_str());
-        return nullptr;
+        SDL_Log("AssetRegistry: Loaded texture '%s'", path.c_str());
+        return std::shared_ptr<Texture>(texPtr.release());
+    });
+}
+
+AssetHandle<Texture> AssetRegistry::loadTextureAsync(const std::string& path,
+                                                     const TextureLoadConfig& config) {
+    auto lookup = textureCache_.acquire(path);
+    if (!lookup.shouldLoad) {
+        return AssetHandle<Texture>(lookup.future);
     }
 
-    // Convert to shared_ptr and cache
-    auto texture = std::shared_ptr<Texture>(texPtr.release());
-    textureCache_.put(path, texture);
+    TaskScheduler::instance().submit(decodePool_, [this, path, config]() {
+        // Nothing above a worker catches, so a throwing decode resolves the
+        // handle as a failed load instead of leaving its waiters hanging
+        MipChain chain;
+        try {
+            chain = Texture::decodeMipChain(path);
+        } catch (const std::exception& e) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                         "AssetRegistry: Failed to decode texture %s: %s", path.c_str(), e.what());
+        }
+        if (!chain.isValid()) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                         "AssetRegistry: Failed to load texture: %s", path.c_str());
+            textureCache_.fulfil(path, nullptr);
+            return;
+        }
+        if (!config.generateMipmaps) {
+            chain.levels.resize(1);
+            chain.data.resize(chain.levels[0].offset + chain.levels[0].size);
+        }
 
-    SDL_Log("AssetRegistry: Loaded texture '%s'", path.c_str());
-    return texture;
+        PendingUpload upload;
+        upload.key = path;
+        upload.chain = std::move(chain);
+        upload.textureConfig = config;
+        queueUpload(std::move(upload));
+    }, &backgroundTasks_);
+
+    return AssetHandle<Texture>(lookup.future);
 }
 
 std::shared_ptr<Texture> AssetRegistry::createSolidColorTexture(
@@ -91,57 +171,93 @@ std::shared_ptr<Texture> AssetRegistry::getTexture(const std::string& path) {
 // Mesh Management
 // ============================================================================
 
-std::shared_ptr<Mesh> AssetRegistry::createMesh(const MeshConfig& config,
-                                                const std::string& name) {
-    // Check cache if name provided
-    if (!name.empty()) {
-        if (auto cached = meshCache_.get(name)) {
-            return cached;
-        }
-    }
-
-    auto mesh = std::make_shared<Mesh>();
-
+void AssetRegistry::buildMeshGeometry(Mesh& mesh, const MeshConfig& config) {
     switch (config.type) {
         case MeshConfig::Type::Cube:
-            mesh->createCube();
+            mesh.createCube();
             break;
         case MeshConfig::Type::Plane:
-            mesh->createPlane(config.width, config.depth);
+            mesh.createPlane(config.width, config.depth);
             break;
         case MeshConfig::Type::Sphere:
-            mesh->createSphere(config.radius, config.stacks, config.slices);
+            mesh.createSphere(config.radius, config.stacks, config.slices);
             break;
         case MeshConfig::Type::Cylinder:
-            mesh->createCylinder(config.radius, config.height, config.segments);
+            mesh.createCylinder(config.radius, config.height, config.segments);
             break;
         case MeshConfig::Type::Capsule:
-            mesh->createCapsule(config.radius, config.height, config.stacks, config.slices);
+            mesh.createCapsule(config.radius, config.height, config.stacks, config.slices);
             break;
         case MeshConfig::Type::Disc:
-            mesh->createDisc(config.radius, config.segments, config.uvScale);
+            mesh.createDisc(config.radius, config.segments, config.uvScale);
             break;
         case MeshConfig::Type::Rock:
-            mesh->createRock(config.radius, config.subdivisions, config.seed,
+            mesh.createRock(config.radius, config.subdivisions, config.seed,
                             config.roughness, config.asymmetry);
             break;
         case MeshConfig::Type::Custom:
             // Empty mesh for custom - caller should use createCustomMesh instead
             break;
     }
+}
 
-    if (!mesh->upload(allocator_, device_, commandPool_, queue_)) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                     "AssetRegistry: Failed to upload mesh");
-        return nullptr;
+std::shared_ptr<Mesh> AssetRegistry::createMesh(const MeshConfig& config,
+                                                const std::string& name) {
+    auto build = [&]() -> std::shared_ptr<Mesh> {
+        auto mesh = std::make_shared<Mesh>();
+        buildMeshGeometry(*mesh, config);
+
+        if (!mesh->upload(allocator_, device_, commandPool_, queue_)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                         "AssetRegistry: Failed to upload mesh");
+            return nullptr;
+        }
+
+        SDL_Log("AssetRegistry: Created mesh '%s'", name.empty() ? "unnamed" : name.c_str());
+        return mesh;
+    };
+
+    // Only named meshes are cached
+    if (name.empty()) {
+        return build();
     }
+    return loadDeduplicated(meshCache_, name, build);
+}
 
-    if (!name.empty()) {
-        meshCache_.put(name, mesh);
+AssetHandle<Mesh> AssetRegistry::loadMeshAsync(const MeshConfig& config,
+                                               const std::string& name) {
+    PendingUpload upload;
+    AssetHandle<Mesh> handle;
+    if (name.empty()) {
+        upload.unnamedMesh = std::make_shared<std::promise<std::shared_ptr<Mesh>>>();
+        handle = AssetHandle<Mesh>(upload.unnamedMesh->get_future().share());
+    } else {
+        auto lookup = meshCache_.acquire(name);
+        handle = AssetHandle<Mesh>(lookup.future);
+        if (!lookup.shouldLoad) {
+            return handle;
+        }
+        upload.key = name;
     }
 
-    SDL_Log("AssetRegistry: Created mesh '%s'", name.empty() ? "unnamed" : name.c_str());
-    return mesh;
+    TaskScheduler::instance().submit(decodePool_, [this, config, upload = std::move(upload)]() mutable {
+        try {
+            upload.mesh = std::make_shared<Mesh>();
+            buildMeshGeometry(*upload.mesh, config);
+        } catch (const std::exception& e) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                         "AssetRegistry: Failed to build mesh '%s': %s", upload.key.c_str(), e.what());
+            if (upload.unnamedMesh) {
+                upload.unnamedMesh->set_value(nullptr);
+            } else {
+                meshCache_.fulfil(upload.key, nullptr);
+            }
+            return;
+        }
+        queueUpload(std::move(upload));
+    }, &backgroundTasks_);
+
+    return handle;
 }
 
 std::shared_ptr<Mesh> AssetRegistry::createCustomMesh(
@@ -204,6 +320,54 @@ std::shared_ptr<AssetRegistry::ShaderModule> AssetRegistry::getShader(const std:
     return shaderCache_.get(path);
 }
 
+// ============================================================================
+// Background Loads
+// ============================================================================
+
+void AssetRegistry::queueUpload(PendingUpload upload) {
+    std::lock_guard<std::mutex> lock(uploadMutex_);
+    pendingUploads_.push_back(std::move(upload));
+}
+
+size_t AssetRegistry::processPendingUploads() {
+    std::deque<PendingUpload> ready;
+    {
+        std::lock_guard<std::mutex> lock(uploadMutex_);
+        ready.swap(pendingUploads_);
+    }
+
+    for (auto& upload : ready) {
+        if (upload.mesh) {
+            std::shared_ptr<Mesh> mesh = upload.mesh;
+            if (!mesh->upload(allocator_, device_, commandPool_, queue_)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                             "AssetRegistry: Failed to upload mesh");
+                mesh = nullptr;
+            }
+            if (upload.unnamedMesh) {
+                upload.unnamedMesh->set_value(std::move(mesh));
+            } else {
+                meshCache_.fulfil(upload.key, std::move(mesh));
+            }
+            continue;
+        }
+
+        std::unique_ptr<Texture> texPtr = Texture::createFromMipChain(
+            upload.chain, upload.key, allocator_, device_, commandPool_, queue_,
+            upload.textureConfig.useSRGB, upload.textureConfig.enableAnisotropy);
+        if (!texPtr) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                         "AssetRegistry: Failed to upload texture: %s", upload.key.c_str());
+            textureCache_.fulfil(upload.key, nullptr);
+            continue;
+        }
+        SDL_Log("AssetRegistry: Loaded texture '%s'", upload.key.c_str());
+        textureCache_.fulfil(upload.key, std::shared_ptr<Texture>(texPtr.release()));
+    }
+
+    return ready.size();
+}
+
 // ============================================================================
 // Statistics and Maintenance
 // ============================================================================
@@ -213,8 +377,19 @@ AssetRegistry::Stats AssetRegistry::getStats() const {
     stats.textureCount = textureCache_.size();
     stats.meshCount = meshCache_.size();
     stats.shaderCount = shaderCache_.size();
-    stats.textureCacheHits = textureCache_.hits();
+
+    auto textures = textureCache_.stats();
+    stats.textureCacheHits = textures.hits;
+    stats.textureCacheMisses = textures.misses;
+    stats.textureDedupHits = textures.dedupHits;
+
+    auto meshes = meshCache_.stats();
+    stats.meshCacheHits = meshes.hits;
+    stats.meshCacheMisses = meshes.misses;
+    stats.meshDedupHits = meshes.dedupHits;
+
     stats.shaderCacheHits = shaderCache_.hits();
+    stats.loadsInFlight = textureCache_.loadingCount() + meshCache_.loadingCount();
     return stats;
 }
 
@@ -1,15 +1,20 @@
 #pragma once
 
 #include "WeakCache.h"
+#include "AssetHandle.h"
 #include "../Texture.h"
 #include "../Mesh.h"
+#include "../MipChain.h"
 #include "../ShaderLoader.h"
+#include "../threading/TaskScheduler.h"
 
 #include <vulkan/vulkan.h>
 #include <vulkan/vulkan.hpp>
 #include <vk_mem_alloc.h>
 
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 
 // Configuration for texture loading (defined outside class for default argument support)
@@ -62,6 +67,12 @@ struct MeshConfig {
  * - Textures and meshes use shared_ptr (freed when last reference released)
  * - Shaders use shared_ptr with custom deleter (vkDestroyShaderModule)
  * - Caches use weak_ptr for deduplication without preventing cleanup
+ * - Concurrent requests for the same asset share one load; async loads
+ *   decode on TaskScheduler workers and upload in processPendingUploads()
+ *
+ * loadTexture(), createMesh() and processPendingUploads() record on the
+ * registry's command pool, so they stay on the thread that owns it. The
+ * async entry points may be called from any thread.
  *
  * Usage:
  *   AssetRegistry registry;
@@ -71,6 +82,11 @@ struct MeshConfig {
  *   auto tex = registry.loadTexture("assets/textures/brick.png");
  *   auto tex2 = registry.loadTexture("assets/textures/brick.png"); // Same shared_ptr
  *
+ *   // Background load; every requester of the same path gets the same handle
+ *   auto handle = registry.loadTextureAsync("assets/textures/grass.png");
+ *   registry.processPendingUploads();  // once per frame
+ *   if (auto grass = handle.tryGet()) { ... }
+ *
  *   // Resources automatically freed when all shared_ptrs are released
  */
 class AssetRegistry {
@@ -114,7 +130,7 @@ public:
     };
 
     AssetRegistry() = default;
-    ~AssetRegistry() = default;  // RAII: all cleanup is automatic
+    ~AssetRegistry();  // Waits for background decodes; everything else is RAII
 
     // Non-copyable, non-movable
     AssetRegistry(const AssetRegistry&) = delete;
@@ -141,6 +157,14 @@ public:
     std::shared_ptr<Texture> loadTexture(const std::string& path,
                                          const TextureLoadConfig& config = TextureLoadConfig{});
 
+    /**
+     * Load a texture in the background. Decoding and mip generation run on
+     * a worker; the handle resolves once processPendingUploads() has
+     * uploaded it. A cached or in-flight texture returns its existing handle.
+     */
+    AssetHandle<Texture> loadTextureAsync(const std::string& path,
+                                          const TextureLoadConfig& config = TextureLoadConfig{});
+
     /**
      * Create a solid color texture.
      */
@@ -168,6 +192,14 @@ public:
     std::shared_ptr<Mesh> createMesh(const MeshConfig& config,
                                      const std::string& name = "");
 
+    /**
+     * Build a procedural mesh on a worker and upload it in
+     * processPendingUploads(). Named meshes are cached and deduplicated
+     * like textures; unnamed ones always build a new mesh.
+     */
+    AssetHandle<Mesh> loadMeshAsync(const MeshConfig& config,
+                                    const std::string& name = "");
+
     /**
      * Create a mesh from custom geometry.
      */
@@ -200,6 +232,16 @@ public:
      */
     std::shared_ptr<ShaderModule> getShader(const std::string& path);
 
+    // ========================================================================
+    // Background Loads
+    // ========================================================================
+
+    /**
+     * Upload assets whose background work has finished and resolve their
+     * handles. Call once per frame. Returns the number of assets uploaded.
+     */
+    size_t processPendingUploads();
+
     // ========================================================================
     // Statistics
     // ========================================================================
@@ -209,7 +251,13 @@ public:
         size_t meshCount = 0;
         size_t shaderCount = 0;
         size_t textureCacheHits = 0;
+        size_t textureCacheMisses = 0;
+        size_t textureDedupHits = 0;    // Requests that joined a load already in flight
+        size_t meshCacheHits = 0;
+        size_t meshCacheMisses = 0;
+        size_t meshDedupHits = 0;
         size_t shaderCacheHits = 0;
+        size_t loadsInFlight = 0;
     };
 
     Stats getStats() const;
@@ -232,4 +280,27 @@ private:
     WeakCache<Texture> textureCache_;
     WeakCache<Mesh> meshCache_;
     WeakCache<ShaderModule> shaderCache_;
+
+    // Finished on a worker, waiting for its upload
+    struct PendingUpload {
+        std::string key;                    // Cache key, empty for unnamed meshes
+        MipChain chain;                     // Texture loads
+        TextureLoadConfig textureConfig;
+        std::shared_ptr<Mesh> mesh;         // Mesh loads: geometry built, not uploaded
+        std::shared_ptr<std::promise<std::shared_ptr<Mesh>>> unnamedMesh;  // Resolves uncached meshes
+    };
+
+    static void buildMeshGeometry(Mesh& mesh, const MeshConfig& config);
+
+    // Run the load on the calling thread when it owns the cache entry,
+    // otherwise pump uploads until whoever does has finished
+    template<typename T, typename Load>
+    std::shared_ptr<T> loadDeduplicated(WeakCache<T>& cache, const std::string& key, Load load);
+
+    void queueUpload(PendingUpload upload);
+
+    std::mutex uploadMutex_;
+    std::deque<PendingUpload> pendingUploads_;
+    TaskScheduler::PoolId decodePool_ = 0;
+    TaskGroup backgroundTasks_;
 };
@@ -0,0 +1,468 @@
+#include "DerivedDataCache.h"
+#include <SDL3/SDL_log.h>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t ENTRY_MAGIC = 0x31434444;    // "DDC1"
+constexpr uint32_t ENTRY_FORMAT_VERSION = 1;
+constexpr const char* ENTRY_EXTENSION = ".ddc";
+constexpr size_t FILE_HASH_CHUNK = 1 << 20;
+
+struct EntryHeader {
+    uint32_t magic = ENTRY_MAGIC;
+    uint32_t version = ENTRY_FORMAT_VERSION;
+    uint64_t key = 0;
+    uint64_t payloadSize = 0;
+    uint64_t payloadHash = 0;
+};
+
+constexpr uint64_t PRIME1 = 11400714785074694791ull;
+constexpr uint64_t PRIME2 = 14029467366897019727ull;
+constexpr uint64_t PRIME3 = 1609587929392839161ull;
+constexpr uint64_t PRIME4 = 9650029242287828579ull;
+constexpr uint64_t PRIME5 = 2870177450012600261ull;
+
+inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline uint64_t read64(const uint8_t* p) { uint64_t v; std::memcpy(&v, p, 8); return v; }
+inline uint32_t read32(const uint8_t* p) { uint32_t v; std::memcpy(&v, p, 4); return v; }
+
+inline uint64_t round64(uint64_t acc, uint64_t input) {
+    acc += input * PRIME2;
+    acc = rotl(acc, 31);
+    return acc * PRIME1;
+}
+
+inline uint64_t mergeRound(uint64_t acc, uint64_t val) {
+    acc ^= round64(0, val);
+    return acc * PRIME1 + PRIME4;
+}
+
+int64_t fileTimeTicks(const fs::path& path) {
+    std::error_code ec;
+    auto time = fs::last_write_time(path, ec);
+    return ec ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+bool parseEntryKey(const fs::path& path, uint64_t& key) {
+    std::string stem = path.stem().string();
+    if (stem.size() != 16) return false;
+    char* end = nullptr;
+    key = std::strtoull(stem.c_str(), &end, 16);
+    return end == stem.c_str() + stem.size();
+}
+
+std::mutex& instanceMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+DerivedDataCache::Config& pendingInstanceConfig() {
+    static DerivedDataCache::Config config;
+    return config;
+}
+
+std::unique_ptr<DerivedDataCache>& instanceStorage() {
+    static std::unique_ptr<DerivedDataCache> cache;
+    return cache;
+}
+
+} // namespace
+
+// ============================================================================
+// DerivedDataKey
+// ============================================================================
+
+DerivedDataKey::DerivedDataKey(std::string_view kind)
+    : hash_(hash(kind.data(), kind.size())) {
+}
+
+DerivedDataKey& DerivedDataKey::bytes(const void* data, size_t size) {
+    hash_ = hash(data, size, hash_);
+    return *this;
+}
+
+DerivedDataKey& DerivedDataKey::string(std::string_view text) {
+    return bytes(text.data(), text.size());
+}
+
+DerivedDataKey& DerivedDataKey::file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        valid_ = false;
+        return *this;
+    }
+    std::vector<char> chunk(FILE_HASH_CHUNK);
+    while (in) {
+        in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        std::streamsize got = in.gcount();
+        if (got > 0) {
+            bytes(chunk.data(), static_cast<size_t>(got));
+        }
+    }
+    if (in.bad()) {
+        valid_ = false;
+    }
+    return *this;
+}
+
+uint64_t DerivedDataKey::hash(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    const uint8_t* end = p + size;
+    uint64_t h;
+
+    if (size >= 32) {
+        uint64_t v1 = seed + PRIME1 + PRIME2;
+        uint64_t v2 = seed + PRIME2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME1;
+        const uint8_t* limit = end - 32;
+        do {
+            v1 = round64(v1, read64(p));
+            v2 = round64(v2, read64(p + 8));
+            v3 = round64(v3, read64(p + 16));
+            v4 = round64(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        h = mergeRound(h, v1);
+        h = mergeRound(h, v2);
+        h = mergeRound(h, v3);
+        h = mergeRound(h, v4);
+    } else {
+        h = seed + PRIME5;
+    }
+
+    h += static_cast<uint64_t>(size);
+
+    while (p + 8 <= end) {
+        h ^= round64(0, read64(p));
+        h = rotl(h, 27) * PRIME1 + PRIME4;
+        p += 8;
+    }
+    if (p + 4 <= end) {
+        h ^= static_cast<uint64_t>(read32(p)) * PRIME1;
+        h = rotl(h, 23) * PRIME2 + PRIME3;
+        p += 4;
+    }
+    while (p < end) {
+        h ^= (*p) * PRIME5;
+        h = rotl(h, 11) * PRIME1;
+        ++p;
+    }
+
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    h *= PRIME3;
+    h ^= h >> 32;
+    return h;
+}
+
+// ============================================================================
+// DerivedDataCache
+// ============================================================================
+
+DerivedDataCache::DerivedDataCache(ConstructToken) {}
+
+DerivedDataCache::~DerivedDataCache() = default;
+
+std::unique_ptr<DerivedDataCache> DerivedDataCache::create(const Config& config) {
+    auto cache = std::make_unique<DerivedDataCache>(ConstructToken{});
+    cache->initInternal(config);
+    return cache;
+}
+
+void DerivedDataCache::configureInstance(const Config& config) {
+    std::lock_guard<std::mutex> lock(instanceMutex());
+    if (instanceStorage()) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                    "DerivedDataCache: configureInstance() after first use is ignored");
+        return;
+    }
+    pendingInstanceConfig() = config;
+}
+
+DerivedDataCache::Config DerivedDataCache::instanceConfig() {
+    std::lock_guard<std::mutex> lock(instanceMutex());
+    return instanceStorage() ? instanceStorage()->config_ : pendingInstanceConfig();
+}
+
+DerivedDataCache& DerivedDataCache::instance() {
+    std::lock_guard<std::mutex> lock(instanceMutex());
+    auto& cache = instanceStorage();
+    if (!cache) {
+        cache = create(pendingInstanceConfig());
+    }
+    return *cache;
+}
+
+void DerivedDataCache::initInternal(const Config& config) {
+    config_ = config;
+    if (config_.directory.empty()) {
+        return;
+    }
+
+    std::error_code ec;
+    fs::create_directories(config_.directory, ec);
+    if (ec || !fs::is_directory(config_.directory, ec)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "DerivedDataCache: Cannot use %s, caching disabled",
+                    config_.directory.c_str());
+        return;
+    }
+    enabled_ = true;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t removed = 0;
+    std::vector<std::pair<int64_t, uint64_t>> byFileTime;
+    for (const auto& item : fs::directory_iterator(config_.directory, ec)) {
+        const fs::path& path = item.path();
+        uint64_t key = 0;
+        bool isEntry = path.extension() == ENTRY_EXTENSION && parseEntryKey(path, key);
+
+        // Leftover temp files from an interrupted store, and everything on rebuild
+        if (path.extension() == ".tmp" || (isEntry && config_.rebuild)) {
+            std::error_code removeError;
+            fs::remove(path, removeError);
+            if (isEntry) removed++;
+            continue;
+        }
+        if (!isEntry) continue;
+
+        Entry entry;
+        entry.size = static_cast<uint64_t>(item.file_size(ec));
+        entries_[key] = entry;
+        totalBytes_ += entry.size;
+        byFileTime.emplace_back(fileTimeTicks(path), key);
+    }
+
+    // Hits refresh file timestamps, so they carry the LRU order between runs
+    std::sort(byFileTime.begin(), byFileTime.end());
+    for (const auto& [time, key] : byFileTime) {
+        entries_[key].lastUse = ++useSequence_;
+    }
+
+    if (config_.rebuild) {
+        SDL_Log("DerivedDataCache: Rebuilding - cleared %zu entries in %s", removed, config_.directory.c_str());
+    } else {
+        SDL_Log("DerivedDataCache: %zu entries (%.1f MB) in %s", entries_.size(),
+                totalBytes_ / (1024.0 * 1024.0), config_.directory.c_str());
+    }
+
+    evictLocked();
+    loadPreviousTimingsLocked();
+}
+
+std::string DerivedDataCache::entryPath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016" PRIx64 "%s", key, ENTRY_EXTENSION);
+    return (fs::path(config_.directory) / name).string();
+}
+
+std::string DerivedDataCache::timingsPath() const {
+    return (fs::path(config_.directory) / "timings.txt").string();
+}
+
+bool DerivedDataCache::load(const DerivedDataKey& key, std::vector<uint8_t>& out) {
+    if (!enabled_ || !key.isValid()) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (entries_.find(key.get()) == entries_.end()) {
+            return false;
+        }
+    }
+
+    std::string path = entryPath(key.get());
+    std::error_code sizeError;
+    uint64_t fileSize = fs::file_size(path, sizeError);
+    std::ifstream in(path, std::ios::binary);
+    EntryHeader header;
+    bool valid = !sizeError && in && in.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+                 header.magic == ENTRY_MAGIC && header.version == ENTRY_FORMAT_VERSION &&
+                 header.key == key.get();
+    // The payload is the rest of the file; a size from a damaged header
+    // must not drive the allocation below
+    valid = valid && header.payloadSize == fileSize - sizeof(header);
+    if (valid) {
+        out.resize(static_cast<size_t>(header.payloadSize));
+        valid = out.empty() ||
+                in.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
+        valid = valid && DerivedDataKey::hash(out.data(), out.size()) == header.payloadHash;
+    }
+    in.close();
+
+    if (!valid) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "DerivedDataCache: Dropping corrupt entry %s", path.c_str());
+        out.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            corrupt_++;
+        }
+        remove(key);
+        return false;
+    }
+
+    // Refresh the timestamp so LRU order survives restarts
+    std::error_code ec;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key.get());
+    if (it != entries_.end()) {
+        it->second.lastUse = ++useSequence_;
+    }
+    return true;
+}
+
+void DerivedDataCache::store(const DerivedDataKey& key, const std::vector<uint8_t>& blob) {
+    if (!enabled_ || !key.isValid()) {
+        return;
+    }
+
+    EntryHeader header;
+    header.key = key.get();
+    header.payloadSize = blob.size();
+    header.payloadHash = DerivedDataKey::hash(blob.data(), blob.size());
+
+    // Write aside and rename, so a crash never leaves a half-written entry
+    std::string path = entryPath(key.get());
+    std::string tempPath;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tempPath = path + "." + std::to_string(tempCounter_++) + ".tmp";
+    }
+    {
+        std::ofstream outFile(tempPath, std::ios::binary | std::ios::trunc);
+        outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        outFile.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        if (!outFile) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "DerivedDataCache: Failed to write %s", tempPath.c_str());
+            outFile.close();
+            std::error_code ec;
+            fs::remove(tempPath, ec);
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        // Windows won't rename over an existing file
+        fs::remove(path, ec);
+        fs::rename(tempPath, path, ec);
+    }
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return;
+    }
+
+    Entry& entry = entries_[key.get()];
+    totalBytes_ -= entry.size;
+    entry.size = sizeof(header) + blob.size();
+    entry.lastUse = ++useSequence_;
+    totalBytes_ += entry.size;
+    evictLocked();
+}
+
+void DerivedDataCache::remove(const DerivedDataKey& key) {
+    if (!enabled_) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key.get());
+    if (it != entries_.end()) {
+        totalBytes_ -= it->second.size;
+        entries_.erase(it);
+    }
+    std::error_code ec;
+    fs::remove(entryPath(key.get()), ec);
+}
+
+void DerivedDataCache::evictLocked() {
+    if (totalBytes_ <= config_.maxBytes) {
+        return;
+    }
+
+    std::vector<std::pair<uint64_t, uint64_t>> byAge;
+    byAge.reserve(entries_.size());
+    for (const auto& [key, entry] : entries_) {
+        byAge.emplace_back(entry.lastUse, key);
+    }
+    std::sort(byAge.begin(), byAge.end());
+
+    for (const auto& [lastUse, key] : byAge) {
+        if (totalBytes_ <= config_.maxBytes) break;
+        std::error_code ec;
+        fs::remove(entryPath(key), ec);
+        totalBytes_ -= entries_[key].size;
+        entries_.erase(key);
+        evicted_++;
+    }
+}
+
+void DerivedDataCache::recordLoad(const std::string& category, bool hit, float ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CategoryStats& stats = categories_[category];
+    if (hit) {
+        stats.hits++;
+        stats.hitMs += ms;
+    } else {
+        stats.misses++;
+        stats.missMs += ms;
+    }
+}
+
+DerivedDataCache::Stats DerivedDataCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.enabled = enabled_;
+    stats.entries = static_cast<uint32_t>(entries_.size());
+    stats.bytes = totalBytes_;
+    stats.evicted = evicted_;
+    stats.corrupt = corrupt_;
+    stats.categories = categories_;
+    return stats;
+}
+
+void DerivedDataCache::loadPreviousTimingsLocked() {
+    std::ifstream in(timingsPath());
+    std::string category;
+    float avgMs = 0.0f;
+    while (in >> category >> avgMs) {
+        categories_[category].previousColdAvgMs = avgMs;
+    }
+}
+
+void DerivedDataCache::logReport() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_) {
+        SDL_Log("DerivedDataCache: disabled");
+        return;
+    }
+
+    SDL_Log("DerivedDataCache: %zu entries, %.1f MB, %" PRIu64 " evicted, %" PRIu64 " corrupt",
+            entries_.size(), totalBytes_ / (1024.0 * 1024.0), evicted_, corrupt_);
+    SDL_Log("  %-12s %6s %6s %14s %14s", "Category", "Hits", "Misses", "Warm ms/asset", "Cold ms/asset");
+
+    std::ofstream out(timingsPath(), std::ios::trunc);
+    for (const auto& [name, stats] : categories_) {
+        float coldAvg = stats.misses > 0 ? stats.missMs / stats.misses : stats.previousColdAvgMs;
+        if (stats.hits > 0 || stats.misses > 0) {
+            char warm[32] = "-";
+            char cold[32] = "-";
+            if (stats.hits > 0) std::snprintf(warm, sizeof(warm), "%.2f", stats.hitMs / stats.hits);
+            if (coldAvg >= 0.0f) std::snprintf(cold, sizeof(cold), "%.2f", coldAvg);
+            SDL_Log("  %-12s %6u %6u %14s %14s", name.c_str(), stats.hits, stats.misses, warm, cold);
+        }
+        if (coldAvg >= 0.0f) {
+            out << name << ' ' << coldAvg << '\n';
+        }
+    }
+}
@@ -0,0 +1,278 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Cache key: a hash of everything the derived data depends on - the source
+ * file's contents, the import settings and a per-kind format version.
+ * Bump the version string whenever the derived layout or the import code
+ * changes so stale entries simply stop matching.
+ *
+ *   DerivedDataKey key("texture-mips-v1");
+ *   key.bytes(fileData.data(), fileData.size()).value(alphaThreshold);
+ */
+class DerivedDataKey {
+public:
+    explicit DerivedDataKey(std::string_view kind);
+
+    DerivedDataKey& bytes(const void* data, size_t size);
+    DerivedDataKey& string(std::string_view text);
+
+    // Hash the contents of a file; an unreadable file makes the key invalid
+    DerivedDataKey& file(const std::string& path);
+
+    template<typename T>
+    DerivedDataKey& value(const T& v) {
+        static_assert(std::is_trivially_copyable_v<T>, "hash fields individually");
+        return bytes(&v, sizeof(T));
+    }
+
+    bool isValid() const { return valid_; }
+    uint64_t get() const { return hash_; }
+
+    // 64-bit content hash (XXH64)
+    static uint64_t hash(const void* data, size_t size, uint64_t seed = 0);
+
+private:
+    uint64_t hash_ = 0;
+    bool valid_ = true;
+};
+
+/**
+ * Append-only binary writer for cache blobs. Only trivially copyable
+ * values and vectors of them are written raw; structs holding strings or
+ * vectors are written field by field.
+ */
+class BlobWriter {
+public:
+    template<typename T>
+    void write(const T& v) {
+        static_assert(std::is_trivially_copyable_v<T>, "write fields individually");
+        append(&v, sizeof(T));
+    }
+
+    template<typename T>
+    void writeVector(const std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable_v<T>, "write elements individually");
+        write(static_cast<uint64_t>(v.size()));
+        append(v.data(), v.size() * sizeof(T));
+    }
+
+    void writeString(const std::string& s) {
+        write(static_cast<uint64_t>(s.size()));
+        append(s.data(), s.size());
+    }
+
+    std::vector<uint8_t>& data() { return data_; }
+
+private:
+    void append(const void* src, size_t size) {
+        if (size == 0) return;
+        size_t offset = data_.size();
+        data_.resize(offset + size);
+        std::memcpy(data_.data() + offset, src, size);
+    }
+
+    std::vector<uint8_t> data_;
+};
+
+/**
+ * Bounds-checked reader matching BlobWriter. Every read returns false
+ * (and leaves the reader failed) on a truncated blob.
+ */
+class BlobReader {
+public:
+    BlobReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+    explicit BlobReader(const std::vector<uint8_t>& blob) : BlobReader(blob.data(), blob.size()) {}
+
+    template<typename T>
+    bool read(T& v) {
+        static_assert(std::is_trivially_copyable_v<T>, "read fields individually");
+        return take(&v, sizeof(T));
+    }
+
+    template<typename T>
+    bool readVector(std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable_v<T>, "read elements individually");
+        uint64_t count = 0;
+        if (!read(count) || count > remaining() / std::max<size_t>(1, sizeof(T))) {
+            failed_ = true;
+            return false;
+        }
+        v.resize(static_cast<size_t>(count));
+        return take(v.data(), v.size() * sizeof(T));
+    }
+
+    bool readString(std::string& s) {
+        uint64_t length = 0;
+        if (!read(length) || length > remaining()) {
+            failed_ = true;
+            return false;
+        }
+        s.assign(reinterpret_cast<const char*>(data_ + offset_), static_cast<size_t>(length));
+        offset_ += static_cast<size_t>(length);
+        return true;
+    }
+
+    // Read a count prefix for a vector of non-trivial elements, rejecting
+    // counts the remaining bytes can't possibly hold
+    bool readCount(uint64_t& count, size_t minElementSize) {
+        if (!read(count) || count > remaining() / std::max<size_t>(1, minElementSize)) {
+            failed_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    size_t remaining() const { return size_ - offset_; }
+    bool ok() const { return !failed_; }
+    bool atEnd() const { return !failed_ && offset_ == size_; }
+
+private:
+    bool take(void* dst, size_t size) {
+        if (failed_ || size > remaining()) {
+            failed_ = true;
+            return false;
+        }
+        if (size > 0) {
+            std::memcpy(dst, data_ + offset_, size);
+        }
+        offset_ += size;
+        return true;
+    }
+
+    const uint8_t* data_;
+    size_t size_;
+    size_t offset_ = 0;
+    bool failed_ = false;
+};
+
+/**
+ * On-disk derived data cache for startup assets.
+ *
+ * Maps a DerivedDataKey to a ready-to-use blob (decoded mip chains,
+ * imported vertex/index data, skeletons and clips) so a warm launch skips
+ * image decoding, FBX/glTF parsing and post-processing. One file per
+ * entry; each is checksummed and a corrupt or truncated entry is deleted
+ * and treated as a miss.
+ *
+ * - LRU eviction by size: hits refresh the entry's timestamp, so the
+ *   order survives restarts
+ * - rebuild: drop every existing entry at startup (--rebuild-cache)
+ * - Per-category hit/miss timings; logReport() compares the warm (hit)
+ *   cost against the cold (miss) cost recorded by the last launch that
+ *   had to build the assets
+ *
+ * Thread safe: loaders call it from TaskScheduler workers.
+ *
+ * Usage:
+ *   DerivedDataKey key("texture-mips-v1");
+ *   key.file(path);
+ *   std::vector<uint8_t> blob;
+ *   if (!cache.load(key, blob)) {
+ *       blob = buildExpensively();
+ *       cache.store(key, blob);
+ *   }
+ */
+class DerivedDataCache {
+public:
+    struct Config {
+        std::string directory;              // Empty disables the cache
+        uint64_t maxBytes = 1ull << 30;
+        bool rebuild = false;
+    };
+
+    struct CategoryStats {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        float hitMs = 0.0f;                 // Total time spent on hits this run
+        float missMs = 0.0f;                // Total time spent building on misses this run
+        float previousColdAvgMs = -1.0f;    // Per-asset miss cost from an earlier run (-1 = unknown)
+    };
+
+    struct Stats {
+        bool enabled = false;
+        uint32_t entries = 0;
+        uint64_t bytes = 0;
+        uint64_t evicted = 0;
+        uint64_t corrupt = 0;
+        std::map<std::string, CategoryStats> categories;
+    };
+
+    // Passkey for controlled construction via make_unique
+    struct ConstructToken { explicit ConstructToken() = default; };
+    explicit DerivedDataCache(ConstructToken);
+
+    /**
+     * Factory: open (creating if needed) the cache directory. A directory
+     * that can't be created leaves the cache disabled rather than failing.
+     */
+    static std::unique_ptr<DerivedDataCache> create(const Config& config);
+
+    /**
+     * Process-wide cache used by the loaders. Disabled until the
+     * application configures a directory; configureInstance() only takes
+     * effect before the first instance() call.
+     */
+    static void configureInstance(const Config& config);
+    static Config instanceConfig();
+    static DerivedDataCache& instance();
+
+    ~DerivedDataCache();
+
+    DerivedDataCache(const DerivedDataCache&) = delete;
+    DerivedDataCache& operator=(const DerivedDataCache&) = delete;
+
+    bool isEnabled() const { return enabled_; }
+
+    // Fetch an entry. False on a miss, an invalid key or a corrupt entry.
+    bool load(const DerivedDataKey& key, std::vector<uint8_t>& out);
+
+    // Write an entry (replacing any existing one) and evict down to budget
+    void store(const DerivedDataKey& key, const std::vector<uint8_t>& blob);
+
+    // Drop an entry whose blob turned out to be unusable
+    void remove(const DerivedDataKey& key);
+
+    // Account one asset's load time under a category ("Textures", ...)
+    void recordLoad(const std::string& category, bool hit, float ms);
+
+    Stats getStats() const;
+
+    // Log the cold vs warm table and remember this run's cold costs
+    void logReport();
+
+private:
+    struct Entry {
+        uint64_t size = 0;
+        uint64_t lastUse = 0;       // Use sequence, for LRU
+    };
+
+    void initInternal(const Config& config);
+    std::string entryPath(uint64_t key) const;
+    std::string timingsPath() const;
+    void evictLocked();
+    void loadPreviousTimingsLocked();
+
+    Config config_;
+    bool enabled_ = false;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Entry> entries_;
+    uint64_t totalBytes_ = 0;
+    uint64_t evicted_ = 0;
+    uint64_t corrupt_ = 0;
+    uint64_t tempCounter_ = 0;
+    uint64_t useSequence_ = 0;
+    std::map<std::string, CategoryStats> categories_;
+};
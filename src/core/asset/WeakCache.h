@@ -1,5 +1,9 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -12,62 +16,156 @@
  * references to an object are released, the object is automatically destroyed
  * and the cache entry becomes stale (returns nullptr on lookup).
  *
+ * Keys are spread over ShardCount independently locked maps, so threads
+ * looking up different assets rarely contend.
+ *
+ * Loads in flight are deduplicated: acquire() hands the first requester
+ * the job of loading and every later requester the same shared_future,
+ * which resolves when the loader calls fulfil().
+ *
  * Usage:
  *   WeakCache<Texture> cache;
  *   cache.put("brick", texturePtr);
  *   auto tex = cache.get("brick");  // Returns shared_ptr or nullptr if expired
+ *
+ *   auto lookup = cache.acquire("grass");
+ *   if (lookup.shouldLoad) cache.fulfil("grass", load());
+ *   auto grass = lookup.future.get();
  */
-template<typename T>
+template<typename T, size_t ShardCount = 16>
 class WeakCache {
 public:
+    using Future = std::shared_future<std::shared_ptr<T>>;
+
+    struct Lookup {
+        Future future;
+        bool shouldLoad = false;  // Caller owns the load and must call fulfil()
+    };
+
+    struct Stats {
+        size_t hits = 0;       // Served from a live entry
+        size_t misses = 0;     // Started a load
+        size_t dedupHits = 0;  // Joined a load already in flight
+    };
+
     /**
      * Get an item from the cache.
-     * Returns nullptr if not found or if the weak_ptr has expired.
+     * Returns nullptr if not found, expired, or still loading.
      * Automatically removes stale entries on access.
      */
     std::shared_ptr<T> get(const std::string& key) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            if (auto ptr = it->second.lock()) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end() && !it->second.loading) {
+            if (auto ptr = it->second.value.lock()) {
                 hits_++;
                 return ptr;
             }
             // Expired - remove stale entry
-            cache_.erase(it);
+            shard.entries.erase(it);
         }
         return nullptr;
     }
 
+    /**
+     * Get a live item, join its in-flight load, or become its loader.
+     */
+    Lookup acquire(const std::string& key) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        Entry& entry = shard.entries[key];
+        if (entry.loading) {
+            dedupHits_++;
+            return {entry.future, false};
+        }
+        if (auto ptr = entry.value.lock()) {
+            hits_++;
+            std::promise<std::shared_ptr<T>> ready;
+            ready.set_value(std::move(ptr));
+            return {ready.get_future().share(), false};
+        }
+
+        misses_++;
+        entry.loading = true;
+        entry.promise = std::make_shared<std::promise<std::shared_ptr<T>>>();
+        entry.future = entry.promise->get_future().share();
+        return {entry.future, true};
+    }
+
+    /**
+     * Finish a load started by acquire(). A null value resolves waiters
+     * with nullptr and drops the entry so the next request retries.
+     */
+    void fulfil(const std::string& key, std::shared_ptr<T> value) {
+        std::shared_ptr<std::promise<std::shared_ptr<T>>> promise;
+        {
+            Shard& shard = shardFor(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.entries.find(key);
+            if (it == shard.entries.end() || !it->second.loading) {
+                return;
+            }
+            promise = std::move(it->second.promise);
+            if (value) {
+                it->second = Entry{};
+                it->second.value = value;
+            } else {
+                shard.entries.erase(it);
+            }
+        }
+        // Outside the lock - waiters may immediately call back into the cache
+        promise->set_value(std::move(value));
+    }
+
     /**
      * Store an item in the cache.
-     * Overwrites any existing entry with the same key.
+     * Overwrites any existing entry with the same key; a load in flight
+     * for it resolves to this value.
      */
     void put(const std::string& key, std::shared_ptr<T> value) {
         if (!value) return;
-        std::lock_guard<std::mutex> lock(mutex_);
-        cache_[key] = value;
+        std::shared_ptr<std::promise<std::shared_ptr<T>>> promise;
+        {
+            Shard& shard = shardFor(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            Entry& entry = shard.entries[key];
+            if (entry.loading) {
+                promise = std::move(entry.promise);
+            }
+            entry = Entry{};
+            entry.value = value;
+        }
+        if (promise) {
+            promise->set_value(std::move(value));
+        }
     }
 
     /**
-     * Remove an item from the cache.
+     * Remove an item from the cache. Loads in flight are left alone.
      */
     void remove(const std::string& key) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        cache_.erase(key);
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end() && !it->second.loading) {
+            shard.entries.erase(it);
+        }
     }
 
     /**
      * Check if key exists and is not expired.
      */
     bool contains(const std::string& key) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            if (!it->second.expired()) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end() && !it->second.loading) {
+            if (!it->second.value.expired()) {
                 return true;
             }
-            cache_.erase(it);
+            shard.entries.erase(it);
         }
         return false;
     }
@@ -76,10 +174,26 @@ public:
      * Get count of non-expired entries.
      */
     size_t size() const {
-        std::lock_guard<std::mutex> lock(mutex_);
         size_t count = 0;
-        for (const auto& [key, wp] : cache_) {
-            if (!wp.expired()) count++;
+        for (const Shard& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (const auto& [key, entry] : shard.entries) {
+                if (!entry.loading && !entry.value.expired()) count++;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Get count of loads in flight.
+     */
+    size_t loadingCount() const {
+        size_t count = 0;
+        for (const Shard& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (const auto& [key, entry] : shard.entries) {
+                if (entry.loading) count++;
+            }
         }
         return count;
     }
@@ -88,8 +202,15 @@ public:
      * Get cache hit count.
      */
     size_t hits() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return hits_;
+        return hits_.load();
+    }
+
+    Stats stats() const {
+        Stats s;
+        s.hits = hits_.load();
+        s.misses = misses_.load();
+        s.dedupHits = dedupHits_.load();
+        return s;
     }
 
     /**
@@ -97,29 +218,53 @@ public:
      * Returns number of entries removed.
      */
     size_t prune() {
-        std::lock_guard<std::mutex> lock(mutex_);
         size_t removed = 0;
-        for (auto it = cache_.begin(); it != cache_.end();) {
-            if (it->second.expired()) {
-                it = cache_.erase(it);
-                removed++;
-            } else {
-                ++it;
+        for (Shard& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+                if (!it->second.loading && it->second.value.expired()) {
+                    it = shard.entries.erase(it);
+                    removed++;
+                } else {
+                    ++it;
+                }
             }
         }
         return removed;
     }
 
     /**
-     * Clear all entries from the cache.
+     * Clear all entries from the cache. Loads in flight are kept so their
+     * fulfil() still reaches the waiters.
      */
     void clear() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        cache_.clear();
+        for (Shard& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+                it = it->second.loading ? std::next(it) : shard.entries.erase(it);
+            }
+        }
     }
 
 private:
-    std::unordered_map<std::string, std::weak_ptr<T>> cache_;
-    mutable size_t hits_ = 0;
-    mutable std::mutex mutex_;
+    struct Entry {
+        std::weak_ptr<T> value;
+        bool loading = false;
+        std::shared_ptr<std::promise<std::shared_ptr<T>>> promise;
+        Future future;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+    };
+
+    Shard& shardFor(const std::string& key) {
+        return shards_[std::hash<std::string>{}(key) % ShardCount];
+    }
+
+    std::array<Shard, ShardCount> shards_;
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+    std::atomic<size_t> dedupHits_{0};
 };
@@ -0,0 +1,810 @@
+#include "IOService.h"
+#include "debug/ThreadProfiler.h"
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef HAVE_LIBURING
+#include <liburing.h>
+#endif
+
+namespace {
+
+constexpr intptr_t INVALID_FILE = -1;
+
+float toMs(IOService::Clock::duration duration) {
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+const char* backendName(IOService::Backend backend) {
+    return backend == IOService::Backend::IoUring ? "io_uring" : "thread pool";
+}
+
+#ifdef _WIN32
+
+// FILE* positions are per handle, so Windows handles are never shared
+intptr_t openFile(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    return file ? reinterpret_cast<intptr_t>(file) : INVALID_FILE;
+}
+
+void closeFile(intptr_t handle) {
+    std::fclose(reinterpret_cast<std::FILE*>(handle));
+}
+
+bool queryFileSize(intptr_t handle, uint64_t& size) {
+    auto* file = reinterpret_cast<std::FILE*>(handle);
+    if (_fseeki64(file, 0, SEEK_END) != 0) return false;
+    __int64 end = _ftelli64(file);
+    if (end < 0) return false;
+    size = static_cast<uint64_t>(end);
+    return true;
+}
+
+bool readAt(intptr_t handle, uint64_t offset, void* dst, size_t size) {
+    auto* file = reinterpret_cast<std::FILE*>(handle);
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0 &&
+           std::fread(dst, 1, size, file) == size;
+}
+
+#else
+
+intptr_t openFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    return fd >= 0 ? static_cast<intptr_t>(fd) : INVALID_FILE;
+}
+
+void closeFile(intptr_t handle) {
+    ::close(static_cast<int>(handle));
+}
+
+bool queryFileSize(intptr_t handle, uint64_t& size) {
+    struct stat st{};
+    if (::fstat(static_cast<int>(handle), &st) != 0) return false;
+    size = static_cast<uint64_t>(st.st_size);
+    return true;
+}
+
+bool readAt(intptr_t handle, uint64_t offset, void* dst, size_t size) {
+    auto* out = static_cast<uint8_t*>(dst);
+    while (size > 0) {
+        ssize_t n = ::pread(static_cast<int>(handle), out, size, static_cast<off_t>(offset));
+        if (n <= 0) return false;
+        out += n;
+        offset += static_cast<uint64_t>(n);
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+#endif
+
+} // namespace
+
+// One slot per read the kernel may hold; buffers must stay put until the
+// completion arrives, so slots are never reallocated while the ring runs
+struct IOService::UringState {
+#ifdef HAVE_LIBURING
+    io_uring ring{};
+#endif
+    struct Slot {
+        Pending pending;
+        intptr_t handle = INVALID_FILE;
+        bool cachedHandle = false;
+        std::vector<uint8_t> data;
+        uint64_t done = 0;
+    };
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+};
+
+IOService::IOService(ConstructToken) {
+}
+
+std::unique_ptr<IOService> IOService::create(const Config& config) {
+    auto service = std::make_unique<IOService>(ConstructToken{});
+    service->initInternal(config);
+    return service;
+}
+
+IOService& IOService::instance() {
+    static std::unique_ptr<IOService> service = create();
+    return *service;
+}
+
+IOService::~IOService() {
+    shutdown();
+}
+
+void IOService::initInternal(const Config& config) {
+    config_ = config;
+    config_.workerCount = std::max(1u, config_.workerCount);
+    config_.queueDepth = std::max(1u, config_.queueDepth);
+
+    latencies_.reserve(LATENCY_HISTORY);
+    rateWindowStart_ = Clock::now();
+
+    running_ = true;
+    tasksRunning_ = true;
+
+    backend_ = Backend::ThreadPool;
+    if (config_.backend == Backend::IoUring && initIoUring()) {
+        backend_ = Backend::IoUring;
+        workers_.emplace_back(&IOService::uringLoop, this);
+    } else {
+        workers_.reserve(config_.workerCount);
+        for (uint32_t i = 0; i < config_.workerCount; ++i) {
+            workers_.emplace_back(&IOService::workerLoop, this);
+        }
+    }
+    taskThread_ = std::thread(&IOService::taskLoop, this);
+    threadCount_ = static_cast<uint32_t>(workers_.size()) + 1;
+
+    if (backend_ == Backend::IoUring) {
+        SDL_Log("IOService: %s backend, queue depth %u, %llu MB in flight", backendName(backend_),
+                config_.queueDepth, static_cast<unsigned long long>(config_.maxBytesInFlight >> 20));
+    } else {
+        SDL_Log("IOService: %s backend, %u readers, %llu MB in flight", backendName(backend_),
+                config_.workerCount, static_cast<unsigned long long>(config_.maxBytesInFlight >> 20));
+    }
+}
+
+void IOService::shutdown() {
+    std::vector<Pending> dropped;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        running_ = false;
+        for (auto& entry : queue_) {
+            dropped.push_back(std::move(entry.second));
+        }
+        queue_.clear();
+        queuedKeys_.clear();
+        deadlines_.clear();
+    }
+    queueCondition_.notify_all();
+
+    for (auto& pending : dropped) {
+        complete(pending, IOStatus::Cancelled, {});
+    }
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+
+    // Tasks are drained, not dropped: callers may be waiting on a TaskGroup
+    {
+        std::lock_guard<std::mutex> lock(taskMutex_);
+        tasksRunning_ = false;
+    }
+    taskCondition_.notify_all();
+    if (taskThread_.joinable()) {
+        taskThread_.join();
+    }
+
+    shutdownIoUring();
+    closeAllFiles();
+}
+
+IORequestId IOService::submit(IORequest request, IOCallback onComplete) {
+    Pending pending;
+    pending.request = std::move(request);
+    pending.callback = std::move(onComplete);
+    pending.submitTime = Clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        pending.id = nextId_++;
+        if (running_) {
+            QueueKey key{static_cast<uint8_t>(pending.request.priority),
+                         pending.request.deadline.time_since_epoch().count(), nextSequence_++};
+            IORequestId id = pending.id;
+            queuedKeys_.emplace(id, key);
+            if (pending.request.deadline != Clock::time_point::max()) {
+                deadlines_.emplace(std::get<1>(key), key);
+            }
+            queue_.emplace(key, std::move(pending));
+            queueCondition_.notify_one();
+            return id;
+        }
+    }
+
+    // Shut down: fail fast so futures don't hang
+    IORequestId id = pending.id;
+    complete(pending, IOStatus::Cancelled, {});
+    return id;
+}
+
+std::future<IOResult> IOService::read(IORequest request) {
+    auto promise = std::make_shared<std::promise<IOResult>>();
+    std::future<IOResult> future = promise->get_future();
+    submit(std::move(request), [promise](IOResult&& result) {
+        promise->set_value(std::move(result));
+    });
+    return future;
+}
+
+IOResult IOService::readFile(const std::string& path, IOPriority priority) {
+    IORequest request;
+    request.path = path;
+    request.priority = priority;
+    return read(std::move(request)).get();
+}
+
+bool IOService::cancel(IORequestId id) {
+    Pending pending;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        auto keyIt = queuedKeys_.find(id);
+        if (keyIt == queuedKeys_.end()) {
+            if (inFlight_.count(id) == 0) {
+                return false;
+            }
+            cancelledInFlight_.insert(id);
+            return true;
+        }
+        auto queueIt = queue_.find(keyIt->second);
+        pending = std::move(queueIt->second);
+        eraseQueuedLocked(queueIt);
+    }
+
+    complete(pending, IOStatus::Cancelled, {});
+    return true;
+}
+
+void IOService::submitTask(std::function<void()> task, IOPriority priority) {
+    {
+        std::lock_guard<std::mutex> lock(taskMutex_);
+        if (tasksRunning_) {
+            tasks_.emplace(std::make_pair(static_cast<uint8_t>(priority), nextTaskSequence_++),
+                           Task{std::move(task)});
+            taskCondition_.notify_one();
+            return;
+        }
+    }
+    // Not running: execute synchronously, as TaskScheduler does
+    task();
+}
+
+void IOService::invalidateFile(const std::string& path) {
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    auto it = openFiles_.find(path);
+    if (it == openFiles_.end()) {
+        return;
+    }
+    // In use: releaseFile() closes it once the handle no longer matches
+    if (it->second.users == 0) {
+        closeFile(it->second.handle);
+    }
+    fileLru_.erase(it->second.lruIt);
+    openFiles_.erase(it);
+}
+
+IOService::Stats IOService::getStats() const {
+    Stats stats;
+    stats.backend = backend_;
+    stats.threads = threadCount_;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        stats.queueDepth = static_cast<uint32_t>(queue_.size());
+        stats.inFlight = static_cast<uint32_t>(inFlight_.size());
+        stats.bytesInFlight = bytesInFlight_;
+    }
+    {
+        std::lock_guard<std::mutex> lock(taskMutex_);
+        stats.tasksQueued = static_cast<uint32_t>(tasks_.size());
+    }
+
+    std::vector<float> sorted;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats.totalBytesRead = totalBytesRead_;
+        stats.completed = completed_;
+        stats.failed = failed_;
+        stats.cancelled = cancelled_;
+        stats.expired = expired_;
+
+        // A window left open this long means reads stopped; report its
+        // average rather than the last busy second
+        float windowSeconds = std::chrono::duration<float>(Clock::now() - rateWindowStart_).count();
+        stats.bytesPerSecond = windowSeconds >= 2.0f
+            ? static_cast<float>(rateWindowBytes_) / windowSeconds
+            : bytesPerSecond_;
+        sorted = latencies_;
+    }
+
+    if (!sorted.empty()) {
+        auto percentile = [&sorted](float p) {
+            size_t index = std::min(sorted.size() - 1, static_cast<size_t>(p * static_cast<float>(sorted.size())));
+            std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(index), sorted.end());
+            return sorted[index];
+        };
+        stats.latencyP50Ms = percentile(0.50f);
+        stats.latencyP95Ms = percentile(0.95f);
+        stats.latencyP99Ms = percentile(0.99f);
+    }
+    return stats;
+}
+
+bool IOService::canDispatchLocked() const {
+    if (queue_.empty()) {
+        return false;
+    }
+    if (!deadlines_.empty() && deadlines_.begin()->first < Clock::now().time_since_epoch().count()) {
+        return true;    // Dispatching expires it
+    }
+    uint64_t size = queue_.begin()->second.request.size;
+    return bytesInFlight_ == 0 || bytesInFlight_ + size <= config_.maxBytesInFlight;
+}
+
+void IOService::expireLocked(Clock::time_point now, std::vector<Pending>& expiredOut) {
+    const Clock::rep nowTicks = now.time_since_epoch().count();
+    while (!deadlines_.empty() && deadlines_.begin()->first < nowTicks) {
+        auto it = queue_.find(deadlines_.begin()->second);
+        expiredOut.push_back(std::move(it->second));
+        eraseQueuedLocked(it);
+    }
+}
+
+void IOService::eraseQueuedLocked(std::map<QueueKey, Pending>::iterator it) {
+    const QueueKey& key = it->first;
+    if (std::get<1>(key) != Clock::time_point::max().time_since_epoch().count()) {
+        deadlines_.erase({std::get<1>(key), key});
+    }
+    queuedKeys_.erase(it->second.id);
+    queue_.erase(it);
+}
+
+void IOService::waitForWorkLocked(std::unique_lock<std::mutex>& lock) {
+    while (running_ && !canDispatchLocked()) {
+        if (deadlines_.empty()) {
+            queueCondition_.wait(lock);
+        } else {
+            queueCondition_.wait_until(lock, Clock::time_point(Clock::duration(deadlines_.begin()->first)));
+        }
+    }
+}
+
+bool IOService::popNext(Pending& out, std::vector<Pending>& expiredOut) {
+    // Late requests anywhere in the queue fail now, not when they reach the head
+    expireLocked(Clock::now(), expiredOut);
+    if (queue_.empty()) {
+        return false;
+    }
+    auto it = queue_.begin();
+
+    // Over budget: the head waits instead of being overtaken by smaller
+    // reads, otherwise a large high-priority read could starve. An idle
+    // service always takes the head so oversized reads still run.
+    uint64_t size = it->second.request.size;
+    if (bytesInFlight_ > 0 && bytesInFlight_ + size > config_.maxBytesInFlight) {
+        return false;
+    }
+
+    out = std::move(it->second);
+    eraseQueuedLocked(it);
+
+    out.reservedBytes = size;
+    bytesInFlight_ += size;
+    inFlight_.insert(out.id);
+    return true;
+}
+
+void IOService::chargeBytes(Pending& pending, uint64_t size) {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    if (size > pending.reservedBytes) {
+        bytesInFlight_ += size - pending.reservedBytes;
+        pending.reservedBytes = size;
+    }
+}
+
+void IOService::workerLoop() {
+    ThreadProfiler::instance().setThreadName("IO reader");
+    std::vector<Pending> expired;
+    while (true) {
+        Pending pending;
+        bool haveRead = false;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            waitForWorkLocked(lock);
+            if (!running_) {
+                return;     // shutdown() completes whatever is still queued
+            }
+            haveRead = popNext(pending, expired);
+        }
+
+        for (auto& request : expired) {
+            complete(request, IOStatus::DeadlineExpired, {});
+        }
+        expired.clear();
+
+        if (haveRead) {
+            PROFILE_THREAD_ZONE("IO:Read");
+            std::vector<uint8_t> data;
+            IOStatus status = readBlocking(pending, data);
+            complete(pending, status, std::move(data));
+        }
+    }
+}
+
+IOStatus IOService::readBlocking(Pending& pending, std::vector<uint8_t>& out) {
+    const IORequest& request = pending.request;
+    bool ranged = request.size > 0;
+
+    intptr_t handle = acquireFile(request.path, ranged);
+    if (handle == INVALID_FILE) {
+        return IOStatus::NotFound;
+    }
+
+    IOStatus status = IOStatus::Ok;
+    uint64_t size = request.size;
+    if (!ranged) {
+        uint64_t fileSize = 0;
+        if (!queryFileSize(handle, fileSize) || fileSize < request.offset) {
+            status = IOStatus::ReadError;
+        } else {
+            size = fileSize - request.offset;
+            chargeBytes(pending, size);
+        }
+    }
+
+    if (status == IOStatus::Ok) {
+        out.resize(static_cast<size_t>(size));
+        if (size > 0 && !readAt(handle, request.offset, out.data(), out.size())) {
+            status = IOStatus::ReadError;
+            out.clear();
+        }
+    }
+
+    releaseFile(request.path, handle, ranged);
+    return status;
+}
+
+void IOService::complete(Pending& pending, IOStatus status, std::vector<uint8_t>&& data) {
+    bool releasedBudget = false;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (inFlight_.erase(pending.id) > 0) {
+            bytesInFlight_ -= pending.reservedBytes;
+            releasedBudget = pending.reservedBytes > 0;
+            if (cancelledInFlight_.erase(pending.id) > 0) {
+                status = IOStatus::Cancelled;
+            }
+        }
+    }
+    if (releasedBudget) {
+        queueCondition_.notify_all();
+    }
+
+    IOResult result;
+    result.status = status;
+    result.latencyMs = toMs(Clock::now() - pending.submitTime);
+    if (status == IOStatus::Ok) {
+        result.data = std::move(data);
+    }
+
+    recordStats(status, result.data.size(), result.latencyMs);
+
+    if (pending.callback) {
+        pending.callback(std::move(result));
+    }
+}
+
+void IOService::recordStats(IOStatus status, size_t bytes, float latencyMs) {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    switch (status) {
+        case IOStatus::Ok:
+            completed_++;
+            totalBytesRead_ += bytes;
+            rateWindowBytes_ += bytes;
+            break;
+        case IOStatus::Cancelled:
+            cancelled_++;
+            return;
+        case IOStatus::DeadlineExpired:
+            expired_++;
+            return;
+        case IOStatus::NotFound:
+        case IOStatus::ReadError:
+            failed_++;
+            break;
+    }
+
+    // Only requests that reached the disk count towards latency
+    if (latencies_.size() < LATENCY_HISTORY) {
+        latencies_.push_back(latencyMs);
+    } else {
+        latencies_[latencyCursor_] = latencyMs;
+        latencyCursor_ = (latencyCursor_ + 1) % LATENCY_HISTORY;
+    }
+
+    auto now = Clock::now();
+    float windowSeconds = std::chrono::duration<float>(now - rateWindowStart_).count();
+    if (windowSeconds >= 1.0f) {
+        bytesPerSecond_ = static_cast<float>(rateWindowBytes_) / windowSeconds;
+        rateWindowBytes_ = 0;
+        rateWindowStart_ = now;
+    }
+}
+
+void IOService::taskLoop() {
+    ThreadProfiler::instance().setThreadName("IO tasks");
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(taskMutex_);
+            taskCondition_.wait(lock, [this] {
+                return !tasksRunning_ || !tasks_.empty();
+            });
+            if (tasks_.empty()) {
+                return;     // Stopped and drained
+            }
+            task = std::move(tasks_.begin()->second);
+            tasks_.erase(tasks_.begin());
+        }
+        if (task.func) {
+            PROFILE_THREAD_ZONE("IO:Task");
+            task.func();
+        }
+    }
+}
+
+intptr_t IOService::acquireFile(const std::string& path, bool cache) {
+#ifdef _WIN32
+    cache = false;
+#endif
+    if (!cache || config_.maxOpenFiles == 0) {
+        return openFile(path);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(fileMutex_);
+        auto it = openFiles_.find(path);
+        if (it != openFiles_.end()) {
+            it->second.users++;
+            fileLru_.splice(fileLru_.begin(), fileLru_, it->second.lruIt);
+            return it->second.handle;
+        }
+    }
+
+    // Open outside the lock; if another thread won the race, use theirs
+    intptr_t handle = openFile(path);
+    if (handle == INVALID_FILE) {
+        return INVALID_FILE;
+    }
+
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    auto it = openFiles_.find(path);
+    if (it != openFiles_.end()) {
+        closeFile(handle);
+        it->second.users++;
+        return it->second.handle;
+    }
+
+    // Evict idle descriptors, least recently used first
+    for (auto lruIt = fileLru_.end(); openFiles_.size() >= config_.maxOpenFiles && lruIt != fileLru_.begin();) {
+        --lruIt;
+        auto victim = openFiles_.find(*lruIt);
+        if (victim->second.users == 0) {
+            closeFile(victim->second.handle);
+            openFiles_.erase(victim);
+            lruIt = fileLru_.erase(lruIt);
+        }
+    }
+
+    fileLru_.push_front(path);
+    OpenFile& file = openFiles_[path];
+    file.handle = handle;
+    file.users = 1;
+    file.lruIt = fileLru_.begin();
+    return handle;
+}
+
+void IOService::releaseFile(const std::string& path, intptr_t handle, bool cache) {
+#ifdef _WIN32
+    cache = false;
+#endif
+    if (!cache || config_.maxOpenFiles == 0) {
+        closeFile(handle);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    auto it = openFiles_.find(path);
+    if (it != openFiles_.end() && it->second.handle == handle) {
+        it->second.users--;
+    } else {
+        closeFile(handle);  // Invalidated while this read used it
+    }
+}
+
+void IOService::closeAllFiles() {
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    for (auto& entry : openFiles_) {
+        closeFile(entry.second.handle);
+    }
+    openFiles_.clear();
+    fileLru_.clear();
+}
+
+#ifdef HAVE_LIBURING
+
+bool IOService::initIoUring() {
+    auto state = std::make_unique<UringState>();
+    int ret = io_uring_queue_init(config_.queueDepth, &state->ring, 0);
+    if (ret < 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "IOService: io_uring unavailable (%s), using thread pool",
+                    std::strerror(-ret));
+        return false;
+    }
+
+    state->slots.resize(config_.queueDepth);
+    state->freeSlots.reserve(config_.queueDepth);
+    for (uint32_t i = config_.queueDepth; i-- > 0;) {
+        state->freeSlots.push_back(i);
+    }
+    uring_ = std::move(state);
+    return true;
+}
+
+void IOService::shutdownIoUring() {
+    if (uring_) {
+        io_uring_queue_exit(&uring_->ring);
+        uring_.reset();
+    }
+}
+
+void IOService::uringLoop() {
+    ThreadProfiler::instance().setThreadName("IO ring");
+    UringState& state = *uring_;
+    // Largest single read; longer requests continue as short reads
+    constexpr uint64_t MAX_READ_CHUNK = 1ull << 30;
+
+    uint32_t active = 0;
+    std::vector<Pending> expired;
+    std::vector<Pending> issue;
+
+    auto queueRead = [&](uint32_t slotIndex) {
+        UringState::Slot& slot = state.slots[slotIndex];
+        uint64_t remaining = slot.data.size() - slot.done;
+        io_uring_sqe* sqe = io_uring_get_sqe(&state.ring);
+        io_uring_prep_read(sqe, static_cast<int>(slot.handle), slot.data.data() + slot.done,
+                           static_cast<unsigned>(std::min(remaining, MAX_READ_CHUNK)),
+                           slot.pending.request.offset + slot.done);
+        io_uring_sqe_set_data(sqe, reinterpret_cast<void*>(static_cast<uintptr_t>(slotIndex)));
+    };
+
+    auto finishSlot = [&](uint32_t slotIndex, IOStatus status) {
+        UringState::Slot& slot = state.slots[slotIndex];
+        releaseFile(slot.pending.request.path, slot.handle, slot.cachedHandle);
+        Pending pending = std::move(slot.pending);
+        std::vector<uint8_t> data = std::move(slot.data);
+        slot = UringState::Slot{};
+        state.freeSlots.push_back(slotIndex);
+        active--;
+        PROFILE_THREAD_ZONE("IO:Complete");
+        complete(pending, status, std::move(data));
+    };
+
+    while (true) {
+        bool stopping = false;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            if (active == 0) {
+                waitForWorkLocked(lock);
+            }
+            stopping = !running_;
+            expireLocked(Clock::now(), expired);     // Even with every slot busy
+            Pending pending;
+            while (!stopping && active + issue.size() < state.slots.size() && popNext(pending, expired)) {
+                issue.push_back(std::move(pending));
+            }
+        }
+
+        for (auto& request : expired) {
+            complete(request, IOStatus::DeadlineExpired, {});
+        }
+        expired.clear();
+
+        if (stopping && active == 0) {
+            return;
+        }
+
+        // Open and size on this thread, then hand the read to the kernel
+        for (auto& pending : issue) {
+            bool ranged = pending.request.size > 0;
+            intptr_t handle = acquireFile(pending.request.path, ranged);
+            if (handle == INVALID_FILE) {
+                complete(pending, IOStatus::NotFound, {});
+                continue;
+            }
+
+            uint64_t size = pending.request.size;
+            if (!ranged) {
+                uint64_t fileSize = 0;
+                if (!queryFileSize(handle, fileSize) || fileSize < pending.request.offset) {
+                    releaseFile(pending.request.path, handle, ranged);
+                    complete(pending, IOStatus::ReadError, {});
+                    continue;
+                }
+                size = fileSize - pending.request.offset;
+                chargeBytes(pending, size);
+            }
+            if (size == 0) {
+                releaseFile(pending.request.path, handle, ranged);
+                complete(pending, IOStatus::Ok, {});
+                continue;
+            }
+
+            uint32_t slotIndex = state.freeSlots.back();
+            state.freeSlots.pop_back();
+            UringState::Slot& slot = state.slots[slotIndex];
+            slot.pending = std::move(pending);
+            slot.handle = handle;
+            slot.cachedHandle = ranged;
+            slot.data.resize(static_cast<size_t>(size));
+            slot.done = 0;
+            active++;
+            queueRead(slotIndex);
+        }
+        issue.clear();
+        io_uring_submit(&state.ring);
+
+        if (active == 0) {
+            continue;
+        }
+
+        // Short timeout so newly queued requests are picked up while reads
+        // are outstanding (the condition variable only covers the idle case)
+        io_uring_cqe* cqe = nullptr;
+        __kernel_timespec timeout{};
+        timeout.tv_nsec = 1000000;
+        int ret = io_uring_wait_cqe_timeout(&state.ring, &cqe, &timeout);
+        bool resubmit = false;
+        while (ret == 0 && cqe) {
+            auto slotIndex = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(io_uring_cqe_get_data(cqe)));
+            int res = cqe->res;
+            io_uring_cqe_seen(&state.ring, cqe);
+
+            UringState::Slot& slot = state.slots[slotIndex];
+            if (res <= 0) {
+                finishSlot(slotIndex, IOStatus::ReadError);
+            } else {
+                slot.done += static_cast<uint64_t>(res);
+                if (slot.done < slot.data.size()) {
+                    queueRead(slotIndex);   // Short read: continue where it stopped
+                    resubmit = true;
+                } else {
+                    finishSlot(slotIndex, IOStatus::Ok);
+                }
+            }
+            ret = io_uring_peek_cqe(&state.ring, &cqe);
+        }
+        if (resubmit) {
+            io_uring_submit(&state.ring);
+        }
+    }
+}
+
+#else
+
+bool IOService::initIoUring() {
+    return false;
+}
+
+void IOService::shutdownIoUring() {
+}
+
+void IOService::uringLoop() {
+}
+
+#endif
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Request priority: lower value is dispatched first
+enum class IOPriority : uint8_t {
+    Critical = 0,   // Something is waiting on this right now (sync loads, on-screen tiles)
+    High = 1,
+    Normal = 2,
+    Low = 3         // Speculative (prefetch)
+};
+
+enum class IOStatus : uint8_t {
+    Ok,
+    NotFound,
+    ReadError,
+    Cancelled,
+    DeadlineExpired
+};
+
+struct IOResult {
+    IOStatus status = IOStatus::ReadError;
+    std::vector<uint8_t> data;
+    float latencyMs = 0.0f;     // Submit to completion
+
+    bool ok() const { return status == IOStatus::Ok; }
+};
+
+/**
+ * A positional read. size == 0 reads from offset to the end of the file.
+ */
+struct IORequest {
+    using Clock = std::chrono::steady_clock;
+
+    std::string path;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    IOPriority priority = IOPriority::Normal;
+
+    // Requests still queued at the deadline complete with DeadlineExpired
+    // instead of being read
+    Clock::time_point deadline = Clock::time_point::max();
+};
+
+using IORequestId = uint64_t;
+using IOCallback = std::function<void(IOResult&&)>;
+
+/**
+ * Asynchronous file I/O shared by the streaming loaders.
+ *
+ * One queue for every read in the process, so terrain tiles, virtual
+ * texture tiles and startup assets compete by priority instead of each
+ * loader's private thread pool hammering the disk independently.
+ *
+ * - Priorities (then deadline, then submission order)
+ * - Cancellation of queued or in-flight requests
+ * - Deadlines for reads that are useless if late
+ * - A bytes-in-flight budget; the head of the queue waits rather than
+ *   being overtaken, so priority order holds under back-pressure
+ * - Stats: queue depth, bytes/sec, latency percentiles (shown by Profiler)
+ *
+ * Backends:
+ * - IoUring: one submission thread keeps up to queueDepth reads in the
+ *   kernel at once (Linux, built with liburing - HAVE_LIBURING)
+ * - ThreadPool: workerCount threads doing blocking positional reads;
+ *   used everywhere else and when io_uring setup fails at runtime
+ *
+ * Completion callbacks run on an I/O thread: keep them short and hand
+ * decoding to the caller's own workers. submitTask() runs blocking file
+ * work that isn't a plain read (directory scans, writes) on a dedicated
+ * FIFO thread, which is what TaskScheduler::submitIO forwards to.
+ *
+ * Usage:
+ *   IORequest request;
+ *   request.path = archivePath;
+ *   request.offset = entry.offset;
+ *   request.size = entry.size;
+ *   IOResult result = IOService::instance().read(std::move(request)).get();
+ */
+class IOService {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Backend {
+        ThreadPool,
+        IoUring
+    };
+
+    struct Config {
+        Backend backend = Backend::IoUring;         // Falls back to ThreadPool if unavailable
+        uint32_t workerCount = 4;                   // ThreadPool reader threads
+        uint32_t queueDepth = 64;                   // IoUring reads in flight
+        uint64_t maxBytesInFlight = 64ull << 20;
+        uint32_t maxOpenFiles = 64;                 // Cached descriptors for ranged reads
+    };
+
+    struct Stats {
+        Backend backend = Backend::ThreadPool;
+        uint32_t threads = 0;           // Reader/ring threads plus the task thread
+        uint32_t queueDepth = 0;        // Reads waiting to be issued
+        uint32_t inFlight = 0;          // Reads issued, not yet complete
+        uint32_t tasksQueued = 0;       // submitTask() work waiting
+        uint64_t bytesInFlight = 0;
+        uint64_t totalBytesRead = 0;
+        uint64_t completed = 0;
+        uint64_t failed = 0;
+        uint64_t cancelled = 0;
+        uint64_t expired = 0;
+        float bytesPerSecond = 0.0f;    // Over the last completed one second window
+        float latencyP50Ms = 0.0f;      // Over the last LATENCY_HISTORY reads
+        float latencyP95Ms = 0.0f;
+        float latencyP99Ms = 0.0f;
+    };
+
+    static constexpr size_t LATENCY_HISTORY = 1024;
+
+    // Passkey for controlled construction via make_unique
+    struct ConstructToken { explicit ConstructToken() = default; };
+    explicit IOService(ConstructToken);
+
+    /**
+     * Factory: start a service. Never fails - an unavailable io_uring
+     * backend falls back to the thread pool.
+     */
+    static std::unique_ptr<IOService> create(const Config& config);
+    static std::unique_ptr<IOService> create() { return create(Config{}); }
+
+    // Process-wide service used by the loaders (created on first use)
+    static IOService& instance();
+
+    ~IOService();
+
+    IOService(const IOService&) = delete;
+    IOService& operator=(const IOService&) = delete;
+    IOService(IOService&&) = delete;
+    IOService& operator=(IOService&&) = delete;
+
+    /**
+     * Queue a read. onComplete is always called exactly once, including
+     * for cancelled and expired requests.
+     */
+    IORequestId submit(IORequest request, IOCallback onComplete);
+
+    // Queue a read and wait on the result through a future
+    std::future<IOResult> read(IORequest request);
+
+    // Blocking whole-file read through the queue
+    IOResult readFile(const std::string& path, IOPriority priority = IOPriority::Normal);
+
+    /**
+     * Cancel a queued or in-flight read. Returns false if it already
+     * completed. In-flight reads finish in the kernel/worker but their data
+     * is dropped and the callback sees Cancelled.
+     */
+    bool cancel(IORequestId id);
+
+    // Run blocking file work on the service's task thread (FIFO within a priority)
+    void submitTask(std::function<void()> task, IOPriority priority = IOPriority::Normal);
+
+    // Drop the cached descriptor for a file that was rewritten
+    void invalidateFile(const std::string& path);
+
+    Stats getStats() const;
+    Backend getBackend() const { return backend_; }
+
+    // Cancel everything queued and stop the threads (also done by the destructor)
+    void shutdown();
+
+private:
+    struct Pending {
+        IORequestId id = 0;
+        IORequest request;
+        IOCallback callback;
+        Clock::time_point submitTime;
+        uint64_t reservedBytes = 0;     // Charged against maxBytesInFlight
+    };
+
+    struct Task {
+        std::function<void()> func;
+    };
+
+    // Dispatch order: priority, then deadline, then submission order
+    using QueueKey = std::tuple<uint8_t, Clock::rep, uint64_t>;
+
+    struct OpenFile {
+        intptr_t handle = -1;
+        uint32_t users = 0;
+        std::list<std::string>::iterator lruIt;
+    };
+
+    void initInternal(const Config& config);
+    bool initIoUring();
+    void shutdownIoUring();
+
+    void workerLoop();
+    void uringLoop();
+    void taskLoop();
+
+    // Pop the next dispatchable request (queue lock held). Expired requests
+    // are moved to expiredOut so their callbacks run outside the lock.
+    bool popNext(Pending& out, std::vector<Pending>& expiredOut);
+    bool canDispatchLocked() const;
+
+    // Move every queued request past its deadline, wherever it sits in the
+    // queue, to expiredOut (queue lock held)
+    void expireLocked(Clock::time_point now, std::vector<Pending>& expiredOut);
+    // Unlink a queued entry whose Pending has been moved out (queue lock held)
+    void eraseQueuedLocked(std::map<QueueKey, Pending>::iterator it);
+    // Sleep until a request can be dispatched or expired, or shutdown; wakes
+    // at the soonest deadline even if nothing is submitted or completes
+    void waitForWorkLocked(std::unique_lock<std::mutex>& lock);
+
+    // Blocking read used by the thread pool backend
+    IOStatus readBlocking(Pending& pending, std::vector<uint8_t>& out);
+
+    // Whole-file reads learn their size after dispatch; charge it then
+    void chargeBytes(Pending& pending, uint64_t size);
+
+    void complete(Pending& pending, IOStatus status, std::vector<uint8_t>&& data);
+    void recordStats(IOStatus status, size_t bytes, float latencyMs);
+
+    // Descriptor cache for ranged reads; whole-file reads open and close
+    intptr_t acquireFile(const std::string& path, bool cache);
+    void releaseFile(const std::string& path, intptr_t handle, bool cache);
+    void closeAllFiles();
+
+    Config config_;
+    Backend backend_ = Backend::ThreadPool;
+    uint32_t threadCount_ = 0;
+
+    // Read queue
+    mutable std::mutex queueMutex_;
+    std::condition_variable queueCondition_;
+    std::map<QueueKey, Pending> queue_;
+    std::unordered_map<IORequestId, QueueKey> queuedKeys_;
+    std::set<std::pair<Clock::rep, QueueKey>> deadlines_;   // Queued requests with a deadline, soonest first
+    std::unordered_set<IORequestId> inFlight_;
+    std::unordered_set<IORequestId> cancelledInFlight_;
+    uint64_t bytesInFlight_ = 0;
+    uint64_t nextSequence_ = 0;
+    IORequestId nextId_ = 1;
+    bool running_ = false;
+
+    // Task queue (submitTask)
+    mutable std::mutex taskMutex_;
+    std::condition_variable taskCondition_;
+    std::map<std::pair<uint8_t, uint64_t>, Task> tasks_;
+    uint64_t nextTaskSequence_ = 0;
+    bool tasksRunning_ = false;
+
+    std::vector<std::thread> workers_;
+    std::thread taskThread_;
+
+    // Open descriptors (LRU)
+    std::mutex fileMutex_;
+    std::unordered_map<std::string, OpenFile> openFiles_;
+    std::list<std::string> fileLru_;
+
+    // Stats
+    mutable std::mutex statsMutex_;
+    std::vector<float> latencies_;
+    size_t latencyCursor_ = 0;
+    Clock::time_point rateWindowStart_;
+    uint64_t rateWindowBytes_ = 0;
+    float bytesPerSecond_ = 0.0f;
+    uint64_t totalBytesRead_ = 0;
+    uint64_t completed_ = 0;
+    uint64_t failed_ = 0;
+    uint64_t cancelled_ = 0;
+    uint64_t expired_ = 0;
+
+    // io_uring state (opaque so the header doesn't need liburing)
+    struct UringState;
+    std::unique_ptr<UringState> uring_;
+};
@@ -8,6 +8,58 @@
 #include <queue>
 #include <sstream>
 
+namespace {
+
+struct AccessInfo {
+    vk::PipelineStageFlags stages;
+    vk::AccessFlags access;
+    vk::ImageLayout layout;
+};
+
+AccessInfo accessInfo(ResourceGraph::Access access) {
+    using Access = ResourceGraph::Access;
+    using Stage = vk::PipelineStageFlagBits;
+    using Flag = vk::AccessFlagBits;
+    using Layout = vk::ImageLayout;
+
+    switch (access) {
+        case Access::None:
+            return {Stage::eTopOfPipe, {}, Layout::eUndefined};
+        case Access::ColorAttachmentWrite:
+            return {Stage::eColorAttachmentOutput, Flag::eColorAttachmentRead | Flag::eColorAttachmentWrite,
+                    Layout::eColorAttachmentOptimal};
+        case Access::DepthStencilWrite:
+            return {Stage::eEarlyFragmentTests | Stage::eLateFragmentTests,
+                    Flag::eDepthStencilAttachmentRead | Flag::eDepthStencilAttachmentWrite,
+                    Layout::eDepthStencilAttachmentOptimal};
+        case Access::DepthStencilRead:
+            return {Stage::eEarlyFragmentTests | Stage::eLateFragmentTests, Flag::eDepthStencilAttachmentRead,
+                    Layout::eDepthStencilReadOnlyOptimal};
+        case Access::ShaderSampledRead:
+            return {Stage::eFragmentShader | Stage::eComputeShader, Flag::eShaderRead,
+                    Layout::eShaderReadOnlyOptimal};
+        case Access::ComputeStorageRead:
+            return {Stage::eComputeShader, Flag::eShaderRead, Layout::eGeneral};
+        case Access::ComputeStorageWrite:
+            return {Stage::eComputeShader, Flag::eShaderWrite, Layout::eGeneral};
+        case Access::ComputeStorageReadWrite:
+            return {Stage::eComputeShader, Flag::eShaderRead | Flag::eShaderWrite, Layout::eGeneral};
+        case Access::TransferRead:
+            return {Stage::eTransfer, Flag::eTransferRead, Layout::eTransferSrcOptimal};
+        case Access::TransferWrite:
+            return {Stage::eTransfer, Flag::eTransferWrite, Layout::eTransferDstOptimal};
+        case Access::IndirectRead:
+            return {Stage::eDrawIndirect, Flag::eIndirectCommandRead, Layout::eUndefined};
+        case Access::VertexRead:
+            return {Stage::eVertexInput, Flag::eVertexAttributeRead | Flag::eIndexRead, Layout::eUndefined};
+        case Access::Present:
+            return {Stage::eBottomOfPipe, {}, Layout::ePresentSrcKHR};
+    }
+    return {Stage::eTopOfPipe, {}, Layout::eUndefined};
+}
+
+} // namespace
+
 FrameGraph::PassId FrameGraph::addPass(const std::string& name, PassFunction execute) {
     return addPass(PassConfig{
         .name = name,
@@ -103,14 +155,19 @@ bool FrameGraph::topologicalSort(std::vector<std::vector<PassId>>& levels) {
     std::vector<uint32_t> inDegree(passes_.size(), 0);
     std::vector<bool> active(passes_.size(), false);
 
+    auto isActive = [this](PassId id) {
+        return id < passes_.size() && passes_[id].enabled && passes_[id].config.execute && !passes_[id].culled;
+    };
+
     for (const auto& pass : passes_) {
-        if (!pass.enabled || !pass.config.execute) continue;
+        if (!isActive(pass.id)) continue;
         active[pass.id] = true;
 
         for (PassId dep : pass.dependencies) {
-            if (dep < passes_.size() && passes_[dep].enabled && passes_[dep].config.execute) {
-                inDegree[pass.id]++;
-            }
+            if (isActive(dep)) inDegree[pass.id]++;
+        }
+        for (PassId dep : pass.derivedDependencies) {
+            if (isActive(dep)) inDegree[pass.id]++;
         }
     }
 
@@ -139,14 +196,16 @@ bool FrameGraph::topologicalSort(std::vector<std::vector<PassId>>& levels) {
             processedCount++;
 
             // Decrement in-degree for dependents
-            for (PassId dependent : passes_[id].dependents) {
+            auto release = [&](PassId dependent) {
                 if (active[dependent]) {
                     inDegree[dependent]--;
                     if (inDegree[dependent] == 0) {
                         readyQueue.push(dependent);
                     }
                 }
-            }
+            };
+            for (PassId dependent : passes_[id].dependents) release(dependent);
+            for (PassId dependent : passes_[id].derivedDependents) release(dependent);
         }
 
         // Sort level by priority (higher priority first)
@@ -169,12 +228,91 @@ bool FrameGraph::topologicalSort(std::vector<std::vector<PassId>>& levels) {
     return true;
 }
 
+bool FrameGraph::compileResources() {
+    std::vector<ResourceGraph::PassDesc> descs(passes_.size());
+    for (const auto& pass : passes_) {
+        ResourceGraph::PassDesc& desc = descs[pass.id];
+        desc.name = pass.config.name;
+        desc.active = pass.enabled && pass.config.execute;
+        desc.hasSideEffects = pass.config.hasSideEffects;
+        desc.uses = pass.config.resources;
+        desc.dependencies = pass.dependencies;
+    }
+
+    if (!resourceGraph_.compile(descs)) {
+        return false;
+    }
+
+    for (auto& pass : passes_) {
+        pass.derivedDependencies.clear();
+        pass.derivedDependents.clear();
+        pass.culled = resourceGraph_.isCulled(pass.id);
+    }
+    for (auto& pass : passes_) {
+        for (PassId dep : resourceGraph_.getDerivedDependencies(pass.id)) {
+            // Already ordered explicitly
+            if (std::find(pass.dependencies.begin(), pass.dependencies.end(), dep) != pass.dependencies.end()) {
+                continue;
+            }
+            pass.derivedDependencies.push_back(dep);
+            passes_[dep].derivedDependents.push_back(pass.id);
+        }
+    }
+
+    if (resourceGraph_.getResourceCount() > 0) {
+        const auto& stats = resourceGraph_.getStats();
+        SDL_Log("FrameGraph: %zu resources, %u of %u passes culled, %u barriers",
+            resourceGraph_.getResourceCount(), stats.culledPasses, stats.activePasses, stats.barriers);
+    }
+    return true;
+}
+
 bool FrameGraph::compile() {
+    if (!compileResources()) {
+        compiled_ = false;
+        return false;
+    }
+
     if (!topologicalSort(executionLevels_)) {
         compiled_ = false;
         return false;
     }
 
+    // Same active set as the levels, as a DAG for dependency-driven execution
+    std::vector<uint32_t> passToNode(passes_.size(), UINT32_MAX);
+    nodeToPass_.clear();
+    for (const auto& level : executionLevels_) {
+        for (PassId id : level) {
+            passToNode[id] = static_cast<uint32_t>(nodeToPass_.size());
+            nodeToPass_.push_back(id);
+        }
+    }
+
+    std::vector<PassScheduler::Node> nodes;
+    nodes.reserve(nodeToPass_.size());
+    for (PassId id : nodeToPass_) {
+        const Pass& pass = passes_[id];
+        PassScheduler::Node node;
+        node.name = pass.config.name;
+        // Secondary recording waits on its own task group, so keep it off the workers;
+        // declared barriers go into the primary command buffer
+        node.mainThreadOnly = pass.config.mainThreadOnly || pass.config.canUseSecondary ||
+                              !pass.config.resources.empty();
+        node.priority = pass.config.priority;
+        auto addEdge = [&](PassId dep) {
+            if (dep < passToNode.size() && passToNode[dep] != UINT32_MAX) {
+                node.dependencies.push_back(passToNode[dep]);
+            }
+        };
+        for (PassId dep : pass.dependencies) addEdge(dep);
+        for (PassId dep : pass.derivedDependencies) addEdge(dep);
+        nodes.push_back(std::move(node));
+    }
+    if (!scheduler_.build(std::move(nodes))) {
+        compiled_ = false;
+        return false;
+    }
+
     SDL_Log("FrameGraph: Compiled with %zu levels:", executionLevels_.size());
     for (size_t i = 0; i < executionLevels_.size(); ++i) {
         std::string passNames;
@@ -196,68 +334,54 @@ void FrameGraph::execute(FrameContext& context, TaskScheduler* scheduler) {
         return;
     }
 
-    for (const auto& level : executionLevels_) {
-        if (level.empty()) continue;
-
-        // Check if we can parallelize this level
-        bool canParallelize = scheduler != nullptr && level.size() > 1;
-        if (canParallelize) {
-            // Check if all passes in level support parallel execution
-            for (PassId id : level) {
-                if (passes_[id].config.mainThreadOnly) {
-                    canParallelize = false;
-                    break;
-                }
-            }
-        }
+    auto runNode = [this, &context, scheduler](PassScheduler::NodeIndex node) {
+        runPass(context, passes_[nodeToPass_[node]], scheduler);
+    };
 
-        if (canParallelize) {
-            // Execute passes in parallel using task scheduler
-            TaskGroup group;
-            for (PassId id : level) {
-                if (!passes_[id].enabled) continue;
+    if (executionMode_ == ExecutionMode::LevelBarriers) {
+        scheduler_.executeLevels(runNode, scheduler);
+    } else {
+        scheduler_.execute(runNode, scheduler);
+    }
+}
 
-                scheduler->submit([this, id, &context]() {
-                    passes_[id].config.execute(context);
-                }, &group);
-            }
-            group.wait();
-        } else {
-            // Execute passes sequentially
-            for (PassId id : level) {
-                // Bounds check
-                if (id >= passes_.size()) {
-                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                        "FrameGraph: Invalid pass ID %u (max %zu)", id, passes_.size());
-                    continue;
-                }
+void FrameGraph::runPass(FrameContext& context, const Pass& pass, TaskScheduler* scheduler) {
+    // Barriers are recorded even for a pass disabled after compile, so the
+    // states later passes expect still hold
+    const ResourceGraph::PassBarriers* barriers = nullptr;
+    if (resourceGraph_.isCompiled() && !pass.config.resources.empty()) {
+        barriers = &resourceGraph_.getBarriers(pass.id);
+        recordBarriers(context.commandBuffer, barriers->before);
+    }
 
-                if (!passes_[id].enabled) continue;
+    if (pass.enabled && pass.config.execute) {
+        executePass(context, pass, scheduler);
+    } else if (pass.enabled) {
+        // Skip passes with null execute function
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+            "FrameGraph: Skipping pass %s with null execute function", pass.config.name.c_str());
+    }
 
-                const auto& config = passes_[id].config;
+    if (barriers) {
+        recordBarriers(context.commandBuffer, barriers->after);
+    }
+}
 
-                // Skip passes with null execute function
-                if (!config.execute) {
-                    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                        "FrameGraph: Skipping pass %s with null execute function", config.name.c_str());
-                    continue;
-                }
+void FrameGraph::executePass(FrameContext& context, const Pass& pass, TaskScheduler* scheduler) {
+    const auto& config = pass.config;
 
-                // Check if this pass uses secondary command buffers for parallel recording
-                if (config.canUseSecondary &&
-                    config.secondarySlots > 0 &&
-                    config.secondaryRecord &&
-                    context.threadedCommandPool &&
-                    scheduler) {
-
-                    // Parallel secondary command buffer recording (Phase 4)
-                    executeWithSecondaryBuffers(context, passes_[id], scheduler);
-                } else {
-                    // Standard primary buffer execution
-                    config.execute(context);
-                }
-            }
-        }
+    // Check if this pass uses secondary command buffers for parallel recording
+    if (config.canUseSecondary &&
+        config.secondarySlots > 0 &&
+        config.secondaryRecord &&
+        context.threadedCommandPool &&
+        scheduler) {
+
+        // Parallel secondary command buffer recording (Phase 4)
+        executeWithSecondaryBuffers(context, pass, scheduler);
+    } else {
+        // Standard primary buffer execution
+        config.execute(context);
     }
 }
 
@@ -351,7 +475,7 @@ void FrameGraph::executeWithSecondaryBuffers(
                     "FrameGraph: Unknown exception in secondary buffer slot %u", slot);
                 failureCount.fetch_add(1, std::memory_order_relaxed);
             }
-        }, &group);
+        }, &group, TaskScheduler::Priority::High);
     }
 
     // Wait for all secondary buffers to be recorded
@@ -386,10 +510,291 @@ FrameGraph::PassId FrameGraph::getPass(const std::string& name) const {
     return (it != nameToId_.end()) ? it->second : INVALID_PASS;
 }
 
+void FrameGraph::recordBarriers(vk::CommandBuffer cmd, const std::vector<ResourceGraph::Barrier>& barriers) const {
+    if (barriers.empty() || !cmd) return;
+
+    vk::PipelineStageFlags srcStages;
+    vk::PipelineStageFlags dstStages;
+    std::vector<vk::ImageMemoryBarrier> imageBarriers;
+    std::vector<vk::BufferMemoryBarrier> bufferBarriers;
+
+    for (const auto& barrier : barriers) {
+        const ResourceBinding& binding = resourceBindings_[barrier.resource];
+        AccessInfo before = accessInfo(barrier.before);
+        AccessInfo after = accessInfo(barrier.after);
+
+        // An aliased transient also waits for the previous occupants of its memory
+        for (ResourceId previous : barrier.aliasedFrom) {
+            AccessInfo last = accessInfo(resourceGraph_.getLastAccess(previous));
+            before.stages |= last.stages;
+            before.access |= last.access;
+        }
+        srcStages |= before.stages;
+        dstStages |= after.stages;
+
+        if (resourceGraph_.getResource(barrier.resource).type == ResourceGraph::ResourceType::Image) {
+            // Unbound imports are skipped; binding them is the owner's job
+            if (!binding.image) continue;
+            imageBarriers.push_back(vk::ImageMemoryBarrier{}
+                .setSrcAccessMask(before.access)
+                .setDstAccessMask(after.access)
+                .setOldLayout(before.layout)
+                .setNewLayout(after.layout)
+                .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                .setImage(binding.image)
+                .setSubresourceRange(vk::ImageSubresourceRange{}
+                    .setAspectMask(binding.aspect)
+                    .setBaseMipLevel(0)
+                    .setLevelCount(VK_REMAINING_MIP_LEVELS)
+                    .setBaseArrayLayer(0)
+                    .setLayerCount(VK_REMAINING_ARRAY_LAYERS)));
+        } else {
+            if (!binding.buffer) continue;
+            bufferBarriers.push_back(vk::BufferMemoryBarrier{}
+                .setSrcAccessMask(before.access)
+                .setDstAccessMask(after.access)
+                .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                .setBuffer(binding.buffer)
+                .setOffset(0)
+                .setSize(VK_WHOLE_SIZE));
+        }
+    }
+
+    if (imageBarriers.empty() && bufferBarriers.empty()) return;
+    cmd.pipelineBarrier(srcStages, dstStages, {}, {}, bufferBarriers, imageBarriers);
+}
+
+FrameGraph::ResourceId FrameGraph::importImage(const std::string& name, ResourceAccess initialAccess,
+                                               ResourceAccess finalAccess, vk::ImageAspectFlags aspect) {
+    ResourceGraph::ResourceDesc desc;
+    desc.name = name;
+    desc.type = ResourceGraph::ResourceType::Image;
+    desc.imported = true;
+    desc.initialAccess = initialAccess;
+    desc.finalAccess = finalAccess;
+
+    ResourceBinding binding;
+    binding.aspect = aspect;
+    resourceBindings_.push_back(binding);
+    compiled_ = false;
+    return resourceGraph_.addResource(std::move(desc));
+}
+
+FrameGraph::ResourceId FrameGraph::importBuffer(const std::string& name, ResourceAccess initialAccess,
+                                                ResourceAccess finalAccess) {
+    ResourceGraph::ResourceDesc desc;
+    desc.name = name;
+    desc.type = ResourceGraph::ResourceType::Buffer;
+    desc.imported = true;
+    desc.initialAccess = initialAccess;
+    desc.finalAccess = finalAccess;
+
+    resourceBindings_.push_back(ResourceBinding{});
+    compiled_ = false;
+    return resourceGraph_.addResource(std::move(desc));
+}
+
+void FrameGraph::bindImage(ResourceId id, vk::Image image, vk::ImageView view) {
+    if (id < resourceBindings_.size() && resourceGraph_.getResource(id).imported) {
+        resourceBindings_[id].image = image;
+        resourceBindings_[id].view = view;
+    }
+}
+
+void FrameGraph::bindBuffer(ResourceId id, vk::Buffer buffer) {
+    if (id < resourceBindings_.size() && resourceGraph_.getResource(id).imported) {
+        resourceBindings_[id].buffer = buffer;
+    }
+}
+
+FrameGraph::ResourceId FrameGraph::createTransientImage(const std::string& name, const vk::ImageCreateInfo& info,
+                                                        vk::ImageViewType viewType, vk::ImageAspectFlags aspect) {
+    ResourceGraph::ResourceDesc desc;
+    desc.name = name;
+    desc.type = ResourceGraph::ResourceType::Image;
+
+    ResourceBinding binding;
+    binding.imageInfo = info;
+    binding.imageInfo.setPNext(nullptr)
+        .setSharingMode(vk::SharingMode::eExclusive)
+        .setQueueFamilyIndexCount(0)
+        .setPQueueFamilyIndices(nullptr)
+        .setInitialLayout(vk::ImageLayout::eUndefined);
+    binding.viewType = viewType;
+    binding.aspect = aspect;
+    resourceBindings_.push_back(binding);
+    compiled_ = false;
+    return resourceGraph_.addResource(std::move(desc));
+}
+
+FrameGraph::ResourceId FrameGraph::createTransientBuffer(const std::string& name, vk::DeviceSize size,
+                                                         vk::BufferUsageFlags usage) {
+    ResourceGraph::ResourceDesc desc;
+    desc.name = name;
+    desc.type = ResourceGraph::ResourceType::Buffer;
+    desc.sizeBytes = size;
+
+    ResourceBinding binding;
+    binding.bufferSize = size;
+    binding.bufferUsage = usage;
+    resourceBindings_.push_back(binding);
+    compiled_ = false;
+    return resourceGraph_.addResource(std::move(desc));
+}
+
+bool FrameGraph::realizeTransients(vk::Device device, VmaAllocator allocator) {
+    destroyTransients();
+    if (!resourceGraph_.isCompiled()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameGraph: realizeTransients() before compile()");
+        return false;
+    }
+
+    transientDevice_ = device;
+    transientAllocator_ = allocator;
+
+    // Create unbound handles to learn the real memory requirements
+    size_t transientCount = 0;
+    try {
+        for (ResourceId id = 0; id < resourceBindings_.size(); ++id) {
+            const auto& desc = resourceGraph_.getResource(id);
+            if (desc.imported || resourceGraph_.getFirstUse(id) == ResourceGraph::NO_PASS) continue;
+
+            ResourceBinding& binding = resourceBindings_[id];
+            vk::MemoryRequirements requirements;
+            if (desc.type == ResourceGraph::ResourceType::Image) {
+                binding.image = device.createImage(binding.imageInfo);
+                requirements = device.getImageMemoryRequirements(binding.image);
+            } else {
+                binding.buffer = device.createBuffer(vk::BufferCreateInfo{}
+                    .setSize(binding.bufferSize)
+                    .setUsage(binding.bufferUsage)
+                    .setSharingMode(vk::SharingMode::eExclusive));
+                requirements = device.getBufferMemoryRequirements(binding.buffer);
+            }
+            resourceGraph_.setResourceMemory(id, requirements.size, requirements.alignment,
+                                             requirements.memoryTypeBits);
+            transientCount++;
+        }
+    } catch (const vk::SystemError& e) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameGraph: Failed to create transient: %s", e.what());
+        destroyTransients();
+        return false;
+    }
+    if (transientCount == 0) return true;
+
+    resourceGraph_.planAliasing();
+
+    for (const auto& heap : resourceGraph_.getHeaps()) {
+        VkMemoryRequirements requirements{};
+        requirements.size = heap.sizeBytes;
+        requirements.alignment = heap.alignment;
+        requirements.memoryTypeBits = heap.memoryTypeBits;
+
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+        VmaAllocation allocation = VK_NULL_HANDLE;
+        VkResult result = vmaAllocateMemory(allocator, &requirements, &allocInfo, &allocation, nullptr);
+        if (result != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                "FrameGraph: Failed to allocate %llu byte transient heap: %d",
+                static_cast<unsigned long long>(heap.sizeBytes), result);
+            destroyTransients();
+            return false;
+        }
+        transientHeaps_.push_back(allocation);
+
+        for (ResourceId id : heap.resources) {
+            ResourceBinding& binding = resourceBindings_[id];
+            VkDeviceSize offset = resourceGraph_.getPlacement(id).offset;
+            result = binding.image
+                ? vmaBindImageMemory2(allocator, allocation, offset, binding.image, nullptr)
+                : vmaBindBufferMemory2(allocator, allocation, offset, binding.buffer, nullptr);
+            if (result != VK_SUCCESS) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                    "FrameGraph: Failed to bind transient %s: %d",
+                    resourceGraph_.getResource(id).name.c_str(), result);
+                destroyTransients();
+                return false;
+            }
+        }
+    }
+
+    try {
+        for (ResourceId id = 0; id < resourceBindings_.size(); ++id) {
+            ResourceBinding& binding = resourceBindings_[id];
+            if (resourceGraph_.getResource(id).imported || !binding.image) continue;
+            binding.view = device.createImageView(vk::ImageViewCreateInfo{}
+                .setImage(binding.image)
+                .setViewType(binding.viewType)
+                .setFormat(binding.imageInfo.format)
+                .setSubresourceRange(vk::ImageSubresourceRange{}
+                    .setAspectMask(binding.aspect)
+                    .setBaseMipLevel(0)
+                    .setLevelCount(binding.imageInfo.mipLevels)
+                    .setBaseArrayLayer(0)
+                    .setLayerCount(binding.imageInfo.arrayLayers)));
+        }
+    } catch (const vk::SystemError& e) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameGraph: Failed to create transient view: %s", e.what());
+        destroyTransients();
+        return false;
+    }
+
+    const auto& stats = resourceGraph_.getStats();
+    SDL_Log("FrameGraph: %u transients in %zu heaps, %.1f MB -> %.1f MB with aliasing",
+        stats.transientResources, transientHeaps_.size(),
+        stats.unaliasedBytes / (1024.0 * 1024.0), stats.aliasedBytes / (1024.0 * 1024.0));
+    return true;
+}
+
+void FrameGraph::destroyTransients() {
+    for (ResourceId id = 0; id < resourceBindings_.size(); ++id) {
+        if (resourceGraph_.getResource(id).imported) continue;
+        ResourceBinding& binding = resourceBindings_[id];
+        if (binding.view) transientDevice_.destroyImageView(binding.view);
+        if (binding.image) transientDevice_.destroyImage(binding.image);
+        if (binding.buffer) transientDevice_.destroyBuffer(binding.buffer);
+        binding.view = nullptr;
+        binding.image = nullptr;
+        binding.buffer = nullptr;
+    }
+    for (VmaAllocation allocation : transientHeaps_) {
+        vmaFreeMemory(transientAllocator_, allocation);
+    }
+    transientHeaps_.clear();
+}
+
+FrameGraph::ResourceId FrameGraph::getResource(const std::string& name) const {
+    for (ResourceId id = 0; id < resourceGraph_.getResourceCount(); ++id) {
+        if (resourceGraph_.getResource(id).name == name) return id;
+    }
+    return INVALID_RESOURCE;
+}
+
+vk::Image FrameGraph::getImage(ResourceId id) const {
+    return id < resourceBindings_.size() ? resourceBindings_[id].image : vk::Image{};
+}
+
+vk::ImageView FrameGraph::getImageView(ResourceId id) const {
+    return id < resourceBindings_.size() ? resourceBindings_[id].view : vk::ImageView{};
+}
+
+vk::Buffer FrameGraph::getBuffer(ResourceId id) const {
+    return id < resourceBindings_.size() ? resourceBindings_[id].buffer : vk::Buffer{};
+}
+
 void FrameGraph::clear() {
+    destroyTransients();
+    resourceGraph_.clear();
+    resourceBindings_.clear();
     passes_.clear();
     nameToId_.clear();
     executionLevels_.clear();
+    nodeToPass_.clear();
+    scheduler_.build({});
     nextPassId_ = 0;
     compiled_ = false;
 }
@@ -403,6 +808,7 @@ std::string FrameGraph::debugString() const {
 
         ss << "  " << pass.config.name;
         if (!pass.enabled) ss << " [DISABLED]";
+        if (pass.culled) ss << " [CULLED]";
         ss << " (id=" << pass.id << ")";
 
         if (!pass.dependencies.empty()) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vulkan/vulkan.hpp>
+#include <vk_mem_alloc.h>
 #include <functional>
 #include <memory>
 #include <string>
@@ -9,6 +10,8 @@
 #include <unordered_set>
 
 #include "core/FrameContext.h"
+#include "PassScheduler.h"
+#include "ResourceGraph.h"
 
 class TaskScheduler;
 class TaskGroup;
@@ -27,6 +30,16 @@ struct QueueSubmitDiagnostics;
  * 2. Compiles to find parallelization opportunities
  * 3. Executes passes in dependency order, running independent passes in parallel
  *
+ * Execution is dependency-driven (see PassScheduler): a pass starts as soon
+ * as its own dependencies finish rather than when its whole level does,
+ * and ready passes are taken longest-remaining-chain first.
+ *
+ * Passes may also declare the resources they read and write (see
+ * ResourceGraph). For those, compile() derives the ordering, culls passes
+ * whose outputs nothing reads, and records layout transitions/barriers
+ * around each pass. Transient resources are owned by the graph and share
+ * memory with other transients whose lifetimes don't overlap.
+ *
  * Example graph:
  *   ComputeStage ──┬──> ShadowPass ──> HDRPass ──> PostProcess
  *                  └──> FroxelStage ─┘
@@ -73,10 +86,12 @@ public:
         // and be parallelized with other secondary-capable passes at the same level
         bool canUseSecondary = false;
 
-        // If true, this pass must run on the main thread
+        // If true, this pass must run on the main thread. If false it may run on
+        // a worker concurrently with any pass it isn't ordered against, so it
+        // must not record into the frame's primary command buffer.
         bool mainThreadOnly = true;
 
-        // Priority within the same dependency level (higher = earlier)
+        // Tie-break between ready passes with equal critical paths (higher = earlier)
         int32_t priority = 0;
 
         // Number of secondary buffers to allocate (for parallel recording)
@@ -87,6 +102,23 @@ public:
         // Called once per slot, potentially from different threads
         // Only used when canUseSecondary = true and secondarySlots > 0
         SecondaryRecordFunction secondaryRecord;
+
+        // Declared resource usage, at most one entry per resource. A pass that
+        // declares any resources runs on the main thread, since its barriers
+        // are recorded into the primary command buffer.
+        std::vector<ResourceGraph::ResourceUse> resources;
+
+        // Keep the pass even if nothing reads what it writes
+        bool hasSideEffects = false;
+    };
+
+    using ResourceId = ResourceGraph::ResourceId;
+    using ResourceAccess = ResourceGraph::Access;
+    static constexpr ResourceId INVALID_RESOURCE = ResourceGraph::INVALID_RESOURCE;
+
+    enum class ExecutionMode {
+        DependencyDriven,   // Each pass starts when its dependencies finish
+        LevelBarriers       // Whole levels with a barrier in between (previous behaviour)
     };
 
     FrameGraph() = default;
@@ -128,9 +160,53 @@ public:
      */
     bool isPassEnabled(PassId id) const;
 
+    /**
+     * Import an image owned elsewhere (e.g. the swapchain or a subsystem).
+     * Bind its handle with bindImage() before execute(). initial/final are
+     * the states it is in at frame start and must be left in
+     * (final None = leave it in whatever state its last user needs).
+     */
+    ResourceId importImage(const std::string& name, ResourceAccess initialAccess, ResourceAccess finalAccess,
+                           vk::ImageAspectFlags aspect = vk::ImageAspectFlagBits::eColor);
+    ResourceId importBuffer(const std::string& name, ResourceAccess initialAccess, ResourceAccess finalAccess);
+    void bindImage(ResourceId id, vk::Image image, vk::ImageView view = {});
+    void bindBuffer(ResourceId id, vk::Buffer buffer);
+
+    /**
+     * Declare a transient image/buffer owned by the graph. Its contents are
+     * only defined between its first and last use within a frame.
+     */
+    ResourceId createTransientImage(const std::string& name, const vk::ImageCreateInfo& info,
+                                    vk::ImageViewType viewType = vk::ImageViewType::e2D,
+                                    vk::ImageAspectFlags aspect = vk::ImageAspectFlagBits::eColor);
+    ResourceId createTransientBuffer(const std::string& name, vk::DeviceSize size, vk::BufferUsageFlags usage);
+
+    /**
+     * Create the transients used by compiled passes, pack them by lifetime
+     * and bind them into shared allocations. Call after compile(), and again
+     * whenever transient descriptions change (e.g. on resize).
+     */
+    bool realizeTransients(vk::Device device, VmaAllocator allocator);
+
+    // Must run while the device is alive; clear() also calls it
+    void destroyTransients();
+
+    // Resource by the name it was imported or created with
+    ResourceId getResource(const std::string& name) const;
+
+    vk::Image getImage(ResourceId id) const;
+    vk::ImageView getImageView(ResourceId id) const;
+    vk::Buffer getBuffer(ResourceId id) const;
+
+    /**
+     * Culled passes, barrier count and transient memory before/after aliasing.
+     */
+    const ResourceGraph::Stats& getResourceStats() const { return resourceGraph_.getStats(); }
+
     /**
      * Compile the graph for execution.
-     * Performs topological sort and identifies parallelization opportunities.
+     * Derives resource dependencies, culls unused passes, then performs the
+     * topological sort and identifies parallelization opportunities.
      * Must be called after adding all passes and dependencies.
      */
     bool compile();
@@ -142,6 +218,15 @@ public:
      */
     void execute(FrameContext& context, TaskScheduler* scheduler = nullptr);
 
+    void setExecutionMode(ExecutionMode mode) { executionMode_ = mode; }
+    ExecutionMode getExecutionMode() const { return executionMode_; }
+
+    /**
+     * CPU timing of the last execute(): wall time, critical path and total
+     * pass time, measured per pass.
+     */
+    const PassScheduler::FrameStats& getLastFrameStats() const { return scheduler_.getLastFrameStats(); }
+
     /**
      * Get pass by name.
      */
@@ -178,12 +263,39 @@ private:
         PassConfig config;
         std::vector<PassId> dependencies;
         std::vector<PassId> dependents;
+        // Edges derived from resource usage by the last compile()
+        std::vector<PassId> derivedDependencies;
+        std::vector<PassId> derivedDependents;
         bool enabled = true;
+        bool culled = false;
+    };
+
+    struct ResourceBinding {
+        vk::Image image;
+        vk::ImageView view;
+        vk::Buffer buffer;
+        vk::ImageAspectFlags aspect = vk::ImageAspectFlagBits::eColor;
+
+        // Transient creation parameters
+        vk::ImageCreateInfo imageInfo;
+        vk::ImageViewType viewType = vk::ImageViewType::e2D;
+        vk::DeviceSize bufferSize = 0;
+        vk::BufferUsageFlags bufferUsage;
     };
 
+    // Feed declared resource usage to resourceGraph_ and apply its results
+    bool compileResources();
+
+    // Translate compiled barriers into one pipeline barrier
+    void recordBarriers(vk::CommandBuffer cmd, const std::vector<ResourceGraph::Barrier>& barriers) const;
+
     // Topological sort helper
     bool topologicalSort(std::vector<std::vector<PassId>>& levels);
 
+    // Run one pass (skipping disabled/empty ones) with its declared barriers
+    void runPass(FrameContext& context, const Pass& pass, TaskScheduler* scheduler);
+    void executePass(FrameContext& context, const Pass& pass, TaskScheduler* scheduler);
+
     // Execute a pass using secondary command buffers for parallel recording
     void executeWithSecondaryBuffers(FrameContext& context, const Pass& pass, TaskScheduler* scheduler);
 
@@ -194,6 +306,18 @@ private:
     // Passes in the same level can potentially run in parallel
     std::vector<std::vector<PassId>> executionLevels_;
 
+    // Compiled DAG of the active passes; node index -> PassId
+    PassScheduler scheduler_;
+    std::vector<PassId> nodeToPass_;
+    ExecutionMode executionMode_ = ExecutionMode::DependencyDriven;
+
+    // Declared resources, indexed by ResourceId
+    ResourceGraph resourceGraph_;
+    std::vector<ResourceBinding> resourceBindings_;
+    std::vector<VmaAllocation> transientHeaps_;
+    vk::Device transientDevice_;
+    VmaAllocator transientAllocator_ = VK_NULL_HANDLE;
+
     PassId nextPassId_ = 0;
     bool compiled_ = false;
 };
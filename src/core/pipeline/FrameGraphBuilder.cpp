@@ -108,3 +108,7 @@ bool FrameGraphBuilder::build(
     SDL_Log("FrameGraph setup complete:\n%s", frameGraph.debugString().c_str());
     return true;
 }
+
+bool FrameGraphBuilder::bindTransients(const FrameGraph& frameGraph, RendererSystems& systems) {
+    return PostPasses::bindTransients(frameGraph, systems);
+}
@@ -24,6 +24,9 @@ class RendererSystems;
  *                  └──> WaterGBuffer ┘          ├──> WaterTileCull┼──> PostProcess
  *                                               ├──> HiZ ──> Bloom┤
  *                                               └──> BilateralGrid┘
+ *
+ * Bloom's down/up-sample steps and the composite's bloom read are ordered by
+ * their declared transient resources rather than explicit edges.
  */
 class FrameGraphBuilder {
 public:
@@ -49,4 +52,10 @@ public:
         const Callbacks& callbacks,
         const State& state
     );
+
+    /**
+     * Hand graph-owned transients (the bloom mip chain) to the systems that
+     * record into them. Call after every FrameGraph::realizeTransients().
+     */
+    static bool bindTransients(const FrameGraph& frameGraph, RendererSystems& systems);
 };
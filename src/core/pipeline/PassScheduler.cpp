@@ -0,0 +1,284 @@
+#include "PassScheduler.h"
+#include "threading/TaskScheduler.h"
+#include "debug/ThreadProfiler.h"
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+float elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+// Weight of the newest sample in the per-pass cost average
+constexpr float COST_SMOOTHING = 0.2f;
+
+} // namespace
+
+// Per-execute() bookkeeping shared between the calling thread and workers
+struct PassScheduler::ExecutionState {
+    const RunFunction& runNode;
+    TaskScheduler* scheduler;
+    std::unique_ptr<std::atomic<uint32_t>[]> remaining;
+    TaskGroup workers;
+
+    // Main-thread queue; finished counts every node, wherever it ran
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<NodeIndex> mainReady;
+    size_t finished = 0;
+
+    std::atomic<uint32_t> workerPasses{0};
+
+    ExecutionState(const RunFunction& run, TaskScheduler* sched, size_t count)
+        : runNode(run), scheduler(sched), remaining(new std::atomic<uint32_t>[count]) {}
+};
+
+bool PassScheduler::build(std::vector<Node> nodes) {
+    const size_t count = nodes.size();
+
+    std::vector<std::vector<NodeIndex>> dependents(count);
+    std::vector<uint32_t> inDegree(count, 0);
+    for (NodeIndex i = 0; i < count; ++i) {
+        for (NodeIndex dep : nodes[i].dependencies) {
+            if (dep >= count || dep == i) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                    "PassScheduler: '%s' has invalid dependency %u", nodes[i].name.c_str(), dep);
+                return false;
+            }
+            dependents[dep].push_back(i);
+            inDegree[i]++;
+        }
+    }
+
+    // Kahn's algorithm by level, for executeLevels() and cycle detection
+    std::vector<std::vector<NodeIndex>> levels;
+    std::vector<NodeIndex> current;
+    for (NodeIndex i = 0; i < count; ++i) {
+        if (inDegree[i] == 0) current.push_back(i);
+    }
+    size_t visited = 0;
+    while (!current.empty()) {
+        std::vector<NodeIndex> next;
+        for (NodeIndex node : current) {
+            visited++;
+            for (NodeIndex dependent : dependents[node]) {
+                if (--inDegree[dependent] == 0) next.push_back(dependent);
+            }
+        }
+        levels.push_back(std::move(current));
+        current = std::move(next);
+    }
+    if (visited != count) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+            "PassScheduler: Cycle detected, %zu of %zu nodes reachable", visited, count);
+        return false;
+    }
+
+    nodes_ = std::move(nodes);
+    dependents_ = std::move(dependents);
+    levels_ = std::move(levels);
+    costMs_.assign(count, 0.0f);
+    lastRunMs_.assign(count, 0.0f);
+    criticalPathMs_.assign(count, 0.0f);
+    profileZones_.resize(count);
+    for (NodeIndex i = 0; i < count; ++i) {
+        profileZones_[i] = ThreadProfiler::instance().internName(nodes_[i].name);
+    }
+    lastFrameStats_ = {};
+    updatePriorities();
+    return true;
+}
+
+bool PassScheduler::higherPriority(NodeIndex a, NodeIndex b) const {
+    if (criticalPathMs_[a] != criticalPathMs_[b]) return criticalPathMs_[a] > criticalPathMs_[b];
+    if (nodes_[a].priority != nodes_[b].priority) return nodes_[a].priority > nodes_[b].priority;
+    return a < b;
+}
+
+void PassScheduler::updatePriorities() {
+    // Reverse level order visits every dependent before its dependencies
+    for (auto level = levels_.rbegin(); level != levels_.rend(); ++level) {
+        for (NodeIndex node : *level) {
+            float downstream = 0.0f;
+            for (NodeIndex dependent : dependents_[node]) {
+                downstream = std::max(downstream, criticalPathMs_[dependent]);
+            }
+            criticalPathMs_[node] = costMs_[node] + downstream;
+        }
+    }
+
+    auto byPriority = [this](NodeIndex a, NodeIndex b) { return higherPriority(a, b); };
+    for (auto& list : dependents_) {
+        std::sort(list.begin(), list.end(), byPriority);
+    }
+    roots_ = levels_.empty() ? std::vector<NodeIndex>{} : levels_.front();
+    std::sort(roots_.begin(), roots_.end(), byPriority);
+}
+
+void PassScheduler::setCostEstimate(NodeIndex node, float ms) {
+    if (node < costMs_.size()) {
+        costMs_[node] = std::max(0.0f, ms);
+        updatePriorities();
+    }
+}
+
+float PassScheduler::getCostEstimate(NodeIndex node) const {
+    return node < costMs_.size() ? costMs_[node] : 0.0f;
+}
+
+float PassScheduler::getCriticalPathMs(NodeIndex node) const {
+    return node < criticalPathMs_.size() ? criticalPathMs_[node] : 0.0f;
+}
+
+void PassScheduler::recordCost(NodeIndex node, float ms) {
+    // Each node runs once per frame, so only one thread writes its slot
+    lastRunMs_[node] = ms;
+    costMs_[node] = costMs_[node] > 0.0f ? costMs_[node] + (ms - costMs_[node]) * COST_SMOOTHING : ms;
+}
+
+void PassScheduler::launch(ExecutionState& state, NodeIndex node) {
+    if (state.scheduler && !nodes_[node].mainThreadOnly) {
+        state.workerPasses.fetch_add(1, std::memory_order_relaxed);
+        // High priority: the render thread is waiting on the frame
+        state.scheduler->submit([this, &state, node]() {
+            ThreadProfiler::ScopedZone zone(profileZones_[node]);
+            runAndComplete(state, node);
+        }, &state.workers, TaskScheduler::Priority::High);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.mainReady.push_back(node);
+    state.cv.notify_all();
+}
+
+void PassScheduler::runAndComplete(ExecutionState& state, NodeIndex node) {
+    auto start = Clock::now();
+    state.runNode(node);
+    recordCost(node, elapsedMs(start));
+
+    // Dependents are sorted critical path first, so the longest chain is launched first
+    for (NodeIndex dependent : dependents_[node]) {
+        if (state.remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            launch(state, dependent);
+        }
+    }
+
+    // Notify under the lock: once finished reaches the total the calling
+    // thread may return, but it still waits on the worker group first
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.finished++;
+    state.cv.notify_all();
+}
+
+void PassScheduler::execute(const RunFunction& runNode, TaskScheduler* scheduler) {
+    const size_t count = nodes_.size();
+    if (count == 0) return;
+
+    auto frameStart = Clock::now();
+    ExecutionState state(runNode, scheduler, count);
+    for (NodeIndex i = 0; i < count; ++i) {
+        state.remaining[i].store(static_cast<uint32_t>(nodes_[i].dependencies.size()), std::memory_order_relaxed);
+    }
+
+    for (NodeIndex root : roots_) {
+        launch(state, root);
+    }
+
+    // Drain main-thread passes until every node, on any thread, is done
+    uint32_t mainThreadPasses = 0;
+    while (true) {
+        NodeIndex node;
+        {
+            std::unique_lock<std::mutex> lock(state.mutex);
+            state.cv.wait(lock, [&state, count]() {
+                return !state.mainReady.empty() || state.finished == count;
+            });
+            if (state.mainReady.empty()) break;
+
+            auto best = std::min_element(state.mainReady.begin(), state.mainReady.end(),
+                [this](NodeIndex a, NodeIndex b) { return higherPriority(a, b); });
+            node = *best;
+            state.mainReady.erase(best);
+        }
+        mainThreadPasses++;
+        runAndComplete(state, node);
+    }
+
+    state.workers.wait();
+    finishStats(elapsedMs(frameStart), state.workerPasses.load(), mainThreadPasses);
+    updatePriorities();
+}
+
+void PassScheduler::executeLevels(const RunFunction& runNode, TaskScheduler* scheduler) {
+    if (nodes_.empty()) return;
+
+    auto frameStart = Clock::now();
+    uint32_t workerPasses = 0;
+    uint32_t mainThreadPasses = 0;
+
+    auto timedRun = [this, &runNode](NodeIndex node) {
+        auto start = Clock::now();
+        runNode(node);
+        recordCost(node, elapsedMs(start));
+    };
+
+    for (const auto& level : levels_) {
+        bool parallel = scheduler != nullptr && level.size() > 1;
+        for (NodeIndex node : level) {
+            if (nodes_[node].mainThreadOnly) {
+                parallel = false;
+                break;
+            }
+        }
+
+        if (parallel) {
+            TaskGroup group;
+            for (NodeIndex node : level) {
+                scheduler->submit([this, &timedRun, node]() {
+                    ThreadProfiler::ScopedZone zone(profileZones_[node]);
+                    timedRun(node);
+                }, &group, TaskScheduler::Priority::High);
+            }
+            group.wait();
+            workerPasses += static_cast<uint32_t>(level.size());
+        } else {
+            for (NodeIndex node : level) {
+                timedRun(node);
+            }
+            mainThreadPasses += static_cast<uint32_t>(level.size());
+        }
+    }
+
+    finishStats(elapsedMs(frameStart), workerPasses, mainThreadPasses);
+    updatePriorities();
+}
+
+void PassScheduler::finishStats(float wallMs, uint32_t workerPasses, uint32_t mainThreadPasses) {
+    FrameStats stats;
+    stats.wallMs = wallMs;
+    stats.workerPasses = workerPasses;
+    stats.mainThreadPasses = mainThreadPasses;
+
+    // Longest chain of this frame's actual times
+    std::vector<float> path(nodes_.size(), 0.0f);
+    for (auto level = levels_.rbegin(); level != levels_.rend(); ++level) {
+        for (NodeIndex node : *level) {
+            float downstream = 0.0f;
+            for (NodeIndex dependent : dependents_[node]) {
+                downstream = std::max(downstream, path[dependent]);
+            }
+            path[node] = lastRunMs_[node] + downstream;
+            stats.criticalPathMs = std::max(stats.criticalPathMs, path[node]);
+            stats.totalWorkMs += lastRunMs_[node];
+        }
+    }
+    lastFrameStats_ = stats;
+}
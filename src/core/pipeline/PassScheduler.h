@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TaskScheduler;
+
+/**
+ * PassScheduler - Runs a DAG of frame passes as soon as each one is ready
+ *
+ * Each node carries a remaining-dependency counter. When a node finishes,
+ * its dependents' counters are decremented and any that reach zero are
+ * launched straight away - there is no barrier between graph levels, so a
+ * long pass doesn't hold back unrelated work that only shares its level.
+ *
+ * Nodes that may run anywhere go to TaskScheduler workers. Main-thread-only
+ * nodes go into a queue that the calling thread drains while it waits for
+ * the frame, so they also start the moment their inputs are done.
+ *
+ * Ready nodes are ordered critical-path first: a node's critical path is
+ * its own measured cost plus the longest chain of dependents behind it
+ * (costs are a moving average of previous frames; static priority breaks
+ * ties, e.g. on the first frame).
+ *
+ * No Vulkan dependencies - FrameGraph supplies the work via runNode, so
+ * the scheduling can be tested with synthetic passes.
+ */
+class PassScheduler {
+public:
+    using NodeIndex = uint32_t;
+    using RunFunction = std::function<void(NodeIndex)>;
+
+    struct Node {
+        std::string name;
+        std::vector<NodeIndex> dependencies;
+        bool mainThreadOnly = true;
+        int32_t priority = 0;       // Tie-break, higher first
+    };
+
+    struct FrameStats {
+        float wallMs = 0.0f;            // execute() start to finish
+        float criticalPathMs = 0.0f;    // Longest chain of measured pass times
+        float totalWorkMs = 0.0f;       // Sum of measured pass times
+        uint32_t workerPasses = 0;
+        uint32_t mainThreadPasses = 0;
+    };
+
+    PassScheduler() = default;
+
+    PassScheduler(const PassScheduler&) = delete;
+    PassScheduler& operator=(const PassScheduler&) = delete;
+
+    /**
+     * Replace the graph. Returns false (and keeps nothing) if the
+     * dependencies contain a cycle or an out-of-range index.
+     */
+    bool build(std::vector<Node> nodes);
+
+    /**
+     * Run every node once, dependency-driven. runNode is called with the
+     * node index from a worker or, for main-thread-only nodes, from the
+     * calling thread. Without a scheduler every node runs on the calling
+     * thread, still in critical-path order. Returns when all have finished.
+     */
+    void execute(const RunFunction& runNode, TaskScheduler* scheduler);
+
+    /**
+     * Level-synchronous execution: all nodes of a level, then a barrier.
+     * A level holding any main-thread-only node runs sequentially. This is
+     * what FrameGraph used to do; kept for A/B comparison.
+     */
+    void executeLevels(const RunFunction& runNode, TaskScheduler* scheduler);
+
+    // Seed or override a node's cost estimate (normally measured)
+    void setCostEstimate(NodeIndex node, float ms);
+    float getCostEstimate(NodeIndex node) const;
+
+    // Own cost plus the longest chain of dependents behind it
+    float getCriticalPathMs(NodeIndex node) const;
+
+    size_t getNodeCount() const { return nodes_.size(); }
+    const std::vector<std::vector<NodeIndex>>& getLevels() const { return levels_; }
+    const FrameStats& getLastFrameStats() const { return lastFrameStats_; }
+
+private:
+    struct ExecutionState;
+
+    // Recompute critical paths and the launch order from the current costs
+    void updatePriorities();
+
+    bool higherPriority(NodeIndex a, NodeIndex b) const;
+
+    void launch(ExecutionState& state, NodeIndex node);
+    void runAndComplete(ExecutionState& state, NodeIndex node);
+    void recordCost(NodeIndex node, float ms);
+    void finishStats(float wallMs, uint32_t workerPasses, uint32_t mainThreadPasses);
+
+    std::vector<Node> nodes_;
+    std::vector<std::vector<NodeIndex>> dependents_;     // Sorted critical path first
+    std::vector<std::vector<NodeIndex>> levels_;
+    std::vector<NodeIndex> roots_;                       // Sorted critical path first
+
+    std::vector<float> costMs_;          // Moving average of measured run time
+    std::vector<float> lastRunMs_;       // This frame's run time
+    std::vector<float> criticalPathMs_;
+    std::vector<uint32_t> profileZones_; // Worker-lane zone per node, named after it
+
+    FrameStats lastFrameStats_;
+};
@@ -0,0 +1,360 @@
+#include "ResourceGraph.h"
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+
+namespace {
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+}
+
+} // namespace
+
+bool ResourceGraph::isRead(Access access) {
+    switch (access) {
+        case Access::DepthStencilRead:
+        case Access::ShaderSampledRead:
+        case Access::ComputeStorageRead:
+        case Access::ComputeStorageReadWrite:
+        case Access::TransferRead:
+        case Access::IndirectRead:
+        case Access::VertexRead:
+        case Access::Present:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool ResourceGraph::isWrite(Access access) {
+    switch (access) {
+        case Access::ColorAttachmentWrite:
+        case Access::DepthStencilWrite:
+        case Access::ComputeStorageWrite:
+        case Access::ComputeStorageReadWrite:
+        case Access::TransferWrite:
+            return true;
+        default:
+            return false;
+    }
+}
+
+const char* ResourceGraph::accessName(Access access) {
+    switch (access) {
+        case Access::None: return "None";
+        case Access::ColorAttachmentWrite: return "ColorAttachmentWrite";
+        case Access::DepthStencilWrite: return "DepthStencilWrite";
+        case Access::DepthStencilRead: return "DepthStencilRead";
+        case Access::ShaderSampledRead: return "ShaderSampledRead";
+        case Access::ComputeStorageRead: return "ComputeStorageRead";
+        case Access::ComputeStorageWrite: return "ComputeStorageWrite";
+        case Access::ComputeStorageReadWrite: return "ComputeStorageReadWrite";
+        case Access::TransferRead: return "TransferRead";
+        case Access::TransferWrite: return "TransferWrite";
+        case Access::IndirectRead: return "IndirectRead";
+        case Access::VertexRead: return "VertexRead";
+        case Access::Present: return "Present";
+    }
+    return "Unknown";
+}
+
+ResourceGraph::ResourceId ResourceGraph::addResource(ResourceDesc desc) {
+    resources_.push_back(std::move(desc));
+    compiled_ = false;
+    return static_cast<ResourceId>(resources_.size() - 1);
+}
+
+void ResourceGraph::setResourceMemory(ResourceId id, uint64_t sizeBytes, uint64_t alignment, uint32_t memoryTypeBits) {
+    if (id >= resources_.size()) return;
+    resources_[id].sizeBytes = sizeBytes;
+    resources_[id].alignment = std::max<uint64_t>(alignment, 1);
+    resources_[id].memoryTypeBits = memoryTypeBits;
+}
+
+void ResourceGraph::clear() {
+    resources_.clear();
+    culled_.clear();
+    derived_.clear();
+    barriers_.clear();
+    reachable_.clear();
+    firstUse_.clear();
+    lastUse_.clear();
+    lastAccess_.clear();
+    placements_.clear();
+    heaps_.clear();
+    stats_ = {};
+    compiled_ = false;
+}
+
+bool ResourceGraph::compile(const std::vector<PassDesc>& passes) {
+    compiled_ = false;
+    const size_t passCount = passes.size();
+    const size_t resourceCount = resources_.size();
+
+    for (PassIndex p = 0; p < passCount; ++p) {
+        const PassDesc& pass = passes[p];
+        if (!pass.active) continue;
+        std::vector<bool> seen(resourceCount, false);
+        for (const ResourceUse& use : pass.uses) {
+            if (use.resource >= resourceCount) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                    "ResourceGraph: Pass '%s' uses invalid resource %u", pass.name.c_str(), use.resource);
+                return false;
+            }
+            if (seen[use.resource]) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                    "ResourceGraph: Pass '%s' uses '%s' more than once",
+                    pass.name.c_str(), resources_[use.resource].name.c_str());
+                return false;
+            }
+            seen[use.resource] = true;
+        }
+    }
+
+    // Producers: the last writer before each read, in declaration order
+    std::vector<std::vector<PassIndex>> producers(passCount);
+    {
+        std::vector<PassIndex> lastWriter(resourceCount, NO_PASS);
+        for (PassIndex p = 0; p < passCount; ++p) {
+            if (!passes[p].active) continue;
+            for (const ResourceUse& use : passes[p].uses) {
+                if (isRead(use.access) && lastWriter[use.resource] != NO_PASS) {
+                    producers[p].push_back(lastWriter[use.resource]);
+                }
+            }
+            for (const ResourceUse& use : passes[p].uses) {
+                if (isWrite(use.access)) lastWriter[use.resource] = p;
+            }
+        }
+    }
+
+    // Cull: walk back from the passes whose results leave the graph
+    culled_.assign(passCount, true);
+    std::vector<PassIndex> worklist;
+    for (PassIndex p = 0; p < passCount; ++p) {
+        const PassDesc& pass = passes[p];
+        if (!pass.active) continue;
+        bool root = pass.uses.empty() || pass.hasSideEffects;
+        for (const ResourceUse& use : pass.uses) {
+            if (isWrite(use.access) && resources_[use.resource].imported) root = true;
+        }
+        if (root) {
+            culled_[p] = false;
+            worklist.push_back(p);
+        }
+    }
+    while (!worklist.empty()) {
+        PassIndex p = worklist.back();
+        worklist.pop_back();
+        auto keep = [&](PassIndex q) {
+            if (q < passCount && passes[q].active && culled_[q]) {
+                culled_[q] = false;
+                worklist.push_back(q);
+            }
+        };
+        for (PassIndex q : producers[p]) keep(q);
+        for (PassIndex q : passes[p].dependencies) keep(q);
+    }
+
+    // Order and barriers over the kept passes only, so a culled pass can't
+    // leave a gap in a resource's chain of uses
+    derived_.assign(passCount, {});
+    barriers_.assign(passCount, {});
+    firstUse_.assign(resourceCount, NO_PASS);
+    lastUse_.assign(resourceCount, NO_PASS);
+    lastAccess_.assign(resourceCount, Access::None);
+    for (ResourceId r = 0; r < resourceCount; ++r) {
+        if (resources_[r].imported) lastAccess_[r] = resources_[r].initialAccess;
+    }
+
+    stats_ = {};
+    for (PassIndex p = 0; p < passCount; ++p) {
+        if (!passes[p].active) continue;
+        stats_.activePasses++;
+        if (culled_[p]) {
+            stats_.culledPasses++;
+            continue;
+        }
+        for (const ResourceUse& use : passes[p].uses) {
+            ResourceId r = use.resource;
+            PassIndex previous = lastUse_[r];
+            if (previous == NO_PASS) {
+                firstUse_[r] = p;
+            } else if (std::find(derived_[p].begin(), derived_[p].end(), previous) == derived_[p].end()) {
+                derived_[p].push_back(previous);
+            }
+
+            // Repeated reads of the same kind need neither a layout change nor a barrier
+            Access before = lastAccess_[r];
+            if (before != use.access || isWrite(use.access)) {
+                barriers_[p].before.push_back({r, before, use.access, {}});
+            }
+            lastAccess_[r] = use.access;
+            lastUse_[r] = p;
+        }
+    }
+
+    for (ResourceId r = 0; r < resourceCount; ++r) {
+        const ResourceDesc& desc = resources_[r];
+        if (desc.imported && lastUse_[r] != NO_PASS &&
+            desc.finalAccess != Access::None && desc.finalAccess != lastAccess_[r]) {
+            barriers_[lastUse_[r]].after.push_back({r, lastAccess_[r], desc.finalAccess, {}});
+        }
+    }
+    for (const PassBarriers& b : barriers_) {
+        stats_.barriers += static_cast<uint32_t>(b.before.size() + b.after.size());
+    }
+
+    // Topological order of kept passes over derived + explicit edges
+    std::vector<std::vector<PassIndex>> dependents(passCount);
+    std::vector<uint32_t> inDegree(passCount, 0);
+    size_t keptCount = 0;
+    for (PassIndex p = 0; p < passCount; ++p) {
+        if (!passes[p].active || culled_[p]) continue;
+        keptCount++;
+        auto addEdge = [&](PassIndex from) {
+            if (from >= passCount || !passes[from].active || culled_[from]) return;
+            dependents[from].push_back(p);
+            inDegree[p]++;
+        };
+        for (PassIndex q : derived_[p]) addEdge(q);
+        for (PassIndex q : passes[p].dependencies) addEdge(q);
+    }
+
+    std::vector<PassIndex> order;
+    order.reserve(keptCount);
+    for (PassIndex p = 0; p < passCount; ++p) {
+        if (passes[p].active && !culled_[p] && inDegree[p] == 0) order.push_back(p);
+    }
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (PassIndex d : dependents[order[i]]) {
+            if (--inDegree[d] == 0) order.push_back(d);
+        }
+    }
+    if (order.size() != keptCount) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+            "ResourceGraph: Cycle between explicit and resource dependencies (%zu of %zu passes ordered)",
+            order.size(), keptCount);
+        return false;
+    }
+
+    // Transitive closure, dependents before the passes that feed them
+    const size_t words = (passCount + 63) / 64;
+    reachable_.assign(passCount, std::vector<uint64_t>(words, 0));
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        std::vector<uint64_t>& reach = reachable_[*it];
+        for (PassIndex d : dependents[*it]) {
+            reach[d / 64] |= uint64_t(1) << (d % 64);
+            for (size_t w = 0; w < words; ++w) reach[w] |= reachable_[d][w];
+        }
+    }
+
+    compiled_ = true;
+    planAliasing();
+    return true;
+}
+
+bool ResourceGraph::isOrderedBefore(PassIndex from, PassIndex to) const {
+    if (from >= reachable_.size() || to >= reachable_.size()) return false;
+    return (reachable_[from][to / 64] >> (to % 64)) & 1;
+}
+
+bool ResourceGraph::lifetimesOrdered(ResourceId a, ResourceId b) const {
+    return isOrderedBefore(lastUse_[a], firstUse_[b]);
+}
+
+void ResourceGraph::planAliasing() {
+    if (!compiled_) return;
+
+    placements_.assign(resources_.size(), Placement{});
+    heaps_.clear();
+    stats_.transientResources = 0;
+    stats_.unaliasedBytes = 0;
+    stats_.aliasedBytes = 0;
+    for (PassBarriers& b : barriers_) {
+        for (Barrier& barrier : b.before) barrier.aliasedFrom.clear();
+    }
+
+    std::vector<ResourceId> transients;
+    for (ResourceId r = 0; r < resources_.size(); ++r) {
+        if (!resources_[r].imported && firstUse_[r] != NO_PASS) {
+            transients.push_back(r);
+            stats_.transientResources++;
+            stats_.unaliasedBytes += alignUp(resources_[r].sizeBytes, resources_[r].alignment);
+        }
+    }
+
+    // Largest first, so small resources fill the gaps the big ones leave
+    std::sort(transients.begin(), transients.end(), [this](ResourceId a, ResourceId b) {
+        if (resources_[a].sizeBytes != resources_[b].sizeBytes) {
+            return resources_[a].sizeBytes > resources_[b].sizeBytes;
+        }
+        return firstUse_[a] < firstUse_[b];
+    });
+
+    for (ResourceId r : transients) {
+        const ResourceDesc& desc = resources_[r];
+
+        uint32_t heapIndex = NO_HEAP;
+        for (uint32_t h = 0; h < heaps_.size(); ++h) {
+            if (heaps_[h].type == desc.type && heaps_[h].memoryTypeBits == desc.memoryTypeBits) {
+                heapIndex = h;
+                break;
+            }
+        }
+        if (heapIndex == NO_HEAP) {
+            heapIndex = static_cast<uint32_t>(heaps_.size());
+            Heap heap;
+            heap.type = desc.type;
+            heap.memoryTypeBits = desc.memoryTypeBits;
+            heaps_.push_back(heap);
+        }
+        Heap& heap = heaps_[heapIndex];
+
+        // Ranges held by resources that may be live at the same time
+        struct Range { uint64_t begin, end; };
+        std::vector<Range> occupied;
+        for (ResourceId other : heap.resources) {
+            if (!lifetimesOrdered(other, r) && !lifetimesOrdered(r, other)) {
+                const Placement& p = placements_[other];
+                occupied.push_back({p.offset, p.offset + resources_[other].sizeBytes});
+            }
+        }
+        std::sort(occupied.begin(), occupied.end(),
+            [](const Range& a, const Range& b) { return a.begin < b.begin; });
+
+        uint64_t offset = 0;
+        for (const Range& range : occupied) {
+            if (offset + desc.sizeBytes <= range.begin) break;
+            offset = std::max(offset, alignUp(range.end, desc.alignment));
+        }
+
+        placements_[r] = {heapIndex, offset};
+        heap.resources.push_back(r);
+        heap.sizeBytes = std::max(heap.sizeBytes, offset + desc.sizeBytes);
+        heap.alignment = std::max(heap.alignment, desc.alignment);
+    }
+
+    // Each transient's first barrier waits for whatever used its memory before
+    for (const Heap& heap : heaps_) {
+        stats_.aliasedBytes += heap.sizeBytes;
+        for (ResourceId r : heap.resources) {
+            const Placement& mine = placements_[r];
+            uint64_t myEnd = mine.offset + resources_[r].sizeBytes;
+            std::vector<ResourceId> previous;
+            for (ResourceId other : heap.resources) {
+                const Placement& theirs = placements_[other];
+                bool overlaps = theirs.offset < myEnd && mine.offset < theirs.offset + resources_[other].sizeBytes;
+                if (other != r && overlaps && lifetimesOrdered(other, r)) previous.push_back(other);
+            }
+            if (previous.empty()) continue;
+
+            for (Barrier& barrier : barriers_[firstUse_[r]].before) {
+                if (barrier.resource == r) {
+                    barrier.aliasedFrom = std::move(previous);
+                    break;
+                }
+            }
+        }
+    }
+}
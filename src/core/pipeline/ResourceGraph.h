@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * ResourceGraph - Compiles declared per-pass resource usage into a frame plan
+ *
+ * Passes list the resources they read and write. compile() turns that into:
+ * - Ordering: every use of a resource is ordered after the previous use in
+ *   declaration order, so each pass has one well-defined prior state.
+ * - Culling: a pass is kept only if it has side effects, writes an imported
+ *   resource, or produces something a kept pass reads. Passes that declare
+ *   no resources at all are always kept.
+ * - Barriers: the access a resource moves from/to before each pass, plus the
+ *   transition to an imported resource's final access after its last user.
+ * - Aliasing: transient resources whose lifetimes are strictly ordered share
+ *   memory. Placement is first-fit by decreasing size into one heap per
+ *   (type, memoryTypeBits); each resource takes the lowest offset that does
+ *   not overlap any resource it could be live alongside.
+ *
+ * Everything here is in abstract terms (Access, byte sizes) - no Vulkan - so
+ * the compile step is testable without a device. FrameGraph maps accesses to
+ * stages/layouts and binds real memory.
+ */
+class ResourceGraph {
+public:
+    using ResourceId = uint32_t;
+    using PassIndex = uint32_t;
+    static constexpr ResourceId INVALID_RESOURCE = UINT32_MAX;
+    static constexpr PassIndex NO_PASS = UINT32_MAX;
+    static constexpr uint32_t NO_HEAP = UINT32_MAX;
+
+    enum class ResourceType : uint8_t { Image, Buffer };
+
+    enum class Access : uint8_t {
+        None,                       // Undefined contents
+        ColorAttachmentWrite,
+        DepthStencilWrite,
+        DepthStencilRead,
+        ShaderSampledRead,          // Fragment or compute sampling
+        ComputeStorageRead,
+        ComputeStorageWrite,        // Overwrites; previous contents not needed
+        ComputeStorageReadWrite,
+        TransferRead,
+        TransferWrite,
+        IndirectRead,
+        VertexRead,                 // Vertex or index input
+        Present
+    };
+
+    static bool isRead(Access access);
+    static bool isWrite(Access access);
+    static const char* accessName(Access access);
+
+    struct ResourceDesc {
+        std::string name;
+        ResourceType type = ResourceType::Image;
+
+        // Imported resources live outside the graph and are never aliased
+        bool imported = false;
+        Access initialAccess = Access::None;    // Imported: state at frame start
+        Access finalAccess = Access::None;      // Imported: state to leave it in (None = don't care)
+
+        // Transient memory requirements
+        uint64_t sizeBytes = 0;
+        uint64_t alignment = 1;
+        uint32_t memoryTypeBits = ~0u;
+    };
+
+    struct ResourceUse {
+        ResourceId resource = INVALID_RESOURCE;
+        Access access = Access::None;
+    };
+
+    struct PassDesc {
+        std::string name;
+        bool active = true;                     // Inactive passes are ignored entirely
+        bool hasSideEffects = false;            // Never culled
+        std::vector<ResourceUse> uses;          // At most one use per resource
+        std::vector<PassIndex> dependencies;    // Explicit ordering edges
+    };
+
+    struct Barrier {
+        ResourceId resource = INVALID_RESOURCE;
+        Access before = Access::None;
+        Access after = Access::None;
+        // First use of an aliased transient: resources that previously
+        // occupied the same memory and must finish first
+        std::vector<ResourceId> aliasedFrom;
+    };
+
+    struct PassBarriers {
+        std::vector<Barrier> before;
+        std::vector<Barrier> after;
+    };
+
+    struct Placement {
+        uint32_t heap = NO_HEAP;
+        uint64_t offset = 0;
+    };
+
+    struct Heap {
+        ResourceType type = ResourceType::Image;
+        uint32_t memoryTypeBits = ~0u;
+        uint64_t sizeBytes = 0;
+        uint64_t alignment = 1;
+        std::vector<ResourceId> resources;
+    };
+
+    struct Stats {
+        uint32_t activePasses = 0;
+        uint32_t culledPasses = 0;
+        uint32_t barriers = 0;
+        uint32_t transientResources = 0;    // Used by at least one kept pass
+        uint64_t unaliasedBytes = 0;        // Every transient in its own allocation
+        uint64_t aliasedBytes = 0;          // Sum of heap sizes
+    };
+
+    ResourceGraph() = default;
+
+    ResourceId addResource(ResourceDesc desc);
+    const ResourceDesc& getResource(ResourceId id) const { return resources_[id]; }
+    size_t getResourceCount() const { return resources_.size(); }
+
+    // Update memory requirements once known (e.g. queried from the device);
+    // call planAliasing() afterwards to repack
+    void setResourceMemory(ResourceId id, uint64_t sizeBytes, uint64_t alignment, uint32_t memoryTypeBits);
+
+    /**
+     * Compile the passes (indexed by position). Returns false on an invalid
+     * resource reference, a resource used twice by one pass, or a cycle
+     * between explicit and derived edges.
+     */
+    bool compile(const std::vector<PassDesc>& passes);
+
+    // Repack transient memory from the current sizes; compile() calls this
+    void planAliasing();
+
+    bool isCompiled() const { return compiled_; }
+    bool isCulled(PassIndex pass) const { return pass < culled_.size() && culled_[pass]; }
+
+    // Edges derived from resource usage (not including explicit ones)
+    const std::vector<PassIndex>& getDerivedDependencies(PassIndex pass) const { return derived_[pass]; }
+    const PassBarriers& getBarriers(PassIndex pass) const { return barriers_[pass]; }
+
+    // True if 'from' finishes before 'to' starts through some chain of edges
+    bool isOrderedBefore(PassIndex from, PassIndex to) const;
+
+    PassIndex getFirstUse(ResourceId id) const { return firstUse_[id]; }
+    PassIndex getLastUse(ResourceId id) const { return lastUse_[id]; }
+    Access getLastAccess(ResourceId id) const { return lastAccess_[id]; }
+
+    const Placement& getPlacement(ResourceId id) const { return placements_[id]; }
+    const std::vector<Heap>& getHeaps() const { return heaps_; }
+    const Stats& getStats() const { return stats_; }
+
+    void clear();
+
+private:
+    bool lifetimesOrdered(ResourceId a, ResourceId b) const;
+
+    std::vector<ResourceDesc> resources_;
+
+    std::vector<bool> culled_;
+    std::vector<std::vector<PassIndex>> derived_;
+    std::vector<PassBarriers> barriers_;
+    std::vector<std::vector<uint64_t>> reachable_;   // Bitset of passes ordered after each pass
+
+    std::vector<PassIndex> firstUse_;
+    std::vector<PassIndex> lastUse_;
+    std::vector<Access> lastAccess_;
+
+    std::vector<Placement> placements_;
+    std::vector<Heap> heaps_;
+    Stats stats_;
+    bool compiled_ = false;
+};
@@ -1,13 +1,39 @@
 #include "TaskScheduler.h"
+#include "core/io/IOService.h"
+#include "debug/ThreadProfiler.h"
 #include <SDL3/SDL_log.h>
+#include <algorithm>
 
 thread_local int32_t TaskScheduler::currentThreadId_ = -1;
 
+namespace {
+
+const char* priorityName(TaskScheduler::Priority priority) {
+    switch (priority) {
+        case TaskScheduler::Priority::Low: return "low";
+        case TaskScheduler::Priority::Normal: return "normal";
+        case TaskScheduler::Priority::High: return "high";
+    }
+    return "?";
+}
+
+float toMs(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+} // namespace
+
 TaskScheduler& TaskScheduler::instance() {
     static TaskScheduler instance;
     return instance;
 }
 
+TaskScheduler::TaskScheduler() {
+    generalPools_[static_cast<int>(Priority::Low)] = registerPool("General (low)", Priority::Low, 0);
+    generalPools_[static_cast<int>(Priority::Normal)] = registerPool("General", Priority::Normal, 0);
+    generalPools_[static_cast<int>(Priority::High)] = registerPool("General (high)", Priority::High, 0);
+}
+
 TaskScheduler::~TaskScheduler() {
     shutdown();
 }
@@ -34,10 +60,7 @@ void TaskScheduler::initialize(uint32_t numThreads) {
         workers_.emplace_back(&TaskScheduler::workerThread, this, i);
     }
 
-    // Create dedicated IO thread (pinned for cache affinity as mentioned in video)
-    ioWorker_ = std::thread(&TaskScheduler::ioWorkerThread, this);
-
-    SDL_Log("TaskScheduler: Initialized with %u workers + 1 IO thread", numThreads);
+    SDL_Log("TaskScheduler: Initialized with %u workers (IO tasks go to IOService)", numThreads);
 }
 
 void TaskScheduler::shutdown() {
@@ -45,11 +68,13 @@ void TaskScheduler::shutdown() {
         return;
     }
 
-    running_.store(false);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        running_.store(false);
+    }
 
     // Wake up all waiting threads
     queueCondition_.notify_all();
-    ioCondition_.notify_all();
 
     // Join all worker threads
     for (auto& worker : workers_) {
@@ -59,119 +84,195 @@ void TaskScheduler::shutdown() {
     }
     workers_.clear();
 
-    // Join IO thread
-    if (ioWorker_.joinable()) {
-        ioWorker_.join();
+    SDL_Log("TaskScheduler: Shutdown complete");
+}
+
+TaskScheduler::PoolId TaskScheduler::registerPool(const std::string& name, Priority priority,
+                                                  uint32_t maxConcurrency) {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    for (PoolId id = 0; id < pools_.size(); ++id) {
+        if (pools_[id]->name == name) {
+            pools_[id]->priority = priority;
+            pools_[id]->maxConcurrency = maxConcurrency;
+            queueCondition_.notify_all();   // A raised cap may unblock queued work
+            return id;
+        }
     }
 
-    SDL_Log("TaskScheduler: Shutdown complete");
+    auto pool = std::make_unique<Pool>();
+    pool->name = name;
+    pool->priority = priority;
+    pool->maxConcurrency = maxConcurrency;
+    pool->windowStart = Clock::now();
+    pool->profileZone = ThreadProfiler::instance().internName(name);
+    pools_.push_back(std::move(pool));
+    return static_cast<PoolId>(pools_.size() - 1);
 }
 
-void TaskScheduler::submit(std::function<void()> task, TaskGroup* group, Priority priority) {
+void TaskScheduler::submit(PoolId poolId, std::function<void()> task, TaskGroup* group) {
+    if (group) {
+        group->increment();
+    }
+
     if (!running_.load()) {
         // If scheduler not running, execute synchronously
-        if (group) group->increment();
         task();
         if (group) group->decrement();
         return;
     }
 
-    if (group) {
-        group->increment();
-    }
-
     {
         std::lock_guard<std::mutex> lock(queueMutex_);
-        taskQueue_.push(Task{std::move(task), group, priority});
+        pools_[poolId]->queue.push_back(Task{std::move(task), group});
     }
     queueCondition_.notify_one();
 }
 
-void TaskScheduler::submitIO(std::function<void()> task, TaskGroup* group) {
-    if (!running_.load()) {
-        // If scheduler not running, execute synchronously
-        if (group) group->increment();
-        task();
-        if (group) group->decrement();
-        return;
-    }
+void TaskScheduler::submit(std::function<void()> task, TaskGroup* group, Priority priority) {
+    submit(generalPools_[static_cast<int>(priority)], std::move(task), group);
+}
 
+void TaskScheduler::submitIO(std::function<void()> task, TaskGroup* group) {
     if (group) {
         group->increment();
     }
 
-    {
-        std::lock_guard<std::mutex> lock(ioMutex_);
-        ioQueue_.push(Task{std::move(task), group, Priority::Normal});
-    }
-    ioCondition_.notify_one();
+    IOService::instance().submitTask([task = std::move(task), group]() {
+        task();
+        if (group) {
+            group->decrement();
+        }
+    });
 }
 
 int32_t TaskScheduler::getCurrentThreadId() const {
     return currentThreadId_;
 }
 
-void TaskScheduler::workerThread(uint32_t threadId) {
-    currentThreadId_ = static_cast<int32_t>(threadId);
+uint32_t TaskScheduler::getPoolConcurrency(PoolId pool) const {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    return poolConcurrencyLocked(*pools_[pool]);
+}
 
-    while (running_.load()) {
-        Task task;
+uint32_t TaskScheduler::poolConcurrencyLocked(const Pool& pool) const {
+    uint32_t threads = std::max(1u, static_cast<uint32_t>(workers_.size()));
+    return pool.maxConcurrency == 0 ? threads : std::min(pool.maxConcurrency, threads);
+}
 
-        {
-            std::unique_lock<std::mutex> lock(queueMutex_);
-            queueCondition_.wait(lock, [this] {
-                return !taskQueue_.empty() || !running_.load();
-            });
+std::vector<TaskScheduler::PoolStats> TaskScheduler::getPoolStats() const {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    auto now = Clock::now();
+
+    std::vector<PoolStats> stats;
+    stats.reserve(pools_.size());
+    for (const auto& pool : pools_) {
+        auto elapsed = now - pool->windowStart;
+        if (elapsed >= std::chrono::seconds(1)) {
+            float capacity = toMs(elapsed) * static_cast<float>(poolConcurrencyLocked(*pool));
+            // Tasks are charged when they finish, so a window can briefly see more than its share
+            pool->utilisation = std::min(1.0f, toMs(pool->busy - pool->windowBusy) / capacity);
+            pool->windowStart = now;
+            pool->windowBusy = pool->busy;
+        }
 
-            if (!running_.load() && taskQueue_.empty()) {
-                break;
-            }
+        PoolStats s;
+        s.name = pool->name;
+        s.priority = pool->priority;
+        s.maxConcurrency = pool->maxConcurrency;
+        s.queued = static_cast<uint32_t>(pool->queue.size());
+        s.running = pool->running;
+        s.peakRunning = pool->peakRunning;
+        s.completed = pool->completed;
+        s.busyMs = toMs(pool->busy);
+        s.utilisation = pool->utilisation;
+        stats.push_back(std::move(s));
+    }
+    return stats;
+}
 
-            if (!taskQueue_.empty()) {
-                task = std::move(const_cast<Task&>(taskQueue_.top()));
-                taskQueue_.pop();
-            }
+void TaskScheduler::logThreadReport() const {
+    const auto ioStats = IOService::instance().getStats();
+    uint32_t workers = getThreadCount();
+
+    SDL_Log("Thread report: %u threads (main + %u scheduler workers + %u IOService)",
+            1 + workers + ioStats.threads, workers, ioStats.threads);
+    for (const auto& pool : getPoolStats()) {
+        if (pool.maxConcurrency == 0) {
+            SDL_Log("  pool %-16s %-6s priority, all workers", pool.name.c_str(), priorityName(pool.priority));
+        } else {
+            SDL_Log("  pool %-16s %-6s priority, up to %u workers", pool.name.c_str(),
+                    priorityName(pool.priority), std::min(pool.maxConcurrency, std::max(1u, workers)));
         }
+    }
+}
 
-        if (task.func) {
-            task.func();
-            if (task.group) {
-                task.group->decrement();
-            }
+TaskScheduler::Pool* TaskScheduler::pickPoolLocked() {
+    Pool* best = nullptr;
+    for (const auto& pool : pools_) {
+        if (pool->queue.empty()) continue;
+        if (pool->maxConcurrency != 0 && pool->running >= pool->maxConcurrency) continue;
+        if (!best || pool->priority > best->priority ||
+            (pool->priority == best->priority && pool->lastServed < best->lastServed)) {
+            best = pool.get();
         }
     }
-
-    currentThreadId_ = -1;
+    return best;
 }
 
-void TaskScheduler::ioWorkerThread() {
-    // IO thread gets a special ID beyond worker range
-    currentThreadId_ = static_cast<int32_t>(workers_.size());
+void TaskScheduler::workerThread(uint32_t threadId) {
+    currentThreadId_ = static_cast<int32_t>(threadId);
+    ThreadProfiler::instance().setThreadName("Worker " + std::to_string(threadId));
 
-    while (running_.load()) {
+    while (true) {
         Task task;
+        Pool* pool = nullptr;
+        bool capped = false;
+        ThreadProfiler::ZoneId zone = ThreadProfiler::INVALID_ZONE;
 
         {
-            std::unique_lock<std::mutex> lock(ioMutex_);
-            ioCondition_.wait(lock, [this] {
-                return !ioQueue_.empty() || !running_.load();
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueCondition_.wait(lock, [this, &pool] {
+                pool = pickPoolLocked();
+                return pool != nullptr || !running_.load();
             });
 
-            if (!running_.load() && ioQueue_.empty()) {
+            // Shutting down: leave once nothing is runnable. Capped work still
+            // queued is drained by the workers running that pool's tasks.
+            if (!pool) {
                 break;
             }
 
-            if (!ioQueue_.empty()) {
-                task = std::move(ioQueue_.front());
-                ioQueue_.pop();
-            }
+            task = std::move(pool->queue.front());
+            pool->queue.pop_front();
+            pool->running++;
+            pool->peakRunning = std::max(pool->peakRunning, pool->running);
+            pool->lastServed = ++serveCounter_;
+            capped = pool->maxConcurrency != 0;
+            zone = pool->profileZone;
         }
 
-        if (task.func) {
+        auto start = Clock::now();
+        {
+            // Shows up as this worker's lane in the CPU flamegraph
+            ThreadProfiler::ScopedZone profileZone(zone);
             task.func();
-            if (task.group) {
-                task.group->decrement();
-            }
+        }
+        auto elapsed = Clock::now() - start;
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            pool->running--;
+            pool->completed++;
+            pool->busy += elapsed;
+        }
+        if (capped) {
+            // A capped pool's next task may have been waiting for this slot
+            queueCondition_.notify_one();
+        }
+
+        // Last, so a waiter sees the pool stats already updated
+        if (task.group) {
+            task.group->decrement();
         }
     }
 
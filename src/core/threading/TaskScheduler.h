@@ -1,12 +1,14 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -23,6 +25,9 @@ public:
     }
 
     void decrement() {
+        // Under the mutex so wait() can't return (and the group be destroyed)
+        // between the count reaching zero and the notify
+        std::lock_guard<std::mutex> lock(mutex_);
         if (--pendingCount_ == 0) {
             cv_.notify_all();
         }
@@ -47,10 +52,18 @@ private:
  * Task-based threading system inspired by enkiTS.
  *
  * Key features:
- * - Thread pool with work stealing
- * - Thread affinity for IO operations (cache benefits)
+ * - One worker pool for the whole process; subsystems (physics, tile
+ *   streaming, startup loading, tree generation) submit into named pools
+ *   instead of spawning their own threads
+ * - Pools carry a priority class and a concurrency cap, so background
+ *   work can't occupy every core while frame-critical work waits
+ * - Blocking IO tasks forwarded to IOService's dedicated task thread
  * - TaskGroup support for synchronization
- * - Priority-based task scheduling
+ * - Per-pool stats (queued, running, utilisation) for the profiler
+ *
+ * Workers take the highest-priority pool that has work and is under its
+ * cap; pools of equal priority are served round-robin. Within a pool
+ * tasks run FIFO.
  *
  * Usage:
  *   TaskScheduler& scheduler = TaskScheduler::instance();
@@ -60,6 +73,10 @@ private:
  *   scheduler.submit([&]{ doWork(); }, &group);
  *   scheduler.submit([&]{ doMoreWork(); }, &group);
  *   group.wait();
+ *
+ *   // Subsystem pool: at most 2 tasks at once, behind Normal/High work
+ *   auto pool = scheduler.registerPool("TreeGeneration", TaskScheduler::Priority::Low, 2);
+ *   scheduler.submit(pool, [&]{ generateTree(); }, &group);
  */
 class TaskScheduler {
 public:
@@ -69,16 +86,41 @@ public:
         High = 2
     };
 
+    using PoolId = uint32_t;
+
+    struct PoolStats {
+        std::string name;
+        Priority priority = Priority::Normal;
+        uint32_t maxConcurrency = 0;    // 0 = no cap
+        uint32_t queued = 0;
+        uint32_t running = 0;
+        uint32_t peakRunning = 0;
+        uint64_t completed = 0;
+        float busyMs = 0.0f;            // Total task time
+        float utilisation = 0.0f;       // Share of the pool's cap in use over the last second
+    };
+
     static TaskScheduler& instance();
 
     // Initialize with specified thread count (0 = hardware concurrency - 1)
     void initialize(uint32_t numThreads = 0);
     void shutdown();
 
-    // Submit a task for parallel execution
+    /**
+     * Register a named pool (or update the priority and cap of an existing
+     * one with the same name). maxConcurrency == 0 lets the pool use every
+     * worker. Pools live as long as the scheduler, so this is cheap to call
+     * from each subsystem's init.
+     */
+    PoolId registerPool(const std::string& name, Priority priority, uint32_t maxConcurrency);
+
+    // Submit a task to a registered pool
+    void submit(PoolId pool, std::function<void()> task, TaskGroup* group = nullptr);
+
+    // Submit a task to the shared "General" pool of the given priority
     void submit(std::function<void()> task, TaskGroup* group = nullptr, Priority priority = Priority::Normal);
 
-    // Submit IO task to pinned thread for cache affinity
+    // Submit blocking IO work (runs FIFO on IOService's task thread)
     void submitIO(std::function<void()> task, TaskGroup* group = nullptr);
 
     // Get thread ID for current worker (0 to threadCount-1, or -1 if not a worker thread)
@@ -90,8 +132,18 @@ public:
     // Check if scheduler is running
     bool isRunning() const { return running_.load(); }
 
+    // Workers a pool can actually occupy (its cap, bounded by the thread count)
+    uint32_t getPoolConcurrency(PoolId pool) const;
+
+    std::vector<PoolStats> getPoolStats() const;
+
+    // Log every thread the engine owns and how the pools divide the workers
+    void logThreadReport() const;
+
 private:
-    TaskScheduler() = default;
+    using Clock = std::chrono::steady_clock;
+
+    TaskScheduler();
     ~TaskScheduler();
 
     TaskScheduler(const TaskScheduler&) = delete;
@@ -99,30 +151,43 @@ private:
 
     struct Task {
         std::function<void()> func;
-        TaskGroup* group;
-        Priority priority;
+        TaskGroup* group = nullptr;
+    };
 
-        bool operator<(const Task& other) const {
-            return priority < other.priority; // Higher priority = processed first
-        }
+    struct Pool {
+        std::string name;
+        Priority priority = Priority::Normal;
+        uint32_t maxConcurrency = 0;
+        std::deque<Task> queue;
+        uint32_t running = 0;
+        uint32_t peakRunning = 0;
+        uint64_t completed = 0;
+        uint64_t lastServed = 0;        // Round-robin between equal priorities
+        Clock::duration busy{0};
+
+        // Utilisation window, rolled over by getPoolStats()
+        Clock::time_point windowStart;
+        Clock::duration windowBusy{0};
+        float utilisation = 0.0f;
+
+        uint32_t profileZone = UINT32_MAX;      // ThreadProfiler zone named after the pool
     };
 
     void workerThread(uint32_t threadId);
-    void ioWorkerThread();
+
+    // Highest-priority pool with queued work and a free slot (queue lock held)
+    Pool* pickPoolLocked();
+    uint32_t poolConcurrencyLocked(const Pool& pool) const;
 
     std::vector<std::thread> workers_;
-    std::thread ioWorker_;
 
-    // General task queue (priority queue)
-    std::priority_queue<Task> taskQueue_;
-    std::mutex queueMutex_;
+    // Pools (index = PoolId) and their queues, all under queueMutex_
+    std::vector<std::unique_ptr<Pool>> pools_;
+    PoolId generalPools_[3] = {0, 0, 0};    // Indexed by Priority
+    uint64_t serveCounter_ = 0;
+    mutable std::mutex queueMutex_;
     std::condition_variable queueCondition_;
 
-    // IO-specific task queue (FIFO, pinned to one thread)
-    std::queue<Task> ioQueue_;
-    std::mutex ioMutex_;
-    std::condition_variable ioCondition_;
-
     std::atomic<bool> running_{false};
 
     // Thread-local storage for thread IDs
@@ -141,6 +206,10 @@ public:
         scheduler_.submit(std::move(task), &group_, priority);
     }
 
+    void submit(TaskScheduler::PoolId pool, std::function<void()> task) {
+        scheduler_.submit(pool, std::move(task), &group_);
+    }
+
     void wait() { group_.wait(); }
     bool isComplete() const { return group_.isComplete(); }
 
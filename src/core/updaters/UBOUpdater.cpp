@@ -9,6 +9,7 @@
 #include "ScreenSpaceShadowSystem.h"
 #include "WeatherSystem.h"
 #include "PostProcessSystem.h"
+#include "FroxelSystem.h"
 #include "SceneManager.h"
 #include "controls/EnvironmentControlSubsystem.h"
 #include "Camera.h"
@@ -92,13 +93,22 @@ UBOUpdater::Result UBOUpdater::update(
     LightBuffer lightBuffer{};
     glm::mat4 viewProj = camera.getProjectionMatrix() * camera.getViewMatrix();
 
-    // Build light buffer from ECS with frustum culling
+    // Build light buffer from ECS with frustum (or cluster) culling
     if (config.ecsWorld) {
         ecs::light::updateFlicker(*config.ecsWorld, config.deltaTime);
-        ecs::light::buildLightBuffer(
-            *config.ecsWorld, lightBuffer,
-            camera.getPosition(), camera.getForward(),
-            viewProj, config.lightCullRadius);
+        if (config.lightClusters) {
+            // Clusters follow the froxel slices and reach out to the cull radius
+            config.lightClusters->setDepthRange(systems.froxel().getVolumetricFarPlane(), config.lightCullRadius);
+            ecs::light::buildLightBuffer(
+                *config.ecsWorld, lightBuffer, *config.lightClusters,
+                camera.getPosition(), camera.getForward(),
+                camera.getViewMatrix(), camera.getProjectionMatrix(), config.lightCullRadius);
+        } else {
+            ecs::light::buildLightBuffer(
+                *config.ecsWorld, lightBuffer,
+                camera.getPosition(), camera.getForward(),
+                viewProj, config.lightCullRadius);
+        }
     }
     systems.globalBuffers().updateLightBuffer(frameIndex, lightBuffer);
 
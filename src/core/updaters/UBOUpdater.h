@@ -18,6 +18,7 @@
 
 class Camera;
 class RendererSystems;
+class LightClusterGrid;
 
 namespace ecs {
 class World;
@@ -35,6 +36,7 @@ public:
         float maxSnowHeight = 0.3f;
         float lightCullRadius = 100.0f;
         ecs::World* ecsWorld = nullptr;  // Optional: ECS world for light updates
+        LightClusterGrid* lightClusters = nullptr;  // Optional: clustered light culling
         float deltaTime = 0.016f;         // For flicker animation
     };
 
@@ -51,9 +51,23 @@ bool AsyncTransferManager::initialize(VulkanContext& context) {
         return false;
     }
 
+    // Persistent staging ring; without it every upload falls back to dedicated buffers
+    if (VmaBufferFactory::createStagingBuffer(allocator_, STAGING_RING_SIZE, stagingRingBuffer_)) {
+        VmaAllocationInfo allocInfo;
+        vmaGetAllocationInfo(allocator_, stagingRingBuffer_.getAllocation(), &allocInfo);
+        stagingRingMapped_ = static_cast<uint8_t*>(allocInfo.pMappedData);
+        stagingRing_.reset(STAGING_RING_SIZE);
+    } else {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+            "AsyncTransferManager: Failed to create %llu MB staging ring, using per-transfer staging",
+            static_cast<unsigned long long>(STAGING_RING_SIZE / (1024 * 1024)));
+        stagingRing_.reset(0);
+    }
+
     initialized_ = true;
-    SDL_Log("AsyncTransferManager: Initialized with timeline semaphore (dedicated transfer: %s)",
-            hasDedicatedTransfer_ ? "yes" : "no");
+    SDL_Log("AsyncTransferManager: Initialized with timeline semaphore (dedicated transfer: %s, staging ring: %llu MB)",
+            hasDedicatedTransfer_ ? "yes" : "no",
+            static_cast<unsigned long long>(stagingRing_.capacity() / (1024 * 1024)));
     return true;
 }
 
@@ -64,6 +78,16 @@ void AsyncTransferManager::shutdown() {
 
     waitAll();
 
+    if (totals_.transfers > 0) {
+        SDL_Log("AsyncTransferManager: %u uploads (%.1f MB) in %u submissions, %u ring / %u dedicated, "
+                "%u staging buffers created",
+                totals_.transfers, totals_.stagedBytes / (1024.0 * 1024.0), totals_.submissions,
+                totals_.ringAllocations, totals_.dedicatedAllocations, totals_.stagingBuffersCreated);
+        SDL_Log("AsyncTransferManager: busiest frame %u uploads -> %u submission(s), %u staging allocation(s) "
+                "(one of each per upload before batching)",
+                busiestFrame_.transfers, busiestFrame_.submissions, busiestFrame_.stagingBuffersCreated);
+    }
+
     // Clear staging buffer pool
     {
         std::lock_guard<std::mutex> lock(stagingMutex_);
@@ -74,6 +98,12 @@ void AsyncTransferManager::shutdown() {
     {
         std::lock_guard<std::mutex> lock(transferMutex_);
         pendingTransfers_.clear();
+        submittedBatches_.clear();
+        batchCmd_ = nullptr;
+        batchTimelineValue_ = 0;
+        stagingRing_.reset(0);
+        stagingRingMapped_ = nullptr;
+        stagingRingBuffer_.reset();
     }
 
     transferTimeline_.reset();
@@ -120,6 +150,7 @@ VmaBuffer AsyncTransferManager::acquireStagingBuffer(vk::DeviceSize size) {
             static_cast<unsigned long long>(size));
         return {};
     }
+    frameStats_.stagingBuffersCreated++;
     return buffer;
 }
 
@@ -133,47 +164,58 @@ void AsyncTransferManager::releaseStagingBuffer(VmaBuffer buffer) {
     // Otherwise buffer is destroyed when going out of scope
 }
 
-TransferHandle AsyncTransferManager::submitBufferTransfer(
-    const void* data, vk::DeviceSize size,
-    vk::Buffer dstBuffer, vk::DeviceSize dstOffset,
-    CompletionCallback onComplete)
-{
-    if (!initialized_ || !data || size == 0) {
-        return {};
+bool AsyncTransferManager::stageLocked(const void* data, vk::DeviceSize size, StagingSlice& out) {
+    auto region = stagingRing_.allocate(size, STAGING_RING_ALIGNMENT);
+    if (!region && stagingRing_.fits(size)) {
+        // Reclaim whatever the GPU finished since the last poll before giving up on the ring
+        stagingRing_.retire(transferTimeline_->getCounterValue());
+        region = stagingRing_.allocate(size, STAGING_RING_ALIGNMENT);
+    }
+
+    if (region) {
+        memcpy(stagingRingMapped_ + region->offset, data, size);
+        vmaFlushAllocation(allocator_, stagingRingBuffer_.getAllocation(), region->offset, size);
+        out.buffer = stagingRingBuffer_.get();
+        out.offset = region->offset;
+        return true;
     }
 
-    // Acquire staging buffer and copy data
+    // Too large for the ring, or the ring is full of in-flight uploads
     VmaBuffer staging = acquireStagingBuffer(size);
     if (!staging) {
-        return {};
+        return false;
     }
-
-    // Copy data to staging buffer (VMA buffers are created mapped)
     VmaAllocationInfo allocInfo;
     vmaGetAllocationInfo(allocator_, staging.getAllocation(), &allocInfo);
     memcpy(allocInfo.pMappedData, data, size);
     vmaFlushAllocation(allocator_, staging.getAllocation(), 0, size);
 
-    // Allocate command buffer
-    vk::CommandBuffer cmd = allocateTransferCommandBuffer();
-
-    // Record transfer commands
-    cmd.begin(vk::CommandBufferBeginInfo{}
-        .setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    stagingRing_.recordDedicated(size, stagingRing_.fits(size));
+    out.buffer = staging.get();
+    out.offset = 0;
+    out.dedicated = std::move(staging);
+    return true;
+}
 
-    auto copyRegion = vk::BufferCopy{}
-        .setSrcOffset(0)
-        .setDstOffset(dstOffset)
-        .setSize(size);
-    cmd.copyBuffer(staging.get(), dstBuffer, copyRegion);
+vk::CommandBuffer AsyncTransferManager::batchCommandBufferLocked() {
+    if (!batchCmd_) {
+        batchCmd_ = allocateTransferCommandBuffer();
+        batchCmd_.begin(vk::CommandBufferBeginInfo{}
+            .setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+        batchTimelineValue_ = nextTimelineValue_++;
+    }
+    return batchCmd_;
+}
 
-    cmd.end();
+void AsyncTransferManager::flushLocked() {
+    if (!batchCmd_) {
+        return;
+    }
 
-    // Get next timeline value to signal for this transfer
-    uint64_t timelineValue = nextTimelineValue_++;
+    batchCmd_.end();
 
     // Submit to transfer queue with timeline semaphore signal
-    uint64_t signalValue = timelineValue;
+    uint64_t signalValue = batchTimelineValue_;
     auto timelineInfo = vk::TimelineSemaphoreSubmitInfo{}
         .setSignalSemaphoreValueCount(1)
         .setPSignalSemaphoreValues(&signalValue);
@@ -181,26 +223,65 @@ TransferHandle AsyncTransferManager::submitBufferTransfer(
     vk::Semaphore signalSemaphores[] = {**transferTimeline_};
     auto submitInfo = vk::SubmitInfo{}
         .setPNext(&timelineInfo)
-        .setCommandBuffers(cmd)
+        .setCommandBuffers(batchCmd_)
         .setSignalSemaphores(signalSemaphores);
 
     transferQueue_.submit(submitInfo, nullptr);  // No fence, using timeline semaphore
 
+    stagingRing_.closeBatch(batchTimelineValue_);
+    submittedBatches_.push_back(SubmittedBatch{batchTimelineValue_, batchCmd_});
+    frameStats_.submissions++;
+
+    batchCmd_ = nullptr;
+    batchTimelineValue_ = 0;
+}
+
+void AsyncTransferManager::flush() {
+    if (!initialized_) return;
+
+    std::lock_guard<std::mutex> lock(transferMutex_);
+    flushLocked();
+}
+
+TransferHandle AsyncTransferManager::submitBufferTransfer(
+    const void* data, vk::DeviceSize size,
+    vk::Buffer dstBuffer, vk::DeviceSize dstOffset,
+    CompletionCallback onComplete)
+{
+    if (!initialized_ || !data || size == 0) {
+        return {};
+    }
+
+    std::lock_guard<std::mutex> lock(transferMutex_);
+
+    StagingSlice staging;
+    if (!stageLocked(data, size, staging)) {
+        return {};
+    }
+
+    // Record into this frame's batch
+    vk::CommandBuffer cmd = batchCommandBufferLocked();
+
+    auto copyRegion = vk::BufferCopy{}
+        .setSrcOffset(staging.offset)
+        .setDstOffset(dstOffset)
+        .setSize(size);
+    cmd.copyBuffer(staging.buffer, dstBuffer, copyRegion);
+
+    frameStats_.transfers++;
+    frameStats_.stagedBytes += size;
+
     // Track pending transfer
     uint64_t id = nextTransferId_++;
-    {
-        std::lock_guard<std::mutex> lock(transferMutex_);
-        pendingTransfers_.push_back(PendingTransfer{
-            .id = id,
-            .timelineValue = timelineValue,
-            .cmdBuffer = cmd,
-            .stagingBuffer = std::move(staging),
-            .onComplete = std::move(onComplete),
-            .needsOwnershipTransfer = false,
-            .targetImage = nullptr,
-            .finalLayout = vk::ImageLayout::eUndefined
-        });
-    }
+    pendingTransfers_.push_back(PendingTransfer{
+        .id = id,
+        .timelineValue = batchTimelineValue_,
+        .stagingBuffer = std::move(staging.dedicated),
+        .onComplete = std::move(onComplete),
+        .needsOwnershipTransfer = false,
+        .targetImage = nullptr,
+        .finalLayout = vk::ImageLayout::eUndefined
+    });
 
     return TransferHandle{id};
 }
@@ -217,24 +298,15 @@ TransferHandle AsyncTransferManager::submitImageTransfer(
         return {};
     }
 
-    // Acquire staging buffer and copy data
-    VmaBuffer staging = acquireStagingBuffer(size);
-    if (!staging) {
+    std::lock_guard<std::mutex> lock(transferMutex_);
+
+    StagingSlice staging;
+    if (!stageLocked(data, size, staging)) {
         return {};
     }
 
-    // Copy data to staging buffer
-    VmaAllocationInfo allocInfo;
-    vmaGetAllocationInfo(allocator_, staging.getAllocation(), &allocInfo);
-    memcpy(allocInfo.pMappedData, data, size);
-    vmaFlushAllocation(allocator_, staging.getAllocation(), 0, size);
-
-    // Allocate command buffer
-    vk::CommandBuffer cmd = allocateTransferCommandBuffer();
-
-    // Record transfer commands
-    cmd.begin(vk::CommandBufferBeginInfo{}
-        .setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    // Record into this frame's batch
+    vk::CommandBuffer cmd = batchCommandBufferLocked();
 
     // Transition image to transfer destination layout
     auto barrier = vk::ImageMemoryBarrier{}
@@ -259,7 +331,7 @@ TransferHandle AsyncTransferManager::submitImageTransfer(
 
     // Copy buffer to image
     auto region = vk::BufferImageCopy{}
-        .setBufferOffset(0)
+        .setBufferOffset(staging.offset)
         .setBufferRowLength(0)
         .setBufferImageHeight(0)
         .setImageSubresource(vk::ImageSubresourceLayers{}
@@ -270,7 +342,7 @@ TransferHandle AsyncTransferManager::submitImageTransfer(
         .setImageOffset({0, 0, 0})
         .setImageExtent(extent);
 
-    cmd.copyBufferToImage(staging.get(), dstImage,
+    cmd.copyBufferToImage(staging.buffer, dstImage,
         vk::ImageLayout::eTransferDstOptimal, region);
 
     // Transition to final layout
@@ -324,40 +396,20 @@ TransferHandle AsyncTransferManager::submitImageTransfer(
             {}, {}, {}, finalBarrier);
     }
 
-    cmd.end();
-
-    // Get next timeline value to signal for this transfer
-    uint64_t timelineValue = nextTimelineValue_++;
-
-    // Submit to transfer queue with timeline semaphore signal
-    uint64_t signalValue = timelineValue;
-    auto timelineInfo = vk::TimelineSemaphoreSubmitInfo{}
-        .setSignalSemaphoreValueCount(1)
-        .setPSignalSemaphoreValues(&signalValue);
-
-    vk::Semaphore signalSemaphores[] = {**transferTimeline_};
-    auto submitInfo = vk::SubmitInfo{}
-        .setPNext(&timelineInfo)
-        .setCommandBuffers(cmd)
-        .setSignalSemaphores(signalSemaphores);
-
-    transferQueue_.submit(submitInfo, nullptr);  // No fence, using timeline semaphore
+    frameStats_.transfers++;
+    frameStats_.stagedBytes += size;
 
     // Track pending transfer
     uint64_t id = nextTransferId_++;
-    {
-        std::lock_guard<std::mutex> lock(transferMutex_);
-        pendingTransfers_.push_back(PendingTransfer{
-            .id = id,
-            .timelineValue = timelineValue,
-            .cmdBuffer = cmd,
-            .stagingBuffer = std::move(staging),
-            .onComplete = std::move(onComplete),
-            .needsOwnershipTransfer = needsOwnershipTransfer,
-            .targetImage = dstImage,
-            .finalLayout = finalLayout
-        });
-    }
+    pendingTransfers_.push_back(PendingTransfer{
+        .id = id,
+        .timelineValue = batchTimelineValue_,
+        .stagingBuffer = std::move(staging.dedicated),
+        .onComplete = std::move(onComplete),
+        .needsOwnershipTransfer = needsOwnershipTransfer,
+        .targetImage = dstImage,
+        .finalLayout = finalLayout
+    });
 
     return TransferHandle{id};
 }
@@ -368,7 +420,8 @@ bool AsyncTransferManager::isComplete(TransferHandle handle) const {
     std::lock_guard<std::mutex> lock(transferMutex_);
     for (const auto& transfer : pendingTransfers_) {
         if (transfer.id == handle.id) {
-            // Non-blocking check using timeline semaphore counter
+            // Non-blocking check using timeline semaphore counter. Transfers in
+            // the unsubmitted batch hold a value the counter hasn't reached yet.
             uint64_t currentValue = transferTimeline_->getCounterValue();
             return currentValue >= transfer.timelineValue;
         }
@@ -388,6 +441,10 @@ void AsyncTransferManager::wait(TransferHandle handle) {
                 break;
             }
         }
+        // Still recording: nothing would ever signal it
+        if (waitValue > 0 && waitValue == batchTimelineValue_) {
+            flushLocked();
+        }
     }
 
     if (waitValue > 0) {
@@ -399,12 +456,45 @@ void AsyncTransferManager::wait(TransferHandle handle) {
     }
 
     // Process to clean up this transfer
-    processPendingTransfers();
+    collectCompletedTransfers();
 }
 
 void AsyncTransferManager::processPendingTransfers() {
     if (!initialized_ || !transferTimeline_) return;
 
+    {
+        std::lock_guard<std::mutex> lock(transferMutex_);
+
+        // One submission for everything recorded since the last frame
+        flushLocked();
+
+        // Close the frame's counters
+        StagingRing::FrameStats ringStats = stagingRing_.takeFrameStats();
+        frameStats_.ringAllocations = ringStats.ringAllocations;
+        frameStats_.dedicatedAllocations = ringStats.dedicatedAllocations;
+        if (ringStats.ringFullFallbacks > 0) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "AsyncTransferManager: staging ring full, %u upload(s) fell back to dedicated buffers",
+                ringStats.ringFullFallbacks);
+        }
+
+        totals_.transfers += frameStats_.transfers;
+        totals_.submissions += frameStats_.submissions;
+        totals_.ringAllocations += frameStats_.ringAllocations;
+        totals_.dedicatedAllocations += frameStats_.dedicatedAllocations;
+        totals_.stagingBuffersCreated += frameStats_.stagingBuffersCreated;
+        totals_.stagedBytes += frameStats_.stagedBytes;
+        if (frameStats_.transfers > busiestFrame_.transfers) {
+            busiestFrame_ = frameStats_;
+        }
+        lastFrameStats_ = frameStats_;
+        frameStats_ = {};
+    }
+
+    collectCompletedTransfers();
+}
+
+void AsyncTransferManager::collectCompletedTransfers() {
     std::vector<PendingTransfer> completed;
 
     // Check for completed transfers using timeline semaphore counter (non-blocking)
@@ -414,6 +504,13 @@ void AsyncTransferManager::processPendingTransfers() {
         // Get current timeline value once (non-blocking)
         uint64_t currentValue = transferTimeline_->getCounterValue();
 
+        // Ring regions and command buffers of finished batches can be reused
+        stagingRing_.retire(currentValue);
+        while (!submittedBatches_.empty() && submittedBatches_.front().timelineValue <= currentValue) {
+            freeTransferCommandBuffer(submittedBatches_.front().cmdBuffer);
+            submittedBatches_.pop_front();
+        }
+
         auto it = pendingTransfers_.begin();
         while (it != pendingTransfers_.end()) {
             if (currentValue >= it->timelineValue) {
@@ -427,10 +524,7 @@ void AsyncTransferManager::processPendingTransfers() {
 
     // Process completed transfers
     for (auto& transfer : completed) {
-        // Free command buffer
-        freeTransferCommandBuffer(transfer.cmdBuffer);
-
-        // Return staging buffer to pool
+        // Return dedicated staging buffer to pool
         releaseStagingBuffer(std::move(transfer.stagingBuffer));
 
         // Execute completion callback
@@ -450,9 +544,13 @@ void AsyncTransferManager::waitAll() {
     uint64_t maxValue = 0;
     {
         std::lock_guard<std::mutex> lock(transferMutex_);
+        flushLocked();
         for (const auto& transfer : pendingTransfers_) {
             maxValue = std::max(maxValue, transfer.timelineValue);
         }
+        for (const auto& batch : submittedBatches_) {
+            maxValue = std::max(maxValue, batch.timelineValue);
+        }
     }
 
     // Wait for all pending transfers to complete
@@ -463,10 +561,15 @@ void AsyncTransferManager::waitAll() {
         (void)device_.waitSemaphores(waitInfo, UINT64_MAX);
     }
 
-    processPendingTransfers();
+    collectCompletedTransfers();
 }
 
 size_t AsyncTransferManager::getPendingCount() const {
     std::lock_guard<std::mutex> lock(transferMutex_);
     return pendingTransfers_.size();
 }
+
+AsyncTransferManager::FrameStats AsyncTransferManager::getLastFrameStats() const {
+    std::lock_guard<std::mutex> lock(transferMutex_);
+    return lastFrameStats_;
+}
@@ -3,6 +3,7 @@
 #include <vulkan/vulkan.hpp>
 #include <vulkan/vulkan_raii.hpp>
 #include "VmaBuffer.h"
+#include "StagingRing.h"
 #include <deque>
 #include <functional>
 #include <mutex>
@@ -24,9 +25,10 @@ struct TransferHandle {
  * AsyncTransferManager - Non-blocking GPU transfer system.
  *
  * Implements the async transfer pattern:
- * 1. Copy data to staging buffer
- * 2. Submit transfer command with timeline semaphore signal (non-blocking)
- * 3. Poll timeline counter each frame via processPendingTransfers() (non-blocking)
+ * 1. Copy data into the shared staging ring
+ * 2. Record the copy into the frame's open transfer batch
+ * 3. processPendingTransfers() submits the batch once per frame with a
+ *    timeline semaphore signal (non-blocking) and polls earlier batches
  * 4. When transfer completes, perform queue ownership transfer if needed
  * 5. Execute completion callback
  *
@@ -34,13 +36,29 @@ struct TransferHandle {
  * - Uses dedicated transfer queue when available
  * - Timeline semaphore synchronization (Vulkan 1.2) for efficient non-blocking checks
  * - Single timeline semaphore with monotonic counter vs per-transfer fences
- * - Staging buffer pooling for reduced allocation overhead
+ * - One persistent, mapped staging buffer sub-allocated as a ring; regions
+ *   are reclaimed when their batch's timeline value is reached. Uploads
+ *   too large for the ring, or made while it is full, get a pooled
+ *   dedicated staging buffer instead.
+ * - All uploads recorded in a frame share one command buffer and one submit
  * - Supports both buffer and image transfers
  */
 class AsyncTransferManager {
 public:
     using CompletionCallback = std::function<void()>;
 
+    // Size of the shared staging ring; single uploads above a quarter of this go dedicated
+    static constexpr vk::DeviceSize STAGING_RING_SIZE = 32ull * 1024 * 1024;
+
+    struct FrameStats {
+        uint32_t transfers = 0;              // Uploads recorded
+        uint32_t submissions = 0;            // Queue submits (previously one per upload)
+        uint32_t ringAllocations = 0;        // Uploads staged in the ring
+        uint32_t dedicatedAllocations = 0;   // Uploads that needed their own staging buffer
+        uint32_t stagingBuffersCreated = 0;  // New VMA staging allocations
+        uint64_t stagedBytes = 0;
+    };
+
     AsyncTransferManager() = default;
     ~AsyncTransferManager();
 
@@ -105,12 +123,18 @@ public:
     void wait(TransferHandle handle);
 
     /**
-     * Poll and process completed transfers.
-     * Call once per frame from the main/render thread.
+     * Submit the uploads recorded so far, then poll and process completed
+     * transfers. Call once per frame from the main/render thread.
      * Executes completion callbacks and releases staging resources.
      */
     void processPendingTransfers();
 
+    /**
+     * Submit the open batch now instead of at the next processPendingTransfers().
+     * wait() and waitAll() do this themselves.
+     */
+    void flush();
+
     /**
      * Wait for all pending transfers to complete.
      * Useful before shutdown or when resources must be ready.
@@ -122,25 +146,52 @@ public:
      */
     size_t getPendingCount() const;
 
+    // Counters for the last frame closed by processPendingTransfers()
+    FrameStats getLastFrameStats() const;
+
 private:
     struct PendingTransfer {
         uint64_t id;
         uint64_t timelineValue;  // Timeline semaphore value to wait for
-        vk::CommandBuffer cmdBuffer;  // From transfer pool
-        VmaBuffer stagingBuffer;
+        VmaBuffer stagingBuffer;  // Only set when the upload bypassed the ring
         CompletionCallback onComplete;
         bool needsOwnershipTransfer = false;
         vk::Image targetImage;  // For queue ownership transfer
         vk::ImageLayout finalLayout;
     };
 
+    // A submitted batch; its command buffer is freed once the timeline passes it
+    struct SubmittedBatch {
+        uint64_t timelineValue;
+        vk::CommandBuffer cmdBuffer;
+    };
+
+    // Where one upload's bytes were staged
+    struct StagingSlice {
+        vk::Buffer buffer;
+        vk::DeviceSize offset = 0;
+        VmaBuffer dedicated;
+    };
+
+    // Copy data into the ring, or a dedicated buffer if it can't take it
+    bool stageLocked(const void* data, vk::DeviceSize size, StagingSlice& out);
+
+    // Command buffer of the open batch, starting one if needed
+    vk::CommandBuffer batchCommandBufferLocked();
+
+    // Submit the open batch, if any
+    void flushLocked();
+
+    // Retire ring regions and command buffers, run callbacks of finished transfers
+    void collectCompletedTransfers();
+
     // Allocate command buffer from transfer pool
     vk::CommandBuffer allocateTransferCommandBuffer();
 
     // Free command buffer back to pool
     void freeTransferCommandBuffer(vk::CommandBuffer cmd);
 
-    // Get or create staging buffer of at least the given size
+    // Get or create staging buffer of at least the given size (for uploads the ring can't take)
     VmaBuffer acquireStagingBuffer(vk::DeviceSize size);
 
     // Return staging buffer to pool for reuse
@@ -165,6 +216,23 @@ private:
     std::deque<PendingTransfer> pendingTransfers_;
     mutable std::mutex transferMutex_;
 
+    // Batch being recorded this frame; its timeline value is reserved when it opens
+    vk::CommandBuffer batchCmd_;
+    uint64_t batchTimelineValue_ = 0;
+    std::deque<SubmittedBatch> submittedBatches_;
+
+    // Shared staging ring (guarded by transferMutex_)
+    VmaBuffer stagingRingBuffer_;
+    uint8_t* stagingRingMapped_ = nullptr;
+    StagingRing stagingRing_;
+    static constexpr vk::DeviceSize STAGING_RING_ALIGNMENT = 256;
+
+    // Allocation counters (guarded by transferMutex_)
+    FrameStats frameStats_;
+    FrameStats lastFrameStats_;
+    FrameStats busiestFrame_;
+    FrameStats totals_;
+
     // Transfer ID counter
     uint64_t nextTransferId_ = 1;
 
@@ -0,0 +1,97 @@
+#include "StagingRing.h"
+#include <algorithm>
+
+namespace {
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return alignment > 1 ? (value + alignment - 1) & ~(alignment - 1) : value;
+}
+
+} // namespace
+
+StagingRing::StagingRing(uint64_t capacity, uint64_t maxAllocation) {
+    reset(capacity, maxAllocation);
+}
+
+void StagingRing::reset(uint64_t capacity, uint64_t maxAllocation) {
+    capacity_ = capacity;
+    maxAllocation_ = maxAllocation > 0 ? std::min(maxAllocation, capacity) : capacity / 4;
+    head_ = 0;
+    tail_ = 0;
+    usedBytes_ = 0;
+    openBytes_ = 0;
+    inFlight_.clear();
+    frameStats_ = {};
+}
+
+std::optional<StagingRing::Allocation> StagingRing::allocate(uint64_t size, uint64_t alignment) {
+    if (!fits(size)) {
+        return std::nullopt;
+    }
+
+    // Nothing live: start from the beginning so large requests see the whole buffer
+    if (usedBytes_ == 0) {
+        head_ = 0;
+        tail_ = 0;
+    }
+
+    uint64_t offset = alignUp(head_, alignment);
+    uint64_t consumed = 0;
+
+    if (usedBytes_ == 0 || head_ > tail_) {
+        // Free space is [head, capacity) plus [0, tail)
+        if (offset + size <= capacity_) {
+            consumed = offset + size - head_;
+        } else if (size <= tail_) {
+            offset = 0;
+            consumed = (capacity_ - head_) + size;
+        } else {
+            return std::nullopt;
+        }
+    } else {
+        // Wrapped: free space is [head, tail)
+        if (offset + size > tail_) {
+            return std::nullopt;
+        }
+        consumed = offset + size - head_;
+    }
+
+    head_ = offset + size;
+    usedBytes_ += consumed;
+    openBytes_ += consumed;
+
+    frameStats_.ringAllocations++;
+    frameStats_.ringBytes += size;
+    return Allocation{offset, size};
+}
+
+void StagingRing::recordDedicated(uint64_t size, bool ringWasFull) {
+    frameStats_.dedicatedAllocations++;
+    frameStats_.dedicatedBytes += size;
+    if (ringWasFull) {
+        frameStats_.ringFullFallbacks++;
+    }
+}
+
+void StagingRing::closeBatch(uint64_t fenceValue) {
+    if (openBytes_ == 0) {
+        return;
+    }
+    inFlight_.push_back(Batch{fenceValue, head_, openBytes_});
+    openBytes_ = 0;
+}
+
+void StagingRing::retire(uint64_t completedValue) {
+    while (!inFlight_.empty() && inFlight_.front().fenceValue <= completedValue) {
+        const Batch& batch = inFlight_.front();
+        tail_ = batch.end;
+        usedBytes_ -= batch.bytes;
+        inFlight_.pop_front();
+    }
+}
+
+StagingRing::FrameStats StagingRing::takeFrameStats() {
+    FrameStats stats = frameStats_;
+    frameStats_ = {};
+    return stats;
+}
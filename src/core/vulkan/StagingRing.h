@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+/**
+ * StagingRing - Sub-allocator for one persistent, mapped staging buffer.
+ *
+ * Uploads take aligned regions from the head of the ring. Everything
+ * allocated since the last closeBatch() belongs to the open batch; closing
+ * it tags those regions with the fence value the submission will signal.
+ * retire() frees batches in submission order once their fence value has
+ * been reached, moving the tail forward. A region that doesn't fit at the
+ * end of the buffer wraps to offset 0 and the skipped bytes are freed with
+ * the batch.
+ *
+ * Allocations larger than maxAllocation (or made while the ring is full)
+ * fail; the caller is expected to fall back to a dedicated buffer and
+ * report it through recordDedicated() so the per-frame stats stay honest.
+ *
+ * The fence is just a monotonic counter (a timeline semaphore value in
+ * AsyncTransferManager). No Vulkan dependencies, so it can be tested
+ * with a fake fence clock.
+ *
+ * Not thread safe.
+ */
+class StagingRing {
+public:
+    struct Allocation {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    struct FrameStats {
+        uint32_t ringAllocations = 0;
+        uint32_t dedicatedAllocations = 0;
+        uint32_t ringFullFallbacks = 0;   // Dedicated allocations forced by a full ring
+        uint64_t ringBytes = 0;
+        uint64_t dedicatedBytes = 0;
+    };
+
+    // maxAllocation 0 = a quarter of the capacity
+    explicit StagingRing(uint64_t capacity = 0, uint64_t maxAllocation = 0);
+
+    // Forget every region and resize. Only safe once the GPU is idle.
+    void reset(uint64_t capacity, uint64_t maxAllocation = 0);
+
+    /**
+     * Reserve size bytes at an offset aligned to alignment (a power of two).
+     * Returns nullopt if the request is too large for the ring or there
+     * isn't enough free space until older batches retire.
+     */
+    std::optional<Allocation> allocate(uint64_t size, uint64_t alignment = 16);
+
+    // Count an upload that bypassed the ring
+    void recordDedicated(uint64_t size, bool ringWasFull);
+
+    // Regions allocated since the previous close are freed once fenceValue is reached
+    void closeBatch(uint64_t fenceValue);
+
+    // Free every closed batch whose fence value is <= completedValue
+    void retire(uint64_t completedValue);
+
+    // True if a request of this size could ever be served by the ring
+    bool fits(uint64_t size) const { return size > 0 && size <= maxAllocation_; }
+
+    uint64_t capacity() const { return capacity_; }
+    uint64_t maxAllocation() const { return maxAllocation_; }
+    uint64_t usedBytes() const { return usedBytes_; }
+    size_t inFlightBatches() const { return inFlight_.size(); }
+    bool hasOpenBatch() const { return openBytes_ > 0; }
+
+    const FrameStats& getFrameStats() const { return frameStats_; }
+
+    // Return this frame's stats and start counting the next frame
+    FrameStats takeFrameStats();
+
+private:
+    struct Batch {
+        uint64_t fenceValue;
+        uint64_t end;        // Head position when the batch was closed
+        uint64_t bytes;      // Bytes consumed, including alignment padding and wrap waste
+    };
+
+    uint64_t capacity_ = 0;
+    uint64_t maxAllocation_ = 0;
+    uint64_t head_ = 0;      // Next free byte
+    uint64_t tail_ = 0;      // Oldest byte still in use
+    uint64_t usedBytes_ = 0;
+    uint64_t openBytes_ = 0;
+    std::deque<Batch> inFlight_;
+    FrameStats frameStats_;
+};
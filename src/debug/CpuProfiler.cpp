@@ -3,33 +3,25 @@
 #include <algorithm>
 #include <cstring>
 
-// Helper to check if a zone name represents a wait/sync operation
-static bool isWaitZoneName(const std::string& name) {
-    // Zones prefixed with "Wait:" are explicitly marked as wait zones
-    if (name.rfind("Wait:", 0) == 0) return true;
-    // Legacy zone names that represent waiting
-    if (name == "FenceWait" || name == "AcquireImage") return true;
-    return false;
-}
-
 void CpuProfiler::beginFrame() {
     if (!enabled) return;
 
-    frameStartTime = Clock::now();
-    activeZones.clear();
-    currentFrameZoneOrder.clear();
-
-    // Start flamegraph capture for this frame
-    if (flamegraphEnabled) {
-        flamegraphBuilder.beginFrame();
-    }
+    frameStartNs = ThreadProfiler::nowNs();
+    mainLane = ThreadProfiler::instance().currentLane();
+    frameActive = true;
 }
 
 void CpuProfiler::endFrame() {
-    if (!enabled) return;
+    if (!enabled || !frameActive) return;
+    frameActive = false;
 
-    auto frameEndTime = Clock::now();
-    float frameTimeMs = std::chrono::duration<float, std::milli>(frameEndTime - frameStartTime).count();
+    uint64_t frameEndNs = ThreadProfiler::nowNs();
+    float frameTimeMs = static_cast<float>(frameEndNs - frameStartNs) / 1e6f;
+
+    // Merge every thread's ring into this frame
+    ThreadProfiler& threads = ThreadProfiler::instance();
+    collector.collect(threads, mainLane, frameStartNs, frameEndNs, flamegraphEnabled, frameResult);
+    droppedEvents = frameResult.droppedEvents;
 
     // Build results for this frame
     lastFrameStats.totalCpuTimeMs = frameTimeMs;
@@ -39,25 +31,22 @@ void CpuProfiler::endFrame() {
     float totalWorkMs = 0.0f;
     float totalWaitMs = 0.0f;
 
-    for (const auto& zoneName : currentFrameZoneOrder) {
-        auto it = activeZones.find(zoneName);
-        if (it != activeZones.end()) {
-            TimingResult result;
-            result.name = zoneName;
-            result.cpuTimeMs = it->second.accumulatedMs;
-            result.percentOfFrame = (frameTimeMs > 0.0f) ? (result.cpuTimeMs / frameTimeMs * 100.0f) : 0.0f;
-            result.isWaitZone = isWaitZoneName(zoneName);
-
-            // Accumulate work vs wait time
-            if (result.isWaitZone) {
-                totalWaitMs += result.cpuTimeMs;
-            } else {
-                totalWorkMs += result.cpuTimeMs;
-            }
-
-            lastFrameStats.zones.push_back(result);
-            zoneNames.push_back(zoneName);
+    for (const auto& total : frameResult.mainTotals) {
+        TimingResult result;
+        result.name = threads.zoneName(total.zone);
+        result.cpuTimeMs = total.ms;
+        result.percentOfFrame = (frameTimeMs > 0.0f) ? (result.cpuTimeMs / frameTimeMs * 100.0f) : 0.0f;
+        result.isWaitZone = isWaitZoneName(result.name);
+
+        // Accumulate work vs wait time
+        if (result.isWaitZone) {
+            totalWaitMs += result.cpuTimeMs;
+        } else {
+            totalWorkMs += result.cpuTimeMs;
         }
+
+        zoneNames.push_back(result.name);
+        lastFrameStats.zones.push_back(std::move(result));
     }
 
     // Calculate breakdown
@@ -110,53 +99,10 @@ void CpuProfiler::endFrame() {
     }
 
     // Finalize flamegraph capture
-    if (flamegraphEnabled && flamegraphBuilder.isActive()) {
-        lastFlamegraph = flamegraphBuilder.endFrame(frameTimeMs, frameNumber);
+    if (flamegraphEnabled) {
+        lastFlamegraph = std::move(frameResult.capture);
+        lastFlamegraph.totalTimeMs = frameTimeMs;
+        lastFlamegraph.frameNumber = frameNumber;
     }
     frameNumber++;
 }
-
-void CpuProfiler::beginZone(const char* zoneName) {
-    if (!enabled) return;
-
-    auto now = Clock::now();
-    auto it = activeZones.find(zoneName);
-    if (it == activeZones.end()) {
-        // New zone for this frame
-        ZoneData data;
-        data.startTime = now;
-        data.accumulatedMs = 0.0f;
-        activeZones[zoneName] = data;
-        currentFrameZoneOrder.push_back(zoneName);
-    } else {
-        // Zone already exists (nested or repeated call)
-        it->second.startTime = now;
-    }
-
-    // Track in flamegraph builder
-    if (flamegraphEnabled && flamegraphBuilder.isActive()) {
-        float timestampMs = std::chrono::duration<float, std::milli>(now - frameStartTime).count();
-        flamegraphBuilder.beginZone(zoneName, timestampMs, isWaitZoneName(zoneName));
-    }
-}
-
-void CpuProfiler::endZone(const char* zoneName) {
-    if (!enabled) return;
-
-    auto endTime = Clock::now();
-
-    auto it = activeZones.find(zoneName);
-    if (it == activeZones.end()) {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "CPU Profiler: endZone called without beginZone for '%s'", zoneName);
-        return;
-    }
-
-    float elapsedMs = std::chrono::duration<float, std::milli>(endTime - it->second.startTime).count();
-    it->second.accumulatedMs += elapsedMs;
-
-    // Track in flamegraph builder
-    if (flamegraphEnabled && flamegraphBuilder.isActive()) {
-        float timestampMs = std::chrono::duration<float, std::milli>(endTime - frameStartTime).count();
-        flamegraphBuilder.endZone(zoneName, timestampMs);
-    }
-}
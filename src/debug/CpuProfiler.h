@@ -3,8 +3,8 @@
 #include <chrono>
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include "Flamegraph.h"
+#include "ThreadProfiler.h"
 
 /**
  * CPU Profiler for measuring CPU-side frame time breakdown.
@@ -16,6 +16,12 @@
  * (time where CPU is idle waiting for GPU). This helps diagnose performance
  * bottlenecks and identify CPU vs GPU bound scenarios.
  *
+ * Zones are recorded through ThreadProfiler's per-thread rings, so
+ * beginZone/endZone are cheap and may be called from any thread. Zones of
+ * the thread that calls beginFrame() make up the frame stats and the
+ * flamegraph roots; every other thread's zones appear as flamegraph lanes.
+ * Zone names must be string literals (they are interned by pointer).
+ *
  * Usage:
  *   profiler.beginFrame();
  *   {
@@ -70,7 +76,7 @@ public:
         const char* name;
     };
 
-    CpuProfiler() = default;
+    CpuProfiler() { ThreadProfiler::setEnabled(enabled); }
     ~CpuProfiler() = default;
 
     /**
@@ -84,14 +90,18 @@ public:
     void endFrame();
 
     /**
-     * Begin a named profiling zone.
+     * Begin a named profiling zone (any thread).
      */
-    void beginZone(const char* zoneName);
+    void beginZone(const char* zoneName) {
+        if (enabled) ThreadProfiler::instance().beginZone(zoneName);
+    }
 
     /**
-     * End a named profiling zone.
+     * End a named profiling zone (any thread).
      */
-    void endZone(const char* zoneName);
+    void endZone(const char* zoneName) {
+        if (enabled) ThreadProfiler::instance().endZone(zoneName);
+    }
 
     /**
      * Get profiling results from the last completed frame.
@@ -102,7 +112,10 @@ public:
      * Check if profiling is enabled.
      */
     bool isEnabled() const { return enabled; }
-    void setEnabled(bool e) { enabled = e; }
+    void setEnabled(bool e) {
+        enabled = e;
+        ThreadProfiler::setEnabled(e);
+    }
 
     /**
      * Get the list of zone names (for GUI display).
@@ -126,21 +139,26 @@ public:
     void setFlamegraphEnabled(bool e) { flamegraphEnabled = e; }
     bool isFlamegraphEnabled() const { return flamegraphEnabled; }
 
-private:
-    using Clock = std::chrono::high_resolution_clock;
-    using TimePoint = Clock::time_point;
+    /**
+     * Start of the current (or last completed) frame, ThreadProfiler::nowNs() time base.
+     */
+    uint64_t getFrameStartNs() const { return frameStartNs; }
 
-    struct ZoneData {
-        TimePoint startTime;
-        float accumulatedMs = 0.0f;
-    };
+    /**
+     * Events lost to full per-thread rings in the last frame.
+     */
+    uint64_t getDroppedEvents() const { return droppedEvents; }
 
+private:
     bool enabled = true;
 
     // Current frame state
-    TimePoint frameStartTime;
-    std::unordered_map<std::string, ZoneData> activeZones;
-    std::vector<std::string> currentFrameZoneOrder;
+    uint64_t frameStartNs = 0;
+    uint32_t mainLane = 0;
+    bool frameActive = false;
+    ThreadProfileCollector collector;
+    ThreadProfileCollector::FrameResult frameResult;
+    uint64_t droppedEvents = 0;
 
     // Results
     FrameStats lastFrameStats;
@@ -152,7 +170,6 @@ private:
 
     // Flamegraph capture
     bool flamegraphEnabled = true;
-    FlamegraphBuilder flamegraphBuilder;
     FlamegraphCapture lastFlamegraph;
     uint64_t frameNumber = 0;
 };
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <stack>
+#include <tuple>
 
 /**
  * Data structures for flamegraph visualization of profiling data.
@@ -55,6 +56,16 @@ struct FlamegraphNode {
     }
 };
 
+/**
+ * Zones recorded on another thread during the same frame, on the same
+ * time base as the capture's roots.
+ */
+struct FlamegraphLane {
+    std::string threadName;
+    uint32_t lane = 0;
+    std::vector<FlamegraphNode> roots;
+};
+
 /**
  * A complete flamegraph capture for one frame.
  */
@@ -62,6 +73,7 @@ struct FlamegraphCapture {
     float totalTimeMs = 0.0f;
     uint64_t frameNumber = 0;
     std::vector<FlamegraphNode> roots;  // Top-level zones
+    std::vector<FlamegraphLane> lanes;  // Other threads (CPU captures only)
 
     bool isEmpty() const { return roots.empty(); }
 
@@ -77,6 +89,28 @@ struct FlamegraphCapture {
     }
 };
 
+/**
+ * Zones prefixed with "Wait:" (and a few legacy names) are time spent
+ * waiting on the GPU or other sync rather than doing work.
+ */
+inline bool isWaitZoneName(const std::string& name) {
+    if (name.rfind("Wait:", 0) == 0) return true;
+    return name == "FenceWait" || name == "AcquireImage";
+}
+
+inline FlamegraphColorHint flamegraphColorHint(const std::string& name, bool isWaitZone) {
+    if (isWaitZone) return FlamegraphColorHint::Wait;
+
+    if (name.find("Shadow") != std::string::npos) return FlamegraphColorHint::Shadow;
+    if (name.find("Water") != std::string::npos) return FlamegraphColorHint::Water;
+    if (name.find("Terrain") != std::string::npos) return FlamegraphColorHint::Terrain;
+    if (name.find("Post") != std::string::npos ||
+        name.find("Bloom") != std::string::npos ||
+        name.find("Tone") != std::string::npos) return FlamegraphColorHint::PostProcess;
+
+    return FlamegraphColorHint::Default;
+}
+
 /**
  * Helper class to build a flamegraph capture from profiling events.
  * Tracks zone hierarchy during a frame and produces a FlamegraphCapture.
@@ -138,17 +172,7 @@ public:
 
 private:
     static FlamegraphColorHint getColorHint(const char* name, bool isWaitZone) {
-        if (isWaitZone) return FlamegraphColorHint::Wait;
-
-        std::string n(name);
-        if (n.find("Shadow") != std::string::npos) return FlamegraphColorHint::Shadow;
-        if (n.find("Water") != std::string::npos) return FlamegraphColorHint::Water;
-        if (n.find("Terrain") != std::string::npos) return FlamegraphColorHint::Terrain;
-        if (n.find("Post") != std::string::npos ||
-            n.find("Bloom") != std::string::npos ||
-            n.find("Tone") != std::string::npos) return FlamegraphColorHint::PostProcess;
-
-        return FlamegraphColorHint::Default;
+        return flamegraphColorHint(name, isWaitZone);
     }
 
     FlamegraphCapture capture_;
@@ -208,6 +232,50 @@ inline FlamegraphCapture buildInitFlamegraph(
     return capture;
 }
 
+/**
+ * Format a capture as folded stacks ("root;child;leaf <count>" per line),
+ * the input format of flamegraph.pl and speedscope. Counts are each
+ * node's self time in microseconds; rootPrefix, if set, becomes an extra
+ * bottom frame so several captures can share one file.
+ */
+inline std::string formatFoldedStacks(const FlamegraphCapture& capture, const std::string& rootPrefix = "") {
+    std::string out;
+
+    struct Frame {
+        const FlamegraphNode* node;
+        std::string stack;
+    };
+    std::vector<Frame> pending;
+    for (auto it = capture.roots.rbegin(); it != capture.roots.rend(); ++it) {
+        pending.push_back({&*it, rootPrefix});
+    }
+
+    while (!pending.empty()) {
+        Frame frame = std::move(pending.back());
+        pending.pop_back();
+
+        // ';' separates frames and the last space separates the count
+        std::string name = frame.node->name;
+        std::replace(name.begin(), name.end(), ';', ':');
+        std::string stack = frame.stack.empty() ? name : frame.stack + ";" + name;
+
+        float childMs = 0.0f;
+        for (const auto& child : frame.node->children) {
+            childMs += child.durationMs;
+        }
+        long long selfUs = static_cast<long long>((frame.node->durationMs - childMs) * 1000.0f + 0.5f);
+        if (selfUs > 0) {
+            out += stack + " " + std::to_string(selfUs) + "\n";
+        }
+
+        for (auto it = frame.node->children.rbegin(); it != frame.node->children.rend(); ++it) {
+            pending.push_back({&*it, stack});
+        }
+    }
+
+    return out;
+}
+
 /**
  * Ring buffer for storing flamegraph capture history.
  */
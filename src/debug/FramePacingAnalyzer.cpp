@@ -0,0 +1,365 @@
+#include "FramePacingAnalyzer.h"
+#include "Flamegraph.h"
+#include <SDL3/SDL_log.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr uint32_t LOG_FLUSH_INTERVAL = 60;
+
+const char* const CSV_HEADER =
+    "frame,frame_ms,cpu_busy_ms,gpu_ms,fence_wait_ms,fence_signaled,acquire_ms,submit_ms,present_ms,"
+    "streaming_ms,bottleneck,hitch,root_cause\n";
+
+// Nearest-rank percentile of sorted values
+float percentile(const std::vector<float>& sorted, float p) {
+    if (sorted.empty()) return 0.0f;
+    size_t rank = static_cast<size_t>(std::ceil(p * static_cast<float>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+// Running average with zones that didn't run this frame decaying towards 0
+void updateZoneAverages(std::unordered_map<std::string, float>& averages,
+                        const std::vector<FramePacingAnalyzer::Zone>& zones, float rate) {
+    for (auto& [name, average] : averages) {
+        average *= 1.0f - rate;
+    }
+    for (const auto& zone : zones) {
+        auto [it, inserted] = averages.try_emplace(zone.name, zone.ms);
+        if (!inserted) it->second += rate * zone.ms;
+    }
+}
+
+} // namespace
+
+const char* FramePacingAnalyzer::bottleneckName(Bottleneck bottleneck) {
+    switch (bottleneck) {
+        case Bottleneck::CpuBound: return "cpu";
+        case Bottleneck::GpuBound: return "gpu";
+        case Bottleneck::StreamingStall: return "streaming";
+        case Bottleneck::PresentBound: return "present";
+    }
+    return "unknown";
+}
+
+FramePacingAnalyzer::FramePacingAnalyzer(Config config)
+    : config_(std::move(config)) {
+    config_.windowFrames = std::max<size_t>(1, config_.windowFrames);
+    config_.hitchBaselineFrames = std::max<size_t>(1, config_.hitchBaselineFrames);
+}
+
+bool FramePacingAnalyzer::isStreamingZone(const std::string& name) const {
+    for (const auto& prefix : config_.streamingZonePrefixes) {
+        if (name.rfind(prefix, 0) == 0) return true;
+    }
+    return false;
+}
+
+void FramePacingAnalyzer::classify(const FrameTimeline& frame, FrameReport& report) const {
+    float streamingMs = 0.0f;
+    float otherWaitMs = 0.0f;
+    for (const auto& zone : frame.cpuZones) {
+        if (isStreamingZone(zone.name)) {
+            streamingMs += zone.ms;
+        } else if (isWaitZoneName(zone.name)) {
+            otherWaitMs += zone.ms;
+        }
+    }
+
+    const float frameMs = frame.frameTimeMs;
+    const float syncMs = frame.acquireMs + frame.presentMs;
+    report.streamingMs = streamingMs;
+    report.cpuBusyMs = std::max(0.0f, frameMs - frame.fenceWaitMs - syncMs - streamingMs - otherWaitMs);
+
+    if (frameMs <= 0.0f) {
+        report.bottleneck = Bottleneck::CpuBound;
+    } else if (streamingMs >= config_.streamingStallFraction * frameMs) {
+        report.bottleneck = Bottleneck::StreamingStall;
+    } else if (!frame.fenceAlreadySignaled && frame.fenceWaitMs >= config_.fenceWaitFraction * frameMs) {
+        report.bottleneck = Bottleneck::GpuBound;
+    } else if (syncMs >= config_.presentFraction * frameMs &&
+               std::max(report.cpuBusyMs, frame.gpuTimeMs) < (1.0f - config_.presentFraction) * frameMs) {
+        report.bottleneck = Bottleneck::PresentBound;
+    } else {
+        report.bottleneck = frame.gpuTimeMs > report.cpuBusyMs ? Bottleneck::GpuBound : Bottleneck::CpuBound;
+    }
+}
+
+bool FramePacingAnalyzer::isHitch(float frameTimeMs) const {
+    if (reports_.size() < std::max<size_t>(1, config_.hitchWarmupFrames)) return false;
+
+    size_t count = std::min(config_.hitchBaselineFrames, reports_.size());
+    scratch_.clear();
+    for (auto it = reports_.end() - static_cast<std::ptrdiff_t>(count); it != reports_.end(); ++it) {
+        scratch_.push_back(it->frameTimeMs);
+    }
+    auto middle = scratch_.begin() + static_cast<std::ptrdiff_t>(scratch_.size() / 2);
+    std::nth_element(scratch_.begin(), middle, scratch_.end());
+    float median = *middle;
+
+    return frameTimeMs > median * config_.hitchFactor && frameTimeMs - median >= config_.hitchMinMs;
+}
+
+void FramePacingAnalyzer::findRootCause(const FrameTimeline& frame, FrameReport& report) const {
+    const char* prefix = nullptr;
+    const std::string* zoneName = nullptr;
+    const char* syncName = "Untracked";
+    float best = 0.0f;
+
+    auto consider = [&](const char* zonePrefix, const std::string& name,
+                        const std::unordered_map<std::string, float>& averages, float ms) {
+        auto it = averages.find(name);
+        float excess = ms - (it != averages.end() ? it->second : 0.0f);
+        if (excess > best) {
+            best = excess;
+            prefix = zonePrefix;
+            zoneName = &name;
+        }
+    };
+    for (const auto& zone : frame.cpuZones) consider("CPU:", zone.name, cpuZoneAverages_, zone.ms);
+    for (const auto& zone : frame.gpuZones) consider("GPU:", zone.name, gpuZoneAverages_, zone.ms);
+
+    auto considerSync = [&](const char* name, float ms, float average) {
+        if (ms - average > best) {
+            best = ms - average;
+            prefix = nullptr;
+            zoneName = nullptr;
+            syncName = name;
+        }
+    };
+    considerSync("Fence wait", frame.fenceWaitMs, fenceWaitAverage_);
+    considerSync("Acquire", frame.acquireMs, acquireAverage_);
+    considerSync("Present", frame.presentMs, presentAverage_);
+
+    report.rootCause = zoneName ? std::string(prefix) + *zoneName : std::string(syncName);
+    report.rootCauseExcessMs = best;
+}
+
+void FramePacingAnalyzer::updateAverages(const FrameTimeline& frame) {
+    float rate = averagesValid_ ? config_.zoneAverageRate : 1.0f;
+    updateZoneAverages(cpuZoneAverages_, frame.cpuZones, rate);
+    updateZoneAverages(gpuZoneAverages_, frame.gpuZones, rate);
+    fenceWaitAverage_ += rate * (frame.fenceWaitMs - fenceWaitAverage_);
+    acquireAverage_ += rate * (frame.acquireMs - acquireAverage_);
+    presentAverage_ += rate * (frame.presentMs - presentAverage_);
+    averagesValid_ = true;
+}
+
+const FramePacingAnalyzer::FrameReport& FramePacingAnalyzer::addFrame(const FrameTimeline& frame) {
+    FrameReport report;
+    report.frameNumber = frame.frameNumber;
+    report.frameTimeMs = frame.frameTimeMs;
+    classify(frame, report);
+
+    report.hitch = isHitch(frame.frameTimeMs);
+    if (report.hitch) {
+        findRootCause(frame, report);
+        hitches_.push_back(report);
+        if (hitches_.size() > MAX_HITCHES) hitches_.pop_front();
+    } else {
+        // Hitches stay out of the averages so the next one is measured against normal frames
+        updateAverages(frame);
+    }
+
+    reports_.push_back(report);
+    if (reports_.size() > config_.windowFrames) reports_.pop_front();
+
+    if (log_.is_open()) writeLogRow(frame, report);
+
+    lastReport_ = std::move(report);
+    return lastReport_;
+}
+
+FramePacingAnalyzer::Summary FramePacingAnalyzer::getSummary() const {
+    Summary summary;
+    summary.frames = reports_.size();
+    if (reports_.empty()) return summary;
+
+    scratch_.clear();
+    double total = 0.0;
+    for (const auto& report : reports_) {
+        scratch_.push_back(report.frameTimeMs);
+        total += report.frameTimeMs;
+        if (report.hitch) summary.hitches++;
+        summary.bottleneckFrames[static_cast<size_t>(report.bottleneck)]++;
+    }
+    std::sort(scratch_.begin(), scratch_.end());
+
+    summary.averageMs = static_cast<float>(total / static_cast<double>(reports_.size()));
+    summary.p50Ms = percentile(scratch_, 0.50f);
+    summary.p95Ms = percentile(scratch_, 0.95f);
+    summary.p99Ms = percentile(scratch_, 0.99f);
+    summary.maxMs = scratch_.back();
+    return summary;
+}
+
+void FramePacingAnalyzer::reset() {
+    lastReport_ = FrameReport{};
+    reports_.clear();
+    hitches_.clear();
+    cpuZoneAverages_.clear();
+    gpuZoneAverages_.clear();
+    fenceWaitAverage_ = 0.0f;
+    acquireAverage_ = 0.0f;
+    presentAverage_ = 0.0f;
+    averagesValid_ = false;
+}
+
+std::string FramePacingAnalyzer::rotatedLogPath(const std::string& path, uint32_t index) {
+    if (index == 0) return path;
+    std::filesystem::path p(path);
+    std::string name = p.stem().string() + "." + std::to_string(index) + p.extension().string();
+    return p.replace_filename(name).string();
+}
+
+bool FramePacingAnalyzer::startLog(const std::string& path, LogFormat format, uint32_t framesPerFile,
+                                   uint32_t keepFiles) {
+    stopLog();
+    logPath_ = path;
+    logFormat_ = format;
+    logFramesPerFile_ = std::max(1u, framesPerFile);
+    logKeepFiles_ = std::max(1u, keepFiles);
+
+    std::error_code ec;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+    if (!openLogFile()) return false;
+
+    SDL_Log("Frame pacing: logging to %s (%u frames per file, %u files kept)", path.c_str(),
+            logFramesPerFile_, logKeepFiles_);
+    return true;
+}
+
+void FramePacingAnalyzer::stopLog() {
+    if (!log_.is_open()) return;
+    log_.close();
+    SDL_Log("Frame pacing: log %s closed", logPath_.c_str());
+}
+
+bool FramePacingAnalyzer::openLogFile() {
+    log_.open(logPath_, std::ios::trunc);
+    if (!log_) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "FramePacingAnalyzer: can't write '%s'", logPath_.c_str());
+        log_.close();
+        return false;
+    }
+    if (logFormat_ == LogFormat::Csv) log_ << CSV_HEADER;
+    logFramesInFile_ = 0;
+    return true;
+}
+
+void FramePacingAnalyzer::rotateLog() {
+    log_.close();
+
+    // Shift name.1 -> name.2 ... and drop the oldest
+    std::error_code ec;
+    if (logKeepFiles_ > 1) {
+        std::filesystem::remove(rotatedLogPath(logPath_, logKeepFiles_ - 1), ec);
+        for (uint32_t i = logKeepFiles_ - 1; i > 1; --i) {
+            std::filesystem::rename(rotatedLogPath(logPath_, i - 1), rotatedLogPath(logPath_, i), ec);
+        }
+        std::filesystem::rename(logPath_, rotatedLogPath(logPath_, 1), ec);
+    }
+    openLogFile();
+}
+
+void FramePacingAnalyzer::writeLogRow(const FrameTimeline& frame, const FrameReport& report) {
+    if (logFramesInFile_ >= logFramesPerFile_) {
+        rotateLog();
+        if (!log_.is_open()) return;
+    }
+
+    if (logFormat_ == LogFormat::Csv) {
+        char row[256];
+        std::snprintf(row, sizeof(row), "%llu,%.3f,%.3f,%.3f,%.3f,%d,%.3f,%.3f,%.3f,%.3f,%s,%d,",
+                      static_cast<unsigned long long>(report.frameNumber), report.frameTimeMs, report.cpuBusyMs,
+                      frame.gpuTimeMs, frame.fenceWaitMs, frame.fenceAlreadySignaled ? 1 : 0, frame.acquireMs,
+                      frame.submitMs, frame.presentMs, report.streamingMs, bottleneckName(report.bottleneck),
+                      report.hitch ? 1 : 0);
+        log_ << row;
+        if (!report.rootCause.empty()) {
+            // Quoted: zone names may contain commas
+            log_ << '"';
+            for (char c : report.rootCause) {
+                if (c == '"') log_ << '"';
+                log_ << c;
+            }
+            log_ << '"';
+        }
+        log_ << '\n';
+    } else {
+        json row = {
+            {"frame", report.frameNumber},
+            {"frame_ms", report.frameTimeMs},
+            {"cpu_busy_ms", report.cpuBusyMs},
+            {"gpu_ms", frame.gpuTimeMs},
+            {"fence_wait_ms", frame.fenceWaitMs},
+            {"fence_signaled", frame.fenceAlreadySignaled},
+            {"acquire_ms", frame.acquireMs},
+            {"submit_ms", frame.submitMs},
+            {"present_ms", frame.presentMs},
+            {"streaming_ms", report.streamingMs},
+            {"bottleneck", bottleneckName(report.bottleneck)},
+            {"hitch", report.hitch},
+        };
+        if (report.hitch) {
+            row["root_cause"] = report.rootCause;
+            row["root_cause_excess_ms"] = report.rootCauseExcessMs;
+        }
+        log_ << row.dump() << '\n';
+    }
+
+    if (++logFramesInFile_ % LOG_FLUSH_INTERVAL == 0) log_.flush();
+}
+
+std::string FramePacingAnalyzer::summaryJson() const {
+    Summary summary = getSummary();
+    json bottlenecks = json::object();
+    for (size_t i = 0; i < BOTTLENECK_COUNT; ++i) {
+        bottlenecks[bottleneckName(static_cast<Bottleneck>(i))] = summary.bottleneckFrames[i];
+    }
+    json hitches = json::array();
+    for (const auto& hitch : hitches_) {
+        hitches.push_back({{"frame", hitch.frameNumber},
+                           {"frame_ms", hitch.frameTimeMs},
+                           {"bottleneck", bottleneckName(hitch.bottleneck)},
+                           {"root_cause", hitch.rootCause},
+                           {"root_cause_excess_ms", hitch.rootCauseExcessMs}});
+    }
+    json root = {
+        {"frames", summary.frames},
+        {"average_ms", summary.averageMs},
+        {"p50_ms", summary.p50Ms},
+        {"p95_ms", summary.p95Ms},
+        {"p99_ms", summary.p99Ms},
+        {"max_ms", summary.maxMs},
+        {"hitches", summary.hitches},
+        {"bottlenecks", std::move(bottlenecks)},
+        {"recent_hitches", std::move(hitches)},
+    };
+    return root.dump(2);
+}
+
+bool FramePacingAnalyzer::writeSummaryJson(const std::string& path) const {
+    std::error_code ec;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "FramePacingAnalyzer: can't write '%s'", path.c_str());
+        return false;
+    }
+    file << summaryJson();
+    return static_cast<bool>(file);
+}
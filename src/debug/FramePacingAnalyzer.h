@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * FramePacingAnalyzer - Per-frame bottleneck classification, frame-time
+ * percentiles and hitch root causes
+ *
+ * Fed one FrameTimeline per frame (Profiler builds it from the CPU zones,
+ * the GPU timestamps and QueueSubmitDiagnostics; tests build them by hand
+ * or replay a recorded run), it decides what each frame was waiting on:
+ * - StreamingStall: the frame thread sat in streaming zones (uploads, IO waits)
+ * - GpuBound: the CPU blocked on the frame fence, or the GPU took longer
+ *   than the CPU's own work
+ * - PresentBound: acquire/present ate the frame while CPU and GPU both had
+ *   headroom (vsync or compositor pacing)
+ * - CpuBound: everything else
+ *
+ * A frame is a hitch when it takes hitchFactor times the median of the
+ * frames before it (and at least hitchMinMs more). Its root cause is the
+ * CPU zone, GPU zone or sync step that grew the most over its running
+ * average.
+ *
+ * For soak runs a rolling log writes one CSV row or JSON line per frame,
+ * starting a new file every framesPerFile frames and keeping the newest
+ * keepFiles of them.
+ */
+class FramePacingAnalyzer {
+public:
+    enum class Bottleneck : uint8_t {
+        CpuBound,
+        GpuBound,
+        StreamingStall,
+        PresentBound
+    };
+    static constexpr size_t BOTTLENECK_COUNT = 4;
+    static const char* bottleneckName(Bottleneck bottleneck);
+
+    struct Zone {
+        std::string name;
+        float ms = 0.0f;
+    };
+
+    // One frame as the profilers saw it (all times in ms)
+    struct FrameTimeline {
+        uint64_t frameNumber = 0;
+        float frameTimeMs = 0.0f;           // CPU frame, begin to end
+        std::vector<Zone> cpuZones;         // Frame thread; "Wait:" zones are blocking
+        float fenceWaitMs = 0.0f;           // Waiting for this slot's previous frame
+        bool fenceAlreadySignaled = true;
+        float acquireMs = 0.0f;
+        float submitMs = 0.0f;
+        float presentMs = 0.0f;
+        float gpuTimeMs = 0.0f;             // 0 when GPU timestamps are unavailable
+        std::vector<Zone> gpuZones;
+    };
+
+    struct FrameReport {
+        uint64_t frameNumber = 0;
+        float frameTimeMs = 0.0f;
+        Bottleneck bottleneck = Bottleneck::CpuBound;
+        float cpuBusyMs = 0.0f;             // Frame time minus every blocking step
+        float streamingMs = 0.0f;
+        bool hitch = false;
+        std::string rootCause;              // Hitches: "CPU:<zone>", "GPU:<zone>", "Fence wait", "Acquire", "Present"
+        float rootCauseExcessMs = 0.0f;     // How far above its running average
+    };
+
+    // Over the frames currently in the window
+    struct Summary {
+        size_t frames = 0;
+        float averageMs = 0.0f;
+        float p50Ms = 0.0f;
+        float p95Ms = 0.0f;
+        float p99Ms = 0.0f;
+        float maxMs = 0.0f;
+        size_t hitches = 0;
+        size_t bottleneckFrames[BOTTLENECK_COUNT] = {};
+    };
+
+    struct Config {
+        size_t windowFrames = 1000;             // Percentiles and bottleneck counts
+        size_t hitchBaselineFrames = 120;       // Median a hitch is measured against
+        size_t hitchWarmupFrames = 30;          // No hitches before this many frames
+        float hitchFactor = 2.0f;
+        float hitchMinMs = 4.0f;
+        float streamingStallFraction = 0.15f;   // Of the frame, to call it a streaming stall
+        float fenceWaitFraction = 0.1f;         // Of the frame, to call it GPU-bound outright
+        float presentFraction = 0.25f;          // Of the frame, for acquire + present
+        float zoneAverageRate = 0.1f;           // Running zone averages (root causes)
+        std::vector<std::string> streamingZonePrefixes = {"Streaming:", "Wait:Streaming", "Wait:Upload", "Wait:IO"};
+    };
+
+    enum class LogFormat {
+        Csv,
+        JsonLines
+    };
+
+    static constexpr size_t MAX_HITCHES = 64;
+
+    FramePacingAnalyzer() : FramePacingAnalyzer(Config{}) {}
+    explicit FramePacingAnalyzer(Config config);
+
+    // Classify a frame, update the window and append it to the log
+    const FrameReport& addFrame(const FrameTimeline& frame);
+
+    const FrameReport& getLastReport() const { return lastReport_; }
+    const std::deque<FrameReport>& getReports() const { return reports_; }
+    // Newest last, at most MAX_HITCHES
+    const std::deque<FrameReport>& getHitches() const { return hitches_; }
+
+    Summary getSummary() const;
+
+    const Config& getConfig() const { return config_; }
+    void reset();
+
+    /**
+     * Rolling per-frame log. path is the live file; full files are renamed
+     * to name.1.ext, name.2.ext, ... (higher is older).
+     */
+    bool startLog(const std::string& path, LogFormat format, uint32_t framesPerFile = 36000, uint32_t keepFiles = 4);
+    void stopLog();
+    bool isLogging() const { return log_.is_open(); }
+
+    std::string summaryJson() const;
+    bool writeSummaryJson(const std::string& path) const;
+
+    // Path of the index-th rotated log file (0 = the live file)
+    static std::string rotatedLogPath(const std::string& path, uint32_t index);
+
+private:
+    bool isStreamingZone(const std::string& name) const;
+    void classify(const FrameTimeline& frame, FrameReport& report) const;
+    bool isHitch(float frameTimeMs) const;
+    void findRootCause(const FrameTimeline& frame, FrameReport& report) const;
+    void updateAverages(const FrameTimeline& frame);
+
+    bool openLogFile();
+    void rotateLog();
+    void writeLogRow(const FrameTimeline& frame, const FrameReport& report);
+
+    Config config_;
+    FrameReport lastReport_;
+    std::deque<FrameReport> reports_;
+    std::deque<FrameReport> hitches_;
+    mutable std::vector<float> scratch_;
+
+    // Running averages for root causes
+    std::unordered_map<std::string, float> cpuZoneAverages_;
+    std::unordered_map<std::string, float> gpuZoneAverages_;
+    float fenceWaitAverage_ = 0.0f;
+    float acquireAverage_ = 0.0f;
+    float presentAverage_ = 0.0f;
+    bool averagesValid_ = false;
+
+    std::ofstream log_;
+    std::string logPath_;
+    LogFormat logFormat_ = LogFormat::Csv;
+    uint32_t logFramesPerFile_ = 0;
+    uint32_t logKeepFiles_ = 0;
+    uint32_t logFramesInFile_ = 0;
+};
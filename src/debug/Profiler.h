@@ -6,7 +6,11 @@
 #include "Flamegraph.h"
 #include "QueueSubmitDiagnostics.h"
 #include "CommandCapture.h"
+#include "TraceExporter.h"
+#include "FramePacingAnalyzer.h"
 #include "interfaces/IProfilerControl.h"
+#include "core/io/IOService.h"
+#include "core/threading/TaskScheduler.h"
 #include <memory>
 #include <optional>
 
@@ -202,11 +206,19 @@ public:
      */
     void captureGpuFlamegraph() {
         if (!gpuProfiler_ || capturePaused_) return;
+        gpuFlamegraphHistory_.push(buildGpuFlamegraph());
+    }
 
-        const auto& stats = gpuProfiler_->getResults();
+    /**
+     * Build a flamegraph from the latest GPU results (see captureGpuFlamegraph).
+     */
+    FlamegraphCapture buildGpuFlamegraph() const {
         FlamegraphCapture capture;
-        capture.totalTimeMs = stats.totalGpuTimeMs;
         capture.frameNumber = frameNumber_;
+        if (!gpuProfiler_) return capture;
+
+        const auto& stats = gpuProfiler_->getResults();
+        capture.totalTimeMs = stats.totalGpuTimeMs;
 
         // Helper to assign color hints
         auto assignColorHint = [](FlamegraphNode& node, const std::string& name) {
@@ -230,7 +242,8 @@ public:
 
         // Build hierarchy from zone names
         // Parent zones (no ':') become roots, child zones (with ':') nest under matching parent
-        std::unordered_map<std::string, FlamegraphNode*> parentNodes;
+        // (indices, since roots grows while children are being attached)
+        std::unordered_map<std::string, size_t> parentNodes;
         std::unordered_map<std::string, float> parentOffsets;
 
         float offset = 0.0f;
@@ -249,10 +262,11 @@ public:
                 // Find existing parent node
                 auto it = parentNodes.find(parentName);
                 if (it != parentNodes.end()) {
-                    // Add as child of parent, offset relative to parent start
-                    node.startMs = parentOffsets[parentName];
+                    // Add as child of parent, laid out from the parent's start
+                    FlamegraphNode& parent = capture.roots[it->second];
+                    node.startMs = parent.startMs + parentOffsets[parentName];
                     parentOffsets[parentName] += zone.gpuTimeMs;
-                    it->second->children.push_back(std::move(node));
+                    parent.children.push_back(std::move(node));
                     continue;  // Don't add to roots
                 }
             }
@@ -264,14 +278,14 @@ public:
             // If this could be a parent, track it
             if (colonPos == std::string::npos) {
                 capture.roots.push_back(std::move(node));
-                parentNodes[zone.name] = &capture.roots.back();
+                parentNodes[zone.name] = capture.roots.size() - 1;
                 parentOffsets[zone.name] = 0.0f;
             } else {
                 capture.roots.push_back(std::move(node));
             }
         }
 
-        gpuFlamegraphHistory_.push(std::move(capture));
+        return capture;
     }
 
     /**
@@ -301,6 +315,54 @@ public:
             captureGpuFlamegraph();
             framesSinceCapture_ = 0;
         }
+
+        if (traceRecording_) {
+            TraceExporter::Frame frame;
+            frame.frameNumber = frameNumber_;
+            frame.startNs = cpuProfiler.getFrameStartNs();
+            frame.cpu = cpuProfiler.getFlamegraphCapture();
+            frame.gpu = buildGpuFlamegraph();
+            frame.counters = std::move(pendingTraceCounters_);
+            pendingTraceCounters_.clear();
+            traceExporter_.addFrame(std::move(frame));
+        }
+
+        if (framePacingEnabled_ && cpuProfiler.isEnabled()) {
+            framePacing_.addFrame(buildFrameTimeline());
+        }
+    }
+
+    /**
+     * The frame just finished as FramePacingAnalyzer sees it: frame-thread
+     * CPU zones, GPU zones and the fence/acquire/submit/present times
+     * FrameExecutor wrote into the queue submit diagnostics. GPU zones are
+     * the latest resolved timestamps, so they trail by the frames in flight.
+     */
+    const FramePacingAnalyzer::FrameTimeline& buildFrameTimeline() {
+        const auto& cpu = cpuProfiler.getResults();
+        FramePacingAnalyzer::FrameTimeline& timeline = pacingTimeline_;
+        timeline.frameNumber = frameNumber_;
+        timeline.frameTimeMs = cpu.totalCpuTimeMs;
+        timeline.cpuZones.resize(cpu.zones.size());
+        for (size_t i = 0; i < cpu.zones.size(); ++i) {
+            timeline.cpuZones[i].name = cpu.zones[i].name;
+            timeline.cpuZones[i].ms = cpu.zones[i].cpuTimeMs;
+        }
+
+        timeline.fenceWaitMs = queueSubmitDiag_.fenceWaitTimeMs;
+        timeline.fenceAlreadySignaled = queueSubmitDiag_.fenceWasAlreadySignaled;
+        timeline.acquireMs = queueSubmitDiag_.acquireImageTimeMs;
+        timeline.submitMs = queueSubmitDiag_.queueSubmitTimeMs;
+        timeline.presentMs = queueSubmitDiag_.presentTimeMs;
+
+        const auto& gpu = getGpuResults();
+        timeline.gpuTimeMs = isGpuProfilingEnabled() ? gpu.totalGpuTimeMs : 0.0f;
+        timeline.gpuZones.resize(isGpuProfilingEnabled() ? gpu.zones.size() : 0);
+        for (size_t i = 0; i < timeline.gpuZones.size(); ++i) {
+            timeline.gpuZones[i].name = gpu.zones[i].name;
+            timeline.gpuZones[i].ms = gpu.zones[i].gpuTimeMs;
+        }
+        return timeline;
     }
 
     /**
@@ -335,6 +397,33 @@ public:
     void setCapturePaused(bool paused) { capturePaused_ = paused; }
     bool isCapturePaused() const { return capturePaused_; }
 
+    /**
+     * Trace recording: while on, every frame (CPU zones of all threads, GPU
+     * zones, counters) goes into the exporter's ring of recent frames.
+     */
+    void setTraceRecording(bool recording) {
+        traceRecording_ = recording;
+        pendingTraceCounters_.clear();
+    }
+    bool isTraceRecording() const { return traceRecording_; }
+
+    // Counter sample for the current frame's trace record (ignored unless recording)
+    void addTraceCounter(const char* track, const char* series, double value) {
+        if (traceRecording_) pendingTraceCounters_.push_back({track, series, value});
+    }
+
+    TraceExporter& getTraceExporter() { return traceExporter_; }
+    const TraceExporter& getTraceExporter() const { return traceExporter_; }
+
+    /**
+     * Frame pacing: every frame is classified (CPU/GPU-bound, streaming
+     * stall, present-bound) and checked for hitches. Cheap, on by default.
+     */
+    void setFramePacingEnabled(bool enabled) { framePacingEnabled_ = enabled; }
+    bool isFramePacingEnabled() const { return framePacingEnabled_; }
+    FramePacingAnalyzer& getFramePacing() { return framePacing_; }
+    const FramePacingAnalyzer& getFramePacing() const { return framePacing_; }
+
     // Flamegraph history access
     const CpuFlamegraphHistory& getCpuFlamegraphHistory() const { return cpuFlamegraphHistory_; }
     const GpuFlamegraphHistory& getGpuFlamegraphHistory() const { return gpuFlamegraphHistory_; }
@@ -348,6 +437,15 @@ public:
     CommandCapture& getCommandCapture() { return commandCapture_; }
     const CommandCapture& getCommandCapture() const { return commandCapture_; }
 
+    /**
+     * Shared streaming I/O queue stats (queue depth, throughput, latency
+     * percentiles). Sampled on demand; IOService keeps the history.
+     */
+    IOService::Stats getIOStats() const { return IOService::instance().getStats(); }
+
+    // Per-pool load on the shared TaskScheduler workers
+    std::vector<TaskScheduler::PoolStats> getThreadPoolStats() const { return TaskScheduler::instance().getPoolStats(); }
+
 private:
     std::optional<GpuProfiler> gpuProfiler_;
     CpuProfiler cpuProfiler;
@@ -369,6 +467,16 @@ private:
     uint32_t framesSinceCapture_ = 0;
     bool flamegraphEnabled_ = true;
     bool capturePaused_ = false;         // Pause capture for inspection
+
+    // Chrome trace export
+    TraceExporter traceExporter_;
+    std::vector<TraceExporter::Counter> pendingTraceCounters_;
+    bool traceRecording_ = false;
+
+    // Frame pacing / bottleneck classification
+    FramePacingAnalyzer framePacing_;
+    FramePacingAnalyzer::FrameTimeline pacingTimeline_;    // Reused each frame
+    bool framePacingEnabled_ = true;
 };
 
 /**
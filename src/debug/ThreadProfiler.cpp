@@ -0,0 +1,196 @@
+#include "ThreadProfiler.h"
+#include <algorithm>
+
+namespace {
+
+// Deeper than any real zone nesting; guards against a thread that never ends its zones
+constexpr size_t MAX_OPEN_ZONES = 64;
+
+} // namespace
+
+std::atomic<bool> ThreadProfiler::enabled_{false};
+
+ThreadProfiler& ThreadProfiler::instance() {
+    static ThreadProfiler instance;
+    return instance;
+}
+
+ThreadProfiler::ZoneId ThreadProfiler::intern(const char* literal) {
+    thread_local std::unordered_map<const char*, ZoneId> cache;
+    auto it = cache.find(literal);
+    if (it != cache.end()) return it->second;
+
+    ZoneId zone = internName(literal);
+    cache.emplace(literal, zone);
+    return zone;
+}
+
+ThreadProfiler::ZoneId ThreadProfiler::internName(const std::string& name) {
+    std::lock_guard<std::mutex> lock(namesMutex_);
+    auto it = nameToZone_.find(name);
+    if (it != nameToZone_.end()) return it->second;
+
+    ZoneId zone = static_cast<ZoneId>(zoneNames_.size());
+    zoneNames_.push_back(name);
+    nameToZone_.emplace(name, zone);
+    return zone;
+}
+
+std::string ThreadProfiler::zoneName(ZoneId zone) const {
+    std::lock_guard<std::mutex> lock(namesMutex_);
+    return zone < zoneNames_.size() ? zoneNames_[zone] : std::string("?");
+}
+
+ThreadProfiler::Ring* ThreadProfiler::registerThread() {
+    auto ring = std::make_unique<Ring>();
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    ring->lane = static_cast<uint32_t>(rings_.size());
+    ring->name = "Thread " + std::to_string(ring->lane);
+    rings_.push_back(std::move(ring));
+    return rings_.back().get();
+}
+
+void ThreadProfiler::setThreadName(const std::string& name) {
+    Ring& ring = localRing();
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    ring.name = name;
+}
+
+uint32_t ThreadProfiler::currentLane() {
+    return localRing().lane;
+}
+
+void ThreadProfiler::drain(std::vector<ThreadEvents>& out) {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    out.resize(rings_.size());
+    for (size_t i = 0; i < rings_.size(); ++i) {
+        Ring& ring = *rings_[i];
+        ThreadEvents& thread = out[i];
+        thread.lane = ring.lane;
+        thread.threadName = ring.name;
+        thread.events.clear();
+        thread.dropped = ring.dropped.exchange(0, std::memory_order_relaxed);
+
+        uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+        uint64_t head = ring.head.load(std::memory_order_acquire);
+        thread.events.reserve(static_cast<size_t>(head - tail));
+        for (uint64_t index = tail; index != head; ++index) {
+            thread.events.push_back(ring.events[index & (RING_CAPACITY - 1)]);
+        }
+        // Hands the slots back to the writer
+        ring.tail.store(head, std::memory_order_release);
+    }
+}
+
+void ThreadProfileCollector::collect(ThreadProfiler& profiler, uint32_t mainLane,
+                                     uint64_t frameStartNs, uint64_t frameEndNs, bool buildTrees,
+                                     FrameResult& out) {
+    profiler.drain(drained_);
+    collect(drained_, profiler, mainLane, frameStartNs, frameEndNs, buildTrees, out);
+}
+
+void ThreadProfileCollector::collect(const std::vector<ThreadProfiler::ThreadEvents>& threads,
+                                     const ThreadProfiler& profiler, uint32_t mainLane,
+                                     uint64_t frameStartNs, uint64_t frameEndNs, bool buildTrees,
+                                     FrameResult& out) {
+    out.capture = FlamegraphCapture{};
+    out.capture.totalTimeMs = static_cast<float>(frameEndNs - frameStartNs) / 1e6f;
+    out.mainTotals.clear();
+    out.droppedEvents = 0;
+
+    std::unordered_map<ThreadProfiler::ZoneId, std::string> names;
+
+    for (const auto& thread : threads) {
+        out.droppedEvents += thread.dropped;
+        if (lanes_.size() <= thread.lane) lanes_.resize(thread.lane + 1);
+        std::vector<RawNode>& open = lanes_[thread.lane].open;
+        const bool isMain = thread.lane == mainLane;
+        std::vector<FlamegraphNode> roots;
+
+        for (const auto& event : thread.events) {
+            if (event.kind == ThreadProfiler::EventKind::Begin) {
+                if (open.size() < MAX_OPEN_ZONES) {
+                    open.push_back({event.zone, event.timestampNs, event.timestampNs, {}});
+                }
+                continue;
+            }
+
+            // Unmatched ends (their begin was dropped or capped) are ignored
+            auto match = std::find_if(open.rbegin(), open.rend(),
+                [&event](const RawNode& node) { return node.zone == event.zone; });
+            if (match == open.rend()) continue;
+            size_t index = static_cast<size_t>(open.rend() - match) - 1;
+
+            // Zones opened inside it that never ended close with it
+            while (open.size() > index + 1) {
+                RawNode inner = std::move(open.back());
+                open.pop_back();
+                inner.endNs = event.timestampNs;
+                if (buildTrees) open.back().children.push_back(std::move(inner));
+            }
+
+            RawNode node = std::move(open.back());
+            open.pop_back();
+            node.endNs = event.timestampNs;
+            if (node.endNs < frameStartNs) continue;   // Ended between frames
+
+            if (isMain) {
+                bool outermost = std::none_of(open.begin(), open.end(),
+                    [&node](const RawNode& parent) { return parent.zone == node.zone; });
+                if (outermost) {
+                    uint64_t start = std::max(node.startNs, frameStartNs);
+                    float ms = static_cast<float>(node.endNs - start) / 1e6f;
+                    auto total = std::find_if(out.mainTotals.begin(), out.mainTotals.end(),
+                        [&node](const ZoneTotal& t) { return t.zone == node.zone; });
+                    if (total == out.mainTotals.end()) {
+                        out.mainTotals.push_back({node.zone, ms, node.startNs});
+                    } else {
+                        total->ms += ms;
+                        total->firstBeginNs = std::min(total->firstBeginNs, node.startNs);
+                    }
+                }
+            }
+
+            if (!buildTrees) continue;
+            if (open.empty()) {
+                roots.push_back(toNode(node, profiler, frameStartNs, names));
+            } else {
+                open.back().children.push_back(std::move(node));
+            }
+        }
+
+        if (isMain) {
+            out.capture.roots = std::move(roots);
+        } else if (!roots.empty()) {
+            out.capture.lanes.push_back({thread.threadName, thread.lane, std::move(roots)});
+        }
+    }
+
+    // Gathered in end order; a parent ends after its children but began first
+    std::stable_sort(out.mainTotals.begin(), out.mainTotals.end(),
+        [](const ZoneTotal& a, const ZoneTotal& b) { return a.firstBeginNs < b.firstBeginNs; });
+}
+
+FlamegraphNode ThreadProfileCollector::toNode(const RawNode& raw, const ThreadProfiler& profiler,
+                                              uint64_t frameStartNs,
+                                              std::unordered_map<ThreadProfiler::ZoneId, std::string>& names) {
+    auto it = names.find(raw.zone);
+    if (it == names.end()) {
+        it = names.emplace(raw.zone, profiler.zoneName(raw.zone)).first;
+    }
+
+    uint64_t start = std::max(raw.startNs, frameStartNs);
+    FlamegraphNode node;
+    node.name = it->second;
+    node.startMs = static_cast<float>(start - frameStartNs) / 1e6f;
+    node.durationMs = static_cast<float>(std::max(raw.endNs, start) - start) / 1e6f;
+    node.isWaitZone = isWaitZoneName(node.name);
+    node.colorHint = flamegraphColorHint(node.name, node.isWaitZone);
+
+    node.children.reserve(raw.children.size());
+    for (const RawNode& child : raw.children) {
+        if (child.endNs < frameStartNs) continue;
+        node.children.push_back(toNode(child, profiler, frameStartNs, names));
+    }
+    return node;
+}
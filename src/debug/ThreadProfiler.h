@@ -0,0 +1,215 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Flamegraph.h"
+
+/**
+ * ThreadProfiler - Per-thread CPU zone recording for any thread
+ *
+ * Every thread that records a zone gets its own fixed-size ring of
+ * (timestamp, zone id, begin/end) events. Only the owning thread writes a
+ * ring and only the collector reads it, so recording is a timestamp read
+ * and a store - no lock, no allocation, no string work. A full ring drops
+ * events (counted) rather than blocking.
+ *
+ * Zone names are interned to ids once. PROFILE_THREAD_ZONE caches the id in
+ * a static at the call site; the const char* overloads cache per thread by
+ * pointer, so they expect string literals.
+ *
+ * When disabled, recording is a single relaxed atomic load.
+ *
+ * Usage:
+ *   ThreadProfiler::instance().setThreadName("Physics");
+ *   {
+ *       PROFILE_THREAD_ZONE("Physics:Step");
+ *       // ...
+ *   }
+ *
+ * ThreadProfileCollector turns drained events into per-thread zone trees.
+ */
+class ThreadProfiler {
+public:
+    using ZoneId = uint32_t;
+    static constexpr ZoneId INVALID_ZONE = UINT32_MAX;
+    static constexpr size_t RING_CAPACITY = 1 << 14;   // Events per thread
+
+    enum class EventKind : uint32_t { Begin, End };
+
+    struct Event {
+        uint64_t timestampNs;
+        ZoneId zone;
+        EventKind kind;
+    };
+
+    struct ThreadEvents {
+        uint32_t lane = 0;                  // Registration order, stable per thread
+        std::string threadName;
+        std::vector<Event> events;
+        uint64_t dropped = 0;               // Since the previous drain
+    };
+
+    static ThreadProfiler& instance();
+
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Intern a string literal; cached per thread by pointer
+    ZoneId intern(const char* literal);
+
+    // Intern a name that may not outlive the call (no pointer caching)
+    ZoneId internName(const std::string& name);
+
+    std::string zoneName(ZoneId zone) const;
+
+    void beginZone(ZoneId zone) { record(zone, EventKind::Begin); }
+    void endZone(ZoneId zone) { record(zone, EventKind::End); }
+    void beginZone(const char* literal) { if (isEnabled()) record(intern(literal), EventKind::Begin); }
+    void endZone(const char* literal) { if (isEnabled()) record(intern(literal), EventKind::End); }
+
+    // Name the calling thread's lane (registers it if needed)
+    void setThreadName(const std::string& name);
+
+    // Lane of the calling thread (registers it if needed)
+    uint32_t currentLane();
+
+    /**
+     * Move every ring's pending events into out, one entry per registered
+     * thread (storage is reused between calls). Safe to call from any one
+     * thread at a time while others keep recording.
+     */
+    void drain(std::vector<ThreadEvents>& out);
+
+    class ScopedZone {
+    public:
+        explicit ScopedZone(ZoneId zone) : zone_(zone), active_(isEnabled()) {
+            if (active_) instance().record(zone_, EventKind::Begin);
+        }
+        ~ScopedZone() {
+            if (active_) instance().record(zone_, EventKind::End);
+        }
+
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+
+    private:
+        ZoneId zone_;
+        bool active_;
+    };
+
+private:
+    ThreadProfiler() = default;
+
+    struct Ring {
+        std::unique_ptr<Event[]> events{new Event[RING_CAPACITY]};
+        alignas(64) std::atomic<uint64_t> head{0};      // Written by the owning thread
+        alignas(64) std::atomic<uint64_t> tail{0};      // Written by the collector
+        std::atomic<uint64_t> dropped{0};
+        uint32_t lane = 0;
+        std::string name;                               // Under registryMutex_
+    };
+
+    void record(ZoneId zone, EventKind kind) {
+        if (!isEnabled()) return;
+        Ring& ring = localRing();
+        uint64_t head = ring.head.load(std::memory_order_relaxed);
+        if (head - ring.tail.load(std::memory_order_acquire) >= RING_CAPACITY) {
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        ring.events[head & (RING_CAPACITY - 1)] = {nowNs(), zone, kind};
+        ring.head.store(head + 1, std::memory_order_release);
+    }
+
+    Ring& localRing() {
+        thread_local Ring* ring = nullptr;
+        if (!ring) ring = registerThread();
+        return *ring;
+    }
+
+    Ring* registerThread();
+
+    static std::atomic<bool> enabled_;
+
+    // Rings live as long as the process so exited threads leave no dangling pointers
+    mutable std::mutex registryMutex_;
+    std::vector<std::unique_ptr<Ring>> rings_;
+
+    mutable std::mutex namesMutex_;
+    std::unordered_map<std::string, ZoneId> nameToZone_;
+    std::deque<std::string> zoneNames_;
+};
+
+/**
+ * ThreadProfileCollector - Builds per-frame zone trees from drained events
+ *
+ * Zones are reported in the frame they end in; zones still open when a
+ * frame is collected stay open and are reported later. Zones that started
+ * before the frame are clipped to its start.
+ */
+class ThreadProfileCollector {
+public:
+    struct ZoneTotal {
+        ThreadProfiler::ZoneId zone;
+        float ms;               // Outermost instances only, clipped to the frame
+        uint64_t firstBeginNs;
+    };
+
+    struct FrameResult {
+        FlamegraphCapture capture;          // Roots = the collecting thread; lanes = other threads
+        std::vector<ZoneTotal> mainTotals;  // Collecting thread, in order of first begin
+        uint64_t droppedEvents = 0;
+    };
+
+    /**
+     * Drain the profiler and build the frame [frameStartNs, frameEndNs].
+     * mainLane is the lane whose zones become the capture roots and totals.
+     */
+    void collect(ThreadProfiler& profiler, uint32_t mainLane,
+                 uint64_t frameStartNs, uint64_t frameEndNs, bool buildTrees, FrameResult& out);
+
+    // Same, from already-drained events (for tests)
+    void collect(const std::vector<ThreadProfiler::ThreadEvents>& threads, const ThreadProfiler& profiler,
+                 uint32_t mainLane, uint64_t frameStartNs, uint64_t frameEndNs, bool buildTrees,
+                 FrameResult& out);
+
+private:
+    struct RawNode {
+        ThreadProfiler::ZoneId zone;
+        uint64_t startNs;
+        uint64_t endNs;
+        std::vector<RawNode> children;
+    };
+
+    struct LaneState {
+        std::vector<RawNode> open;      // Stack of zones begun but not ended
+    };
+
+    static FlamegraphNode toNode(const RawNode& raw, const ThreadProfiler& profiler,
+                                 uint64_t frameStartNs, std::unordered_map<ThreadProfiler::ZoneId, std::string>& names);
+
+    std::vector<ThreadProfiler::ThreadEvents> drained_;
+    std::vector<LaneState> lanes_;
+};
+
+#define PROFILE_THREAD_ZONE_CONCAT_(a, b) a##b
+#define PROFILE_THREAD_ZONE_NAME_(a, b) PROFILE_THREAD_ZONE_CONCAT_(a, b)
+
+// Scoped zone with the name interned once per call site
+#define PROFILE_THREAD_ZONE(name) \
+    static const ThreadProfiler::ZoneId PROFILE_THREAD_ZONE_NAME_(_threadZoneId, __LINE__) = \
+        ThreadProfiler::instance().intern(name); \
+    ThreadProfiler::ScopedZone PROFILE_THREAD_ZONE_NAME_(_threadZone, __LINE__)( \
+        PROFILE_THREAD_ZONE_NAME_(_threadZoneId, __LINE__))
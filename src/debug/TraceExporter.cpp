@@ -0,0 +1,200 @@
+#include "TraceExporter.h"
+#include <SDL3/SDL_log.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr int CPU_PID = 1;
+constexpr int GPU_PID = 2;
+constexpr int STARTUP_PID = 3;
+
+constexpr int FRAME_TID = 0;            // CPU process: the thread that ran the frame
+constexpr int INIT_PHASES_TID = 0;      // Startup process: InitProfiler phases
+
+json metadata(const char* kind, int pid, int tid, const std::string& name) {
+    return {{"ph", "M"}, {"name", kind}, {"pid", pid}, {"tid", tid}, {"args", {{"name", name}}}};
+}
+
+json sortIndex(const char* kind, int pid, int tid, int index) {
+    return {{"ph", "M"}, {"name", kind}, {"pid", pid}, {"tid", tid}, {"args", {{"sort_index", index}}}};
+}
+
+json complete(const std::string& name, const char* category, int pid, int tid, double tsUs, double durUs) {
+    return {{"ph", "X"}, {"name", name}, {"cat", category}, {"pid", pid}, {"tid", tid},
+            {"ts", tsUs}, {"dur", std::max(0.0, durUs)}};
+}
+
+/**
+ * Emit a node and its children as complete events. baseUs is where the
+ * node's capture starts; children are clamped into their parent so float
+ * rounding can't break the nesting viewers rely on.
+ */
+void emitNode(json& events, const FlamegraphNode& node, const char* category, int pid, int tid,
+              double baseUs, double minUs, double maxUs) {
+    double start = std::clamp(baseUs + node.startMs * 1000.0, minUs, maxUs);
+    double end = std::clamp(baseUs + node.endMs() * 1000.0, start, maxUs);
+    events.push_back(complete(node.name, category, pid, tid, start, end - start));
+    for (const auto& child : node.children) {
+        emitNode(events, child, category, pid, tid, baseUs, start, end);
+    }
+}
+
+void emitRoots(json& events, const std::vector<FlamegraphNode>& roots, const char* category,
+               int pid, int tid, double baseUs) {
+    for (const auto& root : roots) {
+        emitNode(events, root, category, pid, tid, baseUs, baseUs, std::numeric_limits<double>::max());
+    }
+}
+
+} // namespace
+
+TraceExporter::TraceExporter(size_t capacity)
+    : capacity_(std::max<size_t>(1, capacity)) {}
+
+void TraceExporter::addFrame(Frame frame) {
+    if (frames_.size() == capacity_) {
+        frames_.pop_front();
+    }
+    frames_.push_back(std::move(frame));
+}
+
+void TraceExporter::setStartup(uint64_t originNs, FlamegraphCapture initPhases, std::vector<StartupSpan> spans) {
+    hasStartup_ = true;
+    startupOriginNs_ = originNs;
+    initPhases_ = std::move(initPhases);
+    startupSpans_ = std::move(spans);
+}
+
+void TraceExporter::setCapacity(size_t capacity) {
+    capacity_ = std::max<size_t>(1, capacity);
+    while (frames_.size() > capacity_) {
+        frames_.pop_front();
+    }
+}
+
+void TraceExporter::clear() {
+    frames_.clear();
+    hasStartup_ = false;
+    initPhases_ = FlamegraphCapture{};
+    startupSpans_.clear();
+}
+
+std::string TraceExporter::toJson() const {
+    // Earliest recorded time becomes ts 0
+    uint64_t originNs = UINT64_MAX;
+    if (hasStartup_) {
+        originNs = startupOriginNs_;
+        for (const auto& span : startupSpans_) originNs = std::min(originNs, span.startNs);
+    }
+    for (const auto& frame : frames_) originNs = std::min(originNs, frame.startNs);
+    if (originNs == UINT64_MAX) originNs = 0;
+
+    auto toUs = [originNs](uint64_t ns) {
+        return ns >= originNs ? static_cast<double>(ns - originNs) / 1000.0
+                              : -static_cast<double>(originNs - ns) / 1000.0;
+    };
+
+    json events = json::array();
+    events.push_back(metadata("process_name", CPU_PID, 0, "CPU"));
+    events.push_back(sortIndex("process_sort_index", CPU_PID, 0, 0));
+    events.push_back(metadata("thread_name", CPU_PID, FRAME_TID, "Frame thread"));
+    events.push_back(sortIndex("thread_sort_index", CPU_PID, FRAME_TID, -1));
+
+    // Worker lanes keep the name they had in the newest frame
+    std::map<uint32_t, std::string> laneNames;
+    bool anyGpu = false;
+
+    for (const auto& frame : frames_) {
+        double frameUs = toUs(frame.startNs);
+
+        events.push_back(complete("Frame " + std::to_string(frame.frameNumber), "frame",
+                                  CPU_PID, FRAME_TID, frameUs, frame.cpu.totalTimeMs * 1000.0));
+        emitRoots(events, frame.cpu.roots, "cpu", CPU_PID, FRAME_TID, frameUs);
+
+        for (const auto& lane : frame.cpu.lanes) {
+            laneNames[lane.lane] = lane.threadName;
+            emitRoots(events, lane.roots, "cpu", CPU_PID, static_cast<int>(lane.lane) + 1, frameUs);
+        }
+
+        if (!frame.gpu.isEmpty()) {
+            anyGpu = true;
+            events.push_back(complete("GPU frame " + std::to_string(frame.frameNumber), "frame",
+                                      GPU_PID, 0, frameUs, frame.gpu.totalTimeMs * 1000.0));
+            emitRoots(events, frame.gpu.roots, "gpu", GPU_PID, 0, frameUs);
+        }
+
+        // One counter event per track, its series as args
+        std::map<std::string, json> tracks;
+        for (const auto& counter : frame.counters) {
+            tracks[counter.track][counter.series] = counter.value;
+        }
+        for (auto& [track, args] : tracks) {
+            events.push_back({{"ph", "C"}, {"name", track}, {"pid", CPU_PID}, {"tid", FRAME_TID},
+                              {"ts", frameUs}, {"args", std::move(args)}});
+        }
+    }
+
+    for (const auto& [lane, name] : laneNames) {
+        int tid = static_cast<int>(lane) + 1;
+        events.push_back(metadata("thread_name", CPU_PID, tid, name));
+        events.push_back(sortIndex("thread_sort_index", CPU_PID, tid, tid));
+    }
+
+    if (anyGpu) {
+        events.push_back(metadata("process_name", GPU_PID, 0, "GPU"));
+        events.push_back(sortIndex("process_sort_index", GPU_PID, 0, 1));
+        events.push_back(metadata("thread_name", GPU_PID, 0, "Graphics queue"));
+    }
+
+    if (hasStartup_) {
+        events.push_back(metadata("process_name", STARTUP_PID, 0, "Startup"));
+        events.push_back(sortIndex("process_sort_index", STARTUP_PID, 0, 2));
+        events.push_back(metadata("thread_name", STARTUP_PID, INIT_PHASES_TID, "Init phases"));
+        emitRoots(events, initPhases_.roots, "startup", STARTUP_PID, INIT_PHASES_TID, toUs(startupOriginNs_));
+
+        // Loader lanes in order of first appearance
+        std::map<std::string, int> laneTids;
+        for (const auto& span : startupSpans_) {
+            auto [it, added] = laneTids.emplace(span.lane, static_cast<int>(laneTids.size()) + 1);
+            if (added) {
+                events.push_back(metadata("thread_name", STARTUP_PID, it->second, span.lane));
+            }
+            uint64_t end = std::max(span.startNs, span.endNs);
+            events.push_back(complete(span.name, "startup", STARTUP_PID, it->second,
+                                      toUs(span.startNs), static_cast<double>(end - span.startNs) / 1000.0));
+        }
+    }
+
+    json trace = {
+        {"displayTimeUnit", "ms"},
+        {"traceEvents", std::move(events)},
+        {"otherData", {{"frames", frames_.size()}, {"startup", hasStartup_}}}
+    };
+    return trace.dump();
+}
+
+bool TraceExporter::writeJson(const std::string& path) const {
+    std::error_code ec;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TraceExporter: can't write '%s'", path.c_str());
+        return false;
+    }
+    file << toJson();
+
+    SDL_Log("Trace written to %s (%zu frames%s)", path.c_str(), frames_.size(),
+            hasStartup_ ? " + startup" : "");
+    return static_cast<bool>(file);
+}
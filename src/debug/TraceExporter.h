@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Flamegraph.h"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * TraceExporter - Recent frames and startup as a Chrome Trace Event file
+ *
+ * Keeps a ring of the last N frames (CPU zones of every thread, GPU zones,
+ * per-frame counters) plus one startup record, and writes them as Trace
+ * Event JSON that chrome://tracing, Perfetto UI and speedscope open
+ * directly.
+ *
+ * Layout of the written trace:
+ * - Process "CPU": the frame thread (tid 0) with a "Frame N" span around
+ *   each frame's zones, one thread per worker lane, and the counter tracks.
+ * - Process "GPU": the frame's GPU zones. GPU timestamps are not correlated
+ *   with the CPU clock, so each GPU frame is drawn from its CPU frame start.
+ * - Process "Startup": InitProfiler phases and the loader lanes.
+ *
+ * All timestamps are steady_clock nanoseconds (ThreadProfiler::nowNs()).
+ */
+class TraceExporter {
+public:
+    struct Counter {
+        std::string track;      // Chart name, e.g. "NPC tiers"
+        std::string series;     // Line within the chart, e.g. "Real"
+        double value = 0.0;
+    };
+
+    struct Frame {
+        uint64_t frameNumber = 0;
+        uint64_t startNs = 0;
+        FlamegraphCapture cpu;          // Roots = frame thread, lanes = other threads
+        FlamegraphCapture gpu;
+        std::vector<Counter> counters;
+    };
+
+    struct StartupSpan {
+        std::string lane;
+        std::string name;
+        uint64_t startNs = 0;
+        uint64_t endNs = 0;
+    };
+
+    static constexpr size_t DEFAULT_CAPACITY = 300;
+
+    explicit TraceExporter(size_t capacity = DEFAULT_CAPACITY);
+
+    // Oldest frame is dropped once the ring is full
+    void addFrame(Frame frame);
+
+    /**
+     * Startup record; initPhases times are relative to originNs, span times
+     * are absolute. Replaces any previous startup record.
+     */
+    void setStartup(uint64_t originNs, FlamegraphCapture initPhases, std::vector<StartupSpan> spans);
+
+    size_t getFrameCount() const { return frames_.size(); }
+    size_t getCapacity() const { return capacity_; }
+    void setCapacity(size_t capacity);
+    bool hasStartup() const { return hasStartup_; }
+
+    void clear();
+
+    std::string toJson() const;
+    bool writeJson(const std::string& path) const;
+
+private:
+    size_t capacity_;
+    std::deque<Frame> frames_;
+
+    bool hasStartup_ = false;
+    uint64_t startupOriginNs_ = 0;
+    FlamegraphCapture initPhases_;
+    std::vector<StartupSpan> startupSpans_;
+};
@@ -0,0 +1,204 @@
+#include "BoundsCulling.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BOUNDSCULLING_SSE2 1
+#endif
+
+namespace ecs {
+
+void CullBoundsSoA::resize(size_t count) {
+    for (auto* column : {&centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ, &radius}) {
+        column->resize(count, 0.0f);
+    }
+}
+
+void CullBoundsSoA::setSphere(size_t index, const glm::mat4& world, const glm::vec3& center, float sphereRadius) {
+    glm::vec3 worldCenter = glm::vec3(world * glm::vec4(center, 1.0f));
+
+    // Squared lengths compared first: one sqrt instead of three
+    float scaleSq = std::max(glm::dot(glm::vec3(world[0]), glm::vec3(world[0])),
+                             std::max(glm::dot(glm::vec3(world[1]), glm::vec3(world[1])),
+                                      glm::dot(glm::vec3(world[2]), glm::vec3(world[2]))));
+
+    centerX[index] = worldCenter.x;
+    centerY[index] = worldCenter.y;
+    centerZ[index] = worldCenter.z;
+    extentX[index] = 0.0f;
+    extentY[index] = 0.0f;
+    extentZ[index] = 0.0f;
+    radius[index] = sphereRadius * std::sqrt(scaleSq);
+}
+
+void CullBoundsSoA::setBox(size_t index, const glm::mat4& world, const glm::vec3& min, const glm::vec3& max) {
+    glm::vec3 localCenter = (min + max) * 0.5f;
+    glm::vec3 localExtent = (max - min) * 0.5f;
+    glm::vec3 worldCenter = glm::vec3(world * glm::vec4(localCenter, 1.0f));
+
+    // Each world axis extent is the local extents projected through |M| (Arvo)
+    glm::vec3 worldExtent(0.0f);
+    for (int axis = 0; axis < 3; ++axis) {
+        worldExtent += glm::abs(glm::vec3(world[axis])) * localExtent[axis];
+    }
+
+    centerX[index] = worldCenter.x;
+    centerY[index] = worldCenter.y;
+    centerZ[index] = worldCenter.z;
+    extentX[index] = worldExtent.x;
+    extentY[index] = worldExtent.y;
+    extentZ[index] = worldExtent.z;
+    radius[index] = 0.0f;
+}
+
+namespace {
+
+bool insideScalar(const std::array<glm::vec4, 6>& planes, const CullBoundsSoA& bounds, size_t i) {
+    for (const auto& plane : planes) {
+        float distance = plane.x * bounds.centerX[i] + plane.y * bounds.centerY[i] +
+                         plane.z * bounds.centerZ[i] + plane.w + bounds.radius[i] +
+                         std::abs(plane.x) * bounds.extentX[i] + std::abs(plane.y) * bounds.extentY[i] +
+                         std::abs(plane.z) * bounds.extentZ[i];
+        if (distance < 0.0f) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+#ifdef BOUNDSCULLING_SSE2
+
+namespace {
+
+struct PlaneLanes {
+    __m128 nx, ny, nz, d;
+    __m128 ax, ay, az;      // |n|
+};
+
+// Four entries' bounds, one per lane
+struct BoundsLanes {
+    __m128 cx, cy, cz;
+    __m128 ex, ey, ez;
+    __m128 r;
+};
+
+inline void broadcastPlanes(const std::array<glm::vec4, 6>& planes, PlaneLanes* lanes) {
+    for (int p = 0; p < 6; ++p) {
+        lanes[p].nx = _mm_set1_ps(planes[p].x);
+        lanes[p].ny = _mm_set1_ps(planes[p].y);
+        lanes[p].nz = _mm_set1_ps(planes[p].z);
+        lanes[p].d = _mm_set1_ps(planes[p].w);
+        lanes[p].ax = _mm_set1_ps(std::abs(planes[p].x));
+        lanes[p].ay = _mm_set1_ps(std::abs(planes[p].y));
+        lanes[p].az = _mm_set1_ps(std::abs(planes[p].z));
+    }
+}
+
+// Four consecutive entries starting at first
+inline BoundsLanes loadBounds4(const CullBoundsSoA& bounds, size_t first) {
+    return {_mm_loadu_ps(&bounds.centerX[first]), _mm_loadu_ps(&bounds.centerY[first]),
+            _mm_loadu_ps(&bounds.centerZ[first]), _mm_loadu_ps(&bounds.extentX[first]),
+            _mm_loadu_ps(&bounds.extentY[first]), _mm_loadu_ps(&bounds.extentZ[first]),
+            _mm_loadu_ps(&bounds.radius[first])};
+}
+
+// Four arbitrary entries, gathered through stack arrays
+inline BoundsLanes gatherBounds4(const CullBoundsSoA& bounds, const uint32_t* entries) {
+    alignas(16) float cx[4], cy[4], cz[4], ex[4], ey[4], ez[4], r[4];
+    for (size_t j = 0; j < 4; ++j) {
+        uint32_t e = entries[j];
+        cx[j] = bounds.centerX[e];
+        cy[j] = bounds.centerY[e];
+        cz[j] = bounds.centerZ[e];
+        ex[j] = bounds.extentX[e];
+        ey[j] = bounds.extentY[e];
+        ez[j] = bounds.extentZ[e];
+        r[j] = bounds.radius[e];
+    }
+    return {_mm_load_ps(cx), _mm_load_ps(cy), _mm_load_ps(cz), _mm_load_ps(ex),
+            _mm_load_ps(ey), _mm_load_ps(ez), _mm_load_ps(r)};
+}
+
+// Visible-lane mask (bit j for lane j)
+inline uint32_t insideMask4(const PlaneLanes* planes, const BoundsLanes& b) {
+    const __m128 zero = _mm_setzero_ps();
+    __m128 outside = zero;
+    for (int p = 0; p < 6; ++p) {
+        const PlaneLanes& pl = planes[p];
+        __m128 distance = _mm_add_ps(_mm_mul_ps(pl.nx, b.cx), _mm_mul_ps(pl.ny, b.cy));
+        distance = _mm_add_ps(distance, _mm_mul_ps(pl.nz, b.cz));
+        distance = _mm_add_ps(distance, _mm_add_ps(pl.d, b.r));
+        __m128 reach = _mm_add_ps(_mm_mul_ps(pl.ax, b.ex), _mm_mul_ps(pl.ay, b.ey));
+        reach = _mm_add_ps(reach, _mm_mul_ps(pl.az, b.ez));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, reach), zero));
+    }
+    return static_cast<uint32_t>(~_mm_movemask_ps(outside)) & 0xFu;
+}
+
+} // namespace
+
+void cullBounds(const std::array<glm::vec4, 6>& planes, const CullBoundsSoA& bounds,
+                size_t begin, size_t end, uint64_t* visibleBits) {
+    PlaneLanes lanes[6];
+    broadcastPlanes(planes, lanes);
+
+    for (size_t base = begin; base < end; base += 64) {
+        size_t count = std::min<size_t>(64, end - base);
+        uint64_t word = 0;
+        size_t j = 0;
+        for (; j + 4 <= count; j += 4) {
+            word |= static_cast<uint64_t>(insideMask4(lanes, loadBounds4(bounds, base + j))) << j;
+        }
+        for (; j < count; ++j) {
+            if (insideScalar(planes, bounds, base + j)) word |= uint64_t(1) << j;
+        }
+        visibleBits[base / 64] = word;
+    }
+}
+
+size_t cullBoundsList(const std::array<glm::vec4, 6>& planes, const CullBoundsSoA& bounds,
+                      uint32_t* entries, size_t count) {
+    PlaneLanes lanes[6];
+    broadcastPlanes(planes, lanes);
+
+    size_t kept = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        uint32_t mask = insideMask4(lanes, gatherBounds4(bounds, entries + i));
+        for (size_t j = 0; j < 4; ++j) {
+            if (mask & (1u << j)) entries[kept++] = entries[i + j];
+        }
+    }
+    for (; i < count; ++i) {
+        if (insideScalar(planes, bounds, entries[i])) entries[kept++] = entries[i];
+    }
+    return kept;
+}
+
+#else
+
+void cullBounds(const std::array<glm::vec4, 6>& planes, const CullBoundsSoA& bounds,
+                size_t begin, size_t end, uint64_t* visibleBits) {
+    for (size_t base = begin; base < end; base += 64) {
+        size_t count = std::min<size_t>(64, end - base);
+        uint64_t word = 0;
+        for (size_t j = 0; j < count; ++j) {
+            if (insideScalar(planes, bounds, base + j)) word |= uint64_t(1) << j;
+        }
+        visibleBits[base / 64] = word;
+    }
+}
+
+size_t cullBoundsList(const std::array<glm::vec4, 6>& planes, const CullBoundsSoA& bounds,
+                      uint32_t* entries, size_t count) {
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (insideScalar(planes, bounds, entries[i])) entries[kept++] = entries[i];
+    }
+    return kept;
+}
+
+#endif
+
+} // namespace ecs
@@ -0,0 +1,57 @@
+// CPU frustum culling of world-space bounds in structure-of-arrays form
+// Four bounds per SSE2 step (scalar fallback elsewhere), one bit per entry
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ecs {
+
+/**
+ * World-space culling bounds, one entry per culled entity.
+ *
+ * Spheres and boxes share one layout so a single kernel tests both: a sphere
+ * has zero extents, a box (centre plus half-extents of its world AABB) has
+ * zero radius. An entry is outside a plane n.p + d = 0 when
+ *   n.center + d + radius + |n|.extents < 0
+ * which is the sphere distance test and the positive-vertex AABB test at once.
+ */
+struct CullBoundsSoA {
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+    std::vector<float> radius;
+
+    size_t size() const { return centerX.size(); }
+    void resize(size_t count);
+
+    // Sphere scaled by the largest axis scale of the world matrix
+    void setSphere(size_t index, const glm::mat4& world, const glm::vec3& center, float sphereRadius);
+    // World AABB of a transformed local AABB (same box as transforming its 8 corners)
+    void setBox(size_t index, const glm::mat4& world, const glm::vec3& min, const glm::vec3& max);
+};
+
+// Bit-per-entry visibility words needed for count entries
+inline size_t cullWordCount(size_t count) { return (count + 63) / 64; }
+
+/**
+ * Test entries [begin, end) against six normalized planes (as in ecs::Frustum)
+ * and write their bits into visibleBits (bit i of word i / 64). begin must be
+ * a multiple of 64 so concurrent calls on disjoint ranges never share a word;
+ * bits past end in the last word are cleared.
+ */
+void cullBounds(const std::array<glm::vec4, 6>& planes, const CullBoundsSoA& bounds,
+                size_t begin, size_t end, uint64_t* visibleBits);
+
+/**
+ * Test an arbitrary list of entries (e.g. the ones a spatial query found
+ * straddling a plane). Entries that pass are compacted to the front of
+ * entries in their original order; returns how many passed.
+ */
+size_t cullBoundsList(const std::array<glm::vec4, 6>& planes, const CullBoundsSoA& bounds,
+                      uint32_t* entries, size_t count);
+
+} // namespace ecs
@@ -44,7 +44,8 @@ struct Transform {
 // =============================================================================
 // Stores transformation relative to parent entity. Used with Parent component
 // for hierarchical transforms. The world Transform is computed by the
-// updateWorldTransforms() system.
+// updateWorldTransforms() system; modify it through World::patch() so that
+// system sees the change.
 
 struct LocalTransform {
     glm::vec3 position = glm::vec3(0.0f);
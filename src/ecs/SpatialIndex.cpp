@@ -0,0 +1,252 @@
+#include "SpatialIndex.h"
+#include <cassert>
+
+namespace ecs {
+
+namespace {
+
+float surfaceArea(const glm::vec3& min, const glm::vec3& max) {
+    glm::vec3 d = max - min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+float unionArea(const glm::vec3& minA, const glm::vec3& maxA, const glm::vec3& minB, const glm::vec3& maxB) {
+    return surfaceArea(glm::min(minA, minB), glm::max(maxA, maxB));
+}
+
+bool contains(const glm::vec3& outerMin, const glm::vec3& outerMax,
+              const glm::vec3& innerMin, const glm::vec3& innerMax) {
+    return outerMin.x <= innerMin.x && outerMin.y <= innerMin.y && outerMin.z <= innerMin.z &&
+           innerMax.x <= outerMax.x && innerMax.y <= outerMax.y && innerMax.z <= outerMax.z;
+}
+
+} // namespace
+
+int32_t SpatialIndex::insert(const glm::vec3& min, const glm::vec3& max, uint32_t userData, uint32_t layers) {
+    int32_t proxy = allocateNode();
+    Node& node = nodes_[proxy];
+    node.min = min - glm::vec3(margin_);
+    node.max = max + glm::vec3(margin_);
+    node.userData = userData;
+    node.layers = layers;
+    node.height = 0;
+    insertLeaf(proxy);
+    ++proxyCount_;
+    return proxy;
+}
+
+void SpatialIndex::remove(int32_t proxy) {
+    assert(proxy >= 0 && static_cast<size_t>(proxy) < nodes_.size() && nodes_[proxy].isLeaf());
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --proxyCount_;
+}
+
+bool SpatialIndex::update(int32_t proxy, const glm::vec3& min, const glm::vec3& max) {
+    Node& node = nodes_[proxy];
+    if (contains(node.min, node.max, min, max)) {
+        // Still inside; only refit if the object shrank far below its fat box,
+        // so a once-large box doesn't keep overlapping every query
+        const glm::vec3 slack(4.0f * margin_);
+        if (contains(min - slack, max + slack, node.min, node.max)) return false;
+    }
+
+    removeLeaf(proxy);
+    nodes_[proxy].min = min - glm::vec3(margin_);
+    nodes_[proxy].max = max + glm::vec3(margin_);
+    insertLeaf(proxy);
+    return true;
+}
+
+void SpatialIndex::setLayers(int32_t proxy, uint32_t layers) {
+    if (nodes_[proxy].layers == layers) return;
+    removeLeaf(proxy);
+    nodes_[proxy].layers = layers;
+    insertLeaf(proxy);
+}
+
+void SpatialIndex::clear() {
+    nodes_.clear();
+    root_ = NULL_PROXY;
+    freeList_ = NULL_PROXY;
+    proxyCount_ = 0;
+}
+
+// ============================================================================
+// Node pool
+// ============================================================================
+
+int32_t SpatialIndex::allocateNode() {
+    if (freeList_ == NULL_PROXY) {
+        nodes_.emplace_back();
+        return static_cast<int32_t>(nodes_.size() - 1);
+    }
+    int32_t node = freeList_;
+    freeList_ = nodes_[node].parent;
+    nodes_[node] = Node{};
+    return node;
+}
+
+void SpatialIndex::freeNode(int32_t node) {
+    nodes_[node].parent = freeList_;
+    nodes_[node].child1 = NULL_PROXY;
+    nodes_[node].child2 = NULL_PROXY;
+    nodes_[node].height = -1;
+    nodes_[node].layers = 0;
+    freeList_ = node;
+}
+
+// ============================================================================
+// Tree edits
+// ============================================================================
+
+void SpatialIndex::insertLeaf(int32_t leaf) {
+    if (root_ == NULL_PROXY) {
+        root_ = leaf;
+        nodes_[leaf].parent = NULL_PROXY;
+        return;
+    }
+
+    // Descend towards the sibling that minimises the added surface area. The
+    // cost of stopping at a node is a new parent there (the combined box) plus
+    // the growth pushed onto every ancestor above it.
+    const glm::vec3 leafMin = nodes_[leaf].min;
+    const glm::vec3 leafMax = nodes_[leaf].max;
+    int32_t index = root_;
+    float inheritedCost = 0.0f;
+    while (!nodes_[index].isLeaf()) {
+        const Node& node = nodes_[index];
+        float area = surfaceArea(node.min, node.max);
+        float combinedArea = unionArea(node.min, node.max, leafMin, leafMax);
+
+        float cost = 2.0f * combinedArea + inheritedCost;
+        float childInherited = inheritedCost + 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int32_t child) {
+            const Node& c = nodes_[child];
+            float grown = unionArea(c.min, c.max, leafMin, leafMax);
+            return c.isLeaf() ? grown + childInherited
+                              : grown - surfaceArea(c.min, c.max) + childInherited;
+        };
+        float cost1 = descendCost(node.child1);
+        float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        inheritedCost = childInherited;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const int32_t sibling = index;
+    const int32_t oldParent = nodes_[sibling].parent;
+    const int32_t newParent = allocateNode();
+    nodes_[newParent].parent = oldParent;
+    nodes_[newParent].child1 = sibling;
+    nodes_[newParent].child2 = leaf;
+    nodes_[sibling].parent = newParent;
+    nodes_[leaf].parent = newParent;
+
+    if (oldParent == NULL_PROXY) {
+        root_ = newParent;
+    } else if (nodes_[oldParent].child1 == sibling) {
+        nodes_[oldParent].child1 = newParent;
+    } else {
+        nodes_[oldParent].child2 = newParent;
+    }
+
+    refit(newParent);
+    refitAncestors(newParent);
+}
+
+void SpatialIndex::removeLeaf(int32_t leaf) {
+    if (leaf == root_) {
+        root_ = NULL_PROXY;
+        return;
+    }
+
+    const int32_t parent = nodes_[leaf].parent;
+    const int32_t grandParent = nodes_[parent].parent;
+    const int32_t sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+    if (grandParent == NULL_PROXY) {
+        root_ = sibling;
+        nodes_[sibling].parent = NULL_PROXY;
+        freeNode(parent);
+        return;
+    }
+
+    if (nodes_[grandParent].child1 == parent) {
+        nodes_[grandParent].child1 = sibling;
+    } else {
+        nodes_[grandParent].child2 = sibling;
+    }
+    nodes_[sibling].parent = grandParent;
+    freeNode(parent);
+    refitAncestors(grandParent);
+}
+
+// Rebalance and refit from node up to the root
+void SpatialIndex::refitAncestors(int32_t node) {
+    while (node != NULL_PROXY) {
+        node = balance(node);
+        refit(node);
+        node = nodes_[node].parent;
+    }
+}
+
+// Box, height and layer mask of an internal node from its children
+void SpatialIndex::refit(int32_t node) {
+    Node& n = nodes_[node];
+    const Node& a = nodes_[n.child1];
+    const Node& b = nodes_[n.child2];
+    n.min = glm::min(a.min, b.min);
+    n.max = glm::max(a.max, b.max);
+    n.height = 1 + std::max(a.height, b.height);
+    n.layers = a.layers | b.layers;
+}
+
+// If one child subtree is more than one level taller than the other, rotate
+// its taller grandchild up. Returns the node now at this position.
+int32_t SpatialIndex::balance(int32_t a) {
+    if (nodes_[a].isLeaf() || nodes_[a].height < 2) return a;
+
+    const int32_t b = nodes_[a].child1;
+    const int32_t c = nodes_[a].child2;
+    const int32_t difference = nodes_[c].height - nodes_[b].height;
+    if (difference >= -1 && difference <= 1) return a;
+
+    // up: the taller child, promoted into a's place; a keeps the shorter child
+    const bool rightHeavy = difference > 1;
+    const int32_t up = rightHeavy ? c : b;
+    const int32_t f = nodes_[up].child1;
+    const int32_t g = nodes_[up].child2;
+
+    nodes_[up].child1 = a;
+    nodes_[up].parent = nodes_[a].parent;
+    nodes_[a].parent = up;
+
+    const int32_t upParent = nodes_[up].parent;
+    if (upParent == NULL_PROXY) {
+        root_ = up;
+    } else if (nodes_[upParent].child1 == a) {
+        nodes_[upParent].child1 = up;
+    } else {
+        nodes_[upParent].child2 = up;
+    }
+
+    // The taller grandchild stays under up; the shorter one replaces up under a
+    const int32_t keep = nodes_[f].height > nodes_[g].height ? f : g;
+    const int32_t give = keep == f ? g : f;
+    nodes_[up].child2 = keep;
+    if (rightHeavy) {
+        nodes_[a].child2 = give;
+    } else {
+        nodes_[a].child1 = give;
+    }
+    nodes_[give].parent = a;
+
+    refit(a);
+    refit(up);
+    return up;
+}
+
+} // namespace ecs
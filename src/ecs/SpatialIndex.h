@@ -0,0 +1,271 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ecs {
+
+/**
+ * SpatialIndex - Dynamic AABB tree (incremental BVH) over axis-aligned boxes
+ *
+ * Each proxy is a leaf holding a "fat" box: the tight box grown by a margin.
+ * update() only re-inserts a proxy once its tight box leaves the fat one, so
+ * objects that move a little each frame cost a containment check, not a tree
+ * edit. Insertion descends by surface-area cost and the tree is kept balanced
+ * by AVL-style rotations, so queries stay O(log n + hits).
+ *
+ * Every proxy carries a layer mask; internal nodes store the union of their
+ * children's masks, so a query for one layer (lights, NPCs) skips subtrees
+ * without any member of that layer.
+ *
+ * Queries report proxies whose fat box passes the test; callers apply the
+ * exact test to their own bounds. Queries are const and keep their traversal
+ * stack on the call stack, so several threads may query concurrently as long
+ * as nothing modifies the tree meanwhile.
+ *
+ * Usage:
+ *   SpatialIndex index;
+ *   int32_t proxy = index.insert(min, max, entityIndex, LAYER_LIGHT);
+ *   index.update(proxy, newMin, newMax);
+ *   index.querySphere(center, radius, LAYER_LIGHT, [&](uint32_t userData) { ... });
+ */
+class SpatialIndex {
+public:
+    static constexpr int32_t NULL_PROXY = -1;
+    static constexpr uint32_t ALL_LAYERS = 0xFFFFFFFFu;
+
+    // margin: how far (world units) a fat box extends past the tight box
+    explicit SpatialIndex(float margin = 0.25f) : margin_(margin) {}
+
+    // ========================================================================
+    // Proxies
+    // ========================================================================
+
+    int32_t insert(const glm::vec3& min, const glm::vec3& max, uint32_t userData,
+                   uint32_t layers = ALL_LAYERS);
+    void remove(int32_t proxy);
+
+    // Move a proxy to a new tight box. Returns true if it had to be
+    // re-inserted (the box left its fat box), false if nothing changed.
+    bool update(int32_t proxy, const glm::vec3& min, const glm::vec3& max);
+
+    // Change a proxy's layer mask (re-inserts it)
+    void setLayers(int32_t proxy, uint32_t layers);
+
+    void clear();
+
+    uint32_t userData(int32_t proxy) const { return nodes_[proxy].userData; }
+    void setUserData(int32_t proxy, uint32_t userData) { nodes_[proxy].userData = userData; }
+    uint32_t layers(int32_t proxy) const { return nodes_[proxy].layers; }
+    const glm::vec3& fatMin(int32_t proxy) const { return nodes_[proxy].min; }
+    const glm::vec3& fatMax(int32_t proxy) const { return nodes_[proxy].max; }
+
+    size_t size() const { return proxyCount_; }
+    bool empty() const { return proxyCount_ == 0; }
+    // Leaf depth of the deepest proxy (0 for a single proxy, -1 when empty)
+    int32_t height() const { return root_ == NULL_PROXY ? -1 : nodes_[root_].height; }
+
+    // ========================================================================
+    // Queries (fat-box tests; fn receives the proxy's userData)
+    // ========================================================================
+
+    // fn(uint32_t userData) for proxies overlapping [min, max]
+    template <typename Fn>
+    void queryAabb(const glm::vec3& min, const glm::vec3& max, uint32_t layerMask, Fn&& fn) const;
+
+    // fn(uint32_t userData) for proxies overlapping the sphere
+    template <typename Fn>
+    void querySphere(const glm::vec3& center, float radius, uint32_t layerMask, Fn&& fn) const;
+
+    // fn(uint32_t userData, bool contained) for proxies not outside the six
+    // inward-facing planes (as in ecs::Frustum). contained is true when the
+    // whole fat box is inside, so the tight bounds need no further test.
+    template <typename Fn>
+    void queryFrustum(const std::array<glm::vec4, 6>& planes, uint32_t layerMask, Fn&& fn) const;
+
+    // fn(uint32_t userData, float maxDistance) -> float for proxies whose fat
+    // box the ray hits within maxDistance, nearest subtrees first. Return the
+    // distance of an exact hit to clip the ray there, maxDistance to keep
+    // going unchanged, or 0 to stop. direction must be normalized.
+    template <typename Fn>
+    void raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                 uint32_t layerMask, Fn&& fn) const;
+
+private:
+    struct Node {
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+        int32_t parent = NULL_PROXY;     // Next free node while on the free list
+        int32_t child1 = NULL_PROXY;
+        int32_t child2 = NULL_PROXY;
+        int32_t height = 0;              // Leaf = 0, free = -1
+        uint32_t userData = 0;
+        uint32_t layers = 0;             // Internal nodes: union of children
+
+        bool isLeaf() const { return child1 == NULL_PROXY; }
+    };
+
+    // Deep enough for any tree the AVL balance allows in 32-bit node indices
+    static constexpr int STACK_CAPACITY = 128;
+
+    int32_t allocateNode();
+    void freeNode(int32_t node);
+    void insertLeaf(int32_t leaf);
+    void removeLeaf(int32_t leaf);
+    int32_t balance(int32_t node);
+    void refitAncestors(int32_t node);
+    void refit(int32_t node);
+
+    std::vector<Node> nodes_;
+    int32_t root_ = NULL_PROXY;
+    int32_t freeList_ = NULL_PROXY;
+    size_t proxyCount_ = 0;
+    float margin_;
+};
+
+// ============================================================================
+// Query templates
+// ============================================================================
+
+template <typename Fn>
+void SpatialIndex::queryAabb(const glm::vec3& min, const glm::vec3& max, uint32_t layerMask, Fn&& fn) const {
+    if (root_ == NULL_PROXY) return;
+    int32_t stack[STACK_CAPACITY];
+    int top = 0;
+    stack[top++] = root_;
+    while (top > 0) {
+        const Node& node = nodes_[stack[--top]];
+        if (!(node.layers & layerMask)) continue;
+        if (node.min.x > max.x || node.max.x < min.x || node.min.y > max.y || node.max.y < min.y ||
+            node.min.z > max.z || node.max.z < min.z) {
+            continue;
+        }
+        if (node.isLeaf()) {
+            fn(node.userData);
+        } else {
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+    }
+}
+
+template <typename Fn>
+void SpatialIndex::querySphere(const glm::vec3& center, float radius, uint32_t layerMask, Fn&& fn) const {
+    if (root_ == NULL_PROXY) return;
+    const float radiusSq = radius * radius;
+    int32_t stack[STACK_CAPACITY];
+    int top = 0;
+    stack[top++] = root_;
+    while (top > 0) {
+        const Node& node = nodes_[stack[--top]];
+        if (!(node.layers & layerMask)) continue;
+        glm::vec3 closest = glm::clamp(center, node.min, node.max);
+        glm::vec3 offset = closest - center;
+        if (glm::dot(offset, offset) > radiusSq) continue;
+        if (node.isLeaf()) {
+            fn(node.userData);
+        } else {
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+    }
+}
+
+template <typename Fn>
+void SpatialIndex::queryFrustum(const std::array<glm::vec4, 6>& planes, uint32_t layerMask, Fn&& fn) const {
+    if (root_ == NULL_PROXY) return;
+    // Sign bit 31 marks a node already known to lie inside every plane
+    constexpr uint32_t CONTAINED = 0x80000000u;
+    uint32_t stack[STACK_CAPACITY];
+    int top = 0;
+    stack[top++] = static_cast<uint32_t>(root_);
+    while (top > 0) {
+        uint32_t item = stack[--top];
+        const Node& node = nodes_[item & ~CONTAINED];
+        if (!(node.layers & layerMask)) continue;
+        bool contained = (item & CONTAINED) != 0;
+
+        if (!contained) {
+            glm::vec3 center = (node.min + node.max) * 0.5f;
+            glm::vec3 extent = (node.max - node.min) * 0.5f;
+            bool outside = false;
+            contained = true;
+            for (const auto& plane : planes) {
+                float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+                float reach = std::abs(plane.x) * extent.x + std::abs(plane.y) * extent.y +
+                              std::abs(plane.z) * extent.z;
+                if (distance + reach < 0.0f) { outside = true; break; }
+                if (distance - reach < 0.0f) contained = false;
+            }
+            if (outside) continue;
+        }
+
+        if (node.isLeaf()) {
+            fn(node.userData, contained);
+        } else {
+            uint32_t flag = contained ? CONTAINED : 0u;
+            stack[top++] = static_cast<uint32_t>(node.child1) | flag;
+            stack[top++] = static_cast<uint32_t>(node.child2) | flag;
+        }
+    }
+}
+
+template <typename Fn>
+void SpatialIndex::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                           uint32_t layerMask, Fn&& fn) const {
+    if (root_ == NULL_PROXY) return;
+    // Axis-parallel rays get a huge finite slope instead of inf * 0 = NaN
+    auto invert = [](float d) { return std::abs(d) > 1e-12f ? 1.0f / d : 1e30f; };
+    const glm::vec3 inverse(invert(direction.x), invert(direction.y), invert(direction.z));
+
+    // Slab test; returns the entry distance or -1 on a miss
+    auto enter = [&](const Node& node, float limit) {
+        glm::vec3 t0 = (node.min - origin) * inverse;
+        glm::vec3 t1 = (node.max - origin) * inverse;
+        glm::vec3 tNear = glm::min(t0, t1);
+        glm::vec3 tFar = glm::max(t0, t1);
+        float entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, limit));
+        return entry <= exit ? entry : -1.0f;
+    };
+
+    int32_t stack[STACK_CAPACITY];
+    int top = 0;
+    if (!(nodes_[root_].layers & layerMask) || enter(nodes_[root_], maxDistance) < 0.0f) return;
+    stack[top++] = root_;
+    while (top > 0) {
+        const Node& node = nodes_[stack[--top]];
+        if (node.isLeaf()) {
+            if (enter(node, maxDistance) < 0.0f) continue;
+            float clip = fn(node.userData, maxDistance);
+            if (clip <= 0.0f) return;
+            maxDistance = std::min(maxDistance, clip);
+            continue;
+        }
+        // Push the farther child first so the nearer one is visited next
+        const Node& a = nodes_[node.child1];
+        const Node& b = nodes_[node.child2];
+        float ta = (a.layers & layerMask) ? enter(a, maxDistance) : -1.0f;
+        float tb = (b.layers & layerMask) ? enter(b, maxDistance) : -1.0f;
+        if (ta >= 0.0f && tb >= 0.0f) {
+            if (ta <= tb) {
+                stack[top++] = node.child2;
+                stack[top++] = node.child1;
+            } else {
+                stack[top++] = node.child1;
+                stack[top++] = node.child2;
+            }
+        } else if (ta >= 0.0f) {
+            stack[top++] = node.child1;
+        } else if (tb >= 0.0f) {
+            stack[top++] = node.child2;
+        }
+    }
+}
+
+} // namespace ecs
@@ -0,0 +1,364 @@
+#include "SpatialSystem.h"
+#include "core/threading/TaskScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ecs {
+namespace systems {
+
+namespace {
+
+using Shape = SpatialEntities::Shape;
+
+// Entries per refresh task
+constexpr size_t CHUNK_SIZE = 4096;
+
+uint32_t entityIndex(Entity entity) {
+    return static_cast<uint32_t>(entt::to_entity(entity));
+}
+
+void onSpatialMembershipChange(entt::registry& registry, Entity entity) {
+    if (auto* spatial = registry.ctx().find<SpatialEntities>()) {
+        spatial->pending.push_back(entity);
+    }
+}
+
+// Shape and layers the entity should be indexed with; false if it shouldn't be
+bool classify(const entt::registry& registry, Entity entity, Shape& shape, uint32_t& layers) {
+    if (!registry.valid(entity) || !registry.all_of<Transform>(entity)) return false;
+
+    const bool sphere = registry.all_of<BoundingSphere>(entity);
+    const bool box = !sphere && registry.all_of<BoundingBox>(entity);
+    const bool light = registry.any_of<PointLightComponent, SpotLightComponent>(entity);
+    const bool npc = registry.all_of<NPCTag>(entity);
+
+    layers = 0;
+    if (sphere || box) layers |= SpatialLayer::Renderable;
+    if (light) layers |= SpatialLayer::Light;
+    if (npc) layers |= SpatialLayer::Npc;
+    if (layers == 0) return false;
+
+    shape = sphere ? Shape::Sphere : box ? Shape::Box : light ? Shape::LightRange : Shape::Point;
+    return true;
+}
+
+template <typename Fn>
+void forEachBoundsColumn(CullBoundsSoA& bounds, Fn&& fn) {
+    for (auto* column : {&bounds.centerX, &bounds.centerY, &bounds.centerZ,
+                         &bounds.extentX, &bounds.extentY, &bounds.extentZ, &bounds.radius}) {
+        fn(*column);
+    }
+}
+
+void addEntry(SpatialEntities& spatial, Entity entity, Shape shape, uint32_t layers) {
+    uint32_t entry = static_cast<uint32_t>(spatial.entities.size());
+    uint32_t index = entityIndex(entity);
+    if (index >= spatial.entryOf.size()) spatial.entryOf.resize(static_cast<size_t>(index) + 1, SpatialEntities::NO_ENTRY);
+    spatial.entryOf[index] = entry;
+
+    spatial.entities.push_back(entity);
+    spatial.shapes.push_back(shape);
+    spatial.layers.push_back(layers);
+    spatial.proxies.push_back(SpatialIndex::NULL_PROXY);
+    spatial.sourceMatrix.emplace_back(1.0f);
+    spatial.sourceMin.emplace_back(0.0f);
+    spatial.sourceMax.emplace_back(0.0f);
+    spatial.sourceValid.push_back(0);     // Bounds and proxy come with the next refresh
+    forEachBoundsColumn(spatial.bounds, [](std::vector<float>& column) { column.push_back(0.0f); });
+}
+
+// Remove an entry by moving the last one into its place
+void removeEntry(SpatialEntities& spatial, uint32_t entry) {
+    if (spatial.proxies[entry] != SpatialIndex::NULL_PROXY) spatial.index.remove(spatial.proxies[entry]);
+    spatial.entryOf[entityIndex(spatial.entities[entry])] = SpatialEntities::NO_ENTRY;
+
+    const uint32_t last = static_cast<uint32_t>(spatial.entities.size() - 1);
+    if (entry != last) {
+        spatial.entities[entry] = spatial.entities[last];
+        spatial.shapes[entry] = spatial.shapes[last];
+        spatial.layers[entry] = spatial.layers[last];
+        spatial.proxies[entry] = spatial.proxies[last];
+        spatial.sourceMatrix[entry] = spatial.sourceMatrix[last];
+        spatial.sourceMin[entry] = spatial.sourceMin[last];
+        spatial.sourceMax[entry] = spatial.sourceMax[last];
+        spatial.sourceValid[entry] = spatial.sourceValid[last];
+        forEachBoundsColumn(spatial.bounds, [&](std::vector<float>& column) { column[entry] = column[last]; });
+
+        spatial.entryOf[entityIndex(spatial.entities[entry])] = entry;
+        if (spatial.proxies[entry] != SpatialIndex::NULL_PROXY) {
+            spatial.index.setUserData(spatial.proxies[entry], entry);
+        }
+    }
+
+    spatial.entities.pop_back();
+    spatial.shapes.pop_back();
+    spatial.layers.pop_back();
+    spatial.proxies.pop_back();
+    spatial.sourceMatrix.pop_back();
+    spatial.sourceMin.pop_back();
+    spatial.sourceMax.pop_back();
+    spatial.sourceValid.pop_back();
+    forEachBoundsColumn(spatial.bounds, [](std::vector<float>& column) { column.pop_back(); });
+}
+
+// Bring each pending entity's entry in line with its current components
+void applyMembershipChanges(const entt::registry& registry, SpatialEntities& spatial) {
+    for (Entity entity : spatial.pending) {
+        uint32_t entry = spatial.findEntry(entity);
+        Shape shape = Shape::Point;
+        uint32_t layers = 0;
+        bool indexed = classify(registry, entity, shape, layers);
+
+        if (!indexed) {
+            if (entry != SpatialEntities::NO_ENTRY) removeEntry(spatial, entry);
+        } else if (entry == SpatialEntities::NO_ENTRY) {
+            addEntry(spatial, entity, shape, layers);
+        } else {
+            if (spatial.shapes[entry] != shape) {
+                spatial.shapes[entry] = shape;
+                spatial.sourceValid[entry] = 0;
+            }
+            if (spatial.layers[entry] != layers) {
+                spatial.layers[entry] = layers;
+                if (spatial.proxies[entry] != SpatialIndex::NULL_PROXY) {
+                    spatial.index.setLayers(spatial.proxies[entry], layers);
+                }
+            }
+        }
+    }
+    spatial.pending.clear();
+}
+
+// Created on first use with its change listeners; every current candidate
+// starts out pending
+SpatialEntities& spatialEntities(World& world) {
+    entt::registry& registry = world.registry();
+    if (auto* spatial = registry.ctx().find<SpatialEntities>()) return *spatial;
+
+    auto& spatial = registry.ctx().emplace<SpatialEntities>();
+    registry.on_construct<Transform>().connect<&onSpatialMembershipChange>();
+    registry.on_destroy<Transform>().connect<&onSpatialMembershipChange>();
+    registry.on_construct<BoundingSphere>().connect<&onSpatialMembershipChange>();
+    registry.on_destroy<BoundingSphere>().connect<&onSpatialMembershipChange>();
+    registry.on_construct<BoundingBox>().connect<&onSpatialMembershipChange>();
+    registry.on_destroy<BoundingBox>().connect<&onSpatialMembershipChange>();
+    registry.on_construct<PointLightComponent>().connect<&onSpatialMembershipChange>();
+    registry.on_destroy<PointLightComponent>().connect<&onSpatialMembershipChange>();
+    registry.on_construct<SpotLightComponent>().connect<&onSpatialMembershipChange>();
+    registry.on_destroy<SpotLightComponent>().connect<&onSpatialMembershipChange>();
+    registry.on_construct<NPCTag>().connect<&onSpatialMembershipChange>();
+    registry.on_destroy<NPCTag>().connect<&onSpatialMembershipChange>();
+
+    for (auto entity : world.view<Transform, BoundingSphere>()) spatial.pending.push_back(entity);
+    for (auto entity : world.view<Transform, BoundingBox>()) spatial.pending.push_back(entity);
+    for (auto entity : world.view<Transform, PointLightComponent>()) spatial.pending.push_back(entity);
+    for (auto entity : world.view<Transform, SpotLightComponent>()) spatial.pending.push_back(entity);
+    for (auto entity : world.view<Transform, NPCTag>()) spatial.pending.push_back(entity);
+    return spatial;
+}
+
+// Component pools, looked up once on the calling thread (a first lookup
+// may create the pool, which workers must not do)
+struct SourcePools {
+    const entt::storage_for_t<Transform>& transforms;
+    const entt::storage_for_t<BoundingSphere>& spheres;
+    const entt::storage_for_t<BoundingBox>& boxes;
+    const entt::storage_for_t<PointLightComponent>& pointLights;
+    const entt::storage_for_t<SpotLightComponent>& spotLights;
+};
+
+// Recompute the world bounds of entries whose Transform or source bounds
+// changed and note them in moved. Reads components only, so chunks can run
+// on any thread.
+void refreshBounds(SpatialEntities& spatial, const SourcePools& pools, size_t begin, size_t end,
+                   std::vector<uint32_t>& moved) {
+    for (size_t entry = begin; entry < end; ++entry) {
+        Entity entity = spatial.entities[entry];
+        const glm::mat4& matrix = pools.transforms.get(entity).matrix;
+        glm::vec3 min(0.0f), max(0.0f);
+        switch (spatial.shapes[entry]) {
+            case Shape::Sphere: {
+                const auto& sphere = pools.spheres.get(entity);
+                min = sphere.center;
+                max.x = sphere.radius;
+                break;
+            }
+            case Shape::Box: {
+                const auto& box = pools.boxes.get(entity);
+                min = box.min;
+                max = box.max;
+                break;
+            }
+            case Shape::LightRange:
+                max.x = pools.pointLights.contains(entity) ? pools.pointLights.get(entity).radius
+                                                           : pools.spotLights.get(entity).radius;
+                break;
+            case Shape::Point:
+                break;
+        }
+
+        if (spatial.sourceValid[entry] && spatial.sourceMatrix[entry] == matrix &&
+            spatial.sourceMin[entry] == min && spatial.sourceMax[entry] == max) {
+            continue;
+        }
+
+        if (spatial.shapes[entry] == Shape::Box) {
+            spatial.bounds.setBox(entry, matrix, min, max);
+        } else {
+            spatial.bounds.setSphere(entry, matrix, min, max.x);
+        }
+        spatial.sourceMatrix[entry] = matrix;
+        spatial.sourceMin[entry] = min;
+        spatial.sourceMax[entry] = max;
+        spatial.sourceValid[entry] = 1;
+        moved.push_back(static_cast<uint32_t>(entry));
+    }
+}
+
+// Distance along the ray to the entry's exact bounds, or -1 on a miss
+float rayHitDistance(const SpatialEntities& spatial, uint32_t entry,
+                     const glm::vec3& origin, const glm::vec3& direction) {
+    const CullBoundsSoA& b = spatial.bounds;
+    glm::vec3 center(b.centerX[entry], b.centerY[entry], b.centerZ[entry]);
+
+    if (b.radius[entry] > 0.0f) {
+        glm::vec3 offset = origin - center;
+        float along = glm::dot(offset, direction);
+        float c = glm::dot(offset, offset) - b.radius[entry] * b.radius[entry];
+        if (c > 0.0f && along > 0.0f) return -1.0f;
+        float discriminant = along * along - c;
+        if (discriminant < 0.0f) return -1.0f;
+        return std::max(0.0f, -along - std::sqrt(discriminant));
+    }
+
+    glm::vec3 extent(b.extentX[entry], b.extentY[entry], b.extentZ[entry]);
+    if (extent.x <= 0.0f && extent.y <= 0.0f && extent.z <= 0.0f) return -1.0f;
+    float entryT = 0.0f;
+    float exitT = std::numeric_limits<float>::max();
+    for (int axis = 0; axis < 3; ++axis) {
+        float lo = center[axis] - extent[axis] - origin[axis];
+        float hi = center[axis] + extent[axis] - origin[axis];
+        if (std::abs(direction[axis]) < 1e-12f) {
+            if (lo > 0.0f || hi < 0.0f) return -1.0f;
+            continue;
+        }
+        float t0 = lo / direction[axis];
+        float t1 = hi / direction[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        entryT = std::max(entryT, t0);
+        exitT = std::min(exitT, t1);
+        if (entryT > exitT) return -1.0f;
+    }
+    return entryT;
+}
+
+} // namespace
+
+SpatialEntities& updateSpatialIndex(World& world) {
+    SpatialEntities& spatial = spatialEntities(world);
+    entt::registry& registry = world.registry();
+    applyMembershipChanges(registry, spatial);
+
+    const size_t count = spatial.entities.size();
+    if (count == 0) return spatial;
+
+    const SourcePools pools{registry.storage<Transform>(), registry.storage<BoundingSphere>(),
+                            registry.storage<BoundingBox>(), registry.storage<PointLightComponent>(),
+                            registry.storage<SpotLightComponent>()};
+
+    // Refresh in chunks across workers; small worlds stay inline
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    const size_t chunkCount = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    spatial.moved.resize(chunkCount);
+    for (auto& moved : spatial.moved) moved.clear();
+    if (chunkCount > 1 && scheduler.getThreadCount() > 0) {
+        TaskGroup group;
+        for (size_t chunk = 1; chunk < chunkCount; ++chunk) {
+            size_t begin = chunk * CHUNK_SIZE;
+            size_t end = std::min(count, begin + CHUNK_SIZE);
+            scheduler.submit([&spatial, &pools, chunk, begin, end] {
+                refreshBounds(spatial, pools, begin, end, spatial.moved[chunk]);
+            }, &group, TaskScheduler::Priority::High);
+        }
+        refreshBounds(spatial, pools, 0, std::min(count, CHUNK_SIZE), spatial.moved[0]);
+        group.wait();
+    } else {
+        refreshBounds(spatial, pools, 0, count, spatial.moved[0]);
+    }
+
+    // Tree edits stay on this thread; most moves stay inside their fat box
+    for (const auto& moved : spatial.moved) {
+        for (uint32_t entry : moved) {
+            glm::vec3 min = spatial.worldMin(entry);
+            glm::vec3 max = spatial.worldMax(entry);
+            if (spatial.proxies[entry] == SpatialIndex::NULL_PROXY) {
+                spatial.proxies[entry] = spatial.index.insert(min, max, entry, spatial.layers[entry]);
+            } else {
+                spatial.index.update(spatial.proxies[entry], min, max);
+            }
+        }
+    }
+    return spatial;
+}
+
+const SpatialEntities* findSpatialIndex(const World& world) {
+    return world.registry().ctx().find<SpatialEntities>();
+}
+
+void queryEntitiesInSphere(const World& world, const glm::vec3& center, float radius,
+                           uint32_t layerMask, std::vector<Entity>& out) {
+    const SpatialEntities* spatial = findSpatialIndex(world);
+    if (!spatial) return;
+    const CullBoundsSoA& b = spatial->bounds;
+    spatial->index.querySphere(center, radius, layerMask, [&](uint32_t entry) {
+        // Sphere-vs-sphere or sphere-vs-box on the tight world bounds
+        glm::vec3 gap(std::max(std::abs(center.x - b.centerX[entry]) - b.extentX[entry], 0.0f),
+                      std::max(std::abs(center.y - b.centerY[entry]) - b.extentY[entry], 0.0f),
+                      std::max(std::abs(center.z - b.centerZ[entry]) - b.extentZ[entry], 0.0f));
+        float reach = radius + b.radius[entry];
+        if (glm::dot(gap, gap) <= reach * reach && world.valid(spatial->entities[entry])) {
+            out.push_back(spatial->entities[entry]);
+        }
+    });
+}
+
+void queryEntitiesInFrustum(const World& world, const Frustum& frustum,
+                            uint32_t layerMask, std::vector<Entity>& out) {
+    const SpatialEntities* spatial = findSpatialIndex(world);
+    if (!spatial) return;
+    std::vector<uint32_t> straddling;
+    spatial->index.queryFrustum(frustum.planes, layerMask, [&](uint32_t entry, bool contained) {
+        if (!contained) {
+            straddling.push_back(entry);
+        } else if (world.valid(spatial->entities[entry])) {
+            out.push_back(spatial->entities[entry]);
+        }
+    });
+    size_t kept = cullBoundsList(frustum.planes, spatial->bounds, straddling.data(), straddling.size());
+    for (size_t i = 0; i < kept; ++i) {
+        Entity entity = spatial->entities[straddling[i]];
+        if (world.valid(entity)) out.push_back(entity);
+    }
+}
+
+Entity raycastEntities(const World& world, const glm::vec3& origin, const glm::vec3& direction,
+                       float maxDistance, uint32_t layerMask, float* hitDistance) {
+    const SpatialEntities* spatial = findSpatialIndex(world);
+    if (!spatial) return NullEntity;
+    Entity nearest = NullEntity;
+    float nearestDistance = maxDistance;
+    spatial->index.raycast(origin, direction, maxDistance, layerMask, [&](uint32_t entry, float limit) {
+        float distance = rayHitDistance(*spatial, entry, origin, direction);
+        if (distance < 0.0f || distance > limit || !world.valid(spatial->entities[entry])) return limit;
+        nearest = spatial->entities[entry];
+        nearestDistance = distance;
+        // Clip the ray just past the hit (a zero clip would stop the query)
+        return std::max(distance, std::numeric_limits<float>::min());
+    });
+    if (nearest != NullEntity && hitDistance) *hitDistance = nearestDistance;
+    return nearest;
+}
+
+} // namespace systems
+} // namespace ecs
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Systems.h"
+#include "BoundsCulling.h"
+#include "SpatialIndex.h"
+#include <vector>
+
+namespace ecs {
+
+// =============================================================================
+// Spatial Index System
+// =============================================================================
+// Keeps every placed entity (Transform plus bounds, a light or an NPC tag) in
+// a dynamic AABB tree so culling, light gathering and gameplay proximity
+// queries visit only nearby entities instead of scanning the whole world.
+//
+// Per frame, after updateWorldTransforms():
+//   systems::updateSpatialIndex(world);
+// then any number of updateVisibility / buildLightBuffer / query calls.
+
+// Layer bits of spatial index proxies; queries pass a mask of these
+namespace SpatialLayer {
+constexpr uint32_t Renderable = 1u << 0;   // BoundingSphere or BoundingBox
+constexpr uint32_t Light = 1u << 1;        // PointLightComponent or SpotLightComponent
+constexpr uint32_t Npc = 1u << 2;          // NPCTag
+constexpr uint32_t All = SpatialIndex::ALL_LAYERS;
+}
+
+/**
+ * Registry context entry behind the spatial index, one entry per indexed
+ * entity. Entries are dense (removal moves the last entry into the hole), so
+ * refresh passes run over flat arrays.
+ *
+ * An entry's bounds come from its BoundingSphere (preferred) or BoundingBox;
+ * lights without either use their falloff radius and NPCs a point at their
+ * origin. World bounds are cached in SoA form and recomputed only when the
+ * Transform matrix or the source bounds differ from last time.
+ */
+struct SpatialEntities {
+    static constexpr uint32_t NO_ENTRY = 0xFFFFFFFFu;
+
+    enum class Shape : uint8_t { Sphere, Box, LightRange, Point };
+
+    std::vector<Entity> entities;
+    std::vector<uint32_t> entryOf;        // Indexed by entity index
+    std::vector<Shape> shapes;
+    std::vector<uint32_t> layers;
+    std::vector<int32_t> proxies;         // SpatialIndex proxy (userData = entry)
+
+    // What the world bounds were computed from
+    std::vector<glm::mat4> sourceMatrix;
+    std::vector<glm::vec3> sourceMin;     // Sphere: center
+    std::vector<glm::vec3> sourceMax;     // Sphere: (radius, 0, 0)
+    std::vector<uint8_t> sourceValid;
+
+    CullBoundsSoA bounds;
+    SpatialIndex index;
+
+    std::vector<Entity> pending;          // Membership may have changed
+    std::vector<std::vector<uint32_t>> moved;   // Per refresh chunk
+
+    // Entry of an entity, or NO_ENTRY if it isn't indexed
+    uint32_t findEntry(Entity entity) const {
+        uint32_t index = static_cast<uint32_t>(entt::to_entity(entity));
+        if (index >= entryOf.size()) return NO_ENTRY;
+        uint32_t entry = entryOf[index];
+        return entry != NO_ENTRY && entities[entry] == entity ? entry : NO_ENTRY;
+    }
+
+    // Tight world AABB of an entry
+    glm::vec3 worldMin(uint32_t entry) const {
+        return glm::vec3(bounds.centerX[entry] - bounds.extentX[entry] - bounds.radius[entry],
+                         bounds.centerY[entry] - bounds.extentY[entry] - bounds.radius[entry],
+                         bounds.centerZ[entry] - bounds.extentZ[entry] - bounds.radius[entry]);
+    }
+    glm::vec3 worldMax(uint32_t entry) const {
+        return glm::vec3(bounds.centerX[entry] + bounds.extentX[entry] + bounds.radius[entry],
+                         bounds.centerY[entry] + bounds.extentY[entry] + bounds.radius[entry],
+                         bounds.centerZ[entry] + bounds.extentZ[entry] + bounds.radius[entry]);
+    }
+};
+
+namespace systems {
+
+// Apply membership changes since the last call, refresh the world bounds of
+// entities that moved (in TaskScheduler chunks) and move their proxies.
+// Queries below see the world as of the last call.
+SpatialEntities& updateSpatialIndex(World& world);
+
+// The index as of the last updateSpatialIndex(), or nullptr before the first
+[[nodiscard]] const SpatialEntities* findSpatialIndex(const World& world);
+
+// Entities of the given layers whose world bounds touch the sphere
+void queryEntitiesInSphere(const World& world, const glm::vec3& center, float radius,
+                           uint32_t layerMask, std::vector<Entity>& out);
+
+// Entities of the given layers whose world bounds are not outside the frustum
+void queryEntitiesInFrustum(const World& world, const Frustum& frustum,
+                            uint32_t layerMask, std::vector<Entity>& out);
+
+// Nearest entity of the given layers whose world bounds the ray hits within
+// maxDistance (point entries are never hit). direction must be normalized.
+// Returns NullEntity on a miss.
+[[nodiscard]] Entity raycastEntities(const World& world, const glm::vec3& origin, const glm::vec3& direction,
+                                     float maxDistance, uint32_t layerMask, float* hitDistance = nullptr);
+
+} // namespace systems
+} // namespace ecs
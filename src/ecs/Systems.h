@@ -2,8 +2,10 @@
 
 #include "World.h"
 #include "Components.h"
+#include "scene/FlatHierarchy.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
 #include <array>
 
 namespace ecs {
@@ -174,69 +176,149 @@ inline void updateBoneAttachmentsWithLocalOffset(World& world,
 // =============================================================================
 // Updates world Transform components from LocalTransform and Parent hierarchy.
 // Must be called before visibility culling or any system that reads Transform.
+//
+// Entities with LocalTransform are kept in a FlatHierarchy stored in the
+// registry context, in parent-before-child order, so the update is one pass
+// without sorting. Parent add/remove and attachToParent/detachFromParent move
+// subtrees in place, each an O(n) FlatHierarchy edit; past
+// MAX_IN_PLACE_RELINKS of those between updates, and whenever LocalTransform
+// is added or removed (spawning, destroying), the order is instead rebuilt
+// once, in O(n), at the next update.
+//
+// Only dirty subtrees are recomputed. Write LocalTransform through
+// World::patch() (or registry.patch()) so on_update marks the entity's
+// subtree dirty; a plain get<LocalTransform>() write goes unseen.
+
+// Registry context entry holding the traversal order. Node ids are entity indices.
+struct TransformOrder {
+    // In-place reparents per update before falling back to one rebuild
+    static constexpr uint32_t MAX_IN_PLACE_RELINKS = 16;
+
+    FlatHierarchy flat;
+    std::vector<Entity> entities;   // Indexed by node id
+    // Parented roots whose world builds on a Transform outside the order (a
+    // parent without LocalTransform, or their own bone-driven Transform).
+    // Those carry no change tracking, so they are re-dirtied every update.
+    std::vector<uint32_t> externalRoots;
+    uint32_t relinksSinceUpdate = 0;
+    bool stale = true;
+};
 
-// Update world transforms for all entities with LocalTransform + Parent
-// Processes in depth order (roots first, then children)
-inline void updateWorldTransforms(World& world) {
-    // First pass: Update root entities (LocalTransform but no Parent)
-    // These entities use LocalTransform directly as their world transform
-    for (auto [entity, local, transform] :
-         world.view<LocalTransform, Transform>(entt::exclude<Parent>).each()) {
-        transform.matrix = local.toMatrix();
-    }
-
-    // Second pass: Update entities with parents
-    // We need to process in depth order, so collect and sort by depth
-    struct EntityDepth {
-        Entity entity;
-        uint16_t depth;
-    };
-    std::vector<EntityDepth> hierarchyEntities;
-
-    for (auto [entity, local, parent] :
-         world.view<LocalTransform, Parent>().each()) {
-        uint16_t depth = 1;
-        if (world.has<HierarchyDepth>(entity)) {
-            depth = world.get<HierarchyDepth>(entity).depth;
-        }
-        hierarchyEntities.push_back({entity, depth});
+inline uint32_t transformNodeId(Entity entity) {
+    return static_cast<uint32_t>(entt::to_entity(entity));
+}
+
+// The node's parent in the order. Parents without LocalTransform stay outside
+// it, and bone-attached entities take their Transform from the skeleton, not
+// the parent; both are roots here
+inline uint32_t transformParentId(const entt::registry& registry, Entity entity, Entity parent) {
+    if (parent == NullEntity || !registry.valid(parent) || !registry.all_of<LocalTransform>(parent) ||
+        registry.all_of<BoneAttachment, Transform>(entity)) {
+        return FlatHierarchy::NONE;
     }
+    return transformNodeId(parent);
+}
 
-    // Sort by depth (parents processed before children)
-    std::sort(hierarchyEntities.begin(), hierarchyEntities.end(),
-              [](const EntityDepth& a, const EntityDepth& b) {
-                  return a.depth < b.depth;
-              });
+// Re-derive the child's place in the order from its Parent component
+inline void relinkTransformParent(entt::registry& registry, Entity child, Entity parent) {
+    auto* order = registry.ctx().find<TransformOrder>();
+    if (!order || order->stale) return;
 
-    // Process in depth order
-    for (const auto& ed : hierarchyEntities) {
-        Entity entity = ed.entity;
+    uint32_t id = transformNodeId(child);
+    if (!order->flat.contains(id)) return;
+    if (++order->relinksSinceUpdate > TransformOrder::MAX_IN_PLACE_RELINKS) {
+        order->stale = true;  // A burst: one rebuild beats many O(n) moves
+        return;
+    }
 
-        if (!world.has<LocalTransform>(entity) || !world.has<Parent>(entity)) {
-            continue;
-        }
+    uint32_t parentId = transformParentId(registry, child, parent);
+    auto& external = order->externalRoots;
+    external.erase(std::remove(external.begin(), external.end(), id), external.end());
+    if (parent != NullEntity && parentId == FlatHierarchy::NONE) {
+        external.push_back(id);
+    }
+    if (!order->flat.setParent(id, parentId)) {
+        order->stale = true;  // Cycle: let the rebuild break it
+    }
+}
 
-        const auto& local = world.get<LocalTransform>(entity);
-        const auto& parent = world.get<Parent>(entity);
+inline void onTransformParentConstruct(entt::registry& registry, Entity entity) {
+    relinkTransformParent(registry, entity, registry.get<Parent>(entity).entity);
+}
 
-        // Get parent's world transform
-        glm::mat4 parentWorld = glm::mat4(1.0f);
-        if (parent.valid() && world.valid(parent.entity) &&
-            world.has<Transform>(parent.entity)) {
-            parentWorld = world.get<Transform>(parent.entity).matrix;
-        }
+inline void onTransformParentDestroy(entt::registry& registry, Entity entity) {
+    relinkTransformParent(registry, entity, NullEntity);
+}
+
+inline void onTransformMembershipChange(entt::registry& registry, Entity) {
+    if (auto* order = registry.ctx().find<TransformOrder>()) {
+        order->stale = true;
+    }
+}
+
+// Transform and BoneAttachment decide whether a member is bone-driven
+inline void onTransformRoleChange(entt::registry& registry, Entity entity) {
+    if (registry.all_of<LocalTransform>(entity)) {
+        onTransformMembershipChange(registry, entity);
+    }
+}
 
-        // Skip entities driven by bone attachments (their Transform is set by updateBoneAttachments)
-        if (world.has<BoneAttachment>(entity)) continue;
+inline void onLocalTransformUpdate(entt::registry& registry, Entity entity) {
+    auto* order = registry.ctx().find<TransformOrder>();
+    if (order && !order->stale) {
+        order->flat.markDirty(transformNodeId(entity));
+    }
+}
 
-        // Compute world transform: parent * local
-        if (world.has<Transform>(entity)) {
-            world.get<Transform>(entity).matrix = parentWorld * local.toMatrix();
+// The world's transform order, created (with its change listeners) on first
+// use and rebuilt here if membership changed since the last call
+inline TransformOrder& transformOrder(World& world) {
+    entt::registry& registry = world.registry();
+    auto* order = registry.ctx().find<TransformOrder>();
+    if (!order) {
+        order = &registry.ctx().emplace<TransformOrder>();
+        registry.on_construct<Parent>().connect<&onTransformParentConstruct>();
+        registry.on_destroy<Parent>().connect<&onTransformParentDestroy>();
+        registry.on_construct<LocalTransform>().connect<&onTransformMembershipChange>();
+        registry.on_destroy<LocalTransform>().connect<&onTransformMembershipChange>();
+        registry.on_update<LocalTransform>().connect<&onLocalTransformUpdate>();
+        registry.on_construct<Transform>().connect<&onTransformRoleChange>();
+        registry.on_destroy<Transform>().connect<&onTransformRoleChange>();
+        registry.on_construct<BoneAttachment>().connect<&onTransformRoleChange>();
+        registry.on_destroy<BoneAttachment>().connect<&onTransformRoleChange>();
+    }
+
+    if (order->stale) {
+        std::vector<std::pair<uint32_t, uint32_t>> nodes;
+        order->externalRoots.clear();
+        for (auto entity : world.view<LocalTransform>()) {
+            uint32_t id = transformNodeId(entity);
+            const auto* parent = world.tryGet<Parent>(entity);
+            Entity parentEntity = parent ? parent->entity : NullEntity;
+            uint32_t parentId = transformParentId(registry, entity, parentEntity);
+            if (parentEntity != NullEntity && parentId == FlatHierarchy::NONE) {
+                order->externalRoots.push_back(id);
+            }
+            nodes.emplace_back(id, parentId);
+            if (id >= order->entities.size()) order->entities.resize(static_cast<size_t>(id) + 1, NullEntity);
+            order->entities[id] = entity;
         }
+        order->flat.rebuild(nodes);  // Leaves every node dirty
+        order->stale = false;
     }
+    order->relinksSinceUpdate = 0;
+    return *order;
 }
 
-// Compute and cache hierarchy depths for efficient sorting
+// Update world transforms for entities whose LocalTransform (or an ancestor's)
+// changed since the last call. Walks the stored order, so parents are always
+// computed before children; large worlds split it into partition() runs of
+// whole root subtrees on TaskScheduler workers.
+// Implemented in TransformSystem.cpp.
+void updateWorldTransforms(World& world);
+
+// Compute and cache hierarchy depths (HierarchyDepth is informational;
+// updateWorldTransforms orders by the stored hierarchy instead)
 // Call this after hierarchy changes (attach/detach operations)
 inline void updateHierarchyDepths(World& world) {
     // First, set depth 0 for all root entities (no parent)
@@ -301,6 +383,7 @@ inline void attachToParent(World& world, Entity child, Entity parent) {
             world.get<Children>(oldParent).remove(child);
         }
         world.get<Parent>(child).entity = parent;
+        relinkTransformParent(world.registry(), child, parent);
     } else {
         world.add<Parent>(child, parent);
     }
@@ -347,9 +430,10 @@ inline void detachFromParent(World& world, Entity child) {
         // The current world transform becomes the local transform
         // (simplified - doesn't decompose TRS, just copies matrix)
         const auto& worldTransform = world.get<Transform>(child);
-        auto& local = world.get<LocalTransform>(child);
-        local.position = worldTransform.position();
-        // Note: rotation and scale would need proper decomposition for accuracy
+        world.patch<LocalTransform>(child, [&](LocalTransform& local) {
+            local.position = worldTransform.position();
+            // Note: rotation and scale would need proper decomposition for accuracy
+        });
     }
 
     // Update hierarchy depths
@@ -360,70 +444,14 @@ inline void detachFromParent(World& world, Entity child) {
 // Visibility Culling System
 // =============================================================================
 
-// CPU-based frustum culling using bounding spheres
+// CPU-based frustum culling using BoundingSphere (or BoundingBox)
 // Adds/removes Visible tag component based on frustum test
-inline void updateVisibility(World& world, const Frustum& frustum) {
-    // Process entities with bounding spheres
-    for (auto [entity, transform, bounds] :
-         world.view<Transform, BoundingSphere>().each()) {
-
-        // Transform bounds center to world space
-        glm::vec3 worldCenter = glm::vec3(transform.matrix * glm::vec4(bounds.center, 1.0f));
-
-        // Approximate scale from transform matrix for radius
-        float scaleX = glm::length(glm::vec3(transform.matrix[0]));
-        float scaleY = glm::length(glm::vec3(transform.matrix[1]));
-        float scaleZ = glm::length(glm::vec3(transform.matrix[2]));
-        float maxScale = glm::max(scaleX, glm::max(scaleY, scaleZ));
-        float worldRadius = bounds.radius * maxScale;
-
-        if (frustum.containsSphere(worldCenter, worldRadius)) {
-            if (!world.has<Visible>(entity)) {
-                world.add<Visible>(entity);
-            }
-        } else {
-            if (world.has<Visible>(entity)) {
-                world.remove<Visible>(entity);
-            }
-        }
-    }
-
-    // Process entities with bounding boxes (that don't have spheres)
-    for (auto [entity, transform, bounds] :
-         world.view<Transform, BoundingBox>(entt::exclude<BoundingSphere>).each()) {
-
-        // Transform AABB to world space (approximate - uses transformed corners)
-        glm::vec3 corners[8] = {
-            glm::vec3(bounds.min.x, bounds.min.y, bounds.min.z),
-            glm::vec3(bounds.max.x, bounds.min.y, bounds.min.z),
-            glm::vec3(bounds.min.x, bounds.max.y, bounds.min.z),
-            glm::vec3(bounds.max.x, bounds.max.y, bounds.min.z),
-            glm::vec3(bounds.min.x, bounds.min.y, bounds.max.z),
-            glm::vec3(bounds.max.x, bounds.min.y, bounds.max.z),
-            glm::vec3(bounds.min.x, bounds.max.y, bounds.max.z),
-            glm::vec3(bounds.max.x, bounds.max.y, bounds.max.z)
-        };
-
-        glm::vec3 worldMin(std::numeric_limits<float>::max());
-        glm::vec3 worldMax(std::numeric_limits<float>::lowest());
-
-        for (const auto& corner : corners) {
-            glm::vec3 worldCorner = glm::vec3(transform.matrix * glm::vec4(corner, 1.0f));
-            worldMin = glm::min(worldMin, worldCorner);
-            worldMax = glm::max(worldMax, worldCorner);
-        }
-
-        if (frustum.containsAABB(worldMin, worldMax)) {
-            if (!world.has<Visible>(entity)) {
-                world.add<Visible>(entity);
-            }
-        } else {
-            if (world.has<Visible>(entity)) {
-                world.remove<Visible>(entity);
-            }
-        }
-    }
-}
+// Implemented in VisibilitySystem.cpp on top of the spatial index (see
+// SpatialSystem.h; call updateSpatialIndex() first each frame). Subtrees fully
+// inside the frustum are accepted whole, entities straddling a plane get the
+// SSE2 bounds test, and Visible tags are added/removed in batches for
+// entities that flipped.
+void updateVisibility(World& world, const Frustum& frustum);
 
 // LOD system - updates LOD levels based on distance from camera
 inline void updateLOD(World& world, const glm::vec3& cameraPos) {
@@ -0,0 +1,77 @@
+#include "Systems.h"
+#include "core/threading/TaskScheduler.h"
+
+namespace ecs {
+namespace systems {
+
+namespace {
+
+// Below this many nodes the pass stays on the calling thread
+constexpr size_t PARALLEL_MIN_NODES = 4096;
+
+} // namespace
+
+void updateWorldTransforms(World& world) {
+    TransformOrder& order = transformOrder(world);
+    FlatHierarchy& flat = order.flat;
+    const uint32_t count = static_cast<uint32_t>(flat.size());
+    if (count == 0) return;
+
+    for (uint32_t id : order.externalRoots) {
+        flat.markDirty(id);
+    }
+
+    entt::registry& registry = world.registry();
+    const std::vector<Entity>& entities = order.entities;
+    auto& locals = registry.storage<LocalTransform>();
+    auto& transforms = registry.storage<Transform>();
+    auto& parents = registry.storage<Parent>();
+    auto& boneAttachments = registry.storage<BoneAttachment>();
+
+    // Reads only the node's own components and Transforms outside the order,
+    // so it is safe on any worker
+    auto localMatrix = [&](uint32_t id) -> glm::mat4 {
+        Entity entity = entities[id];
+        if (!parents.contains(entity) || flat.parentOf(id) != FlatHierarchy::NONE) {
+            return locals.get(entity).toMatrix();
+        }
+
+        // Parented root: bone attachments keep the Transform set by
+        // updateBoneAttachments; others build on their parent's Transform
+        if (boneAttachments.contains(entity) && transforms.contains(entity)) {
+            return transforms.get(entity).matrix;
+        }
+        glm::mat4 local = locals.get(entity).toMatrix();
+        Entity parent = parents.get(entity).entity;
+        return (parent != NullEntity && registry.valid(parent) && transforms.contains(parent))
+            ? transforms.get(parent).matrix * local
+            : local;
+    };
+    auto writeTransform = [&](uint32_t id, const glm::mat4& worldMatrix) {
+        Entity entity = entities[id];
+        if (transforms.contains(entity)) {
+            transforms.get(entity).matrix = worldMatrix;
+        }
+    };
+
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    if (count < PARALLEL_MIN_NODES || scheduler.getThreadCount() == 0) {
+        flat.update(FlatHierarchy::Range{0, count}, localMatrix, writeTransform);
+        return;
+    }
+
+    // Root subtrees never read each other's matrices, so the runs are
+    // independent; this thread takes the first one
+    std::vector<FlatHierarchy::Range> ranges = flat.partition(scheduler.getThreadCount() + 1);
+    TaskGroup group;
+    for (size_t i = 1; i < ranges.size(); ++i) {
+        scheduler.submit([&flat, &localMatrix, &writeTransform, range = ranges[i]] {
+            flat.update(range, localMatrix, writeTransform);
+        }, &group, TaskScheduler::Priority::High);
+    }
+    flat.update(ranges[0], localMatrix, writeTransform);
+    group.wait();
+}
+
+} // namespace systems
+} // namespace ecs
@@ -0,0 +1,110 @@
+#include "Systems.h"
+#include "SpatialSystem.h"
+#include "BoundsCulling.h"
+#include <algorithm>
+
+namespace ecs {
+namespace systems {
+
+namespace {
+
+// Registry context entry: visibility bits per entity index
+struct VisibilityCache {
+    std::vector<uint64_t> visible;          // This frame's result
+    std::vector<uint64_t> tagged;           // Which entities carry Visible
+    std::vector<uint32_t> straddling;       // Entries to test exactly this frame
+};
+
+uint32_t entityIndex(Entity entity) {
+    return static_cast<uint32_t>(entt::to_entity(entity));
+}
+
+void setBit(std::vector<uint64_t>& bits, uint32_t index) {
+    if (index / 64 >= bits.size()) bits.resize(index / 64 + 1, 0);
+    bits[index / 64] |= uint64_t(1) << (index % 64);
+}
+
+// Keep the tagged bits in step with Visible changes made elsewhere (editor,
+// entity factories), so the batch below only touches entities that differ
+void onVisibleConstruct(entt::registry& registry, Entity entity) {
+    if (auto* cache = registry.ctx().find<VisibilityCache>()) setBit(cache->tagged, entityIndex(entity));
+}
+
+void onVisibleDestroy(entt::registry& registry, Entity entity) {
+    auto* cache = registry.ctx().find<VisibilityCache>();
+    uint32_t index = entityIndex(entity);
+    if (cache && index / 64 < cache->tagged.size()) {
+        cache->tagged[index / 64] &= ~(uint64_t(1) << (index % 64));
+    }
+}
+
+VisibilityCache& visibilityCache(World& world) {
+    entt::registry& registry = world.registry();
+    if (auto* cache = registry.ctx().find<VisibilityCache>()) return *cache;
+
+    auto& cache = registry.ctx().emplace<VisibilityCache>();
+    registry.on_construct<Visible>().connect<&onVisibleConstruct>();
+    registry.on_destroy<Visible>().connect<&onVisibleDestroy>();
+    for (auto entity : world.view<Visible>()) setBit(cache.tagged, entityIndex(entity));
+    return cache;
+}
+
+} // namespace
+
+void updateVisibility(World& world, const Frustum& frustum) {
+    VisibilityCache& cache = visibilityCache(world);
+    const SpatialEntities* spatial = findSpatialIndex(world);
+    if (!spatial) return;
+    entt::registry& registry = world.registry();
+
+    // Subtrees wholly inside the frustum are visible without a per-entity
+    // test; entries straddling a plane get the exact SoA test
+    const size_t wordCount = cullWordCount(spatial->entryOf.size());
+    cache.visible.assign(wordCount, 0);
+    cache.straddling.clear();
+    spatial->index.queryFrustum(frustum.planes, SpatialLayer::Renderable, [&](uint32_t entry, bool contained) {
+        if (contained) {
+            setBit(cache.visible, entityIndex(spatial->entities[entry]));
+        } else {
+            cache.straddling.push_back(entry);
+        }
+    });
+    size_t kept = cullBoundsList(frustum.planes, spatial->bounds, cache.straddling.data(), cache.straddling.size());
+    for (size_t i = 0; i < kept; ++i) {
+        setBit(cache.visible, entityIndex(spatial->entities[cache.straddling[i]]));
+    }
+    if (cache.tagged.size() < wordCount) cache.tagged.resize(wordCount, 0);
+
+    // Tag changes batched: only entities whose bit flipped touch the Visible
+    // pool. Tagged entities outside the index (no bounds) are left alone,
+    // including those past the end of entryOf in the last word.
+    const size_t indexedCount = spatial->entryOf.size();
+    std::vector<Entity> becameVisible;
+    std::vector<Entity> becameHidden;
+    for (size_t word = 0; word < wordCount; ++word) {
+        uint64_t changed = cache.visible[word] ^ cache.tagged[word];
+        size_t tail = indexedCount - word * 64;
+        if (tail < 64) changed &= (uint64_t(1) << tail) - 1;
+        for (size_t bit = 0; changed != 0; ++bit, changed >>= 1) {
+            if (!(changed & 1)) continue;
+            uint32_t entry = spatial->entryOf[word * 64 + bit];
+            if (entry == SpatialEntities::NO_ENTRY || !(spatial->layers[entry] & SpatialLayer::Renderable)) continue;
+            Entity entity = spatial->entities[entry];
+            if (!registry.valid(entity)) continue;
+            if (cache.visible[word] & (uint64_t(1) << bit)) {
+                becameVisible.push_back(entity);
+            } else {
+                becameHidden.push_back(entity);
+            }
+        }
+    }
+    if (!becameVisible.empty()) {
+        registry.insert<Visible>(becameVisible.begin(), becameVisible.end());
+    }
+    if (!becameHidden.empty()) {
+        registry.remove<Visible>(becameHidden.begin(), becameHidden.end());
+    }
+}
+
+} // namespace systems
+} // namespace ecs
@@ -82,6 +82,13 @@ public:
         return registry_.try_get<Component>(entity);
     }
 
+    // Modify a component in place and notify its on_update listeners
+    // (e.g. LocalTransform edits dirty the transform hierarchy)
+    template<typename Component, typename... Func>
+    decltype(auto) patch(Entity entity, Func&&... func) {
+        return registry_.patch<Component>(entity, std::forward<Func>(func)...);
+    }
+
     // Query interface - returns a view that can be iterated
     template<typename... Components>
     [[nodiscard]] auto view() {
@@ -91,8 +91,6 @@ bool GuiGizmo::render(const Camera& camera, ISceneControl& sceneControl, SceneEd
 
         // Update LocalTransform if available, otherwise update world Transform directly
         if (world->has<ecs::LocalTransform>(state.selectedEntity)) {
-            auto& local = world->get<ecs::LocalTransform>(state.selectedEntity);
-
             // If entity has a parent, we need to convert world delta to local
             if (world->has<ecs::Parent>(state.selectedEntity)) {
                 auto& parent = world->get<ecs::Parent>(state.selectedEntity);
@@ -107,9 +105,11 @@ bool GuiGizmo::render(const Camera& camera, ISceneControl& sceneControl, SceneEd
                 }
             }
 
-            local.position = translation;
-            local.rotation = rotation;
-            local.scale = scale;
+            world->patch<ecs::LocalTransform>(state.selectedEntity, [&](ecs::LocalTransform& local) {
+                local.position = translation;
+                local.rotation = rotation;
+                local.scale = scale;
+            });
 
             // Update world transforms
             ecs::systems::updateWorldTransforms(*world);
@@ -117,7 +117,8 @@ void renderTransformSection(ecs::World& world, ecs::Entity entity, SceneEditorSt
         auto& local = world.get<ecs::LocalTransform>(entity);
 
         if (editVec3("Position", local.position, 0.1f)) {
-            // Mark for world transform update
+            // Mark the subtree dirty, then update world transforms
+            world.patch<ecs::LocalTransform>(entity);
             ecs::systems::updateWorldTransforms(world);
         }
 
@@ -125,10 +126,12 @@ void renderTransformSection(ecs::World& world, ecs::Entity entity, SceneEditorSt
         glm::vec3 eulerDegrees = glm::degrees(glm::eulerAngles(local.rotation));
         if (editVec3("Rotation", eulerDegrees, 1.0f, -360.0f, 360.0f)) {
             local.rotation = glm::quat(glm::radians(eulerDegrees));
+            world.patch<ecs::LocalTransform>(entity);
             ecs::systems::updateWorldTransforms(world);
         }
 
         if (editVec3("Scale", local.scale, 0.01f, 0.01f, 100.0f)) {
+            world.patch<ecs::LocalTransform>(entity);
             ecs::systems::updateWorldTransforms(world);
         }
 
@@ -141,6 +144,7 @@ void renderTransformSection(ecs::World& world, ecs::Entity entity, SceneEditorSt
             ImGui::SetNextItemWidth(100);
             if (ImGui::DragFloat("##uniformScale", &avgScale, 0.01f, 0.01f, 100.0f)) {
                 local.scale = glm::vec3(avgScale);
+                world.patch<ecs::LocalTransform>(entity);
                 ecs::systems::updateWorldTransforms(world);
             }
         }
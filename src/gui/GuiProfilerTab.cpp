@@ -19,6 +19,15 @@ static int s_cpuFlamegraphIndex = 0;
 
 namespace {
 
+const char* poolPriorityName(TaskScheduler::Priority priority) {
+    switch (priority) {
+        case TaskScheduler::Priority::High: return "High";
+        case TaskScheduler::Priority::Normal: return "Normal";
+        case TaskScheduler::Priority::Low: return "Low";
+    }
+    return "?";
+}
+
 std::string generateMarkdownReport(const Profiler& profiler) {
     std::ostringstream ss;
 
@@ -53,6 +62,49 @@ std::string generateMarkdownReport(const Profiler& profiler) {
     }
     ss << "\n";
 
+    // Frame Pacing
+    const FramePacingAnalyzer& pacing = profiler.getFramePacing();
+    const auto pacingSummary = pacing.getSummary();
+    ss << "## Frame Pacing\n\n";
+    ss << "| Frames | p50 | p95 | p99 | Max | Hitches |\n";
+    ss << "|--------|-----|-----|-----|-----|---------|\n";
+    ss << "| " << pacingSummary.frames << " | " << std::fixed << std::setprecision(2) << pacingSummary.p50Ms
+       << " | " << pacingSummary.p95Ms << " | " << pacingSummary.p99Ms << " | " << pacingSummary.maxMs
+       << " | " << pacingSummary.hitches << " |\n\n";
+    for (size_t i = 0; i < FramePacingAnalyzer::BOTTLENECK_COUNT; ++i) {
+        ss << (i == 0 ? "" : ", ")
+           << FramePacingAnalyzer::bottleneckName(static_cast<FramePacingAnalyzer::Bottleneck>(i))
+           << ": " << pacingSummary.bottleneckFrames[i];
+    }
+    ss << " frames\n\n";
+    for (const auto& hitch : pacing.getHitches()) {
+        ss << "- Hitch at frame " << hitch.frameNumber << ": " << std::setprecision(2) << hitch.frameTimeMs
+           << " ms, " << hitch.rootCause << " +" << hitch.rootCauseExcessMs << " ms\n";
+    }
+    if (!pacing.getHitches().empty()) ss << "\n";
+
+    // Streaming I/O
+    const auto ioStats = profiler.getIOStats();
+    ss << "## Streaming I/O\n\n";
+    ss << "**" << (ioStats.backend == IOService::Backend::IoUring ? "io_uring" : "thread pool") << "**, "
+       << std::fixed << std::setprecision(2) << ioStats.bytesPerSecond / (1024.0f * 1024.0f) << " MB/s, "
+       << "queue " << ioStats.queueDepth << ", in flight " << ioStats.inFlight << "\n\n";
+    ss << "| Latency | p50 | p95 | p99 |\n";
+    ss << "|---------|-----|-----|-----|\n";
+    ss << "| ms | " << ioStats.latencyP50Ms << " | " << ioStats.latencyP95Ms << " | " << ioStats.latencyP99Ms << " |\n\n";
+
+    // Thread Pools
+    ss << "## Thread Pools\n\n";
+    ss << "| Pool | Priority | Cap | Running | Queued | Utilisation | Completed |\n";
+    ss << "|------|----------|-----|---------|--------|-------------|-----------|\n";
+    for (const auto& pool : profiler.getThreadPoolStats()) {
+        ss << "| " << pool.name << " | " << poolPriorityName(pool.priority) << " | ";
+        if (pool.maxConcurrency == 0) ss << "all"; else ss << pool.maxConcurrency;
+        ss << " | " << pool.running << " | " << pool.queued << " | " << std::setprecision(0)
+           << pool.utilisation * 100.0f << "% | " << pool.completed << " |\n";
+    }
+    ss << "\n";
+
     // Startup Timing
     if (InitProfiler::get().isFinalized() && !initResults.phases.empty()) {
         ss << "## Startup Timing\n\n";
@@ -310,6 +362,26 @@ void GuiProfilerTab::render(IProfilerControl& profilerControl) {
                 config.barHeight = 22.0f;
                 GuiFlamegraph::renderWithHistory("cpu_flamegraph", cpuHistory,
                                                   s_cpuFlamegraphIndex, config);
+
+                // Worker threads of the selected capture, one flamegraph per lane on the same time axis
+                const FlamegraphCapture* selected = cpuHistory.get(s_cpuFlamegraphIndex);
+                if (selected && !selected->lanes.empty() &&
+                    ImGui::TreeNode("cpu_worker_lanes", "Worker lanes (%zu)", selected->lanes.size())) {
+                    GuiFlamegraph::Config laneConfig;
+                    laneConfig.barHeight = 18.0f;
+                    for (const auto& lane : selected->lanes) {
+                        ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "%s", lane.threadName.c_str());
+                        FlamegraphCapture laneCapture;
+                        laneCapture.totalTimeMs = selected->totalTimeMs;
+                        laneCapture.frameNumber = selected->frameNumber;
+                        laneCapture.roots = lane.roots;
+
+                        char laneLabel[32];
+                        snprintf(laneLabel, sizeof(laneLabel), "cpu_lane_%u", lane.lane);
+                        GuiFlamegraph::render(laneLabel, laneCapture, laneConfig);
+                    }
+                    ImGui::TreePop();
+                }
             } else {
                 ImGui::TextDisabled("No flamegraph captures yet");
             }
@@ -320,6 +392,44 @@ void GuiProfilerTab::render(IProfilerControl& profilerControl) {
     ImGui::Separator();
     ImGui::Spacing();
 
+    // Frame Pacing Section
+    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.6f, 1.0f, 0.8f, 1.0f));
+    ImGui::Text("FRAME PACING");
+    ImGui::PopStyleColor();
+    {
+        const FramePacingAnalyzer& pacing = profiler.getFramePacing();
+        FramePacingAnalyzer::Summary summary = pacing.getSummary();
+        const auto& last = pacing.getLastReport();
+
+        ImGui::Text("Last frame: %.2f ms, %s-bound", last.frameTimeMs,
+                    FramePacingAnalyzer::bottleneckName(last.bottleneck));
+        ImGui::Text("p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms (%zu frames)",
+                    summary.p50Ms, summary.p95Ms, summary.p99Ms, summary.maxMs, summary.frames);
+
+        if (summary.frames > 0) {
+            float frames = static_cast<float>(summary.frames);
+            ImGui::Text("CPU %.0f%%  GPU %.0f%%  Streaming %.0f%%  Present %.0f%%",
+                100.0f * summary.bottleneckFrames[static_cast<size_t>(FramePacingAnalyzer::Bottleneck::CpuBound)] / frames,
+                100.0f * summary.bottleneckFrames[static_cast<size_t>(FramePacingAnalyzer::Bottleneck::GpuBound)] / frames,
+                100.0f * summary.bottleneckFrames[static_cast<size_t>(FramePacingAnalyzer::Bottleneck::StreamingStall)] / frames,
+                100.0f * summary.bottleneckFrames[static_cast<size_t>(FramePacingAnalyzer::Bottleneck::PresentBound)] / frames);
+        }
+
+        const auto& hitches = pacing.getHitches();
+        if (!hitches.empty() && ImGui::TreeNode("pacing_hitches", "Hitches (%zu in window)", summary.hitches)) {
+            // Newest first
+            for (auto it = hitches.rbegin(); it != hitches.rend(); ++it) {
+                ImGui::Text("#%llu  %.2f ms  %s +%.2f ms", static_cast<unsigned long long>(it->frameNumber),
+                            it->frameTimeMs, it->rootCause.c_str(), it->rootCauseExcessMs);
+            }
+            ImGui::TreePop();
+        }
+    }
+
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::Spacing();
+
     // Queue Submit Diagnostics Section
     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.6f, 0.8f, 1.0f));
     ImGui::Text("QUEUE SUBMIT DIAGNOSTICS");
@@ -677,6 +787,92 @@ void GuiProfilerTab::render(IProfilerControl& profilerControl) {
         ImGui::PopStyleColor();
     }
 
+    // Streaming I/O Section (collapsed by default)
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::Spacing();
+
+    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.6f, 0.9f, 0.8f, 1.0f));
+    if (ImGui::CollapsingHeader("STREAMING I/O")) {
+        ImGui::PopStyleColor();
+
+        const auto ioStats = profiler.getIOStats();
+        ImGui::Text("Backend: %s", ioStats.backend == IOService::Backend::IoUring ? "io_uring" : "thread pool");
+        ImGui::Text("Throughput: %.2f MB/s", ioStats.bytesPerSecond / (1024.0f * 1024.0f));
+        ImGui::Text("Queue depth: %u  In flight: %u (%.2f MB)  IO tasks: %u", ioStats.queueDepth,
+                    ioStats.inFlight, ioStats.bytesInFlight / (1024.0f * 1024.0f), ioStats.tasksQueued);
+
+        if (ImGui::BeginTable("IOLatency", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("p50 (ms)");
+            ImGui::TableSetupColumn("p95 (ms)");
+            ImGui::TableSetupColumn("p99 (ms)");
+            ImGui::TableHeadersRow();
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", ioStats.latencyP50Ms);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", ioStats.latencyP95Ms);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", ioStats.latencyP99Ms);
+            ImGui::EndTable();
+        }
+
+        ImGui::Text("Completed: %llu (%.1f MB)  Failed: %llu  Cancelled: %llu  Expired: %llu",
+                    static_cast<unsigned long long>(ioStats.completed),
+                    ioStats.totalBytesRead / (1024.0 * 1024.0),
+                    static_cast<unsigned long long>(ioStats.failed),
+                    static_cast<unsigned long long>(ioStats.cancelled),
+                    static_cast<unsigned long long>(ioStats.expired));
+    } else {
+        ImGui::PopStyleColor();
+    }
+
+    // Thread Pool Section (collapsed by default)
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::Spacing();
+
+    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.9f, 0.8f, 0.5f, 1.0f));
+    if (ImGui::CollapsingHeader("THREAD POOLS")) {
+        ImGui::PopStyleColor();
+
+        ImGui::Text("Scheduler workers: %u", TaskScheduler::instance().getThreadCount());
+        if (ImGui::BeginTable("ThreadPools", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Pool");
+            ImGui::TableSetupColumn("Priority");
+            ImGui::TableSetupColumn("Cap");
+            ImGui::TableSetupColumn("Running");
+            ImGui::TableSetupColumn("Queued");
+            ImGui::TableSetupColumn("Utilisation", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableHeadersRow();
+
+            for (const auto& pool : profiler.getThreadPoolStats()) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%s", pool.name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%s", poolPriorityName(pool.priority));
+                ImGui::TableNextColumn();
+                if (pool.maxConcurrency == 0) {
+                    ImGui::Text("all");
+                } else {
+                    ImGui::Text("%u", pool.maxConcurrency);
+                }
+                ImGui::TableNextColumn();
+                ImGui::Text("%u (peak %u)", pool.running, pool.peakRunning);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", pool.queued);
+                ImGui::TableNextColumn();
+                char overlay[32];
+                snprintf(overlay, sizeof(overlay), "%.0f%%", pool.utilisation * 100.0f);
+                ImGui::ProgressBar(pool.utilisation, ImVec2(-1, 0), overlay);
+            }
+            ImGui::EndTable();
+        }
+    } else {
+        ImGui::PopStyleColor();
+    }
+
     // Initialization Timing Section (collapsed by default)
     ImGui::Spacing();
     ImGui::Separator();
@@ -1,4 +1,5 @@
 #include "FroxelSystem.h"
+#include "LightClusterGrid.h"
 #include "ShaderLoader.h"
 #include "DescriptorManager.h"
 #include "core/InitInfoBuilder.h"
@@ -12,6 +13,13 @@
 #include <array>
 #include <cmath>
 
+// Light clusters are whole blocks of froxels
+static_assert(LightClusterGrid::FROXEL_WIDTH == FroxelSystem::FROXEL_WIDTH &&
+              LightClusterGrid::FROXEL_HEIGHT == FroxelSystem::FROXEL_HEIGHT &&
+              LightClusterGrid::FROXEL_DEPTH == FroxelSystem::FROXEL_DEPTH &&
+              LightClusterGrid::DEPTH_DISTRIBUTION == FroxelSystem::DEPTH_DISTRIBUTION,
+              "LightClusterGrid must mirror the froxel grid");
+
 std::unique_ptr<FroxelSystem> FroxelSystem::create(const InitInfo& info) {
     auto system = std::make_unique<FroxelSystem>(ConstructToken{}, info);
     if (!system->initialized_) {
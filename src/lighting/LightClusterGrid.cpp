@@ -0,0 +1,354 @@
+#include "LightClusterGrid.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIGHTCLUSTERS_SSE2 1
+#endif
+
+static_assert(LightClusterGrid::TILES_X % 4 == 0, "clusters are tested four columns at a time");
+static_assert(LightClusterGrid::CLUSTER_COUNT <= 65536, "cluster indices are stored as uint16_t");
+
+namespace {
+
+// Bit i set where plane i passes: ge for s_i >= -r, le for s_i <= r
+void planeMasks(const float* na, const float* nz, uint32_t planeCount, float a, float z, float r,
+                uint32_t& ge, uint32_t& le) {
+    ge = 0;
+    le = 0;
+#ifdef LIGHTCLUSTERS_SSE2
+    const __m128 va = _mm_set1_ps(a);
+    const __m128 vz = _mm_set1_ps(z);
+    const __m128 vr = _mm_set1_ps(r);
+    const __m128 negR = _mm_set1_ps(-r);
+    for (uint32_t i = 0; i < planeCount; i += 4) {
+        __m128 s = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(na + i), va), _mm_mul_ps(_mm_loadu_ps(nz + i), vz));
+        ge |= static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(s, negR))) << i;
+        le |= static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(s, vr))) << i;
+    }
+#else
+    for (uint32_t i = 0; i < planeCount; ++i) {
+        float s = na[i] * a + nz[i] * z;
+        if (s >= -r) ge |= 1u << i;
+        if (s <= r) le |= 1u << i;
+    }
+#endif
+}
+
+} // namespace
+
+LightClusterGrid::LightClusterGrid() {
+    for (auto* lane : {&minX_, &minY_, &minZ_, &maxX_, &maxY_, &maxZ_, &sphereX_, &sphereY_, &sphereZ_, &sphereR_}) {
+        lane->resize(CLUSTER_COUNT, 0.0f);
+    }
+    offsets_.assign(CLUSTER_COUNT + 1, 0);
+    cursor_.resize(CLUSTER_COUNT);
+}
+
+void LightClusterGrid::setDepthRange(float froxelFarPlane, float maxDistance) {
+    if (froxelFarPlane == froxelFarPlane_ && std::max(froxelFarPlane, maxDistance) == maxDistance_) return;
+    froxelFarPlane_ = froxelFarPlane;
+    maxDistance_ = std::max(froxelFarPlane, maxDistance);
+    projection_ = glm::mat4(0.0f);   // Rebuild on the next assign()
+}
+
+void LightClusterGrid::rebuildGeometry(const glm::mat4& projection) {
+    projection_ = projection;
+    historyValid_ = false;
+
+    // clip.x = P00 x + P20 z, clip.y = P11 y + P21 z, clip.w = P23 z
+    const float p00 = projection[0][0], p20 = projection[2][0];
+    const float p11 = projection[1][1], p21 = projection[2][1];
+    const float p23 = projection[2][3];
+    depthSign_ = p23;
+
+    // FroxelSystem::sliceToDepth at every FROXELS_PER_SLICE-th froxel slice
+    const float total = std::pow(DEPTH_DISTRIBUTION, static_cast<float>(FROXEL_DEPTH)) - 1.0f;
+    for (uint32_t k = 0; k < SLICES; ++k) {
+        float slice = static_cast<float>(k * FROXELS_PER_SLICE);
+        sliceDepth_[k] = froxelFarPlane_ * (std::pow(DEPTH_DISTRIBUTION, slice) - 1.0f) / total;
+    }
+    sliceDepth_[SLICES] = maxDistance_;
+
+    // NDC x >= a  <=>  P00 x + (P20 - a P23) z >= 0 in front of the eye
+    auto ndcAt = [](uint32_t i, uint32_t tiles) { return -1.0f + 2.0f * static_cast<float>(i) / tiles; };
+    for (uint32_t i = 0; i < COLUMN_PLANES; ++i) {
+        float nx = 0.0f, nz = 0.0f;
+        if (i <= TILES_X) {
+            nx = p00;
+            nz = p20 - ndcAt(i, TILES_X) * p23;
+            float length = std::sqrt(nx * nx + nz * nz);
+            nx /= length;
+            nz /= length;
+        }
+        columnNx_[i] = nx;
+        columnNz_[i] = nz;
+    }
+    for (uint32_t i = 0; i < ROW_PLANES; ++i) {
+        float ny = 0.0f, nz = 0.0f;
+        if (i <= TILES_Y) {
+            ny = p11;
+            nz = p21 - ndcAt(i, TILES_Y) * p23;
+            float length = std::sqrt(ny * ny + nz * nz);
+            ny /= length;
+            nz /= length;
+        }
+        rowNy_[i] = ny;
+        rowNz_[i] = nz;
+    }
+
+    // Cluster AABBs from their eight corners
+    for (uint32_t slice = 0; slice < SLICES; ++slice) {
+        const float depths[2] = {sliceDepth_[slice], sliceDepth_[slice + 1]};
+        for (uint32_t y = 0; y < TILES_Y; ++y) {
+            for (uint32_t x = 0; x < TILES_X; ++x) {
+                glm::vec3 lo(1e30f), hi(-1e30f);
+                for (float depth : depths) {
+                    float z = depth / p23;
+                    for (uint32_t cx = x; cx <= x + 1; ++cx) {
+                        for (uint32_t cy = y; cy <= y + 1; ++cy) {
+                            glm::vec3 corner((ndcAt(cx, TILES_X) * depth - p20 * z) / p00,
+                                             (ndcAt(cy, TILES_Y) * depth - p21 * z) / p11, z);
+                            lo = glm::min(lo, corner);
+                            hi = glm::max(hi, corner);
+                        }
+                    }
+                }
+                uint32_t c = clusterIndex(x, y, slice);
+                minX_[c] = lo.x; minY_[c] = lo.y; minZ_[c] = lo.z;
+                maxX_[c] = hi.x; maxY_[c] = hi.y; maxZ_[c] = hi.z;
+                glm::vec3 center = 0.5f * (lo + hi);
+                sphereX_[c] = center.x;
+                sphereY_[c] = center.y;
+                sphereZ_[c] = center.z;
+                sphereR_[c] = 0.5f * glm::length(hi - lo);
+            }
+        }
+    }
+}
+
+LightClusterGrid::BinnedLight LightClusterGrid::toView(const glm::mat4& view, const ClusterLight& light) const {
+    BinnedLight binned{};
+    binned.apex = glm::vec3(view * glm::vec4(light.position, 1.0f));
+    binned.range = light.radius;
+    binned.axis = glm::normalize(glm::vec3(view * glm::vec4(light.direction, 0.0f)));
+    binned.cosCone = light.cosOuterCone;
+    binned.sinCone = std::sqrt(std::max(0.0f, 1.0f - light.cosOuterCone * light.cosOuterCone));
+
+    if (binned.cosCone <= 0.0f) {
+        binned.center = binned.apex;
+        binned.radius = light.radius;
+    } else if (binned.cosCone < 0.70710678f) {
+        // Wide cone: the cap circle bounds it
+        binned.center = binned.apex + binned.axis * (binned.cosCone * light.radius);
+        binned.radius = binned.sinCone * light.radius;
+    } else {
+        // Narrow cone: sphere through the apex and the cap rim
+        float half = light.radius / (2.0f * binned.cosCone);
+        binned.center = binned.apex + binned.axis * half;
+        binned.radius = half;
+    }
+    return binned;
+}
+
+bool LightClusterGrid::canReuse(const BinnedLight& current, const BinnedLight& previous) const {
+    bool spot = current.cosCone > 0.0f;
+    if (spot != (previous.cosCone > 0.0f)) return false;
+    if (!spot) {
+        return glm::length(current.center - previous.center) + current.radius <= previous.radius + reuseMargin_;
+    }
+    // A cone no longer and no wider than before, with its apex moved by d and
+    // its axis turned, stays within d + range * |axis change| of the old one
+    if (current.range > previous.range || current.cosCone < previous.cosCone) return false;
+    float turn = glm::length(current.axis - previous.axis);
+    return glm::length(current.apex - previous.apex) + previous.range * turn <= reuseMargin_;
+}
+
+uint32_t LightClusterGrid::sliceOf(float depth) const {
+    const float* first = sliceDepth_ + 1;
+    const float* last = sliceDepth_ + SLICES;
+    return static_cast<uint32_t>(std::upper_bound(first, last, depth) - first);
+}
+
+void LightClusterGrid::binLight(const BinnedLight& light, std::vector<uint16_t>& out) const {
+    const float r = light.radius + reuseMargin_;
+    const glm::vec3& c = light.center;
+    const float depth = depthSign_ * c.z;
+    if (light.range <= 0.0f || depth + r < 0.0f || depth - r > maxDistance_) return;
+
+    const uint32_t firstSlice = sliceOf(std::max(0.0f, depth - r));
+    const uint32_t lastSlice = sliceOf(std::min(maxDistance_, depth + r));
+
+    // Tile i is a candidate when the sphere reaches both sides of its bounds
+    uint32_t ge, le;
+    planeMasks(columnNx_, columnNz_, COLUMN_PLANES, c.x, c.z, r, ge, le);
+    const uint32_t columns = ge & (le >> 1) & ((1u << TILES_X) - 1);
+    planeMasks(rowNy_, rowNz_, ROW_PLANES, c.y, c.z, r, ge, le);
+    const uint32_t rows = ge & (le >> 1) & ((1u << TILES_Y) - 1);
+    if (columns == 0 || rows == 0) return;
+
+    uint32_t firstGroup = 0;
+    while (!(columns & (0xFu << firstGroup))) firstGroup += 4;
+    uint32_t lastGroup = TILES_X - 4;
+    while (!(columns & (0xFu << lastGroup))) lastGroup -= 4;
+
+    const bool spot = light.cosCone > 0.0f;
+    // Cone test against the cluster sphere grown by the slack
+    const float coneSlack = reuseMargin_;
+
+#ifdef LIGHTCLUSTERS_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 cx = _mm_set1_ps(c.x), cy = _mm_set1_ps(c.y), cz = _mm_set1_ps(c.z);
+    const __m128 rSq = _mm_set1_ps(r * r);
+    const __m128 ax = _mm_set1_ps(light.apex.x), ay = _mm_set1_ps(light.apex.y), az = _mm_set1_ps(light.apex.z);
+    const __m128 dx = _mm_set1_ps(light.axis.x), dy = _mm_set1_ps(light.axis.y), dz = _mm_set1_ps(light.axis.z);
+    const __m128 cosCone = _mm_set1_ps(light.cosCone), sinCone = _mm_set1_ps(light.sinCone);
+    const __m128 range = _mm_set1_ps(light.range);
+    const __m128 slack = _mm_set1_ps(coneSlack);
+#endif
+
+    for (uint32_t slice = firstSlice; slice <= lastSlice; ++slice) {
+        for (uint32_t y = 0; y < TILES_Y; ++y) {
+            if (!(rows & (1u << y))) continue;
+            for (uint32_t group = firstGroup; group <= lastGroup; group += 4) {
+                uint32_t mask = (columns >> group) & 0xFu;
+                if (mask == 0) continue;
+                const uint32_t base = clusterIndex(group, y, slice);
+#ifdef LIGHTCLUSTERS_SSE2
+                // Sphere vs AABB: squared distance from the centre to the box
+                __m128 ox = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&minX_[base]), cx),
+                                                  _mm_sub_ps(cx, _mm_loadu_ps(&maxX_[base]))), zero);
+                __m128 oy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&minY_[base]), cy),
+                                                  _mm_sub_ps(cy, _mm_loadu_ps(&maxY_[base]))), zero);
+                __m128 oz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&minZ_[base]), cz),
+                                                  _mm_sub_ps(cz, _mm_loadu_ps(&maxZ_[base]))), zero);
+                __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ox, ox), _mm_mul_ps(oy, oy)), _mm_mul_ps(oz, oz));
+                __m128 pass = _mm_cmple_ps(distSq, rSq);
+
+                if (spot) {
+                    // Cone vs cluster sphere: the sphere is outside when past
+                    // the cone's side, beyond its range or behind the apex
+                    __m128 sr = _mm_add_ps(_mm_loadu_ps(&sphereR_[base]), slack);
+                    __m128 vx = _mm_sub_ps(_mm_loadu_ps(&sphereX_[base]), ax);
+                    __m128 vy = _mm_sub_ps(_mm_loadu_ps(&sphereY_[base]), ay);
+                    __m128 vz = _mm_sub_ps(_mm_loadu_ps(&sphereZ_[base]), az);
+                    __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+                    __m128 along = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, dx), _mm_mul_ps(vy, dy)), _mm_mul_ps(vz, dz));
+                    __m128 across = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(lengthSq, _mm_mul_ps(along, along)), zero));
+                    __m128 closest = _mm_sub_ps(_mm_mul_ps(cosCone, across), _mm_mul_ps(along, sinCone));
+                    pass = _mm_and_ps(pass, _mm_cmple_ps(closest, sr));
+                    pass = _mm_and_ps(pass, _mm_cmple_ps(along, _mm_add_ps(sr, range)));
+                    pass = _mm_and_ps(pass, _mm_cmpge_ps(along, _mm_sub_ps(zero, sr)));
+                }
+                mask &= static_cast<uint32_t>(_mm_movemask_ps(pass));
+#else
+                for (uint32_t lane = 0; lane < 4; ++lane) {
+                    if (!(mask & (1u << lane))) continue;
+                    const uint32_t i = base + lane;
+                    float ox = std::max(std::max(minX_[i] - c.x, c.x - maxX_[i]), 0.0f);
+                    float oy = std::max(std::max(minY_[i] - c.y, c.y - maxY_[i]), 0.0f);
+                    float oz = std::max(std::max(minZ_[i] - c.z, c.z - maxZ_[i]), 0.0f);
+                    bool pass = ox * ox + oy * oy + oz * oz <= r * r;
+                    if (pass && spot) {
+                        float sr = sphereR_[i] + coneSlack;
+                        glm::vec3 v = glm::vec3(sphereX_[i], sphereY_[i], sphereZ_[i]) - light.apex;
+                        float along = glm::dot(v, light.axis);
+                        float across = std::sqrt(std::max(glm::dot(v, v) - along * along, 0.0f));
+                        float closest = light.cosCone * across - along * light.sinCone;
+                        pass = closest <= sr && along <= sr + light.range && along >= -sr;
+                    }
+                    if (!pass) mask &= ~(1u << lane);
+                }
+#endif
+                for (uint32_t lane = 0; mask != 0; ++lane, mask >>= 1) {
+                    if (mask & 1u) out.push_back(static_cast<uint16_t>(base + lane));
+                }
+            }
+        }
+    }
+}
+
+void LightClusterGrid::assign(const glm::mat4& view, const glm::mat4& projection,
+                              const std::vector<ClusterLight>& lights) {
+    if (projection != projection_) rebuildGeometry(projection);
+
+    std::swap(ids_, prevIds_);
+    std::swap(lights_, prevLights_);
+    std::swap(pairStart_, prevPairStart_);
+    std::swap(pairCount_, prevPairCount_);
+    std::swap(pairs_, prevPairs_);
+    const size_t history = historyValid_ ? prevIds_.size() : 0;
+
+    const size_t count = lights.size();
+    ids_.resize(count);
+    lights_.resize(count);
+    pairStart_.resize(count);
+    pairCount_.resize(count);
+    pairs_.clear();
+    reusedCount_ = 0;
+
+    // Lights usually arrive in last frame's order; look ids up only when not
+    bool indexBuilt = false;
+    auto previousIndex = [&](size_t i, uint32_t id) -> size_t {
+        if (i < history && prevIds_[i] == id) return i;
+        if (!indexBuilt) {
+            prevIndexOf_.clear();
+            for (size_t p = 0; p < history; ++p) prevIndexOf_.emplace(prevIds_[p], static_cast<uint32_t>(p));
+            indexBuilt = true;
+        }
+        auto found = prevIndexOf_.find(id);
+        return found != prevIndexOf_.end() ? found->second : history;
+    };
+
+    // Every light keeping its clusters at its old index leaves the lists as
+    // they were; without history (new projection or depth range) they're stale
+    bool unchanged = historyValid_ && history == count;
+    for (size_t i = 0; i < count; ++i) {
+        BinnedLight current = toView(view, lights[i]);
+        ids_[i] = lights[i].id;
+        pairStart_[i] = static_cast<uint32_t>(pairs_.size());
+        size_t previous = history > 0 ? previousIndex(i, lights[i].id) : history;
+        if (previous < history && canReuse(current, prevLights_[previous])) {
+            // Keep what the old assignment was made from: it still covers this light
+            lights_[i] = prevLights_[previous];
+            auto first = prevPairs_.begin() + prevPairStart_[previous];
+            pairs_.insert(pairs_.end(), first, first + prevPairCount_[previous]);
+            unchanged = unchanged && previous == i;
+            ++reusedCount_;
+        } else {
+            lights_[i] = current;
+            binLight(current, pairs_);
+            unchanged = false;
+        }
+        pairCount_[i] = static_cast<uint32_t>(pairs_.size()) - pairStart_[i];
+    }
+    historyValid_ = true;
+    if (unchanged) return;
+
+    // Counting sort of (light, cluster) pairs into per-cluster lists
+    uint32_t* offsets = offsets_.data();
+    std::fill(offsets_.begin(), offsets_.end(), 0);
+    for (uint16_t cluster : pairs_) ++offsets[cluster + 1];
+    for (uint32_t c = 0; c < CLUSTER_COUNT; ++c) offsets[c + 1] += offsets[c];
+    std::copy(offsets_.begin(), offsets_.end() - 1, cursor_.begin());
+    indices_.resize(pairs_.size());
+    uint32_t* cursor = cursor_.data();
+    uint32_t* indices = indices_.data();
+    const uint16_t* pairs = pairs_.data();
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t end = pairStart_[i] + pairCount_[i];
+        for (uint32_t p = pairStart_[i]; p < end; ++p) indices[cursor[pairs[p]]++] = static_cast<uint32_t>(i);
+    }
+}
+
+uint32_t LightClusterGrid::clusterAt(const glm::vec3& viewPosition) const {
+    float depth = depthSign_ * viewPosition.z;
+    if (depth <= 0.0f || depth > maxDistance_) return CLUSTER_COUNT;
+    float ndcX = (projection_[0][0] * viewPosition.x + projection_[2][0] * viewPosition.z) / depth;
+    float ndcY = (projection_[1][1] * viewPosition.y + projection_[2][1] * viewPosition.z) / depth;
+    if (ndcX < -1.0f || ndcX > 1.0f || ndcY < -1.0f || ndcY > 1.0f) return CLUSTER_COUNT;
+    uint32_t x = std::min(static_cast<uint32_t>((ndcX + 1.0f) * 0.5f * TILES_X), TILES_X - 1);
+    uint32_t y = std::min(static_cast<uint32_t>((ndcY + 1.0f) * 0.5f * TILES_Y), TILES_Y - 1);
+    return clusterIndex(x, y, sliceOf(depth));
+}
@@ -0,0 +1,147 @@
+// CPU clustered light assignment on a froxel-aligned view-space grid
+// Bins point/spot lights into clusters and keeps compact per-cluster light
+// index lists; four clusters per SSE2 step (scalar fallback elsewhere)
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// A positional light as the cluster grid sees it (world space)
+struct ClusterLight {
+    glm::vec3 position = glm::vec3(0.0f);
+    float radius = 0.0f;                      // Falloff range
+    glm::vec3 direction = glm::vec3(0.0f, -1.0f, 0.0f);  // Spot axis (normalized)
+    float cosOuterCone = -1.0f;               // Spot: cos(outer angle); <= 0 bins as a point light
+    uint32_t id = 0;                          // Stable across frames (e.g. the entity)
+};
+
+/**
+ * Clustered light assignment.
+ *
+ * The view frustum is split into TILES_X x TILES_Y screen tiles and SLICES
+ * depth slices whose boundaries coincide with FroxelSystem's froxels (8x8
+ * froxels per tile, 4 froxel slices per slice, same exponential depth
+ * distribution), so a froxel or pixel finds its cluster with shifts. The last
+ * slice is stretched out to maxDistance.
+ *
+ * assign() clips each light's view-space bounding sphere against the tile
+ * planes and the slice depths, then tests the candidate clusters four at a
+ * time: sphere vs cluster AABB, plus cone vs cluster bounding sphere for spots.
+ *
+ * Lights are binned with a reuse margin of slack. Next frame, a light (matched
+ * by id) that is still within that slack in view space keeps its
+ * clusters without being tested, so static lights under a slow camera cost a
+ * transform and a compare.
+ */
+class LightClusterGrid {
+public:
+    // Mirror FroxelSystem's grid (checked there)
+    static constexpr uint32_t FROXEL_WIDTH = 128;
+    static constexpr uint32_t FROXEL_HEIGHT = 64;
+    static constexpr uint32_t FROXEL_DEPTH = 64;
+    static constexpr float DEPTH_DISTRIBUTION = 1.2f;
+
+    static constexpr uint32_t FROXELS_PER_TILE = 8;
+    static constexpr uint32_t FROXELS_PER_SLICE = 4;
+    static constexpr uint32_t TILES_X = FROXEL_WIDTH / FROXELS_PER_TILE;
+    static constexpr uint32_t TILES_Y = FROXEL_HEIGHT / FROXELS_PER_TILE;
+    static constexpr uint32_t SLICES = FROXEL_DEPTH / FROXELS_PER_SLICE;
+    static constexpr uint32_t CLUSTER_COUNT = TILES_X * TILES_Y * SLICES;
+
+    LightClusterGrid();
+
+    // froxelFarPlane: FroxelSystem's volumetric far plane (slice distribution)
+    // maxDistance: how far the last slice reaches (at least froxelFarPlane)
+    void setDepthRange(float froxelFarPlane, float maxDistance);
+
+    // View-space slack (metres) lights are binned with; larger keeps more
+    // assignments across frames at the cost of looser lists
+    void setReuseMargin(float margin) { reuseMargin_ = margin; historyValid_ = false; }
+    float reuseMargin() const { return reuseMargin_; }
+
+    /**
+     * Assign lights for this view. projection is a perspective matrix in the
+     * glm convention (either handedness, NDC y in either direction); tile
+     * (0, 0) is at NDC (-1, -1).
+     */
+    void assign(const glm::mat4& view, const glm::mat4& projection, const std::vector<ClusterLight>& lights);
+
+    static uint32_t clusterIndex(uint32_t tileX, uint32_t tileY, uint32_t slice) {
+        return (slice * TILES_Y + tileY) * TILES_X + tileX;
+    }
+
+    // Cluster containing a view-space point, or CLUSTER_COUNT outside the grid
+    uint32_t clusterAt(const glm::vec3& viewPosition) const;
+
+    // Lights of cluster c are lightIndices()[clusterOffset(c) ..
+    // clusterOffset(c) + clusterLightCount(c)), ascending indices into the
+    // vector passed to the last assign()
+    uint32_t clusterOffset(uint32_t cluster) const { return offsets_[cluster]; }
+    uint32_t clusterLightCount(uint32_t cluster) const { return offsets_[cluster + 1] - offsets_[cluster]; }
+    const std::vector<uint32_t>& lightIndices() const { return indices_; }
+
+    // Clusters light i touches (0: outside the view or past maxDistance)
+    uint32_t lightClusterCount(uint32_t light) const { return pairCount_[light]; }
+
+    // Lights of the last assign() that kept the previous frame's clusters
+    uint32_t reusedLightCount() const { return reusedCount_; }
+
+private:
+    // Tile boundary planes, padded to whole SIMD groups
+    static constexpr uint32_t COLUMN_PLANES = (TILES_X + 1 + 3) & ~3u;
+    static constexpr uint32_t ROW_PLANES = (TILES_Y + 1 + 3) & ~3u;
+
+    // View-space light, with the slack it was binned with
+    struct BinnedLight {
+        glm::vec3 center;         // Bounding sphere
+        float radius;
+        glm::vec3 apex;           // Spot only
+        float range;
+        glm::vec3 axis;
+        float cosCone;            // <= 0: point light
+        float sinCone;
+    };
+
+    void rebuildGeometry(const glm::mat4& projection);
+    BinnedLight toView(const glm::mat4& view, const ClusterLight& light) const;
+    bool canReuse(const BinnedLight& current, const BinnedLight& previous) const;
+    uint32_t sliceOf(float depth) const;
+    void binLight(const BinnedLight& light, std::vector<uint16_t>& out) const;
+
+    float froxelFarPlane_ = 200.0f;
+    float maxDistance_ = 200.0f;
+    float reuseMargin_ = 0.25f;
+
+    // Grid geometry for the cached projection
+    glm::mat4 projection_ = glm::mat4(0.0f);
+    float depthSign_ = -1.0f;                    // View z to depth (clip w)
+    float sliceDepth_[SLICES + 1] = {};
+    // Tile boundary planes through the eye (normalized x/z resp. y/z)
+    float columnNx_[COLUMN_PLANES] = {}, columnNz_[COLUMN_PLANES] = {};
+    float rowNy_[ROW_PLANES] = {}, rowNz_[ROW_PLANES] = {};
+    // Cluster view-space AABBs and bounding spheres, cluster-index order
+    std::vector<float> minX_, minY_, minZ_, maxX_, maxY_, maxZ_;
+    std::vector<float> sphereX_, sphereY_, sphereZ_, sphereR_;
+
+    // This frame: clusters per light, then compacted per cluster
+    std::vector<uint32_t> pairStart_, pairCount_;
+    std::vector<uint16_t> pairs_;
+    std::vector<uint32_t> offsets_;
+    std::vector<uint32_t> indices_;
+    std::vector<uint32_t> cursor_;
+    uint32_t reusedCount_ = 0;
+
+    std::vector<uint32_t> ids_;
+    std::vector<BinnedLight> lights_;
+
+    // Last frame's, swapped in at the start of assign()
+    bool historyValid_ = false;
+    std::vector<uint32_t> prevIds_;
+    std::vector<BinnedLight> prevLights_;
+    std::vector<uint32_t> prevPairStart_, prevPairCount_;
+    std::vector<uint16_t> prevPairs_;
+    std::unordered_map<uint32_t, uint32_t> prevIndexOf_;   // Built when lights change order
+};
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "Light.h"
+#include "LightClusterGrid.h"
 #include "ecs/World.h"
 #include "ecs/Components.h"
+#include "ecs/SpatialSystem.h"
 #include "scene/RotationUtils.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -212,6 +214,39 @@ inline Light directionalLightToLight(const DirectionalLightComponent& component,
     return light;
 }
 
+// Weight a point/spot light for priority sorting
+inline CollectedLight collectPositionalLight(Entity entity, const Light& light, float priority,
+                                             const glm::vec3& cameraPos, const glm::vec3& cameraFront) {
+    CollectedLight collected;
+    collected.entity = entity;
+    collected.light = light;
+    collected.distanceToCamera = glm::length(light.position - cameraPos);
+
+    // Calculate effective weight for prioritization
+    glm::vec3 toLight = glm::normalize(light.position - cameraPos);
+    float angleFactor = glm::max(0.0f, glm::dot(toLight, cameraFront));
+    angleFactor = 0.25f + 0.75f * angleFactor;
+    collected.effectiveWeight = (priority * angleFactor) / (collected.distanceToCamera + 1.0f);
+    return collected;
+}
+
+// Collect directional lights (always high priority, no distance culling)
+inline void collectDirectionalLights(const World& world, LightCollectionResult& result) {
+    for (auto [entity, dirLight, transform] :
+         world.view<DirectionalLightComponent, Transform>().each()) {
+
+        if (!dirLight.properties.enabled) continue;
+
+        CollectedLight collected;
+        collected.entity = entity;
+        collected.light = directionalLightToLight(dirLight, transform);
+        collected.distanceToCamera = 0.0f;  // Always closest
+        collected.effectiveWeight = dirLight.properties.priority;
+
+        result.directionalLights.push_back(collected);
+    }
+}
+
 // Collect all lights from ECS into a result structure
 // cameraPos: for distance-based sorting
 // cameraFront: for view-direction weighting
@@ -223,60 +258,81 @@ inline LightCollectionResult collectLights(const World& world,
     // Collect point lights
     for (auto [entity, pointLight, transform] :
          world.view<PointLightComponent, Transform>().each()) {
-
         if (!pointLight.properties.enabled) continue;
-
-        CollectedLight collected;
-        collected.entity = entity;
-        collected.light = pointLightToLight(pointLight, transform);
-        collected.distanceToCamera = glm::length(transform.position() - cameraPos);
-
-        // Calculate effective weight for prioritization
-        glm::vec3 toLight = glm::normalize(transform.position() - cameraPos);
-        float angleFactor = glm::max(0.0f, glm::dot(toLight, cameraFront));
-        angleFactor = 0.25f + 0.75f * angleFactor;
-        collected.effectiveWeight = (pointLight.properties.priority * angleFactor) /
-                                    (collected.distanceToCamera + 1.0f);
-
-        result.pointLights.push_back(collected);
+        result.pointLights.push_back(collectPositionalLight(
+            entity, pointLightToLight(pointLight, transform), pointLight.properties.priority, cameraPos, cameraFront));
     }
 
     // Collect spot lights
     for (auto [entity, spotLight, transform] :
          world.view<SpotLightComponent, Transform>().each()) {
-
         if (!spotLight.properties.enabled) continue;
+        result.spotLights.push_back(collectPositionalLight(
+            entity, spotLightToLight(spotLight, transform), spotLight.properties.priority, cameraPos, cameraFront));
+    }
 
-        CollectedLight collected;
-        collected.entity = entity;
-        collected.light = spotLightToLight(spotLight, transform);
-        collected.distanceToCamera = glm::length(transform.position() - cameraPos);
+    collectDirectionalLights(world, result);
+    return result;
+}
 
-        glm::vec3 toLight = glm::normalize(transform.position() - cameraPos);
-        float angleFactor = glm::max(0.0f, glm::dot(toLight, cameraFront));
-        angleFactor = 0.25f + 0.75f * angleFactor;
-        collected.effectiveWeight = (spotLight.properties.priority * angleFactor) /
-                                    (collected.distanceToCamera + 1.0f);
+// Collect the point/spot lights whose range reaches within cullRadius of the
+// camera through the spatial index (as of the last updateSpatialIndex), plus
+// all directional lights. Falls back to collectLights() without an index.
+inline LightCollectionResult collectLightsNear(const World& world,
+                                               const glm::vec3& cameraPos,
+                                               const glm::vec3& cameraFront,
+                                               float cullRadius) {
+    if (!systems::findSpatialIndex(world)) return collectLights(world, cameraPos, cameraFront);
 
-        result.spotLights.push_back(collected);
+    LightCollectionResult result;
+    std::vector<Entity> nearby;
+    systems::queryEntitiesInSphere(world, cameraPos, cullRadius, SpatialLayer::Light, nearby);
+    for (Entity entity : nearby) {
+        const auto* transform = world.tryGet<Transform>(entity);
+        if (!transform) continue;
+        if (const auto* pointLight = world.tryGet<PointLightComponent>(entity)) {
+            if (pointLight->properties.enabled) {
+                result.pointLights.push_back(collectPositionalLight(
+                    entity, pointLightToLight(*pointLight, *transform), pointLight->properties.priority,
+                    cameraPos, cameraFront));
+            }
+        }
+        if (const auto* spotLight = world.tryGet<SpotLightComponent>(entity)) {
+            if (spotLight->properties.enabled) {
+                result.spotLights.push_back(collectPositionalLight(
+                    entity, spotLightToLight(*spotLight, *transform), spotLight->properties.priority,
+                    cameraPos, cameraFront));
+            }
+        }
     }
 
-    // Collect directional lights (always high priority, no distance culling)
-    for (auto [entity, dirLight, transform] :
-         world.view<DirectionalLightComponent, Transform>().each()) {
+    collectDirectionalLights(world, result);
+    return result;
+}
 
-        if (!dirLight.properties.enabled) continue;
+// Write the MAX_LIGHTS heaviest candidates to the buffer, heaviest first
+// Returns number of lights written
+inline uint32_t writeLightBuffer(std::vector<CollectedLight>& allLights, LightBuffer& buffer) {
+    // Only the MAX_LIGHTS heaviest need ordering (descending weight)
+    uint32_t count = static_cast<uint32_t>(std::min(allLights.size(), static_cast<size_t>(MAX_LIGHTS)));
+    std::partial_sort(allLights.begin(), allLights.begin() + count, allLights.end(),
+        [](const CollectedLight& a, const CollectedLight& b) {
+            return a.effectiveWeight > b.effectiveWeight;
+        });
 
-        CollectedLight collected;
-        collected.entity = entity;
-        collected.light = directionalLightToLight(dirLight, transform);
-        collected.distanceToCamera = 0.0f;  // Always closest
-        collected.effectiveWeight = dirLight.properties.priority;
+    // Write to buffer (up to MAX_LIGHTS)
+    buffer.lightCount = glm::uvec4(count, 0, 0, 0);
 
-        result.directionalLights.push_back(collected);
+    for (uint32_t i = 0; i < count; i++) {
+        buffer.lights[i] = allLights[i].light.toGPU();
     }
 
-    return result;
+    // Zero out unused slots
+    for (uint32_t i = count; i < MAX_LIGHTS; i++) {
+        buffer.lights[i] = GPULight{};
+    }
+
+    return count;
 }
 
 // Build GPU light buffer from ECS lights with culling and prioritization
@@ -290,8 +346,8 @@ inline uint32_t buildLightBuffer(const World& world,
                                   const glm::mat4& viewProjMatrix,
                                   float cullRadius = 100.0f) {
 
-    // Collect all lights
-    LightCollectionResult collected = collectLights(world, cameraPos, cameraFront);
+    // Collect candidate lights (only nearby ones when the spatial index exists)
+    LightCollectionResult collected = collectLightsNear(world, cameraPos, cameraFront, cullRadius);
 
     // Merge all lights into a single list for sorting
     std::vector<CollectedLight> allLights;
@@ -316,26 +372,53 @@ inline uint32_t buildLightBuffer(const World& world,
         allLights.push_back(light);
     }
 
-    // Sort by effective weight (descending)
-    std::sort(allLights.begin(), allLights.end(),
-        [](const CollectedLight& a, const CollectedLight& b) {
-            return a.effectiveWeight > b.effectiveWeight;
-        });
+    return writeLightBuffer(allLights, buffer);
+}
 
-    // Write to buffer (up to MAX_LIGHTS)
-    uint32_t count = static_cast<uint32_t>(std::min(allLights.size(), static_cast<size_t>(MAX_LIGHTS)));
-    buffer.lightCount = glm::uvec4(count, 0, 0, 0);
+// Build GPU light buffer through clustered assignment: the gathered point and
+// spot lights are binned into the grid's per-cluster lists, and lights that
+// touch no cluster of the view (outside the frustum or past the grid's depth
+// range) are culled. clusters keeps its lists and last frame's assignment.
+// Returns number of lights written to buffer
+inline uint32_t buildLightBuffer(const World& world,
+                                  LightBuffer& buffer,
+                                  LightClusterGrid& clusters,
+                                  const glm::vec3& cameraPos,
+                                  const glm::vec3& cameraFront,
+                                  const glm::mat4& viewMatrix,
+                                  const glm::mat4& projectionMatrix,
+                                  float cullRadius = 100.0f) {
 
-    for (uint32_t i = 0; i < count; i++) {
-        buffer.lights[i] = allLights[i].light.toGPU();
+    LightCollectionResult collected = collectLightsNear(world, cameraPos, cameraFront, cullRadius);
+
+    // Point then spot lights; cluster light i is positional[i]
+    std::vector<CollectedLight> positional;
+    positional.reserve(collected.pointLights.size() + collected.spotLights.size());
+    positional.insert(positional.end(), collected.pointLights.begin(), collected.pointLights.end());
+    positional.insert(positional.end(), collected.spotLights.begin(), collected.spotLights.end());
+
+    std::vector<ClusterLight> clusterLights(positional.size());
+    for (size_t i = 0; i < positional.size(); ++i) {
+        const Light& light = positional[i].light;
+        ClusterLight& clusterLight = clusterLights[i];
+        clusterLight.position = light.position;
+        clusterLight.radius = light.radius;
+        clusterLight.id = static_cast<uint32_t>(entt::to_integral(positional[i].entity));
+        if (light.type == ::LightType::Spot) {
+            clusterLight.direction = glm::normalize(light.getDirection());
+            clusterLight.cosOuterCone = glm::cos(glm::radians(light.outerConeAngle));
+        }
     }
+    clusters.assign(viewMatrix, projectionMatrix, clusterLights);
 
-    // Zero out unused slots
-    for (uint32_t i = count; i < MAX_LIGHTS; i++) {
-        buffer.lights[i] = GPULight{};
+    std::vector<CollectedLight> allLights;
+    allLights.reserve(collected.directionalLights.size() + positional.size());
+    allLights.insert(allLights.end(), collected.directionalLights.begin(), collected.directionalLights.end());
+    for (size_t i = 0; i < positional.size(); ++i) {
+        if (clusters.lightClusterCount(static_cast<uint32_t>(i)) > 0) allLights.push_back(positional[i]);
     }
 
-    return count;
+    return writeLightBuffer(allLights, buffer);
 }
 
 // =============================================================================
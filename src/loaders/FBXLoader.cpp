@@ -2,6 +2,7 @@
 #include "FBXPostProcess.h"
 #include "SkinnedMesh.h"
 #include "Animation.h"
+#include "LoaderCache.h"
 #include <SDL3/SDL_log.h>
 #include <fstream>
 #include <vector>
@@ -283,13 +284,9 @@ MaterialInfo extractMaterialInfo(const ofbx::Material* mat, const std::string& f
 
 } // anonymous namespace
 
-std::optional<GLTFSkinnedLoadResult> loadSkinned(const std::string& path, const FBXImportSettings& settings) {
-    auto fileData = readFile(path);
-    if (fileData.empty()) {
-        SDL_Log("FBXLoader: Failed to read file: %s", path.c_str());
-        return std::nullopt;
-    }
-
+// Parse and post-process; loadSkinned() only gets here on a cache miss
+static std::optional<GLTFSkinnedLoadResult> importSkinned(const std::string& path, const std::vector<uint8_t>& fileData,
+                                                          const FBXImportSettings& settings) {
     ScenePtr scene(ofbx::load(
         fileData.data(),
         static_cast<ofbx::usize>(fileData.size()),
@@ -768,6 +765,19 @@ std::optional<GLTFSkinnedLoadResult> loadSkinned(const std::string& path, const
     return result;
 }
 
+std::optional<GLTFSkinnedLoadResult> loadSkinned(const std::string& path, const FBXImportSettings& settings) {
+    auto fileData = readFile(path);
+    if (fileData.empty()) {
+        SDL_Log("FBXLoader: Failed to read file: %s", path.c_str());
+        return std::nullopt;
+    }
+
+    DerivedDataKey key("fbx-skinned-v1");
+    key.bytes(fileData.data(), fileData.size());
+    LoaderCache::addSettings(key, settings);
+    return LoaderCache::fetchSkinned(key, path, [&]() { return importSkinned(path, fileData, settings); });
+}
+
 std::optional<GLTFLoadResult> load(const std::string& path, const FBXImportSettings& settings) {
     auto skinned = loadSkinned(path, settings);
     if (!skinned) {
@@ -795,15 +805,10 @@ std::optional<GLTFLoadResult> load(const std::string& path, const FBXImportSetti
     return result;
 }
 
-std::vector<AnimationClip> loadAnimations(const std::string& path, const Skeleton& skeleton, const FBXImportSettings& settings) {
+static std::vector<AnimationClip> importAnimations(const std::string& path, const std::vector<uint8_t>& fileData,
+                                                  const Skeleton& skeleton, const FBXImportSettings& settings) {
     std::vector<AnimationClip> result;
 
-    auto fileData = readFile(path);
-    if (fileData.empty()) {
-        SDL_Log("FBXLoader: Failed to read animation file: %s", path.c_str());
-        return result;
-    }
-
     ScenePtr scene(ofbx::load(
         fileData.data(),
         static_cast<ofbx::usize>(fileData.size()),
@@ -1068,4 +1073,18 @@ std::vector<AnimationClip> loadAnimations(const std::string& path, const Skeleto
     return result;
 }
 
+std::vector<AnimationClip> loadAnimations(const std::string& path, const Skeleton& skeleton, const FBXImportSettings& settings) {
+    auto fileData = readFile(path);
+    if (fileData.empty()) {
+        SDL_Log("FBXLoader: Failed to read animation file: %s", path.c_str());
+        return {};
+    }
+
+    DerivedDataKey key("fbx-animations-v1");
+    key.bytes(fileData.data(), fileData.size());
+    LoaderCache::addSettings(key, settings);
+    LoaderCache::addSkeleton(key, skeleton);
+    return LoaderCache::fetchAnimations(key, path, [&]() { return importAnimations(path, fileData, skeleton, settings); });
+}
+
 } // namespace FBXLoader
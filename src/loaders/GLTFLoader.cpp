@@ -1,6 +1,7 @@
 #include "GLTFLoader.h"
 #include "SkinnedMesh.h"
 #include "Animation.h"
+#include "LoaderCache.h"
 #include <fastgltf/core.hpp>
 #include <fastgltf/types.hpp>
 #include <fastgltf/tools.hpp>
@@ -329,7 +330,8 @@ std::optional<GLTFLoadResult> loadMeshOnly(const std::string& path) {
     return result;
 }
 
-std::optional<GLTFSkinnedLoadResult> loadSkinned(const std::string& path) {
+// fastgltf import behind loadSkinned()
+static std::optional<GLTFSkinnedLoadResult> importSkinned(const std::string& path) {
     fastgltf::Parser parser;
 
     std::filesystem::path filePath(path);
@@ -750,6 +752,22 @@ std::optional<GLTFSkinnedLoadResult> loadSkinned(const std::string& path) {
     return result;
 }
 
+std::optional<GLTFSkinnedLoadResult> loadSkinned(const std::string& path) {
+    // Only binary glTF is self-contained - a .gltf's external buffers aren't
+    // part of the key, so those always import
+    std::string extension = std::filesystem::path(path).extension().string();
+    if (extension != ".glb" && extension != ".GLB") {
+        return importSkinned(path);
+    }
+
+    DerivedDataKey key("gltf-skinned-v1");
+    key.file(path);
+    if (!key.isValid()) {
+        return importSkinned(path);     // Let the importer report the missing file
+    }
+    return LoaderCache::fetchSkinned(key, path, [&]() { return importSkinned(path); });
+}
+
 } // namespace GLTFLoader
 
 void Skeleton::computeGlobalTransforms(std::vector<glm::mat4>& outGlobalTransforms) const {
@@ -0,0 +1,234 @@
+#include "LoaderCache.h"
+#include "SkinnedMesh.h"
+#include "Animation.h"
+#include <SDL3/SDL_log.h>
+#include <chrono>
+
+namespace LoaderCache {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+float elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+template<typename T>
+void writeSampler(BlobWriter& out, const AnimationSampler<T>& sampler) {
+    out.writeVector(sampler.times);
+    out.writeVector(sampler.values);
+}
+
+template<typename T>
+bool readSampler(BlobReader& in, AnimationSampler<T>& sampler) {
+    return in.readVector(sampler.times) && in.readVector(sampler.values);
+}
+
+void writeSkeleton(BlobWriter& out, const Skeleton& skeleton) {
+    out.write(static_cast<uint64_t>(skeleton.joints.size()));
+    for (const Joint& joint : skeleton.joints) {
+        out.writeString(joint.name);
+        out.write(joint.parentIndex);
+        out.write(joint.inverseBindMatrix);
+        out.write(joint.localTransform);
+        out.write(joint.preRotation);
+    }
+    out.write(static_cast<uint8_t>(skeleton.hasHierarchy() ? 1 : 0));
+}
+
+bool readSkeleton(BlobReader& in, Skeleton& skeleton) {
+    uint64_t count = 0;
+    if (!in.readCount(count, sizeof(int32_t))) return false;
+    skeleton.joints.resize(static_cast<size_t>(count));
+    for (Joint& joint : skeleton.joints) {
+        if (!in.readString(joint.name) || !in.read(joint.parentIndex) ||
+            !in.read(joint.inverseBindMatrix) || !in.read(joint.localTransform) ||
+            !in.read(joint.preRotation)) {
+            return false;
+        }
+    }
+    uint8_t hierarchy = 0;
+    if (!in.read(hierarchy)) return false;
+    if (hierarchy) {
+        skeleton.buildHierarchy();
+    }
+    return true;
+}
+
+void writeMaterials(BlobWriter& out, const std::vector<MaterialInfo>& materials) {
+    out.write(static_cast<uint64_t>(materials.size()));
+    for (const MaterialInfo& mat : materials) {
+        out.writeString(mat.name);
+        out.write(mat.diffuseColor);
+        out.write(mat.specularColor);
+        out.write(mat.emissiveColor);
+        out.write(mat.roughness);
+        out.write(mat.metallic);
+        out.write(mat.opacity);
+        out.write(mat.emissiveFactor);
+        out.writeString(mat.diffuseTexturePath);
+        out.writeString(mat.normalTexturePath);
+        out.writeString(mat.specularTexturePath);
+        out.writeString(mat.emissiveTexturePath);
+        out.write(mat.startIndex);
+        out.write(mat.indexCount);
+    }
+}
+
+bool readMaterials(BlobReader& in, std::vector<MaterialInfo>& materials) {
+    uint64_t count = 0;
+    if (!in.readCount(count, sizeof(uint64_t))) return false;
+    materials.resize(static_cast<size_t>(count));
+    for (MaterialInfo& mat : materials) {
+        if (!in.readString(mat.name) || !in.read(mat.diffuseColor) || !in.read(mat.specularColor) ||
+            !in.read(mat.emissiveColor) || !in.read(mat.roughness) || !in.read(mat.metallic) ||
+            !in.read(mat.opacity) || !in.read(mat.emissiveFactor) ||
+            !in.readString(mat.diffuseTexturePath) || !in.readString(mat.normalTexturePath) ||
+            !in.readString(mat.specularTexturePath) || !in.readString(mat.emissiveTexturePath) ||
+            !in.read(mat.startIndex) || !in.read(mat.indexCount)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void writeClips(BlobWriter& out, const std::vector<AnimationClip>& clips) {
+    out.write(static_cast<uint64_t>(clips.size()));
+    for (const AnimationClip& clip : clips) {
+        out.writeString(clip.name);
+        out.write(clip.duration);
+        out.write(static_cast<uint64_t>(clip.channels.size()));
+        for (const AnimationChannel& channel : clip.channels) {
+            out.write(channel.jointIndex);
+            writeSampler(out, channel.translation);
+            writeSampler(out, channel.rotation);
+            writeSampler(out, channel.scale);
+        }
+        out.write(clip.rootBoneIndex);
+        out.write(clip.rootMotionPerCycle);
+        out.write(static_cast<uint64_t>(clip.events.size()));
+        for (const AnimationEvent& event : clip.events) {
+            out.writeString(event.name);
+            out.write(event.time);
+            out.writeString(event.data);
+            out.write(event.intData);
+        }
+    }
+}
+
+bool readClips(BlobReader& in, std::vector<AnimationClip>& clips) {
+    uint64_t clipCount = 0;
+    if (!in.readCount(clipCount, sizeof(uint64_t))) return false;
+    clips.resize(static_cast<size_t>(clipCount));
+    for (AnimationClip& clip : clips) {
+        uint64_t channelCount = 0;
+        if (!in.readString(clip.name) || !in.read(clip.duration) ||
+            !in.readCount(channelCount, sizeof(int32_t))) {
+            return false;
+        }
+        clip.channels.resize(static_cast<size_t>(channelCount));
+        for (AnimationChannel& channel : clip.channels) {
+            if (!in.read(channel.jointIndex) || !readSampler(in, channel.translation) ||
+                !readSampler(in, channel.rotation) || !readSampler(in, channel.scale)) {
+                return false;
+            }
+        }
+        uint64_t eventCount = 0;
+        if (!in.read(clip.rootBoneIndex) || !in.read(clip.rootMotionPerCycle) ||
+            !in.readCount(eventCount, sizeof(float))) {
+            return false;
+        }
+        clip.events.resize(static_cast<size_t>(eventCount));
+        for (AnimationEvent& event : clip.events) {
+            if (!in.readString(event.name) || !in.read(event.time) ||
+                !in.readString(event.data) || !in.read(event.intData)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void addSettings(DerivedDataKey& key, const FBXImportSettings& settings) {
+    key.value(settings.scaleFactor)
+       .value(settings.sourceUpAxis)
+       .value(settings.sourceForwardAxis)
+       .value(settings.rotationCorrection)
+       .value(settings.flipUVs)
+       .value(settings.recalculateTangents);
+}
+
+void addSkeleton(DerivedDataKey& key, const Skeleton& skeleton) {
+    key.value(static_cast<uint64_t>(skeleton.joints.size()));
+    for (const Joint& joint : skeleton.joints) {
+        key.string(joint.name).value(joint.parentIndex);
+    }
+}
+
+std::optional<GLTFSkinnedLoadResult> fetchSkinned(
+    const DerivedDataKey& key, const std::string& path,
+    const std::function<std::optional<GLTFSkinnedLoadResult>()>& import) {
+    DerivedDataCache& cache = DerivedDataCache::instance();
+    auto start = Clock::now();
+
+    std::vector<uint8_t> blob;
+    if (cache.load(key, blob)) {
+        GLTFSkinnedLoadResult result;
+        BlobReader in(blob);
+        if (in.readVector(result.vertices) && in.readVector(result.indices) &&
+            readSkeleton(in, result.skeleton) && readClips(in, result.animations) &&
+            readMaterials(in, result.materials) && in.atEnd()) {
+            cache.recordLoad("Characters", true, elapsedMs(start));
+            SDL_Log("LoaderCache: %s from cache (%zu vertices, %zu joints, %zu clips)", path.c_str(),
+                    result.vertices.size(), result.skeleton.joints.size(), result.animations.size());
+            return result;
+        }
+        cache.remove(key);
+    }
+
+    std::optional<GLTFSkinnedLoadResult> result = import();
+    if (result && cache.isEnabled()) {
+        BlobWriter out;
+        out.writeVector(result->vertices);
+        out.writeVector(result->indices);
+        writeSkeleton(out, result->skeleton);
+        writeClips(out, result->animations);
+        writeMaterials(out, result->materials);
+        cache.store(key, out.data());
+    }
+    cache.recordLoad("Characters", false, elapsedMs(start));
+    return result;
+}
+
+std::vector<AnimationClip> fetchAnimations(
+    const DerivedDataKey& key, const std::string& path,
+    const std::function<std::vector<AnimationClip>()>& import) {
+    DerivedDataCache& cache = DerivedDataCache::instance();
+    auto start = Clock::now();
+
+    std::vector<uint8_t> blob;
+    if (cache.load(key, blob)) {
+        std::vector<AnimationClip> clips;
+        BlobReader in(blob);
+        if (readClips(in, clips) && in.atEnd() && !clips.empty()) {
+            cache.recordLoad("Animations", true, elapsedMs(start));
+            SDL_Log("LoaderCache: %s from cache (%zu clips)", path.c_str(), clips.size());
+            return clips;
+        }
+        cache.remove(key);
+    }
+
+    std::vector<AnimationClip> clips = import();
+    if (!clips.empty() && cache.isEnabled()) {
+        BlobWriter out;
+        writeClips(out, clips);
+        cache.store(key, out.data());
+    }
+    cache.recordLoad("Animations", false, elapsedMs(start));
+    return clips;
+}
+
+} // namespace LoaderCache
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "GLTFLoader.h"
+#include "FBXPostProcess.h"
+#include "core/asset/DerivedDataCache.h"
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct AnimationClip;
+
+// Derived data caching for the skinned mesh and animation importers, so a
+// warm start skips FBX/glTF parsing and FBXPostProcess entirely.
+// The import callbacks only run on a miss; their result is stored for the
+// next launch.
+namespace LoaderCache {
+    // Hash the settings that change the imported result (presetName doesn't)
+    void addSettings(DerivedDataKey& key, const FBXImportSettings& settings);
+
+    // Joint names and parents - animation channels are remapped onto them
+    void addSkeleton(DerivedDataKey& key, const Skeleton& skeleton);
+
+    std::optional<GLTFSkinnedLoadResult> fetchSkinned(
+        const DerivedDataKey& key, const std::string& path,
+        const std::function<std::optional<GLTFSkinnedLoadResult>()>& import);
+
+    // An empty result is treated as a failed import and not cached
+    std::vector<AnimationClip> fetchAnimations(
+        const DerivedDataKey& key, const std::string& path,
+        const std::function<std::vector<AnimationClip>()>& import);
+}
@@ -1,13 +1,32 @@
 #include "AsyncStartupLoader.h"
+#include "StartupTimeline.h"
 #include "../LoadingRenderer.h"
 #include "../vulkan/VulkanContext.h"
 #include <SDL3/SDL.h>
 #include <lodepng.h>
-#include <fstream>
+#include <algorithm>
 #include <filesystem>
 
 namespace Loading {
 
+namespace {
+
+// Rough single-core throughputs, only used to rank jobs by cost
+constexpr float PNG_DECODE_BYTES_PER_MS = 40.0f * 1024.0f;
+constexpr float FILE_READ_BYTES_PER_MS = 500.0f * 1024.0f;
+constexpr float MIN_JOB_MS = 0.5f;
+
+float estimateFromFileSize(const std::string& path, float bytesPerMs) {
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return MIN_JOB_MS;
+    }
+    return std::max(MIN_JOB_MS, static_cast<float>(size) / bytesPerMs);
+}
+
+} // namespace
+
 std::unique_ptr<AsyncStartupLoader> AsyncStartupLoader::create(const InitInfo& info) {
     auto loader = std::make_unique<AsyncStartupLoader>(ConstructToken{});
     if (!loader->init(info)) {
@@ -51,11 +70,17 @@ void AsyncStartupLoader::queueTextureLoad(const std::string& id, const std::stri
     job.id = id;
     job.phase = "Textures";
     job.priority = priority;
+    job.estimatedMs = estimateFromFileSize(fullPath, PNG_DECODE_BYTES_PER_MS);
     job.execute = [fullPath, srgb, id]() -> std::unique_ptr<StagedResource> {
+        IOResult file = readJobFile(fullPath);
+        if (!file.ok()) {
+            return nullptr;
+        }
+
         std::vector<unsigned char> pixels;
         unsigned width, height;
 
-        unsigned error = lodepng::decode(pixels, width, height, fullPath);
+        unsigned error = lodepng::decode(pixels, width, height, file.data);
         if (error != 0) {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
                         "Failed to load texture '%s': %s",
@@ -74,9 +99,7 @@ void AsyncStartupLoader::queueTextureLoad(const std::string& id, const std::stri
         return staged;
     };
 
-    jobQueue_->submit(std::move(job));
-    ++queuedJobCount_;
-    jobQueue_->setTotalJobs(queuedJobCount_);
+    queueJob(std::move(job));
 }
 
 void AsyncStartupLoader::queueHeightmapLoad(const std::string& id, const std::string& path,
@@ -87,12 +110,18 @@ void AsyncStartupLoader::queueHeightmapLoad(const std::string& id, const std::st
     job.id = id;
     job.phase = "Terrain";
     job.priority = priority;
+    job.estimatedMs = estimateFromFileSize(fullPath, PNG_DECODE_BYTES_PER_MS);
     job.execute = [fullPath, id]() -> std::unique_ptr<StagedResource> {
+        IOResult file = readJobFile(fullPath);
+        if (!file.ok()) {
+            return nullptr;
+        }
+
         std::vector<unsigned char> rawPixels;
         unsigned width, height;
 
         // Load as grayscale or RGBA
-        unsigned error = lodepng::decode(rawPixels, width, height, fullPath);
+        unsigned error = lodepng::decode(rawPixels, width, height, file.data);
         if (error != 0) {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
                         "Failed to load heightmap '%s': %s",
@@ -116,9 +145,7 @@ void AsyncStartupLoader::queueHeightmapLoad(const std::string& id, const std::st
         return staged;
     };
 
-    jobQueue_->submit(std::move(job));
-    ++queuedJobCount_;
-    jobQueue_->setTotalJobs(queuedJobCount_);
+    queueJob(std::move(job));
 }
 
 void AsyncStartupLoader::queueFileLoad(const std::string& id, const std::string& path,
@@ -129,33 +156,21 @@ void AsyncStartupLoader::queueFileLoad(const std::string& id, const std::string&
     job.id = id;
     job.phase = phase;
     job.priority = priority;
+    job.estimatedMs = estimateFromFileSize(fullPath, FILE_READ_BYTES_PER_MS);
     job.execute = [fullPath, id]() -> std::unique_ptr<StagedResource> {
-        std::ifstream file(fullPath, std::ios::binary | std::ios::ate);
-        if (!file.is_open()) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                        "Failed to open file '%s'", fullPath.c_str());
+        IOResult file = readJobFile(fullPath);
+        if (!file.ok()) {
             return nullptr;
         }
 
-        size_t size = static_cast<size_t>(file.tellg());
-        file.seekg(0, std::ios::beg);
-
         auto staged = std::make_unique<StagedBuffer>();
-        staged->data.resize(size);
+        staged->data = std::move(file.data);
         staged->name = id;
 
-        if (!file.read(reinterpret_cast<char*>(staged->data.data()), size)) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                        "Failed to read file '%s'", fullPath.c_str());
-            return nullptr;
-        }
-
         return staged;
     };
 
-    jobQueue_->submit(std::move(job));
-    ++queuedJobCount_;
-    jobQueue_->setTotalJobs(queuedJobCount_);
+    queueJob(std::move(job));
 }
 
 void AsyncStartupLoader::queueCustomJob(const std::string& id, const std::string& phase,
@@ -167,9 +182,68 @@ void AsyncStartupLoader::queueCustomJob(const std::string& id, const std::string
     job.priority = priority;
     job.execute = std::move(execute);
 
-    jobQueue_->submit(std::move(job));
+    queueJob(std::move(job));
+}
+
+void AsyncStartupLoader::queueMainThreadJob(const std::string& id, const std::string& phase,
+                                            std::function<bool()> work,
+                                            std::vector<std::string> dependencies,
+                                            float estimatedMs) {
+    LoadJob job;
+    job.id = id;
+    job.phase = phase;
+    job.dependencies = std::move(dependencies);
+    job.estimatedMs = estimatedMs;
+    mainThreadWork_[id] = std::move(work);
+
+    queueJob(std::move(job));
+}
+
+void AsyncStartupLoader::queueJob(LoadJob job) {
+    // Dependents wait for processCompletedJobs() to upload the result
+    job.finishOnMainThread = true;
+
     ++queuedJobCount_;
     jobQueue_->setTotalJobs(queuedJobCount_);
+
+    if (started_) {
+        jobQueue_->submit(std::move(job));
+    } else {
+        stagedJobs_.push_back(std::move(job));
+    }
+}
+
+LoadJob* AsyncStartupLoader::findStagedJob(const std::string& id) {
+    auto it = std::find_if(stagedJobs_.begin(), stagedJobs_.end(),
+                           [&id](const LoadJob& job) { return job.id == id; });
+    return it != stagedJobs_.end() ? &*it : nullptr;
+}
+
+void AsyncStartupLoader::addDependency(const std::string& id, const std::string& dependsOn) {
+    LoadJob* job = findStagedJob(id);
+    if (!job) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                    "AsyncStartupLoader: can't add dependency to '%s' (unknown or already started)", id.c_str());
+        return;
+    }
+    job->dependencies.push_back(dependsOn);
+}
+
+void AsyncStartupLoader::setEstimatedCost(const std::string& id, float estimatedMs) {
+    if (LoadJob* job = findStagedJob(id)) {
+        job->estimatedMs = estimatedMs;
+    }
+}
+
+void AsyncStartupLoader::start() {
+    if (started_) {
+        return;
+    }
+    started_ = true;
+
+    jobQueue_->submitBatch(std::move(stagedJobs_));
+    stagedJobs_.clear();
+    jobQueue_->validateDependencies();
 }
 
 void AsyncStartupLoader::setJobCompleteCallback(JobCompleteCallback callback) {
@@ -177,6 +251,7 @@ void AsyncStartupLoader::setJobCompleteCallback(JobCompleteCallback callback) {
 }
 
 void AsyncStartupLoader::runLoadingLoop() {
+    start();
     SDL_Log("Starting async loading loop with %u jobs", queuedJobCount_);
 
     while (!isComplete()) {
@@ -202,17 +277,46 @@ void AsyncStartupLoader::runLoadingLoop() {
 
     SDL_Log("Async loading complete: %llu bytes loaded",
             static_cast<unsigned long long>(jobQueue_->getProgress().bytesLoaded));
+    jobQueue_->logCriticalPath();
 }
 
 uint32_t AsyncStartupLoader::processCompletedJobs() {
+    start();
+
     auto results = jobQueue_->getCompletedJobs();
     uint32_t count = static_cast<uint32_t>(results.size());
 
-    for (auto& result : results) {
+    // Uploads on the longest remaining chain unblock the most
+    std::vector<std::pair<float, size_t>> order;
+    order.reserve(results.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        order.emplace_back(jobQueue_->getCriticalPathMs(results[i].jobId), i);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    for (const auto& [pathMs, index] : order) {
+        LoadJobResult& result = results[index];
+        auto start = StartupTimeline::Clock::now();
+
+        auto work = mainThreadWork_.find(result.jobId);
+        if (work != mainThreadWork_.end()) {
+            if (result.success && !work->second()) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                             "Startup job '%s' failed on the main thread", result.jobId.c_str());
+                result.success = false;
+                result.error = "main-thread work failed";
+            }
+            mainThreadWork_.erase(work);
+        }
+
         if (jobCompleteCallback_) {
             jobCompleteCallback_(result);
         }
 
+        StartupTimeline::instance().record(result.jobId, start, StartupTimeline::Clock::now());
+        jobQueue_->finishJob(result.jobId, result.success);
+
         // Store result for later retrieval if not consumed by callback
         if (result.resource) {
             collectedResults_.push_back(std::move(result));
@@ -223,6 +327,9 @@ uint32_t AsyncStartupLoader::processCompletedJobs() {
 }
 
 bool AsyncStartupLoader::isComplete() const {
+    if (!started_) {
+        return stagedJobs_.empty();
+    }
     return jobQueue_->isComplete();
 }
 
@@ -239,6 +346,8 @@ void AsyncStartupLoader::shutdown() {
         jobQueue_->shutdown();
         jobQueue_.reset();
     }
+    stagedJobs_.clear();
+    mainThreadWork_.clear();
     collectedResults_.clear();
 }
 
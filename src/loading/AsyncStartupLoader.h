@@ -6,6 +6,8 @@
 #include <functional>
 #include <string>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 class VulkanContext;
 class LoadingRenderer;
@@ -17,15 +19,24 @@ namespace Loading {
  *
  * This class coordinates between:
  * - Background worker threads (load data from disk to CPU staging)
- * - Main thread (GPU uploads + loading screen rendering)
+ * - Main thread (GPU uploads, dependent system init, loading screen)
+ *
+ * Jobs form a dependency graph. Jobs queued before start() are submitted
+ * together, so the scheduler knows every job's critical path (its cost
+ * plus its longest chain of dependents) and runs the longest chains first.
+ * A job's dependents wait for its main-thread stage - the completion
+ * callback - so an init that needs a texture starts as soon as that
+ * texture is uploaded, while the remaining files are still decoding.
+ * The loading bar follows the estimated remaining critical path.
  *
  * Usage:
- *   AsyncStartupLoader loader;
- *   loader.init(vulkanContext, loadingRenderer);
- *   loader.queueTextureLoad("diffuse", "textures/diffuse.png");
- *   loader.queueMeshLoad("character", "models/character.gltf");
- *   loader.runLoadingLoop();  // Blocks until all complete, renders loading screen
- *   // Now retrieve staged resources and upload to GPU
+ *   auto loader = AsyncStartupLoader::create(info);
+ *   loader->queueHeightmapLoad("height", "terrain/height.png");
+ *   loader->queueTextureLoad("albedo", "terrain/albedo.png");
+ *   loader->queueMainThreadJob("terrain", "Terrain", [&] { return initTerrain(); },
+ *                              {"height", "albedo"}, 40.0f);
+ *   loader->setJobCompleteCallback([&](LoadJobResult& r) { upload(r); });
+ *   loader->runLoadingLoop();  // Starts, renders the loading screen until done
  */
 class AsyncStartupLoader {
 public:
@@ -37,7 +48,7 @@ public:
         VulkanContext* vulkanContext = nullptr;
         LoadingRenderer* loadingRenderer = nullptr;  // Optional, for progress display
         std::string resourcePath;
-        uint32_t workerCount = 2;
+        uint32_t workerCount = 2;  // Concurrent jobs on the "LoadJobs" scheduler pool
     };
 
     /**
@@ -81,6 +92,34 @@ public:
                         std::function<std::unique_ptr<StagedResource>()> execute,
                         int priority = 0);
 
+    /**
+     * Queue main-thread work (typically a system init) that runs once its
+     * dependencies have been loaded and uploaded. Returning false fails the
+     * jobs that depend on it.
+     */
+    void queueMainThreadJob(const std::string& id, const std::string& phase,
+                            std::function<bool()> work,
+                            std::vector<std::string> dependencies = {},
+                            float estimatedMs = 1.0f);
+
+    /**
+     * Make a queued job wait for another. Only valid before start().
+     */
+    void addDependency(const std::string& id, const std::string& dependsOn);
+
+    /**
+     * Override a queued job's cost estimate (file jobs default to one
+     * derived from the file size). Only valid before start().
+     */
+    void setEstimatedCost(const std::string& id, float estimatedMs);
+
+    /**
+     * Submit the queued job graph. Jobs queued afterwards are submitted
+     * immediately. runLoadingLoop() and processCompletedJobs() start the
+     * loader if needed.
+     */
+    void start();
+
     /**
      * Set a callback to be invoked when a job completes (on main thread)
      * Use this to perform GPU uploads immediately when data is ready
@@ -95,7 +134,9 @@ public:
     void runLoadingLoop();
 
     /**
-     * Process any completed jobs without blocking
+     * Process any completed jobs without blocking: runs the completion
+     * callback and main-thread work, longest critical path first, then
+     * releases their dependents
      * Returns number of jobs processed
      */
     uint32_t processCompletedJobs();
@@ -126,6 +167,10 @@ private:
     // Helper to build full path
     std::string buildPath(const std::string& relativePath) const;
 
+    // Stage before start(), submit after
+    void queueJob(LoadJob job);
+    LoadJob* findStagedJob(const std::string& id);
+
     std::optional<std::reference_wrapper<LoadingRenderer>> loadingRenderer_;
     std::string resourcePath_;
 
@@ -133,6 +178,9 @@ private:
     JobCompleteCallback jobCompleteCallback_;
 
     uint32_t queuedJobCount_ = 0;
+    bool started_ = false;
+    std::vector<LoadJob> stagedJobs_;
+    std::unordered_map<std::string, std::function<bool()>> mainThreadWork_;
 
     // Collected results for deferred processing
     std::vector<LoadJobResult> collectedResults_;
@@ -1,7 +1,7 @@
 #include "AsyncSystemLoader.h"
+#include "StartupTimeline.h"
 #include "../LoadingRenderer.h"
 #include "../vulkan/VulkanContext.h"
-#include "../threading/TaskScheduler.h"
 #include <SDL3/SDL.h>
 #include <algorithm>
 
@@ -22,19 +22,12 @@ AsyncSystemLoader::~AsyncSystemLoader() {
 bool AsyncSystemLoader::init(const InitInfo& info) {
     loadingRenderer_ = info.loadingRenderer;
 
-    // Determine worker count
-    uint32_t workerCount = info.workerCount;
-    if (workerCount == 0) {
-        workerCount = std::max(1u, std::thread::hardware_concurrency() - 1);
-    }
-
-    // Start worker threads
     running_ = true;
-    for (uint32_t i = 0; i < workerCount; ++i) {
-        workers_.emplace_back(&AsyncSystemLoader::workerLoop, this);
-    }
+    pool_ = TaskScheduler::instance().registerPool("SystemInit", TaskScheduler::Priority::Normal, info.workerCount);
+    concurrency_ = std::max(1u, TaskScheduler::instance().getPoolConcurrency(pool_));
 
-    SDL_Log("AsyncSystemLoader initialized with %u workers", workerCount);
+    SDL_Log("AsyncSystemLoader initialized (%u concurrent CPU tasks)",
+            TaskScheduler::instance().getPoolConcurrency(pool_));
     return true;
 }
 
@@ -50,7 +43,10 @@ void AsyncSystemLoader::addTask(SystemInitTask task) {
         }
     }
 
-    totalWeight_ = totalWeight_.load() + task.weight;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        graph_.addNode(id, task.weight, task.dependencies);
+    }
     tasks_[id] = std::move(task);
     taskOrder_.push_back(id);
     pendingTasks_.insert(id);
@@ -60,111 +56,105 @@ void AsyncSystemLoader::start() {
     SDL_Log("AsyncSystemLoader starting with %zu tasks", tasks_.size());
 
     // Schedule tasks whose dependencies are already satisfied
-    scheduleReadyTasks();
+    std::vector<std::string> readyTasks;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        graph_.validate();
+        readyTasks = graph_.takeReady();
+    }
+    scheduleReadyTasks(readyTasks);
 }
 
-void AsyncSystemLoader::scheduleReadyTasks() {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-
-    // Find pending tasks with satisfied dependencies
-    std::vector<std::string> readyTasks;
-    for (const auto& taskId : pendingTasks_) {
-        if (areDependenciesSatisfied(taskId)) {
-            readyTasks.push_back(taskId);
-        }
+void AsyncSystemLoader::scheduleReadyTasks(const std::vector<std::string>& readyTasks) {
+    if (readyTasks.empty()) {
+        return;
     }
 
+    std::unique_lock<std::mutex> lock(queueMutex_);
+
     // Move to running and queue for CPU work
     for (const auto& taskId : readyTasks) {
         pendingTasks_.erase(taskId);
         cpuRunningTasks_.insert(taskId);
-        cpuWorkQueue_.push(taskId);
-
-        // Update progress display
-        {
-            std::lock_guard<std::mutex> progressLock(progressMutex_);
-            currentPhase_ = tasks_[taskId].displayName;
-        }
+        cpuWorkQueue_.push_back(taskId);
     }
 
-    if (!readyTasks.empty()) {
-        queueCondition_.notify_all();
+    // Update progress display with the task startup is waiting on most
+    {
+        std::lock_guard<std::mutex> progressLock(progressMutex_);
+        currentPhase_ = tasks_[readyTasks.front()].displayName;
     }
-}
 
-bool AsyncSystemLoader::areDependenciesSatisfied(const std::string& taskId) const {
-    const auto& task = tasks_.at(taskId);
-    for (const auto& dep : task.dependencies) {
-        if (completeTasks_.find(dep) == completeTasks_.end()) {
-            return false;
-        }
+    // Submit outside the lock: without a running scheduler the work runs here
+    lock.unlock();
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    for (size_t i = 0; i < readyTasks.size(); ++i) {
+        scheduler.submit(pool_, [this] { runNextCpuTask(); }, &cpuTasks_);
     }
-    return true;
 }
 
-void AsyncSystemLoader::workerLoop() {
-    while (running_) {
-        std::string taskId;
-
-        // Wait for work
-        {
-            std::unique_lock<std::mutex> lock(queueMutex_);
-            queueCondition_.wait(lock, [this] {
-                return !cpuWorkQueue_.empty() || !running_;
-            });
-
-            if (!running_ && cpuWorkQueue_.empty()) {
-                return;
-            }
+std::string AsyncSystemLoader::takeLongestPathLocked(std::vector<std::string>& ids) const {
+    auto best = std::max_element(ids.begin(), ids.end(), [this](const std::string& a, const std::string& b) {
+        return graph_.criticalPathMs(a) < graph_.criticalPathMs(b);
+    });
+    std::string id = std::move(*best);
+    ids.erase(best);
+    return id;
+}
 
-            if (cpuWorkQueue_.empty()) {
-                continue;
-            }
+void AsyncSystemLoader::runNextCpuTask() {
+    std::string taskId;
 
-            taskId = cpuWorkQueue_.front();
-            cpuWorkQueue_.pop();
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (!running_ || cpuWorkQueue_.empty()) {
+            return;
         }
 
-        // Execute CPU work
-        auto& task = tasks_[taskId];
-        bool success = true;
+        taskId = takeLongestPathLocked(cpuWorkQueue_);
+        graph_.markStarted(taskId);
+    }
 
-        if (task.cpuWork) {
-            SDL_Log("AsyncSystemLoader: Starting CPU work for '%s'", taskId.c_str());
-            try {
-                success = task.cpuWork();
-            } catch (const std::exception& e) {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                            "AsyncSystemLoader: CPU work for '%s' threw exception: %s",
-                            taskId.c_str(), e.what());
-                success = false;
-            }
+    // Execute CPU work
+    auto& task = tasks_[taskId];
+    bool success = true;
+
+    if (task.cpuWork) {
+        SDL_Log("AsyncSystemLoader: Starting CPU work for '%s'", taskId.c_str());
+        ScopedStartupSpan span(task.displayName);
+        try {
+            success = task.cpuWork();
+        } catch (const std::exception& e) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                        "AsyncSystemLoader: CPU work for '%s' threw exception: %s",
+                        taskId.c_str(), e.what());
+            success = false;
+        }
 
-            if (!success) {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                            "AsyncSystemLoader: CPU work failed for '%s'",
-                            taskId.c_str());
+        if (!success) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                        "AsyncSystemLoader: CPU work failed for '%s'",
+                        taskId.c_str());
 
-                std::lock_guard<std::mutex> errorLock(errorMutex_);
-                hasError_ = true;
-                errorMessage_ = "CPU work failed for task: " + taskId;
-                return;
-            }
-            SDL_Log("AsyncSystemLoader: CPU work complete for '%s'", taskId.c_str());
+            std::lock_guard<std::mutex> errorLock(errorMutex_);
+            hasError_ = true;
+            errorMessage_ = "CPU work failed for task: " + taskId;
+            return;
         }
+        SDL_Log("AsyncSystemLoader: CPU work complete for '%s'", taskId.c_str());
+    }
 
-        // Mark CPU work complete
-        {
-            std::lock_guard<std::mutex> lock(queueMutex_);
-            cpuRunningTasks_.erase(taskId);
-            cpuCompleteTasks_.insert(taskId);
-        }
+    // Mark CPU work complete
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        cpuRunningTasks_.erase(taskId);
+        cpuCompleteTasks_.insert(taskId);
+    }
 
-        // Queue for main thread GPU work
-        {
-            std::lock_guard<std::mutex> lock(completedMutex_);
-            cpuCompletedQueue_.push(taskId);
-        }
+    // Queue for main thread GPU work
+    {
+        std::lock_guard<std::mutex> lock(completedMutex_);
+        cpuCompletedQueue_.push_back(taskId);
     }
 }
 
@@ -180,8 +170,8 @@ uint32_t AsyncSystemLoader::pollCompletions() {
             if (cpuCompletedQueue_.empty()) {
                 break;
             }
-            taskId = cpuCompletedQueue_.front();
-            cpuCompletedQueue_.pop();
+            std::lock_guard<std::mutex> queueLock(queueMutex_);
+            taskId = takeLongestPathLocked(cpuCompletedQueue_);
         }
 
         // Execute GPU work on main thread
@@ -190,6 +180,7 @@ uint32_t AsyncSystemLoader::pollCompletions() {
 
         if (task.gpuWork) {
             SDL_Log("AsyncSystemLoader: Starting GPU work for '%s'", taskId.c_str());
+            ScopedStartupSpan span(task.displayName);
             try {
                 success = task.gpuWork();
             } catch (const std::exception& e) {
@@ -213,17 +204,18 @@ uint32_t AsyncSystemLoader::pollCompletions() {
         }
 
         // Mark fully complete
+        std::vector<std::string> readyTasks;
         {
             std::lock_guard<std::mutex> lock(queueMutex_);
             cpuCompleteTasks_.erase(taskId);
             completeTasks_.insert(taskId);
+            readyTasks = graph_.markFinished(taskId);
         }
 
-        completedWeight_ = completedWeight_.load() + task.weight;
         ++completed;
 
         // Schedule any newly-ready tasks
-        scheduleReadyTasks();
+        scheduleReadyTasks(readyTasks);
     }
 
     return completed;
@@ -262,11 +254,7 @@ SystemLoadProgress AsyncSystemLoader::getProgress() const {
     {
         std::lock_guard<std::mutex> lock(queueMutex_);
         progress.completedTasks = static_cast<uint32_t>(completeTasks_.size());
-    }
-
-    float total = totalWeight_.load();
-    if (total > 0.0f) {
-        progress.progress = completedWeight_.load() / total;
+        progress.progress = graph_.progress(concurrency_);
     }
 
     {
@@ -310,19 +298,36 @@ void AsyncSystemLoader::runLoadingLoop() {
     } else {
         SDL_Log("AsyncSystemLoader: Loading complete (%u tasks)",
                 finalProgress.completedTasks);
+        logCriticalPath();
     }
 }
 
-void AsyncSystemLoader::shutdown() {
-    running_ = false;
-    queueCondition_.notify_all();
+void AsyncSystemLoader::logCriticalPath() const {
+    std::vector<StartupGraph::PathEntry> path;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        path = graph_.criticalPath();
+    }
+    if (path.empty()) {
+        return;
+    }
 
-    for (auto& worker : workers_) {
-        if (worker.joinable()) {
-            worker.join();
-        }
+    std::string chain;
+    float actualMs = 0.0f;
+    for (const auto& entry : path) {
+        chain += (chain.empty() ? "" : " -> ") + entry.id;
+        actualMs += std::max(0.0f, entry.actualMs);
+    }
+    SDL_Log("AsyncSystemLoader: critical path %s (%.1f ms)", chain.c_str(), actualMs);
+}
+
+void AsyncSystemLoader::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        running_ = false;
+        cpuWorkQueue_.clear();
     }
-    workers_.clear();
+    cpuTasks_.wait();
 
     tasks_.clear();
     taskOrder_.clear();
@@ -330,6 +335,8 @@ void AsyncSystemLoader::shutdown() {
     cpuRunningTasks_.clear();
     cpuCompleteTasks_.clear();
     completeTasks_.clear();
+    cpuCompletedQueue_.clear();
+    graph_ = StartupGraph{};
 }
 
 } // namespace Loading
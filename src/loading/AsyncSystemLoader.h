@@ -1,13 +1,12 @@
 #pragma once
 
+#include "core/threading/TaskScheduler.h"
+#include "StartupGraph.h"
 #include <atomic>
-#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
-#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -30,7 +29,7 @@ struct SystemInitTask {
     std::string displayName;           // Human-readable name for progress display
     std::vector<std::string> dependencies;  // IDs of tasks this depends on
 
-    // CPU work - runs on background thread
+    // CPU work - runs on a scheduler worker
     // Returns true on success, false on failure
     // Can be nullptr if no CPU work needed
     std::function<bool()> cpuWork;
@@ -40,7 +39,8 @@ struct SystemInitTask {
     // Can be nullptr if no GPU work needed
     std::function<bool()> gpuWork;
 
-    // Progress weight (relative to other tasks, default 1.0)
+    // Relative cost estimate (default 1.0). Ranks ready tasks by critical
+    // path and drives the progress estimate.
     float weight = 1.0f;
 };
 
@@ -61,8 +61,11 @@ struct SystemLoadProgress {
  *
  * Design:
  * - Tasks declare dependencies on other tasks
- * - CPU work runs on background threads when dependencies are satisfied
+ * - CPU work runs on the "SystemInit" TaskScheduler pool when dependencies are satisfied
  * - GPU work runs on main thread after CPU work completes
+ * - Both stages pick the task with the longest critical path (its weight
+ *   plus its heaviest chain of dependents) first; progress is the
+ *   estimated remaining critical path
  * - Main thread polls for completions and can render loading screen between polls
  *
  * Usage:
@@ -92,7 +95,7 @@ public:
     struct InitInfo {
         VulkanContext* vulkanContext = nullptr;
         LoadingRenderer* loadingRenderer = nullptr;  // Optional, for progress display
-        uint32_t workerCount = 0;  // 0 = auto (hardware concurrency - 1)
+        uint32_t workerCount = 0;  // Concurrent CPU tasks (0 = every scheduler worker)
     };
 
     /**
@@ -151,6 +154,11 @@ public:
      */
     void runLoadingLoop();
 
+    /**
+     * Log the chain of tasks that bounded startup, estimated vs actual
+     */
+    void logCriticalPath() const;
+
     /**
      * Shutdown and release resources
      */
@@ -158,9 +166,11 @@ public:
 
 private:
     bool init(const InitInfo& info);
-    void workerLoop();
-    void scheduleReadyTasks();
-    bool areDependenciesSatisfied(const std::string& taskId) const;
+    void runNextCpuTask();
+    void scheduleReadyTasks(const std::vector<std::string>& readyTasks);
+
+    // Remove and return the entry with the longest critical path (queueMutex_ held)
+    std::string takeLongestPathLocked(std::vector<std::string>& ids) const;
 
     // Task storage
     std::unordered_map<std::string, SystemInitTask> tasks_;
@@ -172,22 +182,22 @@ private:
     std::unordered_set<std::string> cpuCompleteTasks_;  // CPU done, awaiting GPU work
     std::unordered_set<std::string> completeTasks_;     // Fully complete
 
-    // Worker threads
-    std::vector<std::thread> workers_;
+    // Scheduler pool running CPU work; one task per ready task ID
+    TaskScheduler::PoolId pool_ = 0;
+    uint32_t concurrency_ = 1;
+    TaskGroup cpuTasks_;
     std::atomic<bool> running_{false};
 
-    // Work queue for CPU tasks
+    // Work queue for CPU tasks, and the dependency graph (both under queueMutex_)
     mutable std::mutex queueMutex_;
-    std::queue<std::string> cpuWorkQueue_;  // Task IDs ready for CPU work
-    std::condition_variable queueCondition_;
+    std::vector<std::string> cpuWorkQueue_;  // Task IDs ready for CPU work
+    mutable StartupGraph graph_;  // Mutable: progress() only ratchets its high-water mark
 
     // Completed CPU tasks ready for GPU work (main thread consumption)
     mutable std::mutex completedMutex_;
-    std::queue<std::string> cpuCompletedQueue_;
+    std::vector<std::string> cpuCompletedQueue_;
 
     // Progress tracking
-    std::atomic<float> totalWeight_{0.0f};
-    std::atomic<float> completedWeight_{0.0f};
     mutable std::mutex progressMutex_;
     std::string currentPhase_;
 
@@ -3,10 +3,11 @@
 #include "../vulkan/VmaImage.h"
 #include "../vulkan/CommandBufferUtils.h"
 #include "../ImageBuilder.h"
+#include "core/asset/DerivedDataCache.h"
 #include <SDL3/SDL_log.h>
 #include <vulkan/vulkan.hpp>
 #include <stb_image.h>
-#include <fstream>
+#include <chrono>
 #include <cstring>
 
 namespace Loading {
@@ -18,8 +19,39 @@ LoadJob LoadJobFactory::createTextureJob(const std::string& id, const std::strin
     job.phase = "Textures";
     job.priority = priority;
     job.execute = [path, srgb, id]() -> std::unique_ptr<StagedResource> {
+        auto start = std::chrono::steady_clock::now();
+        auto elapsedMs = [&start]() {
+            return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        IOResult file = readJobFile(path);
+        if (!file.ok()) {
+            return nullptr;
+        }
+
+        auto staged = std::make_unique<StagedTexture>();
+        staged->channels = 4;
+        staged->srgb = srgb;
+        staged->name = id;
+
+        // Decoded RGBA keyed on the encoded bytes
+        DerivedDataCache& cache = DerivedDataCache::instance();
+        DerivedDataKey key("staged-texture-v1");
+        key.bytes(file.data.data(), file.data.size());
+        std::vector<uint8_t> blob;
+        if (cache.load(key, blob)) {
+            BlobReader in(blob);
+            if (in.read(staged->width) && in.read(staged->height) && in.readVector(staged->pixels) &&
+                in.atEnd() && staged->pixels.size() == static_cast<size_t>(staged->width) * staged->height * 4) {
+                cache.recordLoad("Textures", true, elapsedMs());
+                return staged;
+            }
+            cache.remove(key);
+        }
+
         int width, height, channels;
-        stbi_uc* pixels = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+        stbi_uc* pixels = stbi_load_from_memory(file.data.data(), static_cast<int>(file.data.size()),
+                                                &width, &height, &channels, STBI_rgb_alpha);
 
         if (!pixels) {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
@@ -27,12 +59,8 @@ LoadJob LoadJobFactory::createTextureJob(const std::string& id, const std::strin
             return nullptr;
         }
 
-        auto staged = std::make_unique<StagedTexture>();
         staged->width = static_cast<uint32_t>(width);
         staged->height = static_cast<uint32_t>(height);
-        staged->channels = 4;
-        staged->srgb = srgb;
-        staged->name = id;
 
         size_t dataSize = width * height * 4;
         staged->pixels.resize(dataSize);
@@ -40,6 +68,15 @@ LoadJob LoadJobFactory::createTextureJob(const std::string& id, const std::strin
 
         stbi_image_free(pixels);
 
+        if (cache.isEnabled()) {
+            BlobWriter out;
+            out.write(staged->width);
+            out.write(staged->height);
+            out.writeVector(staged->pixels);
+            cache.store(key, out.data());
+        }
+        cache.recordLoad("Textures", false, elapsedMs());
+
         SDL_Log("Loaded texture '%s': %dx%d", id.c_str(), width, height);
         return staged;
     };
@@ -54,10 +91,16 @@ LoadJob LoadJobFactory::createHeightmapJob(const std::string& id, const std::str
     job.phase = "Terrain";
     job.priority = priority;
     job.execute = [path, id]() -> std::unique_ptr<StagedResource> {
+        IOResult file = readJobFile(path);
+        if (!file.ok()) {
+            return nullptr;
+        }
+        const int fileSize = static_cast<int>(file.data.size());
+
         int width, height, channels;
 
         // Try loading as 16-bit first
-        stbi_us* pixels16 = stbi_load_16(path.c_str(), &width, &height, &channels, 1);
+        stbi_us* pixels16 = stbi_load_16_from_memory(file.data.data(), fileSize, &width, &height, &channels, 1);
         if (pixels16) {
             auto staged = std::make_unique<StagedHeightmap>();
             staged->width = static_cast<uint32_t>(width);
@@ -75,7 +118,7 @@ LoadJob LoadJobFactory::createHeightmapJob(const std::string& id, const std::str
         }
 
         // Fall back to 8-bit
-        stbi_uc* pixels8 = stbi_load(path.c_str(), &width, &height, &channels, 1);
+        stbi_uc* pixels8 = stbi_load_from_memory(file.data.data(), fileSize, &width, &height, &channels, 1);
         if (pixels8) {
             auto staged = std::make_unique<StagedHeightmap>();
             staged->width = static_cast<uint32_t>(width);
@@ -111,26 +154,16 @@ LoadJob LoadJobFactory::createFileJob(const std::string& id, const std::string&
     job.phase = phase;
     job.priority = priority;
     job.execute = [path, id]() -> std::unique_ptr<StagedResource> {
-        std::ifstream file(path, std::ios::binary | std::ios::ate);
-        if (!file.is_open()) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                        "Failed to open file '%s'", path.c_str());
+        IOResult file = readJobFile(path);
+        if (!file.ok()) {
             return nullptr;
         }
 
-        size_t size = static_cast<size_t>(file.tellg());
-        file.seekg(0, std::ios::beg);
-
+        size_t size = file.data.size();
         auto staged = std::make_unique<StagedBuffer>();
-        staged->data.resize(size);
+        staged->data = std::move(file.data);
         staged->name = id;
 
-        if (!file.read(reinterpret_cast<char*>(staged->data.data()), size)) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                        "Failed to read file '%s'", path.c_str());
-            return nullptr;
-        }
-
         SDL_Log("Loaded file '%s': %zu bytes", id.c_str(), size);
         return staged;
     };
@@ -1,11 +1,22 @@
 #include "LoadJobQueue.h"
+#include "StartupTimeline.h"
 #include <SDL3/SDL_log.h>
+#include <algorithm>
 
 namespace Loading {
 
-std::unique_ptr<LoadJobQueue> LoadJobQueue::create(uint32_t workerCount) {
+IOResult readJobFile(const std::string& path) {
+    IOResult file = IOService::instance().readFile(path, IOPriority::High);
+    if (!file.ok()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to read file '%s'", path.c_str());
+    }
+    return file;
+}
+
+std::unique_ptr<LoadJobQueue> LoadJobQueue::create(uint32_t workerCount, const std::string& poolName,
+                                                   TaskScheduler::Priority priority) {
     auto queue = std::make_unique<LoadJobQueue>(ConstructToken{});
-    if (!queue->init(workerCount)) {
+    if (!queue->init(workerCount, poolName, priority)) {
         return nullptr;
     }
     return queue;
@@ -15,34 +26,139 @@ LoadJobQueue::~LoadJobQueue() {
     shutdown();
 }
 
-bool LoadJobQueue::init(uint32_t workerCount) {
+bool LoadJobQueue::init(uint32_t workerCount, const std::string& poolName, TaskScheduler::Priority priority) {
     running_ = true;
+    pool_ = TaskScheduler::instance().registerPool(poolName, priority, std::max(1u, workerCount));
+    concurrency_ = std::max(1u, TaskScheduler::instance().getPoolConcurrency(pool_));
 
-    workers_.reserve(workerCount);
-    for (uint32_t i = 0; i < workerCount; ++i) {
-        workers_.emplace_back(&LoadJobQueue::workerLoop, this);
-    }
-
-    SDL_Log("LoadJobQueue initialized with %u workers", workerCount);
+    SDL_Log("LoadJobQueue initialized on pool '%s' (%u concurrent jobs)", poolName.c_str(),
+            TaskScheduler::instance().getPoolConcurrency(pool_));
     return true;
 }
 
 void LoadJobQueue::submit(LoadJob job) {
+    std::vector<LoadJob> jobs;
+    jobs.push_back(std::move(job));
+    submitBatch(std::move(jobs));
+}
+
+void LoadJobQueue::submitBatch(std::vector<LoadJob> jobs) {
+    size_t taskCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        std::vector<std::string> ids;
+        ids.reserve(jobs.size());
+        for (auto& job : jobs) {
+            if (!graph_.addNode(job.id, job.estimatedMs, job.dependencies)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Load job '%s' submitted twice", job.id.c_str());
+                pushResultLocked(job, false, "duplicate job id");
+                continue;
+            }
+            ids.push_back(job.id);
+            blockedJobs_.emplace(job.id, std::move(job));
+        }
+        taskCount = releaseLocked(std::move(ids));
+    }
+    submitTasks(taskCount);
+}
+
+void LoadJobQueue::finishJob(const std::string& jobId, bool success) {
+    size_t taskCount = 0;
     {
         std::lock_guard<std::mutex> lock(queueMutex_);
-        jobQueue_.push(std::move(job));
+        if (!graph_.contains(jobId) || graph_.getState(jobId) == StartupGraph::State::Finished) {
+            return;
+        }
+        taskCount = finishLocked(jobId, success);
     }
-    queueCondition_.notify_one();
+    submitTasks(taskCount);
 }
 
-void LoadJobQueue::submitBatch(std::vector<LoadJob> jobs) {
+uint32_t LoadJobQueue::validateDependencies() {
+    uint32_t removed = 0;
+    size_t taskCount = 0;
     {
         std::lock_guard<std::mutex> lock(queueMutex_);
-        for (auto& job : jobs) {
+        removed = graph_.validate();
+        if (removed > 0) {
+            std::vector<std::string> blocked;
+            for (const auto& [id, job] : blockedJobs_) {
+                blocked.push_back(id);
+            }
+            taskCount = releaseLocked(std::move(blocked));
+        }
+    }
+    submitTasks(taskCount);
+    return removed;
+}
+
+float LoadJobQueue::getCriticalPathMs(const std::string& jobId) const {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    return graph_.criticalPathMs(jobId);
+}
+
+size_t LoadJobQueue::releaseLocked(std::vector<std::string> ids) {
+    size_t taskCount = 0;
+    for (const std::string& id : ids) {
+        auto it = blockedJobs_.find(id);
+        if (it == blockedJobs_.end()) {
+            continue;
+        }
+        // Ids from markFinished() are already released; new submissions aren't
+        if (graph_.getState(id) == StartupGraph::State::Blocked && !graph_.takeIfReady(id)) {
+            continue;
+        }
+
+        LoadJob job = std::move(it->second);
+        blockedJobs_.erase(it);
+
+        auto failedDep = std::find_if(job.dependencies.begin(), job.dependencies.end(),
+                                      [this](const std::string& dep) { return failedJobs_.count(dep) != 0; });
+        if (failedDep != job.dependencies.end()) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Load job '%s' skipped: dependency '%s' failed",
+                        job.id.c_str(), failedDep->c_str());
+            pushResultLocked(job, false, "dependency '" + *failedDep + "' failed");
+            taskCount += finishLocked(job.id, false);
+        } else if (!job.execute) {
+            graph_.markStarted(job.id);
+            pushResultLocked(job, true, "");
+            if (!job.finishOnMainThread) {
+                taskCount += finishLocked(job.id, true);
+            }
+        } else {
+            job.criticalPathMs = graph_.criticalPathMs(job.id);
             jobQueue_.push(std::move(job));
+            ++taskCount;
         }
     }
-    queueCondition_.notify_all();
+    return taskCount;
+}
+
+size_t LoadJobQueue::finishLocked(const std::string& jobId, bool success) {
+    if (!success) {
+        failedJobs_.insert(jobId);
+    }
+    return releaseLocked(graph_.markFinished(jobId));
+}
+
+void LoadJobQueue::pushResultLocked(const LoadJob& job, bool success, const std::string& error) {
+    LoadJobResult result;
+    result.jobId = job.id;
+    result.phase = job.phase;
+    result.success = success;
+    result.error = error;
+    {
+        std::lock_guard<std::mutex> lock(resultsMutex_);
+        completedResults_.push_back(std::move(result));
+    }
+    ++completedJobs_;
+}
+
+void LoadJobQueue::submitTasks(size_t count) {
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    for (size_t i = 0; i < count; ++i) {
+        scheduler.submit(pool_, [this] { runNextJob(); }, &jobTasks_);
+    }
 }
 
 void LoadJobQueue::setTotalJobs(uint32_t count) {
@@ -58,7 +174,8 @@ std::vector<LoadJobResult> LoadJobQueue::getCompletedJobs() {
 
 bool LoadJobQueue::isComplete() const {
     std::lock_guard<std::mutex> lock(queueMutex_);
-    return jobQueue_.empty() && completedJobs_ >= totalJobs_;
+    return jobQueue_.empty() && blockedJobs_.empty() && graph_.allFinished() &&
+           completedJobs_ >= totalJobs_;
 }
 
 LoadProgress LoadJobQueue::getProgress() const {
@@ -67,6 +184,15 @@ LoadProgress LoadJobQueue::getProgress() const {
     progress.totalJobs = totalJobs_.load();
     progress.bytesLoaded = bytesLoaded_.load();
 
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (graph_.size() > 0) {
+            auto now = StartupGraph::Clock::now();
+            progress.estimatedRemainingMs = graph_.estimate(concurrency_, now).remainingMs;
+            progress.estimatedProgress = graph_.progress(concurrency_, now);
+        }
+    }
+
     {
         std::lock_guard<std::mutex> lock(progressMutex_);
         progress.currentPhase = currentPhase_;
@@ -83,86 +209,101 @@ void LoadJobQueue::waitForAll() {
 }
 
 void LoadJobQueue::shutdown() {
+    // Drop queued jobs first so their tasks find nothing to run
     {
         std::lock_guard<std::mutex> lock(queueMutex_);
         running_ = false;
-    }
-    queueCondition_.notify_all();
-
-    for (auto& worker : workers_) {
-        if (worker.joinable()) {
-            worker.join();
+        while (!jobQueue_.empty()) {
+            jobQueue_.pop();
         }
+        blockedJobs_.clear();
     }
-    workers_.clear();
+    jobTasks_.wait();
 
-    // Clear remaining jobs
+    SDL_Log("LoadJobQueue shutdown complete");
+}
+
+void LoadJobQueue::logCriticalPath() const {
+    std::vector<StartupGraph::PathEntry> path;
     {
         std::lock_guard<std::mutex> lock(queueMutex_);
-        while (!jobQueue_.empty()) {
-            jobQueue_.pop();
-        }
+        path = graph_.criticalPath();
+    }
+    if (path.size() < 2) {
+        return;
     }
 
-    SDL_Log("LoadJobQueue shutdown complete");
+    std::string chain;
+    float estimatedMs = 0.0f;
+    float actualMs = 0.0f;
+    for (const auto& entry : path) {
+        chain += (chain.empty() ? "" : " -> ") + entry.id;
+        estimatedMs += entry.estimatedMs;
+        actualMs += std::max(0.0f, entry.actualMs);
+    }
+    SDL_Log("Load critical path: %s (estimated %.1f ms, actual %.1f ms)", chain.c_str(), estimatedMs, actualMs);
 }
 
-void LoadJobQueue::workerLoop() {
-    while (true) {
-        LoadJob job;
+void LoadJobQueue::runNextJob() {
+    LoadJob job;
 
-        {
-            std::unique_lock<std::mutex> lock(queueMutex_);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (!running_ || jobQueue_.empty()) {
+            return;
+        }
 
-            queueCondition_.wait(lock, [this] {
-                return !running_ || !jobQueue_.empty();
-            });
+        job = std::move(const_cast<LoadJob&>(jobQueue_.top()));
+        jobQueue_.pop();
+        graph_.markStarted(job.id);
+    }
 
-            if (!running_ && jobQueue_.empty()) {
-                return;
-            }
+    // Update current job info for progress display
+    {
+        std::lock_guard<std::mutex> lock(progressMutex_);
+        currentPhase_ = job.phase;
+        currentJob_ = job.id;
+    }
 
-            if (jobQueue_.empty()) {
-                continue;
-            }
+    // Execute job outside of lock
+    LoadJobResult result;
+    result.jobId = job.id;
+    result.phase = job.phase;
 
-            job = std::move(const_cast<LoadJob&>(jobQueue_.top()));
-            jobQueue_.pop();
-        }
+    auto start = StartupTimeline::Clock::now();
+    try {
+        result.resource = job.execute();
+        result.success = (result.resource != nullptr);
 
-        // Update current job info for progress display
-        {
-            std::lock_guard<std::mutex> lock(progressMutex_);
-            currentPhase_ = job.phase;
-            currentJob_ = job.id;
+        if (result.resource) {
+            bytesLoaded_ += result.resource->getMemorySize();
         }
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.error = e.what();
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                    "Load job '%s' failed: %s", job.id.c_str(), e.what());
+    }
+    StartupTimeline::instance().record(job.id, start, StartupTimeline::Clock::now());
 
-        // Execute job outside of lock
-        LoadJobResult result;
-        result.jobId = job.id;
-        result.phase = job.phase;
+    bool success = result.success;
 
-        try {
-            result.resource = job.execute();
-            result.success = (result.resource != nullptr);
+    // Add to completed results
+    {
+        std::lock_guard<std::mutex> lock(resultsMutex_);
+        completedResults_.push_back(std::move(result));
+    }
 
-            if (result.resource) {
-                bytesLoaded_ += result.resource->getMemorySize();
-            }
-        } catch (const std::exception& e) {
-            result.success = false;
-            result.error = e.what();
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                        "Load job '%s' failed: %s", job.id.c_str(), e.what());
-        }
+    ++completedJobs_;
 
-        // Add to completed results
+    // A failed job has nothing to upload, so its dependents learn now
+    if (!success || !job.finishOnMainThread) {
+        size_t taskCount = 0;
         {
-            std::lock_guard<std::mutex> lock(resultsMutex_);
-            completedResults_.push_back(std::move(result));
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            taskCount = finishLocked(job.id, success);
         }
-
-        ++completedJobs_;
+        submitTasks(taskCount);
     }
 }
 
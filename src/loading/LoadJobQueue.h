@@ -2,8 +2,8 @@
 
 #include <queue>
 #include <mutex>
-#include <condition_variable>
-#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <atomic>
 #include <functional>
 #include <memory>
@@ -11,15 +11,20 @@
 #include <vector>
 #include <variant>
 #include "vegetation/TreeOptions.h"
+#include "core/io/IOService.h"
+#include "core/threading/TaskScheduler.h"
+#include "StartupGraph.h"
 
 /**
  * LoadJobQueue - Generic async job queue for startup loading
  *
  * Design:
- * - Worker threads execute jobs that produce CPU-side staged data
+ * - Jobs run on a TaskScheduler pool and produce CPU-side staged data
  * - Main thread polls for completed jobs and performs GPU uploads
- * - Jobs are prioritized (lower value = higher priority)
- * - Progress tracking for loading screen updates
+ * - Jobs may depend on other jobs; a job is held back until they finish
+ * - Ready jobs run by priority (lower value = higher priority), then
+ *   longest critical path first
+ * - Progress is estimated from the critical path, not the job count
  *
  * Pattern matches VirtualTextureTileLoader but generalized for any job type.
  */
@@ -143,13 +148,34 @@ struct LoadJob {
     std::string id;
     std::string phase;
     int priority = 0;  // Lower = higher priority
+    std::vector<std::string> dependencies;  // Job ids that must finish first
+    float estimatedMs = 1.0f;               // Expected cost, for the critical path
+
+    // Dependents wait for finishJob() (the main-thread GPU upload) instead
+    // of only for execute()
+    bool finishOnMainThread = false;
+
+    // Worker-thread stage. Empty for main-thread-only jobs, which complete
+    // with a null resource as soon as their dependencies finish.
     std::function<std::unique_ptr<StagedResource>()> execute;
 
+    float criticalPathMs = 0.0f;  // Set by the queue when the job becomes ready
+
     bool operator<(const LoadJob& other) const {
-        return priority > other.priority;  // Min-heap for priority queue
+        if (priority != other.priority) {
+            return priority > other.priority;  // Min-heap for priority queue
+        }
+        return criticalPathMs < other.criticalPathMs;
     }
 };
 
+/**
+ * Read a job's input file through the shared IOService. Jobs hold the
+ * loading screen, so they are read ahead of streaming traffic.
+ * Logs and returns a failed result if the file can't be read.
+ */
+IOResult readJobFile(const std::string& path);
+
 /**
  * Progress information for loading screen
  */
@@ -159,14 +185,22 @@ struct LoadProgress {
     uint32_t completedJobs = 0;
     uint32_t totalJobs = 0;
     uint64_t bytesLoaded = 0;
+    float estimatedProgress = -1.0f;    // From the job graph's critical path (-1 = none)
+    float estimatedRemainingMs = 0.0f;
 
     float getProgress() const {
+        if (estimatedProgress >= 0.0f) return estimatedProgress;
         return totalJobs > 0 ? static_cast<float>(completedJobs) / totalJobs : 0.0f;
     }
 };
 
 /**
- * LoadJobQueue - Thread-safe job queue with worker pool
+ * LoadJobQueue - Thread-safe job queue feeding a TaskScheduler pool
+ *
+ * Each ready job schedules one task; the task runs whichever ready job has
+ * the best priority at that moment. A job whose dependencies fail fails
+ * without running. Without a running scheduler, jobs run synchronously
+ * inside submit() and finishJob().
  */
 class LoadJobQueue {
 public:
@@ -175,9 +209,11 @@ public:
     explicit LoadJobQueue(ConstructToken) {}
 
     /**
-     * Factory: Create and start the job queue with worker threads
+     * Factory: Create the job queue on a named scheduler pool.
+     * @param workerCount Most jobs run at once (the pool's concurrency cap)
      */
-    static std::unique_ptr<LoadJobQueue> create(uint32_t workerCount = 2);
+    static std::unique_ptr<LoadJobQueue> create(uint32_t workerCount = 2, const std::string& poolName = "LoadJobs",
+                                                TaskScheduler::Priority priority = TaskScheduler::Priority::Normal);
 
 
     ~LoadJobQueue();
@@ -194,10 +230,27 @@ public:
     void submit(LoadJob job);
 
     /**
-     * Submit multiple jobs at once
+     * Submit multiple jobs at once. The whole batch is in the graph before
+     * any of it is scheduled, so critical paths see every dependent.
      */
     void submitBatch(std::vector<LoadJob> jobs);
 
+    /**
+     * Release the dependents of a finishOnMainThread job. Call from the main
+     * thread once its upload is done; finishing any other job is a no-op.
+     * A failed finish fails the dependents too.
+     */
+    void finishJob(const std::string& jobId, bool success = true);
+
+    /**
+     * Drop dependencies on jobs that were never submitted and break cycles,
+     * releasing any job they held back. Call once the graph is submitted.
+     */
+    uint32_t validateDependencies();
+
+    // Estimated cost of a job and its longest chain of dependents
+    float getCriticalPathMs(const std::string& jobId) const;
+
     /**
      * Set total expected job count (for progress calculation)
      */
@@ -210,7 +263,7 @@ public:
     std::vector<LoadJobResult> getCompletedJobs();
 
     /**
-     * Check if all jobs are complete
+     * Check if all jobs are complete (including main-thread finishes)
      */
     bool isComplete() const;
 
@@ -225,21 +278,38 @@ public:
     void waitForAll();
 
     /**
-     * Cancel all pending jobs and stop workers
+     * Cancel all pending jobs and wait for running ones
      */
     void shutdown();
 
-private:
-    bool init(uint32_t workerCount);
-    void workerLoop();
+    /**
+     * Log the chain of jobs that bounded the load, estimated vs actual
+     */
+    void logCriticalPath() const;
 
-    std::vector<std::thread> workers_;
+private:
+    bool init(uint32_t workerCount, const std::string& poolName, TaskScheduler::Priority priority);
+    void submitTasks(size_t count);
+    void runNextJob();
+
+    // Move newly ready jobs to the run queue, failing those with a failed
+    // dependency. Returns how many tasks to submit. (queueMutex_ held)
+    size_t releaseLocked(std::vector<std::string> ids);
+    size_t finishLocked(const std::string& jobId, bool success);
+    // Result for a job released without running on a worker
+    void pushResultLocked(const LoadJob& job, bool success, const std::string& error);
+
+    TaskScheduler::PoolId pool_ = 0;
+    uint32_t concurrency_ = 1;
+    TaskGroup jobTasks_;
     std::atomic<bool> running_{false};
 
     // Job queue (protected by queueMutex_)
     mutable std::mutex queueMutex_;
     std::priority_queue<LoadJob> jobQueue_;
-    std::condition_variable queueCondition_;
+    std::unordered_map<std::string, LoadJob> blockedJobs_;  // Waiting on dependencies
+    std::unordered_set<std::string> failedJobs_;
+    mutable StartupGraph graph_;  // Mutable: progress() only ratchets its high-water mark
 
     // Completed results (protected by resultsMutex_)
     mutable std::mutex resultsMutex_;
@@ -0,0 +1,310 @@
+#include "StartupGraph.h"
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+#include <functional>
+
+namespace Loading {
+
+bool StartupGraph::addNode(const std::string& id, float estimatedMs, const std::vector<std::string>& dependencies) {
+    if (nodes_.count(id)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "StartupGraph: duplicate node '%s'", id.c_str());
+        return false;
+    }
+
+    Node& node = nodes_[id];
+    node.estimatedMs = std::max(0.0f, estimatedMs);
+    order_.push_back(id);
+    for (const auto& dep : dependencies) {
+        addDependency(id, dep);
+    }
+    criticalPathsDirty_ = true;
+    return true;
+}
+
+void StartupGraph::addDependency(const std::string& id, const std::string& dependsOn) {
+    auto it = nodes_.find(id);
+    if (it == nodes_.end() || id == dependsOn) {
+        return;
+    }
+    auto& deps = it->second.dependencies;
+    if (std::find(deps.begin(), deps.end(), dependsOn) != deps.end()) {
+        return;
+    }
+    deps.push_back(dependsOn);
+    dependents_[dependsOn].push_back(id);
+    criticalPathsDirty_ = true;
+}
+
+void StartupGraph::setEstimate(const std::string& id, float estimatedMs) {
+    auto it = nodes_.find(id);
+    if (it != nodes_.end()) {
+        it->second.estimatedMs = std::max(0.0f, estimatedMs);
+        criticalPathsDirty_ = true;
+    }
+}
+
+uint32_t StartupGraph::validate() {
+    uint32_t removed = 0;
+
+    auto removeEdge = [this](const std::string& id, const std::string& dep) {
+        auto& deps = nodes_[id].dependencies;
+        deps.erase(std::remove(deps.begin(), deps.end(), dep), deps.end());
+        auto depIt = dependents_.find(dep);
+        if (depIt != dependents_.end()) {
+            auto& list = depIt->second;
+            list.erase(std::remove(list.begin(), list.end(), id), list.end());
+            if (list.empty()) dependents_.erase(depIt);
+        }
+    };
+
+    // Edges to nodes that never appeared would block forever
+    for (const auto& id : order_) {
+        std::vector<std::string> deps = nodes_[id].dependencies;
+        for (const auto& dep : deps) {
+            if (!nodes_.count(dep)) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                            "StartupGraph: '%s' depends on unknown '%s', ignoring", id.c_str(), dep.c_str());
+                removeEdge(id, dep);
+                ++removed;
+            }
+        }
+    }
+
+    // Depth-first over dependencies; an edge back into the current path closes a cycle
+    enum class Mark : uint8_t { None, Visiting, Done };
+    std::unordered_map<std::string, Mark> marks;
+    std::function<void(const std::string&)> visit = [&](const std::string& id) {
+        marks[id] = Mark::Visiting;
+        std::vector<std::string> deps = nodes_[id].dependencies;
+        for (const auto& dep : deps) {
+            Mark mark = marks[dep];
+            if (mark == Mark::Visiting) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                            "StartupGraph: dependency cycle through '%s' -> '%s', breaking it",
+                            id.c_str(), dep.c_str());
+                removeEdge(id, dep);
+                ++removed;
+            } else if (mark == Mark::None) {
+                visit(dep);
+            }
+        }
+        marks[id] = Mark::Done;
+    };
+    for (const auto& id : order_) {
+        if (marks[id] == Mark::None) {
+            visit(id);
+        }
+    }
+
+    if (removed > 0) {
+        criticalPathsDirty_ = true;
+    }
+    return removed;
+}
+
+bool StartupGraph::dependenciesFinished(const Node& node) const {
+    for (const auto& dep : node.dependencies) {
+        auto it = nodes_.find(dep);
+        if (it == nodes_.end() || it->second.state != State::Finished) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> StartupGraph::takeReady() {
+    std::vector<std::string> ready;
+    for (const auto& id : order_) {
+        Node& node = nodes_[id];
+        if (node.state == State::Blocked && dependenciesFinished(node)) {
+            node.state = State::Ready;
+            ready.push_back(id);
+        }
+    }
+    sortByCriticalPath(ready);
+    return ready;
+}
+
+bool StartupGraph::takeIfReady(const std::string& id) {
+    auto it = nodes_.find(id);
+    if (it == nodes_.end() || it->second.state != State::Blocked || !dependenciesFinished(it->second)) {
+        return false;
+    }
+    it->second.state = State::Ready;
+    return true;
+}
+
+void StartupGraph::markStarted(const std::string& id, Clock::time_point now) {
+    auto it = nodes_.find(id);
+    if (it != nodes_.end() && it->second.state != State::Finished) {
+        it->second.state = State::Running;
+        it->second.startTime = now;
+    }
+}
+
+std::vector<std::string> StartupGraph::markFinished(const std::string& id, Clock::time_point now) {
+    std::vector<std::string> released;
+    auto it = nodes_.find(id);
+    if (it == nodes_.end() || it->second.state == State::Finished) {
+        return released;
+    }
+
+    Node& node = it->second;
+    if (node.state == State::Running) {
+        node.actualMs = std::chrono::duration<float, std::milli>(now - node.startTime).count();
+    } else {
+        node.actualMs = 0.0f;
+    }
+    node.state = State::Finished;
+    ++finishedCount_;
+
+    auto depIt = dependents_.find(id);
+    if (depIt != dependents_.end()) {
+        for (const auto& dependent : depIt->second) {
+            if (takeIfReady(dependent)) {
+                released.push_back(dependent);
+            }
+        }
+    }
+    sortByCriticalPath(released);
+    return released;
+}
+
+StartupGraph::State StartupGraph::getState(const std::string& id) const {
+    auto it = nodes_.find(id);
+    return it != nodes_.end() ? it->second.state : State::Blocked;
+}
+
+void StartupGraph::sortByCriticalPath(std::vector<std::string>& ids) const {
+    if (ids.size() < 2) return;
+    updateCriticalPaths();
+    std::stable_sort(ids.begin(), ids.end(), [this](const std::string& a, const std::string& b) {
+        return criticalPaths_.at(a) > criticalPaths_.at(b);
+    });
+}
+
+void StartupGraph::updateCriticalPaths() const {
+    if (!criticalPathsDirty_) return;
+    criticalPaths_.clear();
+
+    // Memoised longest path over dependents; a node met again while still
+    // on the stack (an unbroken cycle) contributes nothing
+    std::unordered_map<std::string, bool> onStack;
+    std::function<float(const std::string&)> pathFrom = [&](const std::string& id) -> float {
+        auto cached = criticalPaths_.find(id);
+        if (cached != criticalPaths_.end()) return cached->second;
+        if (onStack[id]) return 0.0f;
+        onStack[id] = true;
+
+        float downstream = 0.0f;
+        auto depIt = dependents_.find(id);
+        if (depIt != dependents_.end()) {
+            for (const auto& dependent : depIt->second) {
+                if (nodes_.count(dependent)) {
+                    downstream = std::max(downstream, pathFrom(dependent));
+                }
+            }
+        }
+
+        onStack[id] = false;
+        float path = nodes_.at(id).estimatedMs + downstream;
+        criticalPaths_[id] = path;
+        return path;
+    };
+
+    for (const auto& id : order_) {
+        pathFrom(id);
+    }
+    criticalPathsDirty_ = false;
+}
+
+float StartupGraph::criticalPathMs(const std::string& id) const {
+    if (!nodes_.count(id)) return 0.0f;
+    updateCriticalPaths();
+    return criticalPaths_.at(id);
+}
+
+float StartupGraph::remainingOwnMs(const Node& node, Clock::time_point now) const {
+    switch (node.state) {
+        case State::Finished:
+            return 0.0f;
+        case State::Running: {
+            float elapsed = std::chrono::duration<float, std::milli>(now - node.startTime).count();
+            return std::max(0.0f, node.estimatedMs - elapsed);
+        }
+        default:
+            return node.estimatedMs;
+    }
+}
+
+StartupGraph::Estimate StartupGraph::estimate(uint32_t concurrency, Clock::time_point now) const {
+    updateCriticalPaths();
+    float threads = static_cast<float>(std::max(1u, concurrency));
+
+    float totalPath = 0.0f;
+    float totalWork = 0.0f;
+    float remainingPath = 0.0f;
+    float remainingWork = 0.0f;
+    for (const auto& [id, node] : nodes_) {
+        float path = criticalPaths_.at(id);
+        float own = remainingOwnMs(node, now);
+        totalPath = std::max(totalPath, path);
+        totalWork += node.estimatedMs;
+        if (node.state != State::Finished) {
+            remainingPath = std::max(remainingPath, own + (path - node.estimatedMs));
+            remainingWork += own;
+        }
+    }
+
+    Estimate result;
+    result.totalMs = std::max(totalPath, totalWork / threads);
+    result.remainingMs = std::max(remainingPath, remainingWork / threads);
+    return result;
+}
+
+float StartupGraph::progress(uint32_t concurrency, Clock::time_point now) {
+    Estimate e = estimate(concurrency, now);
+    float p;
+    if (e.totalMs > 0.0f) {
+        p = 1.0f - e.remainingMs / e.totalMs;
+    } else {
+        p = (!nodes_.empty() && allFinished()) ? 1.0f : 0.0f;
+    }
+    lastProgress_ = std::max(lastProgress_, std::clamp(p, 0.0f, 1.0f));
+    return lastProgress_;
+}
+
+std::vector<StartupGraph::PathEntry> StartupGraph::criticalPath() const {
+    std::vector<PathEntry> path;
+    if (nodes_.empty()) return path;
+    updateCriticalPaths();
+
+    const std::string* current = nullptr;
+    for (const auto& id : order_) {
+        if (!current || criticalPaths_.at(id) > criticalPaths_.at(*current)) {
+            current = &id;
+        }
+    }
+
+    while (current) {
+        const Node& node = nodes_.at(*current);
+        path.push_back({*current, node.estimatedMs, node.actualMs});
+
+        const std::string* next = nullptr;
+        auto depIt = dependents_.find(*current);
+        if (depIt != dependents_.end()) {
+            for (const auto& dependent : depIt->second) {
+                if (nodes_.count(dependent) &&
+                    (!next || criticalPaths_.at(dependent) > criticalPaths_.at(*next))) {
+                    next = &dependent;
+                }
+            }
+        }
+        // A cycle left in the graph would loop forever
+        if (next && path.size() > nodes_.size()) break;
+        current = next;
+    }
+    return path;
+}
+
+} // namespace Loading
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Loading {
+
+/**
+ * StartupGraph - Dependency graph of startup work with critical-path costs
+ *
+ * Each node is one unit of startup work (a file decode, a GPU upload, a
+ * subsystem init) with an estimated cost and the nodes it waits on. The
+ * graph answers the two questions a startup scheduler has:
+ *
+ * - What to run next: of the ready nodes, the one with the longest
+ *   estimated path to the end of startup (its critical path), so the
+ *   slowest chain starts first and everything else overlaps with it
+ * - How far along we are: remaining time is bounded below by both the
+ *   remaining critical path and the remaining work spread over the
+ *   available threads; progress is measured against the larger of the two
+ *
+ * Dependencies may name nodes that are added later. validate() drops edges
+ * to nodes that never appeared and breaks cycles, so a bad declaration
+ * delays nothing forever.
+ *
+ * Not thread safe: owners guard it with their own queue lock.
+ */
+class StartupGraph {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class State : uint8_t {
+        Blocked,    // Waiting on dependencies
+        Ready,      // Released to a scheduler, not yet started
+        Running,
+        Finished
+    };
+
+    struct Estimate {
+        float totalMs = 0.0f;       // Lower bound on startup length from the estimates
+        float remainingMs = 0.0f;   // Same bound for what's left
+    };
+
+    struct PathEntry {
+        std::string id;
+        float estimatedMs = 0.0f;
+        float actualMs = -1.0f;     // -1 until finished
+    };
+
+    /**
+     * Add a node. Returns false (and changes nothing) if the id exists.
+     */
+    bool addNode(const std::string& id, float estimatedMs, const std::vector<std::string>& dependencies = {});
+
+    void addDependency(const std::string& id, const std::string& dependsOn);
+    void setEstimate(const std::string& id, float estimatedMs);
+
+    /**
+     * Drop dependencies on nodes that were never added and break any
+     * cycles. Returns the number of edges removed (each is logged).
+     */
+    uint32_t validate();
+
+    // Blocked -> Ready for every node whose dependencies have finished,
+    // longest critical path first
+    std::vector<std::string> takeReady();
+
+    // Blocked -> Ready for one node if its dependencies have finished
+    bool takeIfReady(const std::string& id);
+
+    void markStarted(const std::string& id, Clock::time_point now = Clock::now());
+
+    /**
+     * Mark a node finished and release its dependents that are now ready
+     * (returned longest critical path first).
+     */
+    std::vector<std::string> markFinished(const std::string& id, Clock::time_point now = Clock::now());
+
+    bool contains(const std::string& id) const { return nodes_.count(id) != 0; }
+    State getState(const std::string& id) const;
+    size_t size() const { return nodes_.size(); }
+    size_t finishedCount() const { return finishedCount_; }
+    bool allFinished() const { return finishedCount_ == nodes_.size(); }
+
+    // Estimated cost of this node plus its longest chain of dependents
+    float criticalPathMs(const std::string& id) const;
+
+    /**
+     * Remaining-time bound given how many nodes can run at once. Running
+     * nodes count only the part of their estimate not yet elapsed.
+     */
+    Estimate estimate(uint32_t concurrency, Clock::time_point now = Clock::now()) const;
+
+    // 0..1 from estimate(); never moves backwards
+    float progress(uint32_t concurrency, Clock::time_point now = Clock::now());
+
+    // The chain of nodes behind the whole-graph critical path, first to last
+    std::vector<PathEntry> criticalPath() const;
+
+private:
+    struct Node {
+        float estimatedMs = 1.0f;
+        std::vector<std::string> dependencies;
+        State state = State::Blocked;
+        Clock::time_point startTime;
+        float actualMs = -1.0f;
+    };
+
+    bool dependenciesFinished(const Node& node) const;
+    void sortByCriticalPath(std::vector<std::string>& ids) const;
+    void updateCriticalPaths() const;
+    float remainingOwnMs(const Node& node, Clock::time_point now) const;
+
+    std::unordered_map<std::string, Node> nodes_;
+    std::vector<std::string> order_;    // Insertion order, for deterministic ties
+    std::unordered_map<std::string, std::vector<std::string>> dependents_;
+    size_t finishedCount_ = 0;
+    float lastProgress_ = 0.0f;
+
+    // Critical path per node, rebuilt when the graph or an estimate changes
+    mutable std::unordered_map<std::string, float> criticalPaths_;
+    mutable bool criticalPathsDirty_ = true;
+};
+
+} // namespace Loading
@@ -0,0 +1,141 @@
+#include "StartupTimeline.h"
+#include "core/threading/TaskScheduler.h"
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+namespace Loading {
+
+StartupTimeline& StartupTimeline::instance() {
+    static StartupTimeline timeline;
+    return timeline;
+}
+
+void StartupTimeline::reset(Clock::time_point origin) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    origin_ = origin;
+    spans_.clear();
+}
+
+void StartupTimeline::record(const std::string& name, Clock::time_point start, Clock::time_point end) {
+    record(currentLane(), name, start, end);
+}
+
+void StartupTimeline::record(const std::string& lane, const std::string& name,
+                             Clock::time_point start, Clock::time_point end) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    spans_.push_back({lane, name, start, std::max(start, end)});
+}
+
+std::vector<StartupTimeline::Span> StartupTimeline::getSpans() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return spans_;
+}
+
+StartupTimeline::Clock::time_point StartupTimeline::getOrigin() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return origin_;
+}
+
+std::string StartupTimeline::currentLane() {
+    int32_t worker = TaskScheduler::instance().getCurrentThreadId();
+    return worker >= 0 ? "Worker " + std::to_string(worker) : "Main thread";
+}
+
+FlamegraphCapture StartupTimeline::buildFlamegraph() const {
+    std::vector<Span> spans;
+    Clock::time_point origin;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        spans = spans_;
+        origin = origin_;
+    }
+
+    auto toMs = [origin](Clock::time_point t) {
+        return std::chrono::duration<float, std::milli>(t - origin).count();
+    };
+
+    // Main thread first, then workers in numeric order
+    auto laneKey = [](const std::string& lane) {
+        if (lane == "Main thread") return std::make_pair(-1, lane);
+        if (lane.rfind("Worker ", 0) == 0) return std::make_pair(std::atoi(lane.c_str() + 7), lane);
+        return std::make_pair(1 << 30, lane);
+    };
+    std::map<std::pair<int, std::string>, std::vector<const Span*>> lanes;
+    for (const Span& span : spans) {
+        lanes[laneKey(span.lane)].push_back(&span);
+    }
+
+    FlamegraphBuilder builder;
+    builder.beginFrame();
+    float endOfTimeline = 0.0f;
+
+    for (auto& [key, laneSpans] : lanes) {
+        // Earlier first; of two starting together the longer one is the parent
+        std::sort(laneSpans.begin(), laneSpans.end(), [](const Span* a, const Span* b) {
+            if (a->start != b->start) return a->start < b->start;
+            return a->end > b->end;
+        });
+
+        const std::string& laneName = key.second;
+        float laneStart = toMs(laneSpans.front()->start);
+        float laneEnd = laneStart;
+        builder.beginZone(laneName.c_str(), laneStart);
+
+        struct Open { const std::string* name; float endMs; };
+        std::vector<Open> open;
+        for (const Span* span : laneSpans) {
+            float start = toMs(span->start);
+            float end = toMs(span->end);
+            while (!open.empty() && open.back().endMs <= start) {
+                builder.endZone(open.back().name->c_str(), open.back().endMs);
+                open.pop_back();
+            }
+            // Partial overlap on one thread can't happen; clamp to stay well formed
+            if (!open.empty()) {
+                end = std::min(end, open.back().endMs);
+            }
+            builder.beginZone(span->name.c_str(), start);
+            open.push_back({&span->name, end});
+            laneEnd = std::max(laneEnd, end);
+        }
+        while (!open.empty()) {
+            builder.endZone(open.back().name->c_str(), open.back().endMs);
+            open.pop_back();
+        }
+
+        builder.endZone(laneName.c_str(), laneEnd);
+        endOfTimeline = std::max(endOfTimeline, laneEnd);
+    }
+
+    return builder.endFrame(endOfTimeline, 0);
+}
+
+bool StartupTimeline::exportFolded(const std::string& path, const FlamegraphCapture* initCapture) const {
+    std::error_code ec;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "StartupTimeline: can't write '%s'", path.c_str());
+        return false;
+    }
+
+    if (initCapture) {
+        file << formatFoldedStacks(*initCapture, "Init");
+    }
+    FlamegraphCapture lanes = buildFlamegraph();
+    file << formatFoldedStacks(lanes, "Loading");
+
+    SDL_Log("Startup flamegraph written to %s (%.1f ms across %zu lanes)",
+            path.c_str(), lanes.totalTimeMs, lanes.roots.size());
+    return static_cast<bool>(file);
+}
+
+} // namespace Loading
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "debug/Flamegraph.h"
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Loading {
+
+/**
+ * StartupTimeline - Where startup work actually ran, per thread
+ *
+ * The loaders record one span per job stage (worker decode, main-thread
+ * upload, subsystem init). InitProfiler only sees the main thread's nested
+ * phases; this keeps the overlapped work so the exported flamegraph shows
+ * which lane the critical path sat on.
+ *
+ * Thread safe.
+ */
+class StartupTimeline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Span {
+        std::string lane;       // "Main thread", "Worker 3"
+        std::string name;
+        Clock::time_point start;
+        Clock::time_point end;
+    };
+
+    static StartupTimeline& instance();
+
+    // Start a new recording; spans are timed relative to this point
+    void reset(Clock::time_point origin = Clock::now());
+
+    void record(const std::string& name, Clock::time_point start, Clock::time_point end);
+    void record(const std::string& lane, const std::string& name, Clock::time_point start, Clock::time_point end);
+
+    std::vector<Span> getSpans() const;
+    Clock::time_point getOrigin() const;
+
+    // Lane name for the calling thread
+    static std::string currentLane();
+
+    /**
+     * One root per lane holding that lane's spans in time order. Spans
+     * nested in time (a job run synchronously inside another) nest in
+     * the flamegraph.
+     */
+    FlamegraphCapture buildFlamegraph() const;
+
+    /**
+     * Write the lanes plus the InitProfiler phases as folded stacks
+     * (flamegraph.pl / speedscope input). Diff two exports with
+     * difffolded.pl to spot startup regressions.
+     */
+    bool exportFolded(const std::string& path, const FlamegraphCapture* initCapture = nullptr) const;
+
+private:
+    StartupTimeline() = default;
+
+    mutable std::mutex mutex_;
+    Clock::time_point origin_ = Clock::now();
+    std::vector<Span> spans_;
+};
+
+/**
+ * RAII span on the calling thread's lane
+ */
+class ScopedStartupSpan {
+public:
+    explicit ScopedStartupSpan(std::string name)
+        : name_(std::move(name)), start_(StartupTimeline::Clock::now()) {}
+
+    ~ScopedStartupSpan() {
+        StartupTimeline::instance().record(name_, start_, StartupTimeline::Clock::now());
+    }
+
+    ScopedStartupSpan(const ScopedStartupSpan&) = delete;
+    ScopedStartupSpan& operator=(const ScopedStartupSpan&) = delete;
+
+private:
+    std::string name_;
+    StartupTimeline::Clock::time_point start_;
+};
+
+} // namespace Loading
@@ -1,6 +1,9 @@
 #include "Application.h"
 #include "core/CrashHandler.h"
+#include "core/asset/DerivedDataCache.h"
 #include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstdlib>
 #include <string>
 #include <vector>
 
@@ -13,6 +16,14 @@ static void printUsage(const char* progName) {
     SDL_Log("  --enable <name>     Enable a specific toggle");
     SDL_Log("  --minimal           Start with minimal rendering (sky + terrain + objects)");
     SDL_Log("  --list-toggles      List all available toggle names");
+    SDL_Log("  --rebuild-cache     Discard cached imported assets and re-import everything");
+    SDL_Log("");
+    SDL_Log("Profiling Options:");
+    SDL_Log("  --trace <file>      Write a Chrome trace (startup + first frames) to <file>");
+    SDL_Log("  --trace-frames <n>  Frames to record with --trace (default 300)");
+    SDL_Log("  F9 in game starts a trace; F9 again writes it to cache/trace.json");
+    SDL_Log("  --pacing-log <file>  Log per-frame pacing (CSV, or JSON lines for .jsonl) for soak runs;");
+    SDL_Log("                       rolls every 36000 frames, percentile/hitch summary at exit");
     SDL_Log("");
     SDL_Log("Toggle names (use with --disable/--enable):");
     SDL_Log("  Compute: terrainCompute, subdivisionCompute, grassCompute, weatherCompute,");
@@ -36,6 +47,9 @@ int main(int argc, char* argv[]) {
     std::vector<std::pair<std::string, bool>> toggleChanges;
     bool minimalMode = false;
     bool listToggles = false;
+    std::string tracePath;
+    uint32_t traceFrames = 300;
+    std::string pacingLogPath;
 
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -47,6 +61,16 @@ int main(int argc, char* argv[]) {
             listToggles = true;
         } else if (arg == "--minimal") {
             minimalMode = true;
+        } else if (arg == "--rebuild-cache") {
+            DerivedDataCache::Config cacheConfig = DerivedDataCache::instanceConfig();
+            cacheConfig.rebuild = true;
+            DerivedDataCache::configureInstance(cacheConfig);
+        } else if (arg == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (arg == "--trace-frames" && i + 1 < argc) {
+            traceFrames = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--pacing-log" && i + 1 < argc) {
+            pacingLogPath = argv[++i];
         } else if (arg == "--disable" && i + 1 < argc) {
             toggleChanges.emplace_back(argv[++i], false);
         } else if (arg == "--enable" && i + 1 < argc) {
@@ -84,6 +108,13 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    if (!tracePath.empty()) {
+        app.startTraceCapture(tracePath, traceFrames);
+    }
+    if (!pacingLogPath.empty()) {
+        app.startPacingLog(pacingLogPath);
+    }
+
     app.run();
     app.shutdown();
 
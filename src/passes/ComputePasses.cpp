@@ -228,7 +228,7 @@ PassIds addPasses(FrameGraph& graph, RendererSystems& systems, const Config& con
             systems.profiler().endGpuZone(cmd, "Atmosphere");
         },
         .canUseSecondary = false,
-        .mainThreadOnly = false,  // Can run parallel with Shadow
+        .mainThreadOnly = true,  // Records into the frame's primary command buffer
         .priority = 50
     });
 
@@ -8,9 +8,19 @@
 #include "BilateralGridSystem.h"
 #include "GodRaysSystem.h"
 #include "HiZSystem.h"
+#include <SDL3/SDL.h>
+#include <string>
 
 namespace PostPasses {
 
+namespace {
+
+std::string bloomMipName(uint32_t mip) {
+    return "BloomMip" + std::to_string(mip);
+}
+
+} // namespace
+
 PassIds addPasses(FrameGraph& graph, RendererSystems& systems, const Config& config) {
     PassIds ids;
     auto* guiCallback = config.guiRenderCallback;
@@ -33,22 +43,71 @@ PassIds addPasses(FrameGraph& graph, RendererSystems& systems, const Config& con
         .priority = 15
     });
 
-    // Bloom pass - multi-pass bloom effect
-    ids.bloom = graph.addPass({
-        .name = "Bloom",
-        .execute = [&systems, perfToggles](FrameGraph::RenderContext& ctx) {
-            if (!perfToggles->bloom || !systems.postProcess().isBloomEnabled()) return;
-            RenderContext* renderCtx = static_cast<RenderContext*>(ctx.userData);
-            if (!renderCtx) return;
-            systems.profiler().beginGpuZone(ctx.commandBuffer, "Bloom");
-            systems.bloom().setThreshold(systems.postProcess().getBloomThreshold());
-            systems.bloom().recordBloomPass(ctx.commandBuffer, systems.postProcess().getHDRColorView());
-            systems.profiler().endGpuZone(ctx.commandBuffer, "Bloom");
-        },
-        .canUseSecondary = false,
-        .mainThreadOnly = true,
-        .priority = 10
-    });
+    // Bloom - one pass per down/up-sample step over a chain of transient
+    // mips. The graph orders the steps and records every layout transition
+    // from the declared reads and writes, and may alias the mips with other
+    // transients whose lifetimes don't overlap theirs.
+    BloomSystem& bloom = systems.bloom();
+    const uint32_t mipCount = bloom.getMipCount();
+    std::vector<FrameGraph::ResourceId> mips;
+    for (uint32_t mip = 0; mip < mipCount; ++mip) {
+        mips.push_back(graph.createTransientImage(bloomMipName(mip), bloom.getMipImageInfo(mip)));
+    }
+    auto bloomActive = [&systems, perfToggles] {
+        return perfToggles->bloom && systems.postProcess().isBloomEnabled();
+    };
+
+    for (uint32_t mip = 0; mip < mipCount; ++mip) {
+        FrameGraph::PassConfig down{
+            .name = "BloomDown" + std::to_string(mip),
+            .execute = [&systems, bloomActive, mip, mipCount](FrameGraph::RenderContext& ctx) {
+                RenderContext* renderCtx = static_cast<RenderContext*>(ctx.userData);
+                if (!renderCtx) return;
+                if (!bloomActive()) {
+                    if (mip == 0) systems.bloom().recordClearOutput(ctx.commandBuffer);
+                    return;
+                }
+                if (mip == 0) {
+                    systems.profiler().beginGpuZone(ctx.commandBuffer, "Bloom");
+                    systems.bloom().setThreshold(systems.postProcess().getBloomThreshold());
+                }
+                systems.bloom().recordDownsample(ctx.commandBuffer, mip, systems.postProcess().getHDRColorView());
+                if (mipCount == 1) {
+                    systems.profiler().endGpuZone(ctx.commandBuffer, "Bloom");
+                }
+            },
+            .canUseSecondary = false,
+            .mainThreadOnly = true,
+            .priority = 10
+        };
+        down.resources.push_back({mips[mip], FrameGraph::ResourceAccess::ColorAttachmentWrite});
+        if (mip > 0) {
+            down.resources.push_back({mips[mip - 1], FrameGraph::ResourceAccess::ShaderSampledRead});
+        }
+        FrameGraph::PassId id = graph.addPass(down);
+        if (mip == 0) ids.bloom = id;
+    }
+
+    for (int level = static_cast<int>(mipCount) - 2; level >= 0; --level) {
+        const uint32_t mip = static_cast<uint32_t>(level);
+        FrameGraph::PassConfig up{
+            .name = "BloomUp" + std::to_string(mip),
+            .execute = [&systems, bloomActive, mip](FrameGraph::RenderContext& ctx) {
+                RenderContext* renderCtx = static_cast<RenderContext*>(ctx.userData);
+                if (!renderCtx || !bloomActive()) return;
+                systems.bloom().recordUpsample(ctx.commandBuffer, mip);
+                if (mip == 0) {
+                    systems.profiler().endGpuZone(ctx.commandBuffer, "Bloom");
+                }
+            },
+            .canUseSecondary = false,
+            .mainThreadOnly = true,
+            .priority = 10
+        };
+        up.resources.push_back({mips[mip], FrameGraph::ResourceAccess::ColorAttachmentWrite});
+        up.resources.push_back({mips[mip + 1], FrameGraph::ResourceAccess::ShaderSampledRead});
+        graph.addPass(up);
+    }
 
     // God rays pass - quarter-resolution light shafts
     ids.godRays = graph.addPass({
@@ -90,7 +149,7 @@ PassIds addPasses(FrameGraph& graph, RendererSystems& systems, const Config& con
     });
 
     // Post-process pass - final composite with tone mapping and GUI
-    ids.postProcess = graph.addPass({
+    FrameGraph::PassConfig composite{
         .name = "PostProcess",
         .execute = [&systems, framebuffers, guiCallback](FrameGraph::RenderContext& ctx) {
             RenderContext* renderCtx = static_cast<RenderContext*>(ctx.userData);
@@ -103,10 +162,30 @@ PassIds addPasses(FrameGraph& graph, RendererSystems& systems, const Config& con
         },
         .canUseSecondary = false,
         .mainThreadOnly = true,
-        .priority = 0  // Lowest priority - runs last
-    });
+        .priority = 0,  // Lowest priority - runs last
+        // Presents, so never culled even though it only declares the bloom read
+        .hasSideEffects = true
+    };
+    if (!mips.empty()) {
+        composite.resources.push_back({mips[0], FrameGraph::ResourceAccess::ShaderSampledRead});
+    }
+    ids.postProcess = graph.addPass(composite);
 
     return ids;
 }
 
+bool bindTransients(const FrameGraph& graph, RendererSystems& systems) {
+    BloomSystem& bloom = systems.bloom();
+    std::vector<VkImageView> views;
+    for (uint32_t mip = 0; mip < bloom.getMipCount(); ++mip) {
+        views.push_back(graph.getImageView(graph.getResource(bloomMipName(mip))));
+    }
+    if (!bloom.bindMipChain(views)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "PostPasses: Failed to bind bloom mip chain");
+        return false;
+    }
+    systems.postProcess().setBloomTexture(bloom.getBloomOutput(), bloom.getBloomSampler());
+    return true;
+}
+
 } // namespace PostPasses
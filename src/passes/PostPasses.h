@@ -10,6 +10,9 @@ struct PerformanceToggles;
  * PostPasses - Post-processing pass definitions
  *
  * Includes: HiZ, Bloom, BilateralGrid, PostProcess (final composite)
+ *
+ * Bloom is declared per step (BloomDown<N>, BloomUp<N>) on transient mip
+ * images, so its barriers come from the FrameGraph rather than BloomSystem.
  */
 namespace PostPasses {
 
@@ -21,7 +24,7 @@ struct Config {
 
 struct PassIds {
     FrameGraph::PassId hiZ = FrameGraph::INVALID_PASS;
-    FrameGraph::PassId bloom = FrameGraph::INVALID_PASS;
+    FrameGraph::PassId bloom = FrameGraph::INVALID_PASS;    // First down-sample step
     FrameGraph::PassId godRays = FrameGraph::INVALID_PASS;
     FrameGraph::PassId bilateralGrid = FrameGraph::INVALID_PASS;
     FrameGraph::PassId postProcess = FrameGraph::INVALID_PASS;
@@ -29,4 +32,8 @@ struct PassIds {
 
 PassIds addPasses(FrameGraph& graph, RendererSystems& systems, const Config& config);
 
+// Hand the graph-owned bloom mips to BloomSystem and the composite.
+// Call after every FrameGraph::realizeTransients().
+bool bindTransients(const FrameGraph& graph, RendererSystems& systems);
+
 } // namespace PostPasses
@@ -3,11 +3,11 @@
 #include "JoltRuntime.h"
 #include "PhysicsConversions.h"
 #include "TerrainHeight.h"
+#include "TaskSchedulerJobSystem.h"
 
 // Jolt Physics includes
 #include <Jolt/Jolt.h>
 #include <Jolt/Core/TempAllocator.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsSystem.h>
 #include <Jolt/Physics/Collision/Shape/BoxShape.h>
@@ -22,7 +22,6 @@
 #include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
 
 #include <SDL3/SDL_log.h>
-#include <thread>
 #include <cmath>
 #include <algorithm>
 
@@ -88,12 +87,10 @@ bool PhysicsWorld::initInternal() {
     // Create temp allocator (10 MB)
     tempAllocator_ = std::make_unique<JPH::TempAllocatorImpl>(10 * 1024 * 1024);
 
-    // Create job system with thread count
-    int numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
-    jobSystem_ = std::make_unique<JPH::JobSystemThreadPool>(
+    // Physics jobs run on the shared TaskScheduler workers
+    jobSystem_ = std::make_unique<TaskSchedulerJobSystem>(
         JPH::cMaxPhysicsJobs,
-        JPH::cMaxPhysicsBarriers,
-        numThreads
+        JPH::cMaxPhysicsBarriers
     );
 
     // Create physics system
@@ -116,7 +113,7 @@ bool PhysicsWorld::initInternal() {
     // Set gravity
     physicsSystem_->SetGravity(JPH::Vec3(0.0f, -9.81f, 0.0f));
 
-    SDL_Log("Physics system initialized with %d worker threads", numThreads);
+    SDL_Log("Physics system initialized (job concurrency %d)", jobSystem_->GetMaxConcurrency());
     return true;
 }
 
@@ -13,13 +13,13 @@
 namespace JPH {
     class PhysicsSystem;
     class TempAllocatorImpl;
-    class JobSystemThreadPool;
     class BodyInterface;
     class Body;
 }
 
 // Forward declaration for Jolt runtime RAII wrapper
 struct JoltRuntime;
+class TaskSchedulerJobSystem;
 
 // Physics body handle
 using PhysicsBodyID = uint32_t;
@@ -193,7 +193,7 @@ private:
     std::shared_ptr<JoltRuntime> joltRuntime_;
 
     std::unique_ptr<JPH::TempAllocatorImpl> tempAllocator_;
-    std::unique_ptr<JPH::JobSystemThreadPool> jobSystem_;
+    std::unique_ptr<TaskSchedulerJobSystem> jobSystem_;
     std::unique_ptr<JPH::PhysicsSystem> physicsSystem_;
 
     // Character controller
@@ -0,0 +1,63 @@
+#include "TaskSchedulerJobSystem.h"
+
+#include <SDL3/SDL_log.h>
+#include <chrono>
+#include <thread>
+
+TaskSchedulerJobSystem::TaskSchedulerJobSystem(JPH::uint maxJobs, JPH::uint maxBarriers)
+    : JobSystemWithBarrier(maxBarriers) {
+    jobs_.Init(maxJobs, maxJobs);
+    pool_ = TaskScheduler::instance().registerPool("Physics", TaskScheduler::Priority::High, 0);
+}
+
+TaskSchedulerJobSystem::~TaskSchedulerJobSystem() {
+    // Every step has finished by now, but tasks for jobs the waiting thread
+    // already ran may still be queued; they touch jobs_ when they release
+    inFlight_.wait();
+}
+
+int TaskSchedulerJobSystem::GetMaxConcurrency() const {
+    // Workers the pool may use plus the thread waiting on the barrier
+    return static_cast<int>(TaskScheduler::instance().getPoolConcurrency(pool_)) + 1;
+}
+
+TaskSchedulerJobSystem::JobHandle TaskSchedulerJobSystem::CreateJob(const char* inName, JPH::ColorArg inColor,
+                                                                    const JobFunction& inJobFunction,
+                                                                    JPH::uint32 inNumDependencies) {
+    JPH::uint32 index;
+    for (;;) {
+        index = jobs_.ConstructObject(inName, inColor, this, inJobFunction, inNumDependencies);
+        if (index != AvailableJobs::cInvalidObjectIndex) {
+            break;
+        }
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TaskSchedulerJobSystem: out of jobs, waiting");
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    Job* job = &jobs_.Get(index);
+
+    // Take the handle first: a queued job may complete before we return
+    JobHandle handle(job);
+    if (inNumDependencies == 0) {
+        QueueJob(job);
+    }
+    return handle;
+}
+
+void TaskSchedulerJobSystem::QueueJob(Job* inJob) {
+    inJob->AddRef();
+    TaskScheduler::instance().submit(pool_, [inJob] {
+        // No-op if the barrier's waiting thread got to it first
+        inJob->Execute();
+        inJob->Release();
+    }, &inFlight_);
+}
+
+void TaskSchedulerJobSystem::QueueJobs(Job** inJobs, JPH::uint inNumJobs) {
+    for (JPH::uint i = 0; i < inNumJobs; ++i) {
+        QueueJob(inJobs[i]);
+    }
+}
+
+void TaskSchedulerJobSystem::FreeJob(Job* inJob) {
+    jobs_.DestructObject(inJob);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "core/threading/TaskScheduler.h"
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+
+// Jolt job system that runs physics jobs on the engine's TaskScheduler
+// ("Physics" pool, high priority) instead of a private JobSystemThreadPool.
+// Barriers come from JobSystemWithBarrier, so the thread waiting on a step
+// also executes jobs, exactly as with Jolt's own pool.
+class TaskSchedulerJobSystem final : public JPH::JobSystemWithBarrier {
+public:
+    TaskSchedulerJobSystem(JPH::uint maxJobs, JPH::uint maxBarriers);
+    ~TaskSchedulerJobSystem() override;
+
+    // Non-copyable, non-movable (Jolt holds raw pointers to jobs)
+    TaskSchedulerJobSystem(const TaskSchedulerJobSystem&) = delete;
+    TaskSchedulerJobSystem& operator=(const TaskSchedulerJobSystem&) = delete;
+
+    int GetMaxConcurrency() const override;
+    JobHandle CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction,
+                        JPH::uint32 inNumDependencies = 0) override;
+
+protected:
+    void QueueJob(Job* inJob) override;
+    void QueueJobs(Job** inJobs, JPH::uint inNumJobs) override;
+    void FreeJob(Job* inJob) override;
+
+private:
+    using AvailableJobs = JPH::FixedSizeFreeList<Job>;
+
+    AvailableJobs jobs_;
+    TaskScheduler::PoolId pool_ = 0;
+
+    // Scheduler tasks still holding a job reference
+    TaskGroup inFlight_;
+};
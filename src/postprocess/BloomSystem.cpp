@@ -2,9 +2,7 @@
 #include "GraphicsPipelineFactory.h"
 #include "SamplerFactory.h"
 #include "DescriptorManager.h"
-#include "core/ImageBuilder.h"
 #include "core/InitInfoBuilder.h"
-#include "core/vulkan/BarrierHelpers.h"
 #include "core/vulkan/PipelineLayoutBuilder.h"
 #include "core/vulkan/DescriptorSetLayoutBuilder.h"
 #include "core/vulkan/RenderPassBuilder.h"
@@ -95,42 +93,52 @@ bool BloomSystem::createMipChain() {
     uint32_t width = extent.width;
     uint32_t height = extent.height;
 
-    // Create mip chain - each level is half the size of the previous
+    // Each level is half the size of the previous; the images themselves
+    // come from the FrameGraph (see bindMipChain)
     for (uint32_t i = 0; i < MAX_MIP_LEVELS && (width > 1 || height > 1); ++i) {
         width = std::max(1u, width / 2);
         height = std::max(1u, height / 2);
 
         MipLevel mip;
         mip.extent = {width, height};
-
-        // Create image using ImageBuilder
-        ManagedImage managedImage;
-        VkImageView imageView;
-        if (!ImageBuilder(allocator)
-                .setExtent(width, height)
-                .setFormat(BLOOM_FORMAT)
-                .asColorAttachment()
-                .setGpuOnly()
-                .build(device, managedImage, imageView)) {
-            return false;
-        }
-
-        // Release to raw handles (BloomSystem uses raw handles for mip chain)
-        managedImage.releaseToRaw(mip.image, mip.allocation);
-        mip.imageView = imageView;
-
         mipChain.push_back(mip);
     }
 
-    SDL_Log("BloomSystem: Created %zu mip levels, first mip: %ux%u",
+    SDL_Log("BloomSystem: %zu mip levels, first mip: %ux%u",
             mipChain.size(),
             mipChain.empty() ? 0 : mipChain[0].extent.width,
             mipChain.empty() ? 0 : mipChain[0].extent.height);
+    return true;
+}
+
+vk::ImageCreateInfo BloomSystem::getMipImageInfo(uint32_t mip) const {
+    return vk::ImageCreateInfo{}
+        .setImageType(vk::ImageType::e2D)
+        .setFormat(static_cast<vk::Format>(BLOOM_FORMAT))
+        .setExtent(vk::Extent3D{mipChain[mip].extent.width, mipChain[mip].extent.height, 1})
+        .setMipLevels(1)
+        .setArrayLayers(1)
+        .setSamples(vk::SampleCountFlagBits::e1)
+        .setTiling(vk::ImageTiling::eOptimal)
+        .setUsage(vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eSampled);
+}
+
+bool BloomSystem::bindMipChain(const std::vector<VkImageView>& views) {
+    if (views.size() != mipChain.size()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "BloomSystem: Expected %zu mip views, got %zu",
+                     mipChain.size(), views.size());
+        return false;
+    }
 
     // Create framebuffers for each mip level using vulkan-hpp builder
     // Use downsampleRenderPass - both render passes have compatible attachments
     vk::Device vkDevice(device);
-    for (auto& mip : mipChain) {
+    for (size_t i = 0; i < mipChain.size(); ++i) {
+        MipLevel& mip = mipChain[i];
+        if (mip.framebuffer) vkDestroyFramebuffer(device, mip.framebuffer, nullptr);
+        mip.framebuffer = VK_NULL_HANDLE;
+        mip.imageView = views[i];
+
         vk::ImageView attachment(mip.imageView);
         auto fbInfo = vk::FramebufferCreateInfo{}
             .setRenderPass(**downsampleRenderPass_)
@@ -150,11 +158,13 @@ bool BloomSystem::createMipChain() {
 }
 
 bool BloomSystem::createRenderPass() {
+    // Both passes leave the mip as a color attachment; the FrameGraph
+    // transitions it for sampling from the resource declarations
+
     // Downsample render pass - DONT_CARE since we're writing fresh data
     if (!RenderPassBuilder()
             .addColorAttachment(AttachmentBuilder::color(static_cast<vk::Format>(BLOOM_FORMAT))
-                .loadOp(vk::AttachmentLoadOp::eDontCare)
-                .finalLayout(vk::ImageLayout::eShaderReadOnlyOptimal))
+                .loadOp(vk::AttachmentLoadOp::eDontCare))
             .buildInto(*raiiDevice_, downsampleRenderPass_)) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create downsample render pass");
         return false;
@@ -164,8 +174,7 @@ bool BloomSystem::createRenderPass() {
     if (!RenderPassBuilder()
             .addColorAttachment(AttachmentBuilder::color(static_cast<vk::Format>(BLOOM_FORMAT))
                 .loadOp(vk::AttachmentLoadOp::eLoad)
-                .initialLayout(vk::ImageLayout::eColorAttachmentOptimal)
-                .finalLayout(vk::ImageLayout::eShaderReadOnlyOptimal))
+                .initialLayout(vk::ImageLayout::eColorAttachmentOptimal))
             .buildInto(*raiiDevice_, upsampleRenderPass_)) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create upsample render pass");
         return false;
@@ -283,135 +292,128 @@ bool BloomSystem::createDescriptorSets() {
 void BloomSystem::destroyMipChain() {
     for (auto& mip : mipChain) {
         if (mip.framebuffer) vkDestroyFramebuffer(device, mip.framebuffer, nullptr);
-        if (mip.imageView) vkDestroyImageView(device, mip.imageView, nullptr);
-        if (mip.image) vmaDestroyImage(allocator, mip.image, mip.allocation);
     }
     mipChain.clear();
 }
 
-void BloomSystem::recordBloomPass(VkCommandBuffer cmd, VkImageView hdrInput) {
-    if (mipChain.empty()) return;
+void BloomSystem::beginMipPass(vk::CommandBuffer cmd, vk::RenderPass renderPass, uint32_t mip) {
+    vk::Extent2D mipExtent{mipChain[mip].extent.width, mipChain[mip].extent.height};
+    auto renderPassInfo = vk::RenderPassBeginInfo{}
+        .setRenderPass(renderPass)
+        .setFramebuffer(mipChain[mip].framebuffer)
+        .setRenderArea(vk::Rect2D{{0, 0}, mipExtent});
+
+    cmd.beginRenderPass(renderPassInfo, vk::SubpassContents::eInline);
+
+    // Set viewport and scissor
+    auto viewport = vk::Viewport{}
+        .setX(0.0f)
+        .setY(0.0f)
+        .setWidth(static_cast<float>(mipChain[mip].extent.width))
+        .setHeight(static_cast<float>(mipChain[mip].extent.height))
+        .setMinDepth(0.0f)
+        .setMaxDepth(1.0f);
+    cmd.setViewport(0, viewport);
+
+    auto scissor = vk::Rect2D{}
+        .setOffset({0, 0})
+        .setExtent(mipExtent);
+    cmd.setScissor(0, scissor);
+}
+
+void BloomSystem::recordDownsample(VkCommandBuffer cmd, uint32_t mip, VkImageView hdrInput) {
+    if (mip >= mipChain.size() || !mipChain[mip].framebuffer) return;
 
     vk::CommandBuffer vkCmd(cmd);
 
-    // Downsample pass - from HDR to smallest mip
-    for (size_t i = 0; i < mipChain.size(); ++i) {
-        // Update descriptor set to sample from previous level
-        VkImageView sourceView = (i == 0) ? hdrInput : mipChain[i - 1].imageView;
-        DescriptorManager::SetWriter(device, downsampleDescSets[i])
-            .writeImage(0, sourceView, **sampler_)
-            .update();
-
-        // Begin render pass
-        vk::Extent2D mipExtent{mipChain[i].extent.width, mipChain[i].extent.height};
-        auto renderPassInfo = vk::RenderPassBeginInfo{}
-            .setRenderPass(**downsampleRenderPass_)
-            .setFramebuffer(mipChain[i].framebuffer)
-            .setRenderArea(vk::Rect2D{{0, 0}, mipExtent});
-
-        vkCmd.beginRenderPass(renderPassInfo, vk::SubpassContents::eInline);
-
-        // Set viewport and scissor
-        auto viewport = vk::Viewport{}
-            .setX(0.0f)
-            .setY(0.0f)
-            .setWidth(static_cast<float>(mipChain[i].extent.width))
-            .setHeight(static_cast<float>(mipChain[i].extent.height))
-            .setMinDepth(0.0f)
-            .setMaxDepth(1.0f);
-        vkCmd.setViewport(0, viewport);
-
-        auto scissor = vk::Rect2D{}
-            .setOffset({0, 0})
-            .setExtent(mipExtent);
-        vkCmd.setScissor(0, scissor);
-
-        // Bind pipeline and descriptor set
-        vkCmd.bindPipeline(vk::PipelineBindPoint::eGraphics, **downsamplePipeline_);
-        vkCmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, **downsamplePipelineLayout_,
-                                 0, vk::DescriptorSet(downsampleDescSets[i]), {});
-
-        // Push constants - use SOURCE resolution for texel size calculation
-        DownsamplePushConstants pushConstants = {};
-        if (i == 0) {
-            // First pass samples from HDR input at full resolution
-            pushConstants.resolutionX = static_cast<float>(extent.width);
-            pushConstants.resolutionY = static_cast<float>(extent.height);
-        } else {
-            // Subsequent passes sample from previous mip level
-            pushConstants.resolutionX = static_cast<float>(mipChain[i - 1].extent.width);
-            pushConstants.resolutionY = static_cast<float>(mipChain[i - 1].extent.height);
-        }
-        pushConstants.threshold = threshold;
-        pushConstants.isFirstPass = (i == 0) ? 1 : 0;
+    // Update descriptor set to sample from previous level
+    VkImageView sourceView = (mip == 0) ? hdrInput : mipChain[mip - 1].imageView;
+    DescriptorManager::SetWriter(device, downsampleDescSets[mip])
+        .writeImage(0, sourceView, **sampler_)
+        .update();
+
+    beginMipPass(vkCmd, **downsampleRenderPass_, mip);
+
+    // Bind pipeline and descriptor set
+    vkCmd.bindPipeline(vk::PipelineBindPoint::eGraphics, **downsamplePipeline_);
+    vkCmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, **downsamplePipelineLayout_,
+                             0, vk::DescriptorSet(downsampleDescSets[mip]), {});
+
+    // Push constants - use SOURCE resolution for texel size calculation
+    DownsamplePushConstants pushConstants = {};
+    if (mip == 0) {
+        // First pass samples from HDR input at full resolution
+        pushConstants.resolutionX = static_cast<float>(extent.width);
+        pushConstants.resolutionY = static_cast<float>(extent.height);
+    } else {
+        // Subsequent passes sample from previous mip level
+        pushConstants.resolutionX = static_cast<float>(mipChain[mip - 1].extent.width);
+        pushConstants.resolutionY = static_cast<float>(mipChain[mip - 1].extent.height);
+    }
+    pushConstants.threshold = threshold;
+    pushConstants.isFirstPass = (mip == 0) ? 1 : 0;
 
-        vkCmd.pushConstants<DownsamplePushConstants>(
-            **downsamplePipelineLayout_,
-            vk::ShaderStageFlagBits::eFragment,
-            0, pushConstants);
+    vkCmd.pushConstants<DownsamplePushConstants>(
+        **downsamplePipelineLayout_,
+        vk::ShaderStageFlagBits::eFragment,
+        0, pushConstants);
 
-        // Draw fullscreen triangle
-        vkCmd.draw(3, 1, 0, 0);
+    // Draw fullscreen triangle
+    vkCmd.draw(3, 1, 0, 0);
 
-        vkCmd.endRenderPass();
-    }
+    vkCmd.endRenderPass();
+}
 
-    // Upsample pass - from smallest mip back to largest
-    // Blend upsampled results additively into each level
-    for (int i = static_cast<int>(mipChain.size()) - 2; i >= 0; --i) {
-        // Update descriptor set to sample from smaller mip (i+1)
-        DescriptorManager::SetWriter(device, upsampleDescSets[i])
-            .writeImage(0, mipChain[i + 1].imageView, **sampler_)
-            .update();
-
-        // Transition current mip to color attachment for blending
-        BarrierHelpers::imageToColorAttachment(vkCmd, mipChain[i].image);
-
-        // Begin render pass with LOAD operation to preserve downsampled content
-        vk::Extent2D mipExtent{mipChain[i].extent.width, mipChain[i].extent.height};
-        auto renderPassInfo = vk::RenderPassBeginInfo{}
-            .setRenderPass(**upsampleRenderPass_)
-            .setFramebuffer(mipChain[i].framebuffer)
-            .setRenderArea(vk::Rect2D{{0, 0}, mipExtent});
-
-        vkCmd.beginRenderPass(renderPassInfo, vk::SubpassContents::eInline);
-
-        // Set viewport and scissor
-        auto viewport = vk::Viewport{}
-            .setX(0.0f)
-            .setY(0.0f)
-            .setWidth(static_cast<float>(mipChain[i].extent.width))
-            .setHeight(static_cast<float>(mipChain[i].extent.height))
-            .setMinDepth(0.0f)
-            .setMaxDepth(1.0f);
-        vkCmd.setViewport(0, viewport);
-
-        auto scissor = vk::Rect2D{}
-            .setOffset({0, 0})
-            .setExtent(mipExtent);
-        vkCmd.setScissor(0, scissor);
-
-        // Bind pipeline and descriptor set
-        vkCmd.bindPipeline(vk::PipelineBindPoint::eGraphics, **upsamplePipeline_);
-        vkCmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, **upsamplePipelineLayout_,
-                                 0, vk::DescriptorSet(upsampleDescSets[i]), {});
-
-        // Push constants - use SOURCE resolution (the smaller mip being sampled)
-        UpsamplePushConstants pushConstants = {};
-        pushConstants.resolutionX = static_cast<float>(mipChain[i + 1].extent.width);
-        pushConstants.resolutionY = static_cast<float>(mipChain[i + 1].extent.height);
-        pushConstants.filterRadius = 1.0f;
-
-        vkCmd.pushConstants<UpsamplePushConstants>(
-            **upsamplePipelineLayout_,
-            vk::ShaderStageFlagBits::eFragment,
-            0, pushConstants);
-
-        // Draw fullscreen triangle
-        vkCmd.draw(3, 1, 0, 0);
-
-        vkCmd.endRenderPass();
-    }
+void BloomSystem::recordUpsample(VkCommandBuffer cmd, uint32_t mip) {
+    if (mip + 1 >= mipChain.size() || !mipChain[mip].framebuffer) return;
+
+    vk::CommandBuffer vkCmd(cmd);
+
+    // Update descriptor set to sample from smaller mip (mip + 1)
+    DescriptorManager::SetWriter(device, upsampleDescSets[mip])
+        .writeImage(0, mipChain[mip + 1].imageView, **sampler_)
+        .update();
 
-    // Final mip is now in SHADER_READ_ONLY_OPTIMAL and ready for compositing
+    // LOAD operation preserves the downsampled content for additive blending
+    beginMipPass(vkCmd, **upsampleRenderPass_, mip);
+
+    // Bind pipeline and descriptor set
+    vkCmd.bindPipeline(vk::PipelineBindPoint::eGraphics, **upsamplePipeline_);
+    vkCmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, **upsamplePipelineLayout_,
+                             0, vk::DescriptorSet(upsampleDescSets[mip]), {});
+
+    // Push constants - use SOURCE resolution (the smaller mip being sampled)
+    UpsamplePushConstants pushConstants = {};
+    pushConstants.resolutionX = static_cast<float>(mipChain[mip + 1].extent.width);
+    pushConstants.resolutionY = static_cast<float>(mipChain[mip + 1].extent.height);
+    pushConstants.filterRadius = 1.0f;
+
+    vkCmd.pushConstants<UpsamplePushConstants>(
+        **upsamplePipelineLayout_,
+        vk::ShaderStageFlagBits::eFragment,
+        0, pushConstants);
+
+    // Draw fullscreen triangle
+    vkCmd.draw(3, 1, 0, 0);
+
+    vkCmd.endRenderPass();
+}
+
+void BloomSystem::recordClearOutput(VkCommandBuffer cmd) {
+    if (mipChain.empty() || !mipChain[0].framebuffer) return;
+
+    vk::CommandBuffer vkCmd(cmd);
+    beginMipPass(vkCmd, **downsampleRenderPass_, 0);
+
+    auto clear = vk::ClearAttachment{}
+        .setAspectMask(vk::ImageAspectFlagBits::eColor)
+        .setColorAttachment(0)
+        .setClearValue(vk::ClearColorValue(std::array<float, 4>{0.0f, 0.0f, 0.0f, 0.0f}));
+    auto rect = vk::ClearRect{}
+        .setRect(vk::Rect2D{{0, 0}, {mipChain[0].extent.width, mipChain[0].extent.height}})
+        .setBaseArrayLayer(0)
+        .setLayerCount(1);
+    vkCmd.clearAttachments(clear, rect);
+
+    vkCmd.endRenderPass();
 }
@@ -43,7 +43,22 @@ public:
 
     void resize(VkExtent2D newExtent);
 
-    void recordBloomPass(VkCommandBuffer cmd, VkImageView hdrInput);
+    // The mip chain images are FrameGraph transients: declare one per mip
+    // from getMipImageInfo(), then hand the realized views to bindMipChain()
+    // (again after every realizeTransients())
+    uint32_t getMipCount() const { return static_cast<uint32_t>(mipChain.size()); }
+    vk::ImageCreateInfo getMipImageInfo(uint32_t mip) const;
+    bool bindMipChain(const std::vector<VkImageView>& views);
+
+    // One render pass each; the graph records the layout transitions between
+    // them. Downsample mip N reads mip N-1 (the HDR input for mip 0), upsample
+    // mip N blends mip N+1 into it.
+    void recordDownsample(VkCommandBuffer cmd, uint32_t mip, VkImageView hdrInput);
+    void recordUpsample(VkCommandBuffer cmd, uint32_t mip);
+
+    // Bloom skipped this frame: leave mip 0 black for the composite, since
+    // transient contents don't survive between frames
+    void recordClearOutput(VkCommandBuffer cmd);
 
     VkImageView getBloomOutput() const { return mipChain.empty() ? VK_NULL_HANDLE : mipChain[0].imageView; }
     VkSampler getBloomSampler() const { return sampler_ ? **sampler_ : VK_NULL_HANDLE; }
@@ -59,14 +74,13 @@ private:
     void cleanup();
 
     struct MipLevel {
-        VkImage image = VK_NULL_HANDLE;
-        VmaAllocation allocation = VK_NULL_HANDLE;
-        VkImageView imageView = VK_NULL_HANDLE;
+        VkImageView imageView = VK_NULL_HANDLE;     // Owned by the FrameGraph
         VkFramebuffer framebuffer = VK_NULL_HANDLE;
         VkExtent2D extent = {0, 0};
     };
 
     bool createMipChain();
+    void beginMipPass(vk::CommandBuffer cmd, vk::RenderPass renderPass, uint32_t mip);
     bool createRenderPass();
     bool createSampler();
     bool createDescriptorSetLayouts();
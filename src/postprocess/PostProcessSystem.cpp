@@ -63,8 +63,8 @@ std::optional<PostProcessSystem::Bundle> PostProcessSystem::createWithDependenci
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "GodRaysSystem unavailable, god rays disabled");
     }
 
-    // Wire bloom texture to post-process system
-    postProcessSystem->setBloomTexture(bloomSystem->getBloomOutput(), bloomSystem->getBloomSampler());
+    // The bloom texture is wired once the frame graph has realized its mip
+    // chain (PostPasses::bindTransients)
 
     // Wire bilateral grid to post-process system
     postProcessSystem->setBilateralGrid(bilateralGridSystem->getGridView(), bilateralGridSystem->getGridSampler());
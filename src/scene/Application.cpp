@@ -3,12 +3,15 @@
 #include <chrono>
 #include <cmath>
 #include <cstdio>
+#include <filesystem>
 #include <unordered_set>
 #include "core/vulkan/VulkanContext.h"
 #include "core/LoadingRenderer.h"
 #include "loading/LoadJobQueue.h"
 #include "loading/LoadJobFactory.h"
+#include "loading/StartupTimeline.h"
 #include "core/threading/TaskScheduler.h"
+#include "core/asset/DerivedDataCache.h"
 #include "InitProfiler.h"
 #include "Profiler.h"
 
@@ -31,9 +34,11 @@
 #include "core/interfaces/IDebugControl.h"
 #include "core/interfaces/IWeatherState.h"
 #include "core/interfaces/ITerrainControl.h"
+#include "core/interfaces/IGrassControl.h"
 #include "core/interfaces/IPlayerControl.h"
 #include "DebugLineSystem.h"
 #include "npc/NPCSimulation.h"
+#include "ecs/SpatialSystem.h"
 #include "ml/unicon/Controller.h"
 #include "Texture.h"
 
@@ -48,6 +53,7 @@
 bool Application::init(const std::string& title, int width, int height) {
     // Reset and start init profiler
     InitProfiler::get().reset();
+    Loading::StartupTimeline::instance().reset();
 
     {
         INIT_PROFILE_PHASE("SDL");
@@ -90,6 +96,13 @@ bool Application::init(const std::string& title, int width, int height) {
 
     std::string resourcePath = getResourcePath();
 
+    // Imported asset cache; must be configured before the first loader runs
+    {
+        DerivedDataCache::Config cacheConfig = DerivedDataCache::instanceConfig();
+        cacheConfig.directory = resourcePath + "/cache/derived";
+        DerivedDataCache::configureInstance(cacheConfig);
+    }
+
     // Complete Vulkan device initialization (surface, device, swapchain)
     // This must happen before LoadingRenderer can be created
     {
@@ -562,18 +575,119 @@ bool Application::init(const std::string& title, int width, int height) {
     // Finalize init profiler and log results
     InitProfiler::get().finalize();
 
+    // Every subsystem has registered its scheduler pool by now
+    TaskScheduler::instance().logThreadReport();
+    DerivedDataCache::instance().logReport();
+
     // Capture init timing to flamegraph
     renderer_->getSystems().profiler().captureInitFlamegraph();
 
+    // Export it with the overlapped loader work so startup regressions show up in a diff
+    Loading::StartupTimeline::instance().exportFolded(
+        resourcePath + "/cache/startup.folded",
+        &renderer_->getSystems().profiler().getInitFlamegraph());
+
+    // Keep startup for any trace captured later
+    {
+        const auto& timeline = Loading::StartupTimeline::instance();
+        auto toNs = [](Loading::StartupTimeline::Clock::time_point t) {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                t.time_since_epoch()).count());
+        };
+        std::vector<TraceExporter::StartupSpan> spans;
+        for (const auto& span : timeline.getSpans()) {
+            spans.push_back({span.lane, span.name, toNs(span.start), toNs(span.end)});
+        }
+        auto& profiler = renderer_->getSystems().profiler();
+        profiler.getTraceExporter().setStartup(toNs(timeline.getOrigin()), profiler.getInitFlamegraph(),
+                                               std::move(spans));
+    }
+
     running = true;
     return true;
 }
 
+void Application::startTraceCapture(const std::string& path, uint32_t frameCount) {
+    auto& profiler = renderer_->getSystems().profiler();
+    TraceExporter& exporter = profiler.getTraceExporter();
+    exporter.setCapacity(frameCount > 0 ? frameCount : TraceExporter::DEFAULT_CAPACITY);
+
+    tracePath_ = path.empty() ? getResourcePath() + "/cache/trace.json" : path;
+    traceFramesRemaining_ = frameCount;
+    profiler.setTraceRecording(true);
+    if (frameCount > 0) {
+        SDL_Log("Trace: recording %u frames to %s", frameCount, tracePath_.c_str());
+    } else {
+        SDL_Log("Trace: recording the last %zu frames, F9 writes %s", exporter.getCapacity(), tracePath_.c_str());
+    }
+}
+
+void Application::finishTraceCapture() {
+    auto& profiler = renderer_->getSystems().profiler();
+    if (!profiler.isTraceRecording()) return;
+
+    profiler.setTraceRecording(false);
+    profiler.getTraceExporter().writeJson(tracePath_);
+    traceFramesRemaining_ = 0;
+}
+
+void Application::startPacingLog(const std::string& path) {
+    auto& pacing = renderer_->getSystems().profiler().getFramePacing();
+    std::string extension = std::filesystem::path(path).extension().string();
+    auto format = extension == ".jsonl" ? FramePacingAnalyzer::LogFormat::JsonLines
+                                        : FramePacingAnalyzer::LogFormat::Csv;
+    if (pacing.startLog(path, format)) {
+        pacingLogPath_ = path;
+    }
+}
+
+void Application::finishPacingLog() {
+    if (pacingLogPath_.empty()) return;
+
+    auto& pacing = renderer_->getSystems().profiler().getFramePacing();
+    pacing.stopLog();
+    std::filesystem::path summaryPath(pacingLogPath_);
+    summaryPath.replace_filename(summaryPath.stem().string() + ".summary.json");
+    if (pacing.writeSummaryJson(summaryPath.string())) {
+        FramePacingAnalyzer::Summary summary = pacing.getSummary();
+        SDL_Log("Frame pacing: p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, %zu hitches (last %zu frames) -> %s",
+                summary.p50Ms, summary.p95Ms, summary.p99Ms, summary.hitches, summary.frames,
+                summaryPath.string().c_str());
+    }
+    pacingLogPath_.clear();
+}
+
+void Application::recordTraceCounters() {
+    auto& systems = renderer_->getSystems();
+    auto& profiler = systems.profiler();
+    if (!profiler.isTraceRecording()) return;
+
+    IOService::Stats io = profiler.getIOStats();
+    profiler.addTraceCounter("IO requests", "Queued", io.queueDepth);
+    profiler.addTraceCounter("IO requests", "In flight", io.inFlight);
+    profiler.addTraceCounter("IO bytes in flight", "MB", static_cast<double>(io.bytesInFlight) / (1024.0 * 1024.0));
+
+    profiler.addTraceCounter("Tiles in flight", "Grass", systems.grassControl().getPendingLoadCount());
+    if (const auto* vt = systems.terrain().getVirtualTexture()) {
+        profiler.addTraceCounter("Tiles in flight", "Virtual texture", vt->getPendingTileCount());
+        profiler.addTraceCounter("VT cache slots", "Used", vt->getCacheUsedSlots());
+        profiler.addTraceCounter("VT cache slots", "Capacity", vt->getCacheSlotCount());
+    }
+
+    ecs::systems::NPCLODStats npcs = ecs::systems::getNPCLODStats(ecsWorld_);
+    profiler.addTraceCounter("NPC tiers", "Real", static_cast<double>(npcs.realCount));
+    profiler.addTraceCounter("NPC tiers", "Bulk", static_cast<double>(npcs.bulkCount));
+    profiler.addTraceCounter("NPC tiers", "Virtual", static_cast<double>(npcs.virtualCount));
+}
+
 void Application::run() {
     auto lastTime = std::chrono::high_resolution_clock::now();
     float smoothedFps = 60.0f;
 
     while (running) {
+        Profiler& profiler = renderer_->getSystems().profiler();
+        profiler.beginCpuFrame();
+
         auto currentTime = std::chrono::high_resolution_clock::now();
         float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
         lastTime = currentTime;
@@ -894,6 +1008,13 @@ void Application::run() {
             gui_->cancelFrame();
         }
 
+        profiler.endCpuFrame();
+        recordTraceCounters();
+        profiler.advanceFrame();
+        if (traceFramesRemaining_ > 0 && --traceFramesRemaining_ == 0) {
+            finishTraceCapture();
+        }
+
         // Update window title with FPS, time of day, and camera mode
         if (deltaTime > 0.0f) {
             smoothedFps = smoothedFps * 0.95f + (1.0f / deltaTime) * 0.05f;
@@ -912,6 +1033,8 @@ void Application::run() {
 }
 
 void Application::shutdown() {
+    finishTraceCapture();
+    finishPacingLog();
     renderer_->waitIdle();
     gui_.reset();  // RAII cleanup via destructor
     // InputSystem cleanup handled by destructor (RAII)
@@ -989,6 +1112,15 @@ void Application::processEvents() {
                 else if (event.key.scancode == SDL_SCANCODE_F1) {
                     gui_->toggleVisibility();
                 }
+                else if (event.key.scancode == SDL_SCANCODE_F9) {
+                    // First press starts a trace of recent frames, second writes it
+                    // to cache/trace.json (never over an earlier --trace file)
+                    if (sys.profiler().isTraceRecording()) {
+                        finishTraceCapture();
+                    } else {
+                        startTraceCapture({}, 0);
+                    }
+                }
                 else if (event.key.scancode == SDL_SCANCODE_1) {
                     sys.time().setTimeOfDay(0.25f);
                 }
@@ -1529,6 +1661,10 @@ void Application::updateECS(float deltaTime) {
     // This must run before visibility culling so world transforms are current
     ecs::systems::updateWorldTransforms(ecsWorld_);
 
+    // Move spatial index proxies of entities that moved; visibility, light
+    // gathering and proximity queries read the index for the rest of the frame
+    ecs::systems::updateSpatialIndex(ecsWorld_);
+
     // Update visibility culling based on camera frustum
     glm::mat4 viewProj = camera.getProjectionMatrix() * camera.getViewMatrix();
     ecs::Frustum frustum = ecs::Frustum::fromViewProjection(viewProj);
@@ -35,6 +35,18 @@ public:
     // Access renderer for command line toggle configuration
     Renderer& getRenderer() { return *renderer_; }
 
+    /**
+     * Record a Chrome trace of the next frameCount frames (plus startup) and
+     * write it to path. frameCount = 0 records until F9 or shutdown.
+     */
+    void startTraceCapture(const std::string& path, uint32_t frameCount);
+
+    /**
+     * Per-frame pacing log for soak runs (JSON lines for .jsonl, else CSV).
+     * The percentile/hitch summary is written next to it at shutdown.
+     */
+    void startPacingLog(const std::string& path);
+
 private:
     void processEvents();
     void applyInputToCamera();
@@ -45,6 +57,9 @@ private:
     void initECS();
     void updateECS(float deltaTime);
     void spawnRagdoll();
+    void recordTraceCounters();
+    void finishTraceCapture();
+    void finishPacingLog();
 
     SDL_Window* window = nullptr;
     std::unique_ptr<Renderer> renderer_;
@@ -73,6 +88,13 @@ private:
     float currentFps = 60.0f;
     float lastDeltaTime = 0.016f;
 
+    // Chrome trace capture (F9 or --trace)
+    std::string tracePath_;
+    uint32_t traceFramesRemaining_ = 0;     // 0 = until stopped
+
+    // Frame pacing soak log (--pacing-log)
+    std::string pacingLogPath_;
+
     // Camera occlusion parameters (tracking via OccludingCamera ECS tag)
     static constexpr float occlusionFadeSpeed = 8.0f;
     static constexpr float occludedOpacity = 0.3f;
@@ -0,0 +1,281 @@
+#include "FlatHierarchy.h"
+#include <algorithm>
+
+const glm::mat4 FlatHierarchy::identity_(1.0f);
+
+bool FlatHierarchy::insert(uint32_t id, uint32_t parentId) {
+    if (id == NONE || contains(id)) return false;
+
+    uint32_t parentSlot = NONE;
+    uint32_t slot = static_cast<uint32_t>(ids_.size());
+    if (parentId != NONE) {
+        parentSlot = slotOf(parentId);
+        if (parentSlot == NONE) return false;
+        slot = parentSlot + subtreeSizes_[parentSlot];
+    }
+
+    ids_.insert(ids_.begin() + slot, id);
+    parentIds_.insert(parentIds_.begin() + slot, parentId);
+    parentSlots_.insert(parentSlots_.begin() + slot, parentSlot);
+    subtreeSizes_.insert(subtreeSizes_.begin() + slot, 1u);
+    worlds_.insert(worlds_.begin() + slot, glm::mat4(1.0f));
+    dirty_.insert(dirty_.begin() + slot, uint8_t(1));
+
+    if (id >= slotOf_.size()) {
+        slotOf_.resize(static_cast<size_t>(id) + 1, NONE);
+    }
+    addToAncestors(parentSlot, 1);
+    reindexFrom(slot);
+    return true;
+}
+
+void FlatHierarchy::remove(uint32_t id) {
+    uint32_t slot = slotOf(id);
+    if (slot == NONE) return;
+
+    // Orphaned subtrees move to the end, which leaves this slot where it is
+    std::vector<uint32_t> children;
+    childrenOf(id, children);
+    for (uint32_t child : children) {
+        setParent(child, NONE);
+    }
+
+    addToAncestors(parentSlots_[slot], -1);
+    ids_.erase(ids_.begin() + slot);
+    parentIds_.erase(parentIds_.begin() + slot);
+    parentSlots_.erase(parentSlots_.begin() + slot);
+    subtreeSizes_.erase(subtreeSizes_.begin() + slot);
+    worlds_.erase(worlds_.begin() + slot);
+    dirty_.erase(dirty_.begin() + slot);
+
+    slotOf_[id] = NONE;
+    reindexFrom(slot);
+}
+
+bool FlatHierarchy::setParent(uint32_t id, uint32_t newParentId) {
+    uint32_t slot = slotOf(id);
+    if (slot == NONE) return false;
+
+    if (newParentId != NONE) {
+        uint32_t parentSlot = slotOf(newParentId);
+        if (parentSlot == NONE) return false;
+        // The new parent can't be the node itself or inside its subtree
+        if (parentSlot >= slot && parentSlot < slot + subtreeSizes_[slot]) return false;
+    }
+
+    if (parentIds_[slot] == newParentId) return true;
+
+    moveSubtree(slot, newParentId);
+    markDirty(id);
+    return true;
+}
+
+void FlatHierarchy::rebuild(const std::vector<std::pair<uint32_t, uint32_t>>& nodes) {
+    clear();
+    if (nodes.empty()) return;
+
+    uint32_t maxId = 0;
+    for (const auto& [id, parentId] : nodes) {
+        if (id != NONE) maxId = std::max(maxId, id);
+    }
+    slotOf_.assign(static_cast<size_t>(maxId) + 1, NONE);
+
+    // Input index per id; later duplicates are ignored
+    std::vector<uint32_t> indexOf(static_cast<size_t>(maxId) + 1, NONE);
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        uint32_t id = nodes[i].first;
+        if (id != NONE && indexOf[id] == NONE) indexOf[id] = i;
+    }
+
+    auto parentIndex = [&](uint32_t i) -> uint32_t {
+        uint32_t parentId = nodes[i].second;
+        if (parentId == NONE || parentId > maxId || parentId == nodes[i].first) return NONE;
+        return indexOf[parentId];
+    };
+
+    // Children of each input node as one flat list (counting sort by parent)
+    std::vector<uint32_t> childStart(nodes.size() + 1, 0);
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        if (indexOf[nodes[i].first] != i) continue;
+        uint32_t parent = parentIndex(i);
+        if (parent != NONE) childStart[parent + 1]++;
+    }
+    for (size_t i = 1; i < childStart.size(); ++i) childStart[i] += childStart[i - 1];
+    std::vector<uint32_t> childList(childStart.back());
+    std::vector<uint32_t> fill(childStart.begin(), childStart.end() - 1);
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        if (indexOf[nodes[i].first] != i) continue;
+        uint32_t parent = parentIndex(i);
+        if (parent != NONE) childList[fill[parent]++] = i;
+    }
+
+    ids_.reserve(nodes.size());
+    parentIds_.reserve(nodes.size());
+    parentSlots_.reserve(nodes.size());
+
+    std::vector<uint8_t> visited(nodes.size(), 0);
+    std::vector<uint32_t> stack;
+
+    // Depth-first from one root, children visited in input order
+    auto emitTree = [&](uint32_t root) {
+        stack.push_back(root);
+        visited[root] = 1;
+        while (!stack.empty()) {
+            uint32_t i = stack.back();
+            stack.pop_back();
+
+            uint32_t id = nodes[i].first;
+            uint32_t parent = i == root ? NONE : parentIndex(i);
+            uint32_t parentId = parent == NONE ? NONE : nodes[parent].first;
+            slotOf_[id] = static_cast<uint32_t>(ids_.size());
+            ids_.push_back(id);
+            parentIds_.push_back(parentId);
+            parentSlots_.push_back(parentId == NONE ? NONE : slotOf_[parentId]);
+
+            for (uint32_t c = childStart[i + 1]; c > childStart[i]; --c) {
+                uint32_t child = childList[c - 1];
+                if (visited[child]) continue;
+                visited[child] = 1;
+                stack.push_back(child);
+            }
+        }
+    };
+
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        if (indexOf[nodes[i].first] == i && parentIndex(i) == NONE) emitTree(i);
+    }
+    // Whatever is left hangs off a cycle
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        if (indexOf[nodes[i].first] == i && !visited[i]) emitTree(i);
+    }
+
+    subtreeSizes_.assign(ids_.size(), 1u);
+    for (size_t slot = ids_.size(); slot-- > 0;) {
+        if (parentSlots_[slot] != NONE) subtreeSizes_[parentSlots_[slot]] += subtreeSizes_[slot];
+    }
+    worlds_.assign(ids_.size(), glm::mat4(1.0f));
+    dirty_.assign(ids_.size(), uint8_t(1));
+}
+
+void FlatHierarchy::clear() {
+    ids_.clear();
+    parentIds_.clear();
+    parentSlots_.clear();
+    subtreeSizes_.clear();
+    worlds_.clear();
+    dirty_.clear();
+    slotOf_.clear();
+}
+
+uint32_t FlatHierarchy::parentOf(uint32_t id) const {
+    uint32_t slot = slotOf(id);
+    return slot == NONE ? NONE : parentIds_[slot];
+}
+
+void FlatHierarchy::childrenOf(uint32_t id, std::vector<uint32_t>& out) const {
+    out.clear();
+    uint32_t slot = slotOf(id);
+    if (slot == NONE) return;
+
+    uint32_t end = slot + subtreeSizes_[slot];
+    for (uint32_t child = slot + 1; child < end; child += subtreeSizes_[child]) {
+        out.push_back(ids_[child]);
+    }
+}
+
+void FlatHierarchy::roots(std::vector<uint32_t>& out) const {
+    out.clear();
+    for (uint32_t slot = 0; slot < ids_.size(); slot += subtreeSizes_[slot]) {
+        out.push_back(ids_[slot]);
+    }
+}
+
+void FlatHierarchy::markDirty(uint32_t id) {
+    uint32_t slot = slotOf(id);
+    if (slot == NONE) return;
+    std::fill(dirty_.begin() + slot, dirty_.begin() + slot + subtreeSizes_[slot], uint8_t(1));
+}
+
+void FlatHierarchy::markAllDirty() {
+    std::fill(dirty_.begin(), dirty_.end(), uint8_t(1));
+}
+
+bool FlatHierarchy::isDirty(uint32_t id) const {
+    uint32_t slot = slotOf(id);
+    return slot != NONE && dirty_[slot] != 0;
+}
+
+const glm::mat4& FlatHierarchy::world(uint32_t id) const {
+    uint32_t slot = slotOf(id);
+    return slot == NONE ? identity_ : worlds_[slot];
+}
+
+std::vector<FlatHierarchy::Range> FlatHierarchy::partition(size_t maxRanges) const {
+    std::vector<Range> ranges;
+    uint32_t total = static_cast<uint32_t>(ids_.size());
+    if (total == 0 || maxRanges == 0) return ranges;
+
+    uint32_t target = static_cast<uint32_t>((total + maxRanges - 1) / maxRanges);
+    Range current;
+    for (uint32_t slot = 0; slot < total; slot += subtreeSizes_[slot]) {
+        current.end = slot + subtreeSizes_[slot];
+        if (current.end - current.begin >= target && ranges.size() + 1 < maxRanges) {
+            ranges.push_back(current);
+            current.begin = current.end;
+        }
+    }
+    if (current.end > current.begin) ranges.push_back(current);
+    return ranges;
+}
+
+void FlatHierarchy::moveSubtree(uint32_t slot, uint32_t newParentId) {
+    uint32_t count = subtreeSizes_[slot];
+    addToAncestors(parentSlots_[slot], -static_cast<int32_t>(count));
+
+    auto first = static_cast<std::ptrdiff_t>(slot);
+    auto last = first + static_cast<std::ptrdiff_t>(count);
+    std::vector<uint32_t> ids(ids_.begin() + first, ids_.begin() + last);
+    std::vector<uint32_t> parentIds(parentIds_.begin() + first, parentIds_.begin() + last);
+    std::vector<uint32_t> sizes(subtreeSizes_.begin() + first, subtreeSizes_.begin() + last);
+    std::vector<glm::mat4> worlds(worlds_.begin() + first, worlds_.begin() + last);
+    std::vector<uint8_t> dirty(dirty_.begin() + first, dirty_.begin() + last);
+    parentIds[0] = newParentId;
+
+    ids_.erase(ids_.begin() + first, ids_.begin() + last);
+    parentIds_.erase(parentIds_.begin() + first, parentIds_.begin() + last);
+    parentSlots_.erase(parentSlots_.begin() + first, parentSlots_.begin() + last);
+    subtreeSizes_.erase(subtreeSizes_.begin() + first, subtreeSizes_.begin() + last);
+    worlds_.erase(worlds_.begin() + first, worlds_.begin() + last);
+    dirty_.erase(dirty_.begin() + first, dirty_.begin() + last);
+    reindexFrom(slot);
+
+    uint32_t parentSlot = newParentId == NONE ? NONE : slotOf_[newParentId];
+    uint32_t dest = parentSlot == NONE ? static_cast<uint32_t>(ids_.size())
+                                       : parentSlot + subtreeSizes_[parentSlot];
+    auto at = static_cast<std::ptrdiff_t>(dest);
+    ids_.insert(ids_.begin() + at, ids.begin(), ids.end());
+    parentIds_.insert(parentIds_.begin() + at, parentIds.begin(), parentIds.end());
+    parentSlots_.insert(parentSlots_.begin() + at, count, NONE);
+    subtreeSizes_.insert(subtreeSizes_.begin() + at, sizes.begin(), sizes.end());
+    worlds_.insert(worlds_.begin() + at, worlds.begin(), worlds.end());
+    dirty_.insert(dirty_.begin() + at, dirty.begin(), dirty.end());
+
+    addToAncestors(parentSlot, static_cast<int32_t>(count));
+    reindexFrom(std::min(slot, dest));
+}
+
+void FlatHierarchy::addToAncestors(uint32_t parentSlot, int32_t delta) {
+    while (parentSlot != NONE) {
+        subtreeSizes_[parentSlot] = static_cast<uint32_t>(static_cast<int32_t>(subtreeSizes_[parentSlot]) + delta);
+        parentSlot = parentSlots_[parentSlot];
+    }
+}
+
+void FlatHierarchy::reindexFrom(uint32_t first) {
+    // Parents precede children, so a parent's slot is always fixed up first
+    for (uint32_t slot = first; slot < ids_.size(); ++slot) {
+        slotOf_[ids_[slot]] = slot;
+        uint32_t parentId = parentIds_[slot];
+        parentSlots_[slot] = parentId == NONE ? NONE : slotOf_[parentId];
+    }
+}
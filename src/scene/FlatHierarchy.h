@@ -0,0 +1,180 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * FlatHierarchy - Parent/child topology stored in depth-first (pre-order) slots
+ *
+ * Every node's subtree occupies the contiguous slot range
+ * [slot, slot + subtreeSize), so parents always precede their children and a
+ * world-matrix update is one forward pass over flat arrays: no per-node child
+ * lists, no recursion and no per-frame sort.
+ *
+ * Nodes are named by caller-chosen dense ids (TransformHierarchy uses its node
+ * index, the ECS uses the entity index). Attach/detach moves the affected
+ * subtree as one block, so the order stays valid without rebuilding.
+ *
+ * Structural edits are not cheap, though: insert(), remove() and setParent()
+ * are O(n) each, since the slot arrays shift and every slot after the edit
+ * is reindexed. That suits the occasional attach or detach; bursts of edits
+ * (spawning a level, reparenting many nodes in one frame) should go through
+ * a single rebuild() instead.
+ *
+ * Dirty bits are per slot. markDirty() flags the node's whole subtree (a
+ * contiguous range), so update() only recomputes flagged slots and never has
+ * to propagate. Separate root subtrees never read each other's matrices, which
+ * makes partition() ranges safe to update concurrently on worker threads.
+ *
+ * Usage:
+ *   FlatHierarchy flat;
+ *   flat.insert(0);                    // root
+ *   flat.insert(1, 0);                 // child of 0
+ *   flat.markDirty(0);
+ *   flat.update([&](uint32_t id) { return locals[id].toMatrix(); });
+ *   const glm::mat4& world = flat.world(1);
+ */
+class FlatHierarchy {
+public:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    // Half-open slot range covering whole root subtrees
+    struct Range {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+    };
+
+    // ========================================================================
+    // Topology
+    // ========================================================================
+
+    // Add a node as the last child of parentId (or the last root). Returns
+    // false if the id is already present or the parent is unknown. O(n).
+    bool insert(uint32_t id, uint32_t parentId = NONE);
+
+    // Remove a node; its children become roots. O(n).
+    void remove(uint32_t id);
+
+    // Move a node and its subtree under newParentId (NONE makes it a root).
+    // Returns false for unknown ids or if it would create a cycle. O(n).
+    bool setParent(uint32_t id, uint32_t newParentId);
+
+    // Replace the whole topology from (id, parentId) pairs in one O(n) pass.
+    // Parents missing from the list make their children roots; cycles are
+    // broken by promoting one member to a root.
+    void rebuild(const std::vector<std::pair<uint32_t, uint32_t>>& nodes);
+
+    void clear();
+
+    bool contains(uint32_t id) const { return slotOf(id) != NONE; }
+    uint32_t parentOf(uint32_t id) const;
+
+    // Direct children in slot order
+    void childrenOf(uint32_t id, std::vector<uint32_t>& out) const;
+    // Root ids in slot order
+    void roots(std::vector<uint32_t>& out) const;
+
+    size_t size() const { return ids_.size(); }
+
+    // ========================================================================
+    // Dirty tracking and world matrices
+    // ========================================================================
+
+    // Flag the node and everything below it for recomputation
+    void markDirty(uint32_t id);
+    void markAllDirty();
+    bool isDirty(uint32_t id) const;
+
+    // Cached world matrix (identity for unknown ids); see update()/resolve()
+    const glm::mat4& world(uint32_t id) const;
+
+    // Recompute dirty slots. localMatrix(id) returns the node's local matrix.
+    template <typename LocalFn>
+    void update(LocalFn&& localMatrix) {
+        update(Range{0, static_cast<uint32_t>(ids_.size())}, localMatrix);
+    }
+
+    // Recompute dirty slots in one partition() range. Ranges from the same
+    // partition() call may run concurrently; topology must not change meanwhile.
+    template <typename LocalFn>
+    void update(Range range, LocalFn&& localMatrix) {
+        for (uint32_t slot = range.begin; slot < range.end; ++slot) {
+            if (!dirty_[slot]) continue;
+            computeSlot(slot, localMatrix(ids_[slot]));
+        }
+    }
+
+    // As above, then written(id, world) for each recomputed node, so callers
+    // can copy results out without a second pass over the range
+    template <typename LocalFn, typename WrittenFn>
+    void update(Range range, LocalFn&& localMatrix, WrittenFn&& written) {
+        for (uint32_t slot = range.begin; slot < range.end; ++slot) {
+            if (!dirty_[slot]) continue;
+            computeSlot(slot, localMatrix(ids_[slot]));
+            written(ids_[slot], worlds_[slot]);
+        }
+    }
+
+    // Bring a single node up to date by walking up its dirty ancestors only
+    template <typename LocalFn>
+    const glm::mat4& resolve(uint32_t id, LocalFn&& localMatrix) {
+        uint32_t slot = slotOf(id);
+        if (slot == NONE) return identity_;
+        if (dirty_[slot]) resolveSlot(slot, localMatrix);
+        return worlds_[slot];
+    }
+
+    // Split the slots into at most maxRanges runs of whole root subtrees with
+    // roughly equal node counts
+    std::vector<Range> partition(size_t maxRanges) const;
+
+    // ========================================================================
+    // Slot access (for systems that walk the order themselves)
+    // ========================================================================
+
+    uint32_t slotOf(uint32_t id) const {
+        return id < slotOf_.size() ? slotOf_[id] : NONE;
+    }
+    uint32_t idAt(uint32_t slot) const { return ids_[slot]; }
+    uint32_t parentSlot(uint32_t slot) const { return parentSlots_[slot]; }
+    uint32_t subtreeSize(uint32_t slot) const { return subtreeSizes_[slot]; }
+    glm::mat4& worldAt(uint32_t slot) { return worlds_[slot]; }
+    const glm::mat4& worldAt(uint32_t slot) const { return worlds_[slot]; }
+
+private:
+    void computeSlot(uint32_t slot, const glm::mat4& local) {
+        uint32_t parent = parentSlots_[slot];
+        worlds_[slot] = parent == NONE ? local : worlds_[parent] * local;
+        dirty_[slot] = 0;
+    }
+
+    template <typename LocalFn>
+    void resolveSlot(uint32_t slot, LocalFn& localMatrix) {
+        uint32_t parent = parentSlots_[slot];
+        if (parent != NONE && dirty_[parent]) resolveSlot(parent, localMatrix);
+        computeSlot(slot, localMatrix(ids_[slot]));
+    }
+
+    // Cut the subtree at slot out of the arrays and reinsert it as the last
+    // child of newParentId (or the last root)
+    void moveSubtree(uint32_t slot, uint32_t newParentId);
+    void addToAncestors(uint32_t parentSlot, int32_t delta);
+    // Re-derive slotOf_ and parentSlots_ for slots >= first
+    void reindexFrom(uint32_t first);
+
+    // Per slot, in pre-order
+    std::vector<uint32_t> ids_;
+    std::vector<uint32_t> parentIds_;
+    std::vector<uint32_t> parentSlots_;
+    std::vector<uint32_t> subtreeSizes_;
+    std::vector<glm::mat4> worlds_;
+    std::vector<uint8_t> dirty_;
+
+    // Per id
+    std::vector<uint32_t> slotOf_;
+
+    static const glm::mat4 identity_;
+};
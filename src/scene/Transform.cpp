@@ -1,28 +1,21 @@
 #include "Transform.h"
 #include <algorithm>
 
-const std::vector<TransformHandle> TransformHierarchy::emptyChildren_;
-
 TransformHandle TransformHierarchy::create(const std::string& name, TransformHandle parent) {
     uint32_t index = allocateNode();
 
     Node& node = nodes_[index];
     node.local = Transform{};
-    node.worldMatrix = glm::mat4(1.0f);
     node.name = name;
-    node.parent = TransformHandle::null();
-    node.children.clear();
-    node.dirty = true;
     node.active = true;
 
-    TransformHandle handle;
-    handle.index = index;
-    handle.generation = node.generation;
+    TransformHandle handle = handleAt(index);
 
-    // Set parent (handles root tracking)
-    if (parent.isValid()) {
-        setParent(handle, parent);
+    // Insert directly under the parent (handles root tracking)
+    if (isValid(parent)) {
+        flat_.insert(index, parent.index);
     } else {
+        flat_.insert(index);
         roots_.push_back(handle);
     }
 
@@ -33,27 +26,17 @@ TransformHandle TransformHierarchy::create(const std::string& name, TransformHan
 void TransformHierarchy::destroy(TransformHandle handle) {
     if (!isValid(handle)) return;
 
-    Node& node = nodes_[handle.index];
-
     // Orphan children (make them roots)
-    for (auto& child : node.children) {
-        if (isValid(child)) {
-            nodes_[child.index].parent = TransformHandle::null();
-            roots_.push_back(child);
-        }
-    }
-    node.children.clear();
-
-    // Remove from parent's children list
-    if (node.parent.isValid() && isValid(node.parent)) {
-        auto& siblings = nodes_[node.parent.index].children;
-        siblings.erase(std::remove(siblings.begin(), siblings.end(), handle), siblings.end());
+    for (const auto& child : getChildren(handle)) {
+        roots_.push_back(child);
     }
+    flat_.remove(handle.index);
 
     // Remove from roots if necessary
     roots_.erase(std::remove(roots_.begin(), roots_.end(), handle), roots_.end());
 
     // Mark inactive and increment generation
+    Node& node = nodes_[handle.index];
     node.active = false;
     node.generation++;
     freeList_.push_back(handle.index);
@@ -87,32 +70,17 @@ Transform& TransformHierarchy::localMut(TransformHandle handle) {
 
 void TransformHierarchy::markDirty(TransformHandle handle) {
     if (!isValid(handle)) return;
-    propagateDirty(handle.index);
+    flat_.markDirty(handle.index);
 }
 
 const glm::mat4& TransformHierarchy::getWorldMatrix(TransformHandle handle) {
     static const glm::mat4 identity(1.0f);
     if (!isValid(handle)) return identity;
 
-    Node& node = nodes_[handle.index];
-    if (node.dirty) {
-        updateSingleNode(handle.index);
-    }
-    return node.worldMatrix;
-}
-
-void TransformHierarchy::updateSingleNode(uint32_t index) {
-    Node& node = nodes_[index];
-    if (!node.dirty) return;
-
-    // Walk up to update parent first
-    if (node.parent.isValid() && isValid(node.parent)) {
-        updateSingleNode(node.parent.index);
-        node.worldMatrix = nodes_[node.parent.index].worldMatrix * node.local.toMatrix();
-    } else {
-        node.worldMatrix = node.local.toMatrix();
-    }
-    node.dirty = false;
+    // Walks up only through dirty ancestors
+    return flat_.resolve(handle.index, [this](uint32_t index) {
+        return nodes_[index].local.toMatrix();
+    });
 }
 
 glm::vec3 TransformHierarchy::getWorldPosition(TransformHandle handle) {
@@ -121,54 +89,54 @@ glm::vec3 TransformHierarchy::getWorldPosition(TransformHandle handle) {
 }
 
 void TransformHierarchy::updateWorldMatrices() {
-    // Update all roots, which recursively updates children
-    for (auto& root : roots_) {
-        if (isValid(root)) {
-            updateWorldMatrixRecursive(root.index);
-        }
-    }
+    updateWorldMatrices(FlatHierarchy::Range{0, static_cast<uint32_t>(flat_.size())});
+}
+
+std::vector<FlatHierarchy::Range> TransformHierarchy::partitionWorldUpdate(size_t maxRanges) const {
+    return flat_.partition(maxRanges);
+}
+
+void TransformHierarchy::updateWorldMatrices(FlatHierarchy::Range range) {
+    flat_.update(range, [this](uint32_t index) {
+        return nodes_[index].local.toMatrix();
+    });
 }
 
 void TransformHierarchy::setParent(TransformHandle handle, TransformHandle newParent) {
     if (!isValid(handle)) return;
     if (handle == newParent) return;  // Can't parent to self
 
-    Node& node = nodes_[handle.index];
+    bool toRoot = !isValid(newParent);
+    bool wasRoot = flat_.parentOf(handle.index) == FlatHierarchy::NONE;
 
-    // Skip if same parent
-    if (node.parent == newParent) return;
+    // Moves the whole subtree and marks it dirty; refuses cycles
+    if (!flat_.setParent(handle.index, toRoot ? FlatHierarchy::NONE : newParent.index)) return;
 
-    // Remove from old parent
-    if (node.parent.isValid() && isValid(node.parent)) {
-        auto& siblings = nodes_[node.parent.index].children;
-        siblings.erase(std::remove(siblings.begin(), siblings.end(), handle), siblings.end());
-    } else {
-        // Was a root, remove from roots
+    if (wasRoot && !toRoot) {
         roots_.erase(std::remove(roots_.begin(), roots_.end(), handle), roots_.end());
-    }
-
-    // Set new parent
-    node.parent = newParent;
-
-    // Add to new parent or roots
-    if (newParent.isValid() && isValid(newParent)) {
-        nodes_[newParent.index].children.push_back(handle);
-    } else {
+    } else if (!wasRoot && toRoot) {
         roots_.push_back(handle);
     }
-
-    // Mark dirty (world transform changed)
-    propagateDirty(handle.index);
 }
 
 TransformHandle TransformHierarchy::getParent(TransformHandle handle) const {
     if (!isValid(handle)) return TransformHandle::null();
-    return nodes_[handle.index].parent;
+    uint32_t parent = flat_.parentOf(handle.index);
+    if (parent == FlatHierarchy::NONE) return TransformHandle::null();
+    return handleAt(parent);
 }
 
-const std::vector<TransformHandle>& TransformHierarchy::getChildren(TransformHandle handle) const {
-    if (!isValid(handle)) return emptyChildren_;
-    return nodes_[handle.index].children;
+std::vector<TransformHandle> TransformHierarchy::getChildren(TransformHandle handle) const {
+    std::vector<TransformHandle> children;
+    if (!isValid(handle)) return children;
+
+    std::vector<uint32_t> indices;
+    flat_.childrenOf(handle.index, indices);
+    children.reserve(indices.size());
+    for (uint32_t index : indices) {
+        children.push_back(handleAt(index));
+    }
+    return children;
 }
 
 const std::string& TransformHierarchy::getName(TransformHandle handle) const {
@@ -185,49 +153,17 @@ void TransformHierarchy::setName(TransformHandle handle, const std::string& name
 TransformHandle TransformHierarchy::findByName(const std::string& name) const {
     for (size_t i = 0; i < nodes_.size(); ++i) {
         if (nodes_[i].active && nodes_[i].name == name) {
-            TransformHandle h;
-            h.index = static_cast<uint32_t>(i);
-            h.generation = nodes_[i].generation;
-            return h;
+            return handleAt(static_cast<uint32_t>(i));
         }
     }
     return TransformHandle::null();
 }
 
-void TransformHierarchy::propagateDirty(uint32_t index) {
-    Node& node = nodes_[index];
-    if (node.dirty) return;  // Already dirty, children must be too
-
-    node.dirty = true;
-
-    // Propagate to all children
-    for (auto& child : node.children) {
-        if (isValid(child)) {
-            propagateDirty(child.index);
-        }
-    }
-}
-
-void TransformHierarchy::updateWorldMatrixRecursive(uint32_t index) {
-    // Used by batch updateWorldMatrices() - assumes we're called top-down from roots
-    Node& node = nodes_[index];
-
-    if (node.dirty) {
-        if (node.parent.isValid() && isValid(node.parent)) {
-            // Parent should already be up to date (we go top-down)
-            node.worldMatrix = nodes_[node.parent.index].worldMatrix * node.local.toMatrix();
-        } else {
-            node.worldMatrix = node.local.toMatrix();
-        }
-        node.dirty = false;
-    }
-
-    // Recurse to children
-    for (auto& child : node.children) {
-        if (isValid(child)) {
-            updateWorldMatrixRecursive(child.index);
-        }
-    }
+TransformHandle TransformHierarchy::handleAt(uint32_t index) const {
+    TransformHandle h;
+    h.index = index;
+    h.generation = nodes_[index].generation;
+    return h;
 }
 
 uint32_t TransformHierarchy::allocateNode() {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FlatHierarchy.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -91,8 +92,9 @@ struct Transform {
  * Key features:
  * - Handles instead of raw pointers (safe, no dangling references)
  * - Cached world matrices (updated lazily or in batch)
- * - Dirty propagation to children
- * - O(1) parent lookup, O(children) for child iteration
+ * - Topology kept in a FlatHierarchy: subtrees are contiguous and parents come
+ *   before children, so the batch update is a linear pass over dirty slots
+ * - Dirty marking covers the whole subtree in one contiguous fill
  *
  * Usage:
  *   TransformHierarchy hierarchy;
@@ -102,6 +104,10 @@ struct Transform {
  *   hierarchy.setLocal(child, Transform(glm::vec3(1, 0, 0)));
  *   hierarchy.updateWorldMatrices();  // Batch update all dirty matrices
  *   glm::mat4 worldMat = hierarchy.getWorldMatrix(child);
+ *
+ * Large hierarchies can split the batch update across workers:
+ *   for (auto range : hierarchy.partitionWorldUpdate(threadCount))
+ *       group.submit([&, range] { hierarchy.updateWorldMatrices(range); });
  */
 class TransformHierarchy {
 public:
@@ -139,18 +145,24 @@ public:
     // Batch update all dirty world matrices (call once per frame for efficiency)
     void updateWorldMatrices();
 
+    // Independent slices of the batch update (whole root subtrees). Each range
+    // may be passed to updateWorldMatrices(range) on its own worker thread, as
+    // long as the hierarchy isn't modified until all of them finish.
+    std::vector<FlatHierarchy::Range> partitionWorldUpdate(size_t maxRanges) const;
+    void updateWorldMatrices(FlatHierarchy::Range range);
+
     // ========================================================================
     // Hierarchy management
     // ========================================================================
 
-    // Set parent (null to make root)
+    // Set parent (null to make root). Ignored if newParent is inside handle's subtree.
     void setParent(TransformHandle handle, TransformHandle newParent);
 
     // Get parent handle (null if root)
     TransformHandle getParent(TransformHandle handle) const;
 
-    // Get children
-    const std::vector<TransformHandle>& getChildren(TransformHandle handle) const;
+    // Get children (walks the node's contiguous subtree)
+    std::vector<TransformHandle> getChildren(TransformHandle handle) const;
 
     // Get name
     const std::string& getName(TransformHandle handle) const;
@@ -172,18 +184,12 @@ public:
 private:
     struct Node {
         Transform local;
-        glm::mat4 worldMatrix{1.0f};
         std::string name;
-        TransformHandle parent;
-        std::vector<TransformHandle> children;
         uint32_t generation = 0;
-        bool dirty = true;
         bool active = false;
     };
 
-    void propagateDirty(uint32_t index);
-    void updateSingleNode(uint32_t index);  // On-demand: walks up only
-    void updateWorldMatrixRecursive(uint32_t index);  // Batch: walks down from roots
+    TransformHandle handleAt(uint32_t index) const;
     uint32_t allocateNode();
 
     std::vector<Node> nodes_;
@@ -191,6 +197,6 @@ private:
     std::vector<TransformHandle> roots_;
     size_t count_ = 0;
 
-    // Empty children vector for invalid handles
-    static const std::vector<TransformHandle> emptyChildren_;
+    // Parent links, traversal order, world matrices and dirty bits, keyed by node index
+    FlatHierarchy flat_;
 };
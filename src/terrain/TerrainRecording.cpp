@@ -53,6 +53,18 @@ void TerrainSystem::updateUniforms(uint32_t frameIndex, const glm::vec3& cameraP
     uniforms.lodFactor = 2.0f * log2(extent.height / (2.0f * tan(fov * 0.5f) * config.targetEdgePixels));
     uniforms.padding = config.flatnessScale;  // flatnessScale in shader
 
+    // Virtual texture prefetch predicts upcoming tiles from camera motion
+    if (virtualTexture) {
+        VirtualTexture::PrefetchCamera vtCamera;
+        vtCamera.position = cameraPos;
+        vtCamera.forward = -glm::vec3(view[0][2], view[1][2], view[2][2]);
+        vtCamera.fovY = std::abs(fov);  // proj[1][1] is negative with the Vulkan Y flip
+        vtCamera.aspect = std::abs(proj[1][1] / proj[0][0]);
+        vtCamera.viewportHeight = static_cast<float>(extent.height);
+        vtCamera.groundHeight = getHeightAt(cameraPos.x, cameraPos.z);
+        virtualTexture->setCamera(vtCamera);
+    }
+
     // Extract frustum planes
     extractFrustumPlanes(uniforms.viewProjMatrix, uniforms.frustumPlanes);
 
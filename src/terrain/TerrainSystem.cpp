@@ -124,6 +124,7 @@ bool TerrainSystem::initInternal(const InitInfo& info, const TerrainConfig& cfg)
         vtInfo.tilePath = config.virtualTextureTileDir;
         vtInfo.config = vtConfig;
         vtInfo.framesInFlight = framesInFlight;
+        vtInfo.useCompression = config.virtualTextureCompressed;
 
         if (!virtualTexture->init(vtInfo)) {
             SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to initialize virtual texture system");
@@ -131,6 +131,7 @@ struct TerrainConfig {
     // Virtual texture settings
     std::string virtualTextureTileDir;  // Directory containing VT tiles (empty = disabled)
     bool useVirtualTexture = false;     // Enable virtual texturing for terrain
+    bool virtualTextureCompressed = false;  // BC1 VT cache; PNG tiles are transcoded on load
 };
 
 class TerrainSystem : public ITerrainControl, public IRecordable, public IShadowCaster {
@@ -330,6 +331,9 @@ public:
     TerrainTileCache* getTileCache() { return tileCache.get(); }
     const TerrainTileCache* getTileCache() const { return tileCache.get(); }
 
+    // Virtual texture accessor for stats (returns nullptr if not enabled)
+    const VirtualTexture::VirtualTextureSystem* getVirtualTexture() const { return virtualTexture.get(); }
+
     // Tile cache GPU resource accessors (for grass/other systems)
     vk::ImageView getTileArrayView() const {
         return tileCache ? vk::ImageView(tileCache->getTileArrayView()) : vk::ImageView{};
@@ -4,6 +4,7 @@
 #include "core/vulkan/VmaBufferFactory.h"
 #include "core/vulkan/SamplerFactory.h"
 #include "core/ImageBuilder.h"
+#include "core/io/IOService.h"
 #include <SDL3/SDL.h>
 #include <vulkan/vulkan.hpp>
 #include <stb_image.h>
@@ -208,10 +209,20 @@ void TerrainTileCache::calculateTileWorldBounds(TileCoord coord, uint32_t lod, T
 bool TerrainTileCache::loadTileDataFromDisk(TileCoord coord, uint32_t lod, TerrainTile& tile) {
     std::string path = getTilePath(coord, lod);
 
+    // Callers block on this tile (physics, height queries), so it jumps the
+    // shared I/O queue ahead of streaming reads
+    IOResult file = IOService::instance().readFile(path, IOPriority::Critical);
+    if (!file.ok()) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TerrainTileCache: Failed to load tile: %s",
+                    path.c_str());
+        return false;
+    }
+
     int width, height, channels;
-    uint16_t* data = stbi_load_16(path.c_str(), &width, &height, &channels, 1);
+    uint16_t* data = stbi_load_16_from_memory(file.data.data(), static_cast<int>(file.data.size()),
+                                              &width, &height, &channels, 1);
     if (!data) {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TerrainTileCache: Failed to load tile: %s",
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TerrainTileCache: Failed to decode tile: %s",
                     path.c_str());
         return false;
     }
@@ -0,0 +1,320 @@
+#include "VirtualTextureArchive.h"
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace VirtualTexture {
+
+namespace {
+
+bool seekFile(std::FILE* file, uint64_t offset) {
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+// ============================================================================
+// VirtualTextureArchive
+// ============================================================================
+
+std::unique_ptr<VirtualTextureArchive> VirtualTextureArchive::open(const std::string& path) {
+    return open(path, Requirements{});
+}
+
+std::unique_ptr<VirtualTextureArchive> VirtualTextureArchive::open(const std::string& path,
+                                                                   const Requirements& requirements) {
+    auto archive = std::make_unique<VirtualTextureArchive>(ConstructToken{});
+    if (!archive->openInternal(path, requirements)) {
+        return nullptr;
+    }
+    return archive;
+}
+
+uint64_t VirtualTextureArchive::tileByteSize(TileFormat format, uint32_t width, uint32_t height) {
+    uint64_t blocks = uint64_t((width + 3) / 4) * ((height + 3) / 4);
+    switch (format) {
+        case TileFormat::RGBA8:
+            return uint64_t(width) * height * 4;
+        case TileFormat::BC1:
+        case TileFormat::BC1_SRGB:
+        case TileFormat::BC4:
+            return blocks * 8;
+        case TileFormat::BC5:
+        case TileFormat::BC7:
+        case TileFormat::BC7_SRGB:
+            return blocks * 16;
+    }
+    return 0;
+}
+
+VirtualTextureArchive::~VirtualTextureArchive() {
+#ifdef _WIN32
+    if (file_) std::fclose(file_);
+#else
+    if (fd_ >= 0) ::close(fd_);
+#endif
+}
+
+bool VirtualTextureArchive::openInternal(const std::string& path, const Requirements& requirements) {
+    path_ = path;
+
+#ifdef _WIN32
+    file_ = std::fopen(path.c_str(), "rb");
+    if (!file_) return false;
+#else
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) return false;
+#endif
+
+    if (!readFileSize() || !readAt(0, &header_, sizeof(header_)) ||
+        header_.magic != MAGIC || header_.version != VERSION) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VirtualTextureArchive: Invalid archive %s", path.c_str());
+        return false;
+    }
+
+    TileFormat format = getTileFormat();
+    tileBytes_ = header_.tileFormat <= static_cast<uint32_t>(TileFormat::BC7_SRGB)
+        ? tileByteSize(format, header_.tileWidth, header_.tileHeight) : 0;
+    if (tileBytes_ == 0 || header_.tileWidth > MAX_TILE_DIMENSION || header_.tileHeight > MAX_TILE_DIMENSION) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VirtualTextureArchive: Bad tile layout (format %u, %ux%u) in %s",
+                     header_.tileFormat, header_.tileWidth, header_.tileHeight, path.c_str());
+        return false;
+    }
+
+    bool formatAccepted = requirements.formats.empty() ||
+        std::find(requirements.formats.begin(), requirements.formats.end(), format) != requirements.formats.end();
+    if ((requirements.tileWidth != 0 && header_.tileWidth != requirements.tileWidth) ||
+        (requirements.tileHeight != 0 && header_.tileHeight != requirements.tileHeight) || !formatAccepted) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                     "VirtualTextureArchive: %s has %ux%u tiles of format %u, which the cache can't use",
+                     path.c_str(), header_.tileWidth, header_.tileHeight, header_.tileFormat);
+        return false;
+    }
+
+    // Both tables must lie inside the file before anything is sized from them
+    uint64_t mipTableEnd = sizeof(header_) + uint64_t(header_.mipCount) * sizeof(ArchiveMip);
+    uint64_t entryTableBytes = uint64_t(header_.entryCount) * sizeof(ArchiveEntry);
+    if (header_.mipCount > MAX_MIP_COUNT || mipTableEnd > fileSize_ ||
+        header_.entriesOffset > fileSize_ || entryTableBytes > fileSize_ - header_.entriesOffset) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VirtualTextureArchive: Truncated table in %s", path.c_str());
+        return false;
+    }
+
+    mips_.resize(header_.mipCount);
+    entries_.resize(header_.entryCount);
+    if (!readAt(sizeof(header_), mips_.data(), mips_.size() * sizeof(ArchiveMip)) ||
+        !readAt(header_.entriesOffset, entries_.data(), entries_.size() * sizeof(ArchiveEntry))) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VirtualTextureArchive: Truncated table in %s", path.c_str());
+        return false;
+    }
+
+    for (const auto& mip : mips_) {
+        if (static_cast<uint64_t>(mip.firstEntry) + uint64_t(mip.tilesPerAxis) * mip.tilesPerAxis > entries_.size()) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VirtualTextureArchive: Bad mip table in %s", path.c_str());
+            return false;
+        }
+    }
+
+    presentTiles_ = 0;
+    for (const auto& entry : entries_) {
+        if (entry.size > 0) presentTiles_++;
+    }
+
+    SDL_Log("VirtualTextureArchive: %s (%u mips, %u/%u tiles)",
+            path.c_str(), header_.mipCount, presentTiles_, header_.entryCount);
+    return true;
+}
+
+const ArchiveEntry* VirtualTextureArchive::findEntry(TileId id) const {
+    if (id.mipLevel >= mips_.size()) return nullptr;
+    const ArchiveMip& mip = mips_[id.mipLevel];
+    if (id.x >= mip.tilesPerAxis || id.y >= mip.tilesPerAxis) return nullptr;
+    const ArchiveEntry& entry = entries_[mip.firstEntry + uint32_t(id.y) * mip.tilesPerAxis + id.x];
+    return entry.size > 0 ? &entry : nullptr;
+}
+
+bool VirtualTextureArchive::hasTile(TileId id) const {
+    return findEntry(id) != nullptr;
+}
+
+bool VirtualTextureArchive::locateTile(TileId id, uint64_t& offset, uint32_t& size) const {
+    const ArchiveEntry* entry = findEntry(id);
+    if (!entry) return false;
+
+    if (entry->codec != static_cast<uint16_t>(ArchiveCodec::Raw)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VirtualTextureArchive: Unsupported codec %u for tile %u,%u mip %u",
+                     entry->codec, id.x, id.y, id.mipLevel);
+        return false;
+    }
+
+    if (entry->size != tileBytes_ || entry->offset > fileSize_ || entry->size > fileSize_ - entry->offset) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                     "VirtualTextureArchive: Corrupt entry for tile %u,%u mip %u (%u bytes at %llu, expected %llu)",
+                     id.x, id.y, id.mipLevel, entry->size, static_cast<unsigned long long>(entry->offset),
+                     static_cast<unsigned long long>(tileBytes_));
+        return false;
+    }
+
+    offset = entry->offset;
+    size = entry->size;
+    return true;
+}
+
+bool VirtualTextureArchive::readTile(TileId id, LoadedTile& outTile) const {
+    uint64_t offset = 0;
+    uint32_t size = 0;
+    if (!locateTile(id, offset, size)) return false;
+
+    outTile.pixels.resize(size);
+    if (!readAt(offset, outTile.pixels.data(), size)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VirtualTextureArchive: Read failed for tile %u,%u mip %u",
+                     id.x, id.y, id.mipLevel);
+        outTile.pixels.clear();
+        return false;
+    }
+
+    outTile.id = id;
+    outTile.width = header_.tileWidth;
+    outTile.height = header_.tileHeight;
+    outTile.format = getTileFormat();
+    return true;
+}
+
+bool VirtualTextureArchive::readFileSize() {
+#ifdef _WIN32
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    if (_fseeki64(file_, 0, SEEK_END) != 0) return false;
+    __int64 size = _ftelli64(file_);
+    if (size < 0) return false;
+    fileSize_ = static_cast<uint64_t>(size);
+#else
+    struct stat info {};
+    if (::fstat(fd_, &info) != 0) return false;
+    fileSize_ = static_cast<uint64_t>(info.st_size);
+#endif
+    return true;
+}
+
+bool VirtualTextureArchive::readAt(uint64_t offset, void* dst, size_t size) const {
+#ifdef _WIN32
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    return seekFile(file_, offset) && std::fread(dst, 1, size, file_) == size;
+#else
+    auto* out = static_cast<uint8_t*>(dst);
+    while (size > 0) {
+        ssize_t n = ::pread(fd_, out, size, static_cast<off_t>(offset));
+        if (n <= 0) return false;
+        out += n;
+        offset += static_cast<uint64_t>(n);
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+#endif
+}
+
+// ============================================================================
+// VirtualTextureArchiveWriter
+// ============================================================================
+
+VirtualTextureArchiveWriter::~VirtualTextureArchiveWriter() {
+    if (file_) {
+        std::fclose(file_);
+    }
+}
+
+bool VirtualTextureArchiveWriter::open(const std::string& path, TileFormat format,
+                                       uint32_t tileWidth, uint32_t tileHeight,
+                                       uint32_t tilesPerAxisAtMip0, uint32_t mipCount) {
+    path_ = path;
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VirtualTextureArchiveWriter: Failed to create %s", path.c_str());
+        return false;
+    }
+
+    mips_.clear();
+    uint32_t entryCount = 0;
+    for (uint32_t mip = 0; mip < mipCount; ++mip) {
+        uint32_t perAxis = std::max(1u, tilesPerAxisAtMip0 >> mip);
+        mips_.push_back({perAxis, entryCount});
+        entryCount += perAxis * perAxis;
+    }
+    entries_.assign(entryCount, ArchiveEntry{0, 0, static_cast<uint16_t>(ArchiveCodec::Raw), 0});
+
+    header_ = ArchiveHeader{};
+    header_.magic = VirtualTextureArchive::MAGIC;
+    header_.version = VirtualTextureArchive::VERSION;
+    header_.tileFormat = static_cast<uint32_t>(format);
+    header_.tileWidth = tileWidth;
+    header_.tileHeight = tileHeight;
+    header_.mipCount = mipCount;
+    header_.entryCount = entryCount;
+    header_.payloadAlignment = VirtualTextureArchive::PAYLOAD_ALIGNMENT;
+    header_.entriesOffset = sizeof(ArchiveHeader) + mips_.size() * sizeof(ArchiveMip);
+    header_.payloadOffset = alignUp(header_.entriesOffset + entries_.size() * sizeof(ArchiveEntry),
+                                    VirtualTextureArchive::PAYLOAD_ALIGNMENT);
+
+    nextOffset_ = header_.payloadOffset;
+    payloadBytes_ = 0;
+    return true;
+}
+
+bool VirtualTextureArchiveWriter::writeTile(TileId id, const void* data, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_ || id.mipLevel >= mips_.size() || size == 0 || size > UINT32_MAX) {
+        return false;
+    }
+    const ArchiveMip& mip = mips_[id.mipLevel];
+    if (id.x >= mip.tilesPerAxis || id.y >= mip.tilesPerAxis) {
+        return false;
+    }
+
+    ArchiveEntry& entry = entries_[mip.firstEntry + uint32_t(id.y) * mip.tilesPerAxis + id.x];
+    entry.offset = nextOffset_;
+    entry.size = static_cast<uint32_t>(size);
+    entry.codec = static_cast<uint16_t>(ArchiveCodec::Raw);
+
+    if (!seekFile(file_, entry.offset) || std::fwrite(data, 1, size, file_) != size) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VirtualTextureArchiveWriter: Write failed for %s", path_.c_str());
+        entry.size = 0;
+        return false;
+    }
+
+    nextOffset_ = alignUp(entry.offset + size, VirtualTextureArchive::PAYLOAD_ALIGNMENT);
+    payloadBytes_ += size;
+    return true;
+}
+
+bool VirtualTextureArchiveWriter::finish() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) return false;
+
+    bool ok = seekFile(file_, 0) &&
+              std::fwrite(&header_, sizeof(header_), 1, file_) == 1 &&
+              std::fwrite(mips_.data(), sizeof(ArchiveMip), mips_.size(), file_) == mips_.size() &&
+              seekFile(file_, header_.entriesOffset) &&
+              std::fwrite(entries_.data(), sizeof(ArchiveEntry), entries_.size(), file_) == entries_.size();
+
+    ok = (std::fclose(file_) == 0) && ok;
+    file_ = nullptr;
+
+    if (!ok) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VirtualTextureArchiveWriter: Failed to finish %s", path_.c_str());
+    }
+    return ok;
+}
+
+} // namespace VirtualTexture
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "VirtualTextureTypes.h"
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace VirtualTexture {
+
+// Packed tile archive (tiles.vtpack) written by tile_generator and read by
+// VirtualTextureTileLoader in place of one file per tile.
+//
+// File layout (little-endian):
+//   ArchiveHeader   (64 bytes)
+//   ArchiveMip      mipCount entries
+//   ArchiveEntry    one per tile, mip-major then row-major (entry index =
+//                   mip.firstEntry + y * mip.tilesPerAxis + x)
+//   Payloads        each starts on a PAYLOAD_ALIGNMENT boundary so reads map
+//                   cleanly onto pages / direct I/O blocks
+//
+// Payloads are the raw tile pixels in the archive's TileFormat (no DDS/PNG
+// container). Entries with size 0 are missing tiles.
+struct ArchiveHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t tileFormat;        // TileFormat
+    uint32_t tileWidth;
+    uint32_t tileHeight;
+    uint32_t mipCount;
+    uint32_t entryCount;
+    uint32_t payloadAlignment;
+    uint64_t entriesOffset;     // Byte offset of the ArchiveEntry table
+    uint64_t payloadOffset;     // Byte offset of the first payload
+    uint64_t reserved[2];
+};
+static_assert(sizeof(ArchiveHeader) == 64, "ArchiveHeader layout changed");
+
+struct ArchiveMip {
+    uint32_t tilesPerAxis;
+    uint32_t firstEntry;
+};
+static_assert(sizeof(ArchiveMip) == 8, "ArchiveMip layout changed");
+
+enum class ArchiveCodec : uint16_t {
+    Raw = 0,
+    LZ4 = 1,    // Reserved: per-tile LZ4 over BCn, not written yet
+};
+
+struct ArchiveEntry {
+    uint64_t offset;
+    uint32_t size;              // Stored bytes, 0 = tile not present
+    uint16_t codec;             // ArchiveCodec
+    uint16_t reserved;
+};
+static_assert(sizeof(ArchiveEntry) == 16, "ArchiveEntry layout changed");
+
+/**
+ * Read-only view of a tile archive.
+ *
+ * The header and entry table are read once on open; tiles are read with
+ * positional reads on a single file descriptor, so any number of loader
+ * threads can call readTile() concurrently without seeking or locking.
+ */
+class VirtualTextureArchive {
+public:
+    static constexpr uint32_t MAGIC = 0x4B505456;  // "VTPK"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t PAYLOAD_ALIGNMENT = 4096;
+    static constexpr const char* FILE_NAME = "tiles.vtpack";
+
+    // Passkey for controlled construction via make_unique
+    struct ConstructToken { explicit ConstructToken() = default; };
+    explicit VirtualTextureArchive(ConstructToken) {}
+
+    // Header sanity limits; anything larger is treated as corruption
+    static constexpr uint32_t MAX_TILE_DIMENSION = 4096;
+    static constexpr uint32_t MAX_MIP_COUNT = 32;
+
+    // Tile layout a consumer can upload. Zero sizes / no formats accept any.
+    struct Requirements {
+        uint32_t tileWidth = 0;
+        uint32_t tileHeight = 0;
+        std::vector<TileFormat> formats;
+    };
+
+    // Factory: returns nullptr if the file is missing, invalid or truncated
+    static std::unique_ptr<VirtualTextureArchive> open(const std::string& path);
+    // As above, and also nullptr if the tile layout doesn't meet requirements
+    static std::unique_ptr<VirtualTextureArchive> open(const std::string& path, const Requirements& requirements);
+
+    // Bytes of one raw tile, 0 for an unknown format
+    static uint64_t tileByteSize(TileFormat format, uint32_t width, uint32_t height);
+
+    ~VirtualTextureArchive();
+
+    VirtualTextureArchive(const VirtualTextureArchive&) = delete;
+    VirtualTextureArchive& operator=(const VirtualTextureArchive&) = delete;
+
+    // True if the archive has a payload for this tile
+    bool hasTile(TileId id) const;
+
+    // Read a tile's pixels. Returns false if absent, corrupt or on read error. Thread-safe.
+    bool readTile(TileId id, LoadedTile& outTile) const;
+
+    // Byte range of a tile's raw payload, for callers issuing their own
+    // reads (VirtualTextureTileLoader goes through IOService). Entries that
+    // aren't exactly one tile or run past the end of the file are rejected.
+    bool locateTile(TileId id, uint64_t& offset, uint32_t& size) const;
+
+    const std::string& getPath() const { return path_; }
+
+    TileFormat getTileFormat() const { return static_cast<TileFormat>(header_.tileFormat); }
+    uint32_t getTileWidth() const { return header_.tileWidth; }
+    uint32_t getTileHeight() const { return header_.tileHeight; }
+    uint32_t getMipCount() const { return header_.mipCount; }
+    uint32_t getEntryCount() const { return header_.entryCount; }
+    uint32_t getPresentTileCount() const { return presentTiles_; }
+
+private:
+    bool openInternal(const std::string& path, const Requirements& requirements);
+    bool readFileSize();
+    const ArchiveEntry* findEntry(TileId id) const;
+    bool readAt(uint64_t offset, void* dst, size_t size) const;
+
+    std::string path_;
+    ArchiveHeader header_{};
+    std::vector<ArchiveMip> mips_;
+    std::vector<ArchiveEntry> entries_;
+    uint32_t presentTiles_ = 0;
+    uint64_t fileSize_ = 0;
+    uint64_t tileBytes_ = 0;
+
+#ifdef _WIN32
+    std::FILE* file_ = nullptr;
+    mutable std::mutex fileMutex_;
+#else
+    int fd_ = -1;
+#endif
+};
+
+/**
+ * Writes a tile archive. writeTile() may be called from several generator
+ * threads; payload space is handed out in completion order and the entry
+ * table is written by finish().
+ */
+class VirtualTextureArchiveWriter {
+public:
+    VirtualTextureArchiveWriter() = default;
+    ~VirtualTextureArchiveWriter();
+
+    VirtualTextureArchiveWriter(const VirtualTextureArchiveWriter&) = delete;
+    VirtualTextureArchiveWriter& operator=(const VirtualTextureArchiveWriter&) = delete;
+
+    /**
+     * Create the archive file.
+     * @param tilesPerAxisAtMip0 Tiles per axis at mip 0; mip N has tilesPerAxis >> N
+     */
+    bool open(const std::string& path, TileFormat format, uint32_t tileWidth, uint32_t tileHeight,
+              uint32_t tilesPerAxisAtMip0, uint32_t mipCount);
+
+    // Store a tile's pixels (raw, in the archive's format). Thread-safe.
+    bool writeTile(TileId id, const void* data, size_t size);
+
+    // Write header and entry table and close the file
+    bool finish();
+
+    uint64_t getPayloadBytes() const { return payloadBytes_; }
+
+private:
+    std::string path_;
+    std::FILE* file_ = nullptr;
+    std::mutex mutex_;
+    ArchiveHeader header_{};
+    std::vector<ArchiveMip> mips_;
+    std::vector<ArchiveEntry> entries_;
+    uint64_t nextOffset_ = 0;
+    uint64_t payloadBytes_ = 0;
+};
+
+} // namespace VirtualTexture
@@ -0,0 +1,136 @@
+#include "VirtualTextureBC1Encoder.h"
+#include <algorithm>
+#include <cstring>
+
+namespace VirtualTexture {
+namespace BC1Encoder {
+
+namespace {
+
+inline uint16_t packRGB565(int r, int g, int b) {
+    return static_cast<uint16_t>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+// Expand 565 back to 8-bit so index selection sees the same colors the GPU decodes
+inline void expandRGB565(uint16_t c, int out[3]) {
+    int r = (c >> 11) & 0x1F;
+    int g = (c >> 5) & 0x3F;
+    int b = c & 0x1F;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+} // namespace
+
+void encodeBlock(const uint8_t* block, uint8_t* output) {
+    int minC[3] = {255, 255, 255};
+    int maxC[3] = {0, 0, 0};
+    int sum[3] = {0, 0, 0};
+
+    for (int i = 0; i < 16; ++i) {
+        const uint8_t* p = block + i * 4;
+        for (int c = 0; c < 3; ++c) {
+            minC[c] = std::min(minC[c], static_cast<int>(p[c]));
+            maxC[c] = std::max(maxC[c], static_cast<int>(p[c]));
+            sum[c] += p[c];
+        }
+    }
+
+    // Pick the bounding box diagonal that matches the block's dominant direction:
+    // flip channels that are anti-correlated with the widest channel
+    int axis = 0;
+    for (int c = 1; c < 3; ++c) {
+        if (maxC[c] - minC[c] > maxC[axis] - minC[axis]) axis = c;
+    }
+    int cov[3] = {0, 0, 0};
+    for (int i = 0; i < 16; ++i) {
+        const uint8_t* p = block + i * 4;
+        int da = p[axis] * 16 - sum[axis];
+        for (int c = 0; c < 3; ++c) {
+            cov[c] += da * (p[c] * 16 - sum[c]);
+        }
+    }
+
+    // Inset the box by 1/16 of its range to reduce error at the extremes
+    int hi[3], lo[3];
+    for (int c = 0; c < 3; ++c) {
+        int inset = (maxC[c] - minC[c]) >> 4;
+        hi[c] = maxC[c] - inset;
+        lo[c] = minC[c] + inset;
+        if (cov[c] < 0) std::swap(hi[c], lo[c]);
+    }
+
+    uint16_t c0 = packRGB565(hi[0], hi[1], hi[2]);
+    uint16_t c1 = packRGB565(lo[0], lo[1], lo[2]);
+
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        // Four-color mode requires c0 > c1
+        if (c0 < c1) std::swap(c0, c1);
+
+        int e0[3], e1[3];
+        expandRGB565(c0, e0);
+        expandRGB565(c1, e1);
+
+        int dir[3] = {e0[0] - e1[0], e0[1] - e1[1], e0[2] - e1[2]};
+        int lenSq = dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2];
+
+        // Projection onto the endpoint axis quantized to thirds:
+        // step 0 = c1 (index 1), 1 = 2/3 c1 (index 3), 2 = 2/3 c0 (index 2), 3 = c0 (index 0)
+        static constexpr uint32_t stepToIndex[4] = {1, 3, 2, 0};
+        for (int i = 0; i < 16; ++i) {
+            const uint8_t* p = block + i * 4;
+            int dot = (p[0] - e1[0]) * dir[0] + (p[1] - e1[1]) * dir[1] + (p[2] - e1[2]) * dir[2];
+            int step = (dot * 6 + lenSq) / (lenSq * 2);
+            step = std::clamp(step, 0, 3);
+            indices |= stepToIndex[step] << (i * 2);
+        }
+    }
+
+    output[0] = static_cast<uint8_t>(c0 & 0xFF);
+    output[1] = static_cast<uint8_t>(c0 >> 8);
+    output[2] = static_cast<uint8_t>(c1 & 0xFF);
+    output[3] = static_cast<uint8_t>(c1 >> 8);
+    output[4] = static_cast<uint8_t>(indices & 0xFF);
+    output[5] = static_cast<uint8_t>((indices >> 8) & 0xFF);
+    output[6] = static_cast<uint8_t>((indices >> 16) & 0xFF);
+    output[7] = static_cast<uint8_t>((indices >> 24) & 0xFF);
+}
+
+bool encode(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& output) {
+    if (!rgba || width == 0 || height == 0) {
+        return false;
+    }
+
+    uint32_t blocksX = (width + 3) / 4;
+    uint32_t blocksY = (height + 3) / 4;
+    output.resize(compressedSize(width, height));
+
+    uint8_t block[16 * 4];
+    uint8_t* dst = output.data();
+
+    for (uint32_t by = 0; by < blocksY; ++by) {
+        for (uint32_t bx = 0; bx < blocksX; ++bx) {
+            bool interior = (bx * 4 + 4 <= width) && (by * 4 + 4 <= height);
+            for (uint32_t y = 0; y < 4; ++y) {
+                uint32_t sy = std::min(by * 4 + y, height - 1);
+                if (interior) {
+                    std::memcpy(block + y * 16, rgba + (static_cast<size_t>(sy) * width + bx * 4) * 4, 16);
+                } else {
+                    for (uint32_t x = 0; x < 4; ++x) {
+                        uint32_t sx = std::min(bx * 4 + x, width - 1);
+                        std::memcpy(block + (y * 4 + x) * 4, rgba + (static_cast<size_t>(sy) * width + sx) * 4, 4);
+                    }
+                }
+            }
+            encodeBlock(block, dst);
+            dst += BLOCK_BYTES;
+        }
+    }
+
+    return true;
+}
+
+} // namespace BC1Encoder
+} // namespace VirtualTexture
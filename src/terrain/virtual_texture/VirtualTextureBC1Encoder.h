@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace VirtualTexture {
+
+/**
+ * Real-time BC1 encoder for virtual texture tiles.
+ *
+ * Used by VirtualTextureTileLoader worker threads to transcode RGBA8 tiles
+ * (PNG on disk) so they can be uploaded into a BC1 compressed cache.
+ * Quality is traded for speed: endpoints come from the inset RGB bounding
+ * box with a single diagonal-flip pass, and indices are chosen by projecting
+ * onto the endpoint axis (no per-texel palette search). Alpha is ignored.
+ */
+namespace BC1Encoder {
+
+constexpr uint32_t BLOCK_DIM = 4;
+constexpr uint32_t BLOCK_BYTES = 8;
+
+// Size in bytes of a BC1 image with the given dimensions (rounded up to whole blocks)
+inline size_t compressedSize(uint32_t width, uint32_t height) {
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * BLOCK_BYTES;
+}
+
+/**
+ * Encode one 4x4 block.
+ * @param block 16 RGBA8 texels, row-major
+ * @param output 8 bytes of BC1 data
+ */
+void encodeBlock(const uint8_t* block, uint8_t* output);
+
+/**
+ * Encode a full RGBA8 image. Edge blocks of non-multiple-of-4 images
+ * replicate the last row/column.
+ * @return false if the input is empty
+ */
+bool encode(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& output);
+
+} // namespace BC1Encoder
+
+} // namespace VirtualTexture
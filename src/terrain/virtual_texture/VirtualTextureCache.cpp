@@ -33,9 +33,6 @@ VirtualTextureCache::~VirtualTextureCache() {
     cacheSampler_.reset();
 
     cacheImage_.reset();
-
-    slots.clear();
-    tileToSlot.clear();
 }
 
 VirtualTextureCache::VirtualTextureCache(VirtualTextureCache&& other) noexcept
@@ -49,8 +46,7 @@ VirtualTextureCache::VirtualTextureCache(VirtualTextureCache&& other) noexcept
     , stagingBuffers_(std::move(other.stagingBuffers_))
     , stagingMapped_(std::move(other.stagingMapped_))
     , framesInFlight_(other.framesInFlight_)
-    , slots(std::move(other.slots))
-    , tileToSlot(std::move(other.tileToSlot))
+    , slotAllocator(std::move(other.slotAllocator))
 {
     other.device_ = VK_NULL_HANDLE;
     other.allocator_ = VK_NULL_HANDLE;
@@ -80,8 +76,7 @@ VirtualTextureCache& VirtualTextureCache::operator=(VirtualTextureCache&& other)
         stagingBuffers_ = std::move(other.stagingBuffers_);
         stagingMapped_ = std::move(other.stagingMapped_);
         framesInFlight_ = other.framesInFlight_;
-        slots = std::move(other.slots);
-        tileToSlot = std::move(other.tileToSlot);
+        slotAllocator = std::move(other.slotAllocator);
 
         other.device_ = VK_NULL_HANDLE;
         other.allocator_ = VK_NULL_HANDLE;
@@ -108,15 +103,11 @@ bool VirtualTextureCache::initInternal(const InitInfo& info) {
     VkCommandPool commandPool = info.commandPool;
     VkQueue queue = info.queue;
 
-    // Initialize slot array
+    // Initialize slot bookkeeping
     uint32_t totalSlots = config.getTotalCacheSlots();
-    slots.resize(totalSlots);
+    slotAllocator.reset(totalSlots);
 
     uint32_t slotsPerAxis = config.getCacheTilesPerAxis();
-    for (uint32_t i = 0; i < totalSlots; ++i) {
-        slots[i].occupied = false;
-        slots[i].lastUsedFrame = 0;
-    }
 
     // Create the cache texture
     if (!createCacheTexture(device, allocator, commandPool, queue)) {
@@ -238,85 +229,43 @@ bool VirtualTextureCache::createSampler(VkDevice device) {
     return true;
 }
 
-CacheSlot* VirtualTextureCache::allocateSlot(TileId id, uint32_t currentFrame) {
-    uint32_t packed = id.pack();
-
-    // Check if already in cache
-    auto it = tileToSlot.find(packed);
-    if (it != tileToSlot.end()) {
-        slots[it->second].lastUsedFrame = currentFrame;
-        return &slots[it->second];
-    }
-
-    // Find an empty slot first
-    for (size_t i = 0; i < slots.size(); ++i) {
-        if (!slots[i].occupied) {
-            slots[i].occupied = true;
-            slots[i].tileId = id;
-            slots[i].lastUsedFrame = currentFrame;
-            tileToSlot[packed] = i;
-            return &slots[i];
-        }
+CacheSlot* VirtualTextureCache::allocateSlot(TileId id, uint32_t currentFrame,
+                                             std::optional<TileId>* evictedTile) {
+    auto allocation = slotAllocator.allocate(id, currentFrame);
+    if (allocation.slotIndex == VirtualTextureSlotAllocator::INVALID_SLOT) {
+        return nullptr;
     }
 
-    // No empty slots, evict LRU
-    size_t lruIndex = findLRUSlot();
-    if (lruIndex < slots.size()) {
-        // Remove old mapping
-        uint32_t oldPacked = slots[lruIndex].tileId.pack();
-        tileToSlot.erase(oldPacked);
-
-        // Set new tile
-        slots[lruIndex].tileId = id;
-        slots[lruIndex].lastUsedFrame = currentFrame;
-        tileToSlot[packed] = lruIndex;
-        return &slots[lruIndex];
+    if (evictedTile) {
+        *evictedTile = allocation.evicted ? std::optional<TileId>(allocation.evictedTile) : std::nullopt;
     }
-
-    return nullptr;
+    return &slotAllocator.getSlot(allocation.slotIndex);
 }
 
-void VirtualTextureCache::markUsed(TileId id, uint32_t currentFrame) {
-    auto it = tileToSlot.find(id.pack());
-    if (it != tileToSlot.end()) {
-        slots[it->second].lastUsedFrame = currentFrame;
-    }
+bool VirtualTextureCache::markUsed(TileId id, uint32_t currentFrame) {
+    return slotAllocator.touch(id, currentFrame);
 }
 
 bool VirtualTextureCache::hasTile(TileId id) const {
-    return tileToSlot.find(id.pack()) != tileToSlot.end();
+    return slotAllocator.contains(id);
 }
 
 const CacheSlot* VirtualTextureCache::getSlot(TileId id) const {
-    auto it = tileToSlot.find(id.pack());
-    if (it != tileToSlot.end()) {
-        return &slots[it->second];
+    uint32_t index = slotAllocator.find(id);
+    if (index != VirtualTextureSlotAllocator::INVALID_SLOT) {
+        return &slotAllocator.getSlot(index);
     }
     return nullptr;
 }
 
-size_t VirtualTextureCache::findLRUSlot() const {
-    size_t lruIndex = 0;
-    uint32_t oldestFrame = UINT32_MAX;
-
-    for (size_t i = 0; i < slots.size(); ++i) {
-        if (slots[i].occupied && slots[i].lastUsedFrame < oldestFrame) {
-            oldestFrame = slots[i].lastUsedFrame;
-            lruIndex = i;
-        }
-    }
-
-    return lruIndex;
-}
-
-void VirtualTextureCache::recordTileUpload(TileId id, const void* pixelData,
+bool VirtualTextureCache::recordTileUpload(TileId id, const void* pixelData, size_t dataBytes,
                                             uint32_t width, uint32_t height,
                                             TileFormat format, VkCommandBuffer cmd, uint32_t frameIndex) {
     // Find the slot for this tile
-    auto it = tileToSlot.find(id.pack());
-    if (it == tileToSlot.end()) {
+    uint32_t slotIndex = slotAllocator.find(id);
+    if (slotIndex == VirtualTextureSlotAllocator::INVALID_SLOT) {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Cannot upload tile not in cache");
-        return;
+        return false;
     }
 
     // Check format compatibility
@@ -326,21 +275,20 @@ void VirtualTextureCache::recordTileUpload(TileId id, const void* pixelData,
             "Tile format mismatch: tile is %s, cache is %s",
             tileIsCompressed ? "compressed" : "RGBA8",
             useCompression_ ? "BC1" : "RGBA8");
-        return;
+        slotAllocator.release(id);
+        return false;
     }
 
-    // Select the staging buffer for this frame to avoid race conditions
-    uint32_t bufferIndex = frameIndex % framesInFlight_;
-    if (bufferIndex >= stagingBuffers_.size() || !stagingMapped_[bufferIndex]) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Invalid staging buffer index %u", bufferIndex);
-        return;
+    // The staging buffer and the slot hold one tile; anything larger, or
+    // shorter than its dimensions say, is a bad source tile
+    if (width > config.tileSizePixels || height > config.tileSizePixels) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+            "Tile %u,%u mip %u rejected: %ux%u, cache tiles are %u px",
+            id.x, id.y, id.mipLevel, width, height, config.tileSizePixels);
+        slotAllocator.release(id);
+        return false;
     }
 
-    size_t slotIndex = it->second;
-    uint32_t slotsPerAxis = config.getCacheTilesPerAxis();
-    uint32_t slotX = slotIndex % slotsPerAxis;
-    uint32_t slotY = slotIndex / slotsPerAxis;
-
     // Calculate data size based on format
     VkDeviceSize dataSize;
     if (useCompression_) {
@@ -353,6 +301,25 @@ void VirtualTextureCache::recordTileUpload(TileId id, const void* pixelData,
         dataSize = width * height * 4;
     }
 
+    if (dataBytes < dataSize) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+            "Tile %u,%u mip %u rejected: %zu bytes for a %ux%u tile",
+            id.x, id.y, id.mipLevel, dataBytes, width, height);
+        slotAllocator.release(id);
+        return false;
+    }
+
+    // Select the staging buffer for this frame to avoid race conditions
+    uint32_t bufferIndex = frameIndex % framesInFlight_;
+    if (bufferIndex >= stagingBuffers_.size() || !stagingMapped_[bufferIndex]) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Invalid staging buffer index %u", bufferIndex);
+        return false;
+    }
+
+    uint32_t slotsPerAxis = config.getCacheTilesPerAxis();
+    uint32_t slotX = slotIndex % slotsPerAxis;
+    uint32_t slotY = slotIndex / slotsPerAxis;
+
     // Copy to per-frame staging buffer
     std::memcpy(stagingMapped_[bufferIndex], pixelData, dataSize);
 
@@ -417,14 +384,7 @@ void VirtualTextureCache::recordTileUpload(TileId id, const void* pixelData,
                               vk::PipelineStageFlagBits::eFragmentShader,
                               {}, {}, {}, barrier);
     }
-}
-
-uint32_t VirtualTextureCache::getUsedSlotCount() const {
-    uint32_t count = 0;
-    for (const auto& slot : slots) {
-        if (slot.occupied) ++count;
-    }
-    return count;
+    return true;
 }
 
 } // namespace VirtualTexture
@@ -1,11 +1,11 @@
 #pragma once
 
 #include "VirtualTextureTypes.h"
+#include "VirtualTextureSlotAllocator.h"
 #include <vulkan/vulkan.h>
 #include <vulkan/vulkan_raii.hpp>
 #include <vk_mem_alloc.h>
 #include <vector>
-#include <unordered_map>
 #include <optional>
 #include <memory>
 #include "VmaBuffer.h"
@@ -18,7 +18,8 @@ namespace VirtualTexture {
  *
  * The cache can use either RGBA8 or BC1 compressed format.
  * BC1 uses 4x less GPU memory but requires all tiles to be BC1 compressed.
- * It uses LRU eviction when the cache is full.
+ * It uses LRU eviction when the cache is full (see VirtualTextureSlotAllocator);
+ * pinned tiles are never evicted.
  */
 class VirtualTextureCache {
 public:
@@ -49,15 +50,22 @@ public:
     VirtualTextureCache& operator=(const VirtualTextureCache&) = delete;
 
     // Allocate a slot for a new tile, evicting LRU if needed
-    // Returns the cache slot coordinates, or nullptr if allocation failed
-    CacheSlot* allocateSlot(TileId id, uint32_t currentFrame);
+    // Returns the cache slot coordinates, or nullptr if allocation failed.
+    // If a resident tile was evicted to make room, it is written to evictedTile
+    // so the caller can invalidate its page table entry.
+    CacheSlot* allocateSlot(TileId id, uint32_t currentFrame, std::optional<TileId>* evictedTile = nullptr);
 
     // Mark a tile as used this frame (for LRU tracking)
-    void markUsed(TileId id, uint32_t currentFrame);
+    // Returns false if the tile is not in the cache
+    bool markUsed(TileId id, uint32_t currentFrame);
 
     // Check if a tile is in the cache
     bool hasTile(TileId id) const;
 
+    // Pin a resident tile so it is never evicted (returns false if not resident)
+    bool pinTile(TileId id) { return slotAllocator.pin(id); }
+    bool unpinTile(TileId id) { return slotAllocator.unpin(id); }
+
     // Get the cache slot for a tile (nullptr if not in cache)
     const CacheSlot* getSlot(TileId id) const;
 
@@ -68,13 +76,16 @@ public:
      *
      * @param id Tile ID to upload
      * @param pixelData Pixel data to upload (RGBA8 or BC1 compressed)
+     * @param dataBytes Size of pixelData
      * @param width Tile width
      * @param height Tile height
      * @param format Tile format (RGBA8 or BC1)
      * @param cmd Command buffer to record into (must be in recording state)
      * @param frameIndex Current frame index for staging buffer selection
+     * @return false if the tile doesn't fit the cache (wrong format, size or
+     *         too little data); its slot is released
      */
-    void recordTileUpload(TileId id, const void* pixelData, uint32_t width, uint32_t height,
+    bool recordTileUpload(TileId id, const void* pixelData, size_t dataBytes, uint32_t width, uint32_t height,
                           TileFormat format, VkCommandBuffer cmd, uint32_t frameIndex);
 
     // Check if the cache is using compressed BC1 format
@@ -92,25 +103,28 @@ public:
     VkSampler getCacheSampler() const { return cacheSampler_ ? **cacheSampler_ : VK_NULL_HANDLE; }
 
     // Get the slot index for a tile (UINT32_MAX if not found)
-    uint32_t getTileSlotIndex(TileId id) const {
-        auto it = tileToSlot.find(id.pack());
-        if (it != tileToSlot.end()) {
-            return static_cast<uint32_t>(it->second);
-        }
-        return UINT32_MAX;
-    }
+    uint32_t getTileSlotIndex(TileId id) const { return slotAllocator.find(id); }
 
     // Get statistics
-    uint32_t getSlotCount() const { return static_cast<uint32_t>(slots.size()); }
-    uint32_t getUsedSlotCount() const;
+    uint32_t getSlotCount() const { return slotAllocator.getSlotCount(); }
+    uint32_t getUsedSlotCount() const { return slotAllocator.getUsedSlotCount(); }
+    uint32_t getPinnedSlotCount() const { return slotAllocator.getPinnedSlotCount(); }
+
+    // True if a tile can be added without evicting anything used at or after
+    // frame (a slot is free, or the LRU unpinned tile is older than that)
+    bool hasSlotUnusedSince(uint32_t frame) const {
+        if (slotAllocator.getUsedSlotCount() < slotAllocator.getSlotCount()) {
+            return true;
+        }
+        uint32_t lru = slotAllocator.getLRUSlot();
+        return lru != VirtualTextureSlotAllocator::INVALID_SLOT &&
+               slotAllocator.getSlot(lru).lastUsedFrame < frame;
+    }
 
 
 private:
     bool initInternal(const InitInfo& info);
 
-    // Find LRU slot for eviction
-    size_t findLRUSlot() const;
-
     // Create the cache texture
     bool createCacheTexture(VkDevice device, VmaAllocator allocator,
                             VkCommandPool commandPool, VkQueue queue);
@@ -135,9 +149,8 @@ private:
     std::vector<void*> stagingMapped_;
     uint32_t framesInFlight_ = 3;
 
-    // Cache slot management
-    std::vector<CacheSlot> slots;
-    std::unordered_map<uint32_t, size_t> tileToSlot;  // TileId::pack() -> slot index
+    // Cache slot management (tile -> slot map, LRU order, pinning)
+    VirtualTextureSlotAllocator slotAllocator;
 };
 
 } // namespace VirtualTexture
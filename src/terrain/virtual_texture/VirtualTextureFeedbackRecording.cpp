@@ -0,0 +1,124 @@
+#include "VirtualTextureFeedbackRecording.h"
+#include <SDL3/SDL_log.h>
+
+namespace VirtualTexture {
+
+bool FeedbackRecording::open(const std::string& path) {
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FeedbackRecording: Failed to open %s", path.c_str());
+        return false;
+    }
+    uint32_t header[2] = {MAGIC, VERSION};
+    file_.write(reinterpret_cast<const char*>(header), sizeof(header));
+    frameCount_ = 0;
+    return true;
+}
+
+void FeedbackRecording::appendFrame(const std::vector<TileId>& requested) {
+    if (!file_) return;
+
+    scratch_.clear();
+    scratch_.push_back(static_cast<uint32_t>(requested.size()));
+    for (const auto& id : requested) {
+        scratch_.push_back(id.pack());
+    }
+    file_.write(reinterpret_cast<const char*>(scratch_.data()),
+                static_cast<std::streamsize>(scratch_.size() * sizeof(uint32_t)));
+    frameCount_++;
+}
+
+void FeedbackRecording::close() {
+    if (file_.is_open()) {
+        file_.close();
+    }
+}
+
+bool FeedbackRecording::load(const std::string& path, std::vector<std::vector<uint32_t>>& outFrames) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FeedbackRecording: Failed to open %s", path.c_str());
+        return false;
+    }
+
+    uint32_t header[2] = {};
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!file || header[0] != MAGIC || header[1] != VERSION) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FeedbackRecording: Invalid recording %s", path.c_str());
+        return false;
+    }
+
+    outFrames.clear();
+    uint32_t count = 0;
+    while (file.read(reinterpret_cast<char*>(&count), sizeof(count))) {
+        std::vector<uint32_t> frame(count);
+        if (count > 0 && !file.read(reinterpret_cast<char*>(frame.data()),
+                                    static_cast<std::streamsize>(count * sizeof(uint32_t)))) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FeedbackRecording: Truncated frame in %s", path.c_str());
+            return false;
+        }
+        outFrames.push_back(std::move(frame));
+    }
+    return true;
+}
+
+bool CameraPathRecording::open(const std::string& path) {
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "CameraPathRecording: Failed to open %s", path.c_str());
+        return false;
+    }
+    uint32_t header[2] = {MAGIC, VERSION};
+    file_.write(reinterpret_cast<const char*>(header), sizeof(header));
+    frameCount_ = 0;
+    return true;
+}
+
+void CameraPathRecording::appendFrame(const PrefetchCamera& camera) {
+    if (!file_) return;
+
+    float record[11] = {
+        camera.position.x, camera.position.y, camera.position.z,
+        camera.forward.x, camera.forward.y, camera.forward.z,
+        camera.fovY, camera.aspect, camera.viewportHeight, camera.groundHeight, 0.0f
+    };
+    file_.write(reinterpret_cast<const char*>(record), sizeof(record));
+    frameCount_++;
+}
+
+void CameraPathRecording::close() {
+    if (file_.is_open()) {
+        file_.close();
+    }
+}
+
+bool CameraPathRecording::load(const std::string& path, std::vector<PrefetchCamera>& outFrames) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "CameraPathRecording: Failed to open %s", path.c_str());
+        return false;
+    }
+
+    uint32_t header[2] = {};
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!file || header[0] != MAGIC || header[1] != VERSION) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "CameraPathRecording: Invalid recording %s", path.c_str());
+        return false;
+    }
+
+    outFrames.clear();
+    float record[11] = {};
+    while (file.read(reinterpret_cast<char*>(record), sizeof(record))) {
+        PrefetchCamera camera;
+        camera.position = glm::vec3(record[0], record[1], record[2]);
+        camera.forward = glm::vec3(record[3], record[4], record[5]);
+        camera.fovY = record[6];
+        camera.aspect = record[7];
+        camera.viewportHeight = record[8];
+        camera.groundHeight = record[9];
+        outFrames.push_back(camera);
+    }
+    return true;
+}
+
+} // namespace VirtualTexture
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "VirtualTextureTypes.h"
+#include "VirtualTexturePrefetcher.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace VirtualTexture {
+
+/**
+ * Records the per-frame tile request lists produced by feedback readback so
+ * cache behaviour can be replayed offline (see tools/vt_cache_bench).
+ *
+ * File layout (.vtfb, little-endian):
+ *   uint32 magic, uint32 version
+ *   per frame: uint32 count, count * uint32 TileId::pack()
+ */
+class FeedbackRecording {
+public:
+    static constexpr uint32_t MAGIC = 0x42465456;  // "VTFB"
+    static constexpr uint32_t VERSION = 1;
+
+    bool open(const std::string& path);
+    bool isOpen() const { return file_.is_open(); }
+    void appendFrame(const std::vector<TileId>& requested);
+    void close();
+
+    uint32_t getFrameCount() const { return frameCount_; }
+
+    // Read a whole recording. Returns false (and logs) on I/O or format errors.
+    static bool load(const std::string& path, std::vector<std::vector<uint32_t>>& outFrames);
+
+private:
+    std::ofstream file_;
+    std::vector<uint32_t> scratch_;
+    uint32_t frameCount_ = 0;
+};
+
+/**
+ * Records one PrefetchCamera per frame alongside a feedback recording so
+ * prefetch prediction can be replayed headless.
+ *
+ * File layout (.vtcam, little-endian):
+ *   uint32 magic, uint32 version
+ *   per frame: 11 floats (position xyz, forward xyz, fovY, aspect,
+ *              viewportHeight, groundHeight, reserved)
+ */
+class CameraPathRecording {
+public:
+    static constexpr uint32_t MAGIC = 0x4D435456;  // "VTCM"
+    static constexpr uint32_t VERSION = 1;
+
+    bool open(const std::string& path);
+    bool isOpen() const { return file_.is_open(); }
+    void appendFrame(const PrefetchCamera& camera);
+    void close();
+
+    uint32_t getFrameCount() const { return frameCount_; }
+
+    static bool load(const std::string& path, std::vector<PrefetchCamera>& outFrames);
+
+private:
+    std::ofstream file_;
+    uint32_t frameCount_ = 0;
+};
+
+} // namespace VirtualTexture
@@ -0,0 +1,210 @@
+#include "VirtualTexturePrefetcher.h"
+#include <algorithm>
+#include <cmath>
+
+namespace VirtualTexture {
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+constexpr float MAX_PITCH = 1.55f;        // Just short of straight up/down
+constexpr float MOTION_SMOOTHING = 0.5f;  // Weight of the newest frame's motion
+
+float yawOf(const glm::vec3& forward) {
+    return std::atan2(forward.z, forward.x);
+}
+
+float pitchOf(const glm::vec3& forward) {
+    return std::asin(std::clamp(forward.y, -1.0f, 1.0f));
+}
+
+glm::vec3 forwardFrom(float yaw, float pitch) {
+    return glm::vec3(std::cos(pitch) * std::cos(yaw), std::sin(pitch), std::cos(pitch) * std::sin(yaw));
+}
+
+float wrapAngle(float angle) {
+    while (angle > PI) angle -= 2.0f * PI;
+    while (angle < -PI) angle += 2.0f * PI;
+    return angle;
+}
+
+} // namespace
+
+VirtualTexturePrefetcher::VirtualTexturePrefetcher(const VirtualTextureConfig& vtConfig, const Config& config)
+    : vtConfig_(vtConfig)
+    , config_(config)
+    , texelWorldSize_(config.worldSize / static_cast<float>(vtConfig.virtualSizePixels)) {
+}
+
+void VirtualTexturePrefetcher::reset() {
+    hasCamera_ = false;
+    velocity_ = glm::vec3(0.0f);
+    yawRate_ = 0.0f;
+    pitchRate_ = 0.0f;
+    lastFeedback_.clear();
+    candidates_.clear();
+    candidateSet_.clear();
+}
+
+void VirtualTexturePrefetcher::updateCamera(const PrefetchCamera& camera) {
+    if (hasCamera_) {
+        glm::vec3 delta = camera.position - current_.position;
+        float deltaYaw = wrapAngle(yawOf(camera.forward) - yawOf(current_.forward));
+        float deltaPitch = pitchOf(camera.forward) - pitchOf(current_.forward);
+
+        if (glm::length(delta) > config_.teleportDistance) {
+            // Cut or respawn: old motion says nothing about the next frames
+            velocity_ = glm::vec3(0.0f);
+            yawRate_ = 0.0f;
+            pitchRate_ = 0.0f;
+        } else {
+            velocity_ += (delta - velocity_) * MOTION_SMOOTHING;
+            yawRate_ += (deltaYaw - yawRate_) * MOTION_SMOOTHING;
+            pitchRate_ += (deltaPitch - pitchRate_) * MOTION_SMOOTHING;
+        }
+    }
+    current_ = camera;
+    hasCamera_ = true;
+}
+
+void VirtualTexturePrefetcher::addFeedback(const std::vector<TileId>& requested) {
+    lastFeedback_ = requested;
+}
+
+uint32_t VirtualTexturePrefetcher::getBudget(uint32_t demandQueued, uint32_t loaderBacklog) const {
+    if (demandQueued >= config_.demandQueueLimit || loaderBacklog >= config_.maxLoaderBacklog) {
+        return 0;
+    }
+    return std::min(config_.maxPrefetchPerFrame, config_.maxLoaderBacklog - loaderBacklog);
+}
+
+PrefetchCamera VirtualTexturePrefetcher::getPredictedCamera() const {
+    PrefetchCamera predicted = current_;
+    float lookahead = config_.lookaheadFrames;
+    predicted.position += velocity_ * lookahead;
+
+    float yaw = yawOf(current_.forward) + yawRate_ * lookahead;
+    float pitch = std::clamp(pitchOf(current_.forward) + pitchRate_ * lookahead, -MAX_PITCH, MAX_PITCH);
+    predicted.forward = forwardFrom(yaw, pitch);
+    return predicted;
+}
+
+uint32_t VirtualTexturePrefetcher::estimateMipLevel(float horizontalDistance, float heightAboveGround,
+                                                    float fovY, float viewportHeight) const {
+    float height = std::max(heightAboveGround, 1.0f);
+    float slantDistance = std::sqrt(horizontalDistance * horizontalDistance + height * height);
+
+    // World size of one pixel across the view, stretched along the view
+    // direction by 1/sin(grazing angle) - the larger of the two derivatives
+    float pixelAngle = 2.0f * std::tan(fovY * 0.5f) / viewportHeight;
+    float footprint = slantDistance * pixelAngle * (slantDistance / height);
+
+    float texels = std::max(footprint / texelWorldSize_, 1.0f);
+    // Shader rounds with uint(mipLevel + 0.5)
+    auto mip = static_cast<uint32_t>(std::log2(texels) + 0.5f);
+    return std::min(mip, vtConfig_.maxMipLevels - 1);
+}
+
+const std::vector<TileId>& VirtualTexturePrefetcher::predict() {
+    candidates_.clear();
+    candidateSet_.clear();
+    if (!hasCamera_) {
+        return candidates_;
+    }
+
+    // A still camera is fully described by its own feedback
+    glm::vec3 translation = velocity_ * config_.lookaheadFrames;
+    float rotation = (std::abs(yawRate_) + std::abs(pitchRate_)) * config_.lookaheadFrames;
+    if (glm::length(translation) < texelWorldSize_ * vtConfig_.tileSizePixels * 0.25f && rotation < 0.02f) {
+        return candidates_;
+    }
+
+    addShiftedFeedback(translation);
+    addFootprint(getPredictedCamera());
+    return candidates_;
+}
+
+bool VirtualTexturePrefetcher::addCandidate(TileId id) {
+    if (candidates_.size() >= config_.maxCandidates) {
+        return false;
+    }
+    if (candidateSet_.insert(id.pack()).second) {
+        candidates_.push_back(id);
+    }
+    return true;
+}
+
+bool VirtualTexturePrefetcher::addGroundPoint(float x, float z, uint32_t mipLevel) {
+    float u = x / config_.worldSize;
+    float v = z / config_.worldSize;
+    if (u < 0.0f || v < 0.0f || u >= 1.0f || v >= 1.0f) {
+        return true;
+    }
+    uint32_t tilesAtMip = std::max(1u, vtConfig_.getTilesAtMip(mipLevel));
+    TileId id(static_cast<uint16_t>(u * tilesAtMip), static_cast<uint16_t>(v * tilesAtMip),
+              static_cast<uint8_t>(mipLevel));
+    return addCandidate(id);
+}
+
+void VirtualTexturePrefetcher::addShiftedFeedback(const glm::vec3& translation) {
+    glm::vec2 shiftUV = glm::vec2(translation.x, translation.z) / config_.worldSize;
+
+    for (const TileId& id : lastFeedback_) {
+        int tilesAtMip = static_cast<int>(std::max(1u, vtConfig_.getTilesAtMip(id.mipLevel)));
+        int dx = static_cast<int>(std::lround(shiftUV.x * tilesAtMip));
+        int dy = static_cast<int>(std::lround(shiftUV.y * tilesAtMip));
+        if (dx == 0 && dy == 0) {
+            continue;
+        }
+        int x = id.x + dx;
+        int y = id.y + dy;
+        if (x < 0 || y < 0 || x >= tilesAtMip || y >= tilesAtMip) {
+            continue;
+        }
+        if (!addCandidate(TileId(static_cast<uint16_t>(x), static_cast<uint16_t>(y), id.mipLevel))) {
+            return;
+        }
+    }
+}
+
+void VirtualTexturePrefetcher::addFootprint(const PrefetchCamera& camera) {
+    const float height = std::max(camera.position.y - camera.groundHeight, 1.0f);
+    const float tanHalfY = std::tan(camera.fovY * 0.5f) * config_.fovMargin;
+    const float tanHalfX = std::tan(camera.fovY * 0.5f) * camera.aspect * config_.fovMargin;
+
+    glm::vec3 forward = glm::normalize(camera.forward);
+    glm::vec3 right = glm::cross(forward, glm::vec3(0.0f, 1.0f, 0.0f));
+    right = glm::length(right) > 1e-3f ? glm::normalize(right) : glm::vec3(1.0f, 0.0f, 0.0f);
+    glm::vec3 up = glm::cross(right, forward);
+
+    auto inFrustum = [&](float x, float z) {
+        glm::vec3 dir(x - camera.position.x, camera.groundHeight - camera.position.y, z - camera.position.z);
+        float depth = glm::dot(dir, forward);
+        if (depth <= 0.0f) return false;
+        return std::abs(glm::dot(dir, right)) <= tanHalfX * depth &&
+               std::abs(glm::dot(dir, up)) <= tanHalfY * depth;
+    };
+
+    // Rings outward from the camera; near rings first so the most visible
+    // tiles survive the candidate cap. Sample spacing is half a tile at the
+    // ring's mip so no tile is skipped.
+    float distance = 0.0f;
+    while (distance <= config_.maxDistance) {
+        uint32_t mip = estimateMipLevel(distance, height, camera.fovY, camera.viewportHeight);
+        float tileWorldSize = texelWorldSize_ * vtConfig_.tileSizePixels * static_cast<float>(1u << mip);
+        float spacing = std::max(tileWorldSize * 0.5f, 1.0f);
+
+        uint32_t samples = std::clamp(static_cast<uint32_t>(std::ceil(2.0f * PI * distance / spacing)), 8u, 4096u);
+        for (uint32_t i = 0; i < samples; ++i) {
+            float angle = 2.0f * PI * static_cast<float>(i) / static_cast<float>(samples);
+            float x = camera.position.x + std::cos(angle) * distance;
+            float z = camera.position.z + std::sin(angle) * distance;
+            if (inFrustum(x, z) && !addGroundPoint(x, z, mip)) {
+                return;
+            }
+        }
+        distance += spacing;
+    }
+}
+
+} // namespace VirtualTexture
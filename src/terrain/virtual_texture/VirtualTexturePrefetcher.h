@@ -0,0 +1,103 @@
+#pragma once
+
+#include "VirtualTextureTypes.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace VirtualTexture {
+
+// Camera state the prefetcher needs each frame (world space)
+struct PrefetchCamera {
+    glm::vec3 position{0.0f};
+    glm::vec3 forward{0.0f, 0.0f, -1.0f};   // Normalized view direction
+    float fovY = 1.0f;                      // Vertical field of view (radians)
+    float aspect = 16.0f / 9.0f;
+    float viewportHeight = 1080.0f;         // Pixels
+    float groundHeight = 0.0f;              // Terrain height below the camera
+};
+
+/**
+ * Predicts which virtual texture tiles the camera is about to need.
+ *
+ * Feedback only reports tiles after the GPU has sampled them, several frames
+ * after the camera moved. The prefetcher extrapolates camera position and
+ * yaw/pitch from recent frames, then produces candidate tiles from:
+ *
+ * 1. The previous frame's feedback shifted by the predicted translation
+ *    (keeps the mips the GPU actually chose, just moved ahead)
+ * 2. The predicted frustum's footprint on the ground plane, with mip levels
+ *    estimated the way vtCalculateMipLevel does (largest screen derivative,
+ *    which grows with distance and with grazing angle)
+ *
+ * Candidates are ordered most useful first. Filtering against resident or
+ * in-flight tiles and throttling are left to VirtualTextureSystem.
+ * CPU only, no Vulkan.
+ */
+class VirtualTexturePrefetcher {
+public:
+    struct Config {
+        float worldSize = 16384.0f;      // World XZ extent mapped onto the VT (VT_WORLD_SIZE in terrain.frag)
+        float lookaheadFrames = 6.0f;    // Feedback readback + load latency to cover
+        float fovMargin = 1.2f;          // Widen the predicted frustum
+        float maxDistance = 4000.0f;     // Footprint sampling range (metres)
+        float teleportDistance = 200.0f; // Per-frame jump that resets motion history
+        uint32_t maxCandidates = 256;
+
+        // Throttling: prefetch only fills loader capacity demand isn't using
+        uint32_t maxPrefetchPerFrame = 16;
+        uint32_t maxLoaderBacklog = 16;   // No prefetch while this many loads are queued
+        uint32_t demandQueueLimit = 32;   // No prefetch once demand queued this many this frame
+    };
+
+    explicit VirtualTexturePrefetcher(const VirtualTextureConfig& vtConfig, const Config& config);
+    explicit VirtualTexturePrefetcher(const VirtualTextureConfig& vtConfig)
+        : VirtualTexturePrefetcher(vtConfig, Config{}) {}
+
+    // Call once per frame with the current camera
+    void updateCamera(const PrefetchCamera& camera);
+
+    // Call once per frame with the tiles feedback requested
+    void addFeedback(const std::vector<TileId>& requested);
+
+    // Candidate tiles for the predicted camera, most useful first
+    const std::vector<TileId>& predict();
+
+    // Prefetch loads allowed this frame after demand queued demandQueued
+    // tiles, with loaderBacklog loads still waiting in the tile loader
+    uint32_t getBudget(uint32_t demandQueued, uint32_t loaderBacklog) const;
+
+    // Camera extrapolated lookaheadFrames ahead
+    PrefetchCamera getPredictedCamera() const;
+
+    // Mip level the shader would pick for a ground point at this horizontal
+    // distance from a camera at this height
+    uint32_t estimateMipLevel(float horizontalDistance, float heightAboveGround,
+                              float fovY, float viewportHeight) const;
+
+    void reset();
+    const Config& getConfig() const { return config_; }
+
+private:
+    bool addCandidate(TileId id);
+    bool addGroundPoint(float x, float z, uint32_t mipLevel);
+    void addShiftedFeedback(const glm::vec3& translation);
+    void addFootprint(const PrefetchCamera& camera);
+
+    VirtualTextureConfig vtConfig_;
+    Config config_;
+    float texelWorldSize_;
+
+    PrefetchCamera current_;
+    bool hasCamera_ = false;
+    glm::vec3 velocity_{0.0f};   // World units per frame (smoothed)
+    float yawRate_ = 0.0f;       // Radians per frame (smoothed)
+    float pitchRate_ = 0.0f;
+
+    std::vector<TileId> lastFeedback_;
+    std::vector<TileId> candidates_;
+    std::unordered_set<uint32_t> candidateSet_;
+};
+
+} // namespace VirtualTexture
@@ -0,0 +1,200 @@
+#include "VirtualTextureSlotAllocator.h"
+
+namespace VirtualTexture {
+
+VirtualTextureSlotAllocator::VirtualTextureSlotAllocator(uint32_t slotCount) {
+    reset(slotCount);
+}
+
+void VirtualTextureSlotAllocator::reset(uint32_t slotCount) {
+    slots_.assign(slotCount, CacheSlot{});
+    prev_.assign(slotCount, INVALID_SLOT);
+    next_.assign(slotCount, INVALID_SLOT);
+    lruHead_ = INVALID_SLOT;
+    lruTail_ = INVALID_SLOT;
+
+    freeSlots_.resize(slotCount);
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        freeSlots_[i] = slotCount - 1 - i;
+    }
+
+    uint32_t bits = 1;
+    while ((1u << bits) < slotCount * 2u) {
+        ++bits;
+    }
+    tableKeys_.assign(size_t(1) << bits, EMPTY_KEY);
+    tableSlots_.assign(size_t(1) << bits, INVALID_SLOT);
+    tableMask_ = (1u << bits) - 1;
+    tableShift_ = 32 - bits;
+
+    usedCount_ = 0;
+    pinnedCount_ = 0;
+}
+
+VirtualTextureSlotAllocator::Allocation VirtualTextureSlotAllocator::allocate(TileId id, uint32_t currentFrame) {
+    Allocation result;
+    uint32_t key = id.pack();
+
+    uint32_t existing = find(id);
+    if (existing != INVALID_SLOT) {
+        touch(id, currentFrame);
+        result.slotIndex = existing;
+        return result;
+    }
+
+    uint32_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        ++usedCount_;
+    } else {
+        slot = lruTail_;
+        if (slot == INVALID_SLOT) {
+            return result;  // Everything is pinned
+        }
+        result.evicted = true;
+        result.evictedTile = slots_[slot].tileId;
+        tableErase(result.evictedTile.pack());
+        unlink(slot);
+    }
+
+    CacheSlot& s = slots_[slot];
+    s.tileId = id;
+    s.lastUsedFrame = currentFrame;
+    s.occupied = true;
+    s.pinned = false;
+    tableInsert(key, slot);
+    linkFront(slot);
+
+    result.slotIndex = slot;
+    return result;
+}
+
+bool VirtualTextureSlotAllocator::touch(TileId id, uint32_t currentFrame) {
+    uint32_t slot = find(id);
+    if (slot == INVALID_SLOT) {
+        return false;
+    }
+    slots_[slot].lastUsedFrame = currentFrame;
+    if (!slots_[slot].pinned && lruHead_ != slot) {
+        unlink(slot);
+        linkFront(slot);
+    }
+    return true;
+}
+
+bool VirtualTextureSlotAllocator::release(TileId id) {
+    uint32_t slot = find(id);
+    if (slot == INVALID_SLOT) {
+        return false;
+    }
+    if (slots_[slot].pinned) {
+        --pinnedCount_;
+    } else {
+        unlink(slot);
+    }
+    tableErase(id.pack());
+    slots_[slot] = CacheSlot{};
+    --usedCount_;
+
+    // Keep the free stack ordered so the lowest free slot is reused first
+    auto it = freeSlots_.begin();
+    while (it != freeSlots_.end() && *it > slot) {
+        ++it;
+    }
+    freeSlots_.insert(it, slot);
+    return true;
+}
+
+bool VirtualTextureSlotAllocator::pin(TileId id) {
+    uint32_t slot = find(id);
+    if (slot == INVALID_SLOT) {
+        return false;
+    }
+    if (!slots_[slot].pinned) {
+        unlink(slot);
+        slots_[slot].pinned = true;
+        ++pinnedCount_;
+    }
+    return true;
+}
+
+bool VirtualTextureSlotAllocator::unpin(TileId id) {
+    uint32_t slot = find(id);
+    if (slot == INVALID_SLOT) {
+        return false;
+    }
+    if (slots_[slot].pinned) {
+        slots_[slot].pinned = false;
+        --pinnedCount_;
+        linkFront(slot);
+    }
+    return true;
+}
+
+uint32_t VirtualTextureSlotAllocator::find(TileId id) const {
+    uint32_t key = id.pack();
+    for (uint32_t i = tableIndex(key); tableKeys_[i] != EMPTY_KEY; i = (i + 1) & tableMask_) {
+        if (tableKeys_[i] == key) {
+            return tableSlots_[i];
+        }
+    }
+    return INVALID_SLOT;
+}
+
+void VirtualTextureSlotAllocator::linkFront(uint32_t slot) {
+    prev_[slot] = INVALID_SLOT;
+    next_[slot] = lruHead_;
+    if (lruHead_ != INVALID_SLOT) {
+        prev_[lruHead_] = slot;
+    } else {
+        lruTail_ = slot;
+    }
+    lruHead_ = slot;
+}
+
+void VirtualTextureSlotAllocator::unlink(uint32_t slot) {
+    uint32_t p = prev_[slot];
+    uint32_t n = next_[slot];
+    if (p != INVALID_SLOT) next_[p] = n; else lruHead_ = n;
+    if (n != INVALID_SLOT) prev_[n] = p; else lruTail_ = p;
+    prev_[slot] = INVALID_SLOT;
+    next_[slot] = INVALID_SLOT;
+}
+
+uint32_t VirtualTextureSlotAllocator::tableIndex(uint32_t key) const {
+    // Fibonacci hashing: neighbouring tiles differ only in low bits
+    return (key * 0x9E3779B1u) >> tableShift_;
+}
+
+void VirtualTextureSlotAllocator::tableInsert(uint32_t key, uint32_t slot) {
+    uint32_t i = tableIndex(key);
+    while (tableKeys_[i] != EMPTY_KEY) {
+        i = (i + 1) & tableMask_;
+    }
+    tableKeys_[i] = key;
+    tableSlots_[i] = slot;
+}
+
+void VirtualTextureSlotAllocator::tableErase(uint32_t key) {
+    uint32_t i = tableIndex(key);
+    while (tableKeys_[i] != key) {
+        if (tableKeys_[i] == EMPTY_KEY) return;
+        i = (i + 1) & tableMask_;
+    }
+
+    // Backward-shift deletion: pull later entries of the probe run into the
+    // hole if doing so doesn't move them before their home bucket
+    for (uint32_t j = (i + 1) & tableMask_; tableKeys_[j] != EMPTY_KEY; j = (j + 1) & tableMask_) {
+        uint32_t home = tableIndex(tableKeys_[j]);
+        if (((j - home) & tableMask_) >= ((j - i) & tableMask_)) {
+            tableKeys_[i] = tableKeys_[j];
+            tableSlots_[i] = tableSlots_[j];
+            i = j;
+        }
+    }
+    tableKeys_[i] = EMPTY_KEY;
+    tableSlots_[i] = INVALID_SLOT;
+}
+
+} // namespace VirtualTexture
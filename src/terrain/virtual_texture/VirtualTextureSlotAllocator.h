@@ -0,0 +1,100 @@
+#pragma once
+
+#include "VirtualTextureTypes.h"
+#include <cstdint>
+#include <vector>
+
+namespace VirtualTexture {
+
+/**
+ * CPU-side slot bookkeeping for the physical tile cache.
+ *
+ * Maps resident tiles to cache slots and picks eviction victims. Lookup,
+ * touch, allocate and pin are O(1):
+ * - Tile lookup uses a flat open-addressing table keyed on TileId::pack()
+ *   (linear probing, backward-shift deletion, no tombstones).
+ * - Eviction order is an intrusive doubly-linked LRU list threaded through
+ *   the slot indices. Touching a tile moves it to the front, the victim is
+ *   the back.
+ * - Pinned slots are unlinked from the LRU list and can never be evicted
+ *   (used for the coarsest mips, which are the fallback for every lookup).
+ *
+ * No Vulkan dependencies, so it can be tested and benchmarked standalone.
+ */
+class VirtualTextureSlotAllocator {
+public:
+    static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+    struct Allocation {
+        uint32_t slotIndex = INVALID_SLOT;  // INVALID_SLOT if every slot is pinned
+        bool evicted = false;               // True if a resident tile was evicted
+        TileId evictedTile;                 // Valid when evicted is true
+    };
+
+    explicit VirtualTextureSlotAllocator(uint32_t slotCount = 0);
+
+    // Drop all tiles and resize to slotCount slots
+    void reset(uint32_t slotCount);
+
+    /**
+     * Get a slot for a tile. Returns the existing slot if the tile is already
+     * resident, otherwise the lowest free slot, otherwise evicts the least
+     * recently used unpinned tile.
+     */
+    Allocation allocate(TileId id, uint32_t currentFrame);
+
+    // Mark a tile as used this frame. Returns false if the tile is not resident.
+    bool touch(TileId id, uint32_t currentFrame);
+
+    // Remove a tile and free its slot (pinned or not). Returns false if not resident.
+    bool release(TileId id);
+
+    // Pin/unpin a resident tile. Returns false if the tile is not resident.
+    bool pin(TileId id);
+    bool unpin(TileId id);
+
+    // Slot index for a tile, INVALID_SLOT if not resident
+    uint32_t find(TileId id) const;
+    bool contains(TileId id) const { return find(id) != INVALID_SLOT; }
+
+    const CacheSlot& getSlot(uint32_t index) const { return slots_[index]; }
+    CacheSlot& getSlot(uint32_t index) { return slots_[index]; }
+
+    // Least recently used unpinned slot (next eviction victim), INVALID_SLOT if none
+    uint32_t getLRUSlot() const { return lruTail_; }
+
+    uint32_t getSlotCount() const { return static_cast<uint32_t>(slots_.size()); }
+    uint32_t getUsedSlotCount() const { return usedCount_; }
+    uint32_t getPinnedSlotCount() const { return pinnedCount_; }
+
+private:
+    // Intrusive LRU list (head = most recent)
+    void linkFront(uint32_t slot);
+    void unlink(uint32_t slot);
+
+    // Flat tile -> slot table
+    uint32_t tableIndex(uint32_t key) const;
+    void tableInsert(uint32_t key, uint32_t slot);
+    void tableErase(uint32_t key);
+
+    std::vector<CacheSlot> slots_;
+    std::vector<uint32_t> prev_;
+    std::vector<uint32_t> next_;
+    uint32_t lruHead_ = INVALID_SLOT;
+    uint32_t lruTail_ = INVALID_SLOT;
+
+    // Free slots, lowest index on top
+    std::vector<uint32_t> freeSlots_;
+
+    // Open-addressing table, power-of-two capacity, at most 50% full
+    static constexpr uint32_t EMPTY_KEY = UINT32_MAX;  // pack() never sets the top 4 bits
+    std::vector<uint32_t> tableKeys_;
+    std::vector<uint32_t> tableSlots_;
+    uint32_t tableMask_ = 0;
+    uint32_t tableShift_ = 32;
+
+    uint32_t usedCount_ = 0;
+    uint32_t pinnedCount_ = 0;
+};
+
+} // namespace VirtualTexture
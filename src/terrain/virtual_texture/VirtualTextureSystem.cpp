@@ -2,6 +2,8 @@
 #include <vulkan/vulkan.hpp>
 #include <SDL3/SDL_log.h>
 #include <algorithm>
+#include <cstdlib>
+#include <optional>
 
 namespace VirtualTexture {
 
@@ -20,6 +22,7 @@ bool VirtualTextureSystem::init(const InitInfo& info) {
     SDL_Log("  Cache size: %u px", config.cacheSizePixels);
     SDL_Log("  Max mip levels: %u", config.maxMipLevels);
     SDL_Log("  Frames in flight: %u", framesInFlight_);
+    SDL_Log("  Cache format: %s", info.useCompression ? "BC1 (runtime transcode)" : "RGBA8");
 
     // Initialize cache with RAII wrapper
     VirtualTextureCache::InitInfo cacheInfo;
@@ -30,7 +33,7 @@ bool VirtualTextureSystem::init(const InitInfo& info) {
     cacheInfo.queue = info.queue;
     cacheInfo.config = config;
     cacheInfo.framesInFlight = framesInFlight_;
-    cacheInfo.useCompression = false;
+    cacheInfo.useCompression = info.useCompression;
 
     cache = VirtualTextureCache::create(cacheInfo);
     if (!cache) {
@@ -62,23 +65,63 @@ bool VirtualTextureSystem::init(const InitInfo& info) {
     }
 
     // Initialize tile loader
-    tileLoader = VirtualTextureTileLoader::create(info.tilePath, 2);
+    tileLoader = VirtualTextureTileLoader::create(info.tilePath, 2, info.useCompression, config.tileSizePixels);
     if (!tileLoader) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to initialize VT tile loader");
         return false;
     }
 
+    VirtualTexturePrefetcher::Config prefetchConfig;
+    prefetchConfig.worldSize = info.worldSize;
+    prefetchConfig.demandQueueLimit = MAX_REQUESTS_PER_FRAME / 2;
+    prefetcher = std::make_unique<VirtualTexturePrefetcher>(config, prefetchConfig);
+    prefetchEnabled = info.enablePrefetch;
+
+    if (const char* recordPath = std::getenv("VT_RECORD_FEEDBACK")) {
+        startFeedbackRecording(recordPath);
+    }
+
     SDL_Log("VirtualTextureSystem initialized successfully");
     return true;
 }
 
+bool VirtualTextureSystem::startFeedbackRecording(const std::string& path) {
+    if (!feedbackRecording.open(path)) {
+        return false;
+    }
+    SDL_Log("VT: Recording feedback to %s", path.c_str());
+    cameraRecording.open(path + ".vtcam");
+    return true;
+}
+
+void VirtualTextureSystem::stopFeedbackRecording() {
+    if (feedbackRecording.isOpen()) {
+        SDL_Log("VT: Recorded %u feedback frames", feedbackRecording.getFrameCount());
+        feedbackRecording.close();
+    }
+    cameraRecording.close();
+}
+
+void VirtualTextureSystem::setCamera(const PrefetchCamera& camera) {
+    if (prefetcher) {
+        prefetcher->updateCamera(camera);
+    }
+    if (cameraRecording.isOpen()) {
+        cameraRecording.appendFrame(camera);
+    }
+}
+
 void VirtualTextureSystem::destroy(VkDevice device, VmaAllocator allocator) {
+    stopFeedbackRecording();
+
     // RAII-managed subsystems are destroyed automatically via std::optional reset
     tileLoader.reset();
     feedback.reset();
     pageTable.reset();
     cache.reset();
+    prefetcher.reset();
     pendingTiles.clear();
+    prefetchedTiles.clear();
 }
 
 void VirtualTextureSystem::beginFrame(VkCommandBuffer cmd, uint32_t frameIndex) {
@@ -126,12 +169,18 @@ void VirtualTextureSystem::processFeedback(uint32_t frameIndex) {
 
     // Get deduplicated, sorted list of requested tiles
     std::vector<TileId> requested = feedback->getRequestedTiles();
+    if (feedbackRecording.isOpen()) {
+        feedbackRecording.appendFrame(requested);
+    }
+    totalDemandMisses += requested.size();
+    feedbackFramesProcessed++;
 
     if (requested.empty()) {
         // No requests - relax penalty if we have headroom
         if (currentPenalty > 0.0f && pendingTiles.empty()) {
             currentPenalty = std::max(0.0f, currentPenalty - PENALTY_RELAX_RATE);
         }
+        queuePrefetch(0);
         return;
     }
 
@@ -150,6 +199,20 @@ void VirtualTextureSystem::processFeedback(uint32_t frameIndex) {
         }
     }
 
+    // Feedback only reports tiles that aren't resident, and the shader then
+    // samples their nearest resident ancestor, so that ancestor was in use.
+    // Together with uploads stamping their slot, this is what keeps slot
+    // ages meaningful for the prefetch eviction guard in queuePrefetch().
+    for (const auto& id : requested) {
+        TileId ancestor = id;
+        while (ancestor.mipLevel + 1u < config.maxMipLevels) {
+            ancestor = TileId(ancestor.x >> 1, ancestor.y >> 1, static_cast<uint8_t>(ancestor.mipLevel + 1));
+            if (cache->markUsed(ancestor, currentFrame)) {
+                break;
+            }
+        }
+    }
+
     // Apply penalty scheme: increase penalty if we're over budget
     float projectedUsage = static_cast<float>(usedSlots + pendingCount + newRequestCount) /
                            static_cast<float>(totalCacheSlots);
@@ -193,14 +256,18 @@ void VirtualTextureSystem::processFeedback(uint32_t frameIndex) {
 
         uint32_t packed = adjustedId.pack();
 
-        // Skip if already in cache
-        if (cache->hasTile(adjustedId)) {
-            cache->markUsed(adjustedId, currentFrame);
+        // Skip if already in cache (refreshing its LRU position)
+        if (cache->markUsed(adjustedId, currentFrame)) {
             continue;
         }
 
-        // Skip if already pending
+        // Skip if already pending; a prefetch still waiting in the loader
+        // queue is moved up to demand priority
         if (pendingTiles.find(packed) != pendingTiles.end()) {
+            if (prefetchedTiles.erase(packed) > 0) {
+                tileLoader->promoteTile(adjustedId, static_cast<int>(adjustedId.mipLevel));
+                prefetchTilesPromoted++;
+            }
             continue;
         }
 
@@ -221,6 +288,48 @@ void VirtualTextureSystem::processFeedback(uint32_t frameIndex) {
         SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION,
                      "VT: Queued %u new tile requests (penalty: %.1f)", queued, currentPenalty);
     }
+
+    queuePrefetch(queued);
+}
+
+void VirtualTextureSystem::queuePrefetch(uint32_t demandQueued) {
+    if (!prefetcher) {
+        return;
+    }
+    prefetcher->addFeedback(feedback->getRequestedTiles());
+
+    // Prefetch never competes with demand: skip under cache pressure, when
+    // demand is already using the loader, or when a prefetched tile would
+    // evict something uploaded or sampled as a fallback in the last
+    // PREFETCH_MIN_EVICT_AGE frames
+    if (!prefetchEnabled || currentPenalty > 0.0f) {
+        return;
+    }
+    uint32_t budget = prefetcher->getBudget(demandQueued, tileLoader->getPendingCount());
+    if (budget == 0) {
+        return;
+    }
+
+    uint32_t queued = 0;
+    for (const TileId& id : prefetcher->predict()) {
+        if (queued >= budget) {
+            break;
+        }
+        uint32_t packed = id.pack();
+        if (cache->hasTile(id) || pendingTiles.find(packed) != pendingTiles.end()) {
+            continue;
+        }
+        uint32_t evictBefore = currentFrame > PREFETCH_MIN_EVICT_AGE ? currentFrame - PREFETCH_MIN_EVICT_AGE : 0;
+        if (!cache->hasSlotUnusedSince(evictBefore)) {
+            break;
+        }
+
+        tileLoader->queueTile(id, PREFETCH_PRIORITY + static_cast<int>(id.mipLevel));
+        pendingTiles.insert(packed);
+        prefetchedTiles.insert(packed);
+        queued++;
+    }
+    prefetchTilesQueued += queued;
 }
 
 void VirtualTextureSystem::recordPendingTileUploads(VkCommandBuffer cmd, uint32_t frameIndex) {
@@ -240,22 +349,38 @@ void VirtualTextureSystem::recordPendingTileUploads(VkCommandBuffer cmd, uint32_
         }
 
         // Allocate cache slot
-        CacheSlot* slot = cache->allocateSlot(tile.id, currentFrame);
+        std::optional<TileId> evicted;
+        CacheSlot* slot = cache->allocateSlot(tile.id, currentFrame, &evicted);
         if (!slot) {
             SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
                         "VT: Failed to allocate cache slot for tile");
             continue;
         }
 
+        // The evicted tile's page table entry would otherwise keep pointing
+        // at the slot we're about to overwrite
+        if (evicted) {
+            pageTable->clearEntry(*evicted);
+            prefetchedTiles.erase(evicted->pack());
+        }
+
+        if (tile.id.mipLevel + PINNED_MIP_LEVELS >= config.maxMipLevels) {
+            cache->pinTile(tile.id);
+        }
+
         // Record tile upload commands into the main command buffer
         // This uses per-frame staging buffers to avoid race conditions
-        cache->recordTileUpload(tile.id, tile.pixels.data(),
-                                   tile.width, tile.height,
-                                   tile.format, cmd, frameIndex);
+        uint32_t packed = tile.id.pack();
+        if (!cache->recordTileUpload(tile.id, tile.pixels.data(), tile.pixels.size(),
+                                     tile.width, tile.height,
+                                     tile.format, cmd, frameIndex)) {
+            // Rejected (slot already released): leave it unmapped
+            pendingTiles.erase(packed);
+            continue;
+        }
 
         // Update page table (CPU-side, will be uploaded via recordUpload)
         uint32_t slotsPerAxis = config.getCacheTilesPerAxis();
-        uint32_t packed = tile.id.pack();
         auto slotIt = cache->getTileSlotIndex(tile.id);
 
         if (slotIt != UINT32_MAX) {
@@ -5,6 +5,8 @@
 #include "VirtualTexturePageTable.h"
 #include "VirtualTextureFeedback.h"
 #include "VirtualTextureTileLoader.h"
+#include "VirtualTextureFeedbackRecording.h"
+#include "VirtualTexturePrefetcher.h"
 #include <vulkan/vulkan.h>
 #include <vulkan/vulkan_raii.hpp>
 #include <vk_mem_alloc.h>
@@ -25,12 +27,15 @@ namespace VirtualTexture {
  * 2. Tile Loading: Queues missing tiles for async loading
  * 3. Cache Management: Uploads loaded tiles and evicts old ones
  * 4. Page Table Update: Updates indirection textures when tiles change
+ * 5. Prefetch: Queues tiles the extrapolated camera is about to need, at
+ *    lower priority than feedback requests (see VirtualTexturePrefetcher)
  *
  * Usage:
  *   - Call beginFrame() at start of frame
  *   - Bind VT descriptors to terrain shader
  *   - Render terrain (shader writes to feedback buffer)
  *   - Call endFrame() after rendering
+ *   - Call setCamera() once per frame (enables prefetch)
  *   - Call update() to process feedback and load tiles
  */
 class VirtualTextureSystem {
@@ -51,6 +56,12 @@ public:
         std::string tilePath;
         VirtualTextureConfig config;
         uint32_t framesInFlight = 3;
+        // BC1 compressed cache. DDS tiles upload directly; RGBA8 (PNG) tiles
+        // are transcoded to BC1 on the loader worker threads.
+        bool useCompression = false;
+        // World XZ extent mapped onto the VT; must match VT_WORLD_SIZE in terrain.frag
+        float worldSize = 16384.0f;
+        bool enablePrefetch = true;
     };
 
     /**
@@ -95,6 +106,14 @@ public:
      */
     void update(VkCommandBuffer cmd, uint32_t frameIndex);
 
+    /**
+     * Camera for this frame, used to predict upcoming tile requests
+     */
+    void setCamera(const PrefetchCamera& camera);
+
+    void setPrefetchEnabled(bool enabled) { prefetchEnabled = enabled; }
+    bool isPrefetchEnabled() const { return prefetchEnabled; }
+
     /**
      * Get the physical cache texture for shader binding
      */
@@ -133,12 +152,26 @@ public:
      * Get statistics
      */
     uint32_t getCacheUsedSlots() const { return cache->getUsedSlotCount(); }
+    uint32_t getCacheSlotCount() const { return cache->getSlotCount(); }
     uint32_t getPendingTileCount() const { return tileLoader->getPendingCount(); }
     uint32_t getLoadedTileCount() const { return tileLoader->getLoadedCount(); }
     uint64_t getTotalBytesLoaded() const { return tileLoader->getTotalBytesLoaded(); }
+    uint64_t getTotalTilesTranscoded() const { return tileLoader->getTotalTilesTranscoded(); }
+    uint64_t getTotalBytesSavedByTranscode() const { return tileLoader->getTotalBytesSavedByTranscode(); }
+    double getAverageTranscodeMicros() const { return tileLoader->getAverageTranscodeMicros(); }
     float getCurrentPenalty() const { return currentPenalty; }
     uint32_t getTotalCacheSlots() const { return config.getTotalCacheSlots(); }
 
+    /**
+     * Prefetch statistics. Feedback only reports tiles that were missing when
+     * sampled, so feedback entries per frame is the demand-miss count.
+     */
+    double getAverageDemandMisses() const {
+        return feedbackFramesProcessed > 0 ? static_cast<double>(totalDemandMisses) / feedbackFramesProcessed : 0.0;
+    }
+    uint64_t getPrefetchTilesQueued() const { return prefetchTilesQueued; }
+    uint64_t getPrefetchTilesPromoted() const { return prefetchTilesPromoted; }
+
     /**
      * Force load a specific tile (for debugging/testing)
      */
@@ -149,6 +182,15 @@ public:
      */
     bool isTileResident(TileId id) const { return cache->hasTile(id); }
 
+    /**
+     * Record every frame's requested tile list to a .vtfb file for offline
+     * replay (tools/vt_cache_bench), and the camera path to <path>.vtcam.
+     * Also enabled at init by setting the VT_RECORD_FEEDBACK environment
+     * variable to an output path.
+     */
+    bool startFeedbackRecording(const std::string& path);
+    void stopFeedbackRecording();
+
 private:
     VirtualTextureConfig config;
 
@@ -161,6 +203,16 @@ private:
     uint32_t currentFrame = 0;
     uint32_t framesInFlight_ = 3;
     std::unordered_set<uint32_t> pendingTiles; // Tiles currently being loaded
+    FeedbackRecording feedbackRecording;
+    CameraPathRecording cameraRecording;
+
+    std::unique_ptr<VirtualTexturePrefetcher> prefetcher;
+    bool prefetchEnabled = true;
+    std::unordered_set<uint32_t> prefetchedTiles;  // Queued by prefetch, not yet requested by feedback
+    uint64_t totalDemandMisses = 0;
+    uint64_t feedbackFramesProcessed = 0;
+    uint64_t prefetchTilesQueued = 0;
+    uint64_t prefetchTilesPromoted = 0;
 
     // Over-budget penalty scheme (Ghost of Tsushima style)
     // When cache is under pressure, we increase the penalty to request coarser mips
@@ -173,8 +225,17 @@ private:
     static constexpr uint32_t MAX_UPLOADS_PER_FRAME = 16;
     // Maximum tile requests to queue per frame
     static constexpr uint32_t MAX_REQUESTS_PER_FRAME = 64;
+    // The coarsest mip levels are pinned in the cache once loaded: they are the
+    // fallback for every page table lookup and only cover a handful of tiles
+    static constexpr uint32_t PINNED_MIP_LEVELS = 2;
+    // Prefetch priority offset: always behind every demand request (priority = mip)
+    static constexpr int PREFETCH_PRIORITY = VirtualTextureTileLoader::SPECULATIVE_PRIORITY;
+    // Prefetched tiles may only evict tiles unused for this many frames
+    // (uploaded, or sampled as the fallback of a tile in feedback)
+    static constexpr uint32_t PREFETCH_MIN_EVICT_AGE = 60;
 
     void processFeedback(uint32_t readbackFrameIndex);
+    void queuePrefetch(uint32_t demandQueued);
     void recordPendingTileUploads(VkCommandBuffer cmd, uint32_t frameIndex);
 };
 
@@ -1,15 +1,29 @@
 #include "VirtualTextureTileLoader.h"
+#include "VirtualTextureBC1Encoder.h"
 #include "../core/DDSLoader.h"
+#include "core/io/IOService.h"
 #include <SDL3/SDL_log.h>
 #include <lodepng.h>
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
 
 namespace VirtualTexture {
 
-std::unique_ptr<VirtualTextureTileLoader> VirtualTextureTileLoader::create(const std::string& basePath, uint32_t workerCount) {
+namespace {
+
+constexpr const char* POOL_NAME = "VirtualTexture";
+
+IOPriority toIOPriority(int priority) {
+    return priority >= VirtualTextureTileLoader::SPECULATIVE_PRIORITY ? IOPriority::Low : IOPriority::High;
+}
+
+} // namespace
+
+std::unique_ptr<VirtualTextureTileLoader> VirtualTextureTileLoader::create(const std::string& basePath, uint32_t workerCount,
+                                                                    bool transcodeToBC1, uint32_t tileSizePixels) {
     auto loader = std::make_unique<VirtualTextureTileLoader>(ConstructToken{});
-    if (!loader->initInternal(basePath, workerCount)) {
+    if (!loader->initInternal(basePath, workerCount, transcodeToBC1, tileSizePixels)) {
         return nullptr;
     }
     return loader;
@@ -19,41 +33,50 @@ VirtualTextureTileLoader::~VirtualTextureTileLoader() {
     cleanup();
 }
 
-bool VirtualTextureTileLoader::initInternal(const std::string& path, uint32_t workerCount) {
+bool VirtualTextureTileLoader::initInternal(const std::string& path, uint32_t workerCount, bool transcode,
+                                            uint32_t tileSizePixels) {
     basePath = path;
-    running = true;
-
-    // Create worker threads
-    workers.reserve(workerCount);
-    for (uint32_t i = 0; i < workerCount; ++i) {
-        workers.emplace_back(&VirtualTextureTileLoader::workerLoop, this);
+    transcodeToBC1 = transcode;
+
+    // Prefer the packed archive when the tile generator wrote one
+    std::string archivePath = basePath + "/" + VirtualTextureArchive::FILE_NAME;
+    if (std::filesystem::exists(archivePath)) {
+        VirtualTextureArchive::Requirements requirements;
+        if (tileSizePixels != 0) {
+            // A BC1 cache takes BC1 tiles, or RGBA8 ones transcoded here
+            requirements.tileWidth = tileSizePixels;
+            requirements.tileHeight = tileSizePixels;
+            requirements.formats = {TileFormat::RGBA8};
+            if (transcodeToBC1) {
+                requirements.formats.push_back(TileFormat::BC1);
+                requirements.formats.push_back(TileFormat::BC1_SRGB);
+            }
+        }
+        archive = VirtualTextureArchive::open(archivePath, requirements);
+        // A regenerated archive must not be read through a stale descriptor
+        IOService::instance().invalidateFile(archivePath);
     }
 
-    SDL_Log("VirtualTextureTileLoader initialized: %u workers, path: %s",
-            workerCount, basePath.c_str());
+    running = true;
+    maxConcurrentLoads = workerCount;
+    pool = TaskScheduler::instance().registerPool(POOL_NAME, TaskScheduler::Priority::Normal,
+                                                  std::max(1u, workerCount));
+
+    SDL_Log("VirtualTextureTileLoader initialized: %u concurrent loads, path: %s%s%s",
+            workerCount, basePath.c_str(), archive ? " (packed archive)" : "",
+            transcodeToBC1 ? " (BC1 transcode)" : "");
     return true;
 }
 
 void VirtualTextureTileLoader::cleanup() {
+    // Queued tasks still run, but find nothing to load
     {
         std::lock_guard<std::mutex> lock(queueMutex);
         running = false;
-    }
-    queueCondition.notify_all();
-
-    for (auto& worker : workers) {
-        if (worker.joinable()) {
-            worker.join();
-        }
-    }
-    workers.clear();
-
-    // Clear remaining data
-    {
-        std::lock_guard<std::mutex> lock(queueMutex);
         while (!requestQueue.empty()) requestQueue.pop();
         queuedTiles.clear();
     }
+    loadTasks.wait();
 
     {
         std::lock_guard<std::mutex> lock(loadedMutex);
@@ -64,41 +87,82 @@ void VirtualTextureTileLoader::cleanup() {
 void VirtualTextureTileLoader::queueTile(TileId id, int priority) {
     uint32_t packed = id.pack();
 
-    std::lock_guard<std::mutex> lock(queueMutex);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
 
-    // Don't queue duplicates
-    if (queuedTiles.find(packed) != queuedTiles.end()) {
-        return;
-    }
+        // Don't queue duplicates
+        if (queuedTiles.find(packed) != queuedTiles.end()) {
+            return;
+        }
 
-    LoadRequest request;
-    request.id = id;
-    request.priority = priority;
+        LoadRequest request;
+        request.id = id;
+        request.priority = priority;
 
-    requestQueue.push(request);
-    queuedTiles.insert(packed);
+        requestQueue.push(request);
+        queuedTiles.emplace(packed, priority);
+    }
 
-    queueCondition.notify_one();
+    submitLoads(1);
 }
 
 void VirtualTextureTileLoader::queueTiles(const std::vector<TileId>& ids, int priority) {
-    std::lock_guard<std::mutex> lock(queueMutex);
+    uint32_t added = 0;
 
-    for (const auto& id : ids) {
-        uint32_t packed = id.pack();
-        if (queuedTiles.find(packed) != queuedTiles.end()) {
-            continue;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+
+        for (const auto& id : ids) {
+            uint32_t packed = id.pack();
+            if (queuedTiles.find(packed) != queuedTiles.end()) {
+                continue;
+            }
+
+            LoadRequest request;
+            request.id = id;
+            request.priority = priority;
+
+            requestQueue.push(request);
+            queuedTiles.emplace(packed, priority);
+            ++added;
         }
+    }
 
-        LoadRequest request;
-        request.id = id;
-        request.priority = priority;
+    submitLoads(added);
+}
 
-        requestQueue.push(request);
-        queuedTiles.insert(packed);
+bool VirtualTextureTileLoader::promoteTile(TileId id, int priority) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+
+    auto it = queuedTiles.find(id.pack());
+    if (it == queuedTiles.end()) {
+        return false;
+    }
+    if (priority < it->second) {
+        // The heap can't reorder in place: push a second request. Whichever
+        // pops first loads the tile, the other is skipped as no longer queued.
+        // No new task: the tile already has one.
+        it->second = priority;
+        requestQueue.push(LoadRequest{id, priority});
+    }
+    return true;
+}
+
+void VirtualTextureTileLoader::setMaxConcurrentLoads(uint32_t count) {
+    uint32_t previous = maxConcurrentLoads.exchange(count);
+    TaskScheduler::instance().registerPool(POOL_NAME, TaskScheduler::Priority::Normal, std::max(1u, count));
+    if (previous != 0 || count == 0) {
+        return;
     }
 
-    queueCondition.notify_all();
+    // Resuming: tasks submitted before the pause may already have returned
+    // empty-handed, so give every queued tile a task again
+    uint32_t queued;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queued = static_cast<uint32_t>(queuedTiles.size());
+    }
+    submitLoads(queued);
 }
 
 bool VirtualTextureTileLoader::isQueued(TileId id) const {
@@ -131,7 +195,7 @@ void VirtualTextureTileLoader::setLoadedCallback(TileLoadedCallback callback) {
 
 uint32_t VirtualTextureTileLoader::getPendingCount() const {
     std::lock_guard<std::mutex> lock(queueMutex);
-    return static_cast<uint32_t>(requestQueue.size());
+    return static_cast<uint32_t>(queuedTiles.size());
 }
 
 uint32_t VirtualTextureTileLoader::getLoadedCount() const {
@@ -139,64 +203,98 @@ uint32_t VirtualTextureTileLoader::getLoadedCount() const {
     return static_cast<uint32_t>(loadedTiles.size());
 }
 
-void VirtualTextureTileLoader::workerLoop() {
-    while (true) {
-        LoadRequest request;
+void VirtualTextureTileLoader::submitLoads(uint32_t count) {
+    if (maxConcurrentLoads == 0) {
+        return;
+    }
+    // Must not hold queueMutex: without a running scheduler the task runs here
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    for (uint32_t i = 0; i < count; ++i) {
+        scheduler.submit(pool, [this] { loadNextTile(); }, &loadTasks);
+    }
+}
 
-        {
-            std::unique_lock<std::mutex> lock(queueMutex);
+void VirtualTextureTileLoader::loadNextTile() {
+    LoadRequest request;
 
-            // Wait for work or shutdown
-            queueCondition.wait(lock, [this] {
-                return !running || !requestQueue.empty();
-            });
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
 
-            if (!running && requestQueue.empty()) {
+        // Every queued tile submitted a task, so there are at least as many
+        // tasks as live requests. Stale heap entries (cancelled or superseded
+        // by promoteTile) are skipped; a task that finds nothing returns.
+        while (true) {
+            if (!running || maxConcurrentLoads.load() == 0 || requestQueue.empty()) {
                 return;
             }
 
-            if (requestQueue.empty()) {
-                continue;
-            }
-
             request = requestQueue.top();
             requestQueue.pop();
 
-            // Check if this tile was cancelled
-            uint32_t packed = request.id.pack();
-            if (queuedTiles.find(packed) == queuedTiles.end()) {
-                continue; // Tile was cancelled, skip it
+            auto it = queuedTiles.find(request.id.pack());
+            if (it != queuedTiles.end() && it->second == request.priority) {
+                queuedTiles.erase(it);
+                break;
             }
-            queuedTiles.erase(packed);
         }
+    }
 
-        // Load the tile (outside of lock)
-        LoadedTile tile;
-        if (loadTileFromDisk(request.id, tile)) {
-            totalBytesLoaded += tile.pixels.size();
+    // Load the tile (outside of lock)
+    LoadedTile tile;
+    if (loadTileFromDisk(request.id, request.priority, tile)) {
+        if (transcodeToBC1 && tile.format == TileFormat::RGBA8) {
+            transcodeTile(tile);
+        }
+        totalBytesLoaded += tile.pixels.size();
 
-            // Add to loaded list
-            {
-                std::lock_guard<std::mutex> lock(loadedMutex);
-                loadedTiles.push_back(std::move(tile));
-            }
+        // Add to loaded list
+        {
+            std::lock_guard<std::mutex> lock(loadedMutex);
+            loadedTiles.push_back(std::move(tile));
+        }
 
-            // Invoke callback if set
-            if (loadedCallback) {
-                loadedCallback(tile);
-            }
+        // Invoke callback if set
+        if (loadedCallback) {
+            loadedCallback(tile);
         }
     }
 }
 
-bool VirtualTextureTileLoader::loadTileFromDisk(TileId id, LoadedTile& tile) {
+bool VirtualTextureTileLoader::loadTileFromDisk(TileId id, int priority, LoadedTile& tile) {
+    IOService& io = IOService::instance();
+    IOPriority ioPriority = toIOPriority(priority);
+
+    // Packed archive: one ranged read, no per-tile open/stat
+    uint64_t offset = 0;
+    uint32_t size = 0;
+    if (archive && archive->locateTile(id, offset, size)) {
+        IORequest request;
+        request.path = archive->getPath();
+        request.offset = offset;
+        request.size = size;
+        request.priority = ioPriority;
+        IOResult result = io.read(std::move(request)).get();
+        if (result.ok()) {
+            tile.id = id;
+            tile.width = archive->getTileWidth();
+            tile.height = archive->getTileHeight();
+            tile.format = archive->getTileFormat();
+            tile.pixels = std::move(result.data);
+            tilesFromArchive++;
+            return true;
+        }
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VirtualTextureTileLoader: Archive read failed for tile %u,%u mip %u",
+                     id.x, id.y, id.mipLevel);
+    }
+
     // Try loading DDS first (compressed format), then fall back to PNG
     std::string ddsPath = getTilePath(id, true);
     std::string pngPath = getTilePath(id, false);
 
     // Try DDS first
-    if (std::filesystem::exists(ddsPath)) {
-        DDSLoader::Image dds = DDSLoader::load(ddsPath);
+    IOResult ddsFile = io.readFile(ddsPath, ioPriority);
+    if (ddsFile.ok()) {
+        DDSLoader::Image dds = DDSLoader::loadFromMemory(ddsFile.data.data(), ddsFile.data.size());
         if (dds.isValid()) {
             tile.id = id;
             tile.width = dds.width;
@@ -228,22 +326,27 @@ bool VirtualTextureTileLoader::loadTileFromDisk(TileId id, LoadedTile& tile) {
                     break;
             }
 
+            tilesFromLooseFiles++;
             return true;
         }
     }
 
     // Try PNG
-    std::vector<unsigned char> png;
-    unsigned width, height;
-
-    unsigned error = lodepng::decode(png, width, height, pngPath);
-    if (error == 0) {
-        tile.id = id;
-        tile.width = width;
-        tile.height = height;
-        tile.pixels = std::move(png);
-        tile.format = TileFormat::RGBA8;
-        return true;
+    IOResult pngFile = io.readFile(pngPath, ioPriority);
+    if (pngFile.ok()) {
+        std::vector<unsigned char> png;
+        unsigned width, height;
+
+        unsigned error = lodepng::decode(png, width, height, pngFile.data);
+        if (error == 0) {
+            tile.id = id;
+            tile.width = width;
+            tile.height = height;
+            tile.pixels = std::move(png);
+            tile.format = TileFormat::RGBA8;
+            tilesFromLooseFiles++;
+            return true;
+        }
     }
 
     // Neither format found - use a fallback/placeholder
@@ -270,6 +373,25 @@ bool VirtualTextureTileLoader::loadTileFromDisk(TileId id, LoadedTile& tile) {
     return true;
 }
 
+void VirtualTextureTileLoader::transcodeTile(LoadedTile& tile) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<uint8_t> compressed;
+    if (!BC1Encoder::encode(tile.pixels.data(), tile.width, tile.height, compressed)) {
+        return;
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    totalTranscodeMicros += static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    totalTilesTranscoded++;
+    totalBytesSavedByTranscode += tile.pixels.size() - compressed.size();
+
+    // PNG tiles are authored in sRGB, matching the BC1 sRGB cache format
+    tile.pixels = std::move(compressed);
+    tile.format = TileFormat::BC1_SRGB;
+}
+
 std::string VirtualTextureTileLoader::getTilePath(TileId id, bool dds) const {
     // Format: basePath/mip{level}/tile_{x}_{y}.{dds|png}
     char path[512];
@@ -1,15 +1,15 @@
 #pragma once
 
 #include "VirtualTextureTypes.h"
+#include "VirtualTextureArchive.h"
+#include "core/threading/TaskScheduler.h"
 #include <string>
 #include <vector>
 #include <queue>
 #include <mutex>
-#include <condition_variable>
-#include <thread>
 #include <atomic>
 #include <functional>
-#include <unordered_set>
+#include <unordered_map>
 #include <memory>
 
 namespace VirtualTexture {
@@ -17,8 +17,20 @@ namespace VirtualTexture {
 /**
  * Async tile loader for virtual texture system.
  *
- * Manages a worker thread pool that loads tile images from disk.
+ * Loads tile images from disk on the shared TaskScheduler ("VirtualTexture"
+ * pool, capped at workerCount concurrent loads). Each queued tile submits
+ * one task, which takes the best request still queued when it runs, so
+ * priorities and cancellation apply up to the moment a load starts.
  * Tiles are queued for loading and callbacks are invoked when ready.
+ * File reads go through the shared IOService so tile streaming competes
+ * with terrain and asset loads by priority; the tasks here only decode
+ * and transcode.
+ *
+ * Without a running scheduler, queued tiles load synchronously.
+ *
+ * If basePath contains a packed archive (tiles.vtpack), tiles are ranged
+ * reads of it; tiles missing from the archive fall back to the loose
+ * mip{N}/tile_X_Y.{dds,png} files.
  */
 class VirtualTextureTileLoader {
 public:
@@ -28,11 +40,22 @@ public:
 
     using TileLoadedCallback = std::function<void(const LoadedTile&)>;
 
+    // Queue priorities at or above this are speculative (prefetch) and are
+    // read at IOPriority::Low
+    static constexpr int SPECULATIVE_PRIORITY = 1000;
+
     /**
      * Factory: Create and initialize VirtualTextureTileLoader.
      * Returns nullptr on failure.
+     * @param workerCount Concurrent loads allowed (0 = queue only, see setMaxConcurrentLoads)
+     * @param transcodeToBC1 Encode RGBA8 tiles (PNG) to BC1 on the loader tasks so
+     *                       mixed DDS/PNG tile sets can feed a BC1 compressed cache
+     * @param tileSizePixels Cache tile size; a packed archive with other tile
+     *                       dimensions or a format the cache can't take is
+     *                       ignored (0 = accept any archive)
      */
-    static std::unique_ptr<VirtualTextureTileLoader> create(const std::string& basePath, uint32_t workerCount = 2);
+    static std::unique_ptr<VirtualTextureTileLoader> create(const std::string& basePath, uint32_t workerCount = 2,
+                                                            bool transcodeToBC1 = false, uint32_t tileSizePixels = 0);
 
     ~VirtualTextureTileLoader();
 
@@ -54,6 +77,19 @@ public:
      */
     void queueTiles(const std::vector<TileId>& ids, int priority = 0);
 
+    /**
+     * Raise the priority of a tile that is still waiting in the queue.
+     * Returns false if the tile is not queued (never queued, loading or loaded).
+     */
+    bool promoteTile(TileId id, int priority);
+
+    /**
+     * Change how many tiles load at once. 0 pauses loading (tiles keep
+     * queueing); raising it from 0 starts loads for everything queued.
+     */
+    void setMaxConcurrentLoads(uint32_t count);
+    uint32_t getMaxConcurrentLoads() const { return maxConcurrentLoads.load(); }
+
     /**
      * Check if a tile is already queued or loading
      */
@@ -77,7 +113,7 @@ public:
 
     /**
      * Set callback for when tiles finish loading
-     * Callback is invoked from worker thread, use for signaling only
+     * Callback is invoked from a scheduler worker, use for signaling only
      */
     void setLoadedCallback(TileLoadedCallback callback);
 
@@ -88,9 +124,27 @@ public:
     uint32_t getLoadedCount() const;
     uint64_t getTotalBytesLoaded() const { return totalBytesLoaded.load(); }
 
+    /**
+     * Packed archive statistics
+     */
+    bool isUsingArchive() const { return archive != nullptr; }
+    uint64_t getTilesLoadedFromArchive() const { return tilesFromArchive.load(); }
+    uint64_t getTilesLoadedFromLooseFiles() const { return tilesFromLooseFiles.load(); }
+
+    /**
+     * Runtime BC1 transcoding statistics (only non-zero when transcodeToBC1 is enabled)
+     */
+    bool isTranscodingToBC1() const { return transcodeToBC1; }
+    uint64_t getTotalTilesTranscoded() const { return totalTilesTranscoded.load(); }
+    uint64_t getTotalTranscodeMicros() const { return totalTranscodeMicros.load(); }
+    uint64_t getTotalBytesSavedByTranscode() const { return totalBytesSavedByTranscode.load(); }
+    double getAverageTranscodeMicros() const {
+        uint64_t tiles = totalTilesTranscoded.load();
+        return tiles > 0 ? static_cast<double>(totalTranscodeMicros.load()) / static_cast<double>(tiles) : 0.0;
+    }
 
 private:
-    bool initInternal(const std::string& basePath, uint32_t workerCount);
+    bool initInternal(const std::string& basePath, uint32_t workerCount, bool transcodeToBC1, uint32_t tileSizePixels);
     void cleanup();
 
     struct LoadRequest {
@@ -104,14 +158,17 @@ private:
     };
 
     std::string basePath;
-    std::vector<std::thread> workers;
     std::atomic<bool> running{false};
 
+    // Scheduler pool and the load tasks submitted to it
+    TaskScheduler::PoolId pool = 0;
+    std::atomic<uint32_t> maxConcurrentLoads{0};
+    TaskGroup loadTasks;
+
     // Request queue
     mutable std::mutex queueMutex;
     std::priority_queue<LoadRequest> requestQueue;
-    std::unordered_set<uint32_t> queuedTiles; // For quick lookup
-    std::condition_variable queueCondition;
+    std::unordered_map<uint32_t, int> queuedTiles; // Packed TileId -> best queued priority
 
     // Loaded tiles ready for upload
     mutable std::mutex loadedMutex;
@@ -120,8 +177,19 @@ private:
     TileLoadedCallback loadedCallback;
     std::atomic<uint64_t> totalBytesLoaded{0};
 
-    void workerLoop();
-    bool loadTileFromDisk(TileId id, LoadedTile& tile);
+    std::unique_ptr<VirtualTextureArchive> archive;
+    std::atomic<uint64_t> tilesFromArchive{0};
+    std::atomic<uint64_t> tilesFromLooseFiles{0};
+
+    bool transcodeToBC1 = false;
+    std::atomic<uint64_t> totalTilesTranscoded{0};
+    std::atomic<uint64_t> totalTranscodeMicros{0};
+    std::atomic<uint64_t> totalBytesSavedByTranscode{0};
+
+    void submitLoads(uint32_t count);
+    void loadNextTile();
+    bool loadTileFromDisk(TileId id, int priority, LoadedTile& tile);
+    void transcodeTile(LoadedTile& tile);
     std::string getTilePath(TileId id, bool dds = false) const;
 };
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <vector>
 #include <glm/glm.hpp>
 
 namespace VirtualTexture {
@@ -90,6 +92,7 @@ struct CacheSlot {
     TileId tileId;
     uint32_t lastUsedFrame = 0;
     bool occupied = false;
+    bool pinned = false;    // Never evicted (coarse fallback mips)
 };
 
 // Feedback entry from GPU - requested tile with priority
@@ -19,12 +19,12 @@ ThreadedTreeGenerator::~ThreadedTreeGenerator() {
 }
 
 bool ThreadedTreeGenerator::init(uint32_t workerCount) {
-    jobQueue_ = Loading::LoadJobQueue::create(workerCount);
+    jobQueue_ = Loading::LoadJobQueue::create(workerCount, "TreeGeneration", TaskScheduler::Priority::Low);
     if (!jobQueue_) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "ThreadedTreeGenerator: Failed to create job queue");
         return false;
     }
-    SDL_Log("ThreadedTreeGenerator initialized with %u workers", workerCount);
+    SDL_Log("ThreadedTreeGenerator initialized (up to %u trees at once)", workerCount);
     return true;
 }
 
@@ -21,7 +21,8 @@
  * Thread safety:
  * - queueTree() can be called from any thread
  * - update() must be called from main thread (retrieves completed jobs)
- * - Tree mesh generation happens on worker threads (CPU only)
+ * - Tree mesh generation happens on scheduler workers (CPU only), in the
+ *   low-priority "TreeGeneration" pool so it yields to frame work
  */
 class ThreadedTreeGenerator {
 public:
@@ -68,7 +69,7 @@ public:
 
     /**
      * Factory: Create and initialize the threaded generator
-     * @param workerCount Number of worker threads (default: 4)
+     * @param workerCount Most trees generated at once (default: 4)
      */
     static std::unique_ptr<ThreadedTreeGenerator> create(uint32_t workerCount = 4);
 
@@ -3,6 +3,7 @@
 #include <vulkan/vulkan.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
+#include <chrono>
 #include <filesystem>
 #include <cstring>
 
@@ -222,11 +223,21 @@ bool TreeSystem::loadTextures(const InitInfo& info) {
     // Leaf type names (data-driven from JSON presets)
     std::vector<std::string> leafTypeNames = {"ash", "aspen", "pine", "oak"};
 
-    // Load all leaf textures with mipmaps for proper filtering at distance
+    // Load all leaf textures with mipmaps for proper filtering at distance.
+    // Decoding and mip generation for the whole set run in parallel.
+    std::vector<std::string> leafPaths;
     for (const auto& typeName : leafTypeNames) {
-        std::string path = texturePath + "leaves/" + typeName + "_color.png";
-        leafTextures_[typeName] = Texture::loadFromFileWithMipmaps(path, info.allocator, info.device,
-                                                                     info.commandPool, info.graphicsQueue, info.physicalDevice);
+        leafPaths.push_back(texturePath + "leaves/" + typeName + "_color.png");
+    }
+    auto leafStart = std::chrono::steady_clock::now();
+    auto loadedLeaves = Texture::loadBatchWithMipmaps(leafPaths, info.allocator, info.device,
+                                                      info.commandPool, info.graphicsQueue);
+    float leafMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - leafStart).count();
+    SDL_Log("TreeSystem: Loaded %zu leaf textures in %.1f ms", leafPaths.size(), leafMs);
+
+    for (size_t i = 0; i < leafTypeNames.size(); ++i) {
+        const auto& typeName = leafTypeNames[i];
+        leafTextures_[typeName] = std::move(loadedLeaves[i]);
         if (!leafTextures_[typeName]) {
             SDL_Log("TreeSystem: Using placeholder for %s leaf texture", typeName.c_str());
             leafTextures_[typeName] = Texture::createSolidColor(51, 102, 51, 200, info.allocator, info.device,
@@ -235,8 +246,6 @@ bool TreeSystem::loadTextures(const InitInfo& info) {
                 SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create leaf texture %s", typeName.c_str());
                 return false;
             }
-        } else {
-            SDL_Log("TreeSystem: Loaded leaf texture with mipmaps: %s", path.c_str());
         }
     }
 
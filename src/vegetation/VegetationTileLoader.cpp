@@ -0,0 +1,216 @@
+#include "VegetationTileLoader.h"
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+constexpr float TWO_PI = 6.28318530718f;
+
+uint16_t quantizeUnit16(float t) {
+    return static_cast<uint16_t>(std::lround(std::clamp(t, 0.0f, 1.0f) * 65535.0f));
+}
+
+template <typename T>
+void appendBytes(std::vector<uint8_t>& out, const T& value) {
+    const auto* p = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), p, p + sizeof(T));
+}
+
+void appendString(std::vector<uint8_t>& out, const std::string& s) {
+    size_t len = std::min<size_t>(s.size(), 255);
+    out.push_back(static_cast<uint8_t>(len));
+    out.insert(out.end(), s.begin(), s.begin() + len);
+}
+
+} // namespace
+
+VegetationTileInstance VegetationTileData::getInstance(size_t index) const {
+    VegetationPackedInstance packed;
+    std::memcpy(&packed, bytes.data() + instanceOffset + index * sizeof(VegetationPackedInstance), sizeof(packed));
+
+    glm::vec2 extent = worldMax - worldMin;
+    VegetationTileInstance inst;
+    inst.position = worldMin + glm::vec2(packed.x, packed.z) / 65535.0f * extent;
+    inst.rotation = static_cast<float>(packed.rotation) / 65536.0f * TWO_PI;
+    inst.scale = scaleMin + (scaleMax - scaleMin) * (static_cast<float>(packed.scale) / 255.0f);
+    inst.typeId = packed.typeId;
+    inst.seed = packed.seed;
+    return inst;
+}
+
+std::string VegetationTileLoader::getTilePath(const std::string& tilesDir, int32_t tileX, int32_t tileZ) {
+    return tilesDir + "/tile_" + std::to_string(tileX) + "_" + std::to_string(tileZ) + ".vegt";
+}
+
+std::vector<uint8_t> VegetationTileLoader::encode(int32_t tileX, int32_t tileZ,
+                                                  const glm::vec2& worldMin, const glm::vec2& worldMax,
+                                                  const std::vector<VegetationTileType>& types,
+                                                  const std::vector<VegetationTileInstance>& instances) {
+    if (types.size() > MAX_TYPES) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                     "VegetationTileLoader: Tile (%d, %d) has %zu types, at most %zu fit",
+                     tileX, tileZ, types.size(), MAX_TYPES);
+        return {};
+    }
+    for (const auto& inst : instances) {
+        if (inst.typeId >= types.size()) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                         "VegetationTileLoader: Tile (%d, %d) instance type %u is outside its %zu types",
+                         tileX, tileZ, static_cast<unsigned>(inst.typeId), types.size());
+            return {};
+        }
+    }
+
+    VegetationTileHeader header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.tileX = tileX;
+    header.tileZ = tileZ;
+    header.worldMin[0] = worldMin.x;
+    header.worldMin[1] = worldMin.y;
+    header.worldMax[0] = worldMax.x;
+    header.worldMax[1] = worldMax.y;
+    header.instanceCount = static_cast<uint32_t>(instances.size());
+    header.typeCount = static_cast<uint32_t>(types.size());
+
+    header.scaleMin = instances.empty() ? 1.0f : instances.front().scale;
+    header.scaleMax = header.scaleMin;
+    for (const auto& inst : instances) {
+        header.scaleMin = std::min(header.scaleMin, inst.scale);
+        header.scaleMax = std::max(header.scaleMax, inst.scale);
+    }
+
+    std::vector<uint8_t> typeTable;
+    for (const auto& type : types) {
+        appendString(typeTable, type.name);
+        appendString(typeTable, type.preset);
+    }
+    header.typeTableSize = static_cast<uint32_t>(typeTable.size());
+    header.instanceOffset = static_cast<uint32_t>((sizeof(header) + typeTable.size() + 3) & ~size_t(3));
+
+    std::vector<uint8_t> out;
+    out.reserve(header.instanceOffset + instances.size() * sizeof(VegetationPackedInstance));
+    appendBytes(out, header);
+    out.insert(out.end(), typeTable.begin(), typeTable.end());
+    out.resize(header.instanceOffset, 0);
+
+    glm::vec2 extent = worldMax - worldMin;
+    glm::vec2 invExtent(extent.x > 0.0f ? 1.0f / extent.x : 0.0f, extent.y > 0.0f ? 1.0f / extent.y : 0.0f);
+    float scaleRange = header.scaleMax - header.scaleMin;
+
+    for (const auto& inst : instances) {
+        glm::vec2 local = (inst.position - worldMin) * invExtent;
+        float angle = std::fmod(inst.rotation, TWO_PI);
+        if (angle < 0.0f) angle += TWO_PI;
+        float scaleT = scaleRange > 0.0f ? (inst.scale - header.scaleMin) / scaleRange : 0.0f;
+
+        VegetationPackedInstance packed{};
+        packed.x = quantizeUnit16(local.x);
+        packed.z = quantizeUnit16(local.y);
+        packed.rotation = static_cast<uint16_t>(static_cast<uint32_t>(std::lround(angle / TWO_PI * 65536.0f)) & 0xFFFF);
+        packed.scale = static_cast<uint8_t>(std::lround(std::clamp(scaleT, 0.0f, 1.0f) * 255.0f));
+        packed.typeId = inst.typeId;
+        packed.seed = inst.seed;
+        appendBytes(out, packed);
+    }
+
+    return out;
+}
+
+bool VegetationTileLoader::save(const std::string& path, int32_t tileX, int32_t tileZ,
+                                const glm::vec2& worldMin, const glm::vec2& worldMax,
+                                const std::vector<VegetationTileType>& types,
+                                const std::vector<VegetationTileInstance>& instances) {
+    std::vector<uint8_t> bytes = encode(tileX, tileZ, worldMin, worldMax, types, instances);
+    if (bytes.empty()) {
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VegetationTileLoader: Failed to write %s", path.c_str());
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+bool VegetationTileLoader::load(const std::string& path, VegetationTileData& outTile) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VegetationTileLoader: Failed to open %s", path.c_str());
+        return false;
+    }
+
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    std::vector<uint8_t> bytes(static_cast<size_t>(std::max<std::streamsize>(size, 0)));
+    if (!file.read(reinterpret_cast<char*>(bytes.data()), size)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VegetationTileLoader: Failed to read %s", path.c_str());
+        return false;
+    }
+
+    if (!parse(std::move(bytes), outTile)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "VegetationTileLoader: Invalid tile file %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool VegetationTileLoader::parse(std::vector<uint8_t> bytes, VegetationTileData& outTile) {
+    if (bytes.size() < sizeof(VegetationTileHeader)) return false;
+
+    VegetationTileHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != MAGIC || header.version != VERSION) return false;
+    if (header.typeCount > MAX_TYPES) return false;
+
+    size_t instanceBytes = static_cast<size_t>(header.instanceCount) * sizeof(VegetationPackedInstance);
+    if (header.instanceOffset < sizeof(header) + header.typeTableSize ||
+        header.instanceOffset > bytes.size() ||
+        bytes.size() - header.instanceOffset < instanceBytes) {
+        return false;
+    }
+
+    // Type table
+    std::vector<VegetationTileType> types;
+    types.reserve(header.typeCount);
+    size_t pos = sizeof(header);
+    size_t tableEnd = sizeof(header) + header.typeTableSize;
+    auto readString = [&](std::string& out) {
+        if (pos >= tableEnd) return false;
+        size_t len = bytes[pos++];
+        if (tableEnd - pos < len) return false;
+        out.assign(reinterpret_cast<const char*>(bytes.data() + pos), len);
+        pos += len;
+        return true;
+    };
+    for (uint32_t i = 0; i < header.typeCount; ++i) {
+        VegetationTileType type;
+        if (!readString(type.name) || !readString(type.preset)) return false;
+        types.push_back(std::move(type));
+    }
+
+    // getInstance() hands typeId to callers that index the type table
+    for (uint32_t i = 0; i < header.instanceCount; ++i) {
+        VegetationPackedInstance packed;
+        std::memcpy(&packed, bytes.data() + header.instanceOffset + i * sizeof(VegetationPackedInstance),
+                    sizeof(packed));
+        if (packed.typeId >= header.typeCount) return false;
+    }
+
+    outTile.tileX = header.tileX;
+    outTile.tileZ = header.tileZ;
+    outTile.worldMin = glm::vec2(header.worldMin[0], header.worldMin[1]);
+    outTile.worldMax = glm::vec2(header.worldMax[0], header.worldMax[1]);
+    outTile.scaleMin = header.scaleMin;
+    outTile.scaleMax = header.scaleMax;
+    outTile.types = std::move(types);
+    outTile.instanceOffset = header.instanceOffset;
+    outTile.instanceCount = header.instanceCount;
+    outTile.bytes = std::move(bytes);
+    return true;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+// Binary vegetation tile format (.vegt) written by tools/vegetation_generator
+// and read at runtime. Replaces the per-instance JSON tiles, which remain
+// available from the generator as a debug export.
+//
+// File layout (little-endian):
+//   Header            (56 bytes, see VegetationTileHeader)
+//   Type table        typeCount entries of: uint8 nameLen, name, uint8 presetLen, preset
+//   Padding           to a 4-byte boundary (instanceOffset)
+//   Instances         instanceCount * VegetationPackedInstance (12 bytes each)
+//
+// Instances are stored exactly as they should be uploaded, so the instance
+// block can be memory-mapped or copied straight into a GPU buffer and
+// unpacked in a shader (uvec3 per instance).
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct VegetationTileHeader {
+    uint32_t magic;
+    uint32_t version;
+    int32_t tileX;
+    int32_t tileZ;
+    float worldMin[2];          // Tile bounds (world XZ), the quantization range for positions
+    float worldMax[2];
+    float scaleMin;             // Quantization range for instance scale
+    float scaleMax;
+    uint32_t instanceCount;
+    uint32_t typeCount;
+    uint32_t typeTableSize;     // Bytes
+    uint32_t instanceOffset;    // Byte offset of the first instance
+};
+static_assert(sizeof(VegetationTileHeader) == 56, "VegetationTileHeader layout changed");
+
+struct VegetationPackedInstance {
+    uint16_t x;                 // Position within tile bounds, 0..65535
+    uint16_t z;
+    uint16_t rotation;          // Y rotation, [0, 2pi) in 65536 steps
+    uint8_t scale;              // lerp(scaleMin, scaleMax, scale / 255)
+    uint8_t typeId;             // Index into the tile's type table
+    uint32_t seed;              // Per-instance variation seed
+};
+static_assert(sizeof(VegetationPackedInstance) == 12, "VegetationPackedInstance layout changed");
+
+// Entry of a tile's type table, shared by all instances of that type
+struct VegetationTileType {
+    std::string name;           // e.g. "oak_large"
+    std::string preset;         // Tree preset name, empty for non-tree types
+};
+
+// Unpacked instance
+struct VegetationTileInstance {
+    glm::vec2 position;         // World XZ
+    float rotation;
+    float scale;
+    uint8_t typeId;
+    uint32_t seed;
+};
+
+// A loaded tile. Owns the file bytes; instances are decoded on demand.
+struct VegetationTileData {
+    int32_t tileX = 0;
+    int32_t tileZ = 0;
+    glm::vec2 worldMin{0.0f};
+    glm::vec2 worldMax{0.0f};
+    float scaleMin = 1.0f;
+    float scaleMax = 1.0f;
+    std::vector<VegetationTileType> types;
+
+    size_t getInstanceCount() const { return instanceCount; }
+
+    // Raw packed instances, ready for upload (getInstanceCount() * 12 bytes)
+    const uint8_t* getPackedInstances() const { return bytes.data() + instanceOffset; }
+    size_t getPackedInstanceBytes() const { return instanceCount * sizeof(VegetationPackedInstance); }
+
+    VegetationTileInstance getInstance(size_t index) const;
+
+private:
+    friend class VegetationTileLoader;
+    std::vector<uint8_t> bytes;
+    size_t instanceOffset = 0;
+    size_t instanceCount = 0;
+};
+
+class VegetationTileLoader {
+public:
+    static constexpr uint32_t MAGIC = 0x54474556;  // "VEGT"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t MAX_TYPES = 256;         // typeId is one byte
+
+    // Load a .vegt file. Returns false (and logs) on I/O or format errors.
+    static bool load(const std::string& path, VegetationTileData& outTile);
+
+    // Parse an in-memory .vegt file, taking ownership of the bytes. Tiles
+    // with an instance whose typeId is outside the type table are rejected.
+    static bool parse(std::vector<uint8_t> bytes, VegetationTileData& outTile);
+
+    /**
+     * Encode and write a tile.
+     * Instance positions are quantized to the tile bounds and scales to the
+     * tile's own min/max; typeId must index into `types`, which holds at
+     * most MAX_TYPES entries. Fails (and logs) otherwise.
+     */
+    static bool save(const std::string& path, int32_t tileX, int32_t tileZ,
+                     const glm::vec2& worldMin, const glm::vec2& worldMax,
+                     const std::vector<VegetationTileType>& types,
+                     const std::vector<VegetationTileInstance>& instances);
+
+    // Encode to memory (the bytes save() writes); empty if the types or
+    // type ids can't be encoded
+    static std::vector<uint8_t> encode(int32_t tileX, int32_t tileZ,
+                                       const glm::vec2& worldMin, const glm::vec2& worldMax,
+                                       const std::vector<VegetationTileType>& types,
+                                       const std::vector<VegetationTileInstance>& instances);
+
+    // Standard tile path within a tiles directory: <dir>/tile_<x>_<z>.vegt
+    static std::string getTilePath(const std::string& tilesDir, int32_t tileX, int32_t tileZ);
+};
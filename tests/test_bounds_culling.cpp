@@ -0,0 +1,197 @@
+#include <doctest/doctest.h>
+#include "ecs/BoundsCulling.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace ecs;
+
+namespace {
+
+// Axis-aligned box [-10, 10]^3 as six inward-facing normalized planes
+std::array<glm::vec4, 6> boxPlanes() {
+    return {glm::vec4(1, 0, 0, 10), glm::vec4(-1, 0, 0, 10),
+            glm::vec4(0, 1, 0, 10), glm::vec4(0, -1, 0, 10),
+            glm::vec4(0, 0, 1, 10), glm::vec4(0, 0, -1, 10)};
+}
+
+// Tilted planes so the |n| terms of the box test matter
+std::array<glm::vec4, 6> tiltedPlanes() {
+    auto planes = boxPlanes();
+    for (auto& plane : planes) {
+        glm::vec3 n = glm::normalize(glm::vec3(plane) + glm::vec3(0.3f, -0.2f, 0.1f));
+        plane = glm::vec4(n, plane.w);
+    }
+    return planes;
+}
+
+glm::mat4 makeWorld(std::mt19937& rng) {
+    std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.28f);
+
+    float a = angle(rng);
+    glm::mat4 m(1.0f);
+    // Rotation about Y, non-uniform scale, translation
+    m[0] = glm::vec4(std::cos(a), 0.0f, -std::sin(a), 0.0f) * scale(rng);
+    m[1] = glm::vec4(0.0f, 1.0f, 0.0f, 0.0f) * scale(rng);
+    m[2] = glm::vec4(std::sin(a), 0.0f, std::cos(a), 0.0f) * scale(rng);
+    m[3] = glm::vec4(position(rng), position(rng), position(rng), 1.0f);
+    return m;
+}
+
+// Reference: the per-entity tests updateVisibility used before the SoA cache.
+// Returns the smallest plane margin so callers can skip borderline cases.
+float sphereMargin(const std::array<glm::vec4, 6>& planes, const glm::mat4& world,
+                   const glm::vec3& center, float radius) {
+    glm::vec3 c = glm::vec3(world * glm::vec4(center, 1.0f));
+    float maxScale = std::max(glm::length(glm::vec3(world[0])),
+                              std::max(glm::length(glm::vec3(world[1])), glm::length(glm::vec3(world[2]))));
+    float margin = std::numeric_limits<float>::max();
+    for (const auto& plane : planes) {
+        margin = std::min(margin, glm::dot(glm::vec3(plane), c) + plane.w + radius * maxScale);
+    }
+    return margin;
+}
+
+float boxMargin(const std::array<glm::vec4, 6>& planes, const glm::mat4& world,
+                const glm::vec3& min, const glm::vec3& max) {
+    glm::vec3 worldMin(std::numeric_limits<float>::max());
+    glm::vec3 worldMax(std::numeric_limits<float>::lowest());
+    for (int corner = 0; corner < 8; ++corner) {
+        glm::vec3 local((corner & 1) ? max.x : min.x, (corner & 2) ? max.y : min.y, (corner & 4) ? max.z : min.z);
+        glm::vec3 w = glm::vec3(world * glm::vec4(local, 1.0f));
+        worldMin = glm::min(worldMin, w);
+        worldMax = glm::max(worldMax, w);
+    }
+    float margin = std::numeric_limits<float>::max();
+    for (const auto& plane : planes) {
+        glm::vec3 p = worldMin;
+        if (plane.x >= 0) p.x = worldMax.x;
+        if (plane.y >= 0) p.y = worldMax.y;
+        if (plane.z >= 0) p.z = worldMax.z;
+        margin = std::min(margin, glm::dot(glm::vec3(plane), p) + plane.w);
+    }
+    return margin;
+}
+
+bool bitSet(const std::vector<uint64_t>& bits, size_t i) {
+    return (bits[i / 64] >> (i % 64)) & 1u;
+}
+
+} // namespace
+
+TEST_CASE("BoundsCulling - matches per-entity sphere and box tests") {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> local(-2.0f, 2.0f);
+    std::uniform_real_distribution<float> size(0.1f, 3.0f);
+
+    // Not a multiple of 4 or 64, to cover the scalar tail
+    constexpr size_t COUNT = 1003;
+    CullBoundsSoA bounds;
+    bounds.resize(COUNT);
+    std::vector<float> margins[2];
+
+    const std::array<glm::vec4, 6> planeSets[2] = {boxPlanes(), tiltedPlanes()};
+    for (size_t i = 0; i < COUNT; ++i) {
+        glm::mat4 world = makeWorld(rng);
+        if (i % 2 == 0) {
+            glm::vec3 center(local(rng), local(rng), local(rng));
+            float radius = size(rng);
+            bounds.setSphere(i, world, center, radius);
+            for (int s = 0; s < 2; ++s) margins[s].push_back(sphereMargin(planeSets[s], world, center, radius));
+        } else {
+            glm::vec3 min(local(rng), local(rng), local(rng));
+            glm::vec3 max = min + glm::vec3(size(rng), size(rng), size(rng));
+            bounds.setBox(i, world, min, max);
+            for (int s = 0; s < 2; ++s) margins[s].push_back(boxMargin(planeSets[s], world, min, max));
+        }
+    }
+
+    for (int s = 0; s < 2; ++s) {
+        std::vector<uint64_t> bits(cullWordCount(COUNT), ~uint64_t(0));
+        cullBounds(planeSets[s], bounds, 0, COUNT, bits.data());
+
+        size_t visible = 0;
+        for (size_t i = 0; i < COUNT; ++i) {
+            if (std::abs(margins[s][i]) < 1e-3f) continue;  // Rounding may go either way
+            CHECK(bitSet(bits, i) == (margins[s][i] >= 0.0f));
+            visible += bitSet(bits, i) ? 1 : 0;
+        }
+        // The scene straddles the frustum, so both outcomes are exercised
+        CHECK(visible > COUNT / 10);
+        CHECK(visible < COUNT - COUNT / 10);
+
+        // Bits past the end of the last word are cleared
+        CHECK((bits.back() >> (COUNT % 64)) == 0);
+    }
+}
+
+TEST_CASE("BoundsCulling - disjoint 64-aligned ranges give the same bits") {
+    std::mt19937 rng(9);
+    constexpr size_t COUNT = 300;
+    CullBoundsSoA bounds;
+    bounds.resize(COUNT);
+    for (size_t i = 0; i < COUNT; ++i) {
+        bounds.setSphere(i, makeWorld(rng), glm::vec3(0.0f), 1.0f);
+    }
+
+    std::vector<uint64_t> whole(cullWordCount(COUNT));
+    cullBounds(boxPlanes(), bounds, 0, COUNT, whole.data());
+
+    std::vector<uint64_t> split(cullWordCount(COUNT));
+    cullBounds(boxPlanes(), bounds, 128, COUNT, split.data());
+    cullBounds(boxPlanes(), bounds, 0, 128, split.data());
+    CHECK(split == whole);
+}
+
+TEST_CASE("BoundsCulling - sphere radius follows the largest axis scale") {
+    CullBoundsSoA bounds;
+    bounds.resize(1);
+    glm::mat4 world(1.0f);
+    world[0] = world[0] * 3.0f;
+    world[1] = world[1] * 0.5f;
+    world[3] = glm::vec4(14.0f, 0.0f, 0.0f, 1.0f);
+
+    // Radius 1.5 scaled by 3 reaches x = 9.5 < 10: inside
+    bounds.setSphere(0, world, glm::vec3(0.0f), 1.5f);
+    CHECK(bounds.radius[0] == doctest::Approx(4.5f));
+    uint64_t bits = 0;
+    cullBounds(boxPlanes(), bounds, 0, 1, &bits);
+    CHECK(bits == 1);
+
+    // Moved further out: outside
+    world[3].x = 15.0f;
+    bounds.setSphere(0, world, glm::vec3(0.0f), 1.0f);
+    cullBounds(boxPlanes(), bounds, 0, 1, &bits);
+    CHECK(bits == 0);
+}
+
+TEST_CASE("BoundsCulling - list test keeps exactly the visible entries in order") {
+    std::mt19937 rng(13);
+    constexpr size_t COUNT = 203;
+    CullBoundsSoA bounds;
+    bounds.resize(COUNT);
+    for (size_t i = 0; i < COUNT; ++i) {
+        bounds.setBox(i, makeWorld(rng), glm::vec3(-1.0f), glm::vec3(1.0f));
+    }
+    std::vector<uint64_t> bits(cullWordCount(COUNT));
+    cullBounds(tiltedPlanes(), bounds, 0, COUNT, bits.data());
+
+    // Every other entry, back to front
+    std::vector<uint32_t> entries;
+    for (size_t i = COUNT; i-- > 0;) {
+        if (i % 2 == 0) entries.push_back(static_cast<uint32_t>(i));
+    }
+    std::vector<uint32_t> expected;
+    for (uint32_t entry : entries) {
+        if (bitSet(bits, entry)) expected.push_back(entry);
+    }
+
+    size_t kept = cullBoundsList(tiltedPlanes(), bounds, entries.data(), entries.size());
+    entries.resize(kept);
+    CHECK(entries == expected);
+    CHECK(!expected.empty());
+}
@@ -0,0 +1,200 @@
+// Tests for DerivedDataCache - on-disk cache of imported asset data
+
+#include <doctest/doctest.h>
+#include "core/asset/DerivedDataCache.h"
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class TempDir {
+public:
+    explicit TempDir(const std::string& name)
+        : path((fs::temp_directory_path() / ("derived_data_cache_test_" + name)).string()) {
+        std::error_code ec;
+        fs::remove_all(path, ec);
+    }
+    ~TempDir() {
+        std::error_code ec;
+        fs::remove_all(path, ec);
+    }
+
+    std::string path;
+};
+
+DerivedDataCache::Config cacheConfig(const std::string& directory) {
+    DerivedDataCache::Config config;
+    config.directory = directory;
+    return config;
+}
+
+std::vector<uint8_t> makeBlob(size_t size, uint8_t seed) {
+    std::vector<uint8_t> blob(size);
+    for (size_t i = 0; i < size; ++i) blob[i] = static_cast<uint8_t>(seed + i * 13);
+    return blob;
+}
+
+} // namespace
+
+TEST_SUITE("DerivedDataCache") {
+    TEST_CASE("keys depend on kind, contents and settings") {
+        const char data[] = "source bytes";
+        uint64_t base = DerivedDataKey("mesh-v1").bytes(data, sizeof(data)).get();
+
+        CHECK(DerivedDataKey("mesh-v1").bytes(data, sizeof(data)).get() == base);
+        CHECK(DerivedDataKey("mesh-v2").bytes(data, sizeof(data)).get() != base);
+        CHECK(DerivedDataKey("mesh-v1").bytes(data, sizeof(data) - 1).get() != base);
+        CHECK(DerivedDataKey("mesh-v1").bytes(data, sizeof(data)).value(0.5f).get() != base);
+
+        // Hashing a file matches hashing its bytes
+        TempDir dir("key");
+        fs::create_directories(dir.path);
+        std::string path = dir.path + "/source.bin";
+        auto contents = makeBlob(3 << 20, 1);
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(contents.data()),
+                                                    static_cast<std::streamsize>(contents.size()));
+        DerivedDataKey fromFile("mesh-v1");
+        fromFile.file(path);
+        REQUIRE(fromFile.isValid());
+        CHECK(fromFile.get() != base);
+
+        DerivedDataKey missing("mesh-v1");
+        missing.file(path + ".missing");
+        CHECK_FALSE(missing.isValid());
+    }
+
+    TEST_CASE("blobs round trip and reject truncation") {
+        BlobWriter writer;
+        writer.write(uint32_t{42});
+        writer.writeString("skeleton");
+        writer.writeVector(std::vector<float>{1.0f, 2.0f, 3.0f});
+        std::vector<uint8_t> blob = writer.data();
+
+        BlobReader reader(blob);
+        uint32_t number = 0;
+        std::string name;
+        std::vector<float> values;
+        CHECK(reader.read(number));
+        CHECK(reader.readString(name));
+        CHECK(reader.readVector(values));
+        CHECK(reader.atEnd());
+        CHECK(number == 42);
+        CHECK(name == "skeleton");
+        CHECK(values == (std::vector<float>{1.0f, 2.0f, 3.0f}));
+
+        BlobReader truncated(blob.data(), blob.size() - 1);
+        CHECK(truncated.read(number));
+        CHECK(truncated.readString(name));
+        CHECK_FALSE(truncated.readVector(values));
+        CHECK_FALSE(truncated.ok());
+    }
+
+    TEST_CASE("entries persist across instances and corrupt ones are dropped") {
+        TempDir dir("persist");
+        DerivedDataKey key("texture-v1");
+        key.value(7);
+        auto blob = makeBlob(1000, 3);
+
+        {
+            auto cache = DerivedDataCache::create(cacheConfig(dir.path));
+            REQUIRE(cache->isEnabled());
+            std::vector<uint8_t> out;
+            CHECK_FALSE(cache->load(key, out));
+            cache->store(key, blob);
+            REQUIRE(cache->load(key, out));
+            CHECK(out == blob);
+        }
+
+        auto reopened = DerivedDataCache::create(cacheConfig(dir.path));
+        CHECK(reopened->getStats().entries == 1);
+        std::vector<uint8_t> out;
+        REQUIRE(reopened->load(key, out));
+        CHECK(out == blob);
+
+        // Flip a payload byte on disk
+        for (const auto& item : fs::directory_iterator(dir.path)) {
+            if (item.path().extension() != ".ddc") continue;
+            std::fstream file(item.path(), std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(-1, std::ios::end);
+            file.put('\x5a');
+        }
+        CHECK_FALSE(reopened->load(key, out));
+        CHECK(reopened->getStats().corrupt == 1);
+        CHECK(reopened->getStats().entries == 0);
+
+        // A garbage payload size is rejected before anything is allocated
+        reopened->store(key, blob);
+        for (const auto& item : fs::directory_iterator(dir.path)) {
+            if (item.path().extension() != ".ddc") continue;
+            std::fstream file(item.path(), std::ios::in | std::ios::out | std::ios::binary);
+            const uint64_t hugeSize = ~0ull >> 1;
+            file.seekp(16);     // EntryHeader::payloadSize
+            file.write(reinterpret_cast<const char*>(&hugeSize), sizeof(hugeSize));
+        }
+        CHECK_FALSE(reopened->load(key, out));
+        CHECK(out.empty());
+        CHECK(reopened->getStats().corrupt == 2);
+
+        // So is a truncated entry
+        reopened->store(key, blob);
+        for (const auto& item : fs::directory_iterator(dir.path)) {
+            if (item.path().extension() != ".ddc") continue;
+            fs::resize_file(item.path(), fs::file_size(item.path()) - 100);
+        }
+        CHECK_FALSE(reopened->load(key, out));
+        CHECK(reopened->getStats().corrupt == 3);
+    }
+
+    TEST_CASE("rebuild clears entries and eviction keeps the budget") {
+        TempDir dir("evict");
+        {
+            auto cache = DerivedDataCache::create(cacheConfig(dir.path));
+            cache->store(DerivedDataKey("a"), makeBlob(100, 1));
+        }
+
+        DerivedDataCache::Config config = cacheConfig(dir.path);
+        config.rebuild = true;
+        config.maxBytes = 2500;
+        auto cache = DerivedDataCache::create(config);
+        CHECK(cache->getStats().entries == 0);
+
+        // Each entry is 1000 bytes plus its header, so only two fit
+        DerivedDataKey first("first"), second("second"), third("third");
+        cache->store(first, makeBlob(1000, 1));
+        cache->store(second, makeBlob(1000, 2));
+        std::vector<uint8_t> out;
+        REQUIRE(cache->load(first, out));      // first becomes most recently used
+        cache->store(third, makeBlob(1000, 3));
+
+        auto stats = cache->getStats();
+        CHECK(stats.entries == 2);
+        CHECK(stats.evicted == 1);
+        CHECK(stats.bytes <= 2500);
+        CHECK(cache->load(third, out));
+        CHECK_FALSE(cache->load(second, out));
+    }
+
+    TEST_CASE("disabled without a directory and timings carry over") {
+        auto disabled = DerivedDataCache::create(DerivedDataCache::Config{});
+        CHECK_FALSE(disabled->isEnabled());
+        disabled->store(DerivedDataKey("x"), makeBlob(10, 0));
+        std::vector<uint8_t> out;
+        CHECK_FALSE(disabled->load(DerivedDataKey("x"), out));
+
+        TempDir dir("timings");
+        {
+            auto cold = DerivedDataCache::create(cacheConfig(dir.path));
+            cold->recordLoad("Textures", false, 40.0f);
+            cold->recordLoad("Textures", false, 20.0f);
+            cold->logReport();
+        }
+        auto warm = DerivedDataCache::create(cacheConfig(dir.path));
+        warm->recordLoad("Textures", true, 2.0f);
+        auto stats = warm->getStats().categories.at("Textures");
+        CHECK(stats.hits == 1);
+        CHECK(stats.misses == 0);
+        CHECK(stats.previousColdAvgMs == doctest::Approx(30.0f));
+    }
+}
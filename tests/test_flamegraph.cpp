@@ -262,3 +262,40 @@ TEST_SUITE("FlamegraphHistory") {
         CHECK(history.latest() == nullptr);
     }
 }
+
+// ============================================================================
+// Folded stack export tests
+// ============================================================================
+
+TEST_SUITE("FoldedStacks") {
+    TEST_CASE("self time per stack in microseconds") {
+        FlamegraphBuilder builder;
+        builder.beginFrame();
+        builder.beginZone("Frame", 0.0f);
+        builder.beginZone("Shadow", 1.0f);
+        builder.endZone("Shadow", 3.0f);
+        builder.beginZone("a;b", 3.0f);
+        builder.endZone("a;b", 3.5f);
+        builder.endZone("Frame", 10.0f);
+        auto capture = builder.endFrame(10.0f, 1);
+
+        std::string folded = formatFoldedStacks(capture);
+        CHECK(folded == "Frame 7500\nFrame;Shadow 2000\nFrame;a:b 500\n");
+
+        std::string prefixed = formatFoldedStacks(capture, "Init");
+        CHECK(prefixed.rfind("Init;Frame 7500\n", 0) == 0);
+    }
+
+    TEST_CASE("zero self time is omitted") {
+        FlamegraphBuilder builder;
+        builder.beginFrame();
+        builder.beginZone("Parent", 0.0f);
+        builder.beginZone("Child", 0.0f);
+        builder.endZone("Child", 2.0f);
+        builder.endZone("Parent", 2.0f);
+        auto capture = builder.endFrame(2.0f, 0);
+
+        CHECK(formatFoldedStacks(capture) == "Parent;Child 2000\n");
+        CHECK(formatFoldedStacks(FlamegraphCapture{}).empty());
+    }
+}
@@ -0,0 +1,201 @@
+#include <doctest/doctest.h>
+#include "scene/FlatHierarchy.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace {
+
+glm::mat4 translation(float x, float y, float z) {
+    glm::mat4 m(1.0f);
+    m[3] = glm::vec4(x, y, z, 1.0f);
+    return m;
+}
+
+// Every node's parent precedes it and lies in the range that contains it
+void checkOrder(const FlatHierarchy& flat) {
+    for (uint32_t slot = 0; slot < flat.size(); ++slot) {
+        CHECK(flat.slotOf(flat.idAt(slot)) == slot);
+        uint32_t parent = flat.parentSlot(slot);
+        if (parent == FlatHierarchy::NONE) continue;
+        CHECK(parent < slot);
+        CHECK(slot + flat.subtreeSize(slot) <= parent + flat.subtreeSize(parent));
+        CHECK(flat.parentOf(flat.idAt(slot)) == flat.idAt(parent));
+    }
+}
+
+std::vector<uint32_t> slotOrder(const FlatHierarchy& flat) {
+    std::vector<uint32_t> ids;
+    for (uint32_t slot = 0; slot < flat.size(); ++slot) ids.push_back(flat.idAt(slot));
+    return ids;
+}
+
+} // namespace
+
+TEST_CASE("FlatHierarchy - insert keeps subtrees contiguous") {
+    FlatHierarchy flat;
+    CHECK(flat.insert(0));
+    CHECK(flat.insert(1));
+    CHECK(flat.insert(2, 0));
+    CHECK(flat.insert(3, 2));
+    CHECK(flat.insert(4, 0));
+
+    CHECK_FALSE(flat.insert(2));       // Already present
+    CHECK_FALSE(flat.insert(5, 9));    // Unknown parent
+
+    std::vector<uint32_t> expected = {0, 2, 3, 4, 1};
+    CHECK(slotOrder(flat) == expected);
+    CHECK(flat.subtreeSize(flat.slotOf(0)) == 4);
+    checkOrder(flat);
+
+    std::vector<uint32_t> children;
+    flat.childrenOf(0, children);
+    std::vector<uint32_t> expectedChildren = {2, 4};
+    CHECK(children == expectedChildren);
+
+    std::vector<uint32_t> roots;
+    flat.roots(roots);
+    std::vector<uint32_t> expectedRoots = {0, 1};
+    CHECK(roots == expectedRoots);
+}
+
+TEST_CASE("FlatHierarchy - setParent moves the whole subtree") {
+    FlatHierarchy flat;
+    flat.insert(0);
+    flat.insert(1, 0);
+    flat.insert(2, 1);
+    flat.insert(3);
+    flat.insert(4, 3);
+
+    CHECK(flat.setParent(1, 4));
+    std::vector<uint32_t> expected = {0, 3, 4, 1, 2};
+    CHECK(slotOrder(flat) == expected);
+    CHECK(flat.subtreeSize(flat.slotOf(0)) == 1);
+    CHECK(flat.subtreeSize(flat.slotOf(3)) == 4);
+    checkOrder(flat);
+
+    // Back to a root, moving towards the end
+    CHECK(flat.setParent(4, FlatHierarchy::NONE));
+    CHECK(flat.parentOf(4) == FlatHierarchy::NONE);
+    CHECK(flat.subtreeSize(flat.slotOf(3)) == 1);
+    checkOrder(flat);
+
+    // Cycles are refused
+    CHECK_FALSE(flat.setParent(4, 2));
+    CHECK_FALSE(flat.setParent(4, 4));
+    checkOrder(flat);
+}
+
+TEST_CASE("FlatHierarchy - remove orphans children into roots") {
+    FlatHierarchy flat;
+    flat.insert(0);
+    flat.insert(1, 0);
+    flat.insert(2, 1);
+    flat.insert(3, 1);
+
+    flat.remove(1);
+    CHECK_FALSE(flat.contains(1));
+    CHECK(flat.size() == 3);
+    CHECK(flat.parentOf(2) == FlatHierarchy::NONE);
+    CHECK(flat.parentOf(3) == FlatHierarchy::NONE);
+    CHECK(flat.subtreeSize(flat.slotOf(0)) == 1);
+    checkOrder(flat);
+
+    // The id can be reused
+    CHECK(flat.insert(1, 3));
+    checkOrder(flat);
+}
+
+TEST_CASE("FlatHierarchy - update only recomputes dirty subtrees") {
+    FlatHierarchy flat;
+    flat.insert(0);
+    flat.insert(1, 0);
+    flat.insert(2);
+
+    std::vector<glm::mat4> locals = {translation(10, 0, 0), translation(5, 0, 0), translation(0, 1, 0)};
+    int computed = 0;
+    auto local = [&](uint32_t id) {
+        ++computed;
+        return locals[id];
+    };
+
+    flat.update(local);
+    CHECK(computed == 3);
+    CHECK(flat.world(1)[3].x == doctest::Approx(15.0f));
+    CHECK(flat.world(2)[3].y == doctest::Approx(1.0f));
+
+    // Nothing dirty: nothing recomputed
+    computed = 0;
+    flat.update(local);
+    CHECK(computed == 0);
+
+    // Dirtying the root covers its child but not the other root
+    locals[0] = translation(20, 0, 0);
+    flat.markDirty(0);
+    CHECK(flat.isDirty(1));
+    CHECK_FALSE(flat.isDirty(2));
+    flat.update(local);
+    CHECK(computed == 2);
+    CHECK(flat.world(1)[3].x == doctest::Approx(25.0f));
+}
+
+TEST_CASE("FlatHierarchy - resolve walks up dirty ancestors only") {
+    FlatHierarchy flat;
+    flat.insert(0);
+    flat.insert(1, 0);
+    flat.insert(2, 1);
+
+    std::vector<glm::mat4> locals = {translation(1, 0, 0), translation(2, 0, 0), translation(3, 0, 0)};
+    auto local = [&](uint32_t id) { return locals[id]; };
+
+    CHECK(flat.resolve(1, local)[3].x == doctest::Approx(3.0f));
+    CHECK_FALSE(flat.isDirty(0));
+    CHECK(flat.isDirty(2));   // Below the resolved node, still pending
+    CHECK(flat.resolve(2, local)[3].x == doctest::Approx(6.0f));
+}
+
+TEST_CASE("FlatHierarchy - rebuild orders parents first and breaks cycles") {
+    FlatHierarchy flat;
+    // Children listed before parents; 7 -> 8 -> 7 is a cycle; 9's parent is missing
+    flat.rebuild({{3, 1}, {1, 0}, {0, FlatHierarchy::NONE}, {2, 0},
+                  {7, 8}, {8, 7}, {9, 42}});
+
+    CHECK(flat.size() == 7);
+    checkOrder(flat);
+    CHECK(flat.parentOf(3) == 1);
+    CHECK(flat.parentOf(2) == 0);
+    CHECK(flat.parentOf(9) == FlatHierarchy::NONE);
+    CHECK(flat.subtreeSize(flat.slotOf(0)) == 4);
+    // One of the cycle members became the root of the other
+    bool cycleBroken = (flat.parentOf(7) == FlatHierarchy::NONE && flat.parentOf(8) == 7) ||
+                       (flat.parentOf(8) == FlatHierarchy::NONE && flat.parentOf(7) == 8);
+    CHECK(cycleBroken);
+}
+
+TEST_CASE("FlatHierarchy - partition splits on root subtrees") {
+    FlatHierarchy flat;
+    for (uint32_t root = 0; root < 8; ++root) {
+        flat.insert(root * 10);
+        flat.insert(root * 10 + 1, root * 10);
+        flat.insert(root * 10 + 2, root * 10 + 1);
+    }
+
+    auto ranges = flat.partition(4);
+    REQUIRE(ranges.size() == 4);
+    uint32_t expectedBegin = 0;
+    for (const auto& range : ranges) {
+        CHECK(range.begin == expectedBegin);
+        CHECK(range.end - range.begin == 6);
+        // Each range starts at a root
+        CHECK(flat.parentSlot(range.begin) == FlatHierarchy::NONE);
+        expectedBegin = range.end;
+    }
+    CHECK(expectedBegin == flat.size());
+
+    // Ranges updated independently give the same result as a full update
+    auto local = [](uint32_t id) { return translation(static_cast<float>(id), 0, 0); };
+    for (auto it = ranges.rbegin(); it != ranges.rend(); ++it) flat.update(*it, local);
+    CHECK(flat.world(72)[3].x == doctest::Approx(70.0f + 71.0f + 72.0f));
+
+    CHECK(flat.partition(100).size() == 8);
+    CHECK(FlatHierarchy().partition(4).empty());
+}
@@ -0,0 +1,275 @@
+// Tests for FramePacingAnalyzer - bottleneck classification, percentiles,
+// hitch root causes and the rolling log, fed recorded timelines offline
+// No Vulkan dependencies
+
+#include <doctest/doctest.h>
+#include "debug/FramePacingAnalyzer.h"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+using Bottleneck = FramePacingAnalyzer::Bottleneck;
+using FrameTimeline = FramePacingAnalyzer::FrameTimeline;
+namespace fs = std::filesystem;
+
+namespace {
+
+class TempDir {
+public:
+    explicit TempDir(const std::string& name)
+        : path((fs::temp_directory_path() / ("frame_pacing_test_" + name)).string()) {
+        std::error_code ec;
+        fs::remove_all(path, ec);
+        fs::create_directories(path, ec);
+    }
+    ~TempDir() {
+        std::error_code ec;
+        fs::remove_all(path, ec);
+    }
+
+    std::string path;
+};
+
+// A steady 16.7 ms frame: 10 ms of CPU work, 9 ms on the GPU, vsync in present
+FrameTimeline steadyFrame(uint64_t number) {
+    FrameTimeline frame;
+    frame.frameNumber = number;
+    frame.frameTimeMs = 16.7f;
+    frame.cpuZones = {{"SystemUpdates", 4.0f}, {"Update:Grass", 1.5f}, {"RenderPassRecord", 3.0f},
+                      {"Streaming:Uploads", 0.3f}};
+    frame.fenceWaitMs = 0.1f;
+    frame.fenceAlreadySignaled = true;
+    frame.acquireMs = 0.2f;
+    frame.submitMs = 0.4f;
+    frame.presentMs = 6.0f;
+    frame.gpuTimeMs = 9.0f;
+    frame.gpuZones = {{"Shadow", 2.0f}, {"HDR", 5.0f}, {"Post", 2.0f}};
+    return frame;
+}
+
+void setZone(std::vector<FramePacingAnalyzer::Zone>& zones, const char* name, float ms) {
+    for (auto& zone : zones) {
+        if (zone.name == name) {
+            zone.ms = ms;
+            return;
+        }
+    }
+    zones.push_back({name, ms});
+}
+
+size_t countLines(const std::string& path) {
+    std::ifstream file(path);
+    size_t lines = 0;
+    for (std::string line; std::getline(file, line);) ++lines;
+    return lines;
+}
+
+} // namespace
+
+TEST_CASE("FramePacingAnalyzer - classifies what each frame waited on") {
+    FramePacingAnalyzer analyzer;
+
+    // Vsync-paced: both sides have headroom, present absorbs the rest
+    CHECK(analyzer.addFrame(steadyFrame(0)).bottleneck == Bottleneck::PresentBound);
+
+    // CPU-bound: no slack left in present, CPU work over the GPU time
+    FrameTimeline cpu = steadyFrame(1);
+    cpu.frameTimeMs = 22.0f;
+    cpu.presentMs = 0.3f;
+    setZone(cpu.cpuZones, "SystemUpdates", 14.0f);
+    const auto& cpuReport = analyzer.addFrame(cpu);
+    CHECK(cpuReport.bottleneck == Bottleneck::CpuBound);
+    CHECK(cpuReport.cpuBusyMs == doctest::Approx(22.0f - 0.1f - 0.2f - 0.3f - 0.3f));
+
+    // GPU-bound: the CPU blocked on the previous frame's fence
+    FrameTimeline fence = steadyFrame(2);
+    fence.frameTimeMs = 25.0f;
+    fence.presentMs = 0.3f;
+    fence.fenceAlreadySignaled = false;
+    fence.fenceWaitMs = 12.0f;
+    fence.gpuTimeMs = 24.0f;
+    CHECK(analyzer.addFrame(fence).bottleneck == Bottleneck::GpuBound);
+
+    // GPU-bound without a fence wait (the driver blocked in acquire instead)
+    FrameTimeline gpu = steadyFrame(3);
+    gpu.frameTimeMs = 30.0f;
+    gpu.acquireMs = 9.0f;
+    gpu.presentMs = 0.5f;
+    gpu.gpuTimeMs = 28.0f;
+    CHECK(analyzer.addFrame(gpu).bottleneck == Bottleneck::GpuBound);
+
+    // Streaming stall: the frame thread sat in streaming zones
+    FrameTimeline streaming = steadyFrame(4);
+    streaming.frameTimeMs = 40.0f;
+    streaming.presentMs = 0.3f;
+    setZone(streaming.cpuZones, "Streaming:Uploads", 18.0f);
+    streaming.cpuZones.push_back({"Wait:IO", 4.0f});
+    const auto& streamingReport = analyzer.addFrame(streaming);
+    CHECK(streamingReport.bottleneck == Bottleneck::StreamingStall);
+    CHECK(streamingReport.streamingMs == doctest::Approx(22.0f));
+
+    FramePacingAnalyzer::Summary summary = analyzer.getSummary();
+    CHECK(summary.frames == 5);
+    CHECK(summary.bottleneckFrames[static_cast<size_t>(Bottleneck::CpuBound)] == 1);
+    CHECK(summary.bottleneckFrames[static_cast<size_t>(Bottleneck::GpuBound)] == 2);
+    CHECK(summary.bottleneckFrames[static_cast<size_t>(Bottleneck::StreamingStall)] == 1);
+    CHECK(summary.bottleneckFrames[static_cast<size_t>(Bottleneck::PresentBound)] == 1);
+}
+
+TEST_CASE("FramePacingAnalyzer - percentiles over the rolling window") {
+    FramePacingAnalyzer::Config config;
+    config.windowFrames = 100;
+    FramePacingAnalyzer analyzer(config);
+    CHECK(analyzer.getSummary().frames == 0);
+
+    // Frame times 1..100 ms, shuffled order doesn't matter
+    for (int i = 0; i < 100; ++i) {
+        FrameTimeline frame;
+        frame.frameNumber = static_cast<uint64_t>(i);
+        frame.frameTimeMs = static_cast<float>((i * 37) % 100 + 1);
+        analyzer.addFrame(frame);
+    }
+    FramePacingAnalyzer::Summary summary = analyzer.getSummary();
+    CHECK(summary.frames == 100);
+    CHECK(summary.p50Ms == doctest::Approx(50.0f));
+    CHECK(summary.p95Ms == doctest::Approx(95.0f));
+    CHECK(summary.p99Ms == doctest::Approx(99.0f));
+    CHECK(summary.maxMs == doctest::Approx(100.0f));
+    CHECK(summary.averageMs == doctest::Approx(50.5f));
+
+    // Another 100 frames at 10 ms push the old ones out
+    for (int i = 0; i < 100; ++i) {
+        FrameTimeline frame;
+        frame.frameTimeMs = 10.0f;
+        analyzer.addFrame(frame);
+    }
+    summary = analyzer.getSummary();
+    CHECK(summary.frames == 100);
+    CHECK(summary.p99Ms == doctest::Approx(10.0f));
+    CHECK(summary.maxMs == doctest::Approx(10.0f));
+}
+
+TEST_CASE("FramePacingAnalyzer - hitches name the zone that grew") {
+    FramePacingAnalyzer analyzer;
+    uint64_t number = 0;
+    for (; number < 60; ++number) {
+        CHECK_FALSE(analyzer.addFrame(steadyFrame(number)).hitch);
+    }
+
+    // A CPU zone spikes
+    FrameTimeline cpuSpike = steadyFrame(number++);
+    cpuSpike.frameTimeMs = 45.0f;
+    cpuSpike.presentMs = 0.3f;
+    setZone(cpuSpike.cpuZones, "Update:Grass", 30.0f);
+    const auto& cpuReport = analyzer.addFrame(cpuSpike);
+    CHECK(cpuReport.hitch);
+    CHECK(cpuReport.rootCause == "CPU:Update:Grass");
+    CHECK(cpuReport.rootCauseExcessMs == doctest::Approx(28.5f).epsilon(0.01));
+
+    // The same spike again is still a hitch: hitches stay out of the averages
+    cpuSpike.frameNumber = number++;
+    CHECK(analyzer.addFrame(cpuSpike).rootCause == "CPU:Update:Grass");
+
+    // A GPU pass spikes and the CPU blocks on the fence
+    FrameTimeline gpuSpike = steadyFrame(number++);
+    gpuSpike.frameTimeMs = 48.0f;
+    gpuSpike.presentMs = 0.3f;
+    gpuSpike.fenceAlreadySignaled = false;
+    gpuSpike.fenceWaitMs = 28.0f;
+    gpuSpike.gpuTimeMs = 45.0f;
+    setZone(gpuSpike.gpuZones, "Shadow", 38.0f);
+    const auto& gpuReport = analyzer.addFrame(gpuSpike);
+    CHECK(gpuReport.hitch);
+    CHECK(gpuReport.bottleneck == Bottleneck::GpuBound);
+    CHECK(gpuReport.rootCause == "GPU:Shadow");
+
+    // A zone that never ran before counts from zero
+    FrameTimeline newZone = steadyFrame(number++);
+    newZone.frameTimeMs = 40.0f;
+    newZone.presentMs = 0.3f;
+    newZone.cpuZones.push_back({"DeferredTerrainGen", 23.0f});
+    CHECK(analyzer.addFrame(newZone).rootCause == "CPU:DeferredTerrainGen");
+
+    // Slightly slow frames and small absolute jumps are not hitches
+    FrameTimeline slow = steadyFrame(number++);
+    slow.frameTimeMs = 30.0f;
+    CHECK_FALSE(analyzer.addFrame(slow).hitch);
+
+    CHECK(analyzer.getHitches().size() == 4);
+    CHECK(analyzer.getSummary().hitches == 4);
+
+    // No hitches before the warmup: the baseline is meaningless
+    FramePacingAnalyzer fresh;
+    for (uint64_t i = 0; i < 5; ++i) fresh.addFrame(steadyFrame(i));
+    FrameTimeline early = steadyFrame(5);
+    early.frameTimeMs = 100.0f;
+    CHECK_FALSE(fresh.addFrame(early).hitch);
+}
+
+TEST_CASE("FramePacingAnalyzer - rolling CSV log keeps the newest files") {
+    TempDir dir("csv");
+    const std::string path = dir.path + "/pacing.csv";
+    CHECK(FramePacingAnalyzer::rotatedLogPath(path, 0) == path);
+    CHECK(FramePacingAnalyzer::rotatedLogPath(path, 2) == dir.path + "/pacing.2.csv");
+
+    FramePacingAnalyzer analyzer;
+    REQUIRE(analyzer.startLog(path, FramePacingAnalyzer::LogFormat::Csv, 10, 3));
+    CHECK(analyzer.isLogging());
+    for (uint64_t i = 0; i < 45; ++i) analyzer.addFrame(steadyFrame(i));
+    analyzer.stopLog();
+    CHECK_FALSE(analyzer.isLogging());
+
+    // 45 frames, 10 per file, 3 files kept: live has 40..44, .1 has 30..39, .2 has 20..29
+    CHECK(countLines(path) == 1 + 5);
+    CHECK(countLines(FramePacingAnalyzer::rotatedLogPath(path, 1)) == 1 + 10);
+    CHECK(countLines(FramePacingAnalyzer::rotatedLogPath(path, 2)) == 1 + 10);
+    CHECK_FALSE(fs::exists(FramePacingAnalyzer::rotatedLogPath(path, 3)));
+
+    std::ifstream file(FramePacingAnalyzer::rotatedLogPath(path, 2));
+    std::string header, first;
+    std::getline(file, header);
+    std::getline(file, first);
+    CHECK(header.rfind("frame,frame_ms,", 0) == 0);
+    CHECK(first.rfind("20,16.700,", 0) == 0);
+    CHECK(first.find(",present,0,") != std::string::npos);
+}
+
+TEST_CASE("FramePacingAnalyzer - JSON lines log and summary") {
+    TempDir dir("json");
+    const std::string path = dir.path + "/pacing.jsonl";
+
+    FramePacingAnalyzer analyzer;
+    REQUIRE(analyzer.startLog(path, FramePacingAnalyzer::LogFormat::JsonLines, 1000, 2));
+    for (uint64_t i = 0; i < 40; ++i) analyzer.addFrame(steadyFrame(i));
+    FrameTimeline spike = steadyFrame(40);
+    spike.frameTimeMs = 60.0f;
+    setZone(spike.cpuZones, "SystemUpdates", 45.0f);
+    analyzer.addFrame(spike);
+    analyzer.stopLog();
+
+    std::ifstream file(path);
+    std::vector<json> rows;
+    for (std::string line; std::getline(file, line);) rows.push_back(json::parse(line));
+    REQUIRE(rows.size() == 41);
+    CHECK(rows[0]["frame"] == 0);
+    CHECK(rows[0]["bottleneck"] == "present");
+    CHECK_FALSE(rows[0].contains("root_cause"));
+    CHECK(rows[40]["hitch"] == true);
+    CHECK(rows[40]["root_cause"] == "CPU:SystemUpdates");
+
+    json summary = json::parse(analyzer.summaryJson());
+    CHECK(summary["frames"] == 41);
+    CHECK(summary["hitches"] == 1);
+    CHECK(summary["p50_ms"].get<float>() == doctest::Approx(16.7f));
+    CHECK(summary["max_ms"].get<float>() == doctest::Approx(60.0f));
+    CHECK(summary["bottlenecks"]["present"] == 40);
+    REQUIRE(summary["recent_hitches"].size() == 1);
+    CHECK(summary["recent_hitches"][0]["frame"] == 40);
+
+    const std::string summaryPath = dir.path + "/summary.json";
+    CHECK(analyzer.writeSummaryJson(summaryPath));
+    CHECK(fs::exists(summaryPath));
+}
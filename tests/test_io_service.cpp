@@ -0,0 +1,259 @@
+// Tests for IOService - shared async file reads
+// Thread pool backend only, so results don't depend on the kernel
+
+#include <doctest/doctest.h>
+#include "core/io/IOService.h"
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class TempFile {
+public:
+    TempFile(const std::string& name, size_t size) {
+        path = (fs::temp_directory_path() / ("io_service_test_" + name)).string();
+        data.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<uint8_t>(i * 7 + 3);
+        }
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        std::fwrite(data.data(), 1, data.size(), file);
+        std::fclose(file);
+    }
+    ~TempFile() {
+        std::error_code ec;
+        fs::remove(path, ec);
+    }
+
+    std::string path;
+    std::vector<uint8_t> data;
+};
+
+IOService::Config threadPoolConfig(uint32_t workers) {
+    IOService::Config config;
+    config.backend = IOService::Backend::ThreadPool;
+    config.workerCount = workers;
+    return config;
+}
+
+// Occupies every reader until released, so later requests stay queued
+class WorkerBlocker {
+public:
+    WorkerBlocker(IOService& service, const std::string& path, uint32_t workers) {
+        for (uint32_t i = 0; i < workers; ++i) {
+            IORequest request;
+            request.path = path;
+            request.priority = IOPriority::Critical;
+            service.submit(std::move(request), [this](IOResult&&) {
+                started++;
+                while (!released.load()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            });
+        }
+        while (started.load() < workers) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    void release() { released = true; }
+
+    std::atomic<uint32_t> started{0};
+    std::atomic<bool> released{false};
+};
+
+} // namespace
+
+TEST_SUITE("IOService") {
+    TEST_CASE("whole-file and ranged reads return the file contents") {
+        TempFile file("contents.bin", 10000);
+        auto service = IOService::create(threadPoolConfig(2));
+        CHECK(service->getBackend() == IOService::Backend::ThreadPool);
+
+        IOResult whole = service->readFile(file.path);
+        REQUIRE(whole.ok());
+        CHECK(whole.data == file.data);
+
+        IORequest request;
+        request.path = file.path;
+        request.offset = 4096;
+        request.size = 100;
+        IOResult ranged = service->read(request).get();
+        REQUIRE(ranged.ok());
+        REQUIRE(ranged.data.size() == 100);
+        CHECK(std::equal(ranged.data.begin(), ranged.data.end(), file.data.begin() + 4096));
+
+        // Reading past the end is an error, not a short result
+        request.offset = 9950;
+        CHECK(service->read(request).get().status == IOStatus::ReadError);
+
+        CHECK(service->readFile(file.path + ".missing").status == IOStatus::NotFound);
+    }
+
+    TEST_CASE("higher priority requests are dispatched first") {
+        TempFile file("priority.bin", 64);
+        auto service = IOService::create(threadPoolConfig(1));
+        WorkerBlocker blocker(*service, file.path, 1);
+
+        std::mutex orderMutex;
+        std::vector<int> order;
+        std::vector<std::future<void>> done;
+        auto queue = [&](IOPriority priority, int tag) {
+            auto promise = std::make_shared<std::promise<void>>();
+            done.push_back(promise->get_future());
+            IORequest request;
+            request.path = file.path;
+            request.priority = priority;
+            service->submit(std::move(request), [&, promise, tag](IOResult&&) {
+                std::lock_guard<std::mutex> lock(orderMutex);
+                order.push_back(tag);
+                promise->set_value();
+            });
+        };
+        queue(IOPriority::Low, 3);
+        queue(IOPriority::Normal, 1);
+        queue(IOPriority::Critical, 0);
+        queue(IOPriority::Normal, 2);
+
+        blocker.release();
+        for (auto& f : done) f.wait();
+        CHECK(order == (std::vector<int>{0, 1, 2, 3}));
+    }
+
+    TEST_CASE("cancelled and expired requests are reported, not read") {
+        TempFile file("cancel.bin", 64);
+        auto service = IOService::create(threadPoolConfig(1));
+        WorkerBlocker blocker(*service, file.path, 1);
+
+        IORequest request;
+        request.path = file.path;
+        std::future<IOResult> kept = service->read(request);
+
+        auto cancelledPromise = std::make_shared<std::promise<IOResult>>();
+        auto cancelledFuture = cancelledPromise->get_future();
+        IORequestId id = service->submit(request, [cancelledPromise](IOResult&& result) {
+            cancelledPromise->set_value(std::move(result));
+        });
+        CHECK(service->cancel(id));
+
+        request.deadline = IORequest::Clock::now() + std::chrono::milliseconds(1);
+        std::future<IOResult> late = service->read(request);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        blocker.release();
+        CHECK(cancelledFuture.get().status == IOStatus::Cancelled);
+        CHECK(late.get().status == IOStatus::DeadlineExpired);
+        CHECK(kept.get().ok());
+        CHECK_FALSE(service->cancel(id));
+
+        auto stats = service->getStats();
+        CHECK(stats.cancelled == 1);
+        CHECK(stats.expired == 1);
+    }
+
+    TEST_CASE("expired requests fail before the reads queued ahead of them") {
+        TempFile file("expire_order.bin", 64);
+        auto service = IOService::create(threadPoolConfig(1));
+        WorkerBlocker blocker(*service, file.path, 1);
+
+        std::mutex orderMutex;
+        std::vector<IOStatus> order;
+        std::vector<std::future<void>> done;
+        auto queue = [&](IOPriority priority, IORequest::Clock::time_point deadline) {
+            auto promise = std::make_shared<std::promise<void>>();
+            done.push_back(promise->get_future());
+            IORequest request;
+            request.path = file.path;
+            request.priority = priority;
+            request.deadline = deadline;
+            service->submit(std::move(request), [&, promise](IOResult&& result) {
+                std::lock_guard<std::mutex> lock(orderMutex);
+                order.push_back(result.status);
+                promise->set_value();
+            });
+        };
+        queue(IOPriority::Critical, IORequest::Clock::time_point::max());
+        queue(IOPriority::Normal, IORequest::Clock::time_point::max());
+        queue(IOPriority::Low, IORequest::Clock::now() + std::chrono::milliseconds(1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        blocker.release();
+        for (auto& f : done) f.wait();
+        CHECK(order == (std::vector<IOStatus>{IOStatus::DeadlineExpired, IOStatus::Ok, IOStatus::Ok}));
+        CHECK(service->getStats().expired == 1);
+    }
+
+    TEST_CASE("byte budget holds back reads until earlier ones finish") {
+        TempFile file("budget.bin", 4096);
+        IOService::Config config = threadPoolConfig(4);
+        config.maxBytesInFlight = 1024;
+        auto service = IOService::create(config);
+
+        // Sample what the other reads hold each time one completes
+        std::atomic<uint64_t> peak{0};
+        std::vector<std::future<void>> done;
+        for (int i = 0; i < 8; ++i) {
+            auto promise = std::make_shared<std::promise<void>>();
+            done.push_back(promise->get_future());
+            IORequest request;
+            request.path = file.path;
+            request.offset = static_cast<uint64_t>(i) * 512;
+            request.size = 512;
+            service->submit(std::move(request), [&, promise](IOResult&&) {
+                uint64_t inFlight = service->getStats().bytesInFlight;
+                uint64_t current = peak.load();
+                while (inFlight > current && !peak.compare_exchange_weak(current, inFlight)) {}
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                promise->set_value();
+            });
+        }
+        for (auto& f : done) f.wait();
+        CHECK(peak.load() <= 1024);
+        CHECK(service->getStats().bytesInFlight == 0);
+    }
+
+    TEST_CASE("stats track bytes and latency") {
+        TempFile file("stats.bin", 2048);
+        auto service = IOService::create(threadPoolConfig(2));
+        for (int i = 0; i < 20; ++i) {
+            REQUIRE(service->readFile(file.path).ok());
+        }
+        auto stats = service->getStats();
+        CHECK(stats.completed == 20);
+        CHECK(stats.totalBytesRead == 20 * 2048);
+        CHECK(stats.queueDepth == 0);
+        CHECK(stats.inFlight == 0);
+        CHECK(stats.latencyP50Ms >= 0.0f);
+        CHECK(stats.latencyP50Ms <= stats.latencyP95Ms);
+        CHECK(stats.latencyP95Ms <= stats.latencyP99Ms);
+    }
+
+    TEST_CASE("tasks run in order and shutdown cancels queued reads") {
+        TempFile file("shutdown.bin", 64);
+        auto service = IOService::create(threadPoolConfig(1));
+
+        std::vector<int> taskOrder;
+        for (int i = 0; i < 5; ++i) {
+            service->submitTask([&taskOrder, i] { taskOrder.push_back(i); });
+        }
+
+        WorkerBlocker blocker(*service, file.path, 1);
+        IORequest request;
+        request.path = file.path;
+        std::future<IOResult> queued = service->read(request);
+
+        std::thread releaser([&blocker] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            blocker.release();
+        });
+        service->shutdown();
+        releaser.join();
+
+        CHECK(queued.get().status == IOStatus::Cancelled);
+        CHECK(taskOrder == (std::vector<int>{0, 1, 2, 3, 4}));
+        CHECK(service->read(request).get().status == IOStatus::Cancelled);
+    }
+}
@@ -0,0 +1,210 @@
+#include <doctest/doctest.h>
+#include "lighting/LightClusterGrid.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+glm::mat4 makeProjection() {
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+    projection[1][1] *= -1.0f;
+    return projection;
+}
+
+std::vector<ClusterLight> makeLights(std::mt19937& rng, size_t count) {
+    std::uniform_real_distribution<float> coord(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> range(1.0f, 12.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<ClusterLight> lights(count);
+    for (size_t i = 0; i < count; ++i) {
+        lights[i].position = glm::vec3(coord(rng), coord(rng) * 0.2f, coord(rng) + 40.0f);
+        lights[i].radius = range(rng);
+        lights[i].id = static_cast<uint32_t>(1000 + i);
+        if (i % 3 == 0) {
+            glm::vec3 direction(unit(rng), unit(rng), unit(rng));
+            lights[i].direction = glm::length(direction) > 0.01f ? glm::normalize(direction) : glm::vec3(0, -1, 0);
+            lights[i].cosOuterCone = std::cos(glm::radians(i % 2 == 0 ? 20.0f : 60.0f));
+        }
+    }
+    return lights;
+}
+
+bool listed(const LightClusterGrid& grid, uint32_t cluster, uint32_t light) {
+    auto first = grid.lightIndices().begin() + grid.clusterOffset(cluster);
+    auto last = first + grid.clusterLightCount(cluster);
+    return std::binary_search(first, last, light);
+}
+
+// Every sampled point lit by a light lies in a cluster whose list has it
+void checkCoverage(const LightClusterGrid& grid, const glm::mat4& view, const std::vector<ClusterLight>& lights) {
+    std::mt19937 rng(77);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    size_t misses = 0;
+    size_t tested = 0;
+    for (uint32_t i = 0; i < lights.size(); ++i) {
+        const ClusterLight& light = lights[i];
+        for (int sample = 0; sample < 64; ++sample) {
+            glm::vec3 offset(unit(rng), unit(rng), unit(rng));
+            if (glm::dot(offset, offset) > 1.0f) continue;
+            offset *= light.radius;
+            if (light.cosOuterCone > 0.0f && glm::length(offset) > 1e-4f &&
+                glm::dot(glm::normalize(offset), light.direction) < light.cosOuterCone) {
+                continue;
+            }
+            glm::vec3 viewPosition = glm::vec3(view * glm::vec4(light.position + offset, 1.0f));
+            uint32_t cluster = grid.clusterAt(viewPosition);
+            if (cluster == LightClusterGrid::CLUSTER_COUNT) continue;
+            ++tested;
+            if (!listed(grid, cluster, i)) ++misses;
+        }
+    }
+    CHECK(tested > 1000);
+    CHECK(misses == 0);
+}
+
+} // namespace
+
+TEST_CASE("LightClusterGrid - every lit point's cluster lists the light") {
+    std::mt19937 rng(5);
+    std::vector<ClusterLight> lights = makeLights(rng, 300);
+    LightClusterGrid grid;
+    grid.setDepthRange(200.0f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0, 2, 0), glm::vec3(0.3f, 1.5f, 1), glm::vec3(0, 1, 0));
+    grid.assign(view, makeProjection(), lights);
+    checkCoverage(grid, view, lights);
+
+    // Compact lists: one entry per (light, cluster) pair, ascending per cluster
+    size_t pairs = 0;
+    for (uint32_t i = 0; i < lights.size(); ++i) pairs += grid.lightClusterCount(i);
+    CHECK(pairs == grid.lightIndices().size());
+    for (uint32_t c = 0; c < LightClusterGrid::CLUSTER_COUNT; ++c) {
+        auto first = grid.lightIndices().begin() + grid.clusterOffset(c);
+        CHECK(std::is_sorted(first, first + grid.clusterLightCount(c)));
+    }
+    // Far from every cluster being touched by every light
+    CHECK(pairs < lights.size() * LightClusterGrid::CLUSTER_COUNT / 20);
+}
+
+TEST_CASE("LightClusterGrid - lights outside the view or past the grid touch nothing") {
+    LightClusterGrid grid;
+    grid.setDepthRange(200.0f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0, 0, 1), glm::vec3(0, 1, 0));
+
+    std::vector<ClusterLight> lights(4);
+    lights[0].position = glm::vec3(0, 0, -20);     // Behind the camera
+    lights[0].radius = 5.0f;
+    lights[1].position = glm::vec3(0, 0, 260);     // Past the last slice
+    lights[1].radius = 10.0f;
+    lights[2].position = glm::vec3(80, 0, 10);     // Off to the side
+    lights[2].radius = 5.0f;
+    lights[3].position = glm::vec3(0, 0, 10);      // In view
+    lights[3].radius = 1.0f;
+    grid.assign(view, makeProjection(), lights);
+
+    CHECK(grid.lightClusterCount(0) == 0);
+    CHECK(grid.lightClusterCount(1) == 0);
+    CHECK(grid.lightClusterCount(2) == 0);
+    CHECK(grid.lightClusterCount(3) > 0);
+    CHECK(grid.lightClusterCount(3) < 64);
+
+    // A downward spot above the view only reaches the clusters below it
+    lights.resize(1);
+    lights[0].position = glm::vec3(0, 10, 30);
+    lights[0].radius = 8.0f;
+    lights[0].direction = glm::vec3(0, -1, 0);
+    lights[0].cosOuterCone = std::cos(glm::radians(15.0f));
+    grid.assign(view, makeProjection(), lights);
+    uint32_t spotClusters = grid.lightClusterCount(0);
+    lights[0].cosOuterCone = -1.0f;
+    grid.assign(view, makeProjection(), lights);
+    CHECK(spotClusters > 0);
+    CHECK(spotClusters < grid.lightClusterCount(0));
+}
+
+TEST_CASE("LightClusterGrid - slices follow the froxel depth distribution") {
+    LightClusterGrid grid;
+    grid.setDepthRange(200.0f, 300.0f);
+    grid.assign(glm::mat4(1.0f), makeProjection(), {});
+
+    const float total = std::pow(LightClusterGrid::DEPTH_DISTRIBUTION, float(LightClusterGrid::FROXEL_DEPTH)) - 1.0f;
+    for (uint32_t slice = 1; slice < LightClusterGrid::SLICES; ++slice) {
+        float froxelSlice = float(slice * LightClusterGrid::FROXELS_PER_SLICE);
+        float depth = 200.0f * (std::pow(LightClusterGrid::DEPTH_DISTRIBUTION, froxelSlice) - 1.0f) / total;
+        uint32_t before = grid.clusterAt(glm::vec3(0, 0, -depth * 0.999f));
+        uint32_t after = grid.clusterAt(glm::vec3(0, 0, -depth * 1.001f));
+        CHECK(before / (LightClusterGrid::TILES_X * LightClusterGrid::TILES_Y) == slice - 1);
+        CHECK(after / (LightClusterGrid::TILES_X * LightClusterGrid::TILES_Y) == slice);
+    }
+    // The last slice runs on to maxDistance
+    CHECK(grid.clusterAt(glm::vec3(0, 0, -250.0f)) / (LightClusterGrid::TILES_X * LightClusterGrid::TILES_Y) ==
+          LightClusterGrid::SLICES - 1);
+    CHECK(grid.clusterAt(glm::vec3(0, 0, -350.0f)) == LightClusterGrid::CLUSTER_COUNT);
+}
+
+TEST_CASE("LightClusterGrid - small moves reuse last frame's assignment") {
+    std::mt19937 rng(9);
+    std::vector<ClusterLight> lights = makeLights(rng, 200);
+    LightClusterGrid grid;
+    grid.setDepthRange(200.0f, 100.0f);
+    grid.setReuseMargin(0.25f);
+    const glm::mat4 projection = makeProjection();
+    auto viewAt = [](const glm::vec3& eye) { return glm::lookAt(eye, eye + glm::vec3(0, 0, 1), glm::vec3(0, 1, 0)); };
+
+    grid.assign(viewAt(glm::vec3(0.0f)), projection, lights);
+    CHECK(grid.reusedLightCount() == 0);
+    std::vector<uint32_t> first = grid.lightIndices();
+
+    grid.assign(viewAt(glm::vec3(0.0f)), projection, lights);
+    CHECK(grid.reusedLightCount() == lights.size());
+    CHECK(grid.lightIndices() == first);
+
+    // Camera drift within the margin: still reused, and still covering
+    glm::mat4 drifted = viewAt(glm::vec3(0.1f, 0.0f, 0.1f));
+    grid.assign(drifted, projection, lights);
+    CHECK(grid.reusedLightCount() == lights.size());
+    checkCoverage(grid, drifted, lights);
+
+    // Reordered lights are matched by id
+    std::reverse(lights.begin(), lights.end());
+    grid.assign(drifted, projection, lights);
+    CHECK(grid.reusedLightCount() == lights.size());
+    checkCoverage(grid, drifted, lights);
+
+    // One light moves a metre and a spot turns: only those are rebinned
+    lights[0].position.x += 1.0f;
+    size_t spot = 0;
+    while (lights[spot].cosOuterCone <= 0.0f) ++spot;
+    lights[spot].direction = -lights[spot].direction;
+    grid.assign(drifted, projection, lights);
+    CHECK(grid.reusedLightCount() == lights.size() - (spot == 0 ? 1 : 2));
+    checkCoverage(grid, drifted, lights);
+
+    // A camera step past the margin rebins everything
+    glm::mat4 stepped = viewAt(glm::vec3(0.0f, 0.0f, 1.0f));
+    grid.assign(stepped, projection, lights);
+    CHECK(grid.reusedLightCount() == 0);
+    checkCoverage(grid, stepped, lights);
+}
+
+TEST_CASE("LightClusterGrid - an empty assignment after a projection change clears every cluster") {
+    std::mt19937 rng(13);
+    std::vector<ClusterLight> lights = makeLights(rng, 50);
+    LightClusterGrid grid;
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0, 0, 1), glm::vec3(0, 1, 0));
+    grid.assign(view, makeProjection(), lights);
+    REQUIRE_FALSE(grid.lightIndices().empty());
+
+    glm::mat4 wider = glm::perspective(glm::radians(75.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+    wider[1][1] *= -1.0f;
+    grid.assign(view, wider, {});
+    CHECK(grid.lightIndices().empty());
+    size_t litClusters = 0;
+    for (uint32_t cluster = 0; cluster < LightClusterGrid::CLUSTER_COUNT; ++cluster) {
+        if (grid.clusterLightCount(cluster) > 0) ++litClusters;
+    }
+    CHECK(litClusters == 0);
+}
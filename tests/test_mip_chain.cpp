@@ -0,0 +1,129 @@
+// Tests for MipChain - CPU mip generation with alpha coverage preservation
+
+#include <doctest/doctest.h>
+#include "MipChain.h"
+#include <algorithm>
+#include <random>
+
+namespace {
+
+std::vector<uint8_t> solidImage(uint32_t width, uint32_t height, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        pixels[i] = r;
+        pixels[i + 1] = g;
+        pixels[i + 2] = b;
+        pixels[i + 3] = a;
+    }
+    return pixels;
+}
+
+std::vector<uint8_t> randomImage(uint32_t width, uint32_t height, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+    for (auto& v : pixels) v = static_cast<uint8_t>(rng() & 0xFF);
+    // Some fully transparent blocks to exercise the unweighted path
+    for (size_t i = 3; i < pixels.size(); i += 4 * 7) pixels[i] = 0;
+    return pixels;
+}
+
+} // namespace
+
+TEST_SUITE("MipChain") {
+    TEST_CASE("levels are packed back to back down to 1x1") {
+        auto pixels = solidImage(16, 4, 10, 20, 30, 255);
+        MipChain chain = MipChain::build(pixels.data(), 16, 4);
+
+        REQUIRE(chain.getLevelCount() == 5);
+        CHECK(MipChain::levelCountFor(16, 4) == 5);
+        CHECK(MipChain::levelCountFor(1, 1) == 1);
+        CHECK(MipChain::levelCountFor(5, 3) == 3);
+
+        size_t offset = 0;
+        uint32_t expectedWidths[] = {16, 8, 4, 2, 1};
+        uint32_t expectedHeights[] = {4, 2, 1, 1, 1};
+        for (uint32_t i = 0; i < chain.getLevelCount(); ++i) {
+            CHECK(chain.levels[i].width == expectedWidths[i]);
+            CHECK(chain.levels[i].height == expectedHeights[i]);
+            CHECK(chain.levels[i].offset == offset);
+            offset += chain.levels[i].size;
+        }
+        CHECK(chain.data.size() == offset);
+
+        // Opaque uniform colour survives every level unchanged
+        for (uint32_t i = 0; i < chain.getLevelCount(); ++i) {
+            const uint8_t* px = chain.getLevelData(i);
+            CHECK(px[0] == 10);
+            CHECK(px[1] == 20);
+            CHECK(px[2] == 30);
+            CHECK(px[3] == 255);
+        }
+
+        CHECK_FALSE(MipChain::build(nullptr, 4, 4).isValid());
+        CHECK_FALSE(MipChain::build(pixels.data(), 0, 4).isValid());
+    }
+
+    TEST_CASE("transparent texels don't bleed colour") {
+        // Red opaque texel next to black transparent ones
+        uint8_t pixels[2 * 2 * 4] = {
+            255, 0, 0, 255,   0, 0, 0, 0,
+            0, 0, 0, 0,       0, 0, 0, 0,
+        };
+        uint8_t out[4];
+        MipGen::downsample(pixels, 2, 2, out, 1, 1);
+        CHECK(out[0] == 255);
+        CHECK(out[1] == 0);
+        CHECK(out[3] == 64);
+
+        // A fully transparent block keeps its plain average colour
+        uint8_t clear[2 * 2 * 4] = {
+            100, 0, 0, 0,   200, 0, 0, 0,
+            100, 0, 0, 0,   200, 0, 0, 0,
+        };
+        MipGen::downsample(clear, 2, 2, out, 1, 1);
+        CHECK(out[0] == 150);
+        CHECK(out[3] == 0);
+    }
+
+    TEST_CASE("SIMD downsample matches the scalar reference") {
+        struct Size { uint32_t w, h; };
+        for (Size size : {Size{64, 64}, Size{33, 17}, Size{1, 9}, Size{8, 1}}) {
+            auto pixels = randomImage(size.w, size.h, size.w * 31 + size.h);
+            uint32_t dw = std::max(1u, size.w / 2);
+            uint32_t dh = std::max(1u, size.h / 2);
+            std::vector<uint8_t> simd(static_cast<size_t>(dw) * dh * 4);
+            std::vector<uint8_t> scalar(simd.size());
+            MipGen::downsample(pixels.data(), size.w, size.h, simd.data(), dw, dh);
+            MipGen::downsampleScalar(pixels.data(), size.w, size.h, scalar.data(), dw, dh);
+            CHECK(simd == scalar);
+        }
+    }
+
+    TEST_CASE("alpha-tested coverage is preserved down the chain") {
+        // Noisy foliage-like alpha: averaging pulls every level towards
+        // mid-grey, so with a 0.7 test a plain box filter loses most texels
+        const uint32_t size = 128;
+        std::vector<uint8_t> pixels = randomImage(size, size, 7);
+        const float threshold = 0.7f;
+        float target = MipGen::alphaCoverage(pixels.data(), size * size, threshold);
+        REQUIRE(target > 0.2f);
+
+        MipChain plain = MipChain::build(pixels.data(), size, size, 0.0f);
+        MipChain preserved = MipChain::build(pixels.data(), size, size, threshold);
+
+        CHECK(MipGen::alphaCoverage(plain.getLevelData(3), 16 * 16, threshold) < target * 0.5f);
+
+        for (uint32_t i = 1; i < preserved.getLevelCount(); ++i) {
+            const auto& level = preserved.levels[i];
+            if (level.width < 8) break;
+            float coverage = MipGen::alphaCoverage(preserved.getLevelData(i),
+                                                   static_cast<size_t>(level.width) * level.height, threshold);
+            CHECK(coverage == doctest::Approx(target).epsilon(0.1));
+        }
+
+        // Colour is untouched by the alpha scaling
+        const uint8_t* plainLevel1 = plain.getLevelData(1);
+        const uint8_t* preservedLevel1 = preserved.getLevelData(1);
+        CHECK(std::equal(plainLevel1, plainLevel1 + 3, preservedLevel1));
+    }
+}
@@ -0,0 +1,343 @@
+// Tests for ResourceGraph - resource-declared passes, culling, barriers and aliasing
+// No Vulkan dependencies
+
+#include <doctest/doctest.h>
+#include "core/pipeline/ResourceGraph.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+using Access = ResourceGraph::Access;
+using ResourceId = ResourceGraph::ResourceId;
+using PassDesc = ResourceGraph::PassDesc;
+
+constexpr uint64_t MB = 1024 * 1024;
+
+ResourceId transientImage(ResourceGraph& graph, const char* name, uint64_t size, uint64_t alignment = 256) {
+    ResourceGraph::ResourceDesc desc;
+    desc.name = name;
+    desc.sizeBytes = size;
+    desc.alignment = alignment;
+    return graph.addResource(desc);
+}
+
+ResourceId importedImage(ResourceGraph& graph, const char* name, Access initial, Access final) {
+    ResourceGraph::ResourceDesc desc;
+    desc.name = name;
+    desc.imported = true;
+    desc.initialAccess = initial;
+    desc.finalAccess = final;
+    return graph.addResource(desc);
+}
+
+PassDesc pass(const char* name, std::vector<ResourceGraph::ResourceUse> uses) {
+    PassDesc desc;
+    desc.name = name;
+    desc.uses = std::move(uses);
+    return desc;
+}
+
+bool dependsOn(const ResourceGraph& graph, ResourceGraph::PassIndex pass, ResourceGraph::PassIndex on) {
+    const auto& deps = graph.getDerivedDependencies(pass);
+    return std::find(deps.begin(), deps.end(), on) != deps.end();
+}
+
+} // namespace
+
+TEST_SUITE("ResourceGraph") {
+    TEST_CASE("reads are ordered after writes with the matching transitions") {
+        ResourceGraph graph;
+        ResourceId color = transientImage(graph, "SceneColor", 8 * MB);
+        ResourceId backbuffer = importedImage(graph, "Backbuffer", Access::None, Access::Present);
+
+        REQUIRE(graph.compile({
+            pass("Scene", {{color, Access::ColorAttachmentWrite}}),
+            pass("Tonemap", {{color, Access::ShaderSampledRead}, {backbuffer, Access::ColorAttachmentWrite}})}));
+
+        CHECK(dependsOn(graph, 1, 0));
+        CHECK(graph.isOrderedBefore(0, 1));
+        CHECK_FALSE(graph.isOrderedBefore(1, 0));
+
+        const auto& scene = graph.getBarriers(0);
+        REQUIRE(scene.before.size() == 1);
+        CHECK(scene.before[0].before == Access::None);
+        CHECK(scene.before[0].after == Access::ColorAttachmentWrite);
+
+        const auto& tonemap = graph.getBarriers(1);
+        REQUIRE(tonemap.before.size() == 2);
+        CHECK(tonemap.before[0].before == Access::ColorAttachmentWrite);
+        CHECK(tonemap.before[0].after == Access::ShaderSampledRead);
+        REQUIRE(tonemap.after.size() == 1);
+        CHECK(tonemap.after[0].resource == backbuffer);
+        CHECK(tonemap.after[0].after == Access::Present);
+    }
+
+    TEST_CASE("repeated reads of the same kind need no barrier") {
+        ResourceGraph graph;
+        ResourceId depth = transientImage(graph, "Depth", 4 * MB);
+        ResourceId out = importedImage(graph, "Out", Access::None, Access::None);
+
+        REQUIRE(graph.compile({
+            pass("Prepass", {{depth, Access::DepthStencilWrite}}),
+            pass("SSAO", {{depth, Access::ShaderSampledRead}}),
+            pass("Fog", {{depth, Access::ShaderSampledRead}, {out, Access::ComputeStorageWrite}}),
+            pass("Debug", {{depth, Access::ShaderSampledRead}, {out, Access::ComputeStorageReadWrite}})}));
+
+        // SSAO produces nothing that is read, so only Fog and Debug touch depth after the prepass
+        CHECK(graph.isCulled(1));
+        CHECK(graph.getBarriers(2).before.size() == 2);
+        CHECK(graph.getBarriers(3).before.size() == 1);  // Only Out: storage write -> read-write
+        CHECK(dependsOn(graph, 3, 2));
+    }
+
+    TEST_CASE("passes whose outputs are never read are culled") {
+        ResourceGraph graph;
+        ResourceId unused = transientImage(graph, "DebugView", 2 * MB);
+        ResourceId history = transientImage(graph, "History", 2 * MB);
+        ResourceId out = importedImage(graph, "Out", Access::None, Access::None);
+
+        PassDesc legacy;
+        legacy.name = "Gui";   // No declared resources: always kept
+
+        PassDesc readback = pass("Readback", {{history, Access::TransferRead}});
+        readback.hasSideEffects = true;
+
+        PassDesc explicitDep = pass("Prep", {{unused, Access::ComputeStorageWrite}});
+
+        PassDesc consumer = pass("Final", {{out, Access::ColorAttachmentWrite}});
+        consumer.dependencies = {3};
+
+        REQUIRE(graph.compile({
+            pass("Debug", {{unused, Access::ColorAttachmentWrite}}),
+            pass("HistoryWrite", {{history, Access::ComputeStorageWrite}}),
+            legacy,
+            explicitDep,
+            readback,
+            consumer}));
+
+        CHECK(graph.isCulled(0));
+        CHECK_FALSE(graph.isCulled(1));     // Read by a side-effect pass
+        CHECK_FALSE(graph.isCulled(2));
+        CHECK_FALSE(graph.isCulled(3));     // Explicit dependency of a kept pass
+        CHECK_FALSE(graph.isCulled(4));
+        CHECK_FALSE(graph.isCulled(5));
+        CHECK(graph.getStats().culledPasses == 1);
+        CHECK(graph.getBarriers(0).before.empty());
+
+        // Culled uses don't count towards lifetimes
+        CHECK(graph.getFirstUse(unused) == 3);
+    }
+
+    TEST_CASE("a culled pass leaves no gap in the chain of uses") {
+        ResourceGraph graph;
+        ResourceId buffer = transientImage(graph, "Scratch", MB);
+        ResourceId outA = importedImage(graph, "OutA", Access::None, Access::None);
+        ResourceId outB = importedImage(graph, "OutB", Access::None, Access::None);
+
+        REQUIRE(graph.compile({
+            pass("WriteA", {{buffer, Access::ComputeStorageWrite}}),
+            pass("ReadA", {{buffer, Access::ComputeStorageRead}, {outA, Access::ComputeStorageWrite}}),
+            pass("Overwritten", {{buffer, Access::ComputeStorageWrite}}),
+            pass("WriteB", {{buffer, Access::ComputeStorageWrite}}),
+            pass("ReadB", {{buffer, Access::ComputeStorageRead}, {outB, Access::ComputeStorageWrite}})}));
+
+        CHECK(graph.isCulled(2));
+        // WriteB must still wait for ReadA (write after read)
+        CHECK(dependsOn(graph, 3, 1));
+        CHECK(graph.isOrderedBefore(0, 4));
+    }
+
+    TEST_CASE("a mip chain's down- and up-sample steps are ordered through their reads") {
+        // Mirrors the bloom chain: each step renders one mip and samples a neighbour
+        ResourceGraph graph;
+        ResourceId mips[3] = {transientImage(graph, "Mip0", 4 * MB),
+                              transientImage(graph, "Mip1", MB),
+                              transientImage(graph, "Mip2", MB / 4)};
+        ResourceId out = importedImage(graph, "Out", Access::None, Access::None);
+
+        PassDesc composite = pass("Composite", {{mips[0], Access::ShaderSampledRead},
+                                                {out, Access::ColorAttachmentWrite}});
+        composite.hasSideEffects = true;
+
+        REQUIRE(graph.compile({
+            pass("Down0", {{mips[0], Access::ColorAttachmentWrite}}),
+            pass("Down1", {{mips[1], Access::ColorAttachmentWrite}, {mips[0], Access::ShaderSampledRead}}),
+            pass("Down2", {{mips[2], Access::ColorAttachmentWrite}, {mips[1], Access::ShaderSampledRead}}),
+            pass("Up1", {{mips[1], Access::ColorAttachmentWrite}, {mips[2], Access::ShaderSampledRead}}),
+            pass("Up0", {{mips[0], Access::ColorAttachmentWrite}, {mips[1], Access::ShaderSampledRead}}),
+            composite}));
+
+        CHECK(graph.getStats().culledPasses == 0);
+        for (ResourceGraph::PassIndex i = 1; i < 6; ++i) {
+            CHECK(graph.isOrderedBefore(i - 1, i));
+        }
+
+        // Up0 renders into mip 0 again after Down1 sampled it
+        const auto& up0 = graph.getBarriers(4).before;
+        auto mip0 = std::find_if(up0.begin(), up0.end(),
+                                 [&](const auto& b) { return b.resource == mips[0]; });
+        REQUIRE(mip0 != up0.end());
+        CHECK(mip0->before == Access::ShaderSampledRead);
+        CHECK(mip0->after == Access::ColorAttachmentWrite);
+    }
+
+    TEST_CASE("invalid graphs are rejected") {
+        ResourceGraph graph;
+        ResourceId r = transientImage(graph, "R", MB);
+
+        CHECK_FALSE(graph.compile({pass("Twice", {{r, Access::ComputeStorageRead}, {r, Access::ComputeStorageWrite}})}));
+        CHECK_FALSE(graph.compile({pass("Bad", {{42, Access::ComputeStorageRead}})}));
+
+        // Explicit edge pointing against the resource order
+        PassDesc first = pass("First", {{r, Access::ComputeStorageWrite}});
+        first.hasSideEffects = true;
+        first.dependencies = {1};
+        PassDesc second = pass("Second", {{r, Access::ComputeStorageRead}});
+        second.hasSideEffects = true;
+        CHECK_FALSE(graph.compile({first, second}));
+        CHECK_FALSE(graph.isCompiled());
+    }
+
+    TEST_CASE("a linear chain reuses memory of finished transients") {
+        ResourceGraph graph;
+        ResourceId a = transientImage(graph, "A", 4 * MB);
+        ResourceId b = transientImage(graph, "B", 4 * MB);
+        ResourceId c = transientImage(graph, "C", 4 * MB);
+        ResourceId out = importedImage(graph, "Out", Access::None, Access::None);
+
+        REQUIRE(graph.compile({
+            pass("P0", {{a, Access::ColorAttachmentWrite}}),
+            pass("P1", {{a, Access::ShaderSampledRead}, {b, Access::ColorAttachmentWrite}}),
+            pass("P2", {{b, Access::ShaderSampledRead}, {c, Access::ColorAttachmentWrite}}),
+            pass("P3", {{c, Access::ShaderSampledRead}, {out, Access::ColorAttachmentWrite}})}));
+
+        const auto& stats = graph.getStats();
+        CHECK(stats.transientResources == 3);
+        CHECK(stats.unaliasedBytes == 12 * MB);
+        CHECK(stats.aliasedBytes == 8 * MB);
+        REQUIRE(graph.getHeaps().size() == 1);
+
+        // A and C share memory; C's first barrier waits for A's last use
+        CHECK(graph.getPlacement(a).offset == graph.getPlacement(c).offset);
+        CHECK(graph.getPlacement(a).offset != graph.getPlacement(b).offset);
+        const auto& barriers = graph.getBarriers(2).before;
+        auto it = std::find_if(barriers.begin(), barriers.end(),
+            [c](const ResourceGraph::Barrier& barrier) { return barrier.resource == c; });
+        REQUIRE(it != barriers.end());
+        CHECK(it->before == Access::None);
+        REQUIRE(it->aliasedFrom.size() == 1);
+        CHECK(it->aliasedFrom[0] == a);
+    }
+
+    TEST_CASE("resources on unordered branches never share memory") {
+        ResourceGraph graph;
+        ResourceId left = transientImage(graph, "Left", 4 * MB);
+        ResourceId right = transientImage(graph, "Right", 4 * MB);
+        ResourceId outL = importedImage(graph, "OutL", Access::None, Access::None);
+        ResourceId outR = importedImage(graph, "OutR", Access::None, Access::None);
+
+        REQUIRE(graph.compile({
+            pass("L0", {{left, Access::ComputeStorageWrite}}),
+            pass("R0", {{right, Access::ComputeStorageWrite}}),
+            pass("L1", {{left, Access::ComputeStorageRead}, {outL, Access::ComputeStorageWrite}}),
+            pass("R1", {{right, Access::ComputeStorageRead}, {outR, Access::ComputeStorageWrite}})}));
+
+        CHECK_FALSE(graph.isOrderedBefore(2, 1));
+        CHECK(graph.getStats().aliasedBytes == 8 * MB);
+    }
+
+    TEST_CASE("heaps split by type and memory type, offsets respect alignment") {
+        ResourceGraph graph;
+        ResourceId small = transientImage(graph, "Small", 1000, 1);
+        ResourceId big = transientImage(graph, "Big", 3000, 4096);
+        ResourceId other = transientImage(graph, "Other", 500, 1);
+        graph.setResourceMemory(other, 500, 1, 0x2);
+
+        ResourceGraph::ResourceDesc bufferDesc;
+        bufferDesc.name = "Buffer";
+        bufferDesc.type = ResourceGraph::ResourceType::Buffer;
+        bufferDesc.sizeBytes = 2000;
+        ResourceId buffer = graph.addResource(bufferDesc);
+        ResourceId out = importedImage(graph, "Out", Access::None, Access::None);
+
+        // All live together
+        REQUIRE(graph.compile({
+            pass("Write", {{small, Access::ComputeStorageWrite}, {big, Access::ComputeStorageWrite},
+                           {other, Access::ComputeStorageWrite}, {buffer, Access::ComputeStorageWrite}}),
+            pass("Read", {{small, Access::ComputeStorageRead}, {big, Access::ComputeStorageRead},
+                          {other, Access::ComputeStorageRead}, {buffer, Access::ComputeStorageRead},
+                          {out, Access::ComputeStorageWrite}})}));
+
+        CHECK(graph.getHeaps().size() == 3);
+        CHECK(graph.getPlacement(small).heap == graph.getPlacement(big).heap);
+        CHECK(graph.getPlacement(other).heap != graph.getPlacement(big).heap);
+        CHECK(graph.getPlacement(buffer).heap != graph.getPlacement(big).heap);
+
+        // Big placed first at 0, small after it
+        CHECK(graph.getPlacement(big).offset == 0);
+        CHECK(graph.getPlacement(small).offset == 3000);
+        CHECK(graph.getPlacement(big).offset % 4096 == 0);
+    }
+
+    TEST_CASE("post-processing frame reports transient memory before and after aliasing") {
+        // HDR scene -> HiZ, SSR, bloom chain -> composite, with 1080p-sized targets
+        ResourceGraph graph;
+        constexpr uint64_t RGBA16F = 1920ull * 1080 * 8;
+        ResourceId hdr = transientImage(graph, "HDRColor", RGBA16F);
+        ResourceId depth = transientImage(graph, "Depth", 1920ull * 1080 * 4);
+        ResourceId hiz = transientImage(graph, "HiZ", 1920ull * 1080 * 4 * 4 / 3);
+        ResourceId ssr = transientImage(graph, "SSR", RGBA16F / 4);
+        std::vector<ResourceId> bloom;
+        for (int mip = 0; mip < 6; ++mip) {
+            bloom.push_back(transientImage(graph, "BloomMip", RGBA16F >> (2 * (mip + 1))));
+        }
+        ResourceId backbuffer = importedImage(graph, "Swapchain", Access::None, Access::Present);
+
+        std::vector<PassDesc> passes;
+        passes.push_back(pass("HDR", {{hdr, Access::ColorAttachmentWrite}, {depth, Access::DepthStencilWrite}}));
+        passes.push_back(pass("HiZ", {{depth, Access::ShaderSampledRead}, {hiz, Access::ComputeStorageWrite}}));
+        passes.push_back(pass("SSR", {{hdr, Access::ShaderSampledRead}, {hiz, Access::ShaderSampledRead},
+                                      {ssr, Access::ComputeStorageWrite}}));
+        passes.push_back(pass("BloomDown0", {{hdr, Access::ShaderSampledRead}, {bloom[0], Access::ColorAttachmentWrite}}));
+        for (size_t mip = 1; mip < bloom.size(); ++mip) {
+            passes.push_back(pass("BloomDown", {{bloom[mip - 1], Access::ShaderSampledRead},
+                                                {bloom[mip], Access::ColorAttachmentWrite}}));
+        }
+        passes.push_back(pass("Composite", {{hdr, Access::ShaderSampledRead}, {ssr, Access::ShaderSampledRead},
+                                            {bloom[1], Access::ShaderSampledRead},
+                                            {backbuffer, Access::ColorAttachmentWrite}}));
+        // A debug visualisation nobody reads
+        ResourceId debug = transientImage(graph, "DebugView", RGBA16F);
+        passes.push_back(pass("DebugView", {{hiz, Access::ShaderSampledRead}, {debug, Access::ColorAttachmentWrite}}));
+
+        REQUIRE(graph.compile(passes));
+        const auto& stats = graph.getStats();
+        MESSAGE("Transient memory: " << stats.unaliasedBytes / 1024 << " KB unaliased, "
+                << stats.aliasedBytes / 1024 << " KB aliased, " << stats.culledPasses << " passes culled, "
+                << stats.barriers << " barriers");
+
+        // Bloom mips 2+ are unused by the composite, so their passes go
+        CHECK(stats.culledPasses == 5);
+        CHECK(stats.transientResources == 6);
+        CHECK(stats.aliasedBytes < stats.unaliasedBytes);
+
+        // Only used by a culled pass, so never allocated
+        CHECK(graph.getPlacement(debug).heap == ResourceGraph::NO_HEAP);
+
+        // Any two transients sharing bytes must have strictly ordered lifetimes
+        for (ResourceId x = 0; x < graph.getResourceCount(); ++x) {
+            for (ResourceId y = x + 1; y < graph.getResourceCount(); ++y) {
+                const auto& px = graph.getPlacement(x);
+                const auto& py = graph.getPlacement(y);
+                if (px.heap == ResourceGraph::NO_HEAP || px.heap != py.heap) continue;
+                bool overlap = px.offset < py.offset + graph.getResource(y).sizeBytes &&
+                               py.offset < px.offset + graph.getResource(x).sizeBytes;
+                if (!overlap) continue;
+                bool ordered = graph.isOrderedBefore(graph.getLastUse(x), graph.getFirstUse(y)) ||
+                               graph.isOrderedBefore(graph.getLastUse(y), graph.getFirstUse(x));
+                CHECK(ordered);
+            }
+        }
+    }
+}
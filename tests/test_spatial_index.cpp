@@ -0,0 +1,201 @@
+#include <doctest/doctest.h>
+#include "ecs/SpatialIndex.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace ecs;
+
+namespace {
+
+struct Box {
+    glm::vec3 min;
+    glm::vec3 max;
+    uint32_t layers;
+    bool alive;
+};
+
+Box randomBox(std::mt19937& rng, uint32_t layers) {
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.1f, 4.0f);
+    glm::vec3 min(position(rng), position(rng), position(rng));
+    return {min, min + glm::vec3(size(rng), size(rng), size(rng)), layers, true};
+}
+
+bool overlaps(const Box& box, const glm::vec3& min, const glm::vec3& max) {
+    return box.min.x <= max.x && box.max.x >= min.x && box.min.y <= max.y && box.max.y >= min.y &&
+           box.min.z <= max.z && box.max.z >= min.z;
+}
+
+float sphereDistanceSq(const Box& box, const glm::vec3& center) {
+    glm::vec3 offset = glm::clamp(center, box.min, box.max) - center;
+    return glm::dot(offset, offset);
+}
+
+std::vector<uint32_t> sorted(std::vector<uint32_t> ids) {
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+} // namespace
+
+TEST_CASE("SpatialIndex - AABB and sphere queries find every overlapping box") {
+    std::mt19937 rng(3);
+    SpatialIndex index(0.5f);
+    std::vector<Box> boxes;
+    std::vector<int32_t> proxies;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        boxes.push_back(randomBox(rng, i % 3 == 0 ? 2u : 1u));
+        proxies.push_back(index.insert(boxes[i].min, boxes[i].max, i, boxes[i].layers));
+    }
+    CHECK(index.size() == 2000);
+    // Balanced: far below the 2000 levels of a degenerate list
+    CHECK(index.height() < 40);
+
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    for (int query = 0; query < 50; ++query) {
+        glm::vec3 center(position(rng), position(rng), position(rng));
+        float radius = 15.0f;
+
+        std::vector<uint32_t> found;
+        index.querySphere(center, radius, SpatialIndex::ALL_LAYERS, [&](uint32_t id) { found.push_back(id); });
+        for (uint32_t id = 0; id < boxes.size(); ++id) {
+            if (sphereDistanceSq(boxes[id], center) <= radius * radius) {
+                CHECK(std::find(found.begin(), found.end(), id) != found.end());
+            }
+        }
+        // No box is reported that its fat box could not explain
+        for (uint32_t id : found) {
+            CHECK(std::sqrt(sphereDistanceSq(boxes[id], center)) <= radius + 0.5f * std::sqrt(3.0f) + 1e-3f);
+        }
+
+        std::vector<uint32_t> layered;
+        index.queryAabb(center - glm::vec3(radius), center + glm::vec3(radius), 2u,
+                        [&](uint32_t id) { layered.push_back(id); });
+        for (uint32_t id : layered) CHECK(boxes[id].layers == 2u);
+        for (uint32_t id = 0; id < boxes.size(); ++id) {
+            if (boxes[id].layers == 2u && overlaps(boxes[id], center - glm::vec3(radius), center + glm::vec3(radius))) {
+                CHECK(std::find(layered.begin(), layered.end(), id) != layered.end());
+            }
+        }
+    }
+}
+
+TEST_CASE("SpatialIndex - updates and removals keep queries exact") {
+    std::mt19937 rng(8);
+    SpatialIndex index(0.25f);
+    std::vector<Box> boxes;
+    std::vector<int32_t> proxies;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        boxes.push_back(randomBox(rng, 1u));
+        proxies.push_back(index.insert(boxes[i].min, boxes[i].max, i, 1u));
+    }
+
+    std::uniform_real_distribution<float> nudge(-0.1f, 0.1f);
+    std::uniform_int_distribution<uint32_t> pick(0, 999);
+    size_t reinserted = 0;
+    for (int frame = 0; frame < 20; ++frame) {
+        // Small moves mostly stay inside the fat box
+        for (uint32_t i = 0; i < boxes.size(); ++i) {
+            if (!boxes[i].alive) continue;
+            glm::vec3 delta(nudge(rng), nudge(rng), nudge(rng));
+            boxes[i].min += delta;
+            boxes[i].max += delta;
+            reinserted += index.update(proxies[i], boxes[i].min, boxes[i].max) ? 1 : 0;
+        }
+        // A few teleports, removals and re-adds
+        uint32_t teleported = pick(rng);
+        if (boxes[teleported].alive) {
+            boxes[teleported] = randomBox(rng, 1u);
+            CHECK(index.update(proxies[teleported], boxes[teleported].min, boxes[teleported].max));
+        }
+        uint32_t removed = pick(rng);
+        if (boxes[removed].alive) {
+            index.remove(proxies[removed]);
+            boxes[removed].alive = false;
+        } else {
+            boxes[removed] = randomBox(rng, 1u);
+            proxies[removed] = index.insert(boxes[removed].min, boxes[removed].max, removed, 1u);
+        }
+    }
+    CHECK(reinserted < boxes.size() * 20 / 2);
+
+    size_t alive = 0;
+    for (const auto& box : boxes) alive += box.alive ? 1 : 0;
+    CHECK(index.size() == alive);
+    CHECK(index.height() < 40);
+
+    glm::vec3 min(-30.0f), max(30.0f);
+    std::vector<uint32_t> found;
+    index.queryAabb(min, max, SpatialIndex::ALL_LAYERS, [&](uint32_t id) { found.push_back(id); });
+    for (uint32_t id : found) CHECK(boxes[id].alive);
+    for (uint32_t id = 0; id < boxes.size(); ++id) {
+        if (boxes[id].alive && overlaps(boxes[id], min, max)) {
+            CHECK(std::find(found.begin(), found.end(), id) != found.end());
+        }
+    }
+}
+
+TEST_CASE("SpatialIndex - frustum query reports contained subtrees") {
+    SpatialIndex index(0.1f);
+    // A row of unit boxes along x from -50 to 49
+    for (uint32_t i = 0; i < 100; ++i) {
+        glm::vec3 min(static_cast<float>(i) - 50.0f, -0.5f, -0.5f);
+        index.insert(min, min + glm::vec3(1.0f), i);
+    }
+    // x in [-10, 10] slab, generous in y/z
+    std::array<glm::vec4, 6> planes = {glm::vec4(1, 0, 0, 10), glm::vec4(-1, 0, 0, 10),
+                                       glm::vec4(0, 1, 0, 10), glm::vec4(0, -1, 0, 10),
+                                       glm::vec4(0, 0, 1, 10), glm::vec4(0, 0, -1, 10)};
+
+    std::vector<uint32_t> contained, partial;
+    index.queryFrustum(planes, SpatialIndex::ALL_LAYERS, [&](uint32_t id, bool inside) {
+        (inside ? contained : partial).push_back(id);
+    });
+
+    // Boxes [-10, -9] .. [9, 10] (ids 40..59) are inside; fat boxes at the
+    // edges straddle a plane and come back as partial
+    for (uint32_t id : contained) {
+        CHECK(id >= 40);
+        CHECK(id <= 59);
+    }
+    CHECK(contained.size() >= 18);
+    for (uint32_t id : partial) CHECK((id == 39 || id == 40 || id == 59 || id == 60));
+    CHECK(contained.size() + partial.size() <= 22);
+}
+
+TEST_CASE("SpatialIndex - raycast visits hits nearest first and clips") {
+    SpatialIndex index(0.1f);
+    for (uint32_t i = 0; i < 20; ++i) {
+        glm::vec3 min(static_cast<float>(i) * 5.0f, -0.5f, -0.5f);
+        index.insert(min, min + glm::vec3(1.0f), i);
+    }
+    index.insert(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(1.0f, 11.0f, 1.0f), 100);
+
+    // Keep going: every box on the +x axis within 52 units, nothing off-axis
+    std::vector<uint32_t> hits;
+    index.raycast(glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), 52.0f, SpatialIndex::ALL_LAYERS,
+                  [&](uint32_t id, float maxDistance) {
+                      hits.push_back(id);
+                      return maxDistance;
+                  });
+    const std::vector<uint32_t> expected = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    CHECK(sorted(hits) == expected);
+
+    // Clip at the first exact hit: only boxes nearer than it are visited after
+    float nearest = 1e9f;
+    uint32_t nearestId = 0;
+    index.raycast(glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), 1000.0f, SpatialIndex::ALL_LAYERS,
+                  [&](uint32_t id, float) {
+                      float distance = static_cast<float>(id) * 5.0f + 1.0f;
+                      if (distance < nearest) {
+                          nearest = distance;
+                          nearestId = id;
+                      }
+                      return distance;
+                  });
+    CHECK(nearestId == 0);
+    CHECK(nearest == doctest::Approx(1.0f));
+}
@@ -0,0 +1,198 @@
+// Tests for StagingRing - staging sub-allocation fenced per submission
+// No Vulkan dependencies; a fake fence clock stands in for the timeline semaphore
+
+#include <doctest/doctest.h>
+#include "core/vulkan/StagingRing.h"
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Timeline semaphore stand-in: submissions signal increasing values,
+// the "GPU" completes them when told to
+struct FakeFence {
+    uint64_t nextValue = 1;
+    uint64_t completed = 0;
+
+    uint64_t submit() { return nextValue++; }
+    void completeUpTo(uint64_t value) { completed = std::max(completed, value); }
+    void completeAll() { completed = nextValue - 1; }
+};
+
+bool overlaps(const StagingRing::Allocation& a, const StagingRing::Allocation& b) {
+    return a.offset < b.offset + b.size && b.offset < a.offset + a.size;
+}
+
+} // namespace
+
+TEST_SUITE("StagingRing") {
+    TEST_CASE("allocations are aligned and packed within a batch") {
+        StagingRing ring(1024);
+        auto a = ring.allocate(10, 16);
+        auto b = ring.allocate(20, 64);
+        auto c = ring.allocate(4, 4);
+        REQUIRE(a);
+        REQUIRE(b);
+        REQUIRE(c);
+        CHECK(a->offset == 0);
+        CHECK(b->offset == 64);
+        CHECK(c->offset == 84);
+        CHECK(ring.usedBytes() == 88);
+        CHECK(ring.hasOpenBatch());
+    }
+
+    TEST_CASE("regions are freed only when their fence is reached") {
+        FakeFence fence;
+        StagingRing ring(256, 128);
+
+        REQUIRE(ring.allocate(128));
+        uint64_t first = fence.submit();
+        ring.closeBatch(first);
+
+        REQUIRE(ring.allocate(128));
+        uint64_t second = fence.submit();
+        ring.closeBatch(second);
+
+        // Full until the GPU catches up
+        CHECK_FALSE(ring.allocate(16));
+        ring.retire(fence.completed);
+        CHECK_FALSE(ring.allocate(16));
+
+        fence.completeUpTo(first);
+        ring.retire(fence.completed);
+        CHECK(ring.inFlightBatches() == 1);
+        auto wrapped = ring.allocate(64);
+        REQUIRE(wrapped);
+        CHECK(wrapped->offset == 0);
+
+        fence.completeAll();
+        ring.retire(fence.completed);
+        CHECK(ring.inFlightBatches() == 0);
+        CHECK(ring.usedBytes() == 64);  // The open batch is still live
+    }
+
+    TEST_CASE("a region that doesn't fit at the end wraps and frees the gap with its batch") {
+        FakeFence fence;
+        StagingRing ring(100, 100);
+
+        REQUIRE(ring.allocate(60, 1));
+        ring.closeBatch(fence.submit());
+        fence.completeAll();
+        ring.retire(fence.completed);
+
+        // Tail is at 60 but the ring is empty, so the next request starts over at 0
+        auto a = ring.allocate(50, 1);
+        REQUIRE(a);
+        CHECK(a->offset == 0);
+        ring.closeBatch(fence.submit());
+
+        auto b = ring.allocate(30, 1);
+        REQUIRE(b);
+        CHECK(b->offset == 50);
+        ring.closeBatch(fence.submit());
+
+        // [80, 100) is too small; wraps to 0 but only after batch a has retired
+        CHECK_FALSE(ring.allocate(40, 1));
+        fence.completeUpTo(fence.completed + 1);
+        ring.retire(fence.completed);
+        auto c = ring.allocate(40, 1);
+        REQUIRE(c);
+        CHECK(c->offset == 0);
+        CHECK(ring.usedBytes() == 30 + 20 + 40);
+        ring.closeBatch(fence.submit());
+
+        fence.completeAll();
+        ring.retire(fence.completed);
+        CHECK(ring.usedBytes() == 0);
+    }
+
+    TEST_CASE("oversized requests are left to dedicated buffers") {
+        StagingRing ring(1 << 20);
+        CHECK(ring.maxAllocation() == (1u << 18));
+        CHECK_FALSE(ring.fits(0));
+        CHECK_FALSE(ring.allocate((1 << 18) + 1));
+        CHECK(ring.allocate(1 << 18));
+
+        ring.recordDedicated(1 << 22, false);
+        StagingRing::FrameStats stats = ring.takeFrameStats();
+        CHECK(stats.ringAllocations == 1);
+        CHECK(stats.dedicatedAllocations == 1);
+        CHECK(stats.ringFullFallbacks == 0);
+        CHECK(stats.dedicatedBytes == (1u << 22));
+        CHECK(ring.getFrameStats().ringAllocations == 0);
+    }
+
+    TEST_CASE("live regions never overlap under a frames-in-flight workload") {
+        constexpr uint32_t FRAMES_IN_FLIGHT = 3;
+        constexpr uint32_t FRAMES = 500;
+        FakeFence fence;
+        StagingRing ring(256 * 1024);
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<uint32_t> sizeDist(1, 12 * 1024);
+        std::uniform_int_distribution<uint32_t> countDist(0, 12);
+
+        struct Submitted {
+            uint64_t fenceValue;
+            std::vector<StagingRing::Allocation> regions;
+        };
+        std::deque<Submitted> inFlight;
+
+        uint32_t uploads = 0;
+        uint32_t dedicated = 0;
+        uint32_t submissions = 0;
+
+        for (uint32_t frame = 0; frame < FRAMES; ++frame) {
+            // The GPU finishes the frame submitted FRAMES_IN_FLIGHT frames ago
+            if (inFlight.size() >= FRAMES_IN_FLIGHT) {
+                fence.completeUpTo(inFlight.front().fenceValue);
+            }
+            ring.retire(fence.completed);
+            while (!inFlight.empty() && inFlight.front().fenceValue <= fence.completed) {
+                inFlight.pop_front();
+            }
+
+            std::vector<StagingRing::Allocation> frameRegions;
+            uint32_t count = countDist(rng);
+            for (uint32_t i = 0; i < count; ++i) {
+                uint64_t size = sizeDist(rng);
+                auto region = ring.allocate(size, 256);
+                uploads++;
+                if (!region) {
+                    ring.recordDedicated(size, ring.fits(size));
+                    dedicated++;
+                    continue;
+                }
+                CHECK(region->offset % 256 == 0);
+                CHECK(region->offset + region->size <= ring.capacity());
+                for (const auto& other : frameRegions) {
+                    CHECK_FALSE(overlaps(*region, other));
+                }
+                for (const auto& submitted : inFlight) {
+                    for (const auto& other : submitted.regions) {
+                        CHECK_FALSE(overlaps(*region, other));
+                    }
+                }
+                frameRegions.push_back(*region);
+            }
+
+            // One submission per frame for everything recorded
+            if (!frameRegions.empty()) {
+                uint64_t value = fence.submit();
+                ring.closeBatch(value);
+                inFlight.push_back({value, std::move(frameRegions)});
+                submissions++;
+            }
+        }
+
+        // Per-transfer staging would have allocated once per upload and submitted as often
+        CHECK(uploads > 1000);
+        CHECK(submissions <= FRAMES);
+        CHECK(dedicated < uploads / 10);
+
+        fence.completeAll();
+        ring.retire(fence.completed);
+        CHECK(ring.usedBytes() == 0);
+    }
+}
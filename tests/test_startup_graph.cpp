@@ -0,0 +1,262 @@
+// Tests for the startup job graph - critical-path ordering, dependency
+// release in LoadJobQueue and the startup timeline flamegraph
+
+#include <doctest/doctest.h>
+#include "loading/StartupGraph.h"
+#include "loading/StartupTimeline.h"
+#include "loading/LoadJobQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace Loading;
+
+namespace {
+
+// decode_a (10) -> upload_a (5) -> terrain (20); decode_b (30); decode_c (2) -> terrain
+StartupGraph makeStartupGraph() {
+    StartupGraph graph;
+    graph.addNode("decode_a", 10.0f);
+    graph.addNode("upload_a", 5.0f, {"decode_a"});
+    graph.addNode("decode_b", 30.0f);
+    graph.addNode("decode_c", 2.0f);
+    graph.addNode("terrain", 20.0f, {"upload_a", "decode_c"});
+    return graph;
+}
+
+std::vector<LoadJobResult> collect(LoadJobQueue& queue, size_t count) {
+    std::vector<LoadJobResult> results;
+    auto start = std::chrono::steady_clock::now();
+    while (results.size() < count && std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+        for (auto& result : queue.getCompletedJobs()) {
+            results.push_back(std::move(result));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return results;
+}
+
+LoadJob makeJob(const std::string& id, std::vector<std::string> dependencies, bool succeed = true) {
+    LoadJob job;
+    job.id = id;
+    job.phase = "Test";
+    job.dependencies = std::move(dependencies);
+    job.execute = [succeed]() -> std::unique_ptr<StagedResource> {
+        if (!succeed) return nullptr;
+        return std::make_unique<StagedBuffer>();
+    };
+    return job;
+}
+
+bool hasResult(const std::vector<LoadJobResult>& results, const std::string& id) {
+    return std::any_of(results.begin(), results.end(), [&](const LoadJobResult& r) { return r.jobId == id; });
+}
+
+} // namespace
+
+TEST_SUITE("StartupGraph") {
+    TEST_CASE("critical path includes the longest chain of dependents") {
+        StartupGraph graph = makeStartupGraph();
+        CHECK(graph.criticalPathMs("terrain") == doctest::Approx(20.0f));
+        CHECK(graph.criticalPathMs("upload_a") == doctest::Approx(25.0f));
+        CHECK(graph.criticalPathMs("decode_a") == doctest::Approx(35.0f));
+        CHECK(graph.criticalPathMs("decode_c") == doctest::Approx(22.0f));
+
+        // decode_b is the single most expensive job but not on the critical path
+        auto ready = graph.takeReady();
+        REQUIRE(ready.size() == 3);
+        CHECK(ready[0] == "decode_a");
+        CHECK(ready[1] == "decode_b");
+        CHECK(ready[2] == "decode_c");
+
+        auto path = graph.criticalPath();
+        REQUIRE(path.size() == 3);
+        CHECK(path[0].id == "decode_a");
+        CHECK(path[1].id == "upload_a");
+        CHECK(path[2].id == "terrain");
+    }
+
+    TEST_CASE("dependents are released once every dependency finishes") {
+        StartupGraph graph = makeStartupGraph();
+        graph.takeReady();
+
+        CHECK(graph.markFinished("decode_c").empty());
+        CHECK(graph.getState("terrain") == StartupGraph::State::Blocked);
+
+        auto released = graph.markFinished("decode_a");
+        REQUIRE(released.size() == 1);
+        CHECK(released[0] == "upload_a");
+        CHECK(graph.getState("upload_a") == StartupGraph::State::Ready);
+
+        released = graph.markFinished("upload_a");
+        REQUIRE(released.size() == 1);
+        CHECK(released[0] == "terrain");
+
+        // Finishing twice releases nothing more
+        CHECK(graph.markFinished("upload_a").empty());
+        CHECK(graph.finishedCount() == 3);
+        CHECK_FALSE(graph.allFinished());
+    }
+
+    TEST_CASE("dependencies may be declared before the node exists") {
+        StartupGraph graph;
+        graph.addNode("init", 1.0f, {"file"});
+        CHECK_FALSE(graph.takeIfReady("init"));
+        graph.addNode("file", 4.0f);
+        CHECK(graph.criticalPathMs("file") == doctest::Approx(5.0f));
+
+        auto ready = graph.takeReady();
+        REQUIRE(ready.size() == 1);
+        CHECK(ready[0] == "file");
+    }
+
+    TEST_CASE("validate drops unknown dependencies and breaks cycles") {
+        StartupGraph graph;
+        graph.addNode("a", 1.0f, {"missing"});
+        graph.addNode("b", 1.0f, {"c"});
+        graph.addNode("c", 1.0f, {"b"});
+        CHECK(graph.takeReady().empty());
+
+        CHECK(graph.validate() == 2);
+        auto ready = graph.takeReady();
+        CHECK(ready.size() == 2);
+        CHECK(graph.validate() == 0);
+    }
+
+    TEST_CASE("estimate is bounded by both the critical path and total work") {
+        StartupGraph graph = makeStartupGraph();
+        auto now = StartupGraph::Clock::now();
+
+        // Total work 67 ms: on one thread that dominates, on four the 35 ms chain does
+        CHECK(graph.estimate(1, now).totalMs == doctest::Approx(67.0f));
+        CHECK(graph.estimate(4, now).totalMs == doctest::Approx(35.0f));
+        CHECK(graph.progress(4, now) == doctest::Approx(0.0f));
+
+        graph.takeReady();
+        graph.markStarted("decode_a", now);
+        graph.markStarted("decode_b", now);
+        graph.markStarted("decode_c", now);
+
+        // 10 ms in: the critical chain has 25 ms left, the wide decode 20 ms
+        auto later = now + std::chrono::milliseconds(10);
+        CHECK(graph.estimate(4, later).remainingMs == doctest::Approx(25.0f).epsilon(0.01));
+
+        graph.markFinished("decode_a", later);
+        graph.markFinished("decode_c", later);
+        CHECK(graph.progress(4, later) == doctest::Approx(1.0f - 25.0f / 35.0f).epsilon(0.01));
+
+        // Progress never moves backwards, even if an estimate grows
+        float before = graph.progress(4, later);
+        graph.setEstimate("terrain", 200.0f);
+        CHECK(graph.progress(4, later) >= before);
+    }
+}
+
+TEST_SUITE("LoadJobQueue dependencies") {
+    TEST_CASE("dependents wait for the main-thread finish") {
+        auto queue = LoadJobQueue::create(2, "StartupGraphTestChain");
+        REQUIRE(queue);
+
+        LoadJob decode = makeJob("decode", {});
+        decode.finishOnMainThread = true;
+        std::vector<LoadJob> jobs;
+        jobs.push_back(std::move(decode));
+        jobs.push_back(makeJob("init", {"decode"}));
+        queue->setTotalJobs(2);
+        queue->submitBatch(std::move(jobs));
+
+        auto first = collect(*queue, 1);
+        REQUIRE(first.size() == 1);
+        CHECK(first[0].jobId == "decode");
+        CHECK(first[0].success);
+
+        // Nothing else runs until the upload is reported done
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        CHECK(queue->getCompletedJobs().empty());
+        CHECK_FALSE(queue->isComplete());
+
+        queue->finishJob("decode");
+        auto second = collect(*queue, 1);
+        REQUIRE(second.size() == 1);
+        CHECK(second[0].jobId == "init");
+        CHECK(queue->isComplete());
+        CHECK(queue->getProgress().getProgress() == doctest::Approx(1.0f));
+    }
+
+    TEST_CASE("a failed job fails its dependents without running them") {
+        auto queue = LoadJobQueue::create(2, "StartupGraphTestFailure");
+        REQUIRE(queue);
+
+        bool dependentRan = false;
+        std::vector<LoadJob> jobs;
+        jobs.push_back(makeJob("broken", {}, false));
+        LoadJob dependent = makeJob("dependent", {"broken"});
+        dependent.execute = [&dependentRan]() -> std::unique_ptr<StagedResource> {
+            dependentRan = true;
+            return std::make_unique<StagedBuffer>();
+        };
+        jobs.push_back(std::move(dependent));
+        jobs.push_back(makeJob("independent", {}));
+        queue->setTotalJobs(3);
+        queue->submitBatch(std::move(jobs));
+
+        auto results = collect(*queue, 3);
+        REQUIRE(results.size() == 3);
+        CHECK_FALSE(dependentRan);
+        for (const auto& result : results) {
+            CHECK(result.success == (result.jobId == "independent"));
+        }
+        CHECK(queue->isComplete());
+    }
+
+    TEST_CASE("unknown dependencies are dropped by validation") {
+        auto queue = LoadJobQueue::create(1, "StartupGraphTestUnknown");
+        REQUIRE(queue);
+
+        queue->setTotalJobs(1);
+        queue->submit(makeJob("orphan", {"never_submitted"}));
+        CHECK_FALSE(queue->isComplete());
+
+        CHECK(queue->validateDependencies() == 1);
+        auto results = collect(*queue, 1);
+        CHECK(hasResult(results, "orphan"));
+    }
+}
+
+TEST_SUITE("StartupTimeline") {
+    TEST_CASE("lanes become roots with their spans nested in time order") {
+        StartupTimeline& timeline = StartupTimeline::instance();
+        auto origin = StartupTimeline::Clock::now();
+        auto at = [origin](int ms) { return origin + std::chrono::milliseconds(ms); };
+
+        timeline.reset(origin);
+        timeline.record("Worker 1", "decode_b", at(0), at(30));
+        timeline.record("Worker 0", "decode_a", at(0), at(10));
+        timeline.record("Worker 0", "nested", at(2), at(4));
+        timeline.record("Main thread", "Terrain init", at(15), at(35));
+
+        FlamegraphCapture capture = timeline.buildFlamegraph();
+        REQUIRE(capture.roots.size() == 3);
+        CHECK(capture.roots[0].name == "Main thread");
+        CHECK(capture.roots[1].name == "Worker 0");
+        CHECK(capture.roots[2].name == "Worker 1");
+        CHECK(capture.totalTimeMs == doctest::Approx(35.0f));
+
+        const FlamegraphNode& worker0 = capture.roots[1];
+        REQUIRE(worker0.children.size() == 1);
+        CHECK(worker0.children[0].name == "decode_a");
+        REQUIRE(worker0.children[0].children.size() == 1);
+        CHECK(worker0.children[0].children[0].name == "nested");
+        CHECK(worker0.children[0].children[0].startMs == doctest::Approx(2.0f));
+
+        // Terrain colour hint comes from FlamegraphBuilder
+        CHECK(capture.roots[0].children[0].colorHint == FlamegraphColorHint::Terrain);
+
+        std::string folded = formatFoldedStacks(capture, "Loading");
+        CHECK(folded.find("Loading;Worker 0;decode_a 8000\n") != std::string::npos);
+        CHECK(folded.find("Loading;Worker 0;decode_a;nested 2000\n") != std::string::npos);
+
+        timeline.reset();
+    }
+}
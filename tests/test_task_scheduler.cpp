@@ -0,0 +1,148 @@
+// Tests for TaskScheduler pools - priority classes and concurrency caps
+// Uses the process-wide scheduler, so pool names are unique per test
+
+#include <doctest/doctest.h>
+#include "core/threading/TaskScheduler.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void waitFor(const std::atomic<uint32_t>& counter, uint32_t value) {
+    auto start = std::chrono::steady_clock::now();
+    while (counter.load() < value && std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// Occupies scheduler workers until released
+class WorkerBlocker {
+public:
+    WorkerBlocker(TaskScheduler& scheduler, TaskScheduler::PoolId pool, uint32_t count) {
+        for (uint32_t i = 0; i < count; ++i) {
+            scheduler.submit(pool, [this] {
+                started++;
+                while (!released.load()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }, &group);
+        }
+        waitFor(started, count);
+    }
+    ~WorkerBlocker() { release(); }
+
+    void release() {
+        released = true;
+        group.wait();
+    }
+
+    std::atomic<uint32_t> started{0};
+    std::atomic<bool> released{false};
+    TaskGroup group;
+};
+
+TaskScheduler& startedScheduler() {
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    scheduler.initialize(4);
+    return scheduler;
+}
+
+} // namespace
+
+TEST_SUITE("TaskScheduler") {
+    TEST_CASE("pool cap limits concurrent tasks") {
+        TaskScheduler& scheduler = startedScheduler();
+        REQUIRE(scheduler.getThreadCount() >= 2);
+        auto pool = scheduler.registerPool("TestCapped", TaskScheduler::Priority::Normal, 2);
+        CHECK(scheduler.getPoolConcurrency(pool) == 2);
+
+        std::atomic<uint32_t> running{0};
+        std::atomic<uint32_t> peak{0};
+        TaskGroup group;
+        for (int i = 0; i < 24; ++i) {
+            scheduler.submit(pool, [&] {
+                uint32_t now = ++running;
+                uint32_t current = peak.load();
+                while (now > current && !peak.compare_exchange_weak(current, now)) {}
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                --running;
+            }, &group);
+        }
+        group.wait();
+
+        CHECK(peak.load() <= 2);
+        for (const auto& stats : scheduler.getPoolStats()) {
+            if (stats.name == "TestCapped") {
+                CHECK(stats.completed == 24);
+                CHECK(stats.peakRunning <= 2);
+                CHECK(stats.queued == 0);
+                CHECK(stats.running == 0);
+                CHECK(stats.busyMs > 0.0f);
+            }
+        }
+    }
+
+    TEST_CASE("higher priority pools are served first") {
+        TaskScheduler& scheduler = startedScheduler();
+        auto blockerPool = scheduler.registerPool("TestBlocker", TaskScheduler::Priority::High, 0);
+        auto gatePool = scheduler.registerPool("TestGate", TaskScheduler::Priority::High, 0);
+        auto lowPool = scheduler.registerPool("TestLow", TaskScheduler::Priority::Low, 0);
+        auto highPool = scheduler.registerPool("TestHigh", TaskScheduler::Priority::High, 0);
+
+        // Every worker but one held until the end; the last one is freed once
+        // both pools have work, so it alone runs them in pick order
+        WorkerBlocker held(scheduler, blockerPool, scheduler.getThreadCount() - 1);
+        WorkerBlocker gate(scheduler, gatePool, 1);
+
+        std::mutex orderMutex;
+        std::vector<int> order;
+        TaskGroup group;
+        for (int i = 0; i < 3; ++i) {
+            scheduler.submit(lowPool, [&, i] {
+                std::lock_guard<std::mutex> lock(orderMutex);
+                order.push_back(10 + i);
+            }, &group);
+        }
+        for (int i = 0; i < 3; ++i) {
+            scheduler.submit(highPool, [&, i] {
+                std::lock_guard<std::mutex> lock(orderMutex);
+                order.push_back(i);
+            }, &group);
+        }
+
+        gate.release();
+        group.wait();
+        held.release();
+        CHECK(order == (std::vector<int>{0, 1, 2, 10, 11, 12}));
+    }
+
+    TEST_CASE("registering an existing name updates it") {
+        TaskScheduler& scheduler = startedScheduler();
+        auto first = scheduler.registerPool("TestRename", TaskScheduler::Priority::Low, 1);
+        auto second = scheduler.registerPool("TestRename", TaskScheduler::Priority::High, 3);
+        CHECK(first == second);
+        CHECK(scheduler.getPoolConcurrency(first) == std::min(3u, scheduler.getThreadCount()));
+
+        // Uncapped pools can use every worker
+        auto uncapped = scheduler.registerPool("TestUncapped", TaskScheduler::Priority::Normal, 0);
+        CHECK(scheduler.getPoolConcurrency(uncapped) == scheduler.getThreadCount());
+    }
+
+    TEST_CASE("general submit and ScopedTaskGroup run every task") {
+        TaskScheduler& scheduler = startedScheduler();
+        auto pool = scheduler.registerPool("TestScoped", TaskScheduler::Priority::Normal, 1);
+
+        std::atomic<uint32_t> count{0};
+        {
+            ScopedTaskGroup scoped(scheduler);
+            for (int i = 0; i < 16; ++i) {
+                scoped.submit([&] { count++; }, TaskScheduler::Priority::High);
+                scoped.submit(pool, [&] { count++; });
+            }
+        }
+        CHECK(count.load() == 32);
+    }
+}
@@ -0,0 +1,311 @@
+// Tests for ThreadProfiler - per-thread event rings and the frame collector
+// No Vulkan dependencies
+
+#include <doctest/doctest.h>
+#include "debug/ThreadProfiler.h"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Event = ThreadProfiler::Event;
+using EventKind = ThreadProfiler::EventKind;
+using ThreadEvents = ThreadProfiler::ThreadEvents;
+using ZoneId = ThreadProfiler::ZoneId;
+
+constexpr uint64_t MS = 1000000;
+
+ZoneId zone(const char* name) {
+    return ThreadProfiler::instance().internName(name);
+}
+
+Event begin(const char* name, uint64_t ms) { return {ms * MS, zone(name), EventKind::Begin}; }
+Event end(const char* name, uint64_t ms) { return {ms * MS, zone(name), EventKind::End}; }
+
+ThreadEvents lane(uint32_t index, const char* name, std::vector<Event> events) {
+    ThreadEvents thread;
+    thread.lane = index;
+    thread.threadName = name;
+    thread.events = std::move(events);
+    return thread;
+}
+
+// Discard whatever earlier tests left in the rings
+void drainAll() {
+    std::vector<ThreadEvents> discard;
+    ThreadProfiler::instance().drain(discard);
+}
+
+const ThreadEvents* findLane(const std::vector<ThreadEvents>& threads, uint32_t index) {
+    for (const auto& thread : threads) {
+        if (thread.lane == index) return &thread;
+    }
+    return nullptr;
+}
+
+struct EnableScope {
+    bool previous = ThreadProfiler::isEnabled();
+    explicit EnableScope(bool enabled) { ThreadProfiler::setEnabled(enabled); }
+    ~EnableScope() { ThreadProfiler::setEnabled(previous); }
+};
+
+} // namespace
+
+TEST_SUITE("ThreadProfiler") {
+    TEST_CASE("names intern to stable ids") {
+        ThreadProfiler& profiler = ThreadProfiler::instance();
+        ZoneId a = profiler.intern("Test:Intern");
+        CHECK(profiler.intern("Test:Intern") == a);
+        CHECK(profiler.internName(std::string("Test:") + "Intern") == a);
+        CHECK(profiler.internName("Test:Other") != a);
+        CHECK(profiler.zoneName(a) == "Test:Intern");
+    }
+
+    TEST_CASE("recorded zones drain from the calling thread's lane") {
+        EnableScope enable(true);
+        ThreadProfiler& profiler = ThreadProfiler::instance();
+        drainAll();
+
+        profiler.beginZone("Test:Outer");
+        {
+            PROFILE_THREAD_ZONE("Test:Inner");
+        }
+        profiler.endZone("Test:Outer");
+
+        std::vector<ThreadEvents> threads;
+        profiler.drain(threads);
+        const ThreadEvents* self = findLane(threads, profiler.currentLane());
+        REQUIRE(self != nullptr);
+        REQUIRE(self->events.size() == 4);
+        CHECK(self->events[0].kind == EventKind::Begin);
+        CHECK(self->events[0].zone == zone("Test:Outer"));
+        CHECK(self->events[1].zone == zone("Test:Inner"));
+        CHECK(self->events[2].kind == EventKind::End);
+        CHECK(self->events[3].zone == zone("Test:Outer"));
+        CHECK(self->events[0].timestampNs <= self->events[3].timestampNs);
+
+        // Drained events are gone
+        profiler.drain(threads);
+        CHECK(findLane(threads, profiler.currentLane())->events.empty());
+    }
+
+    TEST_CASE("disabled recording leaves the rings untouched") {
+        EnableScope enable(false);
+        ThreadProfiler& profiler = ThreadProfiler::instance();
+        drainAll();
+
+        profiler.beginZone("Test:Disabled");
+        {
+            PROFILE_THREAD_ZONE("Test:DisabledScoped");
+        }
+        profiler.endZone("Test:Disabled");
+
+        std::vector<ThreadEvents> threads;
+        profiler.drain(threads);
+        for (const auto& thread : threads) {
+            CHECK(thread.events.empty());
+        }
+    }
+
+    TEST_CASE("a full ring counts dropped events instead of blocking") {
+        EnableScope enable(true);
+        ThreadProfiler& profiler = ThreadProfiler::instance();
+        drainAll();
+
+        const size_t pairs = ThreadProfiler::RING_CAPACITY / 2 + 100;
+        for (size_t i = 0; i < pairs; ++i) {
+            profiler.beginZone("Test:Flood");
+            profiler.endZone("Test:Flood");
+        }
+
+        std::vector<ThreadEvents> threads;
+        profiler.drain(threads);
+        const ThreadEvents* self = findLane(threads, profiler.currentLane());
+        REQUIRE(self != nullptr);
+        CHECK(self->events.size() == ThreadProfiler::RING_CAPACITY);
+        CHECK(self->dropped == 200);
+
+        // Space is handed back after a drain
+        profiler.beginZone("Test:Flood");
+        profiler.endZone("Test:Flood");
+        profiler.drain(threads);
+        CHECK(findLane(threads, profiler.currentLane())->events.size() == 2);
+        CHECK(findLane(threads, profiler.currentLane())->dropped == 0);
+    }
+
+    TEST_CASE("worker threads get their own named lanes") {
+        EnableScope enable(true);
+        ThreadProfiler& profiler = ThreadProfiler::instance();
+        drainAll();
+
+        constexpr int WORKERS = 4;
+        constexpr int ZONES = 500;
+        std::vector<uint32_t> lanes(WORKERS);
+        std::vector<std::thread> threads;
+        for (int w = 0; w < WORKERS; ++w) {
+            threads.emplace_back([&profiler, &lanes, w] {
+                profiler.setThreadName("TestWorker " + std::to_string(w));
+                lanes[w] = profiler.currentLane();
+                for (int i = 0; i < ZONES; ++i) {
+                    PROFILE_THREAD_ZONE("Test:WorkerTask");
+                }
+            });
+        }
+
+        // Collect concurrently with the writers, then once more after they finish
+        std::vector<ThreadEvents> drained;
+        size_t total = 0;
+        for (int i = 0; i < 10; ++i) {
+            profiler.drain(drained);
+            for (const auto& thread : drained) total += thread.events.size();
+        }
+        for (auto& thread : threads) thread.join();
+        profiler.drain(drained);
+        for (const auto& thread : drained) total += thread.events.size();
+        CHECK(total == WORKERS * ZONES * 2);
+
+        std::sort(lanes.begin(), lanes.end());
+        CHECK(std::unique(lanes.begin(), lanes.end()) == lanes.end());
+        CHECK(std::find(lanes.begin(), lanes.end(), profiler.currentLane()) == lanes.end());
+
+        // Lanes outlive their threads and keep their names
+        for (int w = 0; w < WORKERS; ++w) {
+            bool named = std::any_of(drained.begin(), drained.end(), [w](const ThreadEvents& thread) {
+                return thread.threadName == "TestWorker " + std::to_string(w);
+            });
+            CHECK(named);
+        }
+    }
+}
+
+TEST_SUITE("ThreadProfileCollector") {
+    const ThreadProfiler& profiler = ThreadProfiler::instance();
+
+    TEST_CASE("main lane builds nested roots and per-zone totals") {
+        ThreadProfileCollector collector;
+        ThreadProfileCollector::FrameResult result;
+
+        collector.collect({lane(0, "Main", {
+                              begin("Update", 101), begin("Physics", 102), end("Physics", 104),
+                              begin("Physics", 105), end("Physics", 106), end("Update", 108),
+                              begin("Wait:FenceWait", 108), end("Wait:FenceWait", 110)})},
+                          profiler, 0, 100 * MS, 112 * MS, true, result);
+
+        CHECK(result.capture.totalTimeMs == doctest::Approx(12.0f));
+        REQUIRE(result.capture.roots.size() == 2);
+        const FlamegraphNode& update = result.capture.roots[0];
+        CHECK(update.name == "Update");
+        CHECK(update.startMs == doctest::Approx(1.0f));
+        CHECK(update.durationMs == doctest::Approx(7.0f));
+        REQUIRE(update.children.size() == 2);
+        CHECK(update.children[1].startMs == doctest::Approx(5.0f));
+        CHECK(result.capture.roots[1].isWaitZone);
+        CHECK(result.capture.lanes.empty());
+
+        // Totals follow first-begin order even though Physics ended first
+        REQUIRE(result.mainTotals.size() == 3);
+        CHECK(result.mainTotals[0].zone == zone("Update"));
+        CHECK(result.mainTotals[0].ms == doctest::Approx(7.0f));
+        CHECK(result.mainTotals[1].zone == zone("Physics"));
+        CHECK(result.mainTotals[1].ms == doctest::Approx(3.0f));
+        CHECK(result.mainTotals[2].zone == zone("Wait:FenceWait"));
+    }
+
+    TEST_CASE("recursive zones are counted once in the totals") {
+        ThreadProfileCollector collector;
+        ThreadProfileCollector::FrameResult result;
+
+        collector.collect({lane(0, "Main", {
+                              begin("Recurse", 0), begin("Recurse", 1), end("Recurse", 2), end("Recurse", 4)})},
+                          profiler, 0, 0, 5 * MS, true, result);
+
+        REQUIRE(result.mainTotals.size() == 1);
+        CHECK(result.mainTotals[0].ms == doctest::Approx(4.0f));
+        REQUIRE(result.capture.roots.size() == 1);
+        CHECK(result.capture.roots[0].children.size() == 1);
+    }
+
+    TEST_CASE("zones spanning frames are reported when they end, clipped to the frame") {
+        ThreadProfileCollector collector;
+        ThreadProfileCollector::FrameResult result;
+
+        // Frame 1: a worker task starts near the end and is still running
+        collector.collect({lane(0, "Main", {}),
+                           lane(1, "Worker 0", {begin("Streaming", 9), begin("Decode", 9)})},
+                          profiler, 0, 0, 10 * MS, true, result);
+        CHECK(result.capture.lanes.empty());
+
+        // Frame 2: it finishes; only the part inside this frame is shown
+        collector.collect({lane(0, "Main", {}),
+                           lane(1, "Worker 0", {end("Decode", 12), end("Streaming", 13)})},
+                          profiler, 0, 10 * MS, 20 * MS, true, result);
+        REQUIRE(result.capture.lanes.size() == 1);
+        const FlamegraphLane& worker = result.capture.lanes[0];
+        CHECK(worker.threadName == "Worker 0");
+        CHECK(worker.lane == 1);
+        REQUIRE(worker.roots.size() == 1);
+        CHECK(worker.roots[0].name == "Streaming");
+        CHECK(worker.roots[0].startMs == doctest::Approx(0.0f));
+        CHECK(worker.roots[0].durationMs == doctest::Approx(3.0f));
+        REQUIRE(worker.roots[0].children.size() == 1);
+        CHECK(worker.roots[0].children[0].durationMs == doctest::Approx(2.0f));
+    }
+
+    TEST_CASE("unmatched ends are ignored and unterminated children close with their parent") {
+        ThreadProfileCollector collector;
+        ThreadProfileCollector::FrameResult result;
+
+        collector.collect({lane(0, "Main", {
+                              end("Orphan", 1), begin("Outer", 2), begin("Leaked", 3), end("Outer", 6)})},
+                          profiler, 0, 0, 10 * MS, true, result);
+
+        REQUIRE(result.capture.roots.size() == 1);
+        CHECK(result.capture.roots[0].name == "Outer");
+        REQUIRE(result.capture.roots[0].children.size() == 1);
+        CHECK(result.capture.roots[0].children[0].durationMs == doctest::Approx(3.0f));
+        REQUIRE(result.mainTotals.size() == 1);
+        CHECK(result.mainTotals[0].zone == zone("Outer"));
+    }
+
+    TEST_CASE("totals are still produced without trees") {
+        ThreadProfileCollector collector;
+        ThreadProfileCollector::FrameResult result;
+
+        collector.collect({lane(0, "Main", {begin("Update", 0), end("Update", 2)}),
+                           lane(1, "Worker 0", {begin("Task", 0), end("Task", 1)})},
+                          profiler, 0, 0, 4 * MS, false, result);
+
+        CHECK(result.capture.roots.empty());
+        CHECK(result.capture.lanes.empty());
+        REQUIRE(result.mainTotals.size() == 1);
+        CHECK(result.mainTotals[0].ms == doctest::Approx(2.0f));
+    }
+
+    TEST_CASE("per-zone overhead") {
+        ThreadProfiler& recorder = ThreadProfiler::instance();
+        constexpr int ITERATIONS = 4000;     // Fits the ring: no drops while timing
+        using Clock = std::chrono::steady_clock;
+
+        auto measure = [&recorder](bool enabled) {
+            EnableScope enable(enabled);
+            drainAll();
+            auto start = Clock::now();
+            for (int i = 0; i < ITERATIONS; ++i) {
+                PROFILE_THREAD_ZONE("Bench:Zone");
+            }
+            auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            std::vector<ThreadEvents> threads;
+            recorder.drain(threads);
+            return elapsed / ITERATIONS;
+        };
+
+        measure(true);  // Warm the thread's ring registration
+        double enabledNs = measure(true);
+        double disabledNs = measure(false);
+        MESSAGE("Per zone (begin + end): enabled " << enabledNs << " ns, disabled " << disabledNs << " ns");
+        CHECK(enabledNs > 0.0);
+    }
+}
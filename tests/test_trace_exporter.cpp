@@ -0,0 +1,237 @@
+// Tests for TraceExporter - Chrome Trace Event JSON for frames and startup
+// No Vulkan dependencies
+
+#include <doctest/doctest.h>
+#include "debug/TraceExporter.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr uint64_t MS = 1000000;
+
+FlamegraphNode node(const char* name, float startMs, float durationMs, std::vector<FlamegraphNode> children = {}) {
+    FlamegraphNode n;
+    n.name = name;
+    n.startMs = startMs;
+    n.durationMs = durationMs;
+    n.children = std::move(children);
+    return n;
+}
+
+TraceExporter::Frame frame(uint64_t number, uint64_t startNs) {
+    TraceExporter::Frame f;
+    f.frameNumber = number;
+    f.startNs = startNs;
+    f.cpu.totalTimeMs = 16.0f;
+    f.cpu.roots = {node("Update", 0.0f, 4.0f, {node("Physics", 1.0f, 2.0f)}),
+                   node("Wait:FenceWait", 4.0f, 8.0f)};
+    f.cpu.lanes.push_back({"Worker 0", 3, {node("General (high)", 0.5f, 3.0f, {node("Shadow", 0.5f, 3.0f)})}});
+    f.gpu.totalTimeMs = 10.0f;
+    f.gpu.roots = {node("Shadow", 0.0f, 3.0f), node("HDR", 3.0f, 7.0f, {node("HDR:Sky", 3.0f, 1.0f)})};
+    f.counters = {{"NPC tiers", "Real", 4.0}, {"NPC tiers", "Virtual", 20.0}, {"Tiles in flight", "Grass", 2.0}};
+    return f;
+}
+
+json parse(const TraceExporter& exporter) {
+    json trace = json::parse(exporter.toJson());     // Throws on malformed output
+    REQUIRE(trace.is_object());
+    REQUIRE(trace.contains("traceEvents"));
+    REQUIRE(trace["traceEvents"].is_array());
+    return trace;
+}
+
+std::vector<json> eventsOf(const json& trace, const std::string& phase) {
+    std::vector<json> out;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == phase) out.push_back(event);
+    }
+    return out;
+}
+
+std::string threadName(const json& trace, int pid, int tid) {
+    for (const auto& event : eventsOf(trace, "M")) {
+        if (event["name"] == "thread_name" && event["pid"] == pid && event["tid"] == tid) {
+            return event["args"]["name"];
+        }
+    }
+    return {};
+}
+
+} // namespace
+
+TEST_SUITE("TraceExporter") {
+    TEST_CASE("every event carries the fields viewers require") {
+        TraceExporter exporter;
+        exporter.addFrame(frame(10, 1000 * MS));
+        exporter.addFrame(frame(11, 1016 * MS));
+        json trace = parse(exporter);
+
+        CHECK(trace["displayTimeUnit"] == "ms");
+        for (const auto& event : trace["traceEvents"]) {
+            REQUIRE(event.contains("ph"));
+            REQUIRE(event["ph"].is_string());
+            CHECK(event["pid"].is_number_integer());
+            CHECK(event["tid"].is_number_integer());
+            CHECK(event["name"].is_string());
+
+            std::string phase = event["ph"];
+            CHECK((phase == "X" || phase == "M" || phase == "C"));
+            if (phase == "X") {
+                CHECK(event["ts"].is_number());
+                CHECK(event["dur"].is_number());
+                CHECK(event["dur"].get<double>() >= 0.0);
+                CHECK(event["ts"].get<double>() >= 0.0);
+            } else if (phase == "C") {
+                CHECK(event["args"].is_object());
+            }
+        }
+    }
+
+    TEST_CASE("complete events nest properly on every thread") {
+        TraceExporter exporter;
+        for (uint64_t i = 0; i < 4; ++i) {
+            exporter.addFrame(frame(i, (100 + 16 * i) * MS));
+        }
+        json trace = parse(exporter);
+
+        // Chrome's rule for X events: on one thread, spans either nest or don't overlap
+        std::map<std::pair<int, int>, std::vector<std::pair<double, double>>> byThread;
+        for (const auto& event : eventsOf(trace, "X")) {
+            double ts = event["ts"];
+            byThread[{event["pid"], event["tid"]}].push_back({ts, ts + event["dur"].get<double>()});
+        }
+        for (auto& [thread, spans] : byThread) {
+            std::sort(spans.begin(), spans.end(), [](const auto& a, const auto& b) {
+                return a.first != b.first ? a.first < b.first : a.second > b.second;
+            });
+            std::vector<double> openEnds;
+            for (const auto& [start, end] : spans) {
+                while (!openEnds.empty() && openEnds.back() <= start + 1e-6) openEnds.pop_back();
+                if (!openEnds.empty()) {
+                    CHECK(end <= openEnds.back() + 1e-6);
+                }
+                openEnds.push_back(end);
+            }
+        }
+    }
+
+    TEST_CASE("frames, zones, lanes, GPU and counters are placed on the frame's timeline") {
+        TraceExporter exporter;
+        exporter.addFrame(frame(7, 500 * MS));
+        exporter.addFrame(frame(8, 520 * MS));
+        json trace = parse(exporter);
+
+        std::map<std::string, std::vector<json>> named;
+        for (const auto& event : eventsOf(trace, "X")) {
+            named[event["name"]].push_back(event);
+        }
+
+        REQUIRE(named["Frame 8"].size() == 1);
+        CHECK(named["Frame 8"][0]["ts"].get<double>() == doctest::Approx(20000.0));
+        CHECK(named["Frame 8"][0]["dur"].get<double>() == doctest::Approx(16000.0));
+
+        // Zone start is relative to the frame's start
+        REQUIRE(named["Physics"].size() == 2);
+        CHECK(named["Physics"][1]["ts"].get<double>() == doctest::Approx(21000.0));
+        CHECK(named["Physics"][1]["tid"] == 0);
+
+        // Worker lane gets its own named thread
+        REQUIRE(named["Shadow"].size() == 4);      // 2 CPU lane + 2 GPU
+        int workerTid = -1;
+        for (const auto& event : named["Shadow"]) {
+            if (event["pid"] == 1) workerTid = event["tid"];
+        }
+        CHECK(workerTid == 4);
+        CHECK(threadName(trace, 1, workerTid) == "Worker 0");
+        CHECK(threadName(trace, 1, 0) == "Frame thread");
+
+        // GPU zones in their own process, children inside their parent
+        REQUIRE(named["HDR:Sky"].size() == 2);
+        CHECK(named["HDR:Sky"][0]["pid"] == 2);
+        CHECK(threadName(trace, 2, 0) == "Graphics queue");
+
+        // Counters grouped by track with one arg per series
+        std::vector<json> counters = eventsOf(trace, "C");
+        CHECK(counters.size() == 4);
+        bool foundTiers = false;
+        for (const auto& counter : counters) {
+            if (counter["name"] == "NPC tiers" && counter["ts"].get<double>() > 0.0) {
+                foundTiers = true;
+                CHECK(counter["args"]["Real"].get<double>() == doctest::Approx(4.0));
+                CHECK(counter["args"]["Virtual"].get<double>() == doctest::Approx(20.0));
+            }
+        }
+        CHECK(foundTiers);
+    }
+
+    TEST_CASE("startup phases and loader lanes share the time base with frames") {
+        TraceExporter exporter;
+        FlamegraphCapture init;
+        init.totalTimeMs = 200.0f;
+        init.roots = {node("Renderer", 0.0f, 150.0f, {node("Terrain", 10.0f, 100.0f)}), node("Physics", 150.0f, 50.0f)};
+
+        exporter.setStartup(1000 * MS, init, {
+            {"Main thread", "Upload terrain", 1050 * MS, 1080 * MS},
+            {"Worker 2", "Decode heightmap", 1010 * MS, 1050 * MS},
+            {"Worker 2", "Decode tiles", 1050 * MS, 1070 * MS}});
+        exporter.addFrame(frame(1, 1300 * MS));
+        CHECK(exporter.hasStartup());
+        json trace = parse(exporter);
+
+        std::map<std::string, json> named;
+        for (const auto& event : eventsOf(trace, "X")) named[event["name"]] = event;
+
+        CHECK(named["Renderer"]["pid"] == 3);
+        CHECK(named["Renderer"]["ts"].get<double>() == doctest::Approx(0.0));
+        CHECK(named["Terrain"]["ts"].get<double>() == doctest::Approx(10000.0));
+        CHECK(named["Decode heightmap"]["ts"].get<double>() == doctest::Approx(10000.0));
+        CHECK(named["Decode heightmap"]["dur"].get<double>() == doctest::Approx(40000.0));
+        CHECK(named["Decode tiles"]["tid"] == named["Decode heightmap"]["tid"]);
+        CHECK(named["Upload terrain"]["tid"] != named["Decode heightmap"]["tid"]);
+        CHECK(threadName(trace, 3, named["Decode tiles"]["tid"]) == "Worker 2");
+        CHECK(named["Frame 1"]["ts"].get<double>() == doctest::Approx(300000.0));
+    }
+
+    TEST_CASE("the ring keeps only the most recent frames") {
+        TraceExporter exporter(3);
+        for (uint64_t i = 0; i < 5; ++i) {
+            exporter.addFrame(frame(i, i * 16 * MS));
+        }
+        CHECK(exporter.getFrameCount() == 3);
+        json trace = parse(exporter);
+
+        std::vector<std::string> frames;
+        for (const auto& event : eventsOf(trace, "X")) {
+            if (event["cat"] == "frame" && event["pid"] == 1) frames.push_back(event["name"]);
+        }
+        const std::vector<std::string> expected = {"Frame 2", "Frame 3", "Frame 4"};
+        CHECK(frames == expected);
+        CHECK(trace["otherData"]["frames"] == 3);
+
+        exporter.setCapacity(1);
+        CHECK(exporter.getFrameCount() == 1);
+        exporter.clear();
+        CHECK(exporter.getFrameCount() == 0);
+        CHECK_FALSE(exporter.hasStartup());
+    }
+
+    TEST_CASE("names are escaped") {
+        TraceExporter exporter;
+        TraceExporter::Frame f = frame(1, 0);
+        f.cpu.roots = {node("Load \"town\\square\"\n", 0.0f, 1.0f)};
+        exporter.addFrame(std::move(f));
+        json trace = parse(exporter);
+
+        bool found = false;
+        for (const auto& event : eventsOf(trace, "X")) {
+            if (event["name"] == "Load \"town\\square\"\n") found = true;
+        }
+        CHECK(found);
+    }
+}
@@ -0,0 +1,85 @@
+#include <doctest/doctest.h>
+#include "ecs/Systems.h"
+#include <glm/glm.hpp>
+
+using namespace ecs;
+
+namespace {
+
+Entity createNode(World& world, const glm::vec3& position, Entity parent = NullEntity) {
+    Entity entity = world.create();
+    world.add<LocalTransform>(entity, LocalTransform::fromPosition(position));
+    world.add<Transform>(entity);
+    if (parent != NullEntity) world.add<Parent>(entity, parent);
+    return entity;
+}
+
+glm::vec3 worldPosition(World& world, Entity entity) {
+    return world.get<Transform>(entity).position();
+}
+
+} // namespace
+
+TEST_CASE("TransformSystem - patched LocalTransform updates its subtree") {
+    World world;
+    Entity root = createNode(world, glm::vec3(1.0f, 0.0f, 0.0f));
+    Entity child = createNode(world, glm::vec3(0.0f, 1.0f, 0.0f), root);
+    Entity other = createNode(world, glm::vec3(0.0f, 0.0f, 3.0f));
+
+    systems::updateWorldTransforms(world);
+    CHECK(worldPosition(world, child) == glm::vec3(1.0f, 1.0f, 0.0f));
+
+    world.patch<LocalTransform>(root, [](LocalTransform& local) { local.position.x = 5.0f; });
+    systems::updateWorldTransforms(world);
+    CHECK(worldPosition(world, root) == glm::vec3(5.0f, 0.0f, 0.0f));
+    CHECK(worldPosition(world, child) == glm::vec3(5.0f, 1.0f, 0.0f));
+    CHECK(worldPosition(world, other) == glm::vec3(0.0f, 0.0f, 3.0f));
+}
+
+TEST_CASE("TransformSystem - parents outside the hierarchy are followed every update") {
+    World world;
+    Entity anchor = world.create();
+    world.add<Transform>(anchor, Transform::fromPosition(glm::vec3(100.0f, 0.0f, 0.0f)));
+    Entity child = createNode(world, glm::vec3(0.0f, 0.0f, 1.0f), anchor);
+
+    systems::updateWorldTransforms(world);
+    CHECK(worldPosition(world, child) == glm::vec3(100.0f, 0.0f, 1.0f));
+
+    // Plain Transform writes carry no change tracking
+    world.get<Transform>(anchor).setPosition(glm::vec3(200.0f, 0.0f, 0.0f));
+    systems::updateWorldTransforms(world);
+    CHECK(worldPosition(world, child) == glm::vec3(200.0f, 0.0f, 1.0f));
+}
+
+TEST_CASE("TransformSystem - bone attachments keep their Transform and drive children") {
+    World world;
+    Entity root = createNode(world, glm::vec3(1.0f, 0.0f, 0.0f));
+    Entity attached = createNode(world, glm::vec3(0.0f), root);
+    world.add<BoneAttachment>(attached);
+    world.get<Transform>(attached).setPosition(glm::vec3(0.0f, 50.0f, 0.0f));
+    Entity held = createNode(world, glm::vec3(0.0f, 0.0f, 2.0f), attached);
+
+    systems::updateWorldTransforms(world);
+    CHECK(worldPosition(world, attached) == glm::vec3(0.0f, 50.0f, 0.0f));
+    CHECK(worldPosition(world, held) == glm::vec3(0.0f, 50.0f, 2.0f));
+
+    world.get<Transform>(attached).setPosition(glm::vec3(0.0f, 60.0f, 0.0f));
+    systems::updateWorldTransforms(world);
+    CHECK(worldPosition(world, held) == glm::vec3(0.0f, 60.0f, 2.0f));
+}
+
+TEST_CASE("TransformSystem - reparenting recomputes the moved subtree") {
+    World world;
+    Entity a = createNode(world, glm::vec3(1.0f, 0.0f, 0.0f));
+    Entity b = createNode(world, glm::vec3(0.0f, 10.0f, 0.0f));
+    Entity child = createNode(world, glm::vec3(0.0f, 0.0f, 1.0f), a);
+    systems::updateWorldTransforms(world);
+
+    systems::attachToParent(world, child, b);
+    systems::updateWorldTransforms(world);
+    CHECK(worldPosition(world, child) == glm::vec3(0.0f, 10.0f, 1.0f));
+
+    systems::detachFromParent(world, child);
+    systems::updateWorldTransforms(world);
+    CHECK(worldPosition(world, child) == glm::vec3(0.0f, 10.0f, 1.0f));
+}
@@ -0,0 +1,163 @@
+#include <doctest/doctest.h>
+#include "vegetation/VegetationTileLoader.h"
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <random>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct TestTile {
+    glm::vec2 worldMin{-256.0f, 512.0f};
+    glm::vec2 worldMax{0.0f, 768.0f};
+    std::vector<VegetationTileType> types = {
+        {"oak_large", "oak_large"},
+        {"rock_medium", ""},
+    };
+    std::vector<VegetationTileInstance> instances;
+
+    explicit TestTile(size_t count) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> u(0.0f, 1.0f);
+        for (size_t i = 0; i < count; ++i) {
+            VegetationTileInstance inst;
+            inst.position = worldMin + glm::vec2(u(rng), u(rng)) * (worldMax - worldMin);
+            inst.rotation = u(rng) * 6.2831853f;
+            inst.scale = 0.64f + u(rng) * 1.16f;
+            inst.typeId = static_cast<uint8_t>(i % types.size());
+            inst.seed = static_cast<uint32_t>(rng());
+            instances.push_back(inst);
+        }
+    }
+
+    std::vector<uint8_t> encode() const {
+        return VegetationTileLoader::encode(-1, 2, worldMin, worldMax, types, instances);
+    }
+};
+
+} // namespace
+
+TEST_SUITE("VegetationTileLoader") {
+    TEST_CASE("getTilePath generates correct path") {
+        CHECK(VegetationTileLoader::getTilePath("/tiles", -3, 7) == "/tiles/tile_-3_7.vegt");
+    }
+
+    TEST_CASE("encode/parse round trip within quantization error") {
+        TestTile source(500);
+        std::vector<uint8_t> bytes = source.encode();
+        CHECK(bytes.size() % 4 == 0);
+
+        VegetationTileData tile;
+        REQUIRE(VegetationTileLoader::parse(bytes, tile));
+        CHECK(tile.tileX == -1);
+        CHECK(tile.tileZ == 2);
+        REQUIRE(tile.types.size() == 2);
+        CHECK(tile.types[0].name == "oak_large");
+        CHECK(tile.types[0].preset == "oak_large");
+        CHECK(tile.types[1].preset.empty());
+        REQUIRE(tile.getInstanceCount() == source.instances.size());
+        CHECK(tile.getPackedInstanceBytes() == source.instances.size() * 12);
+
+        // 256m tile / 65535 steps, 1.16 scale range / 255 steps
+        const float positionTolerance = 256.0f / 65535.0f;
+        const float scaleTolerance = 1.16f / 255.0f;
+        const float rotationTolerance = 6.2831853f / 65536.0f;
+        for (size_t i = 0; i < source.instances.size(); ++i) {
+            const auto& expected = source.instances[i];
+            VegetationTileInstance actual = tile.getInstance(i);
+            CHECK(std::abs(actual.position.x - expected.position.x) <= positionTolerance);
+            CHECK(std::abs(actual.position.y - expected.position.y) <= positionTolerance);
+            CHECK(std::abs(actual.scale - expected.scale) <= scaleTolerance);
+            float dr = std::abs(actual.rotation - expected.rotation);
+            CHECK(std::min(dr, 6.2831853f - dr) <= rotationTolerance);
+            CHECK(actual.typeId == expected.typeId);
+            CHECK(actual.seed == expected.seed);
+        }
+    }
+
+    TEST_CASE("packed instances are 4-byte aligned in the file") {
+        TestTile source(3);
+        std::vector<uint8_t> bytes = source.encode();
+        VegetationTileHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        CHECK(header.instanceOffset % 4 == 0);
+        CHECK(bytes.size() == header.instanceOffset + 3 * sizeof(VegetationPackedInstance));
+    }
+
+    TEST_CASE("empty tile round trips") {
+        TestTile source(0);
+        VegetationTileData tile;
+        REQUIRE(VegetationTileLoader::parse(source.encode(), tile));
+        CHECK(tile.getInstanceCount() == 0);
+        CHECK(tile.types.size() == 2);
+    }
+
+    TEST_CASE("parse rejects bad magic, version and truncated files") {
+        TestTile source(10);
+        std::vector<uint8_t> bytes = source.encode();
+        VegetationTileData tile;
+
+        std::vector<uint8_t> badMagic = bytes;
+        badMagic[0] ^= 0xFF;
+        CHECK_FALSE(VegetationTileLoader::parse(badMagic, tile));
+
+        std::vector<uint8_t> badVersion = bytes;
+        badVersion[4] = 99;
+        CHECK_FALSE(VegetationTileLoader::parse(badVersion, tile));
+
+        std::vector<uint8_t> truncated(bytes.begin(), bytes.end() - 1);
+        CHECK_FALSE(VegetationTileLoader::parse(truncated, tile));
+
+        std::vector<uint8_t> headerOnly(bytes.begin(), bytes.begin() + 20);
+        CHECK_FALSE(VegetationTileLoader::parse(headerOnly, tile));
+    }
+
+    TEST_CASE("type ids must index the type table") {
+        TestTile source(10);
+        std::vector<uint8_t> bytes = source.encode();
+        VegetationTileHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        VegetationTileData tile;
+        REQUIRE(VegetationTileLoader::parse(bytes, tile));
+
+        std::vector<uint8_t> badType = bytes;
+        size_t last = header.instanceOffset + 9 * sizeof(VegetationPackedInstance);
+        badType[last + offsetof(VegetationPackedInstance, typeId)] = static_cast<uint8_t>(source.types.size());
+        CHECK_FALSE(VegetationTileLoader::parse(badType, tile));
+
+        // Encoding refuses what parse would reject, and what a byte can't hold
+        TestTile outOfRange(4);
+        outOfRange.instances[2].typeId = 7;
+        CHECK(outOfRange.encode().empty());
+
+        TestTile tooManyTypes(4);
+        tooManyTypes.types.resize(VegetationTileLoader::MAX_TYPES + 1, {"grass", ""});
+        CHECK(tooManyTypes.encode().empty());
+        tooManyTypes.types.resize(VegetationTileLoader::MAX_TYPES);
+        CHECK(VegetationTileLoader::parse(tooManyTypes.encode(), tile));
+        CHECK(tile.types.size() == VegetationTileLoader::MAX_TYPES);
+    }
+
+    TEST_CASE("save and load through a file") {
+        fs::path dir = fs::temp_directory_path() / "vulkan_game_tests_vegt";
+        fs::create_directories(dir);
+        TestTile source(64);
+
+        std::string path = VegetationTileLoader::getTilePath(dir.string(), -1, 2);
+        REQUIRE(VegetationTileLoader::save(path, -1, 2, source.worldMin, source.worldMax,
+                                           source.types, source.instances));
+
+        VegetationTileData tile;
+        REQUIRE(VegetationTileLoader::load(path, tile));
+        CHECK(tile.getInstanceCount() == 64);
+        CHECK(tile.getInstance(5).seed == source.instances[5].seed);
+
+        CHECK_FALSE(VegetationTileLoader::load((dir / "missing.vegt").string(), tile));
+
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+    }
+}
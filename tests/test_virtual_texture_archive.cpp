@@ -0,0 +1,293 @@
+// Tests for VirtualTextureArchive - packed tile archive read/write
+// No Vulkan dependencies
+
+#include <doctest/doctest.h>
+#include "terrain/virtual_texture/VirtualTextureArchive.h"
+#include "terrain/virtual_texture/VirtualTextureTileLoader.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+using namespace VirtualTexture;
+namespace fs = std::filesystem;
+
+namespace {
+
+// Deterministic tile contents so reads can be checked byte for byte
+std::vector<uint8_t> makePayload(TileId id, size_t size) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(id.pack() * 31u + i);
+    }
+    return data;
+}
+
+class TempArchiveDirectory {
+public:
+    TempArchiveDirectory() {
+        path = fs::temp_directory_path() / ("vt_archive_test_" + std::to_string(std::time(nullptr)));
+        fs::create_directories(path);
+    }
+    ~TempArchiveDirectory() {
+        std::error_code ec;
+        fs::remove_all(path, ec);
+    }
+    std::string archivePath() const { return (path / VirtualTextureArchive::FILE_NAME).string(); }
+
+    fs::path path;
+};
+
+} // namespace
+
+TEST_SUITE("VirtualTextureArchive") {
+    TEST_CASE("tiles round trip across the mip chain") {
+        TempArchiveDirectory dir;
+        const uint32_t tilesPerAxis = 4;
+        const uint32_t mipCount = 3;
+        const size_t bc1Size = 32 * 32 / 2;  // 32x32 BC1
+
+        {
+            VirtualTextureArchiveWriter writer;
+            REQUIRE(writer.open(dir.archivePath(), TileFormat::BC1_SRGB, 32, 32, tilesPerAxis, mipCount));
+            // Write out of order, skipping one tile at mip 0
+            for (int mip = mipCount - 1; mip >= 0; --mip) {
+                uint32_t perAxis = tilesPerAxis >> mip;
+                for (uint16_t y = 0; y < perAxis; ++y) {
+                    for (uint16_t x = 0; x < perAxis; ++x) {
+                        TileId id(x, y, static_cast<uint8_t>(mip));
+                        if (id == TileId(2, 1, 0)) continue;
+                        auto payload = makePayload(id, bc1Size);
+                        REQUIRE(writer.writeTile(id, payload.data(), payload.size()));
+                    }
+                }
+            }
+            CHECK_FALSE(writer.writeTile(TileId(4, 0, 0), "x", 1));
+            CHECK_FALSE(writer.writeTile(TileId(0, 0, 3), "x", 1));
+            REQUIRE(writer.finish());
+        }
+
+        auto archive = VirtualTextureArchive::open(dir.archivePath());
+        REQUIRE(archive != nullptr);
+        CHECK(archive->getTileFormat() == TileFormat::BC1_SRGB);
+        CHECK(archive->getMipCount() == mipCount);
+        CHECK(archive->getEntryCount() == 16 + 4 + 1);
+        CHECK(archive->getPresentTileCount() == 20);
+
+        LoadedTile tile;
+        REQUIRE(archive->readTile(TileId(3, 3, 0), tile));
+        CHECK(tile.id == TileId(3, 3, 0));
+        CHECK(tile.width == 32);
+        CHECK(tile.height == 32);
+        CHECK(tile.format == TileFormat::BC1_SRGB);
+        CHECK(tile.pixels == makePayload(TileId(3, 3, 0), bc1Size));
+
+        REQUIRE(archive->readTile(TileId(0, 0, 2), tile));
+        CHECK(tile.pixels == makePayload(TileId(0, 0, 2), bc1Size));
+
+        CHECK_FALSE(archive->hasTile(TileId(2, 1, 0)));
+        CHECK_FALSE(archive->readTile(TileId(2, 1, 0), tile));
+        CHECK_FALSE(archive->hasTile(TileId(2, 0, 1)));   // Outside mip 1 grid
+        CHECK_FALSE(archive->hasTile(TileId(0, 0, 5)));   // Beyond mip count
+    }
+
+    TEST_CASE("payloads start on the alignment boundary") {
+        TempArchiveDirectory dir;
+        VirtualTextureArchiveWriter writer;
+        REQUIRE(writer.open(dir.archivePath(), TileFormat::RGBA8, 4, 4, 2, 1));
+        for (uint16_t i = 0; i < 4; ++i) {
+            auto payload = makePayload(TileId(i % 2, i / 2, 0), 100 + i);
+            REQUIRE(writer.writeTile(TileId(i % 2, i / 2, 0), payload.data(), payload.size()));
+        }
+        CHECK(writer.getPayloadBytes() == 100 + 101 + 102 + 103);
+        REQUIRE(writer.finish());
+
+        std::FILE* file = std::fopen(dir.archivePath().c_str(), "rb");
+        REQUIRE(file != nullptr);
+        ArchiveHeader header{};
+        REQUIRE(std::fread(&header, sizeof(header), 1, file) == 1);
+        CHECK(header.payloadOffset % VirtualTextureArchive::PAYLOAD_ALIGNMENT == 0);
+
+        std::vector<ArchiveEntry> entries(header.entryCount);
+        std::fseek(file, static_cast<long>(header.entriesOffset), SEEK_SET);
+        REQUIRE(std::fread(entries.data(), sizeof(ArchiveEntry), entries.size(), file) == entries.size());
+        std::fclose(file);
+
+        for (const auto& entry : entries) {
+            CHECK(entry.offset >= header.payloadOffset);
+            CHECK(entry.offset % VirtualTextureArchive::PAYLOAD_ALIGNMENT == 0);
+            CHECK(entry.codec == static_cast<uint16_t>(ArchiveCodec::Raw));
+        }
+    }
+
+    TEST_CASE("rejects missing and invalid files") {
+        TempArchiveDirectory dir;
+        CHECK(VirtualTextureArchive::open(dir.archivePath()) == nullptr);
+
+        std::FILE* file = std::fopen(dir.archivePath().c_str(), "wb");
+        REQUIRE(file != nullptr);
+        std::vector<uint8_t> garbage(256, 0xAB);
+        std::fwrite(garbage.data(), 1, garbage.size(), file);
+        std::fclose(file);
+        CHECK(VirtualTextureArchive::open(dir.archivePath()) == nullptr);
+    }
+
+    TEST_CASE("rejects corrupt and truncated archives") {
+        TempArchiveDirectory dir;
+        const size_t tileBytes = 8 * 8 * 4;
+        auto writeArchive = [&]() {
+            VirtualTextureArchiveWriter writer;
+            REQUIRE(writer.open(dir.archivePath(), TileFormat::RGBA8, 8, 8, 2, 2));
+            for (uint16_t i = 0; i < 4; ++i) {
+                TileId id(i % 2, i / 2, 0);
+                auto payload = makePayload(id, tileBytes);
+                REQUIRE(writer.writeTile(id, payload.data(), payload.size()));
+            }
+            REQUIRE(writer.finish());
+        };
+        auto readHeader = [&]() {
+            ArchiveHeader header{};
+            std::FILE* file = std::fopen(dir.archivePath().c_str(), "rb");
+            REQUIRE(file != nullptr);
+            REQUIRE(std::fread(&header, sizeof(header), 1, file) == 1);
+            std::fclose(file);
+            return header;
+        };
+        auto patch = [&](uint64_t offset, const void* data, size_t size) {
+            std::FILE* file = std::fopen(dir.archivePath().c_str(), "r+b");
+            REQUIRE(file != nullptr);
+            std::fseek(file, static_cast<long>(offset), SEEK_SET);
+            std::fwrite(data, 1, size, file);
+            std::fclose(file);
+        };
+        auto patchHeader = [&](const ArchiveHeader& header) { patch(0, &header, sizeof(header)); };
+        auto patchEntry = [&](uint32_t index, const ArchiveEntry& entry) {
+            patch(readHeader().entriesOffset + index * sizeof(ArchiveEntry), &entry, sizeof(entry));
+        };
+
+        SUBCASE("huge table counts fail instead of allocating") {
+            writeArchive();
+            ArchiveHeader header = readHeader();
+            header.mipCount = 0x7FFFFFFF;
+            patchHeader(header);
+            CHECK(VirtualTextureArchive::open(dir.archivePath()) == nullptr);
+
+            header.mipCount = 2;
+            header.entryCount = 0xFFFFFFFF;
+            patchHeader(header);
+            CHECK(VirtualTextureArchive::open(dir.archivePath()) == nullptr);
+
+            header.entryCount = 5;
+            header.entriesOffset = ~0ull;
+            patchHeader(header);
+            CHECK(VirtualTextureArchive::open(dir.archivePath()) == nullptr);
+        }
+
+        SUBCASE("truncated entry table") {
+            writeArchive();
+            ArchiveHeader header = readHeader();
+            fs::resize_file(dir.archivePath(), header.entriesOffset + sizeof(ArchiveEntry));
+            CHECK(VirtualTextureArchive::open(dir.archivePath()) == nullptr);
+        }
+
+        SUBCASE("bad tile layout") {
+            writeArchive();
+            ArchiveHeader header = readHeader();
+            header.tileFormat = 99;
+            patchHeader(header);
+            CHECK(VirtualTextureArchive::open(dir.archivePath()) == nullptr);
+
+            header.tileFormat = static_cast<uint32_t>(TileFormat::RGBA8);
+            header.tileWidth = 1u << 20;
+            patchHeader(header);
+            CHECK(VirtualTextureArchive::open(dir.archivePath()) == nullptr);
+        }
+
+        SUBCASE("entries that aren't exactly one tile inside the file") {
+            writeArchive();
+            {
+                auto archive = VirtualTextureArchive::open(dir.archivePath());
+                REQUIRE(archive != nullptr);
+                CHECK(VirtualTextureArchive::tileByteSize(TileFormat::RGBA8, 8, 8) == tileBytes);
+            }
+
+            ArchiveHeader header = readHeader();
+            ArchiveEntry shortEntry{header.payloadOffset, static_cast<uint32_t>(tileBytes / 2),
+                                    static_cast<uint16_t>(ArchiveCodec::Raw), 0};
+            patchEntry(0, shortEntry);
+            ArchiveEntry hugeEntry{header.payloadOffset, 0xFFFFFFF0u, static_cast<uint16_t>(ArchiveCodec::Raw), 0};
+            patchEntry(1, hugeEntry);
+            ArchiveEntry pastEnd{fs::file_size(dir.archivePath()), static_cast<uint32_t>(tileBytes),
+                                 static_cast<uint16_t>(ArchiveCodec::Raw), 0};
+            patchEntry(2, pastEnd);
+
+            auto archive = VirtualTextureArchive::open(dir.archivePath());
+            REQUIRE(archive != nullptr);
+            LoadedTile tile;
+            uint64_t offset = 0;
+            uint32_t size = 0;
+            CHECK_FALSE(archive->readTile(TileId(0, 0, 0), tile));
+            CHECK_FALSE(archive->locateTile(TileId(1, 0, 0), offset, size));
+            CHECK_FALSE(archive->readTile(TileId(0, 1, 0), tile));
+            REQUIRE(archive->readTile(TileId(1, 1, 0), tile));
+            CHECK(tile.pixels == makePayload(TileId(1, 1, 0), tileBytes));
+        }
+
+        SUBCASE("tile layout the cache can't use") {
+            writeArchive();
+            VirtualTextureArchive::Requirements requirements;
+            requirements.tileWidth = 8;
+            requirements.tileHeight = 8;
+            requirements.formats = {TileFormat::RGBA8};
+            CHECK(VirtualTextureArchive::open(dir.archivePath(), requirements) != nullptr);
+
+            requirements.tileWidth = requirements.tileHeight = 16;
+            CHECK(VirtualTextureArchive::open(dir.archivePath(), requirements) == nullptr);
+
+            requirements.tileWidth = requirements.tileHeight = 8;
+            requirements.formats = {TileFormat::BC1};
+            CHECK(VirtualTextureArchive::open(dir.archivePath(), requirements) == nullptr);
+
+            // The loader falls back to loose files rather than feed the cache wrong-sized tiles
+            auto loader = VirtualTextureTileLoader::create(dir.path.string(), 1, false, 16);
+            REQUIRE(loader != nullptr);
+            CHECK_FALSE(loader->isUsingArchive());
+            auto matching = VirtualTextureTileLoader::create(dir.path.string(), 1, false, 8);
+            REQUIRE(matching != nullptr);
+            CHECK(matching->isUsingArchive());
+        }
+    }
+
+    TEST_CASE("tile loader reads from the archive") {
+        TempArchiveDirectory dir;
+        {
+            VirtualTextureArchiveWriter writer;
+            REQUIRE(writer.open(dir.archivePath(), TileFormat::RGBA8, 8, 8, 2, 2));
+            auto payload = makePayload(TileId(1, 0, 0), 8 * 8 * 4);
+            REQUIRE(writer.writeTile(TileId(1, 0, 0), payload.data(), payload.size()));
+            REQUIRE(writer.finish());
+        }
+
+        auto loader = VirtualTextureTileLoader::create(dir.path.string(), 1);
+        REQUIRE(loader != nullptr);
+        CHECK(loader->isUsingArchive());
+
+        loader->queueTile(TileId(1, 0, 0));
+        auto start = std::chrono::steady_clock::now();
+        while (loader->getLoadedCount() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            if (std::chrono::steady_clock::now() - start > std::chrono::seconds(5)) {
+                FAIL("Timeout waiting for tile to load");
+                break;
+            }
+        }
+
+        auto loaded = loader->getLoadedTiles();
+        REQUIRE(loaded.size() == 1);
+        CHECK(loaded[0].width == 8);
+        CHECK(loaded[0].format == TileFormat::RGBA8);
+        CHECK(loaded[0].pixels == makePayload(TileId(1, 0, 0), 8 * 8 * 4));
+        CHECK(loader->getTilesLoadedFromArchive() == 1);
+        CHECK(loader->getTilesLoadedFromLooseFiles() == 0);
+    }
+}
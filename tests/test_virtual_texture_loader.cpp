@@ -3,14 +3,23 @@
 
 #include <doctest/doctest.h>
 #include "terrain/virtual_texture/VirtualTextureTileLoader.h"
+#include "terrain/virtual_texture/VirtualTextureBC1Encoder.h"
 #include <lodepng.h>
 #include <filesystem>
 #include <thread>
 #include <chrono>
+#include <cstdlib>
 
 using namespace VirtualTexture;
 namespace fs = std::filesystem;
 
+// Loads run on the shared scheduler. Without running workers, queued tiles
+// load synchronously and the queue/cancel/priority tests would see nothing.
+[[maybe_unused]] static const bool schedulerStarted = [] {
+    TaskScheduler::instance().initialize(4);
+    return true;
+}();
+
 // Helper class to create temporary tile directories for testing
 class TempTileDirectory {
 public:
@@ -324,8 +333,9 @@ TEST_SUITE("VirtualTextureTileLoader Loading") {
         REQUIRE(tempDir.createTile(0, 0, 0));
         REQUIRE(tempDir.createTile(1, 0, 0));
 
-        // Use single worker to ensure predictable ordering
-        auto loader = VirtualTextureTileLoader::create(tempDir.getPath(), 1);
+        // Paused until the cancel is in, then a single worker: tile2 can't
+        // have started loading before it was cancelled
+        auto loader = VirtualTextureTileLoader::create(tempDir.getPath(), 0);
         REQUIRE(loader != nullptr);
 
         TileId tile1(0, 0, 0);
@@ -334,6 +344,7 @@ TEST_SUITE("VirtualTextureTileLoader Loading") {
         loader->queueTile(tile1);
         loader->queueTile(tile2);
         loader->cancelTile(tile2);  // Cancel second tile
+        loader->setMaxConcurrentLoads(1);
 
         // Wait for loading to complete
         std::this_thread::sleep_for(std::chrono::milliseconds(200));
@@ -367,8 +378,9 @@ TEST_SUITE("VirtualTextureTileLoader Priority") {
             REQUIRE(tempDir.createTile(i, 0, 0, 32, 32));
         }
 
-        // Use single worker for predictable ordering
-        auto loader = VirtualTextureTileLoader::create(tempDir.getPath(), 1);
+        // Queue while paused so the first tile can't start before the rest
+        // are queued, then load with a single worker for predictable ordering
+        auto loader = VirtualTextureTileLoader::create(tempDir.getPath(), 0);
         REQUIRE(loader != nullptr);
 
         // Queue with different priorities (lower value = higher priority)
@@ -377,6 +389,8 @@ TEST_SUITE("VirtualTextureTileLoader Priority") {
         loader->queueTile(TileId(2, 0, 0), 10);   // High
         loader->queueTile(TileId(3, 0, 0), 1);    // Higher
         loader->queueTile(TileId(4, 0, 0), 0);    // Highest
+        CHECK(loader->getPendingCount() == 5);
+        loader->setMaxConcurrentLoads(1);
 
         // Wait for all to load
         auto start = std::chrono::steady_clock::now();
@@ -444,6 +458,138 @@ TEST_SUITE("VirtualTextureTileLoader Callback") {
     }
 }
 
+// ============================================================================
+// VirtualTextureTileLoader BC1 Transcode Tests
+// ============================================================================
+
+namespace {
+
+// Wait until the loader has produced `count` tiles (or timeout)
+std::vector<LoadedTile> waitForTiles(VirtualTextureTileLoader& loader, size_t count) {
+    std::vector<LoadedTile> result;
+    auto start = std::chrono::steady_clock::now();
+    while (result.size() < count) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        for (auto& tile : loader.getLoadedTiles()) {
+            result.push_back(std::move(tile));
+        }
+        if (std::chrono::steady_clock::now() - start > std::chrono::seconds(5)) break;
+    }
+    return result;
+}
+
+// Decode color0 endpoint of a BC1 block to 8-bit RGB
+void decodeEndpoint0(const uint8_t* block, int rgb[3]) {
+    uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+    rgb[0] = ((c0 >> 11) & 0x1F) * 255 / 31;
+    rgb[1] = ((c0 >> 5) & 0x3F) * 255 / 63;
+    rgb[2] = (c0 & 0x1F) * 255 / 31;
+}
+
+} // namespace
+
+TEST_SUITE("VirtualTextureTileLoader BC1 Transcode") {
+    TEST_CASE("BC1 encoder output size rounds up to whole blocks") {
+        CHECK(BC1Encoder::compressedSize(128, 128) == 32 * 32 * 8);
+        CHECK(BC1Encoder::compressedSize(130, 70) == 33 * 18 * 8);
+
+        std::vector<uint8_t> rgba(6 * 5 * 4, 200);
+        std::vector<uint8_t> bc1;
+        REQUIRE(BC1Encoder::encode(rgba.data(), 6, 5, bc1));
+        CHECK(bc1.size() == BC1Encoder::compressedSize(6, 5));
+
+        CHECK_FALSE(BC1Encoder::encode(nullptr, 4, 4, bc1));
+    }
+
+    TEST_CASE("BC1 encoder preserves solid colors") {
+        uint8_t block[64];
+        for (int i = 0; i < 16; ++i) {
+            block[i * 4 + 0] = 200;
+            block[i * 4 + 1] = 100;
+            block[i * 4 + 2] = 40;
+            block[i * 4 + 3] = 255;
+        }
+        uint8_t out[8];
+        BC1Encoder::encodeBlock(block, out);
+
+        int rgb[3];
+        decodeEndpoint0(out, rgb);
+        CHECK(std::abs(rgb[0] - 200) <= 8);
+        CHECK(std::abs(rgb[1] - 100) <= 4);
+        CHECK(std::abs(rgb[2] - 40) <= 8);
+
+        // Solid block: both endpoints equal, all indices select color0
+        CHECK(out[4] == 0);
+        CHECK(out[5] == 0);
+        CHECK(out[6] == 0);
+        CHECK(out[7] == 0);
+    }
+
+    TEST_CASE("PNG tiles are transcoded to BC1 when enabled") {
+        TempTileDirectory tempDir;
+        REQUIRE(tempDir.createTile(3, 7, 0, 64, 64));
+
+        auto loader = VirtualTextureTileLoader::create(tempDir.getPath(), 2, true);
+        REQUIRE(loader != nullptr);
+        CHECK(loader->isTranscodingToBC1());
+
+        loader->queueTile(TileId(3, 7, 0));
+        auto loaded = waitForTiles(*loader, 1);
+        REQUIRE(loaded.size() == 1);
+
+        const LoadedTile& tile = loaded[0];
+        CHECK(tile.format == TileFormat::BC1_SRGB);
+        CHECK(tile.isCompressed());
+        CHECK(tile.width == 64);
+        CHECK(tile.height == 64);
+        CHECK(tile.pixels.size() == 16 * 16 * 8);
+
+        // Test tile color is (x, y, mip * 20) = (3, 7, 0)
+        int rgb[3];
+        decodeEndpoint0(tile.pixels.data(), rgb);
+        CHECK(rgb[0] <= 8);
+        CHECK(rgb[1] <= 8);
+        CHECK(rgb[2] <= 8);
+
+        CHECK(loader->getTotalTilesTranscoded() == 1);
+        CHECK(loader->getTotalBytesSavedByTranscode() == 64 * 64 * 4 - 16 * 16 * 8);
+        CHECK(loader->getTotalBytesLoaded() == 16 * 16 * 8);
+        CHECK(loader->getAverageTranscodeMicros() >= 0.0);
+    }
+
+    TEST_CASE("placeholder tiles are transcoded when enabled") {
+        TempTileDirectory tempDir;
+
+        auto loader = VirtualTextureTileLoader::create(tempDir.getPath(), 1, true);
+        REQUIRE(loader != nullptr);
+
+        loader->queueTile(TileId(42, 42, 0));
+        auto loaded = waitForTiles(*loader, 1);
+        REQUIRE(loaded.size() == 1);
+
+        CHECK(loaded[0].format == TileFormat::BC1_SRGB);
+        CHECK(loaded[0].pixels.size() == BC1Encoder::compressedSize(128, 128));
+    }
+
+    TEST_CASE("transcode counters stay zero when disabled") {
+        TempTileDirectory tempDir;
+        REQUIRE(tempDir.createTile(0, 0, 0, 32, 32));
+
+        auto loader = VirtualTextureTileLoader::create(tempDir.getPath(), 1);
+        REQUIRE(loader != nullptr);
+        CHECK_FALSE(loader->isTranscodingToBC1());
+
+        loader->queueTile(TileId(0, 0, 0));
+        auto loaded = waitForTiles(*loader, 1);
+        REQUIRE(loaded.size() == 1);
+
+        CHECK(loaded[0].format == TileFormat::RGBA8);
+        CHECK(loader->getTotalTilesTranscoded() == 0);
+        CHECK(loader->getTotalBytesSavedByTranscode() == 0);
+        CHECK(loader->getAverageTranscodeMicros() == 0.0);
+    }
+}
+
 // ============================================================================
 // VirtualTextureTileLoader Stress Tests
 // ============================================================================
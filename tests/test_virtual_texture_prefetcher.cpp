@@ -0,0 +1,353 @@
+// Tests for VirtualTexturePrefetcher - camera extrapolation and headless
+// replay of recorded camera paths with and without prefetch
+// No Vulkan dependencies
+
+#include <doctest/doctest.h>
+#include "terrain/virtual_texture/VirtualTexturePrefetcher.h"
+#include "terrain/virtual_texture/VirtualTextureFeedbackRecording.h"
+#include "terrain/virtual_texture/VirtualTextureSlotAllocator.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace VirtualTexture;
+
+namespace {
+
+constexpr float WORLD_SIZE = 16384.0f;
+
+PrefetchCamera makeCamera(glm::vec3 position, float yaw, float pitch) {
+    PrefetchCamera camera;
+    camera.position = position;
+    camera.forward = glm::vec3(std::cos(pitch) * std::cos(yaw), std::sin(pitch), std::cos(pitch) * std::sin(yaw));
+    camera.fovY = 1.0f;
+    camera.aspect = 16.0f / 9.0f;
+    camera.viewportHeight = 1080.0f;
+    camera.groundHeight = 0.0f;
+    return camera;
+}
+
+// What the GPU feedback pass would want this frame: cast a coarse grid of
+// screen rays at a flat ground plane and pick mips from ray-to-ray
+// derivatives, as vtCalculateMipLevel does with dFdx/dFdy
+std::vector<TileId> visibleTiles(const PrefetchCamera& camera, const VirtualTextureConfig& vt) {
+    constexpr int GRID_W = 96;
+    constexpr int GRID_H = 54;
+    const float pixelsPerCell = camera.viewportHeight / GRID_H;
+    const float texelWorld = WORLD_SIZE / static_cast<float>(vt.virtualSizePixels);
+    const float tanY = std::tan(camera.fovY * 0.5f);
+    const float tanX = tanY * camera.aspect;
+
+    glm::vec3 forward = glm::normalize(camera.forward);
+    glm::vec3 right = glm::normalize(glm::cross(forward, glm::vec3(0.0f, 1.0f, 0.0f)));
+    glm::vec3 up = glm::cross(right, forward);
+
+    auto hit = [&](float i, float j, glm::vec3& out) {
+        float x = (i / GRID_W) * 2.0f - 1.0f;
+        float y = 1.0f - (j / GRID_H) * 2.0f;
+        glm::vec3 dir = forward + right * (x * tanX) + up * (y * tanY);
+        if (dir.y >= -1e-4f) return false;
+        float t = (camera.groundHeight - camera.position.y) / dir.y;
+        out = camera.position + dir * t;
+        return true;
+    };
+
+    std::vector<TileId> tiles;
+    std::unordered_set<uint32_t> seen;
+    for (int j = 0; j < GRID_H; ++j) {
+        for (int i = 0; i < GRID_W; ++i) {
+            glm::vec3 p, px, py;
+            if (!hit(i + 0.5f, j + 0.5f, p) || !hit(i + 1.5f, j + 0.5f, px) || !hit(i + 0.5f, j + 1.5f, py)) {
+                continue;
+            }
+            glm::vec2 uv(p.x / WORLD_SIZE, p.z / WORLD_SIZE);
+            if (uv.x < 0.0f || uv.y < 0.0f || uv.x >= 1.0f || uv.y >= 1.0f) continue;
+
+            glm::vec2 dx = glm::vec2(px.x - p.x, px.z - p.z) / (pixelsPerCell * texelWorld);
+            glm::vec2 dy = glm::vec2(py.x - p.x, py.z - p.z) / (pixelsPerCell * texelWorld);
+            float maxDerivSq = std::max(glm::dot(dx, dx), glm::dot(dy, dy));
+            float mipF = 0.5f * std::log2(std::max(maxDerivSq, 1.0f));
+            uint32_t mip = std::min(static_cast<uint32_t>(mipF + 0.5f), vt.maxMipLevels - 1);
+
+            uint32_t tilesAtMip = vt.getTilesAtMip(mip);
+            TileId id(static_cast<uint16_t>(uv.x * tilesAtMip), static_cast<uint16_t>(uv.y * tilesAtMip),
+                      static_cast<uint8_t>(mip));
+            if (seen.insert(id.pack()).second) {
+                tiles.push_back(id);
+            }
+        }
+    }
+    return tiles;
+}
+
+struct ReplayStats {
+    uint64_t visibleTiles = 0;
+    uint64_t demandMisses = 0;
+    uint64_t prefetchLoads = 0;
+
+    double missRate() const {
+        return visibleTiles > 0 ? static_cast<double>(demandMisses) / static_cast<double>(visibleTiles) : 0.0;
+    }
+};
+
+// Mirrors VirtualTextureSystem: feedback arrives FEEDBACK_LATENCY frames
+// late, demand requests are queued at priority = mip, prefetch behind them
+// under the prefetcher's budget, and the loader completes LOADS_PER_FRAME
+// tiles per frame after LOAD_LATENCY frames
+ReplayStats replay(const std::vector<PrefetchCamera>& path, bool prefetch) {
+    constexpr uint32_t CACHE_SLOTS = 1024;
+    constexpr uint32_t FEEDBACK_LATENCY = 2;
+    constexpr uint32_t LOAD_LATENCY = 2;
+    constexpr uint32_t LOADS_PER_FRAME = 24;
+    constexpr uint32_t MAX_REQUESTS_PER_FRAME = 64;
+    constexpr int PREFETCH_PRIORITY = 1000;
+    constexpr uint32_t PREFETCH_MIN_EVICT_AGE = 60;
+
+    VirtualTextureConfig vt;
+    VirtualTexturePrefetcher::Config prefetchConfig;
+    prefetchConfig.worldSize = WORLD_SIZE;
+    prefetchConfig.demandQueueLimit = MAX_REQUESTS_PER_FRAME / 2;
+    VirtualTexturePrefetcher prefetcher(vt, prefetchConfig);
+    VirtualTextureSlotAllocator cache(CACHE_SLOTS);
+
+    std::unordered_map<uint32_t, int> loaderQueue;          // packed -> priority
+    std::deque<std::pair<uint32_t, uint32_t>> inFlight;     // packed, ready frame
+    std::unordered_set<uint32_t> pending;                   // queued or in flight
+    std::unordered_set<uint32_t> prefetched;
+    std::deque<std::vector<TileId>> feedbackPipe;
+    ReplayStats stats;
+
+    for (uint32_t frame = 1; frame <= path.size(); ++frame) {
+        const PrefetchCamera& camera = path[frame - 1];
+
+        // Loads finishing this frame become resident
+        while (!inFlight.empty() && inFlight.front().second <= frame) {
+            cache.allocate(TileId::unpack(inFlight.front().first), frame);
+            pending.erase(inFlight.front().first);
+            inFlight.pop_front();
+        }
+
+        // Render: everything visible but not resident is a demand miss. As in
+        // sampleVirtualTexture, feedback is written only for non-resident
+        // tiles, walking up the mip chain until a resident fallback is found;
+        // resident hits are invisible to the CPU
+        std::vector<TileId> misses;
+        std::unordered_set<uint32_t> written;
+        for (const TileId& id : visibleTiles(camera, vt)) {
+            stats.visibleTiles++;
+            if (cache.contains(id)) continue;
+            stats.demandMisses++;
+            TileId level = id;
+            while (!cache.contains(level) && written.insert(level.pack()).second) {
+                misses.push_back(level);
+                if (level.mipLevel + 1u >= vt.maxMipLevels) break;
+                level = TileId(level.x >> 1, level.y >> 1, static_cast<uint8_t>(level.mipLevel + 1));
+            }
+        }
+        feedbackPipe.push_back(std::move(misses));
+
+        // CPU side: process feedback from FEEDBACK_LATENCY frames ago
+        std::vector<TileId> requested;
+        if (feedbackPipe.size() > FEEDBACK_LATENCY) {
+            requested = std::move(feedbackPipe.front());
+            feedbackPipe.pop_front();
+        }
+        std::sort(requested.begin(), requested.end(),
+                  [](TileId a, TileId b) { return a.mipLevel > b.mipLevel; });
+
+        // Resident fallbacks of requested tiles were sampled
+        for (const TileId& id : requested) {
+            TileId ancestor = id;
+            while (ancestor.mipLevel + 1u < vt.maxMipLevels) {
+                ancestor = TileId(ancestor.x >> 1, ancestor.y >> 1, static_cast<uint8_t>(ancestor.mipLevel + 1));
+                if (cache.touch(ancestor, frame)) break;
+            }
+        }
+
+        uint32_t demandQueued = 0;
+        for (const TileId& id : requested) {
+            if (demandQueued >= MAX_REQUESTS_PER_FRAME) break;
+            uint32_t packed = id.pack();
+            if (cache.contains(id)) continue;
+            if (pending.count(packed)) {
+                auto it = loaderQueue.find(packed);
+                if (prefetched.erase(packed) && it != loaderQueue.end()) {
+                    it->second = std::min(it->second, static_cast<int>(id.mipLevel));
+                }
+                continue;
+            }
+            loaderQueue[packed] = static_cast<int>(id.mipLevel);
+            pending.insert(packed);
+            demandQueued++;
+        }
+
+        prefetcher.updateCamera(camera);
+        prefetcher.addFeedback(requested);
+        if (prefetch) {
+            uint32_t budget = prefetcher.getBudget(demandQueued, static_cast<uint32_t>(loaderQueue.size()));
+            uint32_t queued = 0;
+            for (const TileId& id : prefetcher.predict()) {
+                if (queued >= budget) break;
+                uint32_t packed = id.pack();
+                if (cache.contains(id) || pending.count(packed)) continue;
+                uint32_t lru = cache.getLRUSlot();
+                bool canEvict = cache.getUsedSlotCount() < cache.getSlotCount() ||
+                                (lru != VirtualTextureSlotAllocator::INVALID_SLOT &&
+                                 cache.getSlot(lru).lastUsedFrame + PREFETCH_MIN_EVICT_AGE < frame);
+                if (!canEvict) break;
+                loaderQueue[packed] = PREFETCH_PRIORITY + static_cast<int>(id.mipLevel);
+                pending.insert(packed);
+                prefetched.insert(packed);
+                queued++;
+            }
+            stats.prefetchLoads += queued;
+        }
+
+        // Loader workers: highest priority first
+        std::vector<std::pair<int, uint32_t>> order;
+        for (const auto& [packed, priority] : loaderQueue) order.emplace_back(priority, packed);
+        std::sort(order.begin(), order.end());
+        for (uint32_t i = 0; i < order.size() && i < LOADS_PER_FRAME; ++i) {
+            inFlight.emplace_back(order[i].second, frame + LOAD_LATENCY);
+            loaderQueue.erase(order[i].second);
+        }
+    }
+    return stats;
+}
+
+// Record a camera path the way VirtualTextureSystem does and read it back
+std::vector<PrefetchCamera> recordAndLoad(const std::vector<PrefetchCamera>& path, const char* name) {
+    auto file = (std::filesystem::temp_directory_path() / (std::string("vulkan_game_tests_") + name + ".vtcam")).string();
+    {
+        CameraPathRecording recording;
+        REQUIRE(recording.open(file));
+        for (const auto& camera : path) recording.appendFrame(camera);
+    }
+    std::vector<PrefetchCamera> loaded;
+    REQUIRE(CameraPathRecording::load(file, loaded));
+    std::filesystem::remove(file);
+    return loaded;
+}
+
+void reportReplay(const char* name, const std::vector<PrefetchCamera>& path, ReplayStats& without, ReplayStats& with) {
+    auto recorded = recordAndLoad(path, name);
+    REQUIRE(recorded.size() == path.size());
+    without = replay(recorded, false);
+    with = replay(recorded, true);
+    MESSAGE(name << ": demand-miss rate " << without.missRate() * 100.0 << "% without prefetch, "
+                 << with.missRate() * 100.0 << "% with prefetch (" << with.prefetchLoads << " prefetch loads)");
+}
+
+} // namespace
+
+TEST_SUITE("VirtualTexturePrefetcher") {
+    TEST_CASE("still camera produces no candidates") {
+        VirtualTexturePrefetcher prefetcher{VirtualTextureConfig{}};
+        for (int i = 0; i < 5; ++i) {
+            prefetcher.updateCamera(makeCamera(glm::vec3(8000.0f, 30.0f, 8000.0f), 0.0f, -0.3f));
+        }
+        CHECK(prefetcher.predict().empty());
+    }
+
+    TEST_CASE("extrapolates translation and yaw") {
+        VirtualTexturePrefetcher::Config config;
+        config.lookaheadFrames = 10.0f;
+        VirtualTexturePrefetcher prefetcher(VirtualTextureConfig{}, config);
+        for (int i = 0; i < 20; ++i) {
+            prefetcher.updateCamera(makeCamera(glm::vec3(8000.0f + i * 2.0f, 30.0f, 8000.0f), i * 0.01f, -0.2f));
+        }
+        PrefetchCamera predicted = prefetcher.getPredictedCamera();
+        CHECK(predicted.position.x == doctest::Approx(8038.0f + 20.0f).epsilon(0.01));
+        CHECK(std::atan2(predicted.forward.z, predicted.forward.x) == doctest::Approx(0.19f + 0.1f).epsilon(0.01));
+    }
+
+    TEST_CASE("teleport resets motion") {
+        VirtualTexturePrefetcher prefetcher{VirtualTextureConfig{}};
+        prefetcher.updateCamera(makeCamera(glm::vec3(100.0f, 30.0f, 100.0f), 0.0f, -0.2f));
+        prefetcher.updateCamera(makeCamera(glm::vec3(105.0f, 30.0f, 100.0f), 0.0f, -0.2f));
+        prefetcher.updateCamera(makeCamera(glm::vec3(9000.0f, 30.0f, 9000.0f), 0.0f, -0.2f));
+        CHECK(prefetcher.getPredictedCamera().position.x == doctest::Approx(9000.0f));
+        CHECK(prefetcher.predict().empty());
+    }
+
+    TEST_CASE("mip estimate grows with distance and grazing angle") {
+        VirtualTexturePrefetcher prefetcher{VirtualTextureConfig{}};
+        CHECK(prefetcher.estimateMipLevel(2.0f, 2.0f, 1.0f, 1080.0f) == 0);
+        uint32_t near = prefetcher.estimateMipLevel(50.0f, 20.0f, 1.0f, 1080.0f);
+        uint32_t far = prefetcher.estimateMipLevel(500.0f, 20.0f, 1.0f, 1080.0f);
+        uint32_t farHigh = prefetcher.estimateMipLevel(500.0f, 200.0f, 1.0f, 1080.0f);
+        CHECK(far > near);
+        CHECK(farHigh < far);
+        CHECK(prefetcher.estimateMipLevel(100000.0f, 1.0f, 1.0f, 1080.0f) == VirtualTextureConfig{}.maxMipLevels - 1);
+    }
+
+    TEST_CASE("turning camera predicts tiles ahead of the turn") {
+        VirtualTextureConfig vt;
+        VirtualTexturePrefetcher prefetcher(vt);
+        for (int i = 0; i < 10; ++i) {
+            prefetcher.updateCamera(makeCamera(glm::vec3(8000.0f, 20.0f, 8000.0f), i * 0.04f, -0.25f));
+        }
+        const auto& candidates = prefetcher.predict();
+        REQUIRE_FALSE(candidates.empty());
+        CHECK(candidates.size() <= prefetcher.getConfig().maxCandidates);
+
+        // Candidates should overlap what the camera will actually see after
+        // the turn continues for the lookahead window
+        PrefetchCamera future = makeCamera(glm::vec3(8000.0f, 20.0f, 8000.0f),
+                                           (9 + prefetcher.getConfig().lookaheadFrames) * 0.04f, -0.25f);
+        auto futureTiles = visibleTiles(future, vt);
+        std::unordered_set<uint32_t> futureSet;
+        for (const auto& id : futureTiles) futureSet.insert(id.pack());
+        size_t overlap = 0;
+        for (const auto& id : candidates) overlap += futureSet.count(id.pack());
+        CHECK(overlap * 2 > candidates.size());
+    }
+
+    TEST_CASE("budget leaves loader capacity to demand") {
+        VirtualTexturePrefetcher prefetcher{VirtualTextureConfig{}};
+        const auto& config = prefetcher.getConfig();
+        CHECK(prefetcher.getBudget(0, 0) == config.maxPrefetchPerFrame);
+        CHECK(prefetcher.getBudget(config.demandQueueLimit, 0) == 0);
+        CHECK(prefetcher.getBudget(0, config.maxLoaderBacklog) == 0);
+        CHECK(prefetcher.getBudget(0, config.maxLoaderBacklog - 2) == 2);
+    }
+}
+
+TEST_SUITE("VirtualTexturePrefetcher replay") {
+    TEST_CASE("fast turn") {
+        std::vector<PrefetchCamera> path;
+        for (int i = 0; i < 300; ++i) {
+            path.push_back(makeCamera(glm::vec3(8000.0f, 20.0f, 8000.0f), i * 0.05f, -0.35f));
+        }
+        ReplayStats without, with;
+        reportReplay("fast turn", path, without, with);
+        CHECK(with.prefetchLoads > 0);
+        CHECK(with.missRate() < without.missRate());
+    }
+
+    TEST_CASE("flyover") {
+        std::vector<PrefetchCamera> path;
+        for (int i = 0; i < 300; ++i) {
+            float t = i / 60.0f;
+            path.push_back(makeCamera(glm::vec3(4000.0f + i * 5.0f, 80.0f + 20.0f * std::sin(t), 8000.0f + i * 1.5f),
+                                      0.3f, -0.35f));
+        }
+        ReplayStats without, with;
+        reportReplay("flyover", path, without, with);
+        CHECK(with.prefetchLoads > 0);
+        CHECK(with.missRate() < without.missRate());
+    }
+
+    TEST_CASE("slow walk is not made worse") {
+        std::vector<PrefetchCamera> path;
+        for (int i = 0; i < 300; ++i) {
+            path.push_back(makeCamera(glm::vec3(8000.0f + i * 0.05f, 2.0f, 8000.0f), 0.002f * i, -0.1f));
+        }
+        ReplayStats without, with;
+        reportReplay("slow walk", path, without, with);
+        CHECK(with.missRate() <= without.missRate() * 1.05 + 1e-6);
+    }
+}
@@ -0,0 +1,230 @@
+// Tests for VirtualTextureSlotAllocator - cache slot bookkeeping
+// No Vulkan dependencies
+
+#include <doctest/doctest.h>
+#include "terrain/virtual_texture/VirtualTextureSlotAllocator.h"
+#include "terrain/virtual_texture/VirtualTextureFeedbackRecording.h"
+#include <algorithm>
+#include <filesystem>
+#include <random>
+#include <unordered_map>
+
+using namespace VirtualTexture;
+
+namespace {
+
+// Straightforward model of the allocator: scan for the lowest free slot,
+// otherwise the unpinned slot touched longest ago (by touch sequence number)
+class ReferenceAllocator {
+public:
+    explicit ReferenceAllocator(uint32_t count) : slots(count), lastTouch(count, 0) {}
+
+    VirtualTextureSlotAllocator::Allocation allocate(TileId id, uint32_t frame) {
+        VirtualTextureSlotAllocator::Allocation result;
+        auto it = tileToSlot.find(id.pack());
+        if (it != tileToSlot.end()) {
+            touch(id, frame);
+            result.slotIndex = it->second;
+            return result;
+        }
+        uint32_t chosen = VirtualTextureSlotAllocator::INVALID_SLOT;
+        for (uint32_t i = 0; i < slots.size(); ++i) {
+            if (!slots[i].occupied) { chosen = i; break; }
+        }
+        if (chosen == VirtualTextureSlotAllocator::INVALID_SLOT) {
+            uint64_t oldest = UINT64_MAX;
+            for (uint32_t i = 0; i < slots.size(); ++i) {
+                if (!slots[i].pinned && lastTouch[i] < oldest) {
+                    oldest = lastTouch[i];
+                    chosen = i;
+                }
+            }
+            if (chosen == VirtualTextureSlotAllocator::INVALID_SLOT) return result;
+            result.evicted = true;
+            result.evictedTile = slots[chosen].tileId;
+            tileToSlot.erase(slots[chosen].tileId.pack());
+        }
+        slots[chosen] = CacheSlot{id, frame, true, false};
+        lastTouch[chosen] = ++sequence;
+        tileToSlot[id.pack()] = chosen;
+        result.slotIndex = chosen;
+        return result;
+    }
+
+    bool touch(TileId id, uint32_t frame) {
+        auto it = tileToSlot.find(id.pack());
+        if (it == tileToSlot.end()) return false;
+        slots[it->second].lastUsedFrame = frame;
+        lastTouch[it->second] = ++sequence;
+        return true;
+    }
+
+    bool pin(TileId id) {
+        auto it = tileToSlot.find(id.pack());
+        if (it == tileToSlot.end()) return false;
+        slots[it->second].pinned = true;
+        return true;
+    }
+
+    std::vector<CacheSlot> slots;
+    std::vector<uint64_t> lastTouch;
+    std::unordered_map<uint32_t, uint32_t> tileToSlot;
+    uint64_t sequence = 0;
+};
+
+} // namespace
+
+TEST_SUITE("VirtualTextureSlotAllocator") {
+    TEST_CASE("fills free slots in index order") {
+        VirtualTextureSlotAllocator allocator(4);
+        for (uint16_t i = 0; i < 4; ++i) {
+            auto a = allocator.allocate(TileId(i, 0, 0), 1);
+            CHECK(a.slotIndex == i);
+            CHECK_FALSE(a.evicted);
+        }
+        CHECK(allocator.getUsedSlotCount() == 4);
+        CHECK(allocator.find(TileId(2, 0, 0)) == 2);
+        CHECK(allocator.find(TileId(9, 0, 0)) == VirtualTextureSlotAllocator::INVALID_SLOT);
+    }
+
+    TEST_CASE("allocating a resident tile returns its slot") {
+        VirtualTextureSlotAllocator allocator(4);
+        allocator.allocate(TileId(1, 1, 0), 1);
+        auto again = allocator.allocate(TileId(1, 1, 0), 5);
+        CHECK(again.slotIndex == 0);
+        CHECK_FALSE(again.evicted);
+        CHECK(allocator.getUsedSlotCount() == 1);
+        CHECK(allocator.getSlot(0).lastUsedFrame == 5);
+    }
+
+    TEST_CASE("evicts the least recently touched tile") {
+        VirtualTextureSlotAllocator allocator(3);
+        allocator.allocate(TileId(0, 0, 0), 1);
+        allocator.allocate(TileId(1, 0, 0), 1);
+        allocator.allocate(TileId(2, 0, 0), 1);
+
+        CHECK(allocator.touch(TileId(0, 0, 0), 2));
+        CHECK_FALSE(allocator.touch(TileId(7, 0, 0), 2));
+
+        auto a = allocator.allocate(TileId(3, 0, 0), 3);
+        CHECK(a.evicted);
+        CHECK(a.evictedTile == TileId(1, 0, 0));
+        CHECK(a.slotIndex == 1);
+        CHECK_FALSE(allocator.contains(TileId(1, 0, 0)));
+        CHECK(allocator.getLRUSlot() == 2);
+    }
+
+    TEST_CASE("pinned tiles are never evicted") {
+        VirtualTextureSlotAllocator allocator(2);
+        allocator.allocate(TileId(0, 0, 8), 1);
+        allocator.allocate(TileId(1, 0, 0), 2);
+        CHECK(allocator.pin(TileId(0, 0, 8)));
+        CHECK(allocator.getPinnedSlotCount() == 1);
+        CHECK(allocator.getSlot(0).pinned);
+
+        for (uint16_t i = 2; i < 10; ++i) {
+            auto a = allocator.allocate(TileId(i, 0, 0), 2 + i);
+            CHECK(a.slotIndex == 1);
+        }
+        CHECK(allocator.contains(TileId(0, 0, 8)));
+
+        CHECK(allocator.pin(TileId(9, 0, 0)));
+        auto full = allocator.allocate(TileId(20, 0, 0), 20);
+        CHECK(full.slotIndex == VirtualTextureSlotAllocator::INVALID_SLOT);
+
+        CHECK(allocator.unpin(TileId(9, 0, 0)));
+        auto after = allocator.allocate(TileId(20, 0, 0), 21);
+        CHECK(after.slotIndex == 1);
+        CHECK(after.evictedTile == TileId(9, 0, 0));
+    }
+
+    TEST_CASE("release frees the slot for reuse") {
+        VirtualTextureSlotAllocator allocator(4);
+        for (uint16_t i = 0; i < 4; ++i) allocator.allocate(TileId(i, 0, 0), 1);
+        allocator.pin(TileId(3, 0, 0));
+
+        CHECK(allocator.release(TileId(2, 0, 0)));
+        CHECK(allocator.release(TileId(3, 0, 0)));
+        CHECK_FALSE(allocator.release(TileId(3, 0, 0)));
+        CHECK(allocator.getUsedSlotCount() == 2);
+        CHECK(allocator.getPinnedSlotCount() == 0);
+
+        auto a = allocator.allocate(TileId(5, 0, 0), 2);
+        CHECK(a.slotIndex == 2);
+        CHECK_FALSE(a.evicted);
+    }
+
+    TEST_CASE("matches reference LRU over a random workload") {
+        const uint32_t slotCount = 97;
+        VirtualTextureSlotAllocator allocator(slotCount);
+        ReferenceAllocator reference(slotCount);
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> coord(0, 31);
+        std::uniform_int_distribution<int> mip(0, 8);
+        std::uniform_int_distribution<int> op(0, 99);
+
+        for (uint32_t frame = 1; frame <= 400; ++frame) {
+            for (int i = 0; i < 50; ++i) {
+                TileId id(static_cast<uint16_t>(coord(rng)), static_cast<uint16_t>(coord(rng)),
+                          static_cast<uint8_t>(mip(rng)));
+                int o = op(rng);
+                if (o < 60) {
+                    REQUIRE(allocator.touch(id, frame) == reference.touch(id, frame));
+                } else if (o < 99) {
+                    auto a = allocator.allocate(id, frame);
+                    auto b = reference.allocate(id, frame);
+                    REQUIRE(a.slotIndex == b.slotIndex);
+                    REQUIRE(a.evicted == b.evicted);
+                    if (a.evicted) REQUIRE(a.evictedTile == b.evictedTile);
+                } else if (allocator.getPinnedSlotCount() < slotCount / 4) {
+                    REQUIRE(allocator.pin(id) == reference.pin(id));
+                }
+            }
+        }
+
+        // Every resident tile is found at the slot the reference has it in
+        for (const auto& [packed, slot] : reference.tileToSlot) {
+            CHECK(allocator.find(TileId::unpack(packed)) == slot);
+        }
+        CHECK(allocator.getUsedSlotCount() == reference.tileToSlot.size());
+    }
+
+    TEST_CASE("table survives heavy churn") {
+        VirtualTextureSlotAllocator allocator(64);
+        for (uint32_t i = 0; i < 20000; ++i) {
+            TileId id = TileId::unpack(i * 2654435761u & 0xFFFFF);
+            allocator.allocate(id, i);
+            REQUIRE(allocator.contains(id));
+        }
+        CHECK(allocator.getUsedSlotCount() == 64);
+        uint32_t found = 0;
+        for (uint32_t i = 20000 - 64; i < 20000; ++i) {
+            found += allocator.contains(TileId::unpack(i * 2654435761u & 0xFFFFF)) ? 1 : 0;
+        }
+        CHECK(found == 64);
+    }
+}
+
+TEST_SUITE("FeedbackRecording") {
+    TEST_CASE("frames round trip") {
+        auto path = (std::filesystem::temp_directory_path() / "vulkan_game_tests_feedback.vtfb").string();
+        {
+            FeedbackRecording recording;
+            REQUIRE(recording.open(path));
+            recording.appendFrame({TileId(1, 2, 0), TileId(3, 4, 5)});
+            recording.appendFrame({});
+            recording.appendFrame({TileId(7, 7, 7)});
+            CHECK(recording.getFrameCount() == 3);
+        }
+
+        std::vector<std::vector<uint32_t>> frames;
+        REQUIRE(FeedbackRecording::load(path, frames));
+        REQUIRE(frames.size() == 3);
+        CHECK((frames[0] == std::vector<uint32_t>{TileId(1, 2, 0).pack(), TileId(3, 4, 5).pack()}));
+        CHECK(frames[1].empty());
+        CHECK((frames[2] == std::vector<uint32_t>{TileId(7, 7, 7).pack()}));
+
+        std::filesystem::remove(path);
+        CHECK_FALSE(FeedbackRecording::load(path, frames));
+    }
+}
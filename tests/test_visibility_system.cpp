@@ -0,0 +1,64 @@
+#include <doctest/doctest.h>
+#include "ecs/Systems.h"
+#include "ecs/SpatialSystem.h"
+#include <glm/glm.hpp>
+
+using namespace ecs;
+
+namespace {
+
+// Axis-aligned box [-10, 10]^3 as six inward-facing normalized planes
+Frustum boxFrustum() {
+    Frustum frustum;
+    frustum.planes = {glm::vec4(1, 0, 0, 10), glm::vec4(-1, 0, 0, 10),
+                      glm::vec4(0, 1, 0, 10), glm::vec4(0, -1, 0, 10),
+                      glm::vec4(0, 0, 1, 10), glm::vec4(0, 0, -1, 10)};
+    return frustum;
+}
+
+Entity createSphere(World& world, const glm::vec3& position) {
+    Entity entity = world.create();
+    world.add<Transform>(entity, Transform::fromPosition(position));
+    world.add<BoundingSphere>(entity, glm::vec3(0.0f), 1.0f);
+    return entity;
+}
+
+} // namespace
+
+TEST_CASE("VisibilitySystem - tags follow the frustum") {
+    World world;
+    Entity inside = createSphere(world, glm::vec3(0.0f));
+    Entity outside = createSphere(world, glm::vec3(50.0f, 0.0f, 0.0f));
+    Entity straddling = createSphere(world, glm::vec3(10.0f, 0.0f, 0.0f));
+
+    systems::updateSpatialIndex(world);
+    systems::updateVisibility(world, boxFrustum());
+    CHECK(world.has<Visible>(inside));
+    CHECK_FALSE(world.has<Visible>(outside));
+    CHECK(world.has<Visible>(straddling));
+
+    world.get<Transform>(inside).setPosition(glm::vec3(0.0f, 0.0f, -50.0f));
+    systems::updateSpatialIndex(world);
+    systems::updateVisibility(world, boxFrustum());
+    CHECK_FALSE(world.has<Visible>(inside));
+    CHECK(world.has<Visible>(straddling));
+}
+
+TEST_CASE("VisibilitySystem - tagged entities outside the index keep their tag") {
+    World world;
+    Entity indexed = createSphere(world, glm::vec3(50.0f, 0.0f, 0.0f));
+    world.add<Visible>(indexed);
+
+    // No bounds, so never indexed; its entity index is above every indexed
+    // one but shares the last word of the visibility bitset
+    Entity unbounded = world.create();
+    for (int i = 0; i < 20; ++i) unbounded = world.create();
+    world.add<Visible>(unbounded);
+
+    const SpatialEntities& spatial = systems::updateSpatialIndex(world);
+    REQUIRE(spatial.entryOf.size() <= entt::to_entity(unbounded));
+
+    systems::updateVisibility(world, boxFrustum());
+    CHECK_FALSE(world.has<Visible>(indexed));
+    CHECK(world.has<Visible>(unbounded));
+}
@@ -0,0 +1,151 @@
+// Tests for WeakCache - sharded asset cache with in-flight load deduplication
+// No Vulkan dependencies
+
+#include <doctest/doctest.h>
+#include "core/asset/WeakCache.h"
+#include "core/asset/AssetHandle.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct FakeAsset {
+    explicit FakeAsset(int v) : value(v) {}
+    int value;
+};
+
+} // namespace
+
+TEST_SUITE("WeakCache") {
+    TEST_CASE("entries expire with their last reference") {
+        WeakCache<FakeAsset> cache;
+        auto asset = std::make_shared<FakeAsset>(1);
+        cache.put("a", asset);
+        CHECK(cache.get("a") == asset);
+        CHECK(cache.contains("a"));
+        CHECK(cache.size() == 1);
+
+        asset.reset();
+        CHECK(cache.get("a") == nullptr);
+        CHECK_FALSE(cache.contains("a"));
+        CHECK(cache.size() == 0);
+    }
+
+    TEST_CASE("second requester joins the load in flight") {
+        WeakCache<FakeAsset> cache;
+        auto first = cache.acquire("tex");
+        auto second = cache.acquire("tex");
+        CHECK(first.shouldLoad);
+        CHECK_FALSE(second.shouldLoad);
+        CHECK(cache.loadingCount() == 1);
+        CHECK(cache.get("tex") == nullptr);
+
+        AssetHandle<FakeAsset> handle(second.future);
+        CHECK_FALSE(handle.isReady());
+        CHECK(handle.tryGet() == nullptr);
+
+        auto asset = std::make_shared<FakeAsset>(7);
+        cache.fulfil("tex", asset);
+        CHECK(handle.isReady());
+        CHECK(handle.get() == asset);
+        CHECK(first.future.get() == asset);
+
+        auto third = cache.acquire("tex");
+        CHECK_FALSE(third.shouldLoad);
+        CHECK(third.future.get() == asset);
+
+        auto stats = cache.stats();
+        CHECK(stats.misses == 1);
+        CHECK(stats.dedupHits == 1);
+        CHECK(stats.hits == 1);
+        CHECK(cache.loadingCount() == 0);
+    }
+
+    TEST_CASE("a failed load resolves waiters with nullptr and is retried") {
+        WeakCache<FakeAsset> cache;
+        auto first = cache.acquire("missing");
+        auto waiter = cache.acquire("missing");
+        cache.fulfil("missing", nullptr);
+        CHECK(waiter.future.get() == nullptr);
+
+        auto retry = cache.acquire("missing");
+        CHECK(retry.shouldLoad);
+        cache.fulfil("missing", std::make_shared<FakeAsset>(3));
+        CHECK(retry.future.get()->value == 3);
+    }
+
+    TEST_CASE("put resolves a load in flight and clear keeps it") {
+        WeakCache<FakeAsset> cache;
+        auto lookup = cache.acquire("mesh");
+        cache.clear();
+        CHECK(cache.loadingCount() == 1);
+
+        auto asset = std::make_shared<FakeAsset>(5);
+        cache.put("mesh", asset);
+        CHECK(lookup.future.get() == asset);
+
+        // The loader finishing later must not clobber the registered value
+        cache.fulfil("mesh", std::make_shared<FakeAsset>(6));
+        CHECK(cache.get("mesh") == asset);
+    }
+
+    TEST_CASE("many threads requesting overlapping assets load each one once") {
+        constexpr int THREADS = 16;
+        constexpr int REQUESTS_PER_THREAD = 2000;
+        constexpr int KEYS = 64;
+
+        WeakCache<FakeAsset> cache;
+        std::vector<std::atomic<int>> loads(KEYS);
+        for (auto& l : loads) l = 0;
+
+        // Keep everything alive so a hit never turns into a reload
+        std::vector<std::shared_ptr<FakeAsset>> keepAlive(KEYS);
+        std::mutex keepAliveMutex;
+        std::atomic<int> wrongValues{0};
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&, t]() {
+                std::mt19937 rng(static_cast<uint32_t>(t) * 7919u);
+                std::uniform_int_distribution<int> keyDist(0, KEYS - 1);
+                for (int i = 0; i < REQUESTS_PER_THREAD; ++i) {
+                    int k = keyDist(rng);
+                    std::string key = "asset_" + std::to_string(k);
+                    auto lookup = cache.acquire(key);
+                    if (lookup.shouldLoad) {
+                        loads[k]++;
+                        // Simulated decode, long enough for others to pile up
+                        std::this_thread::sleep_for(std::chrono::microseconds(200));
+                        auto asset = std::make_shared<FakeAsset>(k);
+                        {
+                            std::lock_guard<std::mutex> lock(keepAliveMutex);
+                            keepAlive[k] = asset;
+                        }
+                        cache.fulfil(key, asset);
+                    }
+                    auto asset = lookup.future.get();
+                    if (!asset || asset->value != k) {
+                        wrongValues++;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        CHECK(wrongValues == 0);
+        for (int k = 0; k < KEYS; ++k) {
+            CHECK(loads[k] <= 1);
+        }
+
+        auto stats = cache.stats();
+        CHECK(stats.hits + stats.misses + stats.dedupHits == size_t(THREADS) * REQUESTS_PER_THREAD);
+        CHECK(stats.misses <= size_t(KEYS));
+        CHECK(cache.loadingCount() == 0);
+        CHECK(cache.size() == cache.stats().misses);
+    }
+}
@@ -138,6 +138,40 @@ void parallel_for(int start, int end, Func&& func) {
     }
 }
 
+// Parallel for with dynamic scheduling over a range [start, end)
+// Threads pull the next index from a shared counter, so items with very
+// uneven cost still balance. threadCount 0 = getThreadCount().
+template<typename Func>
+void parallel_for_dynamic(int start, int end, unsigned int threadCount, Func&& func) {
+    if (start >= end) return;
+
+    unsigned int numThreads = threadCount > 0 ? threadCount : getThreadCount();
+    numThreads = std::min(numThreads, static_cast<unsigned int>(end - start));
+
+    if (numThreads <= 1) {
+        for (int i = start; i < end; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic<int> next(start);
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+
+    for (unsigned int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&] {
+            for (int i = next++; i < end; i = next++) {
+                func(i);
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
 // Parallel for with progress tracking
 // Func signature: void(int index)
 template<typename Func>
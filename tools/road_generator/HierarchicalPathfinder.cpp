@@ -0,0 +1,239 @@
+#include "HierarchicalPathfinder.h"
+#include "../common/ParallelProgress.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace RoadGen {
+
+int HierarchicalPathfinder::clusterOf(const CostGrid& grid, int cell) const {
+    int cx = grid.cellX(cell) / config.clusterSize;
+    int cy = grid.cellY(cell) / config.clusterSize;
+    return cy * clustersPerAxis + cx;
+}
+
+GridBounds HierarchicalPathfinder::clusterBounds(const CostGrid& grid, int cluster) const {
+    int cx = cluster % clustersPerAxis;
+    int cy = cluster / clustersPerAxis;
+    GridBounds b;
+    b.minX = cx * config.clusterSize;
+    b.minY = cy * config.clusterSize;
+    b.maxX = std::min(b.minX + config.clusterSize, grid.size) - 1;
+    b.maxY = std::min(b.minY + config.clusterSize, grid.size) - 1;
+    return b;
+}
+
+int32_t HierarchicalPathfinder::getOrAddNode(int cell, int cluster) {
+    if (cellToNode[cell] >= 0) return cellToNode[cell];
+
+    int32_t id = static_cast<int32_t>(nodes.size());
+    nodes.push_back(Node{cell, cluster, {}});
+    clusterNodes[cluster].push_back(id);
+    cellToNode[cell] = id;
+    return id;
+}
+
+void HierarchicalPathfinder::addTransitions(const CostGrid& grid, int clusterA, int clusterB,
+                                            bool vertical, int entranceSpacing) {
+    GridBounds a = clusterBounds(grid, clusterA);
+
+    // Border runs along y for horizontal neighbors, along x for vertical neighbors
+    int borderStart = vertical ? a.minX : a.minY;
+    int borderEnd = vertical ? a.maxX : a.maxY;
+
+    for (int segStart = borderStart; segStart <= borderEnd; segStart += entranceSpacing) {
+        int segEnd = std::min(segStart + entranceSpacing - 1, borderEnd);
+
+        // Pick the cheapest crossing in this segment so roads keep avoiding water/cliffs
+        int bestCellA = -1, bestCellB = -1;
+        float bestCost = SearchContext::INF;
+        for (int t = segStart; t <= segEnd; ++t) {
+            int cellA = vertical ? grid.index(t, a.maxY) : grid.index(a.maxX, t);
+            int cellB = vertical ? grid.index(t, a.maxY + 1) : grid.index(a.maxX + 1, t);
+            float cost = grid.edgeCost(cellA, false) + grid.edgeCost(cellB, false);
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestCellA = cellA;
+                bestCellB = cellB;
+            }
+        }
+
+        int32_t nodeA = getOrAddNode(bestCellA, clusterA);
+        int32_t nodeB = getOrAddNode(bestCellB, clusterB);
+        nodes[nodeA].edges.push_back(Edge{nodeB, grid.edgeCost(bestCellB, false)});
+        nodes[nodeB].edges.push_back(Edge{nodeA, grid.edgeCost(bestCellA, false)});
+    }
+}
+
+void HierarchicalPathfinder::build(const CostGrid& grid, const BuildConfig& cfg) {
+    config = cfg;
+    config.clusterSize = std::max(4, config.clusterSize);
+    config.entranceSpacing = std::max(1, config.entranceSpacing);
+    config.corridorMargin = std::max(0, config.corridorMargin);
+    clustersPerAxis = (grid.size + config.clusterSize - 1) / config.clusterSize;
+
+    nodes.clear();
+    clusterNodes.assign(static_cast<size_t>(clustersPerAxis) * clustersPerAxis, {});
+    cellToNode.assign(grid.cellCount(), -1);
+
+    // Border transitions (inter-cluster edges)
+    for (int cy = 0; cy < clustersPerAxis; ++cy) {
+        for (int cx = 0; cx < clustersPerAxis; ++cx) {
+            int cluster = cy * clustersPerAxis + cx;
+            if (cx + 1 < clustersPerAxis) {
+                addTransitions(grid, cluster, cluster + 1, false, config.entranceSpacing);
+            }
+            if (cy + 1 < clustersPerAxis) {
+                addTransitions(grid, cluster, cluster + clustersPerAxis, true, config.entranceSpacing);
+            }
+        }
+    }
+
+    // Intra-cluster edges: one bounded Dijkstra flood per node. Each cluster only
+    // touches its own nodes' edge lists, so clusters are built in parallel.
+    ParallelProgress::parallel_for(0, static_cast<int>(clusterNodes.size()), [&](int cluster) {
+        thread_local SearchContext ctx;
+        std::vector<int> unused;
+        GridBounds bounds = clusterBounds(grid, cluster);
+        const auto& members = clusterNodes[cluster];
+
+        for (int32_t from : members) {
+            searchGrid(grid, ctx, nodes[from].cell, -1, bounds, 0, unused);
+            for (int32_t to : members) {
+                if (to == from) continue;
+                float cost = ctx.costTo(nodes[to].cell);
+                if (cost < SearchContext::INF) {
+                    nodes[from].edges.push_back(Edge{to, cost});
+                }
+            }
+        }
+    });
+}
+
+size_t HierarchicalPathfinder::getEdgeCount() const {
+    size_t count = 0;
+    for (const auto& node : nodes) count += node.edges.size();
+    return count;
+}
+
+bool HierarchicalPathfinder::findPath(const CostGrid& grid, SearchContext& ctx, int start, int goal,
+                                      std::vector<int>& outCells, GridSearchStats* stats) const {
+    outCells.clear();
+    if (!isBuilt()) return false;
+
+    int startCluster = clusterOf(grid, start);
+    int goalCluster = clusterOf(grid, goal);
+
+    // Short hops gain little from the abstraction and lose the most quality
+    // to the fixed border transitions; leave them to the flat search
+    int clusterDx = std::abs(startCluster % clustersPerAxis - goalCluster % clustersPerAxis);
+    int clusterDy = std::abs(startCluster / clustersPerAxis - goalCluster / clustersPerAxis);
+    if (std::max(clusterDx, clusterDy) <= 1) return false;
+
+    const auto& startMembers = clusterNodes[startCluster];
+    const auto& goalMembers = clusterNodes[goalCluster];
+    if (startMembers.empty() || goalMembers.empty()) return false;
+
+    GridBounds startBounds = clusterBounds(grid, startCluster);
+    GridBounds goalBounds = clusterBounds(grid, goalCluster);
+    std::vector<int> segment;
+
+    // Connect the start cell to every abstract node in its cluster
+    std::vector<float> startCost(startMembers.size());
+    searchGrid(grid, ctx, start, -1, startBounds, 0, segment, stats);
+    for (size_t i = 0; i < startMembers.size(); ++i) {
+        startCost[i] = ctx.costTo(nodes[startMembers[i]].cell);
+    }
+
+    // Costs are directional (they depend on the destination cell), so node->goal
+    // needs a search per goal-cluster node rather than one flood from the goal
+    std::vector<float> goalCost(goalMembers.size(), SearchContext::INF);
+    for (size_t i = 0; i < goalMembers.size(); ++i) {
+        if (searchGrid(grid, ctx, nodes[goalMembers[i]].cell, goal, goalBounds, 0, segment, stats)) {
+            goalCost[i] = gridPathCost(grid, segment);
+        }
+    }
+
+    // Abstract A*: ids [0, N) are graph nodes, N is the virtual start, N + 1 the virtual goal
+    const int32_t n = static_cast<int32_t>(nodes.size());
+    const int32_t startId = n;
+    const int32_t goalId = n + 1;
+    std::vector<float> g(n + 2, SearchContext::INF);
+    std::vector<int32_t> parent(n + 2, -1);
+    std::vector<uint8_t> closed(n + 2, 0);
+    QuaternaryHeap open;
+
+    auto cellOf = [&](int32_t id) { return id == startId ? start : (id == goalId ? goal : nodes[id].cell); };
+    auto relax = [&](int32_t from, int32_t to, float cost) {
+        float tentative = g[from] + cost;
+        if (tentative < g[to]) {
+            g[to] = tentative;
+            parent[to] = from;
+            open.push(tentative + grid.heuristic(cellOf(to), goal), to);
+        }
+    };
+
+    g[startId] = 0.0f;
+    open.push(grid.heuristic(start, goal), startId);
+    bool found = false;
+
+    while (!open.empty()) {
+        int32_t current = open.top().index;
+        open.pop();
+        if (current == goalId) { found = true; break; }
+        if (closed[current]) continue;
+        closed[current] = 1;
+        if (stats) stats->nodesExpanded++;
+
+        if (current == startId) {
+            for (size_t i = 0; i < startMembers.size(); ++i) {
+                if (startCost[i] < SearchContext::INF) relax(startId, startMembers[i], startCost[i]);
+            }
+            continue;
+        }
+
+        for (const Edge& edge : nodes[current].edges) {
+            if (!closed[edge.to]) relax(current, edge.to, edge.cost);
+        }
+        if (nodes[current].cluster == goalCluster) {
+            auto it = std::find(goalMembers.begin(), goalMembers.end(), current);
+            float cost = goalCost[static_cast<size_t>(it - goalMembers.begin())];
+            if (cost < SearchContext::INF) relax(current, goalId, cost);
+        }
+    }
+
+    if (!found) return false;
+
+    // Corridor refinement: the abstract path fixes which clusters the route passes
+    // through; an exact search confined to those clusters (plus corridorMargin)
+    // recovers the quality lost to fixed border transitions while still touching
+    // only a fraction of the grid. A margin of 1 is near-optimal but ~2x slower.
+    std::vector<uint8_t> corridor(clusterNodes.size(), 0);
+    auto markCluster = [&](int cluster) {
+        int cx = cluster % clustersPerAxis;
+        int cy = cluster / clustersPerAxis;
+        const int m = config.corridorMargin;
+        for (int dy = -m; dy <= m; ++dy) {
+            for (int dx = -m; dx <= m; ++dx) {
+                int nx = cx + dx;
+                int ny = cy + dy;
+                if (nx >= 0 && ny >= 0 && nx < clustersPerAxis && ny < clustersPerAxis) {
+                    corridor[ny * clustersPerAxis + nx] = 1;
+                }
+            }
+        }
+    };
+    markCluster(startCluster);
+    markCluster(goalCluster);
+    for (int32_t id = parent[goalId]; id >= 0 && id < n; id = parent[id]) {
+        markCluster(nodes[id].cluster);
+    }
+
+    GridBounds corridorBounds = GridBounds::whole(grid.size);
+    corridorBounds.clusterMask = corridor.data();
+    corridorBounds.clusterSize = config.clusterSize;
+    corridorBounds.clustersPerAxis = clustersPerAxis;
+
+    return searchGrid(grid, ctx, start, goal, corridorBounds, 0, outCells, stats);
+}
+
+} // namespace RoadGen
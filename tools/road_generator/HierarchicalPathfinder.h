@@ -0,0 +1,66 @@
+#pragma once
+
+// Hierarchical path-finding (HPA*) over a CostGrid.
+//
+// The grid is split into square clusters. Cheap crossing points on each shared
+// cluster border become abstract nodes; intra-cluster edges between them are
+// precomputed with bounded Dijkstra floods. A query connects start and goal to
+// their cluster's nodes, runs A* on the small abstract graph, then refines the
+// route with an exact grid search confined to the corridor of clusters the
+// abstract path visits. Paths are near-optimal rather than optimal, in exchange
+// for never searching the whole grid.
+
+#include "PathfindingGrid.h"
+#include <vector>
+#include <cstdint>
+
+namespace RoadGen {
+
+class HierarchicalPathfinder {
+public:
+    struct BuildConfig {
+        int clusterSize = 32;       // Cells per cluster edge
+        int entranceSpacing = 8;    // One border transition per this many cells
+        int corridorMargin = 0;     // Extra clusters around the abstract path for refinement
+    };
+
+    // Build the abstract graph. Intra-cluster edges are computed in parallel.
+    void build(const CostGrid& grid, const BuildConfig& config);
+
+    bool isBuilt() const { return !nodes.empty(); }
+    size_t getNodeCount() const { return nodes.size(); }
+    size_t getEdgeCount() const;
+
+    /**
+     * Find a path between two cells.
+     * Returns false when start and goal are in the same or adjacent clusters, or
+     * no abstract path exists; callers fall back to a flat grid search then.
+     */
+    bool findPath(const CostGrid& grid, SearchContext& ctx, int start, int goal,
+                  std::vector<int>& outCells, GridSearchStats* stats = nullptr) const;
+
+private:
+    struct Edge {
+        int32_t to;
+        float cost;
+    };
+
+    struct Node {
+        int32_t cell;
+        int32_t cluster;
+        std::vector<Edge> edges;
+    };
+
+    int clusterOf(const CostGrid& grid, int cell) const;
+    GridBounds clusterBounds(const CostGrid& grid, int cluster) const;
+    int32_t getOrAddNode(int cell, int cluster);
+    void addTransitions(const CostGrid& grid, int clusterA, int clusterB, bool vertical, int entranceSpacing);
+
+    BuildConfig config;
+    int clustersPerAxis = 0;
+    std::vector<Node> nodes;
+    std::vector<std::vector<int32_t>> clusterNodes;     // Node ids per cluster
+    std::vector<int32_t> cellToNode;                    // -1 if the cell is not an abstract node
+};
+
+} // namespace RoadGen
@@ -0,0 +1,103 @@
+#include "PathfindingGrid.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace RoadGen {
+
+void SearchContext::begin(size_t cellCount) {
+    if (gCost.size() != cellCount) {
+        gCost.assign(cellCount, INF);
+        parent.assign(cellCount, -1);
+        visitStamp.assign(cellCount, 0);
+        closedStamp.assign(cellCount, 0);
+        stamp = 0;
+    }
+
+    // Stamp 0 means "never touched"; reset the arrays on wrap-around
+    if (++stamp == 0) {
+        std::fill(visitStamp.begin(), visitStamp.end(), 0u);
+        std::fill(closedStamp.begin(), closedStamp.end(), 0u);
+        stamp = 1;
+    }
+    open.clear();
+}
+
+bool searchGrid(const CostGrid& grid, SearchContext& ctx, int start, int goal,
+                const GridBounds& bounds, size_t maxIterations,
+                std::vector<int>& outCells, GridSearchStats* stats) {
+    outCells.clear();
+    ctx.begin(grid.cellCount());
+
+    // Same 8-directional neighbor order as the original unordered_map A*
+    static const int offsets[8][2] = {
+        {-1, -1}, {0, -1}, {1, -1},
+        {-1,  0},          {1,  0},
+        {-1,  1}, {0,  1}, {1,  1}
+    };
+
+    const bool flood = goal < 0;
+    ctx.visit(start, 0.0f, -1);
+    ctx.open.push(flood ? 0.0f : grid.heuristic(start, goal), start);
+
+    size_t iterations = 0;
+    uint64_t expanded = 0;
+
+    while (!ctx.open.empty()) {
+        if (maxIterations > 0 && iterations >= maxIterations) break;
+        iterations++;
+
+        int current = ctx.open.top().index;
+        ctx.open.pop();
+
+        if (current == goal) {
+            for (int cell = goal; cell >= 0; cell = ctx.parentOf(cell)) {
+                outCells.push_back(cell);
+            }
+            std::reverse(outCells.begin(), outCells.end());
+            if (stats) stats->nodesExpanded += expanded;
+            return true;
+        }
+
+        // Lazy deletion: stale heap entries for already-closed cells are skipped
+        if (ctx.isClosed(current)) continue;
+        ctx.close(current);
+        expanded++;
+
+        int cx = grid.cellX(current);
+        int cy = grid.cellY(current);
+        float currentG = ctx.costTo(current);
+
+        for (const auto& offset : offsets) {
+            int nx = cx + offset[0];
+            int ny = cy + offset[1];
+            if (!bounds.contains(nx, ny)) continue;
+
+            int neighbor = grid.index(nx, ny);
+            if (ctx.isClosed(neighbor)) continue;
+
+            bool diagonal = offset[0] != 0 && offset[1] != 0;
+            float tentativeG = currentG + grid.edgeCost(neighbor, diagonal);
+
+            if (tentativeG < ctx.costTo(neighbor)) {
+                ctx.visit(neighbor, tentativeG, current);
+                float h = flood ? 0.0f : grid.heuristic(neighbor, goal);
+                ctx.open.push(tentativeG + h, neighbor);
+            }
+        }
+    }
+
+    if (stats) stats->nodesExpanded += expanded;
+    return flood;
+}
+
+float gridPathCost(const CostGrid& grid, const std::vector<int>& cells) {
+    float cost = 0.0f;
+    for (size_t i = 1; i < cells.size(); ++i) {
+        int dx = std::abs(grid.cellX(cells[i]) - grid.cellX(cells[i - 1]));
+        int dy = std::abs(grid.cellY(cells[i]) - grid.cellY(cells[i - 1]));
+        cost += grid.edgeCost(cells[i], dx != 0 && dy != 0);
+    }
+    return cost;
+}
+
+} // namespace RoadGen
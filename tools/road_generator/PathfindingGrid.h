@@ -0,0 +1,170 @@
+#pragma once
+
+// Flat-array grid search primitives shared by the road pathfinder and its
+// hierarchical (HPA*) abstraction. Cells are addressed by linear index
+// (y * size + x); all per-cell search state lives in contiguous arrays that
+// are reused across searches via a generation stamp instead of being cleared.
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+
+namespace RoadGen {
+
+// Precomputed per-cell traversal cost.
+// Moving into cell `to` costs: stepLength * multiplier[to] + penalty[to]
+// where stepLength is the orthogonal or diagonal cell spacing in meters.
+struct CostGrid {
+    int size = 0;                   // Cells per axis
+    float spacing = 0.0f;           // Orthogonal step length (meters)
+    float diagonalSpacing = 0.0f;   // Diagonal step length (meters)
+    std::vector<float> multiplier;  // 1 + slope * slopeCostMultiplier
+    std::vector<float> penalty;     // Water + cliff penalties
+
+    bool isValid() const { return size > 0 && multiplier.size() == static_cast<size_t>(size) * size; }
+    size_t cellCount() const { return static_cast<size_t>(size) * size; }
+    int index(int x, int y) const { return y * size + x; }
+    int cellX(int index) const { return index % size; }
+    int cellY(int index) const { return index / size; }
+
+    float edgeCost(int toIndex, bool diagonal) const {
+        return (diagonal ? diagonalSpacing : spacing) * multiplier[toIndex] + penalty[toIndex];
+    }
+
+    // Straight-line distance in meters; admissible because multiplier >= 1
+    float heuristic(int from, int to) const {
+        float dx = static_cast<float>(cellX(from) - cellX(to));
+        float dy = static_cast<float>(cellY(from) - cellY(to));
+        return spacing * std::sqrt(dx * dx + dy * dy);
+    }
+};
+
+// Inclusive cell rectangle a search is confined to, optionally further
+// restricted to a set of square clusters (HPA* corridor refinement)
+struct GridBounds {
+    int minX = 0, minY = 0, maxX = -1, maxY = -1;
+    const uint8_t* clusterMask = nullptr;   // Non-zero = cluster allowed
+    int clusterSize = 0;
+    int clustersPerAxis = 0;
+
+    static GridBounds whole(int size) {
+        GridBounds b;
+        b.maxX = size - 1;
+        b.maxY = size - 1;
+        return b;
+    }
+
+    bool contains(int x, int y) const {
+        if (x < minX || x > maxX || y < minY || y > maxY) return false;
+        return !clusterMask || clusterMask[(y / clusterSize) * clustersPerAxis + x / clusterSize];
+    }
+};
+
+// 4-ary min-heap keyed on float cost. Shallower than a binary heap, so fewer
+// cache misses per pop for the large open sets seen on 512+ grids.
+class QuaternaryHeap {
+public:
+    struct Entry {
+        float key;
+        int32_t index;
+    };
+
+    bool empty() const { return entries.empty(); }
+    size_t size() const { return entries.size(); }
+    void clear() { entries.clear(); }
+    const Entry& top() const { return entries.front(); }
+
+    void push(float key, int32_t index) {
+        entries.push_back({key, index});
+        siftUp(entries.size() - 1);
+    }
+
+    void pop() {
+        entries.front() = entries.back();
+        entries.pop_back();
+        if (!entries.empty()) siftDown(0);
+    }
+
+private:
+    void siftUp(size_t i) {
+        Entry e = entries[i];
+        while (i > 0) {
+            size_t parent = (i - 1) / 4;
+            if (entries[parent].key <= e.key) break;
+            entries[i] = entries[parent];
+            i = parent;
+        }
+        entries[i] = e;
+    }
+
+    void siftDown(size_t i) {
+        Entry e = entries[i];
+        size_t n = entries.size();
+        while (true) {
+            size_t first = i * 4 + 1;
+            if (first >= n) break;
+            size_t last = first + 4 < n ? first + 4 : n;
+            size_t best = first;
+            for (size_t c = first + 1; c < last; ++c) {
+                if (entries[c].key < entries[best].key) best = c;
+            }
+            if (entries[best].key >= e.key) break;
+            entries[i] = entries[best];
+            i = best;
+        }
+        entries[i] = e;
+    }
+
+    std::vector<Entry> entries;
+};
+
+// Per-thread reusable search state sized to the full grid
+class SearchContext {
+public:
+    static constexpr float INF = std::numeric_limits<float>::infinity();
+
+    // Start a new search generation (O(1) unless the grid size changed)
+    void begin(size_t cellCount);
+
+    bool isVisited(int cell) const { return visitStamp[cell] == stamp; }
+    bool isClosed(int cell) const { return closedStamp[cell] == stamp; }
+    float costTo(int cell) const { return isVisited(cell) ? gCost[cell] : INF; }
+    int32_t parentOf(int cell) const { return parent[cell]; }
+
+    void visit(int cell, float g, int32_t from) {
+        visitStamp[cell] = stamp;
+        gCost[cell] = g;
+        parent[cell] = from;
+    }
+    void close(int cell) { closedStamp[cell] = stamp; }
+
+    QuaternaryHeap open;
+
+private:
+    std::vector<float> gCost;
+    std::vector<int32_t> parent;
+    std::vector<uint32_t> visitStamp;
+    std::vector<uint32_t> closedStamp;
+    uint32_t stamp = 0;
+};
+
+struct GridSearchStats {
+    uint64_t nodesExpanded = 0;
+};
+
+/**
+ * A* over the cost grid, confined to `bounds`.
+ * If goal < 0 the search runs as a bounded Dijkstra flood; read results via ctx.costTo().
+ * On success (goal >= 0) fills outCells with the start-to-goal cell path.
+ * @param maxIterations Safety limit on heap pops (0 = unlimited)
+ */
+bool searchGrid(const CostGrid& grid, SearchContext& ctx, int start, int goal,
+                const GridBounds& bounds, size_t maxIterations,
+                std::vector<int>& outCells, GridSearchStats* stats = nullptr);
+
+// Sum of edge costs along a cell path
+float gridPathCost(const CostGrid& grid, const std::vector<int>& cells);
+
+} // namespace RoadGen
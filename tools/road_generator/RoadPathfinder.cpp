@@ -1,10 +1,12 @@
 #include "RoadPathfinder.h"
+#include "../common/ParallelProgress.h"
 #include <SDL3/SDL_log.h>
 #include <lodepng.h>
 #include <queue>
 #include <unordered_set>
 #include <unordered_map>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 
 namespace RoadGen {
@@ -90,6 +92,12 @@ RoadPathfinder::RoadPathfinder() = default;
 void RoadPathfinder::init(const PathfinderConfig& cfg) {
     config = cfg;
     gridSize = cfg.gridResolution;
+    costGridValid = false;
+}
+
+void RoadPathfinder::setTerrainData(TerrainData data) {
+    terrain = std::move(data);
+    costGridValid = false;
 }
 
 bool RoadPathfinder::loadHeightmap(const std::string& path) {
@@ -113,6 +121,7 @@ bool RoadPathfinder::loadHeightmap(const std::string& path) {
         terrain.heights[i] = static_cast<float>(val) / 65535.0f;
     }
 
+    costGridValid = false;
     SDL_Log("Loaded heightmap: %s (%u x %u)", path.c_str(), w, h);
     return true;
 }
@@ -145,6 +154,7 @@ bool RoadPathfinder::loadBiomeMap(const std::string& path) {
         terrain.biomeZones[i] = image[i * 4]; // R channel = zone
     }
 
+    costGridValid = false;
     SDL_Log("Loaded biome map: %s (%u x %u)", path.c_str(), w, h);
     return true;
 }
@@ -227,22 +237,86 @@ float RoadPathfinder::heuristic(glm::ivec2 from, glm::ivec2 to) const {
     return glm::length(worldTo - worldFrom);
 }
 
-bool RoadPathfinder::findPath(glm::vec2 start, glm::vec2 end, std::vector<RoadControlPoint>& outPath) {
-    outPath.clear();
+void RoadPathfinder::buildCostGrid() {
+    std::lock_guard<std::mutex> lock(costGridMutex);
+    if (costGridValid) return;
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    // Same cost terms as calculateCost(), evaluated once per cell instead of
+    // once per neighbor expansion (slope sampling is 4 bilinear lookups)
+    costGrid.size = static_cast<int>(gridSize);
+    costGrid.spacing = config.terrainSize / static_cast<float>(gridSize - 1);
+    costGrid.diagonalSpacing = costGrid.spacing * std::sqrt(2.0f);
+    costGrid.multiplier.assign(costGrid.cellCount(), 1.0f);
+    costGrid.penalty.assign(costGrid.cellCount(), 0.0f);
+
+    ParallelProgress::parallel_for(0, costGrid.size, [&](int y) {
+        for (int x = 0; x < costGrid.size; ++x) {
+            glm::vec2 world = gridToWorld(glm::ivec2(x, y));
+            float slope = terrain.sampleSlope(world.x, world.y, config.terrainSize);
+            float penalty = 0.0f;
+            if (terrain.isWater(world.x, world.y, config.terrainSize)) penalty += config.waterPenalty;
+            if (slope > config.cliffSlopeThreshold) penalty += config.cliffPenalty;
+
+            int idx = costGrid.index(x, y);
+            costGrid.multiplier[idx] = 1.0f + slope * config.slopeCostMultiplier;
+            costGrid.penalty[idx] = penalty;
+        }
+    });
 
-    glm::ivec2 startGrid = worldToGrid(start);
-    glm::ivec2 endGrid = worldToGrid(end);
+    auto t1 = std::chrono::steady_clock::now();
+    stats.costGridMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    stats.hierarchyBuildMs = 0.0;
+
+    if (config.useHierarchical) {
+        HierarchicalPathfinder::BuildConfig hpaConfig;
+        hpaConfig.clusterSize = static_cast<int>(config.clusterSize);
+        hpaConfig.entranceSpacing = static_cast<int>(config.entranceSpacing);
+        hpaConfig.corridorMargin = static_cast<int>(config.corridorMargin);
+        hierarchy.build(costGrid, hpaConfig);
+
+        stats.hierarchyBuildMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - t1).count();
+        SDL_Log("HPA* graph: %zu nodes, %zu edges (%.1f ms)",
+                hierarchy.getNodeCount(), hierarchy.getEdgeCount(), stats.hierarchyBuildMs);
+    }
 
-    // Clamp to valid grid positions
-    startGrid = glm::clamp(startGrid, glm::ivec2(0), glm::ivec2(gridSize - 1));
-    endGrid = glm::clamp(endGrid, glm::ivec2(0), glm::ivec2(gridSize - 1));
+    costGridValid = true;
+}
 
-    // If start == end, return single point
-    if (startGrid == endGrid) {
-        outPath.push_back(RoadControlPoint(start));
-        outPath.push_back(RoadControlPoint(end));
-        return true;
+bool RoadPathfinder::findGridPath(glm::ivec2 startGrid, glm::ivec2 endGrid, std::vector<glm::ivec2>& outPath) {
+    outPath.clear();
+    if (!costGridValid) buildCostGrid();
+
+    // One search context per thread; reused across paths without clearing
+    thread_local SearchContext ctx;
+    std::vector<int> cells;
+    GridSearchStats searchStats;
+
+    int start = costGrid.index(startGrid.x, startGrid.y);
+    int goal = costGrid.index(endGrid.x, endGrid.y);
+
+    bool found = config.useHierarchical &&
+                 hierarchy.findPath(costGrid, ctx, start, goal, cells, &searchStats);
+    if (!found) {
+        // No iteration cap: each cell is expanded at most once, unlike the reference
+        // A* whose pop limit counts stale heap entries and can give up near water
+        found = searchGrid(costGrid, ctx, start, goal, GridBounds::whole(costGrid.size),
+                           0, cells, &searchStats);
+    }
+    nodesExpanded += searchStats.nodesExpanded;
+
+    outPath.reserve(cells.size());
+    for (int cell : cells) {
+        outPath.emplace_back(costGrid.cellX(cell), costGrid.cellY(cell));
     }
+    return found;
+}
+
+bool RoadPathfinder::findGridPathReference(glm::ivec2 startGrid, glm::ivec2 endGrid,
+                                           std::vector<glm::ivec2>& outPath) const {
+    outPath.clear();
 
     // A* algorithm
     auto cmp = [](const PathNode& a, const PathNode& b) {
@@ -279,32 +353,15 @@ bool RoadPathfinder::findPath(glm::vec2 start, glm::vec2 end, std::vector<RoadCo
         // Check if we've reached the goal
         if (currentPos == endGrid) {
             // Reconstruct path
-            std::vector<glm::vec2> gridPath;
             glm::ivec2 pos = currentPos;
-
             while (pos.x >= 0 && pos.y >= 0) {
-                gridPath.push_back(gridToWorld(pos));
-                const PathNode& node = allNodes[pos];
+                outPath.push_back(pos);
+                const PathNode& node = allNodes.at(pos);
                 pos = glm::ivec2(node.parentX, node.parentY);
             }
 
             // Reverse to get start-to-end order
-            std::reverse(gridPath.begin(), gridPath.end());
-
-            // Ensure we include exact start and end points
-            if (!gridPath.empty()) {
-                gridPath[0] = start;
-                gridPath.back() = end;
-            }
-
-            // Convert to control points
-            for (const auto& p : gridPath) {
-                outPath.push_back(RoadControlPoint(p));
-            }
-
-            // Simplify the path
-            simplifyPath(outPath);
-
+            std::reverse(outPath.begin(), outPath.end());
             return true;
         }
 
@@ -334,6 +391,63 @@ bool RoadPathfinder::findPath(glm::vec2 start, glm::vec2 end, std::vector<RoadCo
         }
     }
 
+    return false;
+}
+
+float RoadPathfinder::gridPathCost(const std::vector<glm::ivec2>& path) const {
+    float cost = 0.0f;
+    for (size_t i = 1; i < path.size(); ++i) {
+        cost += calculateCost(path[i - 1], path[i]);
+    }
+    return cost;
+}
+
+void RoadPathfinder::buildControlPoints(const std::vector<glm::ivec2>& gridPath, glm::vec2 start, glm::vec2 end,
+                                        std::vector<RoadControlPoint>& outPath) const {
+    std::vector<glm::vec2> worldPath;
+    worldPath.reserve(gridPath.size());
+    for (const auto& cell : gridPath) {
+        worldPath.push_back(gridToWorld(cell));
+    }
+
+    // Ensure we include exact start and end points
+    if (!worldPath.empty()) {
+        worldPath[0] = start;
+        worldPath.back() = end;
+    }
+
+    // Convert to control points
+    for (const auto& p : worldPath) {
+        outPath.push_back(RoadControlPoint(p));
+    }
+
+    // Simplify the path
+    simplifyPath(outPath);
+}
+
+bool RoadPathfinder::findPath(glm::vec2 start, glm::vec2 end, std::vector<RoadControlPoint>& outPath) {
+    outPath.clear();
+
+    glm::ivec2 startGrid = worldToGrid(start);
+    glm::ivec2 endGrid = worldToGrid(end);
+
+    // Clamp to valid grid positions
+    startGrid = glm::clamp(startGrid, glm::ivec2(0), glm::ivec2(gridSize - 1));
+    endGrid = glm::clamp(endGrid, glm::ivec2(0), glm::ivec2(gridSize - 1));
+
+    // If start == end, return single point
+    if (startGrid == endGrid) {
+        outPath.push_back(RoadControlPoint(start));
+        outPath.push_back(RoadControlPoint(end));
+        return true;
+    }
+
+    std::vector<glm::ivec2> gridPath;
+    if (findGridPath(startGrid, endGrid, gridPath)) {
+        buildControlPoints(gridPath, start, end, outPath);
+        return true;
+    }
+
     // No path found - create direct line as fallback
     SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
                 "No path found from (%.1f, %.1f) to (%.1f, %.1f), using direct line",
@@ -493,23 +607,28 @@ bool RoadPathfinder::generateRoadNetwork(const std::vector<Settlement>& settleme
         return true;
     }
 
-    // Generate paths for each connection
-    size_t completed = 0;
-    size_t failed = 0;
+    // Precompute terrain costs (and the HPA* graph) before fanning out
+    buildCostGrid();
 
-    for (size_t i = 0; i < connections.size(); i++) {
+    stats.pathfindingMs = 0.0;
+    stats.pathsSolved = 0;
+    stats.nodesExpanded = 0;
+    stats.threadCount = config.parallelConnections
+        ? std::min(ParallelProgress::getThreadCount(), static_cast<unsigned int>(connections.size()))
+        : 1u;
+    nodesExpanded = 0;
+
+    // Each connection is independent: solve into per-index slots so the output
+    // order matches the (importance-sorted) connection order regardless of threads
+    std::vector<RoadSpline> roads(connections.size());
+    std::vector<uint8_t> pathFound(connections.size(), 0);
+
+    auto solveConnection = [&](int i) {
         const auto& conn = connections[i];
         const Settlement& from = settlements[conn.fromIdx];
         const Settlement& to = settlements[conn.toIdx];
 
-        if (callback) {
-            float progress = static_cast<float>(i + 1) / connections.size();
-            std::string status = "Generating road " + std::to_string(i + 1) + "/" +
-                                 std::to_string(connections.size());
-            callback(progress, status);
-        }
-
-        RoadSpline road;
+        RoadSpline& road = roads[i];
         road.type = conn.roadType;
         road.fromSettlementId = from.id;
         road.toSettlementId = to.id;
@@ -529,18 +648,53 @@ bool RoadPathfinder::generateRoadNetwork(const std::vector<Settlement>& settleme
             endPos = to.position;
         }
 
-        if (findPath(startPos, endPos, road.controlPoints)) {
-            outNetwork.roads.push_back(std::move(road));
-            completed++;
-        } else {
-            // Still add the road even if pathfinding failed (uses direct line)
-            outNetwork.roads.push_back(std::move(road));
-            failed++;
+        // Roads are kept even if pathfinding failed (findPath falls back to a direct line)
+        pathFound[i] = findPath(startPos, endPos, road.controlPoints) ? 1 : 0;
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+    int connectionCount = static_cast<int>(connections.size());
+
+    if (config.parallelConnections) {
+        ParallelProgress::parallel_for_progress(0, connectionCount, solveConnection,
+                                                callback, "Generating road");
+    } else {
+        for (int i = 0; i < connectionCount; i++) {
+            if (callback) {
+                float progress = static_cast<float>(i + 1) / connections.size();
+                std::string status = "Generating road " + std::to_string(i + 1) + "/" +
+                                     std::to_string(connections.size());
+                callback(progress, status);
+            }
+            solveConnection(i);
         }
     }
 
+    stats.pathfindingMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+    stats.pathsSolved = connections.size();
+    stats.nodesExpanded = nodesExpanded.load();
+
+    size_t completed = 0;
+    size_t failed = 0;
+    for (size_t i = 0; i < roads.size(); i++) {
+        if (pathFound[i]) completed++; else failed++;
+        outNetwork.roads.push_back(std::move(roads[i]));
+    }
+
     SDL_Log("Road generation complete: %zu roads (%zu with pathfinding, %zu direct)",
-            outNetwork.roads.size(), completed - failed, failed);
+            outNetwork.roads.size(), completed, failed);
+
+    SDL_Log("Pathfinding timing (%s, %u thread%s):", config.useHierarchical ? "HPA*" : "A*",
+            stats.threadCount, stats.threadCount == 1 ? "" : "s");
+    SDL_Log("  Cost grid: %.1f ms", stats.costGridMs);
+    if (config.useHierarchical) {
+        SDL_Log("  HPA* build: %.1f ms", stats.hierarchyBuildMs);
+    }
+    SDL_Log("  Paths: %zu in %.1f ms (%.2f ms/path), %llu nodes expanded",
+            stats.pathsSolved, stats.pathfindingMs,
+            stats.pathsSolved > 0 ? stats.pathfindingMs / stats.pathsSolved : 0.0,
+            static_cast<unsigned long long>(stats.nodesExpanded));
 
     // Log statistics by road type
     SDL_Log("Road breakdown:");
@@ -1,10 +1,14 @@
 #pragma once
 
 #include "RoadSpline.h"
+#include "PathfindingGrid.h"
+#include "HierarchicalPathfinder.h"
 #include <vector>
 #include <string>
 #include <cstdint>
 #include <functional>
+#include <atomic>
+#include <mutex>
 #include <glm/glm.hpp>
 
 namespace RoadGen {
@@ -25,6 +29,23 @@ struct PathfinderConfig {
 
     // Simplification
     float simplifyEpsilon = 10.0f;      // Douglas-Peucker simplification threshold (meters)
+
+    // Search acceleration
+    bool useHierarchical = false;       // HPA* over grid clusters (near-optimal, much faster)
+    uint32_t clusterSize = 32;          // HPA* cluster edge length in cells
+    uint32_t entranceSpacing = 8;       // HPA* border transition spacing in cells
+    uint32_t corridorMargin = 0;        // HPA* refinement corridor margin (1 = near-optimal, slower)
+    bool parallelConnections = true;    // Solve independent settlement connections concurrently
+};
+
+// Timing report for the most recent generateRoadNetwork call
+struct PathfinderStats {
+    double costGridMs = 0.0;            // Precomputing per-cell slope/biome costs
+    double hierarchyBuildMs = 0.0;      // Building the HPA* abstract graph
+    double pathfindingMs = 0.0;         // Wall time solving all connections
+    size_t pathsSolved = 0;
+    uint64_t nodesExpanded = 0;
+    uint32_t threadCount = 1;
 };
 
 // Terrain data loaded for pathfinding
@@ -57,10 +78,29 @@ public:
     bool loadHeightmap(const std::string& path);
     bool loadBiomeMap(const std::string& path);
 
+    // Use already-loaded terrain data (tests, in-memory pipelines)
+    void setTerrainData(TerrainData data);
+
     // Find path between two world positions
     // Returns true if path found, fills outPath with control points
+    // Thread-safe: may be called concurrently once the cost grid is built
     bool findPath(glm::vec2 start, glm::vec2 end, std::vector<RoadControlPoint>& outPath);
 
+    // Grid-level search (before simplification). Uses the flat-array A* on the
+    // precomputed cost grid, or HPA* when config.useHierarchical is set.
+    bool findGridPath(glm::ivec2 startGrid, glm::ivec2 endGrid, std::vector<glm::ivec2>& outPath);
+
+    // Original unordered_map/priority_queue A* evaluating costs per expansion.
+    // Kept as the reference for cost-regression tests and benchmarks.
+    bool findGridPathReference(glm::ivec2 startGrid, glm::ivec2 endGrid, std::vector<glm::ivec2>& outPath) const;
+
+    // Total traversal cost of a grid path using the per-expansion cost function
+    float gridPathCost(const std::vector<glm::ivec2>& path) const;
+
+    // Precompute the cost grid (and HPA* graph if enabled). Called lazily by
+    // findPath; call explicitly to keep setup out of timing measurements.
+    void buildCostGrid();
+
     // Generate the full road network connecting settlements
     bool generateRoadNetwork(const std::vector<Settlement>& settlements,
                              RoadNetwork& outNetwork,
@@ -69,6 +109,8 @@ public:
     // Get the terrain data (for debugging)
     const TerrainData& getTerrainData() const { return terrain; }
 
+    const PathfinderStats& getStats() const { return stats; }
+
 private:
     // A* node for pathfinding
     struct PathNode {
@@ -103,9 +145,22 @@ private:
     };
     std::vector<ConnectionCandidate> determineConnections(const std::vector<Settlement>& settlements) const;
 
+    // Convert a grid cell path to world-space control points and simplify
+    void buildControlPoints(const std::vector<glm::ivec2>& gridPath, glm::vec2 start, glm::vec2 end,
+                            std::vector<RoadControlPoint>& outPath) const;
+
     PathfinderConfig config;
     TerrainData terrain;
     uint32_t gridSize = 0;
+
+    // Precomputed search structures, rebuilt when terrain or config changes
+    CostGrid costGrid;
+    HierarchicalPathfinder hierarchy;
+    std::atomic<bool> costGridValid{false};
+    std::mutex costGridMutex;
+
+    PathfinderStats stats;
+    std::atomic<uint64_t> nodesExpanded{0};
 };
 
 } // namespace RoadGen
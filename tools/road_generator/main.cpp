@@ -31,6 +31,8 @@ struct RoadBuildConfig {
     uint32_t gridResolution;
     float simplifyEpsilon;
     bool useColonization;
+    bool useHierarchical;
+    uint32_t clusterSize;
 };
 
 bool isRoadOutputUpToDate(const RoadBuildConfig& config) {
@@ -50,6 +52,8 @@ bool isRoadOutputUpToDate(const RoadBuildConfig& config) {
     uint32_t cachedGridResolution = 0;
     float cachedSimplifyEpsilon = 0;
     bool cachedUseColonization = false;
+    bool cachedUseHierarchical = false;
+    uint32_t cachedClusterSize = 0;
 
     while (std::getline(file, line)) {
         std::istringstream iss(line);
@@ -67,6 +71,8 @@ bool isRoadOutputUpToDate(const RoadBuildConfig& config) {
             else if (key == "gridResolution") cachedGridResolution = std::stoul(value);
             else if (key == "simplifyEpsilon") cachedSimplifyEpsilon = std::stof(value);
             else if (key == "useColonization") cachedUseColonization = (value == "1");
+            else if (key == "useHierarchical") cachedUseHierarchical = (value == "1");
+            else if (key == "clusterSize") cachedClusterSize = std::stoul(value);
         }
     }
 
@@ -100,7 +106,9 @@ bool isRoadOutputUpToDate(const RoadBuildConfig& config) {
         std::abs(cachedMaxAltitude - config.maxAltitude) > 0.01f ||
         cachedGridResolution != config.gridResolution ||
         std::abs(cachedSimplifyEpsilon - config.simplifyEpsilon) > 0.01f ||
-        cachedUseColonization != config.useColonization) {
+        cachedUseColonization != config.useColonization ||
+        cachedUseHierarchical != config.useHierarchical ||
+        (config.useHierarchical && cachedClusterSize != config.clusterSize)) {
         SDL_Log("Roads: configuration changed, reprocessing");
         return false;
     }
@@ -144,6 +152,8 @@ bool saveRoadBuildStamp(const RoadBuildConfig& config) {
     file << "gridResolution=" << config.gridResolution << "\n";
     file << "simplifyEpsilon=" << config.simplifyEpsilon << "\n";
     file << "useColonization=" << (config.useColonization ? "1" : "0") << "\n";
+    file << "useHierarchical=" << (config.useHierarchical ? "1" : "0") << "\n";
+    file << "clusterSize=" << config.clusterSize << "\n";
 
     return true;
 }
@@ -166,6 +176,9 @@ void printUsage(const char* programName) {
               << "  --grid-resolution <value>   Pathfinding grid size (default: 512)\n"
               << "  --simplify-epsilon <value>  Path simplification threshold in meters (default: 10.0)\n"
               << "  --use-colonization          Use space colonization for network topology\n"
+              << "  --hierarchical              Use HPA* (near-optimal, faster on large grids)\n"
+              << "  --cluster-size <value>      HPA* cluster size in grid cells (default: 32)\n"
+              << "  --serial                    Solve road connections on a single thread\n"
               << "  --generate-streets          Generate intra-settlement street networks\n"
               << "  --settlement-id <id>        Generate streets for specific settlement only\n"
               << "  --help                      Show this help message\n"
@@ -433,6 +446,12 @@ int main(int argc, char* argv[]) {
             config.simplifyEpsilon = std::stof(argv[++i]);
         } else if (arg == "--use-colonization") {
             useColonization = true;
+        } else if (arg == "--hierarchical") {
+            config.useHierarchical = true;
+        } else if (arg == "--cluster-size" && i + 1 < argc) {
+            config.clusterSize = std::stoul(argv[++i]);
+        } else if (arg == "--serial") {
+            config.parallelConnections = false;
         } else if (arg == "--generate-streets") {
             generateStreets = true;
         } else if (arg == "--settlement-id" && i + 1 < argc) {
@@ -457,6 +476,8 @@ int main(int argc, char* argv[]) {
     buildConfig.gridResolution = config.gridResolution;
     buildConfig.simplifyEpsilon = config.simplifyEpsilon;
     buildConfig.useColonization = useColonization;
+    buildConfig.useHierarchical = config.useHierarchical;
+    buildConfig.clusterSize = config.clusterSize;
 
     if (isRoadOutputUpToDate(buildConfig)) {
         SDL_Log("Roads outputs up to date - skipping");
@@ -0,0 +1,202 @@
+#include <doctest/doctest.h>
+#include "RoadPathfinder.h"
+#include <cmath>
+#include <random>
+
+using namespace RoadGen;
+
+namespace {
+
+constexpr float TERRAIN_SIZE = 4096.0f;
+constexpr uint32_t GRID = 96;
+
+// Rolling hills with a circular lake, so paths have to trade slope against detours
+TerrainData makeTerrain() {
+    TerrainData t;
+    t.width = t.height = 128;
+    t.biomeWidth = t.biomeHeight = 128;
+    t.heights.resize(t.width * t.height);
+    t.biomeZones.resize(t.biomeWidth * t.biomeHeight);
+
+    for (uint32_t y = 0; y < t.height; ++y) {
+        for (uint32_t x = 0; x < t.width; ++x) {
+            float h = 0.5f + 0.25f * std::sin(x * 0.11f) * std::cos(y * 0.07f);
+            t.heights[y * t.width + x] = h * 60.0f;
+            float dx = static_cast<float>(x) - 70.0f;
+            float dy = static_cast<float>(y) - 55.0f;
+            bool lake = dx * dx + dy * dy < 18.0f * 18.0f;
+            t.biomeZones[y * t.biomeWidth + x] = static_cast<uint8_t>(lake ? BiomeZone::Sea : BiomeZone::Grassland);
+        }
+    }
+    return t;
+}
+
+PathfinderConfig makeConfig(bool hierarchical) {
+    PathfinderConfig config;
+    config.terrainSize = TERRAIN_SIZE;
+    config.gridResolution = GRID;
+    config.useHierarchical = hierarchical;
+    config.clusterSize = 16;
+    config.entranceSpacing = 4;
+    return config;
+}
+
+bool isContiguous(const std::vector<glm::ivec2>& path) {
+    for (size_t i = 1; i < path.size(); ++i) {
+        glm::ivec2 d = glm::abs(path[i] - path[i - 1]);
+        if (d.x > 1 || d.y > 1 || (d.x == 0 && d.y == 0)) return false;
+    }
+    return true;
+}
+
+std::vector<std::pair<glm::ivec2, glm::ivec2>> makeQueries(size_t count) {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> coord(0, GRID - 1);
+    std::vector<std::pair<glm::ivec2, glm::ivec2>> queries;
+    while (queries.size() < count) {
+        glm::ivec2 a(coord(rng), coord(rng));
+        glm::ivec2 b(coord(rng), coord(rng));
+        if (a != b) queries.emplace_back(a, b);
+    }
+    return queries;
+}
+
+} // namespace
+
+TEST_SUITE("QuaternaryHeap") {
+    TEST_CASE("Pops in ascending key order") {
+        QuaternaryHeap heap;
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> dist(0.0f, 1000.0f);
+        for (int i = 0; i < 500; ++i) heap.push(dist(rng), i);
+
+        float last = -1.0f;
+        size_t popped = 0;
+        while (!heap.empty()) {
+            CHECK(heap.top().key >= last);
+            last = heap.top().key;
+            heap.pop();
+            popped++;
+        }
+        CHECK(popped == 500);
+    }
+}
+
+TEST_SUITE("RoadPathfinder cost regression") {
+    TEST_CASE("Flat-array A* matches reference A* cost") {
+        RoadPathfinder pathfinder;
+        pathfinder.init(makeConfig(false));
+        pathfinder.setTerrainData(makeTerrain());
+
+        size_t compared = 0;
+        for (const auto& [start, end] : makeQueries(24)) {
+            std::vector<glm::ivec2> fast, reference;
+            REQUIRE(pathfinder.findGridPath(start, end, fast));
+
+            // The reference gives up after gridSize^2 heap pops (stale entries
+            // included), which long detours around the lake can exceed
+            if (!pathfinder.findGridPathReference(start, end, reference)) continue;
+            compared++;
+
+            CHECK(fast.front() == start);
+            CHECK(fast.back() == end);
+            CHECK(isContiguous(fast));
+
+            float fastCost = pathfinder.gridPathCost(fast);
+            float refCost = pathfinder.gridPathCost(reference);
+            CHECK(fastCost == doctest::Approx(refCost).epsilon(1e-4));
+        }
+        CHECK(compared >= 12);
+    }
+
+    void checkHierarchicalQuality(uint32_t corridorMargin, float maxRatio) {
+        RoadPathfinder flat;
+        flat.init(makeConfig(false));
+        flat.setTerrainData(makeTerrain());
+
+        PathfinderConfig hpaConfig = makeConfig(true);
+        hpaConfig.corridorMargin = corridorMargin;
+        RoadPathfinder hierarchical;
+        hierarchical.init(hpaConfig);
+        hierarchical.setTerrainData(makeTerrain());
+
+        for (const auto& [start, end] : makeQueries(24)) {
+            std::vector<glm::ivec2> optimal, approx;
+            REQUIRE(flat.findGridPath(start, end, optimal));
+            REQUIRE(hierarchical.findGridPath(start, end, approx));
+
+            CHECK(approx.front() == start);
+            CHECK(approx.back() == end);
+            CHECK(isContiguous(approx));
+
+            float optimalCost = flat.gridPathCost(optimal);
+            float approxCost = hierarchical.gridPathCost(approx);
+            CHECK(approxCost >= optimalCost * 0.9999f);
+            CHECK(approxCost <= optimalCost * maxRatio);
+        }
+    }
+
+    TEST_CASE("HPA* paths are valid and near-optimal") {
+        checkHierarchicalQuality(0, 1.3f);
+    }
+
+    TEST_CASE("HPA* with corridor margin matches optimal closely") {
+        checkHierarchicalQuality(1, 1.02f);
+    }
+}
+
+TEST_SUITE("RoadPathfinder network") {
+    std::vector<Settlement> makeSettlements() {
+        std::vector<Settlement> settlements;
+        const glm::vec2 positions[] = {
+            {400.0f, 400.0f}, {3600.0f, 500.0f}, {2000.0f, 3500.0f},
+            {900.0f, 2600.0f}, {3100.0f, 2900.0f}, {2300.0f, 1200.0f}
+        };
+        uint32_t id = 0;
+        for (const auto& pos : positions) {
+            Settlement s{};
+            s.id = id;
+            s.type = (id % 3 == 0) ? SettlementType::Town : SettlementType::Village;
+            s.position = pos;
+            s.radius = 60.0f;
+            s.score = 1.0f;
+            settlements.push_back(s);
+            id++;
+        }
+        return settlements;
+    }
+
+    TEST_CASE("Parallel and serial generation produce identical networks") {
+        auto settlements = makeSettlements();
+
+        PathfinderConfig serialConfig = makeConfig(false);
+        serialConfig.parallelConnections = false;
+        RoadPathfinder serial;
+        serial.init(serialConfig);
+        serial.setTerrainData(makeTerrain());
+
+        RoadPathfinder parallel;
+        parallel.init(makeConfig(false));
+        parallel.setTerrainData(makeTerrain());
+
+        RoadNetwork a, b;
+        REQUIRE(serial.generateRoadNetwork(settlements, a, [](float, const std::string&) {}));
+        REQUIRE(parallel.generateRoadNetwork(settlements, b, [](float, const std::string&) {}));
+
+        REQUIRE(a.roads.size() == b.roads.size());
+        REQUIRE_FALSE(a.roads.empty());
+        for (size_t i = 0; i < a.roads.size(); ++i) {
+            CHECK(a.roads[i].fromSettlementId == b.roads[i].fromSettlementId);
+            CHECK(a.roads[i].toSettlementId == b.roads[i].toSettlementId);
+            REQUIRE(a.roads[i].controlPoints.size() == b.roads[i].controlPoints.size());
+            for (size_t j = 0; j < a.roads[i].controlPoints.size(); ++j) {
+                CHECK(a.roads[i].controlPoints[j].position == b.roads[i].controlPoints[j].position);
+            }
+        }
+
+        const PathfinderStats& stats = parallel.getStats();
+        CHECK(stats.pathsSolved == b.roads.size());
+        CHECK(stats.nodesExpanded > 0);
+        CHECK(stats.threadCount >= 1);
+    }
+}
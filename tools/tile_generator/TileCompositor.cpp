@@ -6,6 +6,7 @@
 #include <cmath>
 #include <algorithm>
 #include <filesystem>
+#include <atomic>
 #include "../common/bc_compress.h"
 #include "../common/dds_file.h"
 #include "../common/ParallelProgress.h"
@@ -543,9 +544,11 @@ bool TileCompositor::generateMipLevel(uint32_t mipLevel, const std::string& outp
     uint32_t tilesAtMip = config.getTilesAtMip(mipLevel);
     uint32_t totalTiles = tilesAtMip * tilesAtMip;
 
-    // Create mip directory
+    // Create mip directory (loose files only)
     std::string mipDir = outputDir + "/mip" + std::to_string(mipLevel);
-    std::filesystem::create_directories(mipDir);
+    if (!archiveWriter) {
+        std::filesystem::create_directories(mipDir);
+    }
 
     std::string extension = config.useCompression ? ".dds" : ".png";
     std::atomic<bool> hasError{false};
@@ -569,8 +572,22 @@ bool TileCompositor::generateMipLevel(uint32_t mipLevel, const std::string& outp
 
         // Save tile
         std::string filename = mipDir + "/tile_" + std::to_string(tx) + "_" + std::to_string(ty) + extension;
-
-        if (config.useCompression) {
+        TileId id(static_cast<uint16_t>(tx), static_cast<uint16_t>(ty), static_cast<uint8_t>(mipLevel));
+
+        if (archiveWriter) {
+            bool written;
+            if (config.useCompression) {
+                BCCompress::CompressedImage compressed = BCCompress::compressImage(
+                    tile.pixels.data(), tile.resolution, tile.resolution, BCCompress::BCFormat::BC1);
+                written = archiveWriter->writeTile(id, compressed.data.data(), compressed.data.size());
+            } else {
+                written = archiveWriter->writeTile(id, tile.pixels.data(), tile.pixels.size());
+            }
+            if (!written) {
+                hasError.store(true);
+                return;
+            }
+        } else if (config.useCompression) {
             // Compress to BC1 and save as DDS
             BCCompress::CompressedImage compressed = BCCompress::compressImage(
                 tile.pixels.data(), tile.resolution, tile.resolution, BCCompress::BCFormat::BC1);
@@ -608,13 +625,25 @@ bool TileCompositor::generateMipLevel(uint32_t mipLevel, const std::string& outp
     }
 
     SDL_Log("Generated mip level %u: %u tiles (%s)", mipLevel, totalTiles,
-            config.useCompression ? "BC1 DDS" : "PNG");
+            archiveWriter ? (config.useCompression ? "BC1 archive" : "RGBA8 archive")
+                          : (config.useCompression ? "BC1 DDS" : "PNG"));
     return true;
 }
 
 bool TileCompositor::generateAllMips(const std::string& outputDir, ProgressCallback callback) {
     std::filesystem::create_directories(outputDir);
 
+    if (config.writeArchive) {
+        archiveWriter = std::make_unique<VirtualTextureArchiveWriter>();
+        std::string archivePath = outputDir + "/" + VirtualTextureArchive::FILE_NAME;
+        if (!archiveWriter->open(archivePath, config.useCompression ? TileFormat::BC1_SRGB : TileFormat::RGBA8,
+                                 config.tileResolution, config.tileResolution,
+                                 config.tilesPerAxis, config.maxMipLevels)) {
+            archiveWriter.reset();
+            return false;
+        }
+    }
+
     for (uint32_t mip = 0; mip < config.maxMipLevels; ++mip) {
         if (callback) {
             callback(static_cast<float>(mip) / config.maxMipLevels,
@@ -622,6 +651,17 @@ bool TileCompositor::generateAllMips(const std::string& outputDir, ProgressCallb
         }
 
         if (!generateMipLevel(mip, outputDir, callback)) {
+            archiveWriter.reset();
+            return false;
+        }
+    }
+
+    if (archiveWriter) {
+        bool finished = archiveWriter->finish();
+        SDL_Log("Wrote %s (%.1f MB of tile payloads)", VirtualTextureArchive::FILE_NAME,
+                archiveWriter->getPayloadBytes() / (1024.0 * 1024.0));
+        archiveWriter.reset();
+        if (!finished) {
             return false;
         }
     }
@@ -632,6 +672,80 @@ bool TileCompositor::generateAllMips(const std::string& outputDir, ProgressCallb
     return true;
 }
 
+bool TileCompositor::packLooseTiles(const std::string& tileDir, uint32_t tilesPerAxis, uint32_t maxMipLevels) {
+    // The archive holds a single format; detect it from the first tile present
+    bool dds = std::filesystem::exists(tileDir + "/mip0/tile_0_0.dds");
+    bool png = std::filesystem::exists(tileDir + "/mip0/tile_0_0.png");
+    if (!dds && !png) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "No tiles found in %s/mip0", tileDir.c_str());
+        return false;
+    }
+
+    uint32_t tileWidth = 0;
+    uint32_t tileHeight = 0;
+    if (dds) {
+        DDS::Image first = DDS::read(tileDir + "/mip0/tile_0_0.dds");
+        tileWidth = first.width;
+        tileHeight = first.height;
+    } else {
+        std::vector<unsigned char> pixels;
+        lodepng::decode(pixels, tileWidth, tileHeight, tileDir + "/mip0/tile_0_0.png");
+    }
+
+    VirtualTextureArchiveWriter writer;
+    if (!writer.open(tileDir + "/" + VirtualTextureArchive::FILE_NAME,
+                     dds ? TileFormat::BC1_SRGB : TileFormat::RGBA8,
+                     tileWidth, tileHeight, tilesPerAxis, maxMipLevels)) {
+        return false;
+    }
+
+    std::atomic<uint32_t> packed{0};
+    std::atomic<uint32_t> missing{0};
+    std::atomic<bool> hasError{false};
+
+    for (uint32_t mip = 0; mip < maxMipLevels; ++mip) {
+        uint32_t tilesAtMip = std::max(1u, tilesPerAxis >> mip);
+        std::string mipDir = tileDir + "/mip" + std::to_string(mip);
+
+        ParallelProgress::parallel_for(0, static_cast<int>(tilesAtMip * tilesAtMip), [&](int tileIndex) {
+            if (hasError.load()) return;
+
+            uint32_t tx = tileIndex % tilesAtMip;
+            uint32_t ty = tileIndex / tilesAtMip;
+            TileId id(static_cast<uint16_t>(tx), static_cast<uint16_t>(ty), static_cast<uint8_t>(mip));
+            std::string base = mipDir + "/tile_" + std::to_string(tx) + "_" + std::to_string(ty);
+
+            std::vector<uint8_t> payload;
+            if (dds) {
+                DDS::Image image = DDS::read(base + ".dds");
+                payload = std::move(image.data);
+            } else {
+                unsigned w = 0, h = 0;
+                if (lodepng::decode(payload, w, h, base + ".png") != 0) payload.clear();
+            }
+
+            if (payload.empty()) {
+                missing++;
+                return;
+            }
+            if (!writer.writeTile(id, payload.data(), payload.size())) {
+                hasError.store(true);
+                return;
+            }
+            packed++;
+        });
+    }
+
+    if (hasError.load() || !writer.finish()) {
+        return false;
+    }
+
+    SDL_Log("Packed %u tiles (%u missing) into %s/%s (%.1f MB of payloads)",
+            packed.load(), missing.load(), tileDir.c_str(), VirtualTextureArchive::FILE_NAME,
+            writer.getPayloadBytes() / (1024.0 * 1024.0));
+    return true;
+}
+
 bool TileCompositor::saveMetadata(const std::string& outputDir) const {
     nlohmann::json metadata;
 
@@ -642,6 +756,9 @@ bool TileCompositor::saveMetadata(const std::string& outputDir) const {
     metadata["maxMipLevels"] = config.maxMipLevels;
     metadata["minAltitude"] = config.minAltitude;
     metadata["maxAltitude"] = config.maxAltitude;
+    if (config.writeArchive) {
+        metadata["archive"] = VirtualTextureArchive::FILE_NAME;
+    }
 
     // Mip level info
     nlohmann::json mips = nlohmann::json::array();
@@ -4,10 +4,12 @@
 #include "SplineRasterizer.h"
 #include "../road_generator/RoadSpline.h"
 #include "BiomeGenerator.h"
+#include "terrain/virtual_texture/VirtualTextureArchive.h"
 #include <vector>
 #include <string>
 #include <functional>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <glm/glm.hpp>
 
@@ -35,6 +37,10 @@ struct TileCompositorConfig {
     // BCn compression option
     bool useCompression = false;         // Output BC1 compressed DDS instead of PNG
 
+    // Write the full mip chain into one packed archive (tiles.vtpack) instead of
+    // one file per tile. Payloads are raw BC1 (useCompression) or raw RGBA8.
+    bool writeArchive = false;
+
     // Get tile size in world units
     float getTileSize() const {
         return terrainSize / tilesPerAxis;
@@ -166,6 +172,13 @@ public:
     bool generateAllMips(const std::string& outputDir,
                          ProgressCallback callback = nullptr);
 
+    /**
+     * Pack an existing loose-file tile set (mip{N}/tile_X_Y.dds or .png) into
+     * <tileDir>/tiles.vtpack. DDS tiles are stored as BC1, PNG tiles as RGBA8;
+     * a tile set must not mix the two.
+     */
+    static bool packLooseTiles(const std::string& tileDir, uint32_t tilesPerAxis, uint32_t maxMipLevels);
+
     // Save metadata JSON
     bool saveMetadata(const std::string& outputDir) const;
 
@@ -196,6 +209,9 @@ private:
 
     std::string materialBasePath;
     bool dataLoaded = false;
+
+    // Set by generateAllMips when writing a packed archive
+    std::unique_ptr<VirtualTextureArchiveWriter> archiveWriter;
 };
 
 } // namespace VirtualTexture
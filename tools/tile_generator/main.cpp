@@ -3,6 +3,12 @@
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
 #include <SDL3/SDL_log.h>
 
 void printUsage(const char* programName) {
@@ -24,6 +30,11 @@ void printUsage(const char* programName) {
     SDL_Log("  --single-mip <n>      Generate only a single mip level");
     SDL_Log("  --single-tile <x,y,m> Generate a single tile at x,y,mip level");
     SDL_Log("  --compress, --dds     Output BC1 compressed DDS files (default: PNG)");
+    SDL_Log("  --archive             Write all mips into one packed tiles.vtpack instead of loose files");
+    SDL_Log("");
+    SDL_Log("Standalone modes (no heightmap/biome map needed):");
+    SDL_Log("  --pack <dir>          Pack existing loose tiles in <dir> into <dir>/tiles.vtpack");
+    SDL_Log("  --bench-io <dir>      Compare loose-file and archive tile reads for <dir>");
     SDL_Log("  --help                Show this help message");
 }
 
@@ -48,6 +59,10 @@ struct GeneratorOptions {
     uint32_t singleTileMip = 0;
 
     bool useCompression = false;  // Output BC1 compressed DDS files
+    bool writeArchive = false;    // Output tiles.vtpack instead of loose files
+
+    std::string packDir;          // --pack: convert loose tiles, then exit
+    std::string benchDir;         // --bench-io: compare read paths, then exit
 };
 
 bool parseArguments(int argc, char* argv[], GeneratorOptions& opts) {
@@ -106,12 +121,25 @@ bool parseArguments(int argc, char* argv[], GeneratorOptions& opts) {
         else if (arg == "--compress" || arg == "--dds" || arg == "-c") {
             opts.useCompression = true;
         }
+        else if (arg == "--archive") {
+            opts.writeArchive = true;
+        }
+        else if (arg == "--pack" && i + 1 < argc) {
+            opts.packDir = argv[++i];
+        }
+        else if (arg == "--bench-io" && i + 1 < argc) {
+            opts.benchDir = argv[++i];
+        }
         else {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unknown argument: %s", arg.c_str());
             return false;
         }
     }
 
+    if (!opts.packDir.empty() || !opts.benchDir.empty()) {
+        return true;
+    }
+
     // Validate required arguments
     if (opts.heightmapPath.empty()) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Missing required argument: --heightmap");
@@ -129,6 +157,71 @@ bool parseArguments(int argc, char* argv[], GeneratorOptions& opts) {
     return true;
 }
 
+// Read every tile of the mip chain once through the loose-file layout and
+// once through the archive, the way VirtualTextureTileLoader would
+int benchTileIO(const std::string& tileDir, uint32_t tilesPerAxis, uint32_t maxMipLevels) {
+    using Clock = std::chrono::steady_clock;
+    using VirtualTexture::TileId;
+
+    auto archive = VirtualTexture::VirtualTextureArchive::open(
+        tileDir + "/" + VirtualTexture::VirtualTextureArchive::FILE_NAME);
+    if (!archive) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "No archive in %s (run --pack first)", tileDir.c_str());
+        return 1;
+    }
+
+    std::vector<TileId> tiles;
+    for (uint32_t mip = 0; mip < maxMipLevels; ++mip) {
+        uint32_t tilesAtMip = std::max(1u, tilesPerAxis >> mip);
+        for (uint32_t y = 0; y < tilesAtMip; ++y) {
+            for (uint32_t x = 0; x < tilesAtMip; ++x) {
+                tiles.emplace_back(static_cast<uint16_t>(x), static_cast<uint16_t>(y), static_cast<uint8_t>(mip));
+            }
+        }
+    }
+
+    // Loose files: one open per tile (two when the DDS is missing and PNG is tried)
+    uint64_t looseOpens = 0;
+    uint64_t looseBytes = 0;
+    uint32_t looseTiles = 0;
+    auto looseStart = Clock::now();
+    for (const TileId& id : tiles) {
+        std::string base = tileDir + "/mip" + std::to_string(id.mipLevel) + "/tile_" +
+                           std::to_string(id.x) + "_" + std::to_string(id.y);
+        for (const char* ext : {".dds", ".png"}) {
+            ++looseOpens;
+            std::ifstream file(base + ext, std::ios::binary);
+            if (!file) continue;
+            std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            looseBytes += bytes.size();
+            ++looseTiles;
+            break;
+        }
+    }
+    double looseSeconds = std::chrono::duration<double>(Clock::now() - looseStart).count();
+
+    uint64_t archiveBytes = 0;
+    uint32_t archiveTiles = 0;
+    VirtualTexture::LoadedTile tile;
+    auto archiveStart = Clock::now();
+    for (const TileId& id : tiles) {
+        if (archive->readTile(id, tile)) {
+            archiveBytes += tile.pixels.size();
+            ++archiveTiles;
+        }
+    }
+    double archiveSeconds = std::chrono::duration<double>(Clock::now() - archiveStart).count();
+
+    SDL_Log("%-10s %10s %12s %12s %10s", "layout", "tiles", "tiles/sec", "MB", "opens");
+    SDL_Log("%-10s %10u %12.0f %12.1f %10llu", "loose", looseTiles,
+            looseSeconds > 0.0 ? looseTiles / looseSeconds : 0.0, looseBytes / (1024.0 * 1024.0),
+            static_cast<unsigned long long>(looseOpens));
+    SDL_Log("%-10s %10u %12.0f %12.1f %10u", "archive", archiveTiles,
+            archiveSeconds > 0.0 ? archiveTiles / archiveSeconds : 0.0, archiveBytes / (1024.0 * 1024.0), 1u);
+    SDL_Log("Note: run with a cold page cache for disk-bound numbers");
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     GeneratorOptions opts;
 
@@ -137,6 +230,13 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    if (!opts.packDir.empty()) {
+        return VirtualTexture::TileCompositor::packLooseTiles(opts.packDir, opts.tilesPerAxis, opts.maxMipLevels) ? 0 : 1;
+    }
+    if (!opts.benchDir.empty()) {
+        return benchTileIO(opts.benchDir, opts.tilesPerAxis, opts.maxMipLevels);
+    }
+
     SDL_Log("=== Virtual Texture Tile Generator ===");
     SDL_Log("Heightmap:      %s", opts.heightmapPath.c_str());
     SDL_Log("Biome map:      %s", opts.biomemapPath.c_str());
@@ -146,7 +246,11 @@ int main(int argc, char* argv[]) {
     SDL_Log("Tile resolution: %u px", opts.tileResolution);
     SDL_Log("Tiles/axis:     %u", opts.tilesPerAxis);
     SDL_Log("Max mip levels: %u", opts.maxMipLevels);
-    SDL_Log("Output format:  %s", opts.useCompression ? "BC1 DDS (compressed)" : "PNG");
+    if (opts.writeArchive) {
+        SDL_Log("Output format:  %s in tiles.vtpack", opts.useCompression ? "BC1" : "RGBA8");
+    } else {
+        SDL_Log("Output format:  %s", opts.useCompression ? "BC1 DDS (compressed)" : "PNG");
+    }
 
     // Setup compositor config
     VirtualTexture::TileCompositorConfig config;
@@ -155,6 +259,7 @@ int main(int argc, char* argv[]) {
     config.tilesPerAxis = opts.tilesPerAxis;
     config.maxMipLevels = opts.maxMipLevels;
     config.useCompression = opts.useCompression;
+    config.writeArchive = opts.writeArchive;
 
     // Create compositor
     VirtualTexture::TileCompositor compositor;
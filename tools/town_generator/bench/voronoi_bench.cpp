@@ -0,0 +1,75 @@
+// Voronoi construction benchmark
+// Times incremental insertion (City's path), Hilbert-ordered build() and one
+// Lloyd relaxation step at increasing site counts.
+
+#include "town_generator/geom/Voronoi.h"
+
+#include <SDL3/SDL.h>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace town_generator::geom;
+
+namespace {
+
+std::vector<Point> randomSites(size_t count, double size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(0.0, size);
+    std::vector<Point> sites;
+    sites.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        sites.emplace_back(dist(rng), dist(rng));
+    }
+    return sites;
+}
+
+template <typename Fn>
+double timeMs(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<size_t> counts = {1000, 10000, 100000};
+    if (argc > 1) {
+        counts.clear();
+        for (int i = 1; i < argc; ++i) {
+            counts.push_back(static_cast<size_t>(std::strtoull(argv[i], nullptr, 10)));
+        }
+    }
+
+    const double size = 1000.0;
+    SDL_Log("%10s %14s %14s %14s %12s", "sites", "addPoint (ms)", "build (ms)", "relax (ms)", "triangles");
+
+    for (size_t count : counts) {
+        auto sites = randomSites(count, size, 1234);
+        size_t triangleCount = 0;
+
+        double incrementalMs = timeMs([&] {
+            Voronoi voronoi(0, 0, size, size);
+            for (const auto& p : sites) voronoi.addPoint(p);
+            triangleCount = voronoi.triangles.size();
+        });
+
+        double buildMs = timeMs([&] {
+            Voronoi voronoi = Voronoi::build(sites);
+            (void)voronoi;
+        });
+
+        double relaxMs = timeMs([&] {
+            auto relaxed = Voronoi::relax(sites, size, size);
+            (void)relaxed;
+        });
+
+        SDL_Log("%10zu %14.1f %14.1f %14.1f %12zu", count, incrementalMs, buildMs, relaxMs, triangleCount);
+    }
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace town_generator {
+namespace building {
+
+/**
+ * TownBatch - Generate many towns concurrently
+ *
+ * Each town runs start to finish on one worker thread with its own seed.
+ * Random and Forester state are per thread and reset by City's constructor,
+ * so a town's output depends only on its request, never on thread count or
+ * scheduling order, and matches a standalone town_generator run with the
+ * same --seed/--cells.
+ */
+struct TownRequest {
+    uint32_t id = 0;
+    std::string type;           // Settlement type name from settlements.json
+    int cells = 30;
+    int seed = 1;
+    int coastOverride = -1;     // -1 = use random, 0 = no coast, 1 = force coast
+};
+
+struct TownResult {
+    uint32_t id = 0;
+    std::string type;
+    int cells = 0;
+    int seed = 0;
+    bool success = false;
+    std::string error;
+    std::string svg;
+    uint64_t hash = 0;          // FNV-1a of svg
+    double buildMillis = 0.0;   // City construction + build()
+    double writeMillis = 0.0;   // SVG generation
+};
+
+// Per-town seed derived from the batch seed and settlement id (never 0, which stalls the LCG)
+int deriveTownSeed(int batchSeed, uint32_t id);
+
+// City size for a settlement type name (hamlet, village, fishing_village, town)
+int cellsForSettlementType(const std::string& type);
+
+// 64-bit FNV-1a hash used to compare outputs across runs
+uint64_t hashOutput(const std::string& data);
+
+/**
+ * Read a settlements.json written by settlement_generator into town requests,
+ * in file order. Fishing villages force a coast.
+ * @return false if the file cannot be read or parsed
+ */
+bool loadSettlementRequests(const std::string& path, int batchSeed, std::vector<TownRequest>& outRequests);
+
+/**
+ * Generate all towns on threadCount workers (0 = all cores).
+ * Results are returned in request order regardless of completion order.
+ */
+std::vector<TownResult> generateTowns(const std::vector<TownRequest>& requests, unsigned int threadCount);
+
+} // namespace building
+} // namespace town_generator
@@ -3,7 +3,9 @@
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <memory>
 
 namespace town_generator {
@@ -11,6 +13,12 @@ namespace geom {
 
 class Node;
 
+// Orders nodes by creation so link iteration (and A* tie-breaking) does not
+// depend on heap addresses
+struct NodeOrder {
+    bool operator()(const Node* a, const Node* b) const;
+};
+
 /**
  * Graph - Graph with A* pathfinding, faithful port from Haxe TownGeneratorOS
  */
@@ -44,7 +52,8 @@ private:
  */
 class Node {
 public:
-    std::map<Node*, double> links;
+    std::map<Node*, double, NodeOrder> links;
+    uint64_t serial = nextSerial();  // Creation order, used by NodeOrder
 
     Node() = default;
 
@@ -77,7 +86,17 @@ public:
     bool operator!=(const Node& other) const {
         return !(*this == other);
     }
+
+private:
+    static uint64_t nextSerial() {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
 };
 
+inline bool NodeOrder::operator()(const Node* a, const Node* b) const {
+    return a->serial < b->serial;
+}
+
 } // namespace geom
 } // namespace town_generator
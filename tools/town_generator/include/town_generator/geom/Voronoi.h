@@ -5,6 +5,7 @@
 #include <cmath>
 #include <algorithm>
 #include <memory>
+#include <cstdint>
 
 namespace town_generator {
 namespace geom {
@@ -20,8 +21,20 @@ public:
     Point c;  // Circumcircle center
     double r; // Circumcircle radius
 
+    // Triangulation bookkeeping, maintained by Voronoi
+    Triangle* adjacent[3] = {nullptr, nullptr, nullptr}; // Across edges p1-p2, p2-p3, p3-p1
+    Region* owners[3] = {nullptr, nullptr, nullptr};     // Regions seeded at p1, p2, p3
+    size_t index = 0;       // Position in Voronoi::triangles
+    uint64_t serial = 0;    // Creation order
+    uint64_t visitStamp = 0;
+    bool inCavity = false;
+
     Triangle(const Point& p1, const Point& p2, const Point& p3);
 
+    const Point& vertex(int i) const {
+        return i == 0 ? p1 : (i == 1 ? p2 : p3);
+    }
+
     bool isInCircumcircle(const Point& p) const {
         return Point::distance(p, c) < r;
     }
@@ -43,6 +56,7 @@ class Region {
 public:
     Point seed;
     std::vector<Triangle*> vertices; // Triangles whose circumcenters form the region
+    int id = -1;                     // Index in the owning Voronoi::regions
 
     Region() = default;
     explicit Region(const Point& seed) : seed(seed) {}
@@ -66,6 +80,12 @@ public:
 /**
  * Voronoi - Voronoi tessellation via Delaunay triangulation
  * Faithful port from Haxe TownGeneratorOS
+ *
+ * Bowyer-Watson insertion walks the triangle adjacency to the triangle under
+ * the new point and grows the cavity from there, instead of testing every
+ * triangle. Cavity triangles are retriangulated in creation order with their
+ * original vertex order, so circumcenters and regions are bit-identical to
+ * the brute-force port. The order of `triangles` itself is unspecified.
  */
 class Voronoi {
 private:
@@ -86,7 +106,8 @@ public:
     // Lloyd's relaxation
     static std::vector<Point> relax(const std::vector<Point>& vertices, double width, double height);
 
-    // Build Voronoi from point set
+    // Build Voronoi from point set. Points are inserted in Hilbert curve order
+    // for locality; regions keep the input order.
     static Voronoi build(const std::vector<Point>& vertices);
 
     // Get frame
@@ -113,8 +134,17 @@ public:
     }
 
 private:
-    void updateRegions(Triangle* tr);
-    Region* findRegion(const Point& p);
+    // Insert p owned by region; returns false if no triangle's circumcircle contains p
+    bool insert(const Point& p, Region* region);
+    Triangle* locate(const Point& p) const;
+    Triangle* addTriangle(const Point& a, const Point& b, const Point& c,
+                          Region* ra, Region* rb, Region* rc);
+    void removeTriangle(Triangle* tr);
+    void addRegion(std::unique_ptr<Region> region);
+
+    uint64_t nextSerial_ = 0;
+    uint64_t stamp_ = 0;
+    Triangle* lastTriangle_ = nullptr;
 };
 
 } // namespace geom
@@ -5,6 +5,7 @@
 #include "town_generator/utils/Noise.h"
 #include "town_generator/utils/Random.h"
 #include <vector>
+#include <memory>
 
 namespace town_generator {
 namespace utils {
@@ -54,10 +55,15 @@ public:
      */
     static Perlin& getNoise();
 
+    /**
+     * Drop the shared noise so the next getNoise() reseeds from Random.
+     * Called per city so each one draws it from its own sequence.
+     */
+    static void resetNoise();
+
 private:
-    // Shared Perlin noise for consistent patterns (lazy-initialized)
-    static Perlin* noise_;
-    static bool noiseInitialized_;
+    // Shared Perlin noise for consistent patterns (lazy-initialized, per thread)
+    static thread_local std::unique_ptr<Perlin> noise_;
 
     /**
      * Generate hex grid points within a bounding box
@@ -28,9 +28,6 @@ public:
         for (int i = 0; i < 256; ++i) {
             p_[i + 256] = p_[i];
         }
-
-        // Precompute smoothstep lookup table
-        initSmooth();
     }
 
     double get(double x, double y) const {
@@ -73,8 +70,6 @@ public:
 
 private:
     std::array<int, 512> p_;
-    static std::vector<double> smooth_;
-    static bool smoothInitialized_;
 
     // Ken Perlin's improved permutation table
     static constexpr int PERMUTATION[256] = {
@@ -96,22 +91,25 @@ private:
         222, 114, 67, 29, 24, 72, 243, 141, 128, 195, 78, 66, 215, 61, 156, 180
     };
 
-    static void initSmooth() {
-        if (smoothInitialized_) return;
-        smooth_.resize(4096);
-        for (int i = 0; i < 4096; ++i) {
-            double t = static_cast<double>(i) / 4096.0;
-            // Smoothstep: 6t^5 - 15t^4 + 10t^3
-            smooth_[i] = t * t * t * (t * (6 * t - 15) + 10);
-        }
-        smoothInitialized_ = true;
+    // Smoothstep lookup table, built once (thread-safe static init)
+    static const std::vector<double>& smoothTable() {
+        static const std::vector<double> table = [] {
+            std::vector<double> t(4096);
+            for (int i = 0; i < 4096; ++i) {
+                double x = static_cast<double>(i) / 4096.0;
+                // Smoothstep: 6t^5 - 15t^4 + 10t^3
+                t[i] = x * x * x * (x * (6 * x - 15) + 10);
+            }
+            return t;
+        }();
+        return table;
     }
 
     double smooth(double t) const {
         int idx = static_cast<int>(t * 4096);
         if (idx < 0) idx = 0;
         if (idx >= 4096) idx = 4095;
-        return smooth_[idx];
+        return smoothTable()[idx];
     }
 
     // Gradient function (faithful to mfcg.js)
@@ -126,10 +124,6 @@ private:
     }
 };
 
-// Static member initialization
-inline std::vector<double> Perlin::smooth_;
-inline bool Perlin::smoothInitialized_ = false;
-
 /**
  * FractalNoise - Multi-octave fractal noise
  * Faithful port from mfcg.js pg (Noise) class with fractal() factory
@@ -9,6 +9,9 @@ namespace utils {
 /**
  * Random - Seeded PRNG, faithful port from Haxe TownGeneratorOS
  * Uses linear congruential generator matching the original Haxe implementation
+ *
+ * State is per thread, so cities generated concurrently on different threads
+ * each follow their own seeded sequence (City's constructor calls reset()).
  */
 class Random {
 private:
@@ -16,8 +19,8 @@ private:
     static constexpr double g = 48271.0;
     static constexpr int64_t n = 2147483647;
 
-    static int64_t seed_;
-    static int64_t savedSeed_;  // For save/restore
+    static thread_local int64_t seed_;
+    static thread_local int64_t savedSeed_;  // For save/restore
 
     static int64_t next() {
         seed_ = static_cast<int64_t>(static_cast<double>(seed_) * g) % n;
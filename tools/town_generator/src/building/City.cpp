@@ -3,6 +3,7 @@
 #include "town_generator/building/Topology.h"
 #include "town_generator/geom/EdgeChain.h"
 #include "town_generator/utils/Noise.h"
+#include "town_generator/utils/Forester.h"
 #include <iostream>
 #include <SDL3/SDL_log.h>
 #include "town_generator/wards/Ward.h"
@@ -18,6 +19,7 @@
 #include <cmath>
 #include <limits>
 #include <map>
+#include <optional>
 #include <set>
 #include <stdexcept>
 
@@ -26,6 +28,7 @@ namespace building {
 
 City::City(int nCells, int seed) : nCells_(nCells) {
     utils::Random::reset(seed);
+    utils::Forester::resetNoise();
 
     // Random city features - size-dependent probabilities (faithful to MFCG Blueprint)
     // Reference: 01-blueprint-building.js lines 22-43
@@ -297,6 +300,7 @@ void City::buildPatches() {
 
         // Mark cells as water based on distance from coast center
         int waterCount = 0;
+        std::optional<utils::FractalNoise> coastNoise;
         for (auto* patch : cells) {
             geom::Point c = patchCentroids[patch];
 
@@ -320,8 +324,9 @@ void City::buildPatches() {
             double nx = (rotated.x + b) / (2.0 * b);
             double ny = (rotated.y + b) / (2.0 * b);
             // Use proper fractal noise (6 octaves, faithful to mfcg.js)
-            static utils::FractalNoise coastNoise = utils::FractalNoise::create(6, 1.0, 0.5);
-            double noise = coastNoise.get(nx, ny);
+            // Created on first use so it draws from this city's Random sequence
+            if (!coastNoise) coastNoise = utils::FractalNoise::create(6, 1.0, 0.5);
+            double noise = coastNoise->get(nx, ny);
             double r = noise * n * std::sqrt(rotated.length() / b);
 
             // Mark as water if inside the coastline (u + r < 0)
@@ -855,13 +860,16 @@ void City::buildStreets() {
                 geom::Point dir = center.add(gateDir.norm(1000));  // Point 1000 units from center in gate direction
 
                 geom::PointPtr startPtr = nullptr;
+                geom::Node* startNode = nullptr;
                 double dist = std::numeric_limits<double>::infinity();
 
+                // Ties go to the oldest node; pt2node iteration order depends on addresses
                 for (const auto& [ptPtr, node] : topology_->pt2node) {
                     double d = geom::Point::distance(*ptPtr, dir);
-                    if (d < dist) {
+                    if (d < dist || (d == dist && startNode && geom::NodeOrder()(node, startNode))) {
                         dist = d;
                         startPtr = ptPtr;
+                        startNode = node;
                     }
                 }
 
@@ -1083,11 +1091,14 @@ std::vector<std::vector<Cell*>> City::splitIntoConnectedComponents(const std::ve
     // Create a set of cells we need to process
     std::set<Cell*> remaining(patchList.begin(), patchList.end());
 
-    while (!remaining.empty()) {
-        // Start a new component with any remaining patch
+    for (Cell* start : patchList) {
+        // Start each component at the first remaining patch in list order;
+        // pointer order would make the result depend on heap layout
+        if (remaining.find(start) == remaining.end()) continue;
+
         std::vector<Cell*> component;
         std::vector<Cell*> queue;
-        queue.push_back(*remaining.begin());
+        queue.push_back(start);
 
         // Flood fill through neighbors
         while (!queue.empty()) {
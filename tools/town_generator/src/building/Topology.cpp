@@ -197,21 +197,15 @@ std::vector<geom::Point> Topology::buildPath(
     geom::Node* fromNode = nullptr;
     geom::Node* toNode = nullptr;
 
-    // Find node matching 'from' by coordinates - require exact match
+    // Find nodes matching 'from' and 'to' by coordinates - require exact match.
+    // pt2node is hashed by address, so prefer the oldest node when several match.
+    geom::NodeOrder order;
     for (const auto& [ptPtr, node] : pt2node) {
-        double d = geom::Point::distance(from, *ptPtr);
-        if (d < 0.001) {  // Exact match only
+        if (geom::Point::distance(from, *ptPtr) < 0.001 && (!fromNode || order(node, fromNode))) {
             fromNode = node;
-            break;
         }
-    }
-
-    // Find node matching 'to' by coordinates - require exact match
-    for (const auto& [ptPtr, node] : pt2node) {
-        double d = geom::Point::distance(to, *ptPtr);
-        if (d < 0.001) {  // Exact match only
+        if (geom::Point::distance(to, *ptPtr) < 0.001 && (!toNode || order(node, toNode))) {
             toNode = node;
-            break;
         }
     }
 
@@ -0,0 +1,130 @@
+#include "town_generator/building/TownBatch.h"
+#include "town_generator/building/City.h"
+#include "town_generator/svg/SVGWriter.h"
+#include "../../../common/ParallelProgress.h"
+
+#include <SDL3/SDL_log.h>
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <exception>
+#include <fstream>
+
+namespace town_generator {
+namespace building {
+
+int deriveTownSeed(int batchSeed, uint32_t id) {
+    // SplitMix64 finalizer over (batchSeed, id)
+    uint64_t z = (static_cast<uint64_t>(static_cast<uint32_t>(batchSeed)) << 32) | id;
+    z += 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+
+    // Random's LCG modulus is 2^31 - 1; keep the seed in [1, 2^31 - 2]
+    return static_cast<int>(z % 2147483646ull) + 1;
+}
+
+int cellsForSettlementType(const std::string& type) {
+    if (type == "hamlet") return 8;
+    if (type == "village") return 15;
+    if (type == "fishing_village") return 15;
+    if (type == "town") return 30;
+    return 15;
+}
+
+uint64_t hashOutput(const std::string& data) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+bool loadSettlementRequests(const std::string& path, int batchSeed, std::vector<TownRequest>& outRequests) {
+    std::ifstream file(path);
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open settlements file: %s", path.c_str());
+        return false;
+    }
+
+    nlohmann::json j;
+    try {
+        file >> j;
+    } catch (const nlohmann::json::exception& e) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to parse %s: %s", path.c_str(), e.what());
+        return false;
+    }
+
+    if (!j.contains("settlements") || !j["settlements"].is_array()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s has no settlements array", path.c_str());
+        return false;
+    }
+
+    outRequests.clear();
+    for (const auto& sj : j["settlements"]) {
+        TownRequest request;
+        request.id = sj.value("id", static_cast<uint32_t>(outRequests.size()));
+        request.type = sj.value("type", std::string("village"));
+        request.cells = cellsForSettlementType(request.type);
+        request.seed = deriveTownSeed(batchSeed, request.id);
+        if (request.type == "fishing_village") {
+            request.coastOverride = 1;
+        }
+        outRequests.push_back(request);
+    }
+
+    return true;
+}
+
+namespace {
+
+TownResult generateTown(const TownRequest& request) {
+    using Clock = std::chrono::steady_clock;
+
+    TownResult result;
+    result.id = request.id;
+    result.type = request.type;
+    result.cells = request.cells;
+    result.seed = request.seed;
+
+    try {
+        auto buildStart = Clock::now();
+        City model(request.cells, request.seed);
+        if (request.coastOverride == 1) {
+            model.coastNeeded = true;
+        } else if (request.coastOverride == 0) {
+            model.coastNeeded = false;
+        }
+        model.build();
+        auto buildEnd = Clock::now();
+
+        result.svg = svg::SVGWriter::generate(model);
+        auto writeEnd = Clock::now();
+
+        result.hash = hashOutput(result.svg);
+        result.buildMillis = std::chrono::duration<double, std::milli>(buildEnd - buildStart).count();
+        result.writeMillis = std::chrono::duration<double, std::milli>(writeEnd - buildEnd).count();
+        result.success = true;
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+
+    return result;
+}
+
+} // namespace
+
+std::vector<TownResult> generateTowns(const std::vector<TownRequest>& requests, unsigned int threadCount) {
+    std::vector<TownResult> results(requests.size());
+
+    // Dynamic scheduling: town sizes vary a lot, so workers pull the next town
+    ParallelProgress::parallel_for_dynamic(0, static_cast<int>(requests.size()), threadCount, [&](int i) {
+        results[i] = generateTown(requests[i]);
+    });
+
+    return results;
+}
+
+} // namespace building
+} // namespace town_generator
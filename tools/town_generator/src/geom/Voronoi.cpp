@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <cstdint>
 
 namespace town_generator {
 namespace geom {
@@ -63,26 +64,53 @@ Point Region::center() const {
 }
 
 std::vector<Region*> Region::neighbors(const std::vector<std::unique_ptr<Region>>& allRegions) const {
+    // Regions sharing a triangle are exactly the other owners of our triangles.
+    // Results stay in allRegions order.
     std::vector<Region*> result;
 
-    for (const auto& other : allRegions) {
-        if (other.get() == this) continue;
-
-        // Check if they share a triangle
-        for (const auto* myTr : vertices) {
-            for (const auto* theirTr : other->vertices) {
-                if (myTr == theirTr) {
-                    result.push_back(other.get());
-                    goto nextRegion;
-                }
+    for (const auto* tr : vertices) {
+        for (auto* other : tr->owners) {
+            if (!other || other == this || other->id < 0) continue;
+            if (static_cast<size_t>(other->id) >= allRegions.size()) continue;
+            if (allRegions[other->id].get() != other) continue;
+            if (std::find(result.begin(), result.end(), other) == result.end()) {
+                result.push_back(other);
             }
         }
-        nextRegion:;
     }
 
+    std::sort(result.begin(), result.end(),
+        [](const Region* a, const Region* b) { return a->id < b->id; });
     return result;
 }
 
+namespace {
+
+// Twice the signed area of (a, b, c)
+double orient(const Point& a, const Point& b, const Point& c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+// Position along a Hilbert curve over a 2^16 grid
+uint64_t hilbertIndex(uint32_t x, uint32_t y) {
+    uint64_t d = 0;
+    for (uint32_t s = 1u << 15; s > 0; s >>= 1) {
+        uint32_t rx = (x & s) ? 1 : 0;
+        uint32_t ry = (y & s) ? 1 : 0;
+        d += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - x;
+                y = s - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+} // namespace
+
 // Voronoi implementation
 Voronoi::Voronoi(double minx, double miny, double maxx, double maxy) {
     // Create bounding frame as a rectangle (faithful to Haxe TownGeneratorOS)
@@ -94,128 +122,194 @@ Voronoi::Voronoi(double minx, double miny, double maxx, double maxy) {
 
     frame_ = {c1, c2, c3, c4};
 
-    // Create 2 initial triangles covering the rectangle
-    triangles.push_back(std::make_unique<Triangle>(c1, c2, c3));
-    triangles.push_back(std::make_unique<Triangle>(c2, c3, c4));
-
     // Create regions for frame points
+    std::vector<Region*> frameRegions;
     for (const auto& p : frame_) {
         auto region = std::make_unique<Region>(p);
-        // Each frame point is part of adjacent triangles
-        for (const auto& tr : triangles) {
-            if (tr->p1 == p || tr->p2 == p || tr->p3 == p) {
-                region->vertices.push_back(tr.get());
-            }
+        frameRegions.push_back(region.get());
+        addRegion(std::move(region));
+    }
+
+    // Create 2 initial triangles covering the rectangle; they share edge c2-c3
+    Triangle* t0 = addTriangle(c1, c2, c3, frameRegions[0], frameRegions[1], frameRegions[2]);
+    Triangle* t1 = addTriangle(c2, c3, c4, frameRegions[1], frameRegions[2], frameRegions[3]);
+    t0->adjacent[1] = t1;
+    t1->adjacent[0] = t0;
+
+    for (auto* tr : {t0, t1}) {
+        for (auto* owner : tr->owners) {
+            owner->vertices.push_back(tr);
         }
-        regions.push_back(std::move(region));
     }
 }
 
-Region* Voronoi::findRegion(const Point& p) {
-    for (auto& region : regions) {
-        if (region->seed == p) {
-            return region.get();
+void Voronoi::addRegion(std::unique_ptr<Region> region) {
+    region->id = static_cast<int>(regions.size());
+    regions.push_back(std::move(region));
+}
+
+Triangle* Voronoi::addTriangle(const Point& a, const Point& b, const Point& c,
+                               Region* ra, Region* rb, Region* rc) {
+    auto tr = std::make_unique<Triangle>(a, b, c);
+    tr->owners[0] = ra;
+    tr->owners[1] = rb;
+    tr->owners[2] = rc;
+    tr->index = triangles.size();
+    tr->serial = nextSerial_++;
+
+    Triangle* ptr = tr.get();
+    triangles.push_back(std::move(tr));
+    lastTriangle_ = ptr;
+    return ptr;
+}
+
+void Voronoi::removeTriangle(Triangle* tr) {
+    if (lastTriangle_ == tr) lastTriangle_ = nullptr;
+
+    size_t index = tr->index;
+    if (index + 1 != triangles.size()) {
+        std::swap(triangles[index], triangles.back());
+        triangles[index]->index = index;
+    }
+    triangles.pop_back();
+}
+
+Triangle* Voronoi::locate(const Point& p) const {
+    Triangle* tr = lastTriangle_ ? lastTriangle_ : (triangles.empty() ? nullptr : triangles.back().get());
+
+    // Visibility walk: step across any edge that separates p from the opposite vertex.
+    // Terminates on Delaunay triangulations; the step limit guards degenerate input.
+    for (size_t steps = 0; tr && steps <= triangles.size(); ++steps) {
+        Triangle* next = nullptr;
+        bool crossed = false;
+        for (int e = 0; e < 3; ++e) {
+            const Point& a = tr->vertex(e);
+            const Point& b = tr->vertex((e + 1) % 3);
+            const Point& c = tr->vertex((e + 2) % 3);
+            if (orient(a, b, p) * orient(a, b, c) < 0) {
+                next = tr->adjacent[e];
+                crossed = true;
+                break;
+            }
         }
+        if (!crossed) return tr;
+        tr = next;
     }
     return nullptr;
 }
 
-void Voronoi::updateRegions(Triangle* tr) {
-    // Add this triangle to all three vertex regions
-    auto* r1 = findRegion(tr->p1);
-    auto* r2 = findRegion(tr->p2);
-    auto* r3 = findRegion(tr->p3);
-
-    if (r1) r1->vertices.push_back(tr);
-    if (r2) r2->vertices.push_back(tr);
-    if (r3) r3->vertices.push_back(tr);
-}
+bool Voronoi::insert(const Point& p, Region* region) {
+    // Any triangle whose circumcircle contains p seeds the cavity; the one under
+    // p almost always does. Fall back to a scan for points outside the frame.
+    Triangle* seed = locate(p);
+    if (!seed || !seed->isInCircumcircle(p)) {
+        seed = nullptr;
+        for (auto& tr : triangles) {
+            if (tr->isInCircumcircle(p)) {
+                seed = tr.get();
+                break;
+            }
+        }
+    }
+    if (!seed) return false;
 
-void Voronoi::addPoint(const Point& p) {
-    // Find all triangles whose circumcircle contains the new point
+    // Grow the cavity across adjacency
+    const uint64_t stamp = ++stamp_;
     std::vector<Triangle*> badTriangles;
-
-    for (auto& tr : triangles) {
-        if (tr->isInCircumcircle(p)) {
-            badTriangles.push_back(tr.get());
+    std::vector<Triangle*> stack = {seed};
+    seed->visitStamp = stamp;
+    seed->inCavity = true;
+
+    while (!stack.empty()) {
+        Triangle* tr = stack.back();
+        stack.pop_back();
+        badTriangles.push_back(tr);
+
+        for (auto* nb : tr->adjacent) {
+            if (!nb || nb->visitStamp == stamp) continue;
+            nb->visitStamp = stamp;
+            nb->inCavity = nb->isInCircumcircle(p);
+            if (nb->inCavity) stack.push_back(nb);
         }
     }
 
-    if (badTriangles.empty()) return;
+    // Creation order matches the order the brute-force scan found them in
+    std::sort(badTriangles.begin(), badTriangles.end(),
+        [](const Triangle* a, const Triangle* b) { return a->serial < b->serial; });
 
-    // Find the boundary of the polygonal hole
-    std::vector<std::pair<Point, Point>> boundary;
+    // Boundary of the polygonal hole, keeping each edge's direction from its triangle
+    struct BoundaryEdge {
+        Point a, b;
+        Region* ra;
+        Region* rb;
+        Triangle* inside;
+        Triangle* outside;
+    };
+    std::vector<BoundaryEdge> boundary;
 
     for (auto* tr : badTriangles) {
-        std::pair<Point, Point> edges[3] = {
-            {tr->p1, tr->p2},
-            {tr->p2, tr->p3},
-            {tr->p3, tr->p1}
-        };
-
-        for (const auto& edge : edges) {
-            bool isShared = false;
-
-            for (auto* other : badTriangles) {
-                if (other == tr) continue;
-
-                // Check if this edge is shared with another bad triangle
-                if ((other->p1 == edge.first || other->p2 == edge.first || other->p3 == edge.first) &&
-                    (other->p1 == edge.second || other->p2 == edge.second || other->p3 == edge.second)) {
-                    isShared = true;
-                    break;
-                }
-            }
-
-            if (!isShared) {
-                boundary.push_back(edge);
-            }
+        for (int e = 0; e < 3; ++e) {
+            Triangle* nb = tr->adjacent[e];
+            if (nb && nb->visitStamp == stamp && nb->inCavity) continue;
+            int next = (e + 1) % 3;
+            boundary.push_back({tr->vertex(e), tr->vertex(next), tr->owners[e], tr->owners[next], tr, nb});
         }
     }
 
     // Remove bad triangles from regions
     for (auto* tr : badTriangles) {
-        auto* r1 = findRegion(tr->p1);
-        auto* r2 = findRegion(tr->p2);
-        auto* r3 = findRegion(tr->p3);
-
-        if (r1) {
-            auto it = std::find(r1->vertices.begin(), r1->vertices.end(), tr);
-            if (it != r1->vertices.end()) r1->vertices.erase(it);
-        }
-        if (r2) {
-            auto it = std::find(r2->vertices.begin(), r2->vertices.end(), tr);
-            if (it != r2->vertices.end()) r2->vertices.erase(it);
-        }
-        if (r3) {
-            auto it = std::find(r3->vertices.begin(), r3->vertices.end(), tr);
-            if (it != r3->vertices.end()) r3->vertices.erase(it);
+        for (auto* owner : tr->owners) {
+            if (!owner) continue;
+            auto it = std::find(owner->vertices.begin(), owner->vertices.end(), tr);
+            if (it != owner->vertices.end()) owner->vertices.erase(it);
         }
     }
 
-    // Remove bad triangles
-    triangles.erase(
-        std::remove_if(triangles.begin(), triangles.end(),
-            [&badTriangles](const std::unique_ptr<Triangle>& tr) {
-                return std::find(badTriangles.begin(), badTriangles.end(), tr.get()) != badTriangles.end();
-            }),
-        triangles.end());
-
-    // Create new region for the new point
-    auto newRegion = std::make_unique<Region>(p);
-
     // Create new triangles from boundary edges to new point
+    std::vector<Triangle*> fan;
+    fan.reserve(boundary.size());
     for (const auto& edge : boundary) {
-        auto newTr = std::make_unique<Triangle>(edge.first, edge.second, p);
-        Triangle* trPtr = newTr.get();
+        Triangle* tr = addTriangle(edge.a, edge.b, p, edge.ra, edge.rb, region);
+
+        if (edge.ra) edge.ra->vertices.push_back(tr);
+        if (edge.rb) edge.rb->vertices.push_back(tr);
+        region->vertices.push_back(tr);
+
+        // Edge a-b keeps its outside neighbor
+        tr->adjacent[0] = edge.outside;
+        if (edge.outside) {
+            for (auto*& back : edge.outside->adjacent) {
+                if (back == edge.inside) {
+                    back = tr;
+                    break;
+                }
+            }
+        }
+        fan.push_back(tr);
+    }
 
-        updateRegions(trPtr);
-        newRegion->vertices.push_back(trPtr);
+    // Link the fan: edges b-p and p-a meet the fan triangle sharing that boundary vertex
+    for (auto* tr : fan) {
+        for (auto* other : fan) {
+            if (other == tr) continue;
+            if (other->p1 == tr->p2 || other->p2 == tr->p2) tr->adjacent[1] = other;
+            if (other->p1 == tr->p1 || other->p2 == tr->p1) tr->adjacent[2] = other;
+        }
+    }
 
-        triangles.push_back(std::move(newTr));
+    for (auto* tr : badTriangles) {
+        removeTriangle(tr);
     }
+    if (!fan.empty()) lastTriangle_ = fan.back();
+
+    return true;
+}
 
-    regions.push_back(std::move(newRegion));
+void Voronoi::addPoint(const Point& p) {
+    auto region = std::make_unique<Region>(p);
+    if (insert(p, region.get())) {
+        addRegion(std::move(region));
+    }
 }
 
 std::vector<Region*> Voronoi::partitioning() {
@@ -290,8 +384,27 @@ Voronoi Voronoi::build(const std::vector<Point>& vertices) {
     // Frame extends beyond the point bounds by half the extent
     Voronoi voronoi(minX - dx / 2, minY - dy / 2, maxX + dx / 2, maxY + dy / 2);
 
-    for (const auto& v : vertices) {
-        voronoi.addPoint(v);
+    // Insert along a Hilbert curve so each walk starts next to its target
+    double spanX = std::max(maxX - minX, 1e-12);
+    double spanY = std::max(maxY - minY, 1e-12);
+    std::vector<std::pair<uint64_t, size_t>> order(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        auto hx = static_cast<uint32_t>((vertices[i].x - minX) / spanX * 65535.0);
+        auto hy = static_cast<uint32_t>((vertices[i].y - minY) / spanY * 65535.0);
+        order[i] = {hilbertIndex(hx, hy), i};
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<std::unique_ptr<Region>> pending(vertices.size());
+    for (const auto& [key, i] : order) {
+        auto region = std::make_unique<Region>(vertices[i]);
+        if (voronoi.insert(vertices[i], region.get())) {
+            pending[i] = std::move(region);
+        }
+    }
+
+    for (auto& region : pending) {
+        if (region) voronoi.addRegion(std::move(region));
     }
 
     return voronoi;
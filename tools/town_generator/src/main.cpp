@@ -1,4 +1,5 @@
 #include "town_generator/building/City.h"
+#include "town_generator/building/TownBatch.h"
 #include "town_generator/svg/SVGWriter.h"
 #include "town_generator/utils/Random.h"
 
@@ -6,7 +7,13 @@
 #include <string>
 #include <cstdlib>
 #include <ctime>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
 #include <SDL3/SDL.h>
+#include <nlohmann/json.hpp>
 
 void printUsage(const char* programName) {
     SDL_Log("Usage: %s [options] <output.svg>", programName);
@@ -17,12 +24,124 @@ void printUsage(const char* programName) {
     SDL_Log("  --cells <int>  Number of cells (overrides --size)");
     SDL_Log("  --coast          Generate a coastal city with harbour");
     SDL_Log("  --no-coast       Generate an inland city (no water)");
+    SDL_Log("  --batch <json>   Generate one town per settlement in a settlements.json;");
+    SDL_Log("                   the output argument is then a directory");
+    SDL_Log("  --threads <int>  Worker threads for --batch (default: all cores)");
+    SDL_Log("  --verify         With --batch, regenerate single-threaded and compare hashes");
     SDL_Log("  --help           Show this help message");
     SDL_Log("");
     SDL_Log("Examples:");
     SDL_Log("  %s city.svg", programName);
     SDL_Log("  %s --seed 12345 --size large city.svg", programName);
     SDL_Log("  %s --cells 50 --seed 42 --coast city.svg", programName);
+    SDL_Log("  %s --batch settlements.json --seed 42 towns/", programName);
+}
+
+static char hexDigit(int v) {
+    return static_cast<char>(v < 10 ? '0' + v : 'a' + v - 10);
+}
+
+static std::string hashToHex(uint64_t hash) {
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        hex[i] = hexDigit(static_cast<int>(hash & 0xF));
+        hash >>= 4;
+    }
+    return hex;
+}
+
+static int runBatch(const std::string& settlementsPath, const std::string& outputDir,
+                    int seed, unsigned int threadCount, bool verify) {
+    using namespace town_generator::building;
+
+    std::vector<TownRequest> requests;
+    if (!loadSettlementRequests(settlementsPath, seed, requests)) {
+        return 1;
+    }
+    if (requests.empty()) {
+        SDL_Log("No settlements in %s", settlementsPath.c_str());
+        return 0;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(outputDir, ec);
+    if (ec) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error: Cannot create output directory '%s': %s",
+                     outputDir.c_str(), ec.message().c_str());
+        return 1;
+    }
+
+    SDL_Log("Generating %zu towns (batch seed %d, %u threads)", requests.size(), seed,
+            threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency()));
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<TownResult> results = generateTowns(requests, threadCount);
+    double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Write outputs and report timing in settlement order
+    nlohmann::json summary = nlohmann::json::array();
+    double sumBuildMs = 0.0;
+    int failures = 0;
+
+    SDL_Log("%6s %-16s %5s %11s %10s %10s  %s", "id", "type", "cells", "seed", "build ms", "svg ms", "hash");
+    for (const auto& r : results) {
+        std::string fileName = "town_" + std::to_string(r.id) + ".svg";
+
+        if (!r.success) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Town %u (seed %d) failed: %s", r.id, r.seed, r.error.c_str());
+            failures++;
+            continue;
+        }
+
+        std::ofstream file(std::filesystem::path(outputDir) / fileName, std::ios::binary);
+        if (!file || !(file << r.svg)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error: Failed to write %s", fileName.c_str());
+            failures++;
+            continue;
+        }
+
+        SDL_Log("%6u %-16s %5d %11d %10.1f %10.1f  %s", r.id, r.type.c_str(), r.cells, r.seed,
+                r.buildMillis, r.writeMillis, hashToHex(r.hash).c_str());
+        sumBuildMs += r.buildMillis + r.writeMillis;
+
+        summary.push_back({
+            {"id", r.id},
+            {"type", r.type},
+            {"cells", r.cells},
+            {"seed", r.seed},
+            {"file", fileName},
+            {"hash", hashToHex(r.hash)},
+            {"build_ms", r.buildMillis},
+            {"svg_ms", r.writeMillis}
+        });
+    }
+
+    std::ofstream summaryFile(std::filesystem::path(outputDir) / "towns.json");
+    summaryFile << summary.dump(2);
+
+    SDL_Log("Batch complete: %zu towns, %d failed, %.1f ms wall, %.1f ms summed (%.2fx)",
+            results.size(), failures, totalMs, sumBuildMs, totalMs > 0.0 ? sumBuildMs / totalMs : 0.0);
+
+    if (verify) {
+        SDL_Log("Verifying determinism against a single-threaded run...");
+        std::vector<TownResult> reference = generateTowns(requests, 1);
+        int mismatches = 0;
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (results[i].success != reference[i].success || results[i].hash != reference[i].hash) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Town %u differs: %s vs %s", results[i].id,
+                             hashToHex(results[i].hash).c_str(), hashToHex(reference[i].hash).c_str());
+                mismatches++;
+            }
+        }
+        if (mismatches > 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Determinism check failed: %d of %zu towns differ",
+                         mismatches, results.size());
+            return 1;
+        }
+        SDL_Log("Determinism check passed: all %zu towns match", results.size());
+    }
+
+    return failures > 0 ? 1 : 0;
 }
 
 int main(int argc, char* argv[]) {
@@ -31,6 +150,9 @@ int main(int argc, char* argv[]) {
     int cells = 30;  // Medium city
     std::string outputFile;
     int coastOverride = -1;  // -1 = use random, 0 = no coast, 1 = force coast
+    std::string batchFile;
+    unsigned int threadCount = 0;  // 0 = all cores
+    bool verify = false;
 
     // Parse arguments
     for (int i = 1; i < argc; ++i) {
@@ -75,6 +197,20 @@ int main(int argc, char* argv[]) {
             coastOverride = 1;
         } else if (arg == "--no-coast") {
             coastOverride = 0;
+        } else if (arg == "--batch") {
+            if (i + 1 >= argc) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error: --batch requires a settlements file");
+                return 1;
+            }
+            batchFile = argv[++i];
+        } else if (arg == "--threads") {
+            if (i + 1 >= argc) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error: --threads requires a value");
+                return 1;
+            }
+            threadCount = static_cast<unsigned int>(std::max(0, std::atoi(argv[++i])));
+        } else if (arg == "--verify") {
+            verify = true;
         } else if (arg[0] == '-') {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error: Unknown option '%s'", arg.c_str());
             printUsage(argv[0]);
@@ -95,6 +231,10 @@ int main(int argc, char* argv[]) {
         seed = static_cast<int>(std::time(nullptr));
     }
 
+    if (!batchFile.empty()) {
+        return runBatch(batchFile, outputFile, seed, threadCount, verify);
+    }
+
     SDL_Log("Generating city with %d cells, seed %d", cells, seed);
 
     // Generate the city
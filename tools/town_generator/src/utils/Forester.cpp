@@ -6,20 +6,22 @@ namespace town_generator {
 namespace utils {
 
 // Static member initialization
-Perlin* Forester::noise_ = nullptr;
-bool Forester::noiseInitialized_ = false;
+thread_local std::unique_ptr<Perlin> Forester::noise_;
 
 Perlin& Forester::getNoise() {
-    if (!noiseInitialized_) {
+    if (!noise_) {
         // Initialize with a random seed for variety
-        noise_ = new Perlin(Random::intVal(0, 2147483647));
+        noise_ = std::make_unique<Perlin>(Random::intVal(0, 2147483647));
         noise_->gridSize = 0.1;  // Larger features
         noise_->amplitude = 1.0;
-        noiseInitialized_ = true;
     }
     return *noise_;
 }
 
+void Forester::resetNoise() {
+    noise_.reset();
+}
+
 std::vector<geom::Point> Forester::generateHexGrid(
     double minX, double minY,
     double maxX, double maxY,
@@ -3,9 +3,9 @@
 namespace town_generator {
 namespace utils {
 
-// Static member initialization
-int64_t Random::seed_ = 1;
-int64_t Random::savedSeed_ = 1;
+// Static member initialization (one sequence per thread)
+thread_local int64_t Random::seed_ = 1;
+thread_local int64_t Random::savedSeed_ = 1;
 
 } // namespace utils
 } // namespace town_generator
@@ -357,4 +357,24 @@ TEST_SUITE("Node operations") {
         n1->links[n2] = 10.0;
         CHECK(n1->links[n2] == 10.0);
     }
+
+    TEST_CASE("Links iterate in node creation order") {
+        Graph graph;
+        std::vector<Node*> created;
+        for (int i = 0; i < 16; ++i) {
+            created.push_back(graph.add());
+        }
+
+        // Link in reverse so neither insertion nor address order matches creation
+        auto hub = graph.add();
+        for (auto it = created.rbegin(); it != created.rend(); ++it) {
+            hub->link(*it);
+        }
+
+        std::vector<Node*> iterated;
+        for (const auto& pair : hub->links) {
+            iterated.push_back(pair.first);
+        }
+        CHECK(iterated == created);
+    }
 }
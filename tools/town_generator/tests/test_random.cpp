@@ -0,0 +1,53 @@
+#include <doctest/doctest.h>
+#include "town_generator/utils/Random.h"
+#include <thread>
+#include <vector>
+
+using namespace town_generator::utils;
+
+namespace {
+
+std::vector<double> drawSequence(int seed, int count) {
+    Random::reset(seed);
+    std::vector<double> values;
+    for (int i = 0; i < count; ++i) {
+        values.push_back(Random::floatVal());
+    }
+    return values;
+}
+
+} // namespace
+
+TEST_SUITE("Random") {
+    TEST_CASE("Same seed gives the same sequence") {
+        CHECK(drawSequence(12345, 100) == drawSequence(12345, 100));
+        CHECK(drawSequence(12345, 100) != drawSequence(54321, 100));
+    }
+
+    TEST_CASE("Save and restore rewind the sequence") {
+        Random::reset(42);
+        Random::save();
+        double first = Random::floatVal();
+        Random::floatVal();
+        Random::restore();
+        CHECK(Random::floatVal() == first);
+    }
+
+    TEST_CASE("State is independent per thread") {
+        const auto expected = drawSequence(777, 1000);
+
+        // Other threads drawing concurrently must not perturb each other's sequences
+        std::vector<std::vector<double>> results(4);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < results.size(); ++t) {
+            threads.emplace_back([&results, t] { results[t] = drawSequence(777, 1000); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (const auto& result : results) {
+            CHECK(result == expected);
+        }
+    }
+}
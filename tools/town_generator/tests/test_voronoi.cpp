@@ -0,0 +1,209 @@
+#include <doctest/doctest.h>
+#include "town_generator/geom/Voronoi.h"
+#include <cmath>
+#include <random>
+#include <tuple>
+
+using namespace town_generator::geom;
+
+namespace {
+
+// Brute-force Bowyer-Watson as originally ported from Haxe; the reference the
+// adjacency-walk implementation must reproduce exactly
+struct ReferenceVoronoi {
+    std::vector<std::unique_ptr<Triangle>> triangles;
+    std::vector<std::pair<Point, std::vector<Triangle*>>> regions;
+
+    ReferenceVoronoi(double minx, double miny, double maxx, double maxy) {
+        Point c1(minx, miny), c2(minx, maxy), c3(maxx, miny), c4(maxx, maxy);
+        triangles.push_back(std::make_unique<Triangle>(c1, c2, c3));
+        triangles.push_back(std::make_unique<Triangle>(c2, c3, c4));
+        for (const auto& p : {c1, c2, c3, c4}) {
+            regions.push_back({p, {}});
+            for (const auto& tr : triangles) {
+                if (tr->p1 == p || tr->p2 == p || tr->p3 == p) regions.back().second.push_back(tr.get());
+            }
+        }
+    }
+
+    std::vector<Triangle*>* findRegion(const Point& p) {
+        for (auto& region : regions) {
+            if (region.first == p) return &region.second;
+        }
+        return nullptr;
+    }
+
+    void addPoint(const Point& p) {
+        std::vector<Triangle*> bad;
+        for (auto& tr : triangles) {
+            if (tr->isInCircumcircle(p)) bad.push_back(tr.get());
+        }
+        if (bad.empty()) return;
+
+        std::vector<std::pair<Point, Point>> boundary;
+        for (auto* tr : bad) {
+            std::pair<Point, Point> edges[3] = {{tr->p1, tr->p2}, {tr->p2, tr->p3}, {tr->p3, tr->p1}};
+            for (const auto& edge : edges) {
+                bool shared = false;
+                for (auto* other : bad) {
+                    if (other == tr) continue;
+                    if ((other->p1 == edge.first || other->p2 == edge.first || other->p3 == edge.first) &&
+                        (other->p1 == edge.second || other->p2 == edge.second || other->p3 == edge.second)) {
+                        shared = true;
+                        break;
+                    }
+                }
+                if (!shared) boundary.push_back(edge);
+            }
+        }
+
+        for (auto* tr : bad) {
+            for (const auto& v : {tr->p1, tr->p2, tr->p3}) {
+                if (auto* list = findRegion(v)) {
+                    auto it = std::find(list->begin(), list->end(), tr);
+                    if (it != list->end()) list->erase(it);
+                }
+            }
+        }
+        triangles.erase(std::remove_if(triangles.begin(), triangles.end(),
+            [&](const std::unique_ptr<Triangle>& tr) {
+                return std::find(bad.begin(), bad.end(), tr.get()) != bad.end();
+            }), triangles.end());
+
+        std::vector<Triangle*> newRegion;
+        for (const auto& edge : boundary) {
+            auto tr = std::make_unique<Triangle>(edge.first, edge.second, p);
+            if (auto* list = findRegion(tr->p1)) list->push_back(tr.get());
+            if (auto* list = findRegion(tr->p2)) list->push_back(tr.get());
+            newRegion.push_back(tr.get());
+            triangles.push_back(std::move(tr));
+        }
+        regions.push_back({p, newRegion});
+    }
+};
+
+using Corners = std::tuple<double, double, double, double, double, double>;
+
+Corners corners(const Triangle* tr) {
+    return {tr->p1.x, tr->p1.y, tr->p2.x, tr->p2.y, tr->p3.x, tr->p3.y};
+}
+
+std::vector<Point> randomPoints(size_t count, double size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(0.0, size);
+    std::vector<Point> points;
+    for (size_t i = 0; i < count; ++i) {
+        points.emplace_back(dist(rng), dist(rng));
+    }
+    return points;
+}
+
+// Golden-angle spiral around the frame center, like City's seed layout
+std::vector<Point> spiralPoints(size_t count, double size) {
+    std::vector<Point> points;
+    for (size_t i = 0; i < count; ++i) {
+        double a = i * 2.399963229728653;
+        double r = std::sqrt(static_cast<double>(i) / count) * size * 0.45;
+        points.emplace_back(size / 2 + std::cos(a) * r, size / 2 + std::sin(a) * r);
+    }
+    return points;
+}
+
+void checkMatchesReference(const std::vector<Point>& points, double size) {
+    Voronoi voronoi(0, 0, size, size);
+    ReferenceVoronoi reference(0, 0, size, size);
+    for (const auto& p : points) {
+        voronoi.addPoint(p);
+        reference.addPoint(p);
+    }
+
+    // Same triangles with the same vertex order, so bit-identical circumcenters
+    std::vector<Corners> actual, expected;
+    for (const auto& tr : voronoi.triangles) actual.push_back(corners(tr.get()));
+    for (const auto& tr : reference.triangles) expected.push_back(corners(tr.get()));
+    std::sort(actual.begin(), actual.end());
+    std::sort(expected.begin(), expected.end());
+    CHECK(actual == expected);
+
+    // Same regions in the same order, each listing the same triangles in the same order
+    REQUIRE(voronoi.regions.size() == reference.regions.size());
+    for (size_t i = 0; i < voronoi.regions.size(); ++i) {
+        const auto& region = *voronoi.regions[i];
+        const auto& [seed, vertices] = reference.regions[i];
+        CHECK(region.seed == seed);
+        CHECK(region.id == static_cast<int>(i));
+        REQUIRE(region.vertices.size() == vertices.size());
+        for (size_t v = 0; v < vertices.size(); ++v) {
+            CHECK(corners(region.vertices[v]) == corners(vertices[v]));
+            CHECK(region.vertices[v]->c == vertices[v]->c);
+        }
+    }
+}
+
+} // namespace
+
+TEST_SUITE("Voronoi") {
+    TEST_CASE("Incremental insertion matches brute-force Bowyer-Watson") {
+        checkMatchesReference(randomPoints(400, 200.0, 7), 200.0);
+        checkMatchesReference(spiralPoints(400, 200.0), 200.0);
+    }
+
+    TEST_CASE("Triangle adjacency is symmetric") {
+        Voronoi voronoi(0, 0, 100, 100);
+        for (const auto& p : randomPoints(300, 100.0, 11)) voronoi.addPoint(p);
+
+        for (const auto& tr : voronoi.triangles) {
+            for (int e = 0; e < 3; ++e) {
+                Triangle* nb = tr->adjacent[e];
+                if (!nb) continue;
+                CHECK(std::count(std::begin(nb->adjacent), std::end(nb->adjacent), tr.get()) == 1);
+            }
+        }
+    }
+
+    TEST_CASE("Region neighbors share a triangle and keep region order") {
+        Voronoi voronoi(0, 0, 100, 100);
+        for (const auto& p : spiralPoints(200, 100.0)) voronoi.addPoint(p);
+
+        for (const auto& region : voronoi.regions) {
+            std::vector<Region*> expected;
+            for (const auto& other : voronoi.regions) {
+                if (other.get() == region.get()) continue;
+                for (auto* tr : region->vertices) {
+                    if (std::find(other->vertices.begin(), other->vertices.end(), tr) != other->vertices.end()) {
+                        expected.push_back(other.get());
+                        break;
+                    }
+                }
+            }
+            CHECK(region->neighbors(voronoi.regions) == expected);
+        }
+    }
+
+    TEST_CASE("Hilbert-ordered build is Delaunay and keeps input region order") {
+        auto points = randomPoints(500, 100.0, 3);
+        Voronoi voronoi = Voronoi::build(points);
+
+        REQUIRE(voronoi.regions.size() == points.size() + 4);
+        for (size_t i = 0; i < points.size(); ++i) {
+            CHECK(voronoi.regions[i + 4]->seed == points[i]);
+        }
+
+        // Empty circumcircle property against every site
+        for (const auto& tr : voronoi.triangles) {
+            for (const auto& p : points) {
+                CHECK(Point::distance(p, tr->c) >= tr->r * (1.0 - 1e-9));
+            }
+        }
+    }
+
+    TEST_CASE("Relaxation returns one point per interior region") {
+        auto points = spiralPoints(150, 100.0);
+        auto relaxed = Voronoi::relax(points, 100.0, 100.0);
+
+        Voronoi voronoi(0, 0, 100, 100);
+        for (const auto& p : points) voronoi.addPoint(p);
+        CHECK(relaxed.size() == voronoi.partitioning().size());
+        CHECK(Voronoi::relax(points, 100.0, 100.0) == relaxed);
+    }
+}
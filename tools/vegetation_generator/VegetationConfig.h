@@ -177,6 +177,12 @@ struct VegetationGeneratorConfig {
     bool generateSVG = true;
     int svgSize = 2048;
 
+    // Also write per-instance JSON tiles (debug export, binary .vegt tiles are always written)
+    bool writeJsonTiles = false;
+
+    // Time loading the written tiles in both formats and log sizes (implies writeJsonTiles)
+    bool compareTileFormats = false;
+
     // Default biome densities
     BiomeDensityConfig woodlandDensity = {
         .treeDensity = 0.01f,           // ~100 trees per hectare
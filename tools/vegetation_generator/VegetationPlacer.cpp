@@ -1,4 +1,5 @@
 #include "VegetationPlacer.h"
+#include "vegetation/VegetationTileLoader.h"
 #include <SDL3/SDL_log.h>
 #include <nlohmann/json.hpp>
 #include <lodepng.h>
@@ -542,6 +543,41 @@ size_t VegetationPlacer::getTotalInstanceCount() const {
 bool VegetationPlacer::saveTiles(const std::string& outputDir) const {
     std::filesystem::create_directories(outputDir);
 
+    size_t totalBytes = 0;
+    for (const auto& tile : tiles_) {
+        // Per-tile type table: only the types present, in first-use order
+        std::vector<VegetationTileType> types;
+        std::unordered_map<VegetationType, uint8_t> typeIds;
+        std::vector<VegetationTileInstance> instances;
+        instances.reserve(tile.instances.size());
+
+        for (const auto& inst : tile.instances) {
+            auto it = typeIds.find(inst.type);
+            if (it == typeIds.end()) {
+                const char* preset = getVegetationPreset(inst.type);
+                it = typeIds.emplace(inst.type, static_cast<uint8_t>(types.size())).first;
+                types.push_back({getVegetationTypeName(inst.type), preset ? preset : ""});
+            }
+            instances.push_back({inst.position, inst.rotation, inst.scale, it->second, inst.seed});
+        }
+
+        std::string path = VegetationTileLoader::getTilePath(outputDir, tile.tileX, tile.tileZ);
+        if (!VegetationTileLoader::save(path, tile.tileX, tile.tileZ, tile.worldMin, tile.worldMax,
+                                        types, instances)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to write tile: %s", path.c_str());
+            return false;
+        }
+        totalBytes += std::filesystem::file_size(path);
+    }
+
+    SDL_Log("Saved %zu tiles to %s (%.2f MB)", tiles_.size(), outputDir.c_str(),
+            totalBytes / (1024.0 * 1024.0));
+    return true;
+}
+
+bool VegetationPlacer::saveTilesJson(const std::string& outputDir) const {
+    std::filesystem::create_directories(outputDir);
+
     for (const auto& tile : tiles_) {
         json tileJson;
         tileJson["tileX"] = tile.tileX;
@@ -580,13 +616,15 @@ bool VegetationPlacer::saveTiles(const std::string& outputDir) const {
         file << tileJson.dump(2);
     }
 
-    SDL_Log("Saved %zu tiles to %s", tiles_.size(), outputDir.c_str());
+    SDL_Log("Saved %zu JSON debug tiles to %s", tiles_.size(), outputDir.c_str());
     return true;
 }
 
 bool VegetationPlacer::saveManifest(const std::string& path) const {
     json manifest;
-    manifest["version"] = 1;
+    manifest["version"] = 2;
+    manifest["tileFormat"] = "vegt";
+    manifest["tileFormatVersion"] = VegetationTileLoader::VERSION;
     manifest["tileSize"] = config_.tileSize;
     manifest["terrainSize"] = config_.terrainSize;
     manifest["seed"] = config_.seed;
@@ -44,7 +44,10 @@ public:
     size_t getTotalInstanceCount() const;
 
     // Output
+    // Binary .vegt tiles (see src/vegetation/VegetationTileLoader.h)
     bool saveTiles(const std::string& outputDir) const;
+    // Human-readable per-instance JSON tiles, for debugging only
+    bool saveTilesJson(const std::string& outputDir) const;
     bool saveSVG(const std::string& path, int size) const;
     bool saveManifest(const std::string& path) const;
 
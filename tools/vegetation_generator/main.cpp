@@ -1,9 +1,13 @@
 // Vegetation placement generator tool
 // Uses Poisson disk sampling to generate natural-looking vegetation distributions
-// Outputs tile-based JSON files for streaming/paging
+// Outputs binary tiles (.vegt) for streaming/paging, optionally JSON for debugging
 
 #include "VegetationPlacer.h"
+#include "vegetation/VegetationTileLoader.h"
 #include <SDL3/SDL_log.h>
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <filesystem>
@@ -12,7 +16,7 @@ void printUsage(const char* programName) {
     std::cout << "Usage: " << programName << " <output_dir> [options]\n"
               << "\n"
               << "Generates vegetation placement data using Poisson disk sampling.\n"
-              << "Results are saved as tile-based JSON files for efficient streaming.\n"
+              << "Results are saved as binary tiles (.vegt) for efficient streaming.\n"
               << "\n"
               << "Arguments:\n"
               << "  output_dir           Directory for output files\n"
@@ -31,6 +35,8 @@ void printUsage(const char* programName) {
               << "  --rock-spacing <m>   Minimum spacing between rocks (default: 3.0)\n"
               << "  --no-svg             Disable SVG visualization output\n"
               << "  --svg-size <px>      SVG output size (default: 2048)\n"
+              << "  --json-tiles         Also write per-instance JSON tiles (debug export)\n"
+              << "  --compare-formats    Write JSON tiles too and log size/load time of both formats\n"
               << "  --help               Show this help message\n"
               << "\n"
               << "Biome Densities (trees per hectare approx):\n"
@@ -41,13 +47,17 @@ void printUsage(const char* programName) {
               << "\n"
               << "Output files:\n"
               << "  vegetation_manifest.json    Tile listing and statistics\n"
-              << "  tile_X_Z.json               Per-tile vegetation instances\n"
+              << "  tiles/tile_X_Z.vegt         Per-tile vegetation instances (binary)\n"
+              << "  tiles/tile_X_Z.json         Same instances as JSON (--json-tiles only)\n"
               << "  vegetation.svg              Optional visualization\n"
               << "\n"
               << "Example:\n"
               << "  " << programName << " ./vegetation --biome-map biome.png --density 1.5\n"
               << "\n"
-              << "Instance JSON format:\n"
+              << "Binary tile format: see src/vegetation/VegetationTileLoader.h\n"
+              << "(12 bytes per instance: quantized position, rotation, scale, type id, seed)\n"
+              << "\n"
+              << "Instance JSON format (debug export):\n"
               << "  {\n"
               << "    \"position\": [x, z],\n"
               << "    \"rotation\": radians,\n"
@@ -58,6 +68,63 @@ void printUsage(const char* programName) {
               << "  }\n";
 }
 
+// Load every written tile in both formats and report size and load time.
+// The JSON side decodes the same fields the binary side does.
+void compareTileFormats(const std::string& tilesDir) {
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<std::filesystem::path> binaryPaths;
+    for (const auto& entry : std::filesystem::directory_iterator(tilesDir)) {
+        if (entry.path().extension() == ".vegt") {
+            binaryPaths.push_back(entry.path());
+        }
+    }
+
+    size_t binaryBytes = 0;
+    size_t jsonBytes = 0;
+    size_t binaryInstances = 0;
+    size_t jsonInstances = 0;
+    double checksum = 0.0;
+
+    auto binaryStart = Clock::now();
+    for (const auto& path : binaryPaths) {
+        VegetationTileData tile;
+        if (!VegetationTileLoader::load(path.string(), tile)) continue;
+        binaryBytes += std::filesystem::file_size(path);
+        for (size_t i = 0; i < tile.getInstanceCount(); i++) {
+            VegetationTileInstance inst = tile.getInstance(i);
+            checksum += inst.position.x + inst.scale;
+        }
+        binaryInstances += tile.getInstanceCount();
+    }
+    double binaryMs = std::chrono::duration<double, std::milli>(Clock::now() - binaryStart).count();
+
+    auto jsonStart = Clock::now();
+    for (auto path : binaryPaths) {
+        path.replace_extension(".json");
+        std::ifstream file(path);
+        if (!file) continue;
+        nlohmann::json tileJson = nlohmann::json::parse(file);
+        jsonBytes += std::filesystem::file_size(path);
+        for (const auto& inst : tileJson["instances"]) {
+            float x = inst["position"][0].get<float>();
+            float scale = inst["scale"].get<float>();
+            checksum -= x + scale;
+        }
+        jsonInstances += tileJson["instances"].size();
+    }
+    double jsonMs = std::chrono::duration<double, std::milli>(Clock::now() - jsonStart).count();
+
+    SDL_Log("Tile format comparison (%zu tiles):", binaryPaths.size());
+    SDL_Log("  %-8s %12s %12s %12s", "format", "size (MB)", "load (ms)", "instances");
+    SDL_Log("  %-8s %12.2f %12.1f %12zu", "json", jsonBytes / (1024.0 * 1024.0), jsonMs, jsonInstances);
+    SDL_Log("  %-8s %12.2f %12.1f %12zu", "vegt", binaryBytes / (1024.0 * 1024.0), binaryMs, binaryInstances);
+    if (binaryBytes > 0 && binaryMs > 0.0) {
+        SDL_Log("  size ratio %.1fx, load speedup %.1fx (quantization drift %.3f)",
+                static_cast<double>(jsonBytes) / binaryBytes, jsonMs / binaryMs, checksum);
+    }
+}
+
 int main(int argc, char* argv[]) {
     // Check for help flag first
     for (int i = 1; i < argc; i++) {
@@ -105,6 +172,11 @@ int main(int argc, char* argv[]) {
             config.generateSVG = false;
         } else if (arg == "--svg-size" && i + 1 < argc) {
             config.svgSize = std::stoi(argv[++i]);
+        } else if (arg == "--json-tiles") {
+            config.writeJsonTiles = true;
+        } else if (arg == "--compare-formats") {
+            config.compareTileFormats = true;
+            config.writeJsonTiles = true;
         } else {
             std::cerr << "Unknown option: " << arg << "\n";
             printUsage(argv[0]);
@@ -153,6 +225,15 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    if (config.writeJsonTiles && !placer.saveTilesJson(tilesDir)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to save JSON tiles!");
+        return 1;
+    }
+
+    if (config.compareTileFormats) {
+        compareTileFormats(tilesDir);
+    }
+
     if (!placer.saveManifest(manifestPath)) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to save manifest!");
         return 1;
@@ -175,7 +256,10 @@ int main(int argc, char* argv[]) {
     SDL_Log("  Detritus: %zu", stats.totalDetritus);
     SDL_Log("Output files:");
     SDL_Log("  %s", manifestPath.c_str());
-    SDL_Log("  %s/*.json", tilesDir.c_str());
+    SDL_Log("  %s/*.vegt", tilesDir.c_str());
+    if (config.writeJsonTiles) {
+        SDL_Log("  %s/*.json", tilesDir.c_str());
+    }
     if (config.generateSVG) {
         SDL_Log("  %s", svgPath.c_str());
     }
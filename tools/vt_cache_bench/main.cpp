@@ -0,0 +1,209 @@
+// Virtual texture cache benchmark
+// Replays a feedback stream against the cache slot bookkeeping, comparing the
+// VirtualTextureSlotAllocator (flat map + intrusive LRU) with the previous
+// implementation (unordered_map + linear scan for the LRU slot).
+//
+// The stream is either a .vtfb recording (VT_RECORD_FEEDBACK=<path> when
+// running the game) or a synthetic camera fly-over. CPU only, no Vulkan.
+
+#include "terrain/virtual_texture/VirtualTextureSlotAllocator.h"
+#include "terrain/virtual_texture/VirtualTextureFeedbackRecording.h"
+
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace VirtualTexture;
+
+namespace {
+
+// Slot bookkeeping as VirtualTextureCache did it before VirtualTextureSlotAllocator
+class LegacyCache {
+public:
+    explicit LegacyCache(uint32_t slotCount) : slots(slotCount) {}
+
+    bool markUsed(TileId id, uint32_t frame) {
+        auto it = tileToSlot.find(id.pack());
+        if (it == tileToSlot.end()) return false;
+        slots[it->second].lastUsedFrame = frame;
+        return true;
+    }
+
+    bool allocate(TileId id, uint32_t frame) {
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (!slots[i].occupied) {
+                slots[i] = CacheSlot{id, frame, true, false};
+                tileToSlot[id.pack()] = i;
+                return false;
+            }
+        }
+
+        size_t lruIndex = 0;
+        uint32_t oldestFrame = UINT32_MAX;
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].lastUsedFrame < oldestFrame) {
+                oldestFrame = slots[i].lastUsedFrame;
+                lruIndex = i;
+            }
+        }
+        tileToSlot.erase(slots[lruIndex].tileId.pack());
+        slots[lruIndex] = CacheSlot{id, frame, true, false};
+        tileToSlot[id.pack()] = lruIndex;
+        return true;
+    }
+
+private:
+    std::vector<CacheSlot> slots;
+    std::unordered_map<uint32_t, size_t> tileToSlot;
+};
+
+class AllocatorCache {
+public:
+    explicit AllocatorCache(uint32_t slotCount) : allocator(slotCount) {}
+
+    bool markUsed(TileId id, uint32_t frame) { return allocator.touch(id, frame); }
+    bool allocate(TileId id, uint32_t frame) { return allocator.allocate(id, frame).evicted; }
+
+private:
+    VirtualTextureSlotAllocator allocator;
+};
+
+// Camera circling the terrain; requests every tile within a screen-sized
+// footprint at each mip, like the feedback pass does after deduplication
+std::vector<std::vector<uint32_t>> synthesizeStream(uint32_t frames, uint32_t tilesPerAxis, uint32_t mipLevels) {
+    std::vector<std::vector<uint32_t>> stream(frames);
+    const float center = tilesPerAxis * 0.5f;
+    const float radius = tilesPerAxis * 0.3f;
+    for (uint32_t f = 0; f < frames; ++f) {
+        float angle = f * 0.004f;
+        float camX = center + std::cos(angle) * radius;
+        float camY = center + std::sin(angle) * radius;
+
+        auto& frame = stream[f];
+        for (uint32_t mip = 0; mip < mipLevels; ++mip) {
+            int extent = std::max(1, static_cast<int>(tilesPerAxis >> mip));
+            int reach = mip == 0 ? 6 : 10;
+            int cx = static_cast<int>(camX) >> mip;
+            int cy = static_cast<int>(camY) >> mip;
+            for (int y = std::max(0, cy - reach); y <= std::min(extent - 1, cy + reach); ++y) {
+                for (int x = std::max(0, cx - reach); x <= std::min(extent - 1, cx + reach); ++x) {
+                    frame.push_back(TileId(static_cast<uint16_t>(x), static_cast<uint16_t>(y),
+                                           static_cast<uint8_t>(mip)).pack());
+                }
+            }
+        }
+    }
+    return stream;
+}
+
+struct ReplayResult {
+    double millis = 0.0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+// Mirrors VirtualTextureSystem::processFeedback: touch resident tiles, load
+// up to loadsPerFrame misses (loads complete immediately here)
+template <typename Cache>
+ReplayResult replay(Cache& cache, const std::vector<std::vector<uint32_t>>& stream, uint32_t loadsPerFrame) {
+    ReplayResult result;
+    auto start = std::chrono::steady_clock::now();
+    uint32_t frame = 0;
+    for (const auto& requests : stream) {
+        ++frame;
+        uint32_t loads = 0;
+        for (uint32_t packed : requests) {
+            TileId id = TileId::unpack(packed);
+            if (cache.markUsed(id, frame)) {
+                ++result.hits;
+                continue;
+            }
+            ++result.misses;
+            if (loads < loadsPerFrame) {
+                ++loads;
+                result.evictions += cache.allocate(id, frame) ? 1 : 0;
+            }
+        }
+    }
+    result.millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void printUsage(const char* programName) {
+    SDL_Log("Usage: %s [recording.vtfb] [options]", programName);
+    SDL_Log("  --slots <n>       Physical cache slots (default: 4096, a 8K cache of 128px tiles)");
+    SDL_Log("  --frames <n>      Synthetic stream length when no recording is given (default: 2000)");
+    SDL_Log("  --loads <n>       Tile loads per frame (default: 64, as VirtualTextureSystem)");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string recordingPath;
+    uint32_t slotCount = 4096;
+    uint32_t frames = 2000;
+    uint32_t loadsPerFrame = 64;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--slots" && i + 1 < argc) {
+            slotCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--frames" && i + 1 < argc) {
+            frames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--loads" && i + 1 < argc) {
+            loadsPerFrame = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg[0] != '-' && recordingPath.empty()) {
+            recordingPath = arg;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<std::vector<uint32_t>> stream;
+    if (!recordingPath.empty()) {
+        if (!FeedbackRecording::load(recordingPath, stream)) {
+            return 1;
+        }
+        SDL_Log("Replaying %s", recordingPath.c_str());
+    } else {
+        VirtualTextureConfig config;
+        stream = synthesizeStream(frames, config.getTilesPerAxis(), config.maxMipLevels);
+        SDL_Log("Replaying synthetic fly-over");
+    }
+
+    size_t totalRequests = 0;
+    for (const auto& frame : stream) totalRequests += frame.size();
+    SDL_Log("%zu frames, %.0f requests/frame, %u slots, %u loads/frame",
+            stream.size(), stream.empty() ? 0.0 : static_cast<double>(totalRequests) / stream.size(),
+            slotCount, loadsPerFrame);
+
+    LegacyCache legacy(slotCount);
+    AllocatorCache current(slotCount);
+    ReplayResult legacyResult = replay(legacy, stream, loadsPerFrame);
+    ReplayResult currentResult = replay(current, stream, loadsPerFrame);
+
+    SDL_Log("%-22s %10s %12s %10s %10s %10s", "implementation", "total ms", "us/frame", "hits", "misses", "evictions");
+    auto row = [&](const char* name, const ReplayResult& r) {
+        SDL_Log("%-22s %10.1f %12.2f %10llu %10llu %10llu", name, r.millis,
+                stream.empty() ? 0.0 : r.millis * 1000.0 / stream.size(),
+                static_cast<unsigned long long>(r.hits), static_cast<unsigned long long>(r.misses),
+                static_cast<unsigned long long>(r.evictions));
+    };
+    row("unordered_map + scan", legacyResult);
+    row("flat map + LRU list", currentResult);
+    if (currentResult.millis > 0.0) {
+        SDL_Log("Speedup: %.1fx", legacyResult.millis / currentResult.millis);
+    }
+
+    return 0;
+}